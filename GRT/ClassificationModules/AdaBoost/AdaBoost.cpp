@@ -117,13 +117,6 @@ bool AdaBoost::train_(ClassificationData &trainingData){
     
     numInputDimensions = trainingData.getNumDimensions();
     numClasses = trainingData.getNumClasses();
-    const UINT M = trainingData.getNumSamples();
-    const UINT POSITIVE_LABEL = WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
-    const UINT NEGATIVE_LABEL = WEAK_CLASSIFIER_NEGATIVE_CLASS_LABEL;
-    Float alpha = 0;
-    const Float beta = 0.001;
-    Float epsilon = 0;
-    TrainingResult trainingResult;
     
     const UINT K = (UINT)weakClassifiers.size();
     if( K == 0 ){
@@ -140,128 +133,57 @@ bool AdaBoost::train_(ClassificationData &trainingData){
         trainingData.scale(ranges,0,1);
     }
     
-    //Create the weights vector
-    VectorFloat weights(M);
-    
-    //Create the error matrix
-    MatrixFloat errorMatrix(K,M);
+    //Let the weak classifiers precompute anything that only depends on the samples (such as the sort orders used by
+    //the DecisionStump), this is then shared by every class and boosting iteration
+    for(UINT k=0; k<K; k++){
+        if( !weakClassifiers[k]->prepareTrainingData( trainingData ) ){
+            errorLog << "train_(ClassificationData &trainingData) - Failed to prepare the training data for weakClassifier: " << k << std::endl;
+            for(UINT j=0; j<k; j++) weakClassifiers[j]->clearTrainingData();
+            return false;
+        }
+    }
     
     for(UINT classIter=0; classIter<numClasses; classIter++){
-        
         //Get the class label for the current class
         classLabels[classIter] = trainingData.getClassLabels()[classIter];
         
         //Set the class label of the current model
         models[ classIter ].setClassLabel( classLabels[classIter] );
-        
-        //Setup the labels for this class, POSITIVE_LABEL == 1, NEGATIVE_LABEL == 2
-        ClassificationData classData;
-        classData.setNumDimensions(trainingData.getNumDimensions());
-        for(UINT i=0; i<M; i++){
-            UINT label = trainingData[i].getClassLabel()==classLabels[classIter] ? POSITIVE_LABEL : NEGATIVE_LABEL;
-            VectorFloat trainingSample = trainingData[i].getSample();
-            classData.addSample(label,trainingSample);
+    }
+    
+    //Train the one-vs-all model for each class, the classes are independent so they can be trained in parallel. When they are, the
+    //weak classifiers run their own training serially, as it is nested inside the class blocks
+    Vector< Vector< TrainingResult > > classTrainingResults( numClasses );
+    Vector< unsigned int > classTrained( numClasses, 0 );
+    
+    ThreadPool::parallelFor( 0, numClasses, 1, [this,&trainingData,&classTrainingResults,&classTrained](const UINT classBegin,const UINT classEnd){
+        for(UINT classIter=classBegin; classIter<classEnd; classIter++){
+            classTrained[classIter] = trainClassModel( trainingData, classIter, classTrainingResults[classIter] ) ? 1 : 0;
         }
-        
-        //Setup the initial training sample weights
-        std::fill(weights.begin(),weights.end(),1.0/M);
-        
-        //Run the boosting loop
-        bool keepBoosting = true;
-        UINT t = 0;
-        
-        while( keepBoosting ){
-            
-            //Pick the classifier from the family of classifiers that minimizes the total error
-            UINT bestClassifierIndex = 0;
-            Float minError = grt_numeric_limits< Float >::max();
-            for(UINT k=0; k<K; k++){
-                //Get the k'th possible classifier
-                WeakClassifier *weakLearner = weakClassifiers[k];
-                
-                //Train the current classifier
-                if( !weakLearner->train(classData,weights) ){
-                    errorLog << "Failed to train weakLearner!" << std::endl;
-                    return false;
-                }
-                
-                //Compute the weighted error for this clasifier
-                Float e = 0;
-                Float positiveLabel = weakLearner->getPositiveClassLabel();
-                Float numCorrect = 0;
-                Float numIncorrect = 0;
-                for(UINT i=0; i<M; i++){
-                    //Only penalize errors
-                    Float prediction = weakLearner->predict( classData[i].getSample() );
-                    
-                    if( (prediction == positiveLabel && classData[i].getClassLabel() != POSITIVE_LABEL) ||        //False positive
-                    (prediction != positiveLabel && classData[i].getClassLabel() == POSITIVE_LABEL) ){       //False negative
-                        e += weights[i]; //Increase the error proportional to the weight of the example
-                        errorMatrix[k][i] = 1; //Flag that there was an error
-                        numIncorrect++;
-                    }else{
-                        errorMatrix[k][i] = 0; //Flag that there was no error
-                        numCorrect++;
-                    }
-                }
-                
-                trainingLog << "PositiveClass: " << classLabels[classIter] << " Boosting Iter: " << t << " Classifier: " << k << " WeightedError: " << e << " NumCorrect: " << numCorrect/M << " NumIncorrect: " <<numIncorrect/M << std::endl;
-                
-                if( e < minError ){
-                    minError = e;
-                    bestClassifierIndex = k;
-                }
-                
-            }
-            
-            epsilon = minError;
-            
-            //Set alpha, using the M1 weight value, small weights (close to 0) will receive a strong weight in the final classifier
-            alpha = 0.5 * log( (1.0-epsilon)/epsilon );
-            
-            trainingLog << "PositiveClass: " << classLabels[classIter] << " Boosting Iter: " << t << " Best Classifier Index: " << bestClassifierIndex << " MinError: " << minError << " Alpha: " << alpha << std::endl;
-            
-            if( grt_isinf(alpha) ){ keepBoosting = false; trainingLog << "Alpha is INF. Stopping boosting for current class" << std::endl; }
-            if( 0.5 - epsilon <= beta ){ keepBoosting = false; trainingLog << "Epsilon <= Beta. Stopping boosting for current class" << std::endl; }
-            if( ++t >= numBoostingIterations ) keepBoosting = false;
-            
-            trainingResult.setClassificationResult(t, minError, this);
-            trainingResults.push_back(trainingResult);
-            trainingResultsObserverManager.notifyObservers( trainingResult );
-            
-            if( keepBoosting ){
-                
-                //Add the best weak classifier to the committee
-                models[ classIter ].addClassifierToCommitee( weakClassifiers[bestClassifierIndex], alpha );
-                
-                //Update the weights for the next boosting iteration
-                Float reWeight = (1.0 - epsilon) / epsilon;
-                Float oldSum = 0;
-                Float newSum = 0;
-                for(UINT i=0; i<M; i++){
-                    oldSum += weights[i];
-                    //Only update the weights that resulted in an incorrect prediction
-                    if( errorMatrix[bestClassifierIndex][i] == 1 ) weights[i] *= reWeight;
-                    newSum += weights[i];
-                }
-                
-                //Normalize all the weights
-                //This results to increasing the weights of the samples that were incorrectly labelled
-                //While decreasing the weights of the samples that were correctly classified
-                reWeight = oldSum/newSum;
-                for(UINT i=0; i<M; i++){
-                    weights[i] *= reWeight;
-                }
-                
-            }else{
-                trainingLog << "Stopping boosting training at iteration : " << t-1 << " with an error of " << epsilon << std::endl;
-                if( t-1 == 0 ){
-                    //Add the best weak classifier to the committee (we have to add it as this is the first iteration)
-                    if( grt_isinf(alpha) ){ alpha = 1; } //If alpha is infinite then the first classifier got everything correct
-                    models[ classIter ].addClassifierToCommitee( weakClassifiers[bestClassifierIndex], alpha );
-                }
-            }
-            
+        return true;
+    } );
+    
+    //Release the precomputed data, the weak classifiers in the committees share it with the classifiers they were copied from
+    for(UINT k=0; k<K; k++){
+        weakClassifiers[k]->clearTrainingData();
+    }
+    for(UINT classIter=0; classIter<numClasses; classIter++){
+        Vector< WeakClassifier* > committee = models[classIter].getWeakClassifiers();
+        for(UINT i=0; i<committee.getSize(); i++){
+            committee[i]->clearTrainingData();
+        }
+    }
+    
+    //Report the training results in the same order as the classes were trained in serial
+    for(UINT classIter=0; classIter<numClasses; classIter++){
+        for(UINT i=0; i<classTrainingResults[classIter].getSize(); i++){
+            trainingResults.push_back( classTrainingResults[classIter][i] );
+            trainingResultsObserverManager.notifyObservers( classTrainingResults[classIter][i] );
+        }
+        if( !classTrained[classIter] ){
+            errorLog << "train_(ClassificationData &trainingData) - Failed to train model for class: " << classLabels[classIter] << std::endl;
+            clear();
+            return false;
         }
     }
     
@@ -282,6 +204,162 @@ bool AdaBoost::train_(ClassificationData &trainingData){
     return true;
 }
 
+bool AdaBoost::trainClassModel(const ClassificationData &trainingData,const UINT classIter,Vector< TrainingResult > &classTrainingResults){
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT K = (UINT)weakClassifiers.size();
+    const UINT POSITIVE_LABEL = WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
+    const UINT NEGATIVE_LABEL = WEAK_CLASSIFIER_NEGATIVE_CLASS_LABEL;
+    Float alpha = 0;
+    const Float beta = 0.001;
+    Float epsilon = 0;
+    TrainingResult trainingResult;
+    
+    //Each class trains its own copy of the weak classifiers, so the classes can be trained at the same time
+    Vector< WeakClassifier* > weakLearners( K, NULL );
+    bool copiedWeakLearners = true;
+    for(UINT k=0; k<K; k++){
+        weakLearners[k] = weakClassifiers[k]->createNewInstance();
+        if( weakLearners[k] == NULL || !weakLearners[k]->deepCopyFrom( weakClassifiers[k] ) ){
+            copiedWeakLearners = false;
+            break;
+        }
+    }
+    if( !copiedWeakLearners ){
+        errorLog << "trainClassModel(...) - Failed to copy weakClassifiers!" << std::endl;
+        for(UINT k=0; k<K; k++){
+            if( weakLearners[k] != NULL ) delete weakLearners[k];
+        }
+        return false;
+    }
+    
+    //Create the weights vector
+    VectorFloat weights(M);
+    
+    //Create the error matrix
+    MatrixFloat errorMatrix(K,M);
+    
+    //Setup the labels for this class, POSITIVE_LABEL == 1, NEGATIVE_LABEL == 2
+    ClassificationData classData;
+    classData.setNumDimensions(trainingData.getNumDimensions());
+    classData.reserve(M);
+    for(UINT i=0; i<M; i++){
+        UINT label = trainingData[i].getClassLabel()==classLabels[classIter] ? POSITIVE_LABEL : NEGATIVE_LABEL;
+        classData.addSample(label,trainingData[i].getSample());
+    }
+    
+    //Setup the initial training sample weights
+    std::fill(weights.begin(),weights.end(),1.0/M);
+    
+    //Run the boosting loop
+    bool keepBoosting = true;
+    bool trainingFailed = false;
+    UINT t = 0;
+    
+    while( keepBoosting ){
+        
+        //Pick the classifier from the family of classifiers that minimizes the total error
+        UINT bestClassifierIndex = 0;
+        Float minError = grt_numeric_limits< Float >::max();
+        for(UINT k=0; k<K; k++){
+            //Get the k'th possible classifier
+            WeakClassifier *weakLearner = weakLearners[k];
+            
+            //Train the current classifier
+            if( !weakLearner->train(classData,weights) ){
+                errorLog << "Failed to train weakLearner!" << std::endl;
+                trainingFailed = true;
+                break;
+            }
+            
+            //Compute the weighted error for this clasifier
+            Float e = 0;
+            Float positiveLabel = weakLearner->getPositiveClassLabel();
+            Float numCorrect = 0;
+            Float numIncorrect = 0;
+            for(UINT i=0; i<M; i++){
+                //Only penalize errors
+                Float prediction = weakLearner->predict( classData[i].getSample() );
+                
+                if( (prediction == positiveLabel && classData[i].getClassLabel() != POSITIVE_LABEL) ||        //False positive
+                (prediction != positiveLabel && classData[i].getClassLabel() == POSITIVE_LABEL) ){       //False negative
+                    e += weights[i]; //Increase the error proportional to the weight of the example
+                    errorMatrix[k][i] = 1; //Flag that there was an error
+                    numIncorrect++;
+                }else{
+                    errorMatrix[k][i] = 0; //Flag that there was no error
+                    numCorrect++;
+                }
+            }
+            
+            trainingLog << "PositiveClass: " << classLabels[classIter] << " Boosting Iter: " << t << " Classifier: " << k << " WeightedError: " << e << " NumCorrect: " << numCorrect/M << " NumIncorrect: " <<numIncorrect/M << std::endl;
+            
+            if( e < minError ){
+                minError = e;
+                bestClassifierIndex = k;
+            }
+            
+        }
+        
+        if( trainingFailed ) break;
+        
+        epsilon = minError;
+        
+        //Set alpha, using the M1 weight value, small weights (close to 0) will receive a strong weight in the final classifier
+        alpha = 0.5 * log( (1.0-epsilon)/epsilon );
+        
+        trainingLog << "PositiveClass: " << classLabels[classIter] << " Boosting Iter: " << t << " Best Classifier Index: " << bestClassifierIndex << " MinError: " << minError << " Alpha: " << alpha << std::endl;
+        
+        if( grt_isinf(alpha) ){ keepBoosting = false; trainingLog << "Alpha is INF. Stopping boosting for current class" << std::endl; }
+        if( 0.5 - epsilon <= beta ){ keepBoosting = false; trainingLog << "Epsilon <= Beta. Stopping boosting for current class" << std::endl; }
+        if( ++t >= numBoostingIterations ) keepBoosting = false;
+        
+        //The results are reported by train_ once all the classes have been trained
+        trainingResult.setClassificationResult(t, minError, this);
+        classTrainingResults.push_back(trainingResult);
+        
+        if( keepBoosting ){
+            
+            //Add the best weak classifier to the committee
+            models[ classIter ].addClassifierToCommitee( weakLearners[bestClassifierIndex], alpha );
+            
+            //Update the weights for the next boosting iteration
+            Float reWeight = (1.0 - epsilon) / epsilon;
+            Float oldSum = 0;
+            Float newSum = 0;
+            for(UINT i=0; i<M; i++){
+                oldSum += weights[i];
+                //Only update the weights that resulted in an incorrect prediction
+                if( errorMatrix[bestClassifierIndex][i] == 1 ) weights[i] *= reWeight;
+                newSum += weights[i];
+            }
+            
+            //Normalize all the weights
+            //This results to increasing the weights of the samples that were incorrectly labelled
+            //While decreasing the weights of the samples that were correctly classified
+            reWeight = oldSum/newSum;
+            for(UINT i=0; i<M; i++){
+                weights[i] *= reWeight;
+            }
+            
+        }else{
+            trainingLog << "Stopping boosting training at iteration : " << t-1 << " with an error of " << epsilon << std::endl;
+            if( t-1 == 0 ){
+                //Add the best weak classifier to the committee (we have to add it as this is the first iteration)
+                if( grt_isinf(alpha) ){ alpha = 1; } //If alpha is infinite then the first classifier got everything correct
+                models[ classIter ].addClassifierToCommitee( weakLearners[bestClassifierIndex], alpha );
+            }
+        }
+        
+    }
+    
+    for(UINT k=0; k<K; k++){
+        delete weakLearners[k];
+    }
+    
+    return !trainingFailed;
+}
+
 bool AdaBoost::predict_(VectorFloat &inputVector){
     
     predictedClassLabel = 0;
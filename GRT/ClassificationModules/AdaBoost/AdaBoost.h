@@ -101,6 +101,7 @@ class GRT_API AdaBoost : public Classifier
     /**
     This trains the AdaBoost model, using the labelled classification data.
     This overrides the train function in the Classifier base class.
+    The one-vs-all model for each class is trained in parallel if GRT_CXX11_ENABLED is defined.
     
     @param trainingData: a reference to the training data
     @return returns true if the AdaBoost model was trained, false otherwise
@@ -227,10 +228,20 @@ class GRT_API AdaBoost : public Classifier
     using MLBase::load;
     using MLBase::train;
     using MLBase::train_;
-    using MLBase::predict;
+    using Classifier::predict;
     using MLBase::predict_;
     
 protected:
+    /**
+    Trains the one-vs-all model for a single class, using its own copies of the weak classifiers so the classes can be trained at the same time.
+    
+    @param trainingData: the (scaled) training data
+    @param classIter: the index of the class to train
+    @param classTrainingResults: returns the training result of each boosting iteration
+    @return returns true if the model was trained, false otherwise
+    */
+    bool trainClassModel(const ClassificationData &trainingData,const UINT classIter,Vector< TrainingResult > &classTrainingResults);
+    
     bool loadLegacyModelFromFile( std::fstream &file );
     
     UINT numBoostingIterations;
@@ -60,6 +60,7 @@ DecisionStump& DecisionStump::operator=(const DecisionStump &rhs){
         this->decisionValue = rhs.decisionValue;
         this->direction = rhs.direction;
         this->numRandomSplits = rhs.numRandomSplits;
+        this->sortedTrainingData = rhs.sortedTrainingData;
         this->copyBaseVariables( &rhs );
     }
     return *this;
@@ -92,62 +93,169 @@ bool DecisionStump::train(ClassificationData &trainingData, VectorFloat &weights
         return false;
     }
     
-    //Pick the training sample to use as the stump feature
     const UINT M = trainingData.getNumSamples();
-    UINT bestFeatureIndex = 0;
-    Vector< MinMax > ranges = trainingData.getRanges();
-    Float minError = grt_numeric_limits< Float >::max();
-    Float minRange = 0;
-    Float maxRange = 0;
-    Float step = 0;
-    Float threshold = 0;
-    Float bestThreshold = 0;
-    Random random;
-    
-    for(UINT k=0; k<numRandomSplits; k++){
+    const UINT N = numInputDimensions;
+    
+    //Use the sort orders computed by prepareTrainingData if they match the training data, otherwise sort the data now
+    std::shared_ptr< const SortedTrainingData > sortedData = sortedTrainingData;
+    if( !sortedData || sortedData->numSamples != M || sortedData->numDimensions != N ){
+        sortedData = sortTrainingData( trainingData );
+    }
+    
+    //Split the weights into the positive and negative class, so the sweep below does not need to look up the class labels
+    VectorFloat positiveWeights(M);
+    VectorFloat negativeWeights(M);
+    Float totalPositiveWeight = 0;
+    Float totalNegativeWeight = 0;
+    for(UINT i=0; i<M; i++){
+        if( trainingData[i].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL ){
+            positiveWeights[i] = weights[i];
+            negativeWeights[i] = 0;
+            totalPositiveWeight += weights[i];
+        }else{
+            positiveWeights[i] = 0;
+            negativeWeights[i] = weights[i];
+            totalNegativeWeight += weights[i];
+        }
+    }
+    
+    struct Split{
+        Float error;
+        Float threshold;
+        UINT featureIndex;
+        UINT direction;
+    };
+    
+    //Find the best split for each feature in [begin end), by sweeping over the sorted values and accumulating the weight
+    //of each class below the current threshold
+    auto searchFeatures = [&]( const UINT begin, const UINT end ){
+        Split best;
+        best.error = grt_numeric_limits< Float >::max();
+        best.threshold = 0;
+        best.featureIndex = begin;
+        best.direction = 1;
         
-        //Randomly select a feature and a threshold
-        UINT n = random.getRandomNumberInt(0,numInputDimensions);
-        minRange = ranges[n].minValue;
-        maxRange = ranges[n].maxValue;
-        threshold = random.getRandomNumberUniform( minRange, maxRange );
+        const Float *posWeights = &positiveWeights[0];
+        const Float *negWeights = &negativeWeights[0];
+        
+        for(UINT n=begin; n<end; n++){
+            const Float *values = &sortedData->values[ n*M ];
+            const UINT *indexes = &sortedData->indexes[ n*M ];
             
-        //Compute the error using the current threshold on the current input dimension
-        //We need to check both sides of the threshold
-        Float rhsError = 0;
-        Float lhsError = 0;
-        for(UINT i=0; i<M; i++){
-            bool positiveClass = trainingData[ i ].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
-            bool rhs = trainingData[ i ][ n ] >= threshold;
-            bool lhs = trainingData[ i ][ n ] <= threshold;
-            if( (rhs && !positiveClass) || (!rhs && positiveClass) ) rhsError += weights[ i ];
-            if( (lhs && !positiveClass) || (!lhs && positiveClass) ) lhsError += weights[ i ];
-        }
+            //Splitting below the smallest value predicts the same class for every sample
+            //direction 1 (x >= threshold is positive) predicts all samples as positive
+            if( totalNegativeWeight < best.error ){
+                best.error = totalNegativeWeight;
+                best.threshold = values[0];
+                best.featureIndex = n;
+                best.direction = 1;
+            }
+            //direction 0 (x <= threshold is positive) predicts all samples as negative
+            if( totalPositiveWeight < best.error ){
+                best.error = totalPositiveWeight;
+                best.threshold = values[0] - 1.0;
+                best.featureIndex = n;
+                best.direction = 0;
+            }
             
-        //Check to see if either the rhsError or lhsError beats the minError, if so then store the results
-        if( rhsError < minError ){
-            minError = rhsError;
-            bestFeatureIndex = n;
-            bestThreshold = threshold;
-            direction = 1; //1 means rhs
+            Float lhsPositive = 0;
+            Float lhsNegative = 0;
+            for(UINT j=1; j<M; j++){
+                lhsPositive += posWeights[ indexes[j-1] ];
+                lhsNegative += negWeights[ indexes[j-1] ];
+                
+                //We can only split between two different values
+                if( values[j-1] == values[j] ) continue;
+                
+                //Samples [0 j) are below the threshold, samples [j M) are above it
+                const Float rhsError = lhsPositive + (totalNegativeWeight - lhsNegative);
+                const Float lhsError = (totalPositiveWeight - lhsPositive) + lhsNegative;
+                
+                if( rhsError < best.error || lhsError < best.error ){
+                    //Place the threshold half way between the two values, making sure the samples still fall on the correct side of it
+                    const Float mid = (values[j-1] + values[j]) * 0.5;
+                    if( rhsError <= lhsError ){
+                        best.error = rhsError;
+                        best.threshold = mid > values[j-1] ? mid : values[j];
+                        best.direction = 1; //1 means rhs
+                    }else{
+                        best.error = lhsError;
+                        best.threshold = mid < values[j] ? mid : values[j-1];
+                        best.direction = 0; //0 means lhs
+                    }
+                    best.featureIndex = n;
+                }
+            }
         }
-        if( lhsError < minError ){
-            minError = lhsError;
-            bestFeatureIndex = n;
-            bestThreshold = threshold;
-            direction = 0; //0 means lhs
+        return best;
+    };
+    
+    Split best;
+    
+    //Only search the features in parallel if there is enough work to justify the threads, and at most maxNumTrainingThreads blocks
+    const UINT minBlockSize = 4;
+    const UINT minWorkSize = 1 << 15;
+    if( (unsigned long long)M * N >= minWorkSize && ThreadPool::getNumParallelBlocks( N, minBlockSize, maxNumTrainingThreads ) > 1 ){
+        Vector< Split > featureSplits( N );
+        ThreadPool::parallelFor( 0, N, minBlockSize, [&searchFeatures,&featureSplits](const UINT begin,const UINT end){
+            for(UINT n=begin; n<end; n++) featureSplits[n] = searchFeatures( n, n+1 );
+            return true;
+        }, maxNumTrainingThreads );
+        
+        //The features are merged in order, so ties are resolved exactly as in the serial search
+        best = featureSplits[0];
+        for(UINT n=1; n<N; n++){
+            if( featureSplits[n].error < best.error ) best = featureSplits[n];
         }
-            
-    }
+    }else best = searchFeatures( 0, N );
     
-    decisionFeatureIndex = bestFeatureIndex;
-    decisionValue = bestThreshold;
+    decisionFeatureIndex = best.featureIndex;
+    decisionValue = best.threshold;
+    direction = best.direction;
     trained = true;
     
-    trainingLog << "Best Feature Index: " << decisionFeatureIndex << " Value: " << decisionValue << " Direction: " << direction << " Error: " << minError << std::endl;
+    trainingLog << "Best Feature Index: " << decisionFeatureIndex << " Value: " << decisionValue << " Direction: " << direction << " Error: " << best.error << std::endl;
     return true;
 }
 
+bool DecisionStump::prepareTrainingData(const ClassificationData &trainingData){
+    sortedTrainingData = sortTrainingData( trainingData );
+    return true;
+}
+
+bool DecisionStump::clearTrainingData(){
+    sortedTrainingData.reset();
+    return true;
+}
+
+std::shared_ptr< const DecisionStump::SortedTrainingData > DecisionStump::sortTrainingData(const ClassificationData &trainingData){
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = trainingData.getNumDimensions();
+    
+    std::shared_ptr< SortedTrainingData > sortedData = std::make_shared< SortedTrainingData >();
+    sortedData->numSamples = M;
+    sortedData->numDimensions = N;
+    sortedData->values.resize( M*N );
+    sortedData->indexes.resize( M*N );
+    
+    Vector< IndexedDouble > column( M );
+    for(UINT n=0; n<N; n++){
+        for(UINT i=0; i<M; i++){
+            column[i].index = i;
+            column[i].value = trainingData[i][n];
+        }
+        //Ties keep the sample order, so the sort orders (and the splits found with them) are deterministic
+        std::stable_sort( column.begin(), column.end(), IndexedDouble::sortIndexedDoubleByValueAscending );
+        for(UINT i=0; i<M; i++){
+            sortedData->values[ n*M+i ] = column[i].value;
+            sortedData->indexes[ n*M+i ] = column[i].index;
+        }
+    }
+    
+    return sortedData;
+}
+
 Float DecisionStump::predict(const VectorFloat &x){
     if( direction == 1){
         if( x[ decisionFeatureIndex ] >= decisionValue ) return 1;
@@ -70,12 +70,33 @@ public:
     /**
      This function trains the DecisionStump model, using the weighted labelled training data.
      
+     The samples of each feature are sorted (or the sort orders computed by prepareTrainingData are reused), so the exact best
+     threshold for each feature can be found with a single sweep over the cumulative weighted errors. The features are searched
+     in parallel if GRT_CXX11_ENABLED is defined.
+     
      @param trainingData: the labelled training data
      @param weights: the corresponding weights for each sample in the labelled training data
      @return returns true if the model was trained successfull, false otherwise
      */
     virtual bool train(ClassificationData &trainingData, VectorFloat &weights);
     
+    /**
+     This function sorts the samples of each feature in the training data. The sort orders are then reused by train, as long as
+     the data passed to train contains the same samples in the same order. The sort orders are shared (not copied) by copies of
+     this DecisionStump.
+     
+     @param trainingData: the training data that will be used to train the model
+     @return returns true if the training data was prepared, false otherwise
+     */
+    virtual bool prepareTrainingData(const ClassificationData &trainingData);
+    
+    /**
+     This function releases the sort orders computed by prepareTrainingData.
+     
+     @return returns true if the data was cleared
+     */
+    virtual bool clearTrainingData();
+    
     /**
      This function predicts the class label of the input vector, given the current model. The class label returned will
      either be positive (WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL) or negative (WEAK_CLASSIFIER_NEGATIVE_CLASS_LABEL).
@@ -117,7 +138,7 @@ public:
     UINT getDirection() const;
     
     /**
-    @return returns the number of random splits that will be used to search for the best decision spilt
+    @return returns the number of random splits, this is no longer used for training as the exact best split is found, but is kept in the model file
     */
     UINT getNumRandomSplits() const;
     
@@ -127,6 +148,19 @@ public:
     Float getDecisionValue() const;
 
 protected:
+    /**
+     The values of each feature sorted in ascending order, along with the index of the sample each value came from.
+     */
+    struct SortedTrainingData{
+        UINT numSamples;
+        UINT numDimensions;
+        VectorFloat values;         ///< The sorted values, stored feature by feature (numDimensions x numSamples)
+        Vector< UINT > indexes;     ///< The sample index of each sorted value
+    };
+    
+    static std::shared_ptr< const SortedTrainingData > sortTrainingData(const ClassificationData &trainingData);
+    
+    std::shared_ptr< const SortedTrainingData > sortedTrainingData;  ///< The sort orders computed by prepareTrainingData
     UINT decisionFeatureIndex;  ///< The dimension that the data will be spilt on
     UINT direction;             ///< Indicates if the decision spilt threshold is greater than (1), or less than (0)
     UINT numRandomSplits;       ///< The number of random splits used to search for the best decision spilt
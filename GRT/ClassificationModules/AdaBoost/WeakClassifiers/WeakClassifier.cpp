@@ -31,7 +31,7 @@
 GRT_BEGIN_NAMESPACE
     
 WeakClassifier::StringWeakClassifierMap* WeakClassifier::stringWeakClassifierMap = NULL;
-UINT WeakClassifier::numWeakClassifierInstances = 0;
+InstanceCounter WeakClassifier::numWeakClassifierInstances( 0 );
 
 WeakClassifier* WeakClassifier::createInstanceFromString( std::string const &weakClassifierType ){
     
@@ -46,6 +46,7 @@ WeakClassifier::WeakClassifier(){
     weakClassifierType = "";
     trained = false;
     numInputDimensions = 0;
+    maxNumTrainingThreads = 0;
     numWeakClassifierInstances++;
 }
     
@@ -61,6 +62,7 @@ WeakClassifier& WeakClassifier::operator=(const WeakClassifier &rhs){
         this->weakClassifierType = rhs.weakClassifierType;
         this->trained = rhs.trained;
         this->numInputDimensions = rhs.numInputDimensions;
+        this->maxNumTrainingThreads = rhs.maxNumTrainingThreads;
         this->trainingLog = rhs.trainingLog;
         this->errorLog = rhs.errorLog;
         this->warningLog = rhs.warningLog;
@@ -76,6 +78,7 @@ bool WeakClassifier::copyBaseVariables(const WeakClassifier *weakClassifer){
     this->weakClassifierType = weakClassifer->weakClassifierType;
     this->trained = weakClassifer->trained;
     this->numInputDimensions = weakClassifer->numInputDimensions;
+    this->maxNumTrainingThreads = weakClassifer->maxNumTrainingThreads;
     return true;
 }
     
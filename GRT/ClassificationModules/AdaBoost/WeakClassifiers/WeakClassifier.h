@@ -97,6 +97,41 @@ public:
         return false;
     }
     
+    /**
+     This function lets the WeakClassifier precompute anything that only depends on the training samples (and not on their labels
+     or weights) before it is trained many times on the same samples, for example by AdaBoost. Any data that is labelled differently
+     but contains the same samples in the same order can then be passed to train.
+     This function can be overwritten in the inheriting class, by default it does nothing.
+     
+     @param trainingData: a reference to the training data that will be used to train the weak classifier model
+     @return returns true if the training data was prepared, false otherwise
+     */
+    virtual bool prepareTrainingData(const ClassificationData &trainingData){
+        return true;
+    }
+    
+    /**
+     This function releases any data computed by prepareTrainingData.
+     This function can be overwritten in the inheriting class, by default it does nothing.
+     
+     @return returns true if the data was cleared, false otherwise
+     */
+    virtual bool clearTrainingData(){
+        return true;
+    }
+    
+    /**
+     Sets the maximum number of threads the weak classifier can use in train. The weak classifiers AdaBoost trains in parallel
+     always train serially, as ThreadPool::parallelFor runs nested calls on the calling thread.
+     
+     @param maxNumTrainingThreads: the maximum number of threads, 0 uses the ThreadPool size
+     @return returns true if the value was updated, false otherwise
+     */
+    bool setMaxNumTrainingThreads(const UINT maxNumTrainingThreads){
+        this->maxNumTrainingThreads = maxNumTrainingThreads;
+        return true;
+    }
+    
     /**
      This function is the main predict interface for all the WeakClassifiers.
      This function should be overwritten in the inheriting class.
@@ -163,6 +198,13 @@ public:
         return numInputDimensions;
     }
     
+    /**
+     @return returns the maximum number of threads the weak classifier can use in train, 0 means the ThreadPool size is used
+     */
+    UINT getMaxNumTrainingThreads() const{
+        return maxNumTrainingThreads;
+    }
+    
     /**
      Defines a map between a string (which will contain the name of the WeakClassifier, such as DecisionStump) and a function returns a new instance of that WeakClassifier
      */
@@ -187,6 +229,7 @@ protected:
     std::string weakClassifierType;  ///<A string that represents the weak classifier type, e.g. DecisionStump
     bool trained;               ///<A flag to show if the weak classifier model has been trained
     UINT numInputDimensions;    ///<The number of input dimensions to the weak classifier
+    UINT maxNumTrainingThreads; ///<The maximum number of threads used by train, 0 uses the ThreadPool size
     TrainingLog trainingLog;
     ErrorLog errorLog;
     WarningLog warningLog;
@@ -198,7 +241,7 @@ protected:
     
 private:
     static StringWeakClassifierMap *stringWeakClassifierMap;
-    static UINT numWeakClassifierInstances;
+    static InstanceCounter numWeakClassifierInstances;
 };
     
 //These two functions/classes are used to register any new WeakClassification Module with the WeakClassifier base class
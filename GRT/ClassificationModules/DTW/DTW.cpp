@@ -259,7 +259,7 @@ bool DTW::train_(TimeSeriesClassificationData &data){
     
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
-    continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+    continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions,0);
     classLikelihoods.resize(numTemplates,DEFAULT_NULL_LIKELIHOOD_VALUE);
     classDistances.resize(numTemplates,0);
     predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
@@ -353,12 +353,26 @@ bool DTW::train_NDDTW(TimeSeriesClassificationData &trainingData,DTWTemplate &dt
 
 
 bool DTW::predict_(MatrixFloat &inputTimeSeries){
+    PredictionContext context;
+    swapPredictionResults( context );
+    bool result = predictTimeSeries( inputTimeSeries, distanceMatrices, warpPaths, context );
+    swapPredictionResults( context );
+    return result;
+}
+
+bool DTW::predictTimeSeries(MatrixFloat &inputTimeSeries,Vector< MatrixFloat > &distanceMatrices,Vector< Vector< IndexDist > > &warpPaths,PredictionContext &context) const{
     
     if( !trained ){
         errorLog << "predict_(MatrixFloat &inputTimeSeries) - The DTW templates have not been trained!" << std::endl;
         return false;
     }
     
+    UINT &predictedClassLabel = context.predictedClassLabel;
+    Float &maxLikelihood = context.maxLikelihood;
+    Float &bestDistance = context.bestDistance;
+    VectorFloat &classLikelihoods = context.classLikelihoods;
+    VectorFloat &classDistances = context.classDistances;
+    
     if( classLikelihoods.size() != numTemplates ) classLikelihoods.resize(numTemplates);
     if( classDistances.size() != numTemplates ) classDistances.resize(numTemplates);
     
@@ -489,32 +503,72 @@ bool DTW::predict_( VectorFloat &inputVector ){
     }
     
     //Add the new input to the circular buffer
-    continuousInputDataBuffer.push_back( inputVector );
+    continuousInputDataBuffer.push_back( &inputVector[0] );
     
     if( continuousInputDataBuffer.getNumValuesInBuffer() < averageTemplateLength ){
         //We haven't got enough samples yet so can't do the prediction
         return true;
     }
     
-    //Copy the data into a temporary matrix
-    const UINT M = continuousInputDataBuffer.getSize();
+    //Copy the data into a temporary matrix, the buffered frames are contiguous so this is a single block copy
+    const UINT M = continuousInputDataBuffer.getNumFrames();
     const UINT N = numInputDimensions;
     MatrixFloat predictionTimeSeries(M,N);
-    for(UINT i=0; i<M; i++){
-        for(UINT j=0; j<N; j++){
-            predictionTimeSeries[i][j] = continuousInputDataBuffer[i][j];
-        }
-    }
+    const Float *window = continuousInputDataBuffer.getWindow();
+    std::copy( window, window + M*N, predictionTimeSeries.getData() );
     
     //Run the prediction
     return predict( predictionTimeSeries );
     
 }
 
+bool DTW::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
+    
+    if( !trained ){
+        errorLog << "predict_(VectorFloat &inputVector) - The model has not been trained!" << std::endl;
+        return false;
+    }
+    context.predictedClassLabel = 0;
+    context.maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    std::fill(context.classLikelihoods.begin(),context.classLikelihoods.end(),DEFAULT_NULL_LIKELIHOOD_VALUE);
+    std::fill(context.classDistances.begin(),context.classDistances.end(),0);
+    
+    if( numInputDimensions != inputVector.size() ){
+        errorLog << "predict_(VectorFloat &inputVector) - The number of features in the model " << numInputDimensions << " does not match that of the input Vector " << inputVector.size() << std::endl;
+        return false;
+    }
+    
+    //Each context has its own input buffer, so several streams can be classified with the same templates
+    MultichannelCircularBuffer< Float > &inputDataBuffer = context.inputDataBuffer;
+    if( inputDataBuffer.getNumFrames() != averageTemplateLength || inputDataBuffer.getNumChannels() != numInputDimensions ){
+        inputDataBuffer.resize( averageTemplateLength, numInputDimensions, 0 );
+    }
+    
+    //Add the new input to the circular buffer
+    inputDataBuffer.push_back( &inputVector[0] );
+    
+    if( inputDataBuffer.getNumValuesInBuffer() < averageTemplateLength ){
+        //We haven't got enough samples yet so can't do the prediction
+        return true;
+    }
+    
+    //Copy the data into a temporary matrix
+    const UINT M = inputDataBuffer.getNumFrames();
+    const UINT N = numInputDimensions;
+    MatrixFloat predictionTimeSeries(M,N);
+    const Float *window = inputDataBuffer.getWindow();
+    std::copy( window, window + M*N, predictionTimeSeries.getData() );
+    
+    //Run the prediction, the distance matrices and warping paths are only needed for this prediction
+    Vector< MatrixFloat > predictionDistanceMatrices;
+    Vector< Vector< IndexDist > > predictionWarpPaths;
+    return predictTimeSeries( predictionTimeSeries, predictionDistanceMatrices, predictionWarpPaths, context );
+}
+
 bool DTW::reset(){
     continuousInputDataBuffer.clear();
     if( trained ){
-        continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+        continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions,0);
         recomputeNullRejectionThresholds();
     }
     return true;
@@ -563,9 +617,13 @@ bool DTW::setModels( Vector< DTWTemplate > newTemplates ){
     return false;
 }
 
+Vector< VectorFloat > DTW::getInputDataBuffer() const{
+    return continuousInputDataBuffer.getData< VectorFloat >();
+}
+
 ////////////////////////// computeDistance ///////////////////////////////////////////
 
-Float DTW::computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath){
+Float DTW::computeDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath) const{
     
     const int M = timeSeriesA.getNumRows();
     const int N = timeSeriesB.getNumRows();
@@ -681,7 +739,7 @@ Float DTW::computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,Mat
     return totalDist/normFactor;
 }
 
-Float DTW::d(int m,int n,MatrixFloat &distanceMatrix,const int M,const int N){
+Float DTW::d(int m,int n,MatrixFloat &distanceMatrix,const int M,const int N) const{
     
     Float dist = 0;
     //The following is based on Matlab code by Eamonn Keogh and Michael Pazzani
@@ -802,7 +860,7 @@ void DTW::scaleData(TimeSeriesClassificationData &trainingData){
     
 }
 
-void DTW::scaleData(MatrixFloat &data,MatrixFloat &scaledData){
+void DTW::scaleData(const MatrixFloat &data,MatrixFloat &scaledData) const{
     
     const UINT R = data.getNumRows();
     const UINT C = data.getNumCols();
@@ -826,7 +884,7 @@ void DTW::znormData(TimeSeriesClassificationData &trainingData){
     
 }
 
-void DTW::znormData(MatrixFloat &data,MatrixFloat &normData){
+void DTW::znormData(const MatrixFloat &data,MatrixFloat &normData) const{
     
     const UINT R = data.getNumRows();
     const UINT C = data.getNumCols();
@@ -860,7 +918,7 @@ void DTW::znormData(MatrixFloat &data,MatrixFloat &normData){
     }
 }
 
-void DTW::smoothData(VectorFloat &data,UINT smoothFactor,VectorFloat &resultsData){
+void DTW::smoothData(const VectorFloat &data,UINT smoothFactor,VectorFloat &resultsData) const{
     
     const UINT M = (UINT)data.size();
     const UINT N = (UINT) floor(Float(M)/Float(smoothFactor));
@@ -894,7 +952,7 @@ void DTW::smoothData(VectorFloat &data,UINT smoothFactor,VectorFloat &resultsDat
     
 }
 
-void DTW::smoothData(MatrixFloat &data,UINT smoothFactor,MatrixFloat &resultsData){
+void DTW::smoothData(const MatrixFloat &data,UINT smoothFactor,MatrixFloat &resultsData) const{
     
     const UINT M = data.getNumRows();
     const UINT C = data.getNumCols();
@@ -1217,7 +1275,7 @@ bool DTW::load( std::fstream &file ){
         
         //Resize the prediction results to make sure it is setup for realtime prediction
         continuousInputDataBuffer.clear();
-        continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+        continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions,0);
         maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
         bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
         classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
@@ -1278,7 +1336,7 @@ bool DTW::enableTrimTrainingData(bool trimTrainingData,Float trimThreshold,Float
     return true;
 }
 
-void DTW::offsetTimeseries(MatrixFloat &timeseries){
+void DTW::offsetTimeseries(MatrixFloat &timeseries) const{
     VectorFloat firstRow = timeseries.getRow(0);
     for(UINT i=0; i<timeseries.getNumRows(); i++){
         for(UINT j=0; j<timeseries.getNumCols(); j++){
@@ -1525,7 +1583,7 @@ bool DTW::loadLegacyModelFromFile( std::fstream &file ){
     
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
-    continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+    continuousInputDataBuffer.resize(averageTemplateLength,numInputDimensions,0);
     maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
     bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
     classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
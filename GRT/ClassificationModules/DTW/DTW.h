@@ -310,7 +310,7 @@ public:
     
     @return returns a vector of VectorFloats containing the current data in the DTW circular buffer
     */
-    Vector< VectorFloat > getInputDataBuffer() const { return continuousInputDataBuffer.getData(); }
+    Vector< VectorFloat > getInputDataBuffer() const;
     
     /**
     Gets the distances matrices from the last prediction.  Each element in the vector represents the distance matrices for each corresponding class.
@@ -343,19 +343,23 @@ protected:
     //Public training and prediction methods
     bool train_NDDTW(TimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex);
     
+    //The const prediction methods, these store the results in the context so the templates can be shared by several streams
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    bool predictTimeSeries(MatrixFloat &inputTimeSeries,Vector< MatrixFloat > &distanceMatrices,Vector< Vector< IndexDist > > &warpPaths,PredictionContext &context) const;
+    
     //The actual DTW function
-    Float computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath);
-    Float d(int m,int n,MatrixFloat &distanceMatrix,const int M,const int N);
+    Float computeDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath) const;
+    Float d(int m,int n,MatrixFloat &distanceMatrix,const int M,const int N) const;
     Float inline MIN_(Float a,Float b, Float c);
     
     //Private Scaling and Utility Functions
     void scaleData(TimeSeriesClassificationData &trainingData);
-    void scaleData(MatrixFloat &data,MatrixFloat &scaledData);
+    void scaleData(const MatrixFloat &data,MatrixFloat &scaledData) const;
     void znormData(TimeSeriesClassificationData &trainingData);
-    void znormData(MatrixFloat &data,MatrixFloat &normData);
-    void smoothData(VectorFloat &data,UINT smoothFactor,VectorFloat &resultsData);
-    void smoothData(MatrixFloat &data,UINT smoothFactor,MatrixFloat &resultsData);
-    void offsetTimeseries(MatrixFloat &timeseries);
+    void znormData(const MatrixFloat &data,MatrixFloat &normData) const;
+    void smoothData(const VectorFloat &data,UINT smoothFactor,VectorFloat &resultsData) const;
+    void smoothData(const MatrixFloat &data,UINT smoothFactor,MatrixFloat &resultsData) const;
+    void offsetTimeseries(MatrixFloat &timeseries) const;
     bool loadLegacyModelFromFile( std::fstream &file );
     
     static RegisterClassifierModule< DTW > registerModule;
@@ -364,7 +368,7 @@ protected:
     Vector< DTWTemplate > templatesBuffer;      //A buffer to store the templates for each time series
     Vector< MatrixFloat > distanceMatrices;
     Vector< Vector< IndexDist > > warpPaths;
-    CircularBuffer< VectorFloat > continuousInputDataBuffer;
+    MultichannelCircularBuffer< Float > continuousInputDataBuffer;
     UINT                numTemplates;           //The number of templates in our buffer
     UINT                rejectionMode;          //The rejection mode used to reject null gestures during the prediction phase
     
@@ -395,4 +399,4 @@ public:
 GRT_END_NAMESPACE
 
 #endif //GRT_DTW_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
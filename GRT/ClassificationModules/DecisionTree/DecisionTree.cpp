@@ -903,6 +903,20 @@ DecisionTreeNode* DecisionTree::buildTree(ClassificationData &trainingData,Decis
         }else lhs.addSample(trainingData[i].getClassLabel(), trainingData[i].getSample());
     }
     
+    //If the split did not separate the data then make this a leaf node, otherwise the node would have a child that is NULL
+    if( lhs.getNumSamples() == 0 || rhs.getNumSamples() == 0 ){
+        
+        node->setLeafNode( M, classProbs );
+        
+        if( useNullRejection ){
+            nodeClusters[ nodeID ] = trainingData.getMean();
+        }
+        
+        Classifier::trainingLog << "Reached leaf node, the split did not separate the data. Depth: " << depth << " NumSamples: " << M << std::endl;
+        
+        return node;
+    }
+    
     //Clear the parent dataset so we do not run out of memory with very large datasets (with very deep trees)
     trainingData.clear();
     
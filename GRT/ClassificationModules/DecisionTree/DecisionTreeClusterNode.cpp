@@ -20,6 +20,10 @@ DecisionTreeClusterNode::~DecisionTreeClusterNode(){
 }
 
 bool DecisionTreeClusterNode::predict(const VectorFloat &x) {
+    return getSplitDecision( x );
+}
+
+bool DecisionTreeClusterNode::getSplitDecision(const VectorFloat &x) const{
 
     if( x[ featureIndex ] >= threshold ) return true;
 
@@ -374,5 +378,47 @@ bool DecisionTreeClusterNode::loadParametersFromFile( std::fstream &file ){
     return true;
 }
 
+bool DecisionTreeClusterNode::saveParametersToBinaryFile( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    //Save the DecisionTreeNode parameters
+    if( !DecisionTreeNode::saveParametersToBinaryFile( file ) ){
+        errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - Failed to save DecisionTreeNode parameters to file!" << std::endl;
+        return false;
+    }
+    
+    //Save the custom DecisionTreeClusterNode parameters
+    file.writeUInt( featureIndex );
+    file.writeFloat( threshold );
+    
+    return true;
+}
+
+bool DecisionTreeClusterNode::loadParametersFromBinaryFile( BinaryModelReader &file ){
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    //Load the DecisionTreeNode parameters
+    if( !DecisionTreeNode::loadParametersFromBinaryFile( file ) ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to load DecisionTreeNode parameters from file!" << std::endl;
+        return false;
+    }
+    
+    //Load the custom DecisionTreeClusterNode parameters
+    if( !file.readUInt( featureIndex ) || !file.readFloat( threshold ) ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to read the DecisionTreeClusterNode parameters!" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
 GRT_END_NAMESPACE
 
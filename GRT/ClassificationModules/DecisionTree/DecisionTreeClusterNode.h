@@ -64,6 +64,15 @@ public:
      */
     virtual bool predict(const VectorFloat &x);
     
+    /**
+     This function returns true if the input should be passed to the right child of this node (i.e. the same result as the predict function),
+     without changing the node.
+     
+     @param x: the input Vector that will be used for the split
+     @return returns true if the input should be passed to the right child, false otherwise
+     */
+    virtual bool getSplitDecision(const VectorFloat &x) const;
+    
     /**
      This functions cleans up any dynamic memory assigned by the node.
      It will recursively clear the memory for the left and right child nodes.
@@ -173,6 +182,23 @@ protected:
      */
     virtual bool loadParametersFromFile( std::fstream &file );
     
+    /**
+     This saves the DecisionTreeClusterNode custom parameters to a binary file. It will be called automatically by the Node base class
+     if the saveBinary function is called.
+     
+     @param file: a reference to the binary file the parameters will be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveParametersToBinaryFile( BinaryModelWriter &file ) const;
+    
+    /**
+     This loads the DecisionTreeClusterNode parameters from a binary file.
+     
+     @param file: a reference to the binary file the parameters will be loaded from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadParametersFromBinaryFile( BinaryModelReader &file );
+    
     UINT featureIndex;
     Float threshold;
     
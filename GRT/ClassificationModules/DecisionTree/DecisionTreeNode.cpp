@@ -55,6 +55,27 @@ bool DecisionTreeNode::predict(const VectorFloat &x,VectorFloat &classLikelihood
     return false;
 }
 
+bool DecisionTreeNode::predictClassProbabilities(const VectorFloat &x,VectorFloat &classLikelihoods) const{
+    
+    const DecisionTreeNode *node = this;
+    while( !node->isLeafNode ){
+        const Node *child = node->getSplitDecision( x ) ? node->rightChild : node->leftChild;
+        if( child == NULL ) return false;
+        
+        //The children of a decision tree node are always decision tree nodes
+        node = static_cast< const DecisionTreeNode* >( child );
+    }
+    
+    classLikelihoods = node->classProbabilities;
+    
+    return true;
+}
+
+bool DecisionTreeNode::getSplitDecision(const VectorFloat &x) const{
+    warningLog << "getSplitDecision(const VectorFloat &x) - Base class not overwritten!" << std::endl;
+    return false;
+}
+
 bool DecisionTreeNode::computeBestSpilt( const UINT &trainingMode, const UINT &numSplittingSteps,const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
     
     switch( trainingMode ){
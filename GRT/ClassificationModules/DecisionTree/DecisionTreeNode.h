@@ -64,6 +64,25 @@ public:
      */
     virtual bool predict(const VectorFloat &x,VectorFloat &classLikelihoods);
     
+    /**
+     This function predicts the class probabilities of the input Vector, by walking down the tree until a leaf node is reached.
+     Unlike the predict function, this does not update the predictedNodeID of any node, so one tree can be used by several threads at once.
+     
+     @param x: the input Vector that will be used for the prediction
+     @param classLikelihoods: a reference to a Vector that will store the class probabilities
+     @return returns true if a leaf node was reached, false otherwise
+     */
+    bool predictClassProbabilities(const VectorFloat &x,VectorFloat &classLikelihoods) const;
+    
+    /**
+     This function returns true if the input Vector should be passed to the right child of this node, false if it should be passed to the left child.
+     This should be overwritten by the derived class.
+     
+     @param x: the input Vector that will be used for the split
+     @return returns true if the input should be passed to the right child, false otherwise
+     */
+    virtual bool getSplitDecision(const VectorFloat &x) const;
+    
     /**
      This function calls the best spliting algorithm based on the current trainingMode.  
      
@@ -258,6 +277,45 @@ protected:
         return true;
     }
     
+    /**
+     This saves the DecisionTreeNode custom parameters to a binary file.
+     
+     @param file: a reference to the binary file the parameters will be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveParametersToBinaryFile( BinaryModelWriter &file ) const{
+        
+        if( !file.getIsOpen() ){
+            errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - File is not open!" << std::endl;
+            return false;
+        }
+        
+        //Save the custom DecisionTreeNode parameters
+        file.writeUInt( nodeSize );
+        return file.writeVector( classProbabilities );
+    }
+    
+    /**
+     This loads the Decision Tree Node parameters from a binary file.
+     
+     @param file: a reference to the binary file the parameters will be loaded from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadParametersFromBinaryFile( BinaryModelReader &file ){
+        
+        if( !file.getIsOpen() ){
+            errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - File is not open!" << std::endl;
+            return false;
+        }
+        
+        if( !file.readUInt( nodeSize ) || !file.readVector( classProbabilities ) ){
+            errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to read the node parameters!" << std::endl;
+            return false;
+        }
+        
+        return true;
+    }
+    
     UINT nodeSize;
     VectorFloat classProbabilities;
     
@@ -20,6 +20,10 @@ DecisionTreeThresholdNode::~DecisionTreeThresholdNode(){
 }
 
 bool DecisionTreeThresholdNode::predict(const VectorFloat &x) {
+    return getSplitDecision( x );
+}
+
+bool DecisionTreeThresholdNode::getSplitDecision(const VectorFloat &x) const{
 
     if( x[ featureIndex ] >= threshold ) return true;
     
@@ -337,5 +341,47 @@ bool DecisionTreeThresholdNode::loadParametersFromFile( std::fstream &file ){
     return true;
 }
 
+bool DecisionTreeThresholdNode::saveParametersToBinaryFile( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    //Save the DecisionTreeNode parameters
+    if( !DecisionTreeNode::saveParametersToBinaryFile( file ) ){
+        errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - Failed to save DecisionTreeNode parameters to file!" << std::endl;
+        return false;
+    }
+    
+    //Save the custom DecisionTreeThresholdNode parameters
+    file.writeUInt( featureIndex );
+    file.writeFloat( threshold );
+    
+    return true;
+}
+
+bool DecisionTreeThresholdNode::loadParametersFromBinaryFile( BinaryModelReader &file ){
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    //Load the DecisionTreeNode parameters
+    if( !DecisionTreeNode::loadParametersFromBinaryFile( file ) ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to load DecisionTreeNode parameters from file!" << std::endl;
+        return false;
+    }
+    
+    //Load the custom DecisionTreeThresholdNode parameters
+    if( !file.readUInt( featureIndex ) || !file.readFloat( threshold ) ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to read the DecisionTreeThresholdNode parameters!" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
 GRT_END_NAMESPACE
 
@@ -20,6 +20,10 @@ DecisionTreeTripleFeatureNode::~DecisionTreeTripleFeatureNode(){
 }
 
 bool DecisionTreeTripleFeatureNode::predict(const VectorFloat &x) {
+    return getSplitDecision( x );
+}
+
+bool DecisionTreeTripleFeatureNode::getSplitDecision(const VectorFloat &x) const{
 
     if( (x[ featureIndexA ] - x[ featureIndexB ]) >= (x[ featureIndexC ] - x[ featureIndexB ]) ) return true;
 
@@ -293,6 +297,49 @@ bool DecisionTreeTripleFeatureNode::loadParametersFromFile( std::fstream &file )
     return true;
 }
 
+bool DecisionTreeTripleFeatureNode::saveParametersToBinaryFile( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    //Save the DecisionTreeNode parameters
+    if( !DecisionTreeNode::saveParametersToBinaryFile( file ) ){
+        errorLog << "saveParametersToBinaryFile(BinaryModelWriter &file) - Failed to save DecisionTreeNode parameters to file!" << std::endl;
+        return false;
+    }
+    
+    //Save the custom DecisionTreeTripleFeatureNode parameters
+    file.writeUInt( featureIndexA );
+    file.writeUInt( featureIndexB );
+    file.writeUInt( featureIndexC );
+    
+    return true;
+}
+
+bool DecisionTreeTripleFeatureNode::loadParametersFromBinaryFile( BinaryModelReader &file ){
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    //Load the DecisionTreeNode parameters
+    if( !DecisionTreeNode::loadParametersFromBinaryFile( file ) ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to load DecisionTreeNode parameters from file!" << std::endl;
+        return false;
+    }
+    
+    //Load the custom DecisionTreeTripleFeatureNode parameters
+    if( !file.readUInt( featureIndexA ) || !file.readUInt( featureIndexB ) || !file.readUInt( featureIndexC ) ){
+        errorLog << "loadParametersFromBinaryFile(BinaryModelReader &file) - Failed to read the DecisionTreeTripleFeatureNode parameters!" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
 GRT_END_NAMESPACE
 
 
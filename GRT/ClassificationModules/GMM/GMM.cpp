@@ -400,7 +400,7 @@ bool GMM::load( std::fstream &file ){
         for(UINT k=0; k<numClasses; k++){
             UINT classLabel = 0;
             UINT K = 0;
-            Float normalizationFactor;
+            AccumFloat normalizationFactor;
             Float trainingMu;
             Float trainingSigma;
             Float rejectionThreshold;
@@ -672,7 +672,7 @@ bool GMM::loadLegacyModelFromFile( std::fstream &file ){
     for(UINT k=0; k<numClasses; k++){
         UINT classLabel = 0;
         UINT K = 0;
-        Float normalizationFactor;
+        AccumFloat normalizationFactor;
         Float trainingMu;
         Float trainingSigma;
         Float rejectionThreshold;
@@ -73,7 +73,7 @@ public:
         return true;
     }
     
-    Float det;
+    AccumFloat det;
     VectorFloat mu;
     MatrixFloat sigma;
     MatrixFloat invSigma;
@@ -103,12 +103,12 @@ public:
     }
     
     Float computeMixtureLikelihood( const VectorFloat &x ){
-        Float sum = 0;
+        AccumFloat sum = 0;
         for(UINT k=0; k<K; k++){
             sum += gauss(x,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
         }
         //Normalize the mixture likelihood
-        return sum/normFactor;
+        return Float( sum/normFactor );
     }
     
     bool resize(UINT K){
@@ -170,7 +170,7 @@ public:
         return nullRejectionThreshold;
     }
     
-    Float getNormalizationFactor() const {
+    AccumFloat getNormalizationFactor() const {
         return normFactor;
     }
     
@@ -179,7 +179,7 @@ public:
         return true;
     }
     
-    bool setNormalizationFactor(const Float normFactor){
+    bool setNormalizationFactor(const AccumFloat normFactor){
         this->normFactor = normFactor;
         return true;
     }
@@ -196,10 +196,11 @@ public:
     }
     
 private:
-    Float gauss(const VectorFloat &x,Float det,const VectorFloat &mu,const MatrixFloat &invSigma){
+    //The determinant and the density can be far outside of the range of a float for high dimensional data, so they are computed in double
+    AccumFloat gauss(const VectorFloat &x,AccumFloat det,const VectorFloat &mu,const MatrixFloat &invSigma){
         
-        Float y = 0;
-        Float sum = 0;
+        AccumFloat y = 0;
+        AccumFloat sum = 0;
         const UINT N = x.getSize();
         VectorFloat temp(N,0);
         
@@ -211,10 +212,10 @@ private:
             for(UINT j=0; j<N; j++){
                 temp[i] += (x[j]-mu[j]) * invSigma[j][i];
             }
-            sum += (x[i]-mu[i]) * temp[i];
+            sum += AccumFloat(x[i]-mu[i]) * temp[i];
         }
         
-        return y*grt_exp( -0.5*sum );
+        return y*exp( -0.5*sum );
     }
     
     UINT classLabel;
@@ -223,7 +224,7 @@ private:
     Float gamma;                           //The number of standard deviations to use for the threshold
     Float trainingMu;                      //The average confidence value in the training data
     Float trainingSigma;                   //The simga confidence value in the training data
-    Float normFactor;
+    AccumFloat normFactor;
     Vector< GuassModel > gaussModels;
     
 };
@@ -121,14 +121,11 @@ bool ContinuousHiddenMarkovModel::predict_(VectorFloat &x){
     }
     
     //Add the new sample to the circular buffer
-    observationSequence.push_back( x );
+    observationSequence.push_back( &x[0] );
     
-    //Convert the circular buffer to MatrixFloat
-    for(unsigned int i=0; i<observationSequence.getSize(); i++){
-        for(unsigned int j=0; j<numInputDimensions; j++){
-            obsSequence[i][j] = observationSequence[i][j];
-        }
-    }
+    //Convert the circular buffer to MatrixFloat, the buffered frames are contiguous so this is a single block copy
+    const Float *window = observationSequence.getWindow();
+    std::copy( window, window + observationSequence.getNumFrames()*numInputDimensions, obsSequence.getData() );
     
     return predict_( obsSequence );
 }
@@ -147,6 +144,7 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
     
     unsigned int t,i,j,k,index = 0;
     Float maxAlpha = 0;
+    AccumFloat scale = 0;
     Float norm = 0;
     
     //Downsample the observation timeseries using the same downsample factor of the training data
@@ -177,12 +175,13 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
     
     ////////////////// Run the forward algorithm ////////////////////////
     //Step 1: Init at t=0
+    //The scaling sums are accumulated in double precision, so they do not lose precision if Float is single precision
     t = 0;
-    c[t] = 0;
+    scale = 0;
     maxAlpha = 0;
     for(i=0; i<numStates; i++){
         alpha[t][i] = pi[i]*gauss(b,obs,sigmaStates,i,t,numInputDimensions);
-        c[t] += alpha[t][i];
+        scale += alpha[t][i];
         
         //Keep track of the best state at time t
         if( alpha[t][i] > maxAlpha ){
@@ -192,22 +191,22 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
     }
     
     //Set the inital scaling coeff
-    c[t] = 1.0/c[t];
+    c[t] = Float( 1.0/scale );
     
     //Scale alpha
     for(i=0; i<numStates; i++) alpha[t][i] *= c[t];
     
     //Step 2: Induction
     for(t=1; t<T; t++){
-        c[t] = 0.0;
+        scale = 0.0;
         maxAlpha = 0;
         for(j=0; j<numStates; j++){
-            alpha[t][j] = 0.0;
+            AccumFloat sum = 0.0;
             for(i=0; i<numStates; i++){
-                alpha[t][j] +=  alpha[t-1][i] * a[i][j];
+                sum +=  AccumFloat(alpha[t-1][i]) * a[i][j];
             }
-            alpha[t][j] *= gauss(b,obs,sigmaStates,j,t,numInputDimensions);
-            c[t] += alpha[t][j];
+            alpha[t][j] = Float( sum * gauss(b,obs,sigmaStates,j,t,numInputDimensions) );
+            scale += alpha[t][j];
             
             //Keep track of the best state at time t
             if( alpha[t][j] > maxAlpha ){
@@ -217,16 +216,16 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
         }
         
         //Set the scaling coeff
-        c[t] = 1.0/c[t];
+        c[t] = Float( 1.0/scale );
         
         //Scale Alpha
         for(j=0; j<numStates; j++) alpha[t][j] *= c[t];
     }
     
     //Termination
-    loglikelihood = 0.0;
-    for(t=0; t<T; t++) loglikelihood += log( c[t] );
-    loglikelihood = -loglikelihood; //Store the negative log likelihood
+    AccumFloat sumLogScale = 0.0;
+    for(t=0; t<T; t++) sumLogScale += log( AccumFloat(c[t]) );
+    loglikelihood = Float( -sumLogScale ); //Store the negative log likelihood
     
     //Set the phase as the last estimated state, this will give a phase between [0 1]
     phase = (estimatedStates[T-1]+1.0)/Float(numStates);
@@ -360,7 +359,7 @@ bool ContinuousHiddenMarkovModel::train_(TimeSeriesClassificationSample &trainin
     }
     
     //Setup the observation buffer for prediction
-    observationSequence.resize( timeseriesLength, VectorFloat(numInputDimensions,0) );
+    observationSequence.resize( timeseriesLength, numInputDimensions, 0 );
     obsSequence.resize(timeseriesLength,numInputDimensions);
     estimatedStates.resize( numStates );
     
@@ -376,9 +375,7 @@ bool ContinuousHiddenMarkovModel::reset(){
     MLBase::reset();
     
     if( trained ){
-        for(unsigned int i=0; i<observationSequence.getSize(); i++){
-            observationSequence.push_back( VectorFloat(numInputDimensions,0) );
-        }
+        observationSequence.fill( 0 );
     }
     
     return true;
@@ -726,7 +723,7 @@ bool ContinuousHiddenMarkovModel::load( std::fstream &file ){
         }
         
         //Setup the observation buffer for prediction
-        observationSequence.resize( timeseriesLength, VectorFloat(numInputDimensions,0) );
+        observationSequence.resize( timeseriesLength, numInputDimensions, 0 );
         obsSequence.resize(timeseriesLength,numInputDimensions);
         estimatedStates.resize( numStates );
     }
@@ -148,7 +148,7 @@ class GRT_API ContinuousHiddenMarkovModel : public MLBase {
     VectorFloat pi;            ///<The state start probability vector
     MatrixFloat alpha;
     VectorFloat c;
-    CircularBuffer< VectorFloat > observationSequence; ///<A buffer to store data for realtime prediction
+    MultichannelCircularBuffer< Float > observationSequence; ///<A buffer to store data for realtime prediction
     MatrixFloat obsSequence;
     Vector< UINT > estimatedStates; ///<The estimated states for prediction
     MatrixFloat sigmaStates; ///<The sigma value for each state
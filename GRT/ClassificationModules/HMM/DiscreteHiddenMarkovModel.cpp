@@ -201,53 +201,64 @@ Float DiscreteHiddenMarkovModel::predict(const UINT newSample){
         return 0;
     }
     
-    observationSequence.push_back( newSample );
+    if( !observationSequence.push_back( &newSample ) ){
+        return 0;
+    }
+    
+    //The most recent observations are contiguous in the buffer, so they can be used without copying them
+    const UINT numObs = observationSequence.getNumValuesInBuffer();
+    return predict( observationSequence.getWindow( numObs ), numObs );
+}
     
-    Vector< UINT > obs = observationSequence.getData();
+Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
+    
+    if( obs.size() == 0 ) return 0;
     
-    return predict(obs);
+    return predict( &obs[0], obs.getSize() );
 }
   
 /*Float predictLogLikelihood(Vector<UINT> &obs)
  - This method computes P(O|A,B,Pi) using the forward algorithm
  */
-Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
+Float DiscreteHiddenMarkovModel::predict(const UINT *obs,const UINT numObs){
     
 	const int N = (int)numStates;
-    const int T = (int)obs.size();
+    const int T = (int)numObs;
 	int t,i,j = 0;
     MatrixFloat alpha(T,numStates);
     VectorFloat c(T);
+    AccumFloat scale = 0;
     
 	////////////////// Run the forward algorithm ////////////////////////
 	//Step 1: Init at t=0
+	//The scaling sums are accumulated in double precision, so they do not lose precision if Float is single precision
 	t = 0;
-	c[t] = 0.0;
+	scale = 0.0;
 	for(i=0; i<N; i++){
 		alpha[t][i] = pi[i]*b[i][ obs[t] ];
-		c[t] += alpha[t][i];
+		scale += alpha[t][i];
 	}
     
 	//Set the inital scaling coeff
-	c[t] = 1.0/c[t];
+	c[t] = Float( 1.0/scale );
     
 	//Scale alpha
     for(i=0; i<N; i++) alpha[t][i] *= c[t];
     
 	//Step 2: Induction
 	for(t=1; t<T; t++){
-		c[t] = 0.0;
+		scale = 0.0;
 		for(j=0; j<N; j++){
-			alpha[t][j] = 0.0;
+			AccumFloat sum = 0.0;
 			for(i=0; i<N; i++){
-				alpha[t][j] +=  alpha[t-1][i] * a[i][j];
+				sum +=  AccumFloat(alpha[t-1][i]) * a[i][j];
 			}
-            alpha[t][j] *= b[j][obs[t]];
-            c[t] += alpha[t][j];
+            alpha[t][j] = Float( sum * b[j][obs[t]] );
+            scale += alpha[t][j];
 		}
         
 		//Set the scaling coeff
-		c[t] = 1.0/c[t];
+		c[t] = Float( 1.0/scale );
         
 		//Scale Alpha
         for(j=0; j<N; j++) alpha[t][j] *= c[t];
@@ -265,9 +276,9 @@ Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
     }
     
 	//Termination
-	Float loglikelihood = 0.0;
-    for(t=0; t<T; t++) loglikelihood += log( c[t] );
-    return -loglikelihood; //Return the negative log likelihood
+	AccumFloat loglikelihood = 0.0;
+    for(t=0; t<T; t++) loglikelihood += log( AccumFloat(c[t]) );
+    return Float( -loglikelihood ); //Return the negative log likelihood
 }
 
 /*Float predictLogLikelihood(Vector<UINT> &obs)
@@ -332,44 +343,47 @@ bool DiscreteHiddenMarkovModel::forwardBackward(HMMTrainingObject &hmm,const Vec
 	const int N = (int)numStates;
 	const int T = (int)obs.size();
 	int t,i,j = 0;
+	AccumFloat scale = 0;
 
 	////////////////// Run the forward algorithm ////////////////////////
 	//Step 1: Init at t=0
+	//The scaling sums are accumulated in double precision, so they do not lose precision if Float is single precision
 	t = 0;
-	hmm.c[t] = 0.0;
+	scale = 0.0;
 	for(i=0; i<N; i++){
 		hmm.alpha[t][i] = pi[i]*b[i][ obs[t] ];
-		hmm.c[t] += hmm.alpha[t][i];
+		scale += hmm.alpha[t][i];
 	}
 
 	//Set the inital scaling coeff
-	hmm.c[t] = 1.0/hmm.c[t];
+	hmm.c[t] = Float( 1.0/scale );
 
 	//Scale alpha
     for(i=0; i<N; i++) hmm.alpha[t][i] *= hmm.c[t];
     
 	//Step 2: Induction
 	for(t=1; t<T; t++){
-		hmm.c[t] = 0.0;
+		scale = 0.0;
 		for(j=0; j<N; j++){
-			hmm.alpha[t][j] = 0.0;
+			AccumFloat sum = 0.0;
 			for(i=0; i<N; i++){
-				hmm.alpha[t][j] +=  hmm.alpha[t-1][i] * a[i][j];
+				sum +=  AccumFloat(hmm.alpha[t-1][i]) * a[i][j];
 			}
-            hmm.alpha[t][j] *= b[j][obs[t]];
-            hmm.c[t] += hmm.alpha[t][j];
+            hmm.alpha[t][j] = Float( sum * b[j][obs[t]] );
+            scale += hmm.alpha[t][j];
 		}
 
 		//Set the scaling coeff
-		hmm.c[t] = 1.0/hmm.c[t];
+		hmm.c[t] = Float( 1.0/scale );
 
 		//Scale Alpha
         for(j=0; j<N; j++) hmm.alpha[t][j] *= hmm.c[t];
 	}
 
 	//Termination
-	hmm.pk = 0.0;
-    for(t=0; t<T; t++) hmm.pk += log( hmm.c[t] );
+	AccumFloat pk = 0.0;
+    for(t=0; t<T; t++) pk += log( AccumFloat(hmm.c[t]) );
+	hmm.pk = Float( pk );
     //hmm.pk = - hmm.pk; //We don't really need to minus here
     
     if( grt_isinf(hmm.pk) ){
@@ -469,7 +483,7 @@ bool DiscreteHiddenMarkovModel::train(const Vector< Vector<UINT> > &trainingData
 	}
     
     averageObsLength = (UINT)floor( averageObsLength/Float(numObs) );
-    observationSequence.resize( averageObsLength );
+    observationSequence.resize( averageObsLength, 1 );
     estimatedStates.resize( averageObsLength );
     
     //Finally, flag that the model was trained
@@ -482,7 +496,8 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
     
     const UINT numObs = (unsigned int)obs.size();
     UINT i,j,k,t = 0;
-    Float num,denom,oldLoglikelihood = 0;
+    AccumFloat num,denom; //The re-estimation sums are accumulated in double precision, even if Float is single precision
+    Float oldLoglikelihood = 0;
     bool keepTraining = true;
     trainingIterationLog.clear();
     
@@ -564,7 +579,7 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
                         }
                     
                         //Update a[i][j]
-                        a[i][j] = num/denom;
+                        a[i][j] = Float( num/denom );
                     }
                 }else{
                     errorLog << "Denom is zero for A!" << std::endl;
@@ -595,7 +610,7 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
                     //Update b[i][j]
                     //If there are no observations at all for a state then the probabilities will be zero which is bad
                     //So instead we flag that B needs to be renormalized later
-                    if( num > 0 ) b[i][j] = denom > 0 ? num/denom : 1.0e-5;
+                    if( num > 0 ) b[i][j] = denom > 0 ? Float( num/denom ) : Float( 1.0e-5 );
                     else{ b[i][j] = 0; renormB = true; }
                 }
             }
@@ -663,9 +678,7 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
     
 bool DiscreteHiddenMarkovModel::reset(){
 
-    for(UINT i=0; i<observationSequence.getSize(); i++){
-        observationSequence.push_back( 0 );
-    }
+    observationSequence.fill( 0 );
     
     return true;
 }
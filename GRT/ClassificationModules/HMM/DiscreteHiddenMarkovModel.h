@@ -65,6 +65,7 @@ public:
     
     Float predict(const UINT newSample);
     Float predict(const Vector<UINT> &obs);
+    Float predict(const UINT *obs,const UINT numObs);
     
     bool resetModel(const UINT numStates,const UINT numSymbols,const UINT modelType,const UINT delta);
     bool train(const Vector< Vector<UINT> > &trainingData);
@@ -111,7 +112,7 @@ protected:
     UINT numRandomTrainingIterations;       //The number of training loops to find the best starting values
     Float logLikelihood;    //The log likelihood of an observation sequence given the modal, calculated by the forward method
     Float cThreshold;       //The classification threshold for this model
-    CircularBuffer<UINT> observationSequence;
+    MultichannelCircularBuffer<UINT> observationSequence;
     Vector< UINT > estimatedStates;
 };
 
@@ -307,6 +307,10 @@ bool KNN::train_(const ClassificationData &trainingData,const UINT K){
 }
 
 bool KNN::predict_(VectorFloat &inputVector){
+    return predictAndStoreResults( inputVector );
+}
+
+bool KNN::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
     
     if( !trained ){
         errorLog << "predict_(VectorFloat &inputVector) - KNN model has not been trained" << std::endl;
@@ -326,10 +330,18 @@ bool KNN::predict_(VectorFloat &inputVector){
     }
     
     //Run the prediction
-    return predict(inputVector,K);
+    return predict(inputVector,K,context);
 }
 
 bool KNN::predict(const VectorFloat &inputVector,const UINT K){
+    PredictionContext context;
+    swapPredictionResults( context );
+    bool result = predict( inputVector, K, context );
+    swapPredictionResults( context );
+    return result;
+}
+
+bool KNN::predict(const VectorFloat &inputVector,const UINT K,PredictionContext &context) const{
     
     if( !trained ){
         errorLog << "predict(VectorFloat inputVector,UINT K) - KNN model has not been trained" << std::endl;
@@ -392,6 +404,8 @@ bool KNN::predict(const VectorFloat &inputVector,const UINT K){
     }
     
     //Predict the class ID using the labels of the K nearest neighbours
+    VectorFloat &classLikelihoods = context.classLikelihoods;
+    VectorFloat &classDistances = context.classDistances;
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses);
     
@@ -440,16 +454,16 @@ bool KNN::predict(const VectorFloat &inputVector,const UINT K){
     }
     
     //Set the maximum likelihood value
-    maxLikelihood = classLikelihoods[ maxIndex ];
+    context.maxLikelihood = classLikelihoods[ maxIndex ];
     
     if( useNullRejection ){
         if( classDistances[ maxIndex ] <= nullRejectionThresholds[ maxIndex ] ){
-            predictedClassLabel = classLabels[maxIndex];
+            context.predictedClassLabel = classLabels[maxIndex];
         }else{
-            predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
+            context.predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
         }
     }else{
-        predictedClassLabel = classLabels[maxIndex];
+        context.predictedClassLabel = classLabels[maxIndex];
     }
     
     return true;
@@ -655,6 +669,138 @@ bool KNN::load( std::fstream &file ){
     return true;
 }
 
+bool KNN::saveBinary( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    //Write the header info
+    file.writeString( "GRT_KNN_BINARY_MODEL_V1.0" );
+    
+    //Write the classifier settings to the file
+    if( !Classifier::saveBaseSettingsToBinaryFile( file ) ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save classifier base settings to file!" << std::endl;
+        return false;
+    }
+    
+    file.writeUInt( K );
+    file.writeUInt( distanceMethod );
+    file.writeBool( searchForBestKValue );
+    file.writeUInt( minKSearchValue );
+    file.writeUInt( maxKSearchValue );
+    
+    if( trained ){
+        if( useNullRejection ){
+            file.writeVector( trainingMu );
+            file.writeVector( trainingSigma );
+        }
+        
+        //Write the class labels, followed by all the samples as one block so they can be loaded without parsing each value
+        const UINT numTrainingSamples = trainingData.getNumSamples();
+        Vector< UINT > labels( numTrainingSamples );
+        VectorFloat samples( numTrainingSamples * numInputDimensions );
+        for(UINT i=0; i<numTrainingSamples; i++){
+            labels[i] = trainingData[i].getClassLabel();
+            for(UINT j=0; j<numInputDimensions; j++){
+                samples[ i*numInputDimensions + j ] = trainingData[i][j];
+            }
+        }
+        file.writeVector( labels );
+        if( !file.writeFloatBlock( samples.getData(), samples.getSize() ) ){
+            errorLog << "saveBinary(BinaryModelWriter &file) - Failed to write the training data!" << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool KNN::loadBinary( BinaryModelReader &file ){
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBinary(BinaryModelReader &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    std::string header;
+    
+    //Find the file type header
+    if( !file.readString( header ) || header != "GRT_KNN_BINARY_MODEL_V1.0" ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Could not find Model File Header!" << std::endl;
+        return false;
+    }
+    
+    //Load the base settings from the file
+    if( !Classifier::loadBaseSettingsFromBinaryFile( file ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to load base settings from file!" << std::endl;
+        return false;
+    }
+    
+    if( !file.readUInt( K ) || !file.readUInt( distanceMethod ) || !file.readBool( searchForBestKValue ) ||
+        !file.readUInt( minKSearchValue ) || !file.readUInt( maxKSearchValue ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the KNN settings!" << std::endl;
+        return false;
+    }
+    
+    if( trained ){
+        
+        trainingMu.resize(numClasses,0);
+        trainingSigma.resize(numClasses,0);
+        
+        if( useNullRejection ){
+            if( !file.readVector( trainingMu ) || !file.readVector( trainingSigma ) ||
+                trainingMu.getSize() != numClasses || trainingSigma.getSize() != numClasses ){
+                errorLog << "loadBinary(BinaryModelReader &file) - Failed to read TrainingMu and TrainingSigma!" << std::endl;
+                return false;
+            }
+        }
+        
+        Vector< UINT > labels;
+        if( !file.readVector( labels ) ){
+            errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the training labels!" << std::endl;
+            return false;
+        }
+        const UINT numTrainingSamples = labels.getSize();
+        
+        //Use the samples directly from the mapped file if possible, otherwise copy them into a buffer
+        const Float *samples = NULL;
+        UINT numValues = 0;
+        VectorFloat buffer;
+        if( !file.mapFloatBlock( samples, numValues ) ){
+            buffer.resize( numTrainingSamples * numInputDimensions );
+            if( !file.readFloatBlock( buffer.getData(), buffer.getSize() ) ){
+                errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the training data!" << std::endl;
+                return false;
+            }
+            samples = buffer.getData();
+            numValues = buffer.getSize();
+        }
+        
+        if( numValues != numTrainingSamples * numInputDimensions ){
+            errorLog << "loadBinary(BinaryModelReader &file) - The size of the training data does not match the number of samples!" << std::endl;
+            return false;
+        }
+        
+        //Load the training data
+        trainingData.setNumDimensions( numInputDimensions );
+        trainingData.reserve( numTrainingSamples );
+        VectorFloat sample( numInputDimensions );
+        for(UINT i=0; i<numTrainingSamples; i++){
+            std::copy( samples + i*numInputDimensions, samples + (i+1)*numInputDimensions, sample.begin() );
+            trainingData.addSample( labels[i], sample );
+        }
+        
+        maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+        bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
+        classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
+        classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+    }
+    
+    return true;
+}
+
 bool KNN::recomputeNullRejectionThresholds(){
     
     if( !trained ){
@@ -714,7 +860,7 @@ bool KNN::setDistanceMethod(UINT distanceMethod){
     return false;
 }
 
-Float KNN::computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b){
+Float KNN::computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b) const{
     Float dist = 0;
     for(UINT j=0; j<numInputDimensions; j++){
         dist += SQR( a[j] - b[j] );
@@ -722,7 +868,7 @@ Float KNN::computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b){
     return sqrt( dist );
 }
 
-Float KNN::computeCosineDistance(const VectorFloat &a,const VectorFloat &b){
+Float KNN::computeCosineDistance(const VectorFloat &a,const VectorFloat &b) const{
     Float dist = 0;
     
     Float dotAB = 0;
@@ -740,7 +886,7 @@ Float KNN::computeCosineDistance(const VectorFloat &a,const VectorFloat &b){
     return dist;
 }
 
-Float KNN::computeManhattanDistance(const VectorFloat &a,const VectorFloat &b){
+Float KNN::computeManhattanDistance(const VectorFloat &a,const VectorFloat &b) const{
     Float dist = 0;
     
     for(UINT j=0; j<numInputDimensions; j++){
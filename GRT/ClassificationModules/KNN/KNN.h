@@ -137,6 +137,24 @@ public:
     */
     virtual bool load( std::fstream &file );
     
+    /**
+    This saves the trained KNN model to a binary model file. The training samples are stored as a single raw block.
+    This overrides the saveBinary function in the MLBase base class.
+    
+    @param file: a reference to the binary file the KNN model will be saved to
+    @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveBinary( BinaryModelWriter &file ) const;
+    
+    /**
+    This loads a trained KNN model from a binary model file.
+    This overrides the loadBinary function in the MLBase base class.
+    
+    @param file: a reference to the binary file the KNN model will be loaded from
+    @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadBinary( BinaryModelReader &file );
+    
     /**
     This recomputes the null rejection thresholds for each of the classes in the KNN model.
     This will be called automatically if the setGamma(Float gamma) function is called.
@@ -223,17 +241,21 @@ public:
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
+    using MLBase::saveBinary;
+    using MLBase::loadBinary;
     using MLBase::train_;
     using MLBase::predict_;
-    using MLBase::predict;
+    using Classifier::predict;
     
 protected:
     bool train_(const ClassificationData &trainingData,const UINT K);
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
     bool predict(const VectorFloat &inputVector,const UINT K);
+    bool predict(const VectorFloat &inputVector,const UINT K,PredictionContext &context) const;
     bool loadLegacyModelFromFile( std::fstream &file );
-    Float computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b);
-    Float computeCosineDistance(const VectorFloat &a,const VectorFloat &b);
-    Float computeManhattanDistance(const VectorFloat &a,const VectorFloat &b);
+    Float computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b) const;
+    Float computeCosineDistance(const VectorFloat &a,const VectorFloat &b) const;
+    Float computeManhattanDistance(const VectorFloat &a,const VectorFloat &b) const;
     
     UINT K;                                     ///> The number of neighbours to search for
     UINT distanceMethod;                        ///> The distance method used to compute the distance between each data point
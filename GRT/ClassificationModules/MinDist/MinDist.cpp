@@ -55,6 +55,8 @@ MinDist& MinDist::operator=(const MinDist &rhs){
         //MinDist variables
         this->numClusters = rhs.numClusters;
         this->models = rhs.models;
+        this->packedCentres = rhs.packedCentres;
+        this->classCentreOffsets = rhs.classCentreOffsets;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -72,6 +74,8 @@ bool MinDist::deepCopyFrom(const Classifier *classifier){
         
         this->numClusters = ptr->numClusters;
         this->models = ptr->models;
+        this->packedCentres = ptr->packedCentres;
+        this->classCentreOffsets = ptr->classCentreOffsets;
         
         //Classifier variables
         return copyBaseVariables( classifier );
@@ -148,13 +152,30 @@ bool MinDist::train_(ClassificationData &trainingData){
         
     }
     
+    //Pack the centres of all the models so they can be searched together at prediction time
+    packCentres();
+    
     trained = true;
     return true;
 }
 
 
 bool MinDist::predict_(VectorFloat &inputVector){
+    PredictionContext context;
+    swapPredictionResults( context );
+    context.workspace.swap( centreDistances );
+    bool result = predictWithContext_( inputVector, context );
+    context.workspace.swap( centreDistances );
+    swapPredictionResults( context );
+    return result;
+}
+
+bool MinDist::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
     
+    UINT &predictedClassLabel = context.predictedClassLabel;
+    Float &maxLikelihood = context.maxLikelihood;
+    VectorFloat &classLikelihoods = context.classLikelihoods;
+    VectorFloat &classDistances = context.classDistances;
     predictedClassLabel = 0;
     maxLikelihood = 0;
     
@@ -177,12 +198,12 @@ bool MinDist::predict_(VectorFloat &inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
+    //Compute the distance to the closest centre of each class
+    computeClassDistances( inputVector, context.workspace, classDistances );
+    
     Float sum = 0;
     Float minDist = grt_numeric_limits< Float >::max();
     for(UINT k=0; k<numClasses; k++){
-        //Compute the distance for class k
-        classDistances[k] = models[k].predict( inputVector );
-        
         //Keep track of the best value
         if( classDistances[k] < minDist ){
             minDist = classDistances[k];
@@ -211,6 +232,63 @@ bool MinDist::predict_(VectorFloat &inputVector){
     return true;
 }
 
+bool MinDist::update(const VectorFloat &sample,const UINT classLabel){
+    
+    if( !trained ){
+        errorLog << "update(const VectorFloat &sample,const UINT classLabel) - MinDist Model Not Trained!" << std::endl;
+        return false;
+    }
+    
+    if( sample.getSize() != numInputDimensions ){
+        errorLog << "update(const VectorFloat &sample,const UINT classLabel) - The size of the sample (" << sample.getSize() << ") does not match the num features in the model (" << numInputDimensions << ")" << std::endl;
+        return false;
+    }
+    
+    //Find the model for this class
+    UINT classIndex = numClasses;
+    for(UINT k=0; k<numClasses; k++){
+        if( models[k].getClassLabel() == classLabel ){
+            classIndex = k;
+            break;
+        }
+    }
+    
+    if( classIndex == numClasses ){
+        errorLog << "update(const VectorFloat &sample,const UINT classLabel) - The class label " << classLabel << " does not match any of the classes in the model! You need to retrain the model to add a new class." << std::endl;
+        return false;
+    }
+    
+    VectorFloat x = sample;
+    if( useScaling ){
+        for(UINT n=0; n<numInputDimensions; n++){
+            x[n] = grt_scale(x[n], ranges[n].minValue, ranges[n].maxValue, 0.0, 1.0);
+        }
+    }
+    
+    MinDistModel &model = models[classIndex];
+    if( !model.update( x ) ){
+        errorLog << "update(const VectorFloat &sample,const UINT classLabel) - Failed to update the model for class: " << classLabel << std::endl;
+        return false;
+    }
+    
+    //Copy the updated centres of this class back into the packed centres
+    const MatrixFloat clusters = model.getClusters();
+    const UINT numCentres = packedCentres.getNumCols();
+    const UINT offset = classCentreOffsets[classIndex];
+    Float *centres = packedCentres.getData();
+    for(UINT i=0; i<clusters.getNumRows(); i++){
+        for(UINT n=0; n<numInputDimensions; n++){
+            centres[ n*numCentres + offset + i ] = clusters[i][n];
+        }
+    }
+    
+    if( nullRejectionThresholds.getSize() == numClasses ){
+        nullRejectionThresholds[classIndex] = model.getRejectionThreshold();
+    }
+    
+    return true;
+}
+
 bool MinDist::clear(){
     
     //Clear the Classifier variables
@@ -218,6 +296,77 @@ bool MinDist::clear(){
     
     //Clear the MinDist variables
     models.clear();
+    packedCentres.clear();
+    classCentreOffsets.clear();
+    centreDistances.clear();
+    
+    return true;
+}
+
+bool MinDist::packCentres(){
+    
+    const UINT K = models.getSize();
+    
+    //Work out where the centres for each class start
+    classCentreOffsets.resize( K+1 );
+    classCentreOffsets[0] = 0;
+    for(UINT k=0; k<K; k++){
+        classCentreOffsets[k+1] = classCentreOffsets[k] + models[k].getNumClusters();
+    }
+    
+    const UINT numCentres = classCentreOffsets[K];
+    if( numCentres == 0 ){
+        packedCentres.clear();
+        centreDistances.clear();
+        return false;
+    }
+    
+    //Store the centres feature-major, so the distance to every centre can be accumulated one feature at a time
+    packedCentres.resize( numInputDimensions, numCentres );
+    centreDistances.resize( numCentres );
+    Float *centres = packedCentres.getData();
+    for(UINT k=0; k<K; k++){
+        const MatrixFloat clusters = models[k].getClusters();
+        const UINT offset = classCentreOffsets[k];
+        for(UINT i=0; i<clusters.getNumRows(); i++){
+            for(UINT n=0; n<numInputDimensions; n++){
+                centres[ n*numCentres + offset + i ] = clusters[i][n];
+            }
+        }
+    }
+    
+    return true;
+}
+
+bool MinDist::computeClassDistances(const VectorFloat &inputVector,VectorFloat &centreDistances,VectorFloat &classDistances) const{
+    
+    const UINT numCentres = packedCentres.getNumCols();
+    if( numCentres == 0 ) return false;
+    if( centreDistances.getSize() != numCentres ) centreDistances.resize( numCentres );
+    
+    Float *dist = &centreDistances[0];
+    const Float *centres = packedCentres.getData();
+    for(UINT j=0; j<numCentres; j++) dist[j] = 0;
+    
+    //Accumulate the squared distance to all the centres, one feature at a time. The inner loop runs over
+    //independent centres stored in contiguous memory, which lets the compiler vectorise it
+    for(UINT n=0; n<numInputDimensions; n++){
+        const Float x = inputVector[n];
+        const Float *c = centres + n*numCentres;
+        for(UINT j=0; j<numCentres; j++){
+            const Float d = c[j] - x;
+            dist[j] += d * d;
+        }
+    }
+    
+    //The distance for each class is the distance to its closest centre, only compute the sqrt for the minimum distance
+    for(UINT k=0; k<numClasses; k++){
+        Float minDist = grt_numeric_limits< Float >::max();
+        for(UINT j=classCentreOffsets[k]; j<classCentreOffsets[k+1]; j++){
+            if( dist[j] < minDist ) minDist = dist[j];
+        }
+        classDistances[k] = sqrt( minDist );
+    }
     
     return true;
 }
@@ -229,6 +378,10 @@ bool MinDist::recomputeNullRejectionThresholds(){
             models[k].setGamma( nullRejectionCoeff );
             models[k].recomputeThresholdValue();
         }
+        nullRejectionThresholds.resize( numClasses );
+        for(UINT k=0; k<numClasses; k++){
+            nullRejectionThresholds[k] = models[k].getRejectionThreshold();
+        }
         return true;
     }
     return false;
@@ -252,6 +405,10 @@ Vector< MinDistModel > MinDist::getModels() const {
     return models;
 }
 
+const MatrixFloat& MinDist::getPackedCentres() const {
+    return packedCentres;
+}
+
 bool MinDist::save( std::fstream &file ) const{
     
     if(!file.is_open())
@@ -261,7 +418,7 @@ bool MinDist::save( std::fstream &file ) const{
     }
     
     //Write the header info
-    file<<"GRT_MINDIST_MODEL_FILE_V2.0\n";
+    file<<"GRT_MINDIST_MODEL_FILE_V3.0\n";
     
     //Write the classifier settings to the file
     if( !Classifier::saveBaseSettingsToFile(file) ){
@@ -287,6 +444,13 @@ bool MinDist::save( std::fstream &file ) const{
                 }
                 file << std::endl;
             }
+            file << "ClusterCounts:";
+            Vector< UINT > clusterCounts = models[k].getClusterCounts();
+            for(UINT i=0; i<models[k].getNumClusters(); i++){
+                //Models loaded from older files do not have any cluster counts
+                file << " " << (i < clusterCounts.getSize() ? clusterCounts[i] : 1);
+            }
+            file << std::endl;
         }
         
     }
@@ -314,8 +478,9 @@ bool MinDist::load( std::fstream &file ){
         return loadLegacyModelFromFile( file );
     }
     
-    //Find the file type header
-    if(word != "GRT_MINDIST_MODEL_FILE_V2.0"){
+    //Find the file type header, V2.0 files are the same as V3.0 but without the cluster counts
+    const bool hasClusterCounts = word == "GRT_MINDIST_MODEL_FILE_V3.0";
+    if(word != "GRT_MINDIST_MODEL_FILE_V2.0" && !hasClusterCounts){
         errorLog << "load(string filename) - Could not find Model File Header" << std::endl;
         return false;
     }
@@ -397,6 +562,19 @@ bool MinDist::load( std::fstream &file ){
             
             models[k].setClassLabel( classLabels[k] );
             models[k].setClusters( clusters );
+            
+            if( hasClusterCounts ){
+                file >> word;
+                if( word != "ClusterCounts:" ){
+                    errorLog << "load(string filename) - Could not load the ClusterCounts for class " << k << std::endl;
+                    return false;
+                }
+                Vector< UINT > clusterCounts(numClusters);
+                for(UINT i=0; i<numClusters; i++){
+                    file >> clusterCounts[i];
+                }
+                models[k].setClusterCounts( clusterCounts );
+            }
             models[k].setGamma( gamma );
             models[k].setRejectionThreshold( rejectionThreshold );
             models[k].setTrainingSigma( trainingSigma );
@@ -406,6 +584,9 @@ bool MinDist::load( std::fstream &file ){
         //Recompute the null rejection thresholds
         recomputeNullRejectionThresholds();
         
+        //Pack the centres of all the models
+        packCentres();
+        
         //Resize the prediction results to make sure it is setup for realtime prediction
         maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
         bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
@@ -550,6 +731,9 @@ bool MinDist::loadLegacyModelFromFile( std::fstream &file ){
     //Recompute the null rejection thresholds
     recomputeNullRejectionThresholds();
     
+    //Pack the centres of all the models
+    packCentres();
+    
     //Resize the prediction results to make sure it is setup for realtime prediction
     maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
     bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
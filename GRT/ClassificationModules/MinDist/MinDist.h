@@ -98,6 +98,18 @@ class GRT_API MinDist : public Classifier
     */
     virtual bool predict_(VectorFloat &inputVector);
     
+    /**
+    This incrementally updates the trained MinDist model with a new labelled sample, without retraining the model.
+    The closest cluster of the sample's class is moved towards the sample, and the null rejection threshold of
+    that class is updated to reflect the new sample. The sample will be scaled if useScaling is enabled, using
+    the ranges computed during the training phase.
+    
+    @param sample: the new sample, this must have the same number of dimensions as the training data
+    @param classLabel: the class label of the sample, this must match one of the classes in the trained model
+    @return returns true if the model was updated, false otherwise
+    */
+    bool update(const VectorFloat &sample,const UINT classLabel);
+    
     /**
     This overrides the clear function in the Classifier base class.
     It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -147,6 +159,15 @@ class GRT_API MinDist : public Classifier
     */
     Vector< MinDistModel > getModels() const;
     
+    /**
+    Returns the cluster centres of all the classes, packed into one contiguous matrix.
+    The matrix is stored feature-major, with one row per input dimension and one column per cluster centre,
+    and the centres of each class stored in consecutive columns (following the order of the models).
+    
+    @return returns the packed cluster centres
+    */
+    const MatrixFloat& getPackedCentres() const;
+    
     /**
     Sets the nullRejectionCoeff parameter.
     The nullRejectionCoeff parameter is a multipler controlling the null rejection threshold for each class.
@@ -180,9 +201,15 @@ class GRT_API MinDist : public Classifier
     
     protected:
     bool loadLegacyModelFromFile( std::fstream &file );
+    bool packCentres();
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    bool computeClassDistances(const VectorFloat &inputVector,VectorFloat &centreDistances,VectorFloat &classDistances) const;
     
     UINT numClusters;
     Vector< MinDistModel > models;            //A buffer to hold all the models
+    MatrixFloat packedCentres;                //The centres of all the models, stored feature-major [numInputDimensions x numCentres]
+    Vector< UINT > classCentreOffsets;        //The first column in packedCentres for each class, with the total number of centres at the end
+    VectorFloat centreDistances;              //A buffer for the squared distance to each centre
     static std::string id;
     
     private:
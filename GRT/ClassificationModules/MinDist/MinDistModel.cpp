@@ -40,6 +40,7 @@ MinDistModel::MinDistModel(const MinDistModel &rhs){
     this->trainingMu = rhs.trainingMu;
     this->trainingSigma = rhs.trainingSigma;
     this->clusters = rhs.clusters;
+    this->clusterCounts = rhs.clusterCounts;
 }
     
 MinDistModel::~MinDistModel(void){}
@@ -55,6 +56,7 @@ MinDistModel& MinDistModel:: operator=(const MinDistModel &rhs){
 		this->trainingMu = rhs.trainingMu;
 		this->trainingSigma = rhs.trainingSigma;
 		this->clusters = rhs.clusters;
+		this->clusterCounts = rhs.clusterCounts;
 	}
 	return *this;
 }
@@ -80,6 +82,7 @@ bool MinDistModel::train(UINT classLabel,MatrixFloat &trainingData,UINT numClust
 	}
 	
 	clusters = kmeans.getClusters();
+	clusterCounts = kmeans.getClassCountVector();
     
 	//Compute the rejection thresholds
 	rejectionThreshold = 0;
@@ -118,12 +121,13 @@ bool MinDistModel::train(UINT classLabel,MatrixFloat &trainingData,UINT numClust
 Float MinDistModel::predict(const VectorFloat &inputVector){
 	
 	Float minDist = grt_numeric_limits< Float >::max();
-	Float dist = 0;
+	const Float *x = &inputVector[0];
 	
 	for(UINT k=0; k<numClusters; k++){
-		dist = 0;
+		const Float *c = clusters[k];
+		Float dist = 0;
         for(UINT n=0; n<numFeatures; n++){
-            dist += SQR( clusters[k][n]-inputVector[n] );
+            dist += SQR( c[n]-x[n] );
         }
 		if( dist < minDist )
 			minDist = dist;
@@ -131,8 +135,56 @@ Float MinDistModel::predict(const VectorFloat &inputVector){
     
     //Only compute the sqrt for the minimum distance
 	return sqrt( minDist );
-     
-    return minDist;
+}
+
+bool MinDistModel::update(const VectorFloat &sample){
+	
+	if( numClusters == 0 || sample.getSize() != numFeatures ){
+		return false;
+	}
+	
+	//Models loaded from older files do not have any cluster counts, so treat each cluster as a single sample
+	if( clusterCounts.getSize() != numClusters ){
+		clusterCounts.resize( numClusters, 1 );
+	}
+	
+	//Find the closest cluster
+	UINT closestCluster = 0;
+	Float minDist = grt_numeric_limits< Float >::max();
+	for(UINT k=0; k<numClusters; k++){
+		const Float *c = clusters[k];
+		Float dist = 0;
+		for(UINT n=0; n<numFeatures; n++){
+			dist += SQR( c[n]-sample[n] );
+		}
+		if( dist < minDist ){
+			minDist = dist;
+			closestCluster = k;
+		}
+	}
+	
+	//Move the closest cluster towards the sample, so it remains the mean of all the samples assigned to it
+	const Float eta = 1.0 / ++clusterCounts[closestCluster];
+	Float *c = clusters[closestCluster];
+	Float dist = 0;
+	for(UINT n=0; n<numFeatures; n++){
+		c[n] += eta * ( sample[n]-c[n] );
+		dist += SQR( c[n]-sample[n] );
+	}
+	dist = sqrt( dist );
+	
+	//Update the training mu and sigma with the distance of the new sample (Welford's method)
+	UINT M = 0;
+	for(UINT k=0; k<numClusters; k++) M += clusterCounts[k];
+	Float sumSquares = M > 2 ? SQR( trainingSigma ) * (M-2) : 0;
+	const Float delta = dist - trainingMu;
+	trainingMu += delta / M;
+	sumSquares += delta * ( dist - trainingMu );
+	trainingSigma = M > 1 ? sqrt( sumSquares / (M-1) ) : 0;
+	
+	recomputeThresholdValue();
+	
+	return true;
 }
 	
 void MinDistModel::recomputeThresholdValue(){
@@ -170,6 +222,10 @@ Float MinDistModel::getTrainingSigma() const{
 MatrixFloat MinDistModel::getClusters() const{
 	return clusters;
 }
+
+Vector< UINT > MinDistModel::getClusterCounts() const{
+	return clusterCounts;
+}
     
 bool MinDistModel::setClassLabel(UINT classLabel){
     this->classLabel = classLabel;
@@ -180,6 +236,15 @@ bool MinDistModel::setClusters(MatrixFloat &clusters){
     this->clusters = clusters;
 	this->numClusters = clusters.getNumRows();
 	this->numFeatures = clusters.getNumCols();
+	this->clusterCounts.clear();
+    return true;
+}
+
+bool MinDistModel::setClusterCounts(const Vector< UINT > &clusterCounts){
+    if( clusterCounts.getSize() != numClusters ){
+        return false;
+    }
+    this->clusterCounts = clusterCounts;
     return true;
 }
 
@@ -63,6 +63,16 @@ public:
 	
 	bool train(UINT classLabel,MatrixFloat &trainingData,UINT numClusters,Float minChange,UINT maxNumEpochs);
 	Float predict(const VectorFloat &observation);
+    
+    /**
+     Incrementally adapts the model to a new sample, without retraining the clusters from scratch.
+     The closest cluster is moved towards the sample using a running-mean (MacQueen) update, and the
+     training mu/sigma (and therefore the rejection threshold) are updated with the new distance.
+     
+     @param sample: the new sample, this should have the same number of features as the model
+     @return returns true if the model was updated successfully, false otherwise
+     */
+    bool update(const VectorFloat &sample);
 	void recomputeThresholdValue();
 	
 	UINT getClassLabel() const;
@@ -74,9 +84,11 @@ public:
     Float getTrainingMu() const;
     Float getTrainingSigma() const;
     MatrixFloat getClusters() const;
+    Vector< UINT > getClusterCounts() const;
     
     bool setClassLabel(UINT classLabel);
     bool setClusters(MatrixFloat &clusters);
+    bool setClusterCounts(const Vector< UINT > &clusterCounts);
     bool setGamma(Float gamma);
     bool setRejectionThreshold(Float rejectionThreshold);
     bool setTrainingSigma(Float trainingSigma);
@@ -92,6 +104,7 @@ private:
 	Float trainingMu;			//The average confidence value in the training data
 	Float trainingSigma;		//The simga confidence value in the training data
 	MatrixFloat clusters;
+	Vector< UINT > clusterCounts;	//The number of samples assigned to each cluster, used for the incremental updates
 };
 
 GRT_END_NAMESPACE
@@ -123,7 +123,50 @@ public:
         
         return true;
     }
-    
+
+    virtual bool updateBatch( VectorFloat &data, const unsigned int begin, const unsigned int end ){
+
+        //The weight is the product of one Gaussian per input dimension, so we precompute the normalization term and
+        //the exponent scale once and then only need a single exp per particle
+        Float norm = 1;
+        VectorFloat expScale( numInputDimensions );
+        for(unsigned int j=0; j<numInputDimensions; j++){
+            norm *= 1.0/(SQRT_TWO_PI*measurementNoise[j]);
+            expScale[j] = 1.0/(2.0*SQR(measurementNoise[j]));
+        }
+
+        for(unsigned int i=begin; i<end; i++){
+            Particle &p = particles[i];
+
+            //Get the gesture template
+            const unsigned int templateIndex = (unsigned int)p.x[0];
+
+            if( templateIndex >= numTemplates ){
+                errorLog << "updateBatch( VectorFloat &data, const unsigned int begin, const unsigned int end ) - Template index out of bounds! templateIndex: " << templateIndex << std::endl;
+                return false;
+            }
+
+            //Get the current position in the template
+            const MatrixFloat &timeseries = gestureTemplates[templateIndex].timeseries;
+            const unsigned int templateLength = timeseries.getNumRows();
+            const unsigned int templatePos = (unsigned int)(p.x[1] * Float(templateLength-1));
+
+            if( templatePos >= templateLength ){
+                errorLog << "updateBatch( VectorFloat &data, const unsigned int begin, const unsigned int end ) - Template position out of bounds! templatePos: " << templatePos << " templateLength: " << templateLength << std::endl;
+                return false;
+            }
+
+            const Float *mu = timeseries[templatePos];
+            Float sum = 0;
+            for(unsigned int j=0; j<numInputDimensions; j++){
+                sum += SQR( data[j] - mu[j] ) * expScale[j];
+            }
+            p.w = norm * exp( -sum );
+        }
+
+        return true;
+    }
+
     virtual bool clear(){
         
         //Clear the base class
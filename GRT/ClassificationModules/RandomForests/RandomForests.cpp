@@ -262,9 +262,13 @@ bool RandomForests::train_(ClassificationData &trainingData){
 }
 
 bool RandomForests::predict_(VectorDouble &inputVector){
+    return predictAndStoreResults( inputVector );
+}
+
+bool RandomForests::predictWithContext_(VectorDouble &inputVector,PredictionContext &context) const{
     
-    predictedClassLabel = 0;
-    maxLikelihood = 0;
+    context.predictedClassLabel = 0;
+    context.maxLikelihood = 0;
     
     if( !trained ){
         errorLog << "predict_(VectorDouble &inputVector) - Model Not Trained!" << std::endl;
@@ -282,15 +286,17 @@ bool RandomForests::predict_(VectorDouble &inputVector){
         }
     }
     
+    VectorDouble &classLikelihoods = context.classLikelihoods;
+    VectorDouble &classDistances = context.classDistances;
     if( classLikelihoods.getSize() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.getSize() != numClasses ) classDistances.resize(numClasses,0);
     
     std::fill(classDistances.begin(),classDistances.end(),0);
     
-    //Run the prediction for each tree in the forest
-    VectorDouble y;
+    //Run the prediction for each tree in the forest, the trees are not modified so the forest can be shared by several contexts
+    VectorDouble &y = context.workspace;
     for(UINT i=0; i<forestSize; i++){
-        if( !forest[i]->predict(inputVector, y) ){
+        if( !forest[i]->predictClassProbabilities(inputVector, y) ){
             errorLog << "predict_(VectorDouble &inputVector) - Tree " << i << " failed prediction!" << std::endl;
             return false;
         }
@@ -301,20 +307,20 @@ bool RandomForests::predict_(VectorDouble &inputVector){
     }
     
     //Use the class distances to estimate the class likelihoods
-    bestDistance = 0;
+    context.bestDistance = 0;
     UINT bestIndex = 0;
     Float classNorm = 1.0 / Float(forestSize);
     for(UINT k=0; k<numClasses; k++){
         classLikelihoods[k] = classDistances[k] * classNorm;
         
-        if( classLikelihoods[k] > maxLikelihood ){
-            maxLikelihood = classLikelihoods[k];
-            bestDistance = classDistances[k];
+        if( classLikelihoods[k] > context.maxLikelihood ){
+            context.maxLikelihood = classLikelihoods[k];
+            context.bestDistance = classDistances[k];
             bestIndex = k;
         }
     }
     
-    predictedClassLabel = classLabels[ bestIndex ];
+    context.predictedClassLabel = classLabels[ bestIndex ];
     
     return true;
 }
@@ -571,6 +577,143 @@ bool RandomForests::load( std::fstream &file ){
     return true;
 }
 
+bool RandomForests::saveBinary( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    //Write the header info
+    file.writeString( "GRT_RANDOM_FOREST_BINARY_MODEL_V1.0" );
+    
+    //Write the classifier settings to the file
+    if( !Classifier::saveBaseSettingsToBinaryFile( file ) ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save classifier base settings to file!" << std::endl;
+        return false;
+    }
+    
+    if( decisionTreeNode == NULL ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - The decisionTreeNode is NULL!" << std::endl;
+        return false;
+    }
+    
+    file.writeString( decisionTreeNode->getNodeType() );
+    if( !decisionTreeNode->saveBinary( file ) ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save decisionTreeNode settings to file!" << std::endl;
+        return false;
+    }
+    
+    file.writeUInt( forestSize );
+    file.writeUInt( numRandomSplits );
+    file.writeUInt( minNumSamplesPerNode );
+    file.writeUInt( maxDepth );
+    file.writeBool( removeFeaturesAtEachSpilt );
+    file.writeUInt( trainingMode );
+    file.writeBool( trained );
+    
+    if( trained ){
+        for(UINT i=0; i<forestSize; i++){
+            file.writeString( forest[i]->getNodeType() );
+            if( !forest[i]->saveBinary( file ) ){
+                errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save tree " << i << " to file!" << std::endl;
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+bool RandomForests::loadBinary( BinaryModelReader &file ){
+    
+    clear();
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBinary(BinaryModelReader &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    std::string header;
+    std::string treeNodeType;
+    
+    //Find the file type header
+    if( !file.readString( header ) || header != "GRT_RANDOM_FOREST_BINARY_MODEL_V1.0" ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Could not find Model File Header" << std::endl;
+        return false;
+    }
+    
+    //Load the base settings from the file
+    if( !Classifier::loadBaseSettingsFromBinaryFile( file ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to load base settings from file!" << std::endl;
+        return false;
+    }
+    
+    if( !file.readString( treeNodeType ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Could not find the DecisionTreeNodeType!" << std::endl;
+        return false;
+    }
+    
+    if( decisionTreeNode != NULL ){
+        delete decisionTreeNode;
+        decisionTreeNode = NULL;
+    }
+    decisionTreeNode = dynamic_cast< DecisionTreeNode* >( DecisionTreeNode::createInstanceFromString( treeNodeType ) );
+    
+    if( decisionTreeNode == NULL ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Could not create new DecisionTreeNode from type: " << treeNodeType << std::endl;
+        return false;
+    }
+    
+    if( !decisionTreeNode->loadBinary( file ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to load decisionTreeNode settings from file!" << std::endl;
+        return false;
+    }
+    
+    UINT trainingModeTmp = 0;
+    bool forestBuilt = false;
+    if( !file.readUInt( forestSize ) || !file.readUInt( numRandomSplits ) || !file.readUInt( minNumSamplesPerNode ) ||
+        !file.readUInt( maxDepth ) || !file.readBool( removeFeaturesAtEachSpilt ) || !file.readUInt( trainingModeTmp ) ||
+        !file.readBool( forestBuilt ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the forest settings!" << std::endl;
+        return false;
+    }
+    trainingMode = (Tree::TrainingMode)trainingModeTmp;
+    trained = forestBuilt;
+    
+    if( trained ){
+        //Load each tree
+        forest.reserve( forestSize );
+        for(UINT i=0; i<forestSize; i++){
+            
+            if( !file.readString( treeNodeType ) ){
+                errorLog << "loadBinary(BinaryModelReader &file) - Could not find the TreeNodeType!" << std::endl;
+                return false;
+            }
+            
+            //Create a new DTree
+            DecisionTreeNode *tree = dynamic_cast< DecisionTreeNode* >( DecisionTreeNode::createInstanceFromString( treeNodeType ) );
+            
+            if( tree == NULL ){
+                errorLog << "loadBinary(BinaryModelReader &file) - Failed to create new Tree!" << std::endl;
+                return false;
+            }
+            
+            //Add the tree to the forest first, so it will be cleaned up if the load fails
+            forest.push_back( tree );
+            
+            //Load the tree from the file
+            tree->setParent( NULL );
+            if( !tree->loadBinary( file ) ){
+                errorLog << "loadBinary(BinaryModelReader &file) - Failed to load tree from file!" << std::endl;
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
 bool RandomForests::combineModels( const RandomForests &forest ){
     
     if( !getTrained() ){
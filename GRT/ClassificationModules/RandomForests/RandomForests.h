@@ -143,6 +143,24 @@ public:
     */
     virtual bool load( std::fstream &file );
     
+    /**
+    This saves the trained RandomForests model to a binary model file.
+    This overrides the saveBinary function in the MLBase base class.
+    
+    @param file: a reference to the binary file the RandomForests model will be saved to
+    @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveBinary( BinaryModelWriter &file ) const;
+    
+    /**
+    This loads a trained RandomForests model from a binary model file.
+    This overrides the loadBinary function in the MLBase base class.
+    
+    @param file: a reference to the binary file the RandomForests model will be loaded from
+    @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadBinary( BinaryModelReader &file );
+    
     /**
     This function enables multiple random forest models to be merged together.  The model in forest will be combined
     with this instance.  For example, if this instance has 10 trees, and the other forest has 15 trees, the resulting
@@ -338,8 +356,12 @@ public:
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
+    using MLBase::saveBinary;
+    using MLBase::loadBinary;
     
 protected:
+    virtual bool predictWithContext_(VectorDouble &inputVector,PredictionContext &context) const;
+    
     
     UINT forestSize;
     UINT numRandomSplits;
@@ -360,4 +382,4 @@ private:
 GRT_END_NAMESPACE
 
 #endif //GRT_RANDOM_FORESTS_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
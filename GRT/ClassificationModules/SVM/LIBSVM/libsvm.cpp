@@ -1,5 +1,10 @@
 
 #include "libsvm.h"
+#include "../../../Util/ThreadPool.h"
+
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
 
 namespace LIBSVM {
 
@@ -53,6 +58,49 @@ static void info(const char *fmt,...)
 static void info(const char *fmt,...) {}
 #endif
 
+//
+// Thread-local random numbers and task runner
+//
+// The sub problems are trained concurrently, so they cannot share rand(). Each task instead gets a
+// seed drawn from rand() before the tasks start, which keeps the results independent of nr_thread.
+//
+static inline int svm_rand(unsigned int &state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return (int)(state & 0x7fffffff);
+}
+
+static inline unsigned int svm_seed(unsigned int seed)
+{
+	return seed == 0 ? 0x9e3779b9 : seed;
+}
+
+typedef void (*svm_task_func)(void *context, int index);
+
+// Runs func(context,i) for i in [0,n), using up to nr_thread blocks of the GRT thread pool.
+// The tasks can take very different times, so each block keeps taking the next task until they are all done.
+static void svm_run_tasks(svm_task_func func, void *context, int n, int nr_thread)
+{
+#ifdef GRT_CXX11_ENABLED
+	if(nr_thread > 1 && n > 1)
+	{
+		std::atomic<int> next(0);
+		unsigned int nr_worker = (unsigned int)min(nr_thread,n);
+		GRT::ThreadPool::parallelFor(0,nr_worker,1,[&](const unsigned int,const unsigned int)
+		{
+			for(int i=next++;i<n;i=next++)
+				func(context,i);
+			return true;
+		},nr_worker);
+		return;
+	}
+#endif
+	for(int i=0;i<n;i++)
+		func(context,i);
+}
+
 //
 // Kernel Cache
 //
@@ -1887,18 +1935,19 @@ static void multiclass_probability(int k, double **r, double *p)
 // Cross-validation decision values for probability estimates
 static void svm_binary_svc_probability(
 	const svm_problem *prob, const svm_parameter *param,
-	double Cp, double Cn, double& probA, double& probB)
+	double Cp, double Cn, double& probA, double& probB, unsigned int seed)
 {
 	int i;
 	int nr_fold = 5;
 	int *perm = Malloc(int,prob->l);
 	double *dec_values = Malloc(double,prob->l);
+	unsigned int state = svm_seed(seed);
 
 	// random shuffle
 	for(i=0;i<prob->l;i++) perm[i]=i;
 	for(i=0;i<prob->l;i++)
 	{
-		int j = i+rand()%(prob->l-i);
+		int j = i+svm_rand(state)%(prob->l-i);
 		std::swap(perm[i],perm[j]);
 	}
 	for(i=0;i<nr_fold;i++)
@@ -1945,6 +1994,7 @@ static void svm_binary_svc_probability(
 		{
 			svm_parameter subparam = *param;
 			subparam.probability=0;
+			subparam.nr_thread=1;
 			subparam.C=1.0;
 			subparam.nr_weight=2;
 			subparam.weight_label = Malloc(int,2);
@@ -2066,7 +2116,54 @@ static void svm_group_classes(const svm_problem *prob, int *nr_class_ret, int **
 //
 // Interface functions
 //
-svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
+// One-vs-one sub problem (i,j) of the classification branch of svm_train
+struct svm_pair_task
+{
+	const svm_parameter *param;
+	svm_node **x;
+	const int *start;
+	const int *count;
+	const double *weighted_C;
+	const int *pair_i;
+	const int *pair_j;
+	const unsigned int *seed;
+	decision_function *f;
+	double *probA;
+	double *probB;
+};
+
+static void svm_train_pair(void *context, int p)
+{
+	svm_pair_task *task = (svm_pair_task*)context;
+	int i = task->pair_i[p];
+	int j = task->pair_j[p];
+	svm_problem sub_prob;
+	int si = task->start[i], sj = task->start[j];
+	int ci = task->count[i], cj = task->count[j];
+	sub_prob.l = ci+cj;
+	sub_prob.x = Malloc(svm_node *,sub_prob.l);
+	sub_prob.y = Malloc(double,sub_prob.l);
+	int k;
+	for(k=0;k<ci;k++)
+	{
+		sub_prob.x[k] = task->x[si+k];
+		sub_prob.y[k] = +1;
+	}
+	for(k=0;k<cj;k++)
+	{
+		sub_prob.x[ci+k] = task->x[sj+k];
+		sub_prob.y[ci+k] = -1;
+	}
+
+	if(task->param->probability)
+		svm_binary_svc_probability(&sub_prob,task->param,task->weighted_C[i],task->weighted_C[j],task->probA[p],task->probB[p],task->seed[p]);
+
+	task->f[p] = svm_train_one(&sub_prob,task->param,task->weighted_C[i],task->weighted_C[j]);
+	free(sub_prob.x);
+	free(sub_prob.y);
+}
+
+static svm_model *svm_train_seeded(const svm_problem *prob, const svm_parameter *param, unsigned int seed)
 {
 	svm_model *model = Malloc(svm_model,1);
 	model->param = *param;
@@ -2164,43 +2261,52 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 			probB=Malloc(double,nr_class*(nr_class-1)/2);
 		}
 
+		int nr_pair = nr_class*(nr_class-1)/2;
+		int *pair_i = Malloc(int,nr_pair);
+		int *pair_j = Malloc(int,nr_pair);
+		unsigned int *pair_seed = Malloc(unsigned int,nr_pair);
+		unsigned int state = svm_seed(seed);
 		int p = 0;
 		for(i=0;i<nr_class;i++)
 			for(int j=i+1;j<nr_class;j++)
 			{
-				svm_problem sub_prob;
-				int si = start[i], sj = start[j];
-				int ci = count[i], cj = count[j];
-				sub_prob.l = ci+cj;
-				sub_prob.x = Malloc(svm_node *,sub_prob.l);
-				sub_prob.y = Malloc(double,sub_prob.l);
-				int k;
-				for(k=0;k<ci;k++)
-				{
-					sub_prob.x[k] = x[si+k];
-					sub_prob.y[k] = +1;
-				}
-				for(k=0;k<cj;k++)
-				{
-					sub_prob.x[ci+k] = x[sj+k];
-					sub_prob.y[ci+k] = -1;
-				}
-
-				if(param->probability)
-					svm_binary_svc_probability(&sub_prob,param,weighted_C[i],weighted_C[j],probA[p],probB[p]);
-
-				f[p] = svm_train_one(&sub_prob,param,weighted_C[i],weighted_C[j]);
-				for(k=0;k<ci;k++)
-					if(!nonzero[si+k] && fabs(f[p].alpha[k]) > 0)
-						nonzero[si+k] = true;
-				for(k=0;k<cj;k++)
-					if(!nonzero[sj+k] && fabs(f[p].alpha[ci+k]) > 0)
-						nonzero[sj+k] = true;
-				free(sub_prob.x);
-				free(sub_prob.y);
+				pair_i[p] = i;
+				pair_j[p] = j;
+				pair_seed[p] = (unsigned int)svm_rand(state);
 				++p;
 			}
 
+		// the sub problems are independent, so they can be solved concurrently
+		svm_pair_task task;
+		task.param = param;
+		task.x = x;
+		task.start = start;
+		task.count = count;
+		task.weighted_C = weighted_C;
+		task.pair_i = pair_i;
+		task.pair_j = pair_j;
+		task.seed = pair_seed;
+		task.f = f;
+		task.probA = probA;
+		task.probB = probB;
+		svm_run_tasks(&svm_train_pair,&task,nr_pair,param->nr_thread);
+
+		for(p=0;p<nr_pair;p++)
+		{
+			int si = start[pair_i[p]], sj = start[pair_j[p]];
+			int ci = count[pair_i[p]], cj = count[pair_j[p]];
+			int k;
+			for(k=0;k<ci;k++)
+				if(!nonzero[si+k] && fabs(f[p].alpha[k]) > 0)
+					nonzero[si+k] = true;
+			for(k=0;k<cj;k++)
+				if(!nonzero[sj+k] && fabs(f[p].alpha[ci+k]) > 0)
+					nonzero[sj+k] = true;
+		}
+		free(pair_i);
+		free(pair_j);
+		free(pair_seed);
+
 		// build output
 
 		model->nr_class = nr_class;
@@ -2305,6 +2411,68 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 	return model;
 }
 
+svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
+{
+	return svm_train_seeded(prob,param,(unsigned int)rand());
+}
+
+// One fold of svm_cross_validation
+struct svm_fold_task
+{
+	const svm_problem *prob;
+	const svm_parameter *param;
+	const int *perm;
+	const int *fold_start;
+	const unsigned int *seed;
+	double *target;
+};
+
+static void svm_train_fold(void *context, int i)
+{
+	svm_fold_task *task = (svm_fold_task*)context;
+	const svm_problem *prob = task->prob;
+	const int *perm = task->perm;
+	double *target = task->target;
+	int l = prob->l;
+	int begin = task->fold_start[i];
+	int end = task->fold_start[i+1];
+	int j,k;
+	struct svm_problem subprob;
+
+	subprob.l = l-(end-begin);
+	subprob.x = Malloc(struct svm_node*,subprob.l);
+	subprob.y = Malloc(double,subprob.l);
+		
+	k=0;
+	for(j=0;j<begin;j++)
+	{
+		subprob.x[k] = prob->x[perm[j]];
+		subprob.y[k] = prob->y[perm[j]];
+		++k;
+	}
+	for(j=end;j<l;j++)
+	{
+		subprob.x[k] = prob->x[perm[j]];
+		subprob.y[k] = prob->y[perm[j]];
+		++k;
+	}
+	struct svm_model *submodel = svm_train_seeded(&subprob,task->param,task->seed[i]);
+	if(task->param->probability && 
+	   (task->param->svm_type == C_SVC || task->param->svm_type == NU_SVC))
+	{
+		double *prob_estimates=Malloc(double,svm_get_nr_class(submodel));
+		for(j=begin;j<end;j++)
+			target[perm[j]] = svm_predict_probability(submodel,prob->x[perm[j]],prob_estimates);
+		free(prob_estimates);			
+	}
+	else
+		for(j=begin;j<end;j++)
+			target[perm[j]] = svm_predict(submodel,prob->x[perm[j]]);
+	svm_free_and_destroy_model(&submodel);
+	free(subprob.x);
+	free(subprob.y);
+}
+
 // Stratified cross validation
 void svm_cross_validation(const svm_problem *prob, const svm_parameter *param, int nr_fold, double *target)
 {
@@ -2377,46 +2545,23 @@ void svm_cross_validation(const svm_problem *prob, const svm_parameter *param, i
 			fold_start[i]=i*l/nr_fold;
 	}
 
+	// the folds are trained concurrently, each fold solves its own sub problems on a single thread
+	unsigned int *fold_seed = Malloc(unsigned int,nr_fold);
 	for(i=0;i<nr_fold;i++)
-	{
-		int begin = fold_start[i];
-		int end = fold_start[i+1];
-		int j,k;
-		struct svm_problem subprob;
-
-		subprob.l = l-(end-begin);
-		subprob.x = Malloc(struct svm_node*,subprob.l);
-		subprob.y = Malloc(double,subprob.l);
-			
-		k=0;
-		for(j=0;j<begin;j++)
-		{
-			subprob.x[k] = prob->x[perm[j]];
-			subprob.y[k] = prob->y[perm[j]];
-			++k;
-		}
-		for(j=end;j<l;j++)
-		{
-			subprob.x[k] = prob->x[perm[j]];
-			subprob.y[k] = prob->y[perm[j]];
-			++k;
-		}
-		struct svm_model *submodel = svm_train(&subprob,param);
-		if(param->probability && 
-		   (param->svm_type == C_SVC || param->svm_type == NU_SVC))
-		{
-			double *prob_estimates=Malloc(double,svm_get_nr_class(submodel));
-			for(j=begin;j<end;j++)
-				target[perm[j]] = svm_predict_probability(submodel,prob->x[perm[j]],prob_estimates);
-			free(prob_estimates);			
-		}
-		else
-			for(j=begin;j<end;j++)
-				target[perm[j]] = svm_predict(submodel,prob->x[perm[j]]);
-		svm_free_and_destroy_model(&submodel);
-		free(subprob.x);
-		free(subprob.y);
-	}		
+		fold_seed[i] = (unsigned int)rand();
+	svm_parameter fold_param = *param;
+	fold_param.nr_thread = 1;
+
+	svm_fold_task task;
+	task.prob = prob;
+	task.param = &fold_param;
+	task.perm = perm;
+	task.fold_start = fold_start;
+	task.seed = fold_seed;
+	task.target = target;
+	svm_run_tasks(&svm_train_fold,&task,nr_fold,param->nr_thread);
+
+	free(fold_seed);
 	free(fold_start);
 	free(perm);	
 }
@@ -2527,6 +2672,11 @@ double svm_predict_values(const svm_model *model, const svm_node *x, double* dec
 	}
 }
 
+double svm_k_function(const svm_node *x, const svm_node *y, const svm_parameter *param)
+{
+	return Kernel::k_function(x,y,*param);
+}
+
 double svm_predict(const svm_model *model, const svm_node *x)
 {
 	int nr_class = model->nr_class;
@@ -2718,6 +2868,7 @@ svm_model *svm_load_model(const char *model_file_name)
 
 	svm_model *model = Malloc(svm_model,1);
 	svm_parameter& param = model->param;
+	param.nr_thread = 1;
 	model->rho = NULL;
 	model->probA = NULL;
 	model->probB = NULL;
@@ -106,6 +106,7 @@ struct svm_parameter
     svm_parameter(){
         weight_label = NULL;
         weight = NULL;
+        nr_thread = 1;
     }
 	int svm_type;
 	int kernel_type;
@@ -124,6 +125,7 @@ struct svm_parameter
 	double p;	/* for EPSILON_SVR */
 	int shrinking;	/* use the shrinking heuristics */
 	int probability; /* do probability estimates */
+	int nr_thread;	/* number of threads used to train the one-vs-one sub problems and cv folds */
 };
 
 //
@@ -162,6 +164,7 @@ void svm_get_labels(const struct svm_model *model, int *label);
 double svm_get_svr_probability(const struct svm_model *model);
 
 double svm_predict_values(const struct svm_model *model, const struct svm_node *x, double* dec_values);
+double svm_k_function(const struct svm_node *x, const struct svm_node *y, const struct svm_parameter *param);
 double svm_predict(const struct svm_model *model, const struct svm_node *x);
 double svm_predict_probability(const struct svm_model *model, const struct svm_node *x, double* prob_estimates);
 
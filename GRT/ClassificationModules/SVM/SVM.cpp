@@ -63,9 +63,15 @@ SVM::SVM(KernelType kernelType,SVMType svmType,bool useScaling,bool useNullRejec
     this->useCrossValidation = false;
     this->useNullRejection = false;
     this->useAutoGamma = true;
+    useGridSearch = false;
+    kernelCacheSize = 0;
     classificationThreshold = 0.5;
     crossValidationResult = 0;
     
+    //Setup the default grid search range, based on the coarse grid suggested in the LIBSVM guide
+    for(int i=-5; i<=15; i+=2) gridSearchCValues.push_back( pow(2.0,i) );
+    for(int i=-15; i<=3; i+=2) gridSearchGammaValues.push_back( pow(2.0,i) );
+    
     classifierMode = STANDARD_CLASSIFIER_MODE;
     
     init(kernelType,svmType,useScaling,useNullRejection,useAutoGamma,gamma,degree,coef0,nu,C,useCrossValidation,kFoldValue);
@@ -79,6 +85,8 @@ SVM::SVM(const SVM &rhs) : Classifier( getId() )
     prob.l = 0;
     prob.x = NULL;
     prob.y = NULL;
+    useGridSearch = false;
+    kernelCacheSize = 0;
     classifierMode = STANDARD_CLASSIFIER_MODE;
     *this = rhs;
 }
@@ -103,6 +111,10 @@ SVM& SVM::operator=(const SVM &rhs){
         this->crossValidationResult = rhs.crossValidationResult;
         this->useAutoGamma = rhs.useAutoGamma;
         this->useCrossValidation = rhs.useCrossValidation;
+        this->useGridSearch = rhs.useGridSearch;
+        this->kernelCacheSize = rhs.kernelCacheSize;
+        this->gridSearchCValues = rhs.gridSearchCValues;
+        this->gridSearchGammaValues = rhs.gridSearchGammaValues;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -129,6 +141,10 @@ bool SVM::deepCopyFrom(const Classifier *classifier){
         this->crossValidationResult = ptr->crossValidationResult;
         this->useAutoGamma = ptr->useAutoGamma;
         this->useCrossValidation = ptr->useCrossValidation;
+        this->useGridSearch = ptr->useGridSearch;
+        this->kernelCacheSize = ptr->kernelCacheSize;
+        this->gridSearchCValues = ptr->gridSearchCValues;
+        this->gridSearchGammaValues = ptr->gridSearchGammaValues;
         
         //Classifier variables
         return copyBaseVariables( classifier );
@@ -228,6 +244,7 @@ bool SVM::init(KernelType kernelType,SVMType svmType,bool useScaling,bool useNul
     this->useCrossValidation = useCrossValidation;
     this->useNullRejection = useNullRejection;
     this->useAutoGamma = useAutoGamma;
+    this->kFoldValue = kFoldValue;
     classificationThreshold = 0.5;
     crossValidationResult = 0;
     
@@ -303,6 +320,11 @@ bool SVM::trainSVM(){
         return false;
     }
     
+    //Split the one-vs-one sub problems and cross validation folds across the thread pool, sizing the kernel cache for each thread.
+    //If the SVM is trained inside a parallel block, then the sub problems are run serially
+    param.nr_thread = (int)ThreadPool::getNumParallelBlocks( ThreadPool::getThreadPoolSize(), 1 );
+    param.cache_size = computeKernelCacheSize( param.nr_thread );
+    
     //Verify the problem and the parameters
     if( !validateProblemAndParameters() ) return false;
     
@@ -313,12 +335,20 @@ bool SVM::trainSVM(){
         prob.x[i][j].value = grt_scale(prob.x[i][j].value,ranges[j].minValue,ranges[j].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE);
     }
     
+    //Search for the best C and gamma values, these will be used for any cross validation and the final model
+    if( useGridSearch ){
+        if( !gridSearch() ){
+            errorLog << "trainSVM() - Failed to run grid search!" << std::endl;
+            return false;
+        }
+    }
+    
     if( useCrossValidation ){
         int i;
         Float total_correct = 0;
         Float total_error = 0;
         Float sumv = 0, sumy = 0, sumvv = 0, sumyy = 0, sumvy = 0;
-        Float *target = new Float[prob.l];
+        double *target = new double[prob.l];
         
         svm_cross_validation(&prob,&param,kFoldValue,target);
         if( param.svm_type == EPSILON_SVR || param.svm_type == NU_SVR )
@@ -370,6 +400,203 @@ bool SVM::trainSVM(){
     return trained;
 }
 
+bool SVM::gridSearch(){
+    
+    if( param.svm_type != C_SVC ){
+        warningLog << "gridSearch() - The grid search is only supported for the C_SVC svm type, the current parameters will be used!" << std::endl;
+        return true;
+    }
+    
+    if( gridSearchCValues.size() == 0 ){
+        errorLog << "gridSearch() - The grid search C values have not been set!" << std::endl;
+        return false;
+    }
+    
+    const UINT M = (UINT)prob.l;
+    const UINT K = grt_min( kFoldValue, M );
+    
+    if( K < 2 ){
+        errorLog << "gridSearch() - The kFoldValue must be at least 2 and not larger than the number of training samples!" << std::endl;
+        return false;
+    }
+    
+    //The gamma parameter is not used by the linear kernel, so only the C values need to be searched
+    VectorFloat gammaValues;
+    if( param.kernel_type == LINEAR_KERNEL || gridSearchGammaValues.size() == 0 ) gammaValues.push_back( param.gamma );
+    else gammaValues = gridSearchGammaValues;
+    const UINT numGamma = gammaValues.getSize();
+    const UINT numC = gridSearchCValues.getSize();
+    
+    //Assign each sample to a fold, stratified by class so each fold has a similar class distribution
+    Vector< UINT > foldIndices( M );
+    {
+        Random random;
+        std::map< int, Vector< UINT > > classIndices;
+        for(UINT i=0; i<M; i++) classIndices[ (int)prob.y[i] ].push_back( i );
+        
+        UINT foldCounter = 0;
+        std::map< int, Vector< UINT > >::iterator iter;
+        for(iter = classIndices.begin(); iter != classIndices.end(); ++iter){
+            Vector< UINT > &indices = iter->second;
+            const UINT N = indices.getSize();
+            for(UINT i=0; i<N; i++){
+                grt_swap( indices[i], indices[ random.getRandomNumberInt(i,N) ] );
+            }
+            for(UINT i=0; i<N; i++){
+                foldIndices[ indices[i] ] = foldCounter++ % K;
+            }
+        }
+    }
+    
+    const UINT numThreads = ThreadPool::getNumParallelBlocks( numC*K, 1 );
+    const Float cacheSize = computeKernelCacheSize( numThreads );
+    
+    //If the full kernel matrix fits within the cache budget of all the threads, then it is computed once per gamma value
+    //and shared (as a LIBSVM precomputed kernel) across all the C values and folds for that gamma
+    const Float kernelMatrixSize = (Float(M) * Float(M+2) * sizeof(svm_node)) / (1<<20);
+    const bool precomputeKernel = kernelMatrixSize <= cacheSize * numThreads;
+    
+    Vector< svm_node > kernelMatrix;
+    Vector< svm_node* > kernelRows;
+    if( precomputeKernel ){
+        kernelMatrix.resize( M*(M+2) );
+        kernelRows.resize( M );
+        for(UINT i=0; i<M; i++) kernelRows[i] = &kernelMatrix[ i*(M+2) ];
+    }
+    
+    MatrixFloat numCorrect(numGamma,numC);
+    numCorrect.setAllValues( 0 );
+    
+    for(UINT g=0; g<numGamma; g++){
+        
+        svm_parameter foldParam = param;
+        foldParam.gamma = gammaValues[g];
+        foldParam.probability = 0;
+        foldParam.nr_thread = 1;
+        foldParam.cache_size = cacheSize;
+        foldParam.nr_weight = 0;
+        foldParam.weight_label = NULL;
+        foldParam.weight = NULL;
+        
+        svm_node **x = prob.x;
+        
+        if( precomputeKernel ){
+            //Each row is {serial number, K(i,0) ... K(i,M-1), terminator}, this is the layout LIBSVM expects for precomputed kernels
+            const svm_parameter &kernelParam = foldParam;
+            Vector< svm_node* > &rows = kernelRows;
+            svm_node **source = prob.x;
+            ThreadPool::parallelFor( 0, M, 16, [&rows,&kernelParam,source,M](const UINT start,const UINT end){
+                for(UINT i=start; i<end; i++){
+                    rows[i][0].index = 0;
+                    rows[i][0].value = i+1;
+                    for(UINT j=0; j<M; j++){
+                        rows[i][j+1].index = j+1;
+                        rows[i][j+1].value = svm_k_function( source[i], source[j], &kernelParam );
+                    }
+                    rows[i][M+1].index = -1;
+                    rows[i][M+1].value = 0;
+                }
+                return true;
+            } );
+            foldParam.kernel_type = PRECOMPUTED_KERNEL;
+            x = &kernelRows[0];
+        }
+        
+        //Evaluate every C value and fold for this gamma concurrently
+        Vector< UINT > foldCorrect( numC*K, 0 );
+        ThreadPool::parallelFor( 0, numC*K, 1, [this,&foldParam,x,&foldIndices,&foldCorrect,K](const UINT begin,const UINT end){
+            for(UINT t=begin; t<end; t++){
+                svm_parameter cParam = foldParam;
+                cParam.C = gridSearchCValues[ t / K ];
+                foldCorrect[t] = this->gridSearchFold( cParam, x, foldIndices, t % K );
+            }
+            return true;
+        } );
+        for(UINT c=0; c<numC; c++){
+            for(UINT k=0; k<K; k++){
+                numCorrect[g][c] += foldCorrect[ c*K + k ];
+            }
+        }
+        
+        trainingLog << "gridSearch() - gamma: " << gammaValues[g] << " best accuracy: " << numCorrect.getRow(g).getMaxValue() / M * 100.0 << std::endl;
+    }
+    
+    //Find the best grid point, ties are resolved in favour of the first (smallest) values in the grid
+    UINT bestGamma = 0;
+    UINT bestC = 0;
+    for(UINT g=0; g<numGamma; g++){
+        for(UINT c=0; c<numC; c++){
+            if( numCorrect[g][c] > numCorrect[bestGamma][bestC] ){
+                bestGamma = g;
+                bestC = c;
+            }
+        }
+    }
+    
+    param.C = gridSearchCValues[ bestC ];
+    param.gamma = gammaValues[ bestGamma ];
+    crossValidationResult = numCorrect[bestGamma][bestC] / M * 100.0;
+    
+    trainingLog << "gridSearch() - best C: " << param.C << " best gamma: " << param.gamma << " accuracy: " << crossValidationResult << std::endl;
+    
+    return true;
+}
+
+UINT SVM::gridSearchFold(const svm_parameter &foldParam,svm_node **x,const Vector< UINT > &foldIndices,const UINT fold) const{
+    
+    const UINT M = foldIndices.getSize();
+    
+    //Build the training problem from all the samples that are not in this fold, the samples are referenced not copied
+    svm_problem subProb;
+    subProb.l = 0;
+    for(UINT i=0; i<M; i++) if( foldIndices[i] != fold ) subProb.l++;
+    subProb.x = new svm_node*[ subProb.l ];
+    subProb.y = new double[ subProb.l ];
+    
+    UINT index = 0;
+    for(UINT i=0; i<M; i++){
+        if( foldIndices[i] != fold ){
+            subProb.x[index] = x[i];
+            subProb.y[index] = prob.y[i];
+            index++;
+        }
+    }
+    
+    UINT numCorrect = 0;
+    svm_model *foldModel = svm_train( &subProb, &foldParam );
+    if( foldModel != NULL ){
+        for(UINT i=0; i<M; i++){
+            if( foldIndices[i] == fold && svm_predict( foldModel, x[i] ) == prob.y[i] ){
+                numCorrect++;
+            }
+        }
+        svm_free_and_destroy_model( &foldModel );
+    }
+    
+    delete[] subProb.x;
+    delete[] subProb.y;
+    subProb.x = NULL;
+    subProb.y = NULL;
+    
+    return numCorrect;
+}
+
+Float SVM::computeKernelCacheSize(const UINT numThreads) const{
+    
+    if( kernelCacheSize > 0 ) return kernelCacheSize;
+    
+    //The cache never needs to be larger than the full kernel matrix (LIBSVM caches the kernel as floats)
+    const Float requiredSize = (Float(prob.l) * Float(prob.l) * sizeof(float)) / (1<<20) + 1;
+    
+    //Use at most a quarter of the available memory, split between the training threads
+    const unsigned long long availableMemory = Util::getAvailableMemory();
+    if( availableMemory == 0 ) return grt_min( requiredSize, (Float)SVM_DEFAULT_KERNEL_CACHE_SIZE );
+    
+    const Float budget = (availableMemory / 4.0) / (1<<20) / grt_max(numThreads,1u);
+    
+    return grt_max( grt_min( requiredSize, budget ), 1.0 );
+}
+
 bool SVM::predictSVM(VectorFloat &inputVector){
     
     if( !trained || inputVector.size() != numInputDimensions ) return false;
@@ -408,11 +635,11 @@ bool SVM::predictSVM(VectorFloat &inputVector,Float &maxProbability, VectorFloat
     
     if( !trained || param.probability == 0 || inputVector.size() != numInputDimensions ) return false;
     
-    Float *prob_estimates = NULL;
+    double *prob_estimates = NULL;
     svm_node *x = NULL;
     
     //Setup the memory for the probability estimates
-    prob_estimates = new Float[ model->nr_class ];
+    prob_estimates = new double[ model->nr_class ];
     
     //Copy the input data into the SVM format
     x = new svm_node[numInputDimensions+1];
@@ -473,7 +700,7 @@ bool SVM::convertClassificationDataToLIBSVMFormat(ClassificationData &trainingDa
     //Init the memory
     prob.l = numTrainingExamples;
     prob.x = new svm_node*[numTrainingExamples];
-    prob.y = new Float[numTrainingExamples];
+    prob.y = new double[numTrainingExamples];
     problemSet = true;
     
     for(UINT i=0; i<numTrainingExamples; i++){
@@ -598,7 +825,7 @@ bool SVM::save( std::fstream &file ) const{
         
         file << "SupportVectors: \n";
         
-        const Float * const *sv_coef = model->sv_coef;
+        const double * const *sv_coef = model->sv_coef;
         const svm_node * const *SV = model->SV;
         
         for(UINT i=0;i<numSV;i++){
@@ -828,7 +1055,7 @@ bool SVM::load( std::fstream &file ){
             clear();
             return false;
         }
-        model->rho = new Float[ halfNumClasses ];
+        model->rho = new double[ halfNumClasses ];
         for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->rho[i];
         
         //See if we can load the Labels
@@ -847,7 +1074,7 @@ bool SVM::load( std::fstream &file ){
         if(word != "ProbA:"){
             model->probA = NULL;
         }else{
-            model->probA = new Float[ halfNumClasses ];
+            model->probA = new double[ halfNumClasses ];
             for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->probA[i];
             //We only need to read a new line if we found the label!
             file >> word;
@@ -858,7 +1085,7 @@ bool SVM::load( std::fstream &file ){
         if(word != "ProbB:"){
             model->probB = NULL;
         }else{
-            model->probB = new Float[ halfNumClasses ];
+            model->probB = new double[ halfNumClasses ];
             for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->probB[i];
             //We only need to read a new line if we found the label!
             file >> word;
@@ -884,8 +1111,8 @@ bool SVM::load( std::fstream &file ){
         }
         
         //Setup the memory
-        model->sv_coef = new Float*[numClasses-1];
-        for(UINT j=0;j<numClasses-1;j++) model->sv_coef[j] = new Float[numSV];
+        model->sv_coef = new double*[numClasses-1];
+        for(UINT j=0;j<numClasses-1;j++) model->sv_coef[j] = new double[numSV];
         model->SV = new svm_node*[numSV];
         
         for(UINT i=0; i<numSV; i++){
@@ -926,6 +1153,260 @@ bool SVM::load( std::fstream &file ){
     return true;
 }
 
+bool SVM::saveBinary( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    file.writeString( "GRT_SVM_BINARY_MODEL_V1.0" );
+    
+    //Write the classifier settings to the file
+    if( !Classifier::saveBaseSettingsToBinaryFile( file ) ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save classifier base settings to file!" << std::endl;
+        return false;
+    }
+    
+    const svm_parameter& param = trained ? model->param : this->param;
+    
+    file.writeInt( param.svm_type );
+    file.writeInt( param.kernel_type );
+    file.writeInt( param.degree );
+    file.writeFloat( param.gamma );
+    file.writeFloat( param.coef0 );
+    file.writeInt( param.shrinking );
+    file.writeInt( param.probability );
+    
+    if( trained ){
+        const UINT numClasses = (UINT)model->nr_class;
+        const UINT numSV = (UINT)model->l;
+        const UINT halfNumClasses = numClasses*(numClasses-1)/2;
+        const UINT numColumns = param.kernel_type == PRECOMPUTED ? 1 : numInputDimensions;
+        
+        file.writeUInt( numSV );
+        
+        VectorFloat rho( halfNumClasses );
+        for(UINT i=0; i<halfNumClasses; i++) rho[i] = model->rho[i];
+        file.writeVector( rho );
+        
+        //The optional arrays are written with a flag, so the loader knows if they exist
+        file.writeBool( model->label != NULL );
+        if( model->label ){
+            for(UINT i=0; i<numClasses; i++) file.writeInt( model->label[i] );
+        }
+        
+        file.writeBool( model->probA != NULL );
+        if( model->probA ){
+            VectorFloat probA( halfNumClasses );
+            for(UINT i=0; i<halfNumClasses; i++) probA[i] = model->probA[i];
+            file.writeVector( probA );
+        }
+        
+        file.writeBool( model->probB != NULL );
+        if( model->probB ){
+            VectorFloat probB( halfNumClasses );
+            for(UINT i=0; i<halfNumClasses; i++) probB[i] = model->probB[i];
+            file.writeVector( probB );
+        }
+        
+        file.writeBool( model->nSV != NULL );
+        if( model->nSV ){
+            for(UINT i=0; i<numClasses; i++) file.writeInt( model->nSV[i] );
+        }
+        
+        //Write the coefficients and the support vectors as dense blocks
+        MatrixFloat coefficients( numClasses-1, numSV );
+        for(UINT j=0; j<numClasses-1; j++){
+            for(UINT i=0; i<numSV; i++) coefficients[j][i] = model->sv_coef[j][i];
+        }
+        
+        MatrixFloat supportVectors( numSV, numColumns );
+        supportVectors.setAllValues( 0 );
+        for(UINT i=0; i<numSV; i++){
+            const svm_node *p = model->SV[i];
+            if( param.kernel_type == PRECOMPUTED ) supportVectors[i][0] = p->value;
+            else{
+                while( p->index != -1 ){
+                    if( p->index >= 1 && (UINT)p->index <= numColumns ) supportVectors[i][ p->index-1 ] = p->value;
+                    p++;
+                }
+            }
+        }
+        
+        file.writeMatrix( coefficients );
+        if( !file.writeMatrix( supportVectors ) ){
+            errorLog << "saveBinary(BinaryModelWriter &file) - Failed to write the support vectors!" << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool SVM::loadBinary( BinaryModelReader &file ){
+    
+    //Clear any previous models, parameters or problems
+    clear();
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBinary(BinaryModelReader &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    std::string header;
+    if( !file.readString( header ) || header != "GRT_SVM_BINARY_MODEL_V1.0" ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Invalid file format!" << std::endl;
+        return false;
+    }
+    
+    //Load the base settings from the file
+    if( !Classifier::loadBaseSettingsFromBinaryFile( file ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to load base settings from file!" << std::endl;
+        return false;
+    }
+    
+    int svmType = 0;
+    int kernelType = 0;
+    int degree = 0;
+    Float gammaValue = 0;
+    Float coef0 = 0;
+    int shrinking = 0;
+    int probability = 0;
+    if( !file.readInt( svmType ) || !file.readInt( kernelType ) || !file.readInt( degree ) || !file.readFloat( gammaValue ) ||
+        !file.readFloat( coef0 ) || !file.readInt( shrinking ) || !file.readInt( probability ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the SVM parameters!" << std::endl;
+        clear();
+        return false;
+    }
+    
+    if( !trained ){
+        param.svm_type = svmType;
+        param.kernel_type = kernelType;
+        param.degree = degree;
+        param.gamma = gammaValue;
+        param.coef0 = coef0;
+        param.shrinking = shrinking;
+        param.probability = probability;
+        return true;
+    }
+    
+    UINT numSV = 0;
+    VectorFloat rho;
+    if( !file.readUInt( numSV ) || !file.readVector( rho ) || rho.getSize() != numClasses*(numClasses-1)/2 ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read RHO!" << std::endl;
+        clear();
+        return false;
+    }
+    const UINT halfNumClasses = rho.getSize();
+    
+    //The model is allocated in the same way as LIBSVM's svm_load_model, so it can be freed by svm_free_and_destroy_model
+    model = (svm_model*)malloc( sizeof(svm_model) );
+    model->param = param;
+    model->param.svm_type = svmType;
+    model->param.kernel_type = kernelType;
+    model->param.degree = degree;
+    model->param.gamma = gammaValue;
+    model->param.coef0 = coef0;
+    model->param.shrinking = shrinking;
+    model->param.probability = probability;
+    model->param.nr_weight = 0;
+    model->param.weight_label = NULL;
+    model->param.weight = NULL;
+    model->nr_class = numClasses;
+    model->l = 0;
+    model->SV = NULL;
+    model->sv_coef = NULL;
+    model->probA = NULL;
+    model->probB = NULL;
+    model->label = NULL;
+    model->nSV = NULL;
+    model->free_sv = 1;
+    
+    model->rho = (double*)malloc( sizeof(double) * halfNumClasses );
+    for(UINT i=0; i<halfNumClasses; i++) model->rho[i] = rho[i];
+    
+    bool hasValues = false;
+    bool ok = file.readBool( hasValues );
+    if( ok && hasValues ){
+        model->label = (int*)malloc( sizeof(int) * numClasses );
+        for(UINT i=0; i<numClasses && ok; i++) ok = file.readInt( model->label[i] );
+    }
+    
+    VectorFloat values;
+    if( ok ) ok = file.readBool( hasValues );
+    if( ok && hasValues ){
+        ok = file.readVector( values ) && values.getSize() == halfNumClasses;
+        if( ok ){
+            model->probA = (double*)malloc( sizeof(double) * halfNumClasses );
+            for(UINT i=0; i<halfNumClasses; i++) model->probA[i] = values[i];
+        }
+    }
+    
+    if( ok ) ok = file.readBool( hasValues );
+    if( ok && hasValues ){
+        ok = file.readVector( values ) && values.getSize() == halfNumClasses;
+        if( ok ){
+            model->probB = (double*)malloc( sizeof(double) * halfNumClasses );
+            for(UINT i=0; i<halfNumClasses; i++) model->probB[i] = values[i];
+        }
+    }
+    
+    if( ok ) ok = file.readBool( hasValues );
+    if( ok && hasValues ){
+        model->nSV = (int*)malloc( sizeof(int) * numClasses );
+        for(UINT i=0; i<numClasses && ok; i++) ok = file.readInt( model->nSV[i] );
+    }
+    
+    MatrixFloat coefficients;
+    MatrixFloat supportVectors;
+    if( ok ) ok = file.readMatrix( coefficients ) && file.readMatrix( supportVectors );
+    
+    const UINT numColumns = model->param.kernel_type == PRECOMPUTED ? 1 : numInputDimensions;
+    if( !ok || model->label == NULL || coefficients.getNumRows() != numClasses-1 || coefficients.getNumCols() != numSV ||
+        supportVectors.getNumRows() != numSV || supportVectors.getNumCols() != numColumns ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the support vectors!" << std::endl;
+        clear();
+        return false;
+    }
+    
+    model->sv_coef = (double**)malloc( sizeof(double*) * (numClasses-1) );
+    for(UINT j=0; j<numClasses-1; j++){
+        model->sv_coef[j] = (double*)malloc( sizeof(double) * numSV );
+        for(UINT i=0; i<numSV; i++) model->sv_coef[j][i] = coefficients[j][i];
+    }
+    
+    //All the support vectors share one block of nodes, each vector is terminated by a node with an index of -1
+    model->l = numSV;
+    model->SV = (svm_node**)malloc( sizeof(svm_node*) * numSV );
+    if( numSV > 0 ){
+        svm_node *nodes = (svm_node*)malloc( sizeof(svm_node) * numSV * (numColumns+1) );
+        for(UINT i=0; i<numSV; i++){
+            model->SV[i] = nodes + i*(numColumns+1);
+            for(UINT j=0; j<numColumns; j++){
+                model->SV[i][j].index = model->param.kernel_type == PRECOMPUTED ? 0 : j+1;
+                model->SV[i][j].value = supportVectors[i][j];
+            }
+            model->SV[i][numColumns].index = -1;
+            model->SV[i][numColumns].value = 0;
+        }
+    }
+    
+    //Set the class labels
+    classLabels.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        classLabels[k] = model->label[k];
+    }
+    
+    //Resize the prediction results to make sure it is setup for realtime prediction
+    maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
+    bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
+    classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
+    classDistances.resize(numClasses,DEFAULT_NULL_DISTANCE_VALUE);
+    
+    return true;
+}
+
 bool SVM::clear(){
     
     //Clear the base class
@@ -1050,6 +1531,14 @@ Float SVM::getC() const{
 
 Float SVM::getCrossValidationResult() const{ return crossValidationResult; }
 
+Float SVM::getKernelCacheSize() const{ return kernelCacheSize; }
+
+bool SVM::getIsGridSearchEnabled() const{ return useGridSearch; }
+
+VectorFloat SVM::getGridSearchCValues() const{ return gridSearchCValues; }
+
+VectorFloat SVM::getGridSearchGammaValues() const{ return gridSearchGammaValues; }
+
 struct LIBSVM::svm_model* SVM::getLIBSVMModel() const { return model; }
 
 SVMModel SVM::getModel() const {
@@ -1177,6 +1666,47 @@ bool SVM::enableCrossValidationTraining(const bool useCrossValidation){
     this->useCrossValidation = useCrossValidation;
     return true;
 }
+
+bool SVM::setKernelCacheSize(const Float kernelCacheSize){
+    if( kernelCacheSize >= 0 ){
+        this->kernelCacheSize = kernelCacheSize;
+        return true;
+    }
+    warningLog << "setKernelCacheSize(const Float kernelCacheSize) - Failed to set kernelCacheSize, the kernelCacheSize must be >= 0!" << std::endl;
+    return false;
+}
+
+bool SVM::enableGridSearch(const bool useGridSearch){
+    this->useGridSearch = useGridSearch;
+    return true;
+}
+
+bool SVM::setGridSearchRange(const VectorFloat &cValues,const VectorFloat &gammaValues){
+    
+    if( cValues.size() == 0 ){
+        warningLog << "setGridSearchRange(const VectorFloat &cValues,const VectorFloat &gammaValues) - Failed to set grid search range, there must be at least one C value!" << std::endl;
+        return false;
+    }
+    
+    for(UINT i=0; i<cValues.size(); i++){
+        if( cValues[i] <= 0 ){
+            warningLog << "setGridSearchRange(const VectorFloat &cValues,const VectorFloat &gammaValues) - Failed to set grid search range, all the C values must be greater than 0!" << std::endl;
+            return false;
+        }
+    }
+    
+    for(UINT i=0; i<gammaValues.size(); i++){
+        if( gammaValues[i] <= 0 ){
+            warningLog << "setGridSearchRange(const VectorFloat &cValues,const VectorFloat &gammaValues) - Failed to set grid search range, all the gamma values must be greater than 0!" << std::endl;
+            return false;
+        }
+    }
+    
+    gridSearchCValues = cValues;
+    gridSearchGammaValues = gammaValues;
+    
+    return true;
+}
  
 bool SVM::validateSVMType(const SVMType svmType){
     if( svmType == C_SVC ){
@@ -1268,7 +1798,7 @@ struct svm_model* SVM::deepCopyModel() const{
     //Setup the values
     halfNumClasses = model->nr_class*(model->nr_class-1)/2;
     
-    m->rho = new Float[ halfNumClasses ];
+    m->rho = new double[ halfNumClasses ];
     for(int i=0;i <model->nr_class*(model->nr_class-1)/2; i++) m->rho[i] = model->rho[i];
     
     if( model->label != NULL ){
@@ -1277,12 +1807,12 @@ struct svm_model* SVM::deepCopyModel() const{
     }
     
     if( model->probA != NULL ){
-        m->probA = new Float[ halfNumClasses ];
+        m->probA = new double[ halfNumClasses ];
         for(UINT i=0;i<halfNumClasses; i++) m->probA[i] = model->probA[i];
     }
     
     if( model->probB != NULL ){
-        m->probB = new Float[ halfNumClasses ];
+        m->probB = new double[ halfNumClasses ];
         for(UINT i=0; i<halfNumClasses; i++) m->probB[i] = model->probB[i];
     }
     
@@ -1292,8 +1822,8 @@ struct svm_model* SVM::deepCopyModel() const{
     }
     
     //Setup the memory
-    m->sv_coef = new Float*[numClasses-1];
-    for(UINT j=0;j<numClasses-1;j++) m->sv_coef[j] = new Float[model->l];
+    m->sv_coef = new double*[numClasses-1];
+    for(UINT j=0;j<numClasses-1;j++) m->sv_coef[j] = new double[model->l];
     m->SV = new svm_node*[model->l];
     
     for(int i=0; i<model->l; i++){
@@ -1348,7 +1878,7 @@ bool SVM::deepCopyProblem( const struct svm_problem &source, struct svm_problem
     }
     
     if( source.y != NULL ){
-        target.y = new Float[ target.l ];
+        target.y = new double[ target.l ];
         for(int i=0; i<target.l; i++){
             target.y[i] = source.y[i];
         }
@@ -1383,6 +1913,7 @@ bool SVM::deepCopyParam( const svm_parameter &source_param, svm_parameter &targe
     target_param.p = source_param.p;
     target_param.shrinking = source_param.shrinking;
     target_param.probability = source_param.probability;
+    target_param.nr_thread = source_param.nr_thread;
     
     //Copy any dynamic memory
     if( source_param.weight_label != NULL ){
@@ -1609,7 +2140,7 @@ bool SVM::loadLegacyModelFromFile( std::fstream &file ){
         clear();
         return false;
     }
-    model->rho = new Float[ halfNumClasses ];
+    model->rho = new double[ halfNumClasses ];
     for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->rho[i];
     
     //See if we can load the Labels
@@ -1628,7 +2159,7 @@ bool SVM::loadLegacyModelFromFile( std::fstream &file ){
     if(word != "ProbA:"){
         model->probA = NULL;
     }else{
-        model->probA = new Float[ halfNumClasses ];
+        model->probA = new double[ halfNumClasses ];
         for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->probA[i];
         //We only need to read a new line if we found the label!
         file >> word;
@@ -1639,7 +2170,7 @@ bool SVM::loadLegacyModelFromFile( std::fstream &file ){
     if(word != "ProbB:"){
         model->probB = NULL;
     }else{
-        model->probB = new Float[ halfNumClasses ];
+        model->probB = new double[ halfNumClasses ];
         for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->probB[i];
         //We only need to read a new line if we found the label!
         file >> word;
@@ -1665,8 +2196,8 @@ bool SVM::loadLegacyModelFromFile( std::fstream &file ){
     }
     
     //Setup the memory
-    model->sv_coef = new Float*[numClasses-1];
-    for(UINT j=0;j<numClasses-1;j++) model->sv_coef[j] = new Float[numSV];
+    model->sv_coef = new double*[numClasses-1];
+    for(UINT j=0;j<numClasses-1;j++) model->sv_coef[j] = new double[numSV];
     model->SV = new svm_node*[numSV];
     
     for(UINT i=0; i<numSV; i++){
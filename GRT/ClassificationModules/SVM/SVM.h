@@ -43,6 +43,7 @@ GRT_BEGIN_NAMESPACE
 
 #define SVM_MIN_SCALE_RANGE -1.0
 #define SVM_MAX_SCALE_RANGE 1.0
+#define SVM_DEFAULT_KERNEL_CACHE_SIZE 100
 
 typedef struct SVMModel{
     unsigned int numInputDimensions;
@@ -151,6 +152,24 @@ public:
      */
     virtual bool load( std::fstream &file );
     
+    /**
+     This saves the trained SVM model to a binary model file. The support vectors and their coefficients are stored as raw blocks.
+     This overrides the saveBinary function in the MLBase base class.
+     
+     @param file: a reference to the binary file the SVM model will be saved to
+     @return returns true if the model was saved successfully, false otherwise
+     */
+    virtual bool saveBinary( BinaryModelWriter &file ) const;
+    
+    /**
+     This loads a trained SVM model from a binary model file.
+     This overrides the loadBinary function in the MLBase base class.
+     
+     @param file: a reference to the binary file the SVM model will be loaded from
+     @return returns true if the model was loaded successfully, false otherwise
+     */
+    virtual bool loadBinary( BinaryModelReader &file );
+    
     /**
      This initializes the SVM settings and parameters.  Any previous model, settings, or problems will be cleared.
      
@@ -257,6 +276,35 @@ public:
     @return returns the last cross validation result.
     */
     Float getCrossValidationResult() const;
+
+    /**
+    Gets the kernel cache size (in MB) that will be used by each training thread.
+    A value of 0 means the cache size will be computed automatically from the available memory when the model is trained.
+
+    @return returns the kernel cache size in MB
+    */
+    Float getKernelCacheSize() const;
+
+    /**
+    Gets if the C/gamma grid search is enabled.
+
+    @return returns true if the grid search is enabled, false otherwise
+    */
+    bool getIsGridSearchEnabled() const;
+
+    /**
+    Gets the C values that will be tested by the grid search.
+
+    @return returns a vector containing the C values of the grid search
+    */
+    VectorFloat getGridSearchCValues() const;
+
+    /**
+    Gets the gamma values that will be tested by the grid search.
+
+    @return returns a vector containing the gamma values of the grid search
+    */
+    VectorFloat getGridSearchGammaValues() const;
     
     /**
      Returns a pointer to the svm_model, this will be NULL if the model has not been trained.
@@ -353,6 +401,34 @@ public:
     */
     bool enableCrossValidationTraining(const bool useCrossValidation);
 
+    /**
+    Sets the kernel cache size (in MB) used by each training thread. If this is set to 0 then the cache size will be computed
+    automatically from the available memory and the size of the training data, split across the training threads.
+
+    @param kernelCacheSize: the new kernel cache size in MB, must be >= 0
+    return returns true if the kernelCacheSize was set, false otherwise
+    */
+    bool setKernelCacheSize(const Float kernelCacheSize);
+
+    /**
+    Sets if a C/gamma grid search should be run during the training phase. If enabled, each point in the grid will be evaluated
+    using kFoldValue cross validation and the final model will be trained with the C and gamma values that gave the best accuracy.
+    The grid points and folds are evaluated concurrently using the ThreadPool. This is only supported for the C_SVC svm type.
+
+    @param useGridSearch: the new useGridSearch setting
+    return returns true if the useGridSearch was set, false otherwise
+    */
+    bool enableGridSearch(const bool useGridSearch);
+
+    /**
+    Sets the C and gamma values that will be tested by the grid search. The gamma values are ignored for the linear kernel.
+
+    @param cValues: the C values to test, each value must be greater than 0
+    @param gammaValues: the gamma values to test, each value must be greater than 0
+    return returns true if the grid search values were set, false otherwise
+    */
+    bool setGridSearchRange(const VectorFloat &cValues,const VectorFloat &gammaValues);
+
     /**
     Gets a string that represents the class.
     
@@ -363,6 +439,8 @@ public:
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
+    using MLBase::saveBinary;
+    using MLBase::loadBinary;
     using MLBase::train_;
     using MLBase::predict_;
     
@@ -373,6 +451,9 @@ protected:
     bool validateKernelType(KernelType kernelType);
     bool convertClassificationDataToLIBSVMFormat(ClassificationData &trainingData);
     bool trainSVM();
+    bool gridSearch();
+    UINT gridSearchFold(const LIBSVM::svm_parameter &foldParam,LIBSVM::svm_node **x,const Vector< UINT > &foldIndices,const UINT fold) const;
+    Float computeKernelCacheSize(const UINT numThreads) const;
     
     bool predictSVM(VectorFloat &inputVector);
     bool predictSVM(VectorFloat &inputVector,Float &maxProbability, VectorFloat &probabilites);
@@ -391,6 +472,10 @@ protected:
     Float crossValidationResult;
     bool useAutoGamma;
     bool useCrossValidation;
+    bool useGridSearch;
+    Float kernelCacheSize;
+    VectorFloat gridSearchCValues;
+    VectorFloat gridSearchGammaValues;
     
     static RegisterClassifierModule< SVM > registerModule;
     static std::string id;
@@ -399,4 +484,4 @@ protected:
 GRT_END_NAMESPACE
 
 #endif //GRT_SVM_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
@@ -37,6 +37,8 @@ Softmax::Softmax(const bool useScaling,const Float learningRate,const Float minC
     this->minChange = minChange;
     this->maxNumEpochs = maxNumEpochs;
     this->batchSize = batchSize;
+    this->trainingMethod = MINI_BATCH_GRADIENT_DESCENT;
+    this->regularizationCoeff = 0;
     classifierMode = STANDARD_CLASSIFIER_MODE;
 }
 
@@ -53,7 +55,9 @@ Softmax::~Softmax(void)
 Softmax& Softmax::operator=(const Softmax &rhs){
     if( this != &rhs ){
         this->batchSize = rhs.batchSize;
-        this->models = rhs.models;
+        this->trainingMethod = rhs.trainingMethod;
+        this->regularizationCoeff = rhs.regularizationCoeff;
+        this->weights = rhs.weights;
         
         //Copy the base classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -69,7 +73,9 @@ bool Softmax::deepCopyFrom(const Classifier *classifier){
         Softmax *ptr = (Softmax*)classifier;
         
         this->batchSize = ptr->batchSize;
-        this->models = ptr->models;
+        this->trainingMethod = ptr->trainingMethod;
+        this->regularizationCoeff = ptr->regularizationCoeff;
+        this->weights = ptr->weights;
         
         //Copy the base classifier variables
         return copyBaseVariables( classifier );
@@ -91,9 +97,13 @@ bool Softmax::train_(ClassificationData &trainingData){
         return false;
     }
     
+    if( batchSize == 0 ){
+        errorLog << "train_(ClassificationData &labelledTrainingData) - The batch size must be greater than zero!" << std::endl;
+        return false;
+    }
+    
     numInputDimensions = N;
     numClasses = K;
-    models.resize(K);
     classLabels.resize(K);
     ranges = trainingData.getRanges();
     
@@ -103,21 +113,46 @@ bool Softmax::train_(ClassificationData &trainingData){
         trainingData.scale(0, 1);
     }
     
-    //Train a regression model for each class in the training data
-    for(UINT k=0; k<numClasses; k++){
-        
-        //Set the class label
+    //Set the class labels, and the index of the class of each training sample
+    Vector< UINT > targets(M);
+    for(UINT k=0; k<K; k++){
         classLabels[k] = trainingData.getClassTracker()[k].classLabel;
-        
-        //Train the model
-        if( !trainSoftmaxModel(classLabels[k],models[k],trainingData) ){
-            errorLog << "train(ClassificationData labelledTrainingData) - Failed to train model for class: " << classLabels[k] << std::endl;
-                return false;
-        }
+    }
+    for(UINT i=0; i<M; i++){
+        targets[i] = getClassLabelIndexValue( trainingData[i].getClassLabel() );
+    }
+    
+    //The weights for all the classes are stored in a single matrix, with one column per class and the bias in the first row
+    weights.resize( N+1, K );
+    weights.setAllValues( 0 );
+    
+    bool result = false;
+    switch( trainingMethod ){
+        case MINI_BATCH_GRADIENT_DESCENT:
+            result = trainMiniBatch( trainingData, targets );
+            break;
+        case LIMITED_MEMORY_BFGS:
+            result = trainLBFGS( trainingData, targets );
+            break;
+        default:
+            errorLog << "train_(ClassificationData &labelledTrainingData) - Unknown training method: " << trainingMethod << std::endl;
+            break;
+    }
+    
+    if( !result ){
+        clear();
+        return false;
     }
     
     //Flag that the algorithm has been trained
     trained = true;
+    
+    //Setup the data for prediction
+    predictedClassLabel = 0;
+    maxLikelihood = 0;
+    classLikelihoods.resize(numClasses,0);
+    classDistances.resize(numClasses,0);
+    
     return trained;
 }
 
@@ -147,62 +182,105 @@ bool Softmax::predict_(VectorFloat &inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
-    //Loop over each class and compute the likelihood of the input data coming from class k. Pick the class with the highest likelihood
-    Float sum = 0;
-    Float bestEstimate = -grt_numeric_limits< Float >::max();
-    UINT bestIndex = 0;
+    //Compute the score of each class, the weight matrix is read one row at a time so the inner loop runs over contiguous data
+    Float *scores = &classDistances[0];
+    const Float *w = weights.getData();
     for(UINT k=0; k<numClasses; k++){
-        Float estimate = models[k].compute( inputVector );
-        
-        if( estimate > bestEstimate ){
-            bestEstimate = estimate;
-            bestIndex = k;
-        }
-        
-        classDistances[k] = estimate;
-        classLikelihoods[k] = estimate;
-        sum += estimate;
+        scores[k] = w[k];
     }
-    
-    if( sum > 1.0e-5 ){
+    for(UINT n=0; n<numInputDimensions; n++){
+        const Float x = inputVector[n];
+        const Float *row = w + (n+1)*numClasses;
         for(UINT k=0; k<numClasses; k++){
-            classLikelihoods[k] /= sum;
+            scores[k] += x * row[k];
         }
-    }else{
-        //If the sum is less than the value above then none of the models found a positive class
-        maxLikelihood = bestEstimate;
-        predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
-        return true;
     }
+    
+    //Normalize the scores with the softmax function, subtracting the max score so the exponentials can not overflow
+    UINT bestIndex = 0;
+    for(UINT k=1; k<numClasses; k++){
+        if( scores[k] > scores[bestIndex] ) bestIndex = k;
+    }
+    Float sum = 0;
+    for(UINT k=0; k<numClasses; k++){
+        classLikelihoods[k] = exp( scores[k] - scores[bestIndex] );
+        sum += classLikelihoods[k];
+    }
+    for(UINT k=0; k<numClasses; k++){
+        classLikelihoods[k] /= sum;
+    }
+    
     maxLikelihood = classLikelihoods[bestIndex];
     predictedClassLabel = classLabels[bestIndex];
     
     return true;
 }
 
-bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,ClassificationData &data){
+Float Softmax::computeLossAndGradient(const MatrixFloat &X,const UINT *targets,const MatrixFloat &w,MatrixFloat &scores,MatrixFloat &gradient) const{
+    
+    const UINT M = X.getNumRows();
+    const UINT K = w.getNumCols();
+    
+    //Compute the class scores for every sample in the batch with a single matrix product
+    scores.multiple( X, w );
+    
+    //Convert the scores to the gradient of the cross entropy loss with respect to the scores: (softmax(scores) - y) / M,
+    //normalizing each row with the log-sum-exp trick
+    Float loss = 0;
+    for(UINT i=0; i<M; i++){
+        Float *s = scores.getData() + i*K;
+        Float maxScore = s[0];
+        for(UINT k=1; k<K; k++){
+            if( s[k] > maxScore ) maxScore = s[k];
+        }
+        Float sum = 0;
+        for(UINT k=0; k<K; k++){
+            sum += exp( s[k] - maxScore );
+        }
+        const Float logSum = maxScore + log( sum );
+        loss += logSum - s[ targets[i] ];
+        for(UINT k=0; k<K; k++){
+            s[k] = exp( s[k] - logSum ) / M;
+        }
+        s[ targets[i] ] -= 1.0 / M;
+    }
+    loss /= M;
+    
+    //Back propagate the gradient to the weights
+    gradient.multiple( X, scores, true );
+    
+    //Add the L2 regularization term, the bias (the first row) is not regularized
+    if( regularizationCoeff > 0 ){
+        const UINT numWeights = w.getSize();
+        const Float *wData = w.getData();
+        Float *g = gradient.getData();
+        Float sumSquares = 0;
+        for(UINT i=K; i<numWeights; i++){
+            sumSquares += wData[i] * wData[i];
+            g[i] += regularizationCoeff * wData[i];
+        }
+        loss += 0.5 * regularizationCoeff * sumSquares;
+    }
+    
+    return loss;
+}
+
+bool Softmax::trainMiniBatch(const ClassificationData &data,const Vector< UINT > &targets){
     
-    Float error = 0;
-    Float errorSum = 0;
-    Float lastErrorSum = 0;
-    Float delta = 0;
     const UINT N = data.getNumDimensions();
     const UINT M = data.getNumSamples();
+    const UINT K = numClasses;
+    const UINT B = batchSize < M ? batchSize : M;
     UINT iter = 0;
     bool keepTraining = true;
-    Random random;
-    VectorFloat y(M);
-    VectorFloat batchMean(N);
+    Float loss = 0;
+    Float lastLoss = grt_numeric_limits< Float >::max();
+    Float delta = 0;
     Vector< UINT > randomTrainingOrder(M);
-    Vector< VectorFloat > batchData(batchSize,VectorFloat(N));
-    
-    //Init the model
-    model.init( classLabel,  N );
-    
-    //Setup the target vector, the input data is relabelled as positive samples (with label 1.0) and negative samples (with label 0.0)
-    for(UINT i=0; i<M; i++){
-        y[i] = data[i].getClassLabel()==classLabel ? 1.0 : 0;
-    }
+    Vector< UINT > batchTargets(B);
+    MatrixFloat batchData(B,N+1);
+    MatrixFloat scores(B,K);
+    MatrixFloat gradient(N+1,K);
     
     //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
     //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
@@ -216,47 +294,51 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,Classificati
     trainingResults.clear();
     trainingResults.reserve( maxNumEpochs );
     TrainingResult epochResult;
-
-    //Run the main stochastic gradient descent training algorithm
+    
+    //Run the main mini-batch gradient descent training algorithm
     while( keepTraining ){
-
-        //Run one epoch of training using stochastic gradient descent
-        errorSum = 0;
+        
+        //Run one epoch of training
+        loss = 0;
         UINT m=0;
         while( m < M ){
-          //Get the batch data for this update
-          UINT roundSize = m+batchSize < M ? batchSize : M-m;
-          batchMean.fill(0.0);
-          for(UINT i=0; i<roundSize; i++){
-            for(UINT j=0; j<N; j++){
-              batchData[i][j] = data[ randomTrainingOrder[m+i] ][j];
-              batchMean[j] += batchData[i][j];
+            //Get the batch data for this update, the first column is set to 1 for the bias
+            UINT roundSize = m+B < M ? B : M-m;
+            if( roundSize != batchData.getNumRows() ) batchData.resize( roundSize, N+1 );
+            for(UINT i=0; i<roundSize; i++){
+                const UINT index = randomTrainingOrder[m+i];
+                Float *row = batchData.getData() + i*(N+1);
+                row[0] = 1.0;
+                for(UINT j=0; j<N; j++){
+                    row[j+1] = data[ index ][j];
+                }
+                batchTargets[i] = targets[ index ];
             }
-          }
-
-          for(UINT j=0; j<N; j++) batchMean[j] /= roundSize;
-
-          //Compute the error on this batch, given the current weights
-          error = 0.0;
-          for(UINT i=0; i<roundSize; i++){
-            error += y[ randomTrainingOrder[m+i] ] - model.compute( batchData[i] );
-          }
-          error /= roundSize;
-          errorSum += error;
-
-          //Update the weights
-          for(UINT j=0; j<N; j++){
-            model.w[j] += learningRate  * error * batchMean[j];
-          }
-          model.w0 += learningRate  * error;
-
-          m += roundSize;
+            
+            //Compute the loss and gradient on this batch, given the current weights
+            loss += computeLossAndGradient( batchData, &batchTargets[0], weights, scores, gradient ) * roundSize;
+            
+            //Update the weights
+            Float *w = weights.getData();
+            const Float *g = gradient.getData();
+            const UINT numWeights = weights.getSize();
+            for(UINT i=0; i<numWeights; i++){
+                w[i] -= learningRate * g[i];
+            }
+            
+            m += roundSize;
         }
-
-        //Compute the error
-        delta = fabs( errorSum-lastErrorSum );
-        lastErrorSum = errorSum;
-
+        loss /= M;
+        
+        if( grt_isnan(loss) || grt_isinf(loss) ){
+            errorLog << "trainMiniBatch(...) - The training loss is not finite, the learning rate might be too large!" << std::endl;
+            return false;
+        }
+        
+        //Compute the change in the loss
+        delta = fabs( loss-lastLoss );
+        lastLoss = loss;
+        
         //Check to see if we should stop
         if( delta <= minChange ){
             keepTraining = false;
@@ -266,8 +348,60 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,Classificati
             keepTraining = false;
         }
         
-        trainingLog << "Class: " << classLabel << " Epoch: " << iter << " TotalError: " << errorSum << " Delta: " << delta << std::endl;
-        epochResult.setClassificationResult( iter, errorSum, this );
+        trainingLog << "Epoch: " << iter << " Loss: " << loss << " Delta: " << delta << std::endl;
+        epochResult.setClassificationResult( iter, loss, this );
+        trainingResults.push_back( epochResult );
+    }
+    
+    return true;
+}
+
+bool Softmax::trainLBFGS(const ClassificationData &data,const Vector< UINT > &targets){
+    
+    const UINT N = data.getNumDimensions();
+    const UINT M = data.getNumSamples();
+    const UINT K = numClasses;
+    
+    //Copy the training data into a single matrix, the first column is set to 1 for the bias
+    MatrixFloat X(M,N+1);
+    for(UINT i=0; i<M; i++){
+        Float *row = X.getData() + i*(N+1);
+        row[0] = 1.0;
+        for(UINT j=0; j<N; j++){
+            row[j+1] = data[i][j];
+        }
+    }
+    
+    MatrixFloat w(N+1,K);
+    MatrixFloat scores(M,K);
+    MatrixFloat gradient(N+1,K);
+    
+    //The optimizer works on the weights as a single vector, which is the row-major data of the weight matrix
+    LBFGS::ObjectiveFunction objective = [&]( const VectorFloat &x, VectorFloat &g ){
+        std::copy( x.begin(), x.end(), w.getData() );
+        const Float loss = computeLossAndGradient( X, &targets[0], w, scores, gradient );
+        std::copy( gradient.getData(), gradient.getData() + gradient.getSize(), g.begin() );
+        return loss;
+    };
+    
+    VectorFloat x( weights.getSize() );
+    std::copy( weights.getData(), weights.getData() + weights.getSize(), x.begin() );
+    
+    LBFGS optimizer( 10, maxNumEpochs, minChange );
+    if( !optimizer.minimize( objective, x ) ){
+        errorLog << "trainLBFGS(...) - Failed to minimize the training loss!" << std::endl;
+        return false;
+    }
+    std::copy( x.begin(), x.end(), weights.getData() );
+    
+    //Store the loss after each iteration as the training results
+    VectorFloat losses = optimizer.getObjectiveValues();
+    trainingResults.clear();
+    trainingResults.reserve( losses.getSize() );
+    TrainingResult epochResult;
+    for(UINT iter=1; iter<losses.getSize(); iter++){
+        trainingLog << "Iteration: " << iter << " Loss: " << losses[iter] << " Delta: " << fabs( losses[iter]-losses[iter-1] ) << std::endl;
+        epochResult.setClassificationResult( iter, losses[iter], this );
         trainingResults.push_back( epochResult );
     }
     
@@ -280,7 +414,7 @@ bool Softmax::clear(){
     Classifier::clear();
     
     //Clear the Softmax model
-    models.clear();
+    weights.clear();
     
     return true;
 }
@@ -305,10 +439,10 @@ bool Softmax::save( std::fstream &file ) const{
     if( trained ){
         file << "Models:\n";
         for(UINT k=0; k<numClasses; k++){
-            file << "ClassLabel: " << models[k].classLabel << std::endl;
-            file << "Weights: " << models[k].w0;
+            file << "ClassLabel: " << classLabels[k] << std::endl;
+            file << "Weights: " << weights[0][k];
             for(UINT n=0; n<numInputDimensions; n++){
-                file << " " << models[k].w[n];
+                file << " " << weights[n+1][k];
             }
             file << std::endl;
         }
@@ -322,7 +456,7 @@ bool Softmax::load( std::fstream &file ){
     trained = false;
     numInputDimensions = 0;
     numClasses = 0;
-    models.clear();
+    weights.clear();
     classLabels.clear();
     
     if(!file.is_open())
@@ -354,7 +488,7 @@ bool Softmax::load( std::fstream &file ){
     
     if( trained ){
         //Resize the buffer
-        models.resize(numClasses);
+        weights.resize(numInputDimensions+1,numClasses);
         classLabels.resize(numClasses);
         
         //Load the models
@@ -370,20 +504,17 @@ bool Softmax::load( std::fstream &file ){
                 errorLog << "load(string filename) - Could not find the ClassLabel for model: " << k << "!" << std::endl;
                     return false;
             }
-            file >> models[k].classLabel;
-            classLabels[k] = models[k].classLabel;
+            file >> classLabels[k];
             
             file >> word;
             if(word != "Weights:"){
                 errorLog << "load(string filename) - Could not find the Weights for model: " << k << "!" << std::endl;
                     return false;
             }
-            file >>  models[k].w0;
+            file >> weights[0][k];
             
-            models[k].N = numInputDimensions;
-            models[k].w.resize( numInputDimensions );
             for(UINT n=0; n<numInputDimensions; n++){
-                file >> models[k].w[n];
+                file >> weights[n+1][k];
             }
         }
         
@@ -401,9 +532,63 @@ bool Softmax::load( std::fstream &file ){
 }
 
 Vector< SoftmaxModel > Softmax::getModels() const{
+    Vector< SoftmaxModel > models( numClasses );
+    if( !trained ) return models;
+    for(UINT k=0; k<numClasses; k++){
+        models[k].classLabel = classLabels[k];
+        models[k].N = numInputDimensions;
+        models[k].w0 = weights[0][k];
+        models[k].w.resize( numInputDimensions );
+        for(UINT n=0; n<numInputDimensions; n++){
+            models[k].w[n] = weights[n+1][k];
+        }
+    }
     return models;
 }
 
+MatrixFloat Softmax::getWeights() const{
+    return weights;
+}
+
+UINT Softmax::getBatchSize() const{
+    return batchSize;
+}
+
+UINT Softmax::getTrainingMethod() const{
+    return trainingMethod;
+}
+
+Float Softmax::getRegularizationCoeff() const{
+    return regularizationCoeff;
+}
+
+bool Softmax::setBatchSize(const UINT batchSize){
+    if( batchSize == 0 ){
+        warningLog << "setBatchSize(const UINT batchSize) - The batch size must be greater than zero!" << std::endl;
+        return false;
+    }
+    this->batchSize = batchSize;
+    return true;
+}
+
+bool Softmax::setTrainingMethod(const UINT trainingMethod){
+    if( trainingMethod != MINI_BATCH_GRADIENT_DESCENT && trainingMethod != LIMITED_MEMORY_BFGS ){
+        warningLog << "setTrainingMethod(const UINT trainingMethod) - Unknown training method: " << trainingMethod << std::endl;
+        return false;
+    }
+    this->trainingMethod = trainingMethod;
+    return true;
+}
+
+bool Softmax::setRegularizationCoeff(const Float regularizationCoeff){
+    if( regularizationCoeff < 0 ){
+        warningLog << "setRegularizationCoeff(const Float regularizationCoeff) - The regularization coefficient must be greater than or equal to zero!" << std::endl;
+        return false;
+    }
+    this->regularizationCoeff = regularizationCoeff;
+    return true;
+}
+
 bool Softmax::loadLegacyModelFromFile( std::fstream &file ){
     
     std::string word;
@@ -453,7 +638,7 @@ bool Softmax::loadLegacyModelFromFile( std::fstream &file ){
     }
     
     //Resize the buffer
-    models.resize(numClasses);
+    weights.resize(numInputDimensions+1,numClasses);
     classLabels.resize(numClasses);
     
     //Load the models
@@ -469,20 +654,17 @@ bool Softmax::loadLegacyModelFromFile( std::fstream &file ){
             errorLog << "load(string filename) - Could not find the ClassLabel for model: " << k << "!" << std::endl;
                 return false;
         }
-        file >> models[k].classLabel;
-        classLabels[k] = models[k].classLabel;
+        file >> classLabels[k];
         
         file >> word;
         if(word != "Weights:"){
             errorLog << "load(string filename) - Could not find the Weights for model: " << k << "!" << std::endl;
                 return false;
         }
-        file >>  models[k].w0;
+        file >> weights[0][k];
         
-        models[k].N = numInputDimensions;
-        models[k].w.resize( numInputDimensions );
         for(UINT n=0; n<numInputDimensions; n++){
-            file >> models[k].w[n];
+            file >> weights[n+1][k];
         }
     }
     
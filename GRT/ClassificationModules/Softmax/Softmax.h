@@ -5,6 +5,11 @@
 
 @brief The Softmax Classifier is a simple but effective classifier (based on logisitc regression) that works well on problems that are linearly separable.
 
+The classifier is trained as a single multinomial logistic regression model, minimizing the cross entropy loss of all the classes
+jointly. The weights of all the classes are stored in one matrix, so the class scores for a batch of samples are computed with a
+single matrix product, and a prediction is one matrix-vector product followed by the softmax function. The model can be trained
+with mini-batch gradient descent (the default) or with L-BFGS.
+
 @example ClassificationModulesExamples/SoftmaxExample/SoftmaxExample.cpp
 
 @remark This implementation is based on Bishop, Christopher M. Pattern recognition and machine learning. Vol. 1. New York: springer, 2006.
@@ -35,12 +40,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "../../CoreModules/Classifier.h"
 #include "SoftmaxModel.h"
+#include "../../CoreAlgorithms/LBFGS/LBFGS.h"
 
 GRT_BEGIN_NAMESPACE
 
 class GRT_API Softmax : public Classifier
 {
     public:
+    enum TrainingMethods{ MINI_BATCH_GRADIENT_DESCENT=0, LIMITED_MEMORY_BFGS };
+    
     /**
     Default Constructor
     
@@ -127,10 +135,59 @@ class GRT_API Softmax : public Classifier
     
     /**
     Get the softmax models for each class. The Softmax class must be trained first.
+    These are copied from the weight matrix, the likelihood of each class is the softmax of the scores of all the models.
     
     @return returns a vector of softmax models, with each element representing the model for a specific class
     */
     Vector< SoftmaxModel > getModels() const;
+    
+    /**
+    Gets the weight matrix. This has numInputDimensions+1 rows and numClasses columns, the first row contains the bias of each
+    class and row n+1 contains the weights of input dimension n.
+    
+    @return returns the weight matrix, this will be empty if the model has not been trained
+    */
+    MatrixFloat getWeights() const;
+    
+    /**
+    @return returns the number of training samples used in each batch to update the model weights
+    */
+    UINT getBatchSize() const;
+    
+    /**
+    @return returns the training method, this will be one of the TrainingMethods enums
+    */
+    UINT getTrainingMethod() const;
+    
+    /**
+    @return returns the L2 regularization coefficient
+    */
+    Float getRegularizationCoeff() const;
+    
+    /**
+    Sets the number of training samples used in each batch to update the model weights with mini-batch gradient descent.
+    
+    @param batchSize: the new batch size, must be greater than zero
+    @return returns true if the batch size was updated, false otherwise
+    */
+    bool setBatchSize(const UINT batchSize);
+    
+    /**
+    Sets the training method. This should be MINI_BATCH_GRADIENT_DESCENT or LIMITED_MEMORY_BFGS. L-BFGS runs on the full training
+    data, using the maxNumEpochs as the maximum number of iterations and the minChange as the minimum change in the training loss.
+    
+    @param trainingMethod: the new training method
+    @return returns true if the training method was updated, false otherwise
+    */
+    bool setTrainingMethod(const UINT trainingMethod);
+    
+    /**
+    Sets the L2 regularization coefficient. The biases are not regularized.
+    
+    @param regularizationCoeff: the new regularization coefficient, must be greater than or equal to zero. Default value = 0
+    @return returns true if the regularization coefficient was updated, false otherwise
+    */
+    bool setRegularizationCoeff(const Float regularizationCoeff);
 
 
     /**
@@ -145,11 +202,15 @@ class GRT_API Softmax : public Classifier
     using MLBase::load;
     
 protected:
-    bool trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,ClassificationData &data);
+    bool trainMiniBatch(const ClassificationData &data,const Vector< UINT > &targets);
+    bool trainLBFGS(const ClassificationData &data,const Vector< UINT > &targets);
+    Float computeLossAndGradient(const MatrixFloat &X,const UINT *targets,const MatrixFloat &w,MatrixFloat &scores,MatrixFloat &gradient) const;
     bool loadLegacyModelFromFile( std::fstream &file );
     
     UINT batchSize;
-    Vector< SoftmaxModel > models;
+    UINT trainingMethod;
+    Float regularizationCoeff;
+    MatrixFloat weights;
     static std::string id;
     
     static RegisterClassifierModule< Softmax > registerModule;
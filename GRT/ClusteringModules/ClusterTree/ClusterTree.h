@@ -176,7 +176,7 @@ public:
     using MLBase::saveModelToFile;
     using MLBase::loadModelFromFile;
     using MLBase::train;
-    using MLBase::predict;
+    using Clusterer::predict;
     
 protected:
     Float minRMSErrorPerNode;
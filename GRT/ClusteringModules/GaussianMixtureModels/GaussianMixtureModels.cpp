@@ -456,7 +456,8 @@ bool GaussianMixtureModels::loadModelFromFile( std::fstream &file ){
 
 bool GaussianMixtureModels::estep( const MatrixFloat &data, VectorFloat &u, VectorFloat &v, Float &change ){
 
-	Float tmp,sum,max,oldloglike;
+	Float tmp,max,oldloglike;
+	AccumFloat sum, totalLoglike;
 	for(UINT j=0; j<numInputDimensions; j++) u[j] = v[j] = 0;
 
 	oldloglike = loglike;
@@ -471,21 +472,22 @@ bool GaussianMixtureModels::estep( const MatrixFloat &data, VectorFloat &u, Vect
 			if( !cholesky.elsolve(u,v) ){ return false; }
 			sum=0;
 			for(UINT j=0; j<numInputDimensions; j++) sum += SQR(v[j]);
-			resp[i][k] = -0.5*(sum + lndets[k]) + log(frac[k]);
+			resp[i][k] = Float( -0.5*(sum + lndets[k]) + log(frac[k]) );
 		}
 	}
 
 	//Compute the overall likelihood of the entire estimated paramter set
-	loglike = 0;
+	totalLoglike = 0;
 	for(UINT i=0; i<numTrainingSamples; i++){
 		sum=0;
-		max = -99.9e99;
+		max = -grt_numeric_limits< Float >::max();
 		for(UINT k=0; k<numClusters; k++) if( resp[i][k] > max ) max = resp[i][k];
 		for(UINT k=0; k<numClusters; k++) sum += exp( resp[i][k]-max );
-		tmp = max + log( sum );
+		tmp = Float( max + log( sum ) );
 		for(UINT k=0; k<numClusters; k++) resp[i][k] = exp( resp[i][k] - tmp );
-		loglike += tmp;
+		totalLoglike += tmp;
 	}
+	loglike = Float( totalLoglike );
     
     change = (loglike - oldloglike);
 
@@ -494,21 +496,27 @@ bool GaussianMixtureModels::estep( const MatrixFloat &data, VectorFloat &u, Vect
 
 bool GaussianMixtureModels::mstep( const MatrixFloat &data ){
 
-	Float wgt, sum;
+	//The weighted sums are accumulated in double precision, even if Float is single precision
+	AccumFloat wgt, sum;
 	for(UINT k=0; k<numClusters; k++){
 		wgt = 0.0;
 		for(UINT m=0; m<numTrainingSamples; m++) wgt += resp[m][k];
-		frac[k] = wgt/Float(numTrainingSamples);
+		frac[k] = Float( wgt/numTrainingSamples );
+		
+		//Update the mean of every dimension before the covariance, so the covariance matrix is symmetric
 		for(UINT n=0; n<numInputDimensions; n++){
 			sum = 0;
-			for(UINT m=0; m<numTrainingSamples; m++) sum += resp[m][k] * data[m][n];
-			mu[k][n] = sum/wgt;
-			for(UINT j=0; j<numInputDimensions; j++){
+			for(UINT m=0; m<numTrainingSamples; m++) sum += AccumFloat(resp[m][k]) * data[m][n];
+			mu[k][n] = Float( sum/wgt );
+		}
+		
+		for(UINT n=0; n<numInputDimensions; n++){
+			for(UINT j=n; j<numInputDimensions; j++){
 				sum = 0;
 				for(UINT m=0; m<numTrainingSamples; m++){
-					sum += resp[m][k] * (data[m][n]-mu[k][n]) * (data[m][j]-mu[k][j]);
+					sum += AccumFloat(resp[m][k]) * (data[m][n]-mu[k][n]) * (data[m][j]-mu[k][j]);
 				}
-				sigma[k][n][j] = sum/wgt;
+				sigma[k][n][j] = sigma[k][j][n] = Float( sum/wgt );
 			}
 		}
 	}
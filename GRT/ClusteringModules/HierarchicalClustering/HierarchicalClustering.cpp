@@ -57,7 +57,6 @@ HierarchicalClustering& HierarchicalClustering::operator=(const HierarchicalClus
         this->M = rhs.M;
         this->N = rhs.N;
         this->clusters = rhs.clusters;
-        this->distanceMatrix = rhs.distanceMatrix;
         
         //Clone the Clusterer variables
         copyBaseVariables( (Clusterer*)&rhs );
@@ -77,7 +76,6 @@ bool HierarchicalClustering::deepCopyFrom(const Clusterer *clusterer){
         this->M = ptr->M;
         this->N = ptr->N;
         this->clusters = ptr->clusters;
-        this->distanceMatrix = ptr->distanceMatrix;
         
         //Clone the Clusterer variables
         return copyBaseVariables( clusterer );
@@ -99,7 +97,6 @@ bool HierarchicalClustering::clear(){
     M = 0;
     N = 0;
     clusters.clear();
-    distanceMatrix.clear();
     
     return true;
 }
@@ -144,11 +141,22 @@ bool HierarchicalClustering::train_(UnlabelledData &trainingData){
 	return train( data );
 }
 
+//Returns the root of the union-find tree containing sample i, compressing the path as it goes
+static UINT findClusterRoot( Vector< UINT > &root, UINT i ){
+    UINT r = i;
+    while( root[r] != r ) r = root[r];
+    while( root[i] != r ){
+        const UINT next = root[i];
+        root[i] = r;
+        i = next;
+    }
+    return r;
+}
+
 bool HierarchicalClustering::train_(MatrixFloat &data){
 	
 	trained = false;
     clusters.clear();
-    distanceMatrix.clear();
     
     if( data.getNumRows() == 0 || data.getNumCols() == 0 ){
 		return false;
@@ -158,19 +166,6 @@ bool HierarchicalClustering::train_(MatrixFloat &data){
     M = data.getNumRows();
 	N = data.getNumCols();
     
-    //Build the distance matrix
-    distanceMatrix.resize(M,M);
-
-    //Build the distance matrix
-    for(UINT i=0; i<M; i++){
-        for(UINT j=0; j<M; j++){
-            if( i== j ) distanceMatrix[i][j] = grt_numeric_limits< Float >::max();
-            else{
-                distanceMatrix[i][j] = squaredEuclideanDistance(data[i], data[j]);
-            }
-        }
-    }
-
     //Build the initial clusters, at the start each sample gets its own cluster
     UINT uniqueClusterID = 0;
     Vector< ClusterInfo > clusterData(M);
@@ -192,101 +187,145 @@ bool HierarchicalClustering::train_(MatrixFloat &data){
     
     //Move to level 1 and start the search
     level++;
-    bool keepClustering = true;
     
-    while( keepClustering ){
+    if( M < 2 ){
+        warningLog << "train_(MatrixFloat &data) - Failed to find any cluster at level: " << level << std::endl;
+        return false;
+    }
+    
+    //The single linkage merges are the edges of the minimum spanning tree of the samples, in order of increasing distance,
+    //so there is no need to store a distance matrix or to rescan every pair of clusters at each level
+    Vector< UINT > edgeA;
+    Vector< UINT > edgeB;
+    VectorFloat edgeDist;
+    computeMinimumSpanningTree( data, edgeA, edgeB, edgeDist );
+    
+    const UINT numEdges = M-1;
+    Vector< UINT > edgeOrder( numEdges );
+    for(UINT i=0; i<numEdges; i++) edgeOrder[i] = i;
+    std::stable_sort( edgeOrder.begin(), edgeOrder.end(), [&edgeDist](const UINT a,const UINT b){ return edgeDist[a] < edgeDist[b]; } );
+    
+    //Each cluster is stored at the root of its union-find tree. The cluster key gives its position in the list of active clusters
+    //(the samples in order, followed by the merged clusters in the order they were created), which is used to break ties in the
+    //same way as a full scan over the list of clusters
+    Vector< UINT > root(M);
+    Vector< UINT > clusterKey(M);
+    for(UINT i=0; i<M; i++){
+        root[i] = i;
+        clusterKey[i] = i;
+    }
+    UINT nextKey = M;
+    
+    //Tied edges are resolved by merging the pair of clusters at that distance with the lowest keys, this needs all the sample
+    //pairs of the clusters involved (not just the tree edges) so it is limited to ties between reasonably small clusters
+    const UINT maxTieResolutionSize = 4096;
+    
+    UINT e = 0;
+    while( e < numEdges ){
+        
+        //Find all the edges with the same distance
+        const Float dist = edgeDist[ edgeOrder[e] ];
+        UINT tieEnd = e+1;
+        while( tieEnd < numEdges && edgeDist[ edgeOrder[tieEnd] ] == dist ) tieEnd++;
+        
+        //Get the clusters connected by these edges
+        Vector< UINT > tieClusters;
+        for(UINT k=e; k<tieEnd; k++){
+            const UINT a = findClusterRoot( root, edgeA[ edgeOrder[k] ] );
+            const UINT b = findClusterRoot( root, edgeB[ edgeOrder[k] ] );
+            if( std::find(tieClusters.begin(),tieClusters.end(),a) == tieClusters.end() ) tieClusters.push_back( a );
+            if( std::find(tieClusters.begin(),tieClusters.end(),b) == tieClusters.end() ) tieClusters.push_back( b );
+        }
+        const UINT numTieClusters = tieClusters.getSize();
         
-        //Find the closest two clusters within the cluster data
-        Float minDist = grt_numeric_limits< Float >::max();
-        Vector< Vector< UINT > > clusterPairs;
-        UINT K = (UINT)clusterData.size();
-        for(UINT i=0; i<K; i++){
-            for(UINT j=0; j<K; j++){
-                if( i != j ){
-                    Float dist = computeClusterDistance( clusterData[i], clusterData[j]  );
-             
-                    if( dist < minDist ){
-                        minDist = dist;
-                        Vector< UINT > clusterPair(2);
-                        clusterPair[0] = i;
-                        clusterPair[1] = j;
-                        clusterPairs.clear();
-                        clusterPairs.push_back( clusterPair );
+        //Flag which of these clusters are at the current distance from each other
+        Matrix< bool > adjacent( numTieClusters, numTieClusters );
+        adjacent.setAll( false );
+        UINT numTieSamples = 0;
+        for(UINT i=0; i<numTieClusters; i++) numTieSamples += clusterData[ tieClusters[i] ].getNumSamplesInCluster();
+        
+        if( tieEnd-e > 1 && numTieSamples <= maxTieResolutionSize ){
+            for(UINT i=0; i<numTieClusters; i++){
+                const ClusterInfo &clusterA = clusterData[ tieClusters[i] ];
+                for(UINT j=i+1; j<numTieClusters; j++){
+                    const ClusterInfo &clusterB = clusterData[ tieClusters[j] ];
+                    bool found = false;
+                    for(UINT a=0; a<clusterA.getNumSamplesInCluster() && !found; a++){
+                        for(UINT b=0; b<clusterB.getNumSamplesInCluster() && !found; b++){
+                            found = squaredEuclideanDistance( data[ clusterA[a] ], data[ clusterB[b] ] ) == dist;
+                        }
                     }
-                    
+                    adjacent[i][j] = adjacent[j][i] = found;
                 }
             }
-        }
-        
-        if( minDist == grt_numeric_limits< Float >::max() ){
-            keepClustering = false;
-            warningLog << "train_(MatrixFloat &data) - Failed to find any cluster at level: " << level << std::endl;
-            return false;
         }else{
+            for(UINT k=e; k<tieEnd; k++){
+                const UINT a = findClusterRoot( root, edgeA[ edgeOrder[k] ] );
+                const UINT b = findClusterRoot( root, edgeB[ edgeOrder[k] ] );
+                const UINT i = UINT( std::find(tieClusters.begin(),tieClusters.end(),a) - tieClusters.begin() );
+                const UINT j = UINT( std::find(tieClusters.begin(),tieClusters.end(),b) - tieClusters.begin() );
+                adjacent[i][j] = adjacent[j][i] = true;
+            }
+        }
         
-            //Merge the two closest clusters together and create a new level
-            ClusterLevel newLevel;
-            newLevel.level = level;
-            
-            //Create the new cluster
-            ClusterInfo newCluster;
-            newCluster.uniqueClusterID = uniqueClusterID++;
+        //Merge the clusters, one level per merge
+        Vector< bool > active( numTieClusters, true );
+        for(UINT k=e; k<tieEnd; k++){
             
-            const UINT numClusterPairs = clusterPairs.getSize();
-            
-            for(UINT k=0; k<numClusterPairs; k++){
-                //Add all the samples in the first cluster to the new cluster
-                UINT numSamplesInClusterA = clusterData[ clusterPairs[k][0] ].getNumSamplesInCluster();
-                for(UINT i=0; i<numSamplesInClusterA; i++){
-                    UINT index = clusterData[ clusterPairs[k][0] ][ i ];
-                    newCluster.addSampleToCluster( index );
-                }
-                
-                //Add all the samples in the second cluster to the new cluster
-                UINT numSamplesInClusterB = clusterData[ clusterPairs[k][1] ].getNumSamplesInCluster();
-                for(UINT i=0; i<numSamplesInClusterB; i++){
-                    UINT index = clusterData[ clusterPairs[k][1] ][ i ];
-                    newCluster.addSampleToCluster( index );
-                }
-                
-                //Compute the cluster variance
-                newCluster.clusterVariance = computeClusterVariance( newCluster, data );
-                
-                //Remove the two cluster pairs (so they will not be used in the next search
-                UINT idA = clusterData[ clusterPairs[k][0] ].getUniqueClusterID();
-                UINT idB = clusterData[ clusterPairs[k][1] ].getUniqueClusterID();
-                UINT numRemoved = 0;
-                Vector< ClusterInfo >::iterator iter = clusterData.begin();
-                while( iter != clusterData.end() ){
-                    if( iter->getUniqueClusterID() == idA || iter->getUniqueClusterID() == idB ){
-                        iter = clusterData.erase( iter );
-                        if( ++numRemoved >= 2 ) break;
-                    }else iter++;
+            //Find the adjacent pair of clusters with the lowest keys
+            UINT bestI = 0;
+            UINT bestJ = 0;
+            bool foundPair = false;
+            for(UINT i=0; i<numTieClusters; i++){
+                if( !active[i] ) continue;
+                for(UINT j=0; j<numTieClusters; j++){
+                    if( i == j || !active[j] || !adjacent[i][j] ) continue;
+                    const UINT keyI = clusterKey[ tieClusters[i] ];
+                    const UINT keyJ = clusterKey[ tieClusters[j] ];
+                    if( keyI > keyJ ) continue;
+                    if( !foundPair || keyI < clusterKey[ tieClusters[bestI] ] || (keyI == clusterKey[ tieClusters[bestI] ] && keyJ < clusterKey[ tieClusters[bestJ] ]) ){
+                        bestI = i;
+                        bestJ = j;
+                        foundPair = true;
+                    }
                 }
             }
             
-            //Add the merged cluster to the clusterData
-            clusterData.push_back( newCluster );
+            if( !foundPair ){
+                errorLog << "train_(MatrixFloat &data) - Failed to find any cluster at level: " << level << std::endl;
+                return false;
+            }
+            
+            //Merge cluster B into cluster A, adding all the samples in the first cluster and then the second cluster to the new cluster
+            const UINT rootA = tieClusters[ bestI ];
+            const UINT rootB = tieClusters[ bestJ ];
+            ClusterInfo &clusterA = clusterData[ rootA ];
+            ClusterInfo &clusterB = clusterData[ rootB ];
+            clusterA.uniqueClusterID = uniqueClusterID++;
+            clusterA.indexs.insert( clusterA.indexs.end(), clusterB.indexs.begin(), clusterB.indexs.end() );
+            clusterA.clusterVariance = computeClusterVariance( clusterA, data );
+            Vector< UINT >().swap( clusterB.indexs );
+            root[ rootB ] = rootA;
+            clusterKey[ rootA ] = nextKey++;
             
-            //Add the new level and cluster data to the main cluster buffer
-            newLevel.clusters.push_back( newCluster );
+            active[ bestJ ] = false;
+            for(UINT i=0; i<numTieClusters; i++){
+                adjacent[bestI][i] = adjacent[i][bestI] = (adjacent[bestI][i] || adjacent[bestJ][i]) && i != bestI;
+            }
             
+            //Add the new level to the main cluster buffer
+            ClusterLevel newLevel;
+            newLevel.level = level;
+            newLevel.clusters.push_back( clusterA );
             clusters.push_back( newLevel );
             
             //Update the level
             level++;
+            
+            trainingLog << "Cluster level: " << level << " Number of clusters: " << clusters.back().getNumClusters() << std::endl;
         }
         
-        //Check to see if we should stop clustering
-        if( level >= M ){
-            keepClustering = false;
-        }
-        
-        if( clusterData.size() == 0 ){
-            keepClustering = false;
-        }
-        
-        trainingLog << "Cluster level: " << level << " Number of clusters: " << clusters.back().getNumClusters() << std::endl;
+        e = tieEnd;
     }
     
     //Flag that the model is trained
@@ -303,6 +342,68 @@ bool HierarchicalClustering::train_(MatrixFloat &data){
 	return true;
 }
     
+void HierarchicalClustering::computeMinimumSpanningTree( const MatrixFloat &data, Vector< UINT > &edgeA, Vector< UINT > &edgeB, VectorFloat &edgeDist ) const{
+    
+    edgeA.resize( M-1 );
+    edgeB.resize( M-1 );
+    edgeDist.resize( M-1 );
+    
+    //For each sample not yet in the tree, store the closest sample in the tree and the distance to it
+    Vector< bool > inTree( M, false );
+    Vector< UINT > closest( M, 0 );
+    VectorFloat closestDist( M, grt_numeric_limits< Float >::max() );
+    
+    //Each update of the closest distances is split into blocks that are searched concurrently, small problems are run serially
+    const UINT minBlockSize = 1024;
+    const UINT numBlocks = ThreadPool::getNumParallelBlocks( M, minBlockSize );
+    Vector< UINT > blockBestIndex( numBlocks );
+    VectorFloat blockBestDist( numBlocks );
+    
+    //Adds the sample v to the tree, updating the closest distances for the samples in the block and returning the next best sample in the block
+    auto updateBlock = [&]( const UINT v, const UINT block ){
+        const UINT start = (UINT)( (unsigned long long)M * block / numBlocks );
+        const UINT end = (UINT)( (unsigned long long)M * (block+1) / numBlocks );
+        UINT bestIndex = M;
+        Float bestDist = grt_numeric_limits< Float >::max();
+        for(UINT u=start; u<end; u++){
+            if( inTree[u] ) continue;
+            const Float dist = squaredEuclideanDistance( data[v], data[u] );
+            if( dist < closestDist[u] ){
+                closestDist[u] = dist;
+                closest[u] = v;
+            }
+            if( bestIndex == M || closestDist[u] < bestDist ){
+                bestDist = closestDist[u];
+                bestIndex = u;
+            }
+        }
+        blockBestIndex[ block ] = bestIndex;
+        blockBestDist[ block ] = bestDist;
+    };
+    
+    UINT v = 0;
+    for(UINT k=0; k<M-1; k++){
+        inTree[v] = true;
+        
+        ThreadPool::parallelFor( 0, numBlocks, 1, [&updateBlock,v](const UINT blockBegin,const UINT blockEnd){
+            for(UINT block=blockBegin; block<blockEnd; block++) updateBlock( v, block );
+            return true;
+        }, numBlocks );
+        
+        //Add the closest sample to the tree
+        UINT next = M;
+        for(UINT block=0; block<numBlocks; block++){
+            if( blockBestIndex[block] == M ) continue;
+            if( next == M || blockBestDist[block] < closestDist[next] ) next = blockBestIndex[block];
+        }
+        
+        edgeA[k] = closest[next];
+        edgeB[k] = next;
+        edgeDist[k] = closestDist[next];
+        v = next;
+    }
+}
+    
 bool HierarchicalClustering::printModel(){
     
     UINT K = (UINT)clusters.size();
@@ -330,7 +431,7 @@ bool HierarchicalClustering::printModel(){
     return true;
 }
     
-Float HierarchicalClustering::squaredEuclideanDistance(const Float *a,const Float *b){
+Float HierarchicalClustering::squaredEuclideanDistance(const Float *a,const Float *b) const{
     Float dist = 0;
     for(UINT i=0; i<N; i++){
         dist += SQR( a[i] - b[i] );
@@ -338,24 +439,6 @@ Float HierarchicalClustering::squaredEuclideanDistance(const Float *a,const Floa
     return dist;
 }
     
-Float HierarchicalClustering::computeClusterDistance( const ClusterInfo &clusterA, const ClusterInfo &clusterB ){
-    
-    Float minDist = grt_numeric_limits< Float >::max();
-    const UINT numSamplesA = clusterA.getNumSamplesInCluster();
-    const UINT numSamplesB = clusterB.getNumSamplesInCluster();
-    
-    //Find the minimum distance between the two clusters
-    for(UINT i=0; i<numSamplesA; i++){
-        for(UINT j=0; j<numSamplesB; j++){
-            if( distanceMatrix[ clusterA[i] ][ clusterB[j] ] < minDist ){
-                minDist = distanceMatrix[ clusterA[i] ][ clusterB[j] ];
-            }
-        }
-    }
-    
-    return minDist;
-}
-    
 Float HierarchicalClustering::computeClusterVariance( const ClusterInfo &cluster, const MatrixFloat &data ){
     
     VectorFloat mean(N,0);
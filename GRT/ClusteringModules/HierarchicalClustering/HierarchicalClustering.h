@@ -234,15 +234,25 @@ public:
     using MLBase::loadModelFromFile;
 
 protected:
-	inline Float SQR(const Float &a) {return a*a;};
-    Float squaredEuclideanDistance(const Float *a,const Float *b);
-    Float computeClusterDistance( const ClusterInfo &clusterA, const ClusterInfo &clusterB );
+	inline Float SQR(const Float &a) const {return a*a;};
+    Float squaredEuclideanDistance(const Float *a,const Float *b) const;
     Float computeClusterVariance( const ClusterInfo &cluster, const MatrixFloat &data );
+    
+    /**
+     Computes the minimum spanning tree of the training samples (using the squared Euclidean distance) with Prim's algorithm.
+     Only O(M) memory is used, the distances are computed on the fly and, if C++11 is enabled, in parallel across the samples.
+     The single linkage merges are exactly the edges of this tree, taken in order of increasing distance.
+     
+     @param data: the training data
+     @param edgeA: returns the index of the first sample of each of the M-1 edges
+     @param edgeB: returns the index of the second sample of each of the M-1 edges
+     @param edgeDist: returns the squared distance of each of the M-1 edges
+     */
+    void computeMinimumSpanningTree( const MatrixFloat &data, Vector< UINT > &edgeA, Vector< UINT > &edgeB, VectorFloat &edgeDist ) const;
 
 	UINT M;                             //Number of training examples
 	UINT N;                             //Number of dimensions
     Vector< ClusterLevel > clusters;
-    MatrixFloat distanceMatrix;                     //The distance matrix
 
 private:
     static RegisterClustererModule< HierarchicalClustering > registerModule;
@@ -198,6 +198,10 @@ bool KMeans::train_(MatrixFloat &data){
 }
     
 bool KMeans::predict_(VectorFloat &inputVector){
+    return predictAndStoreResults( inputVector );
+}
+
+bool KMeans::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
     
     if( !trained ){
         return false;
@@ -218,6 +222,11 @@ bool KMeans::predict_(VectorFloat &inputVector){
     Float sum = 0;
     Float dist = 0;
 	UINT minIndex = 0;
+	UINT &predictedClusterLabel = context.predictedClusterLabel;
+	Float &maxLikelihood = context.maxLikelihood;
+	Float &bestDistance = context.bestDistance;
+	VectorFloat &clusterLikelihoods = context.clusterLikelihoods;
+	VectorFloat &clusterDistances = context.clusterDistances;
 	bestDistance = grt_numeric_limits< Float >::max();
 	predictedClusterLabel = 0;
 	maxLikelihood = 0;
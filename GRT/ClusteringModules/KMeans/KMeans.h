@@ -177,10 +177,12 @@ public:
     using MLBase::loadModelFromFile;
     using MLBase::train;
     using MLBase::train_;
-    using MLBase::predict;
+    using Clusterer::predict;
     using MLBase::predict_;
 
 protected:
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    
     UINT estep(const MatrixFloat &data);
     void mstep(const MatrixFloat &data);
     Float calculateTheta(const MatrixFloat &data);
@@ -37,6 +37,7 @@ SelfOrganizingMap::SelfOrganizingMap( const UINT networkSize, const UINT network
     this->sigmaWeight = sigmaWeight;
     this->alphaStart = alphaStart;
     this->alphaEnd = alphaEnd;
+    this->useBatchTraining = false;
     
     classType = "SelfOrganizingMap";
     clustererType = classType;
@@ -58,6 +59,7 @@ SelfOrganizingMap::SelfOrganizingMap(const SelfOrganizingMap &rhs){
     if( this != &rhs ){
         
         this->numClusters = rhs.numClusters;
+        this->useBatchTraining = rhs.useBatchTraining;
         this->networkTypology = rhs.networkTypology;
         this->sigmaWeight = rhs.sigmaWeight;
         this->alphaStart = rhs.alphaStart;
@@ -79,6 +81,7 @@ SelfOrganizingMap& SelfOrganizingMap::operator=(const SelfOrganizingMap &rhs){
     if( this != &rhs ){
         
         this->numClusters = rhs.numClusters;
+        this->useBatchTraining = rhs.useBatchTraining;
         this->networkTypology = rhs.networkTypology;
         this->sigmaWeight = rhs.sigmaWeight;
         this->alphaStart = rhs.alphaStart;
@@ -102,6 +105,7 @@ bool SelfOrganizingMap::deepCopyFrom(const Clusterer *clusterer){
         const SelfOrganizingMap *ptr = dynamic_cast<const SelfOrganizingMap*>(clusterer);
         
         this->numClusters = ptr->numClusters;
+        this->useBatchTraining = ptr->useBatchTraining;
         this->networkTypology = ptr->networkTypology;
         this->sigmaWeight = ptr->sigmaWeight;
         this->alphaStart = ptr->alphaStart;
@@ -171,22 +175,48 @@ bool SelfOrganizingMap::train_( MatrixFloat &data ){
         }
     }
     
+    const UINT K = numClusters*numClusters;
     Float error = 0;
     Float lastError = 0;
-    Float trainingSampleError = 0;
     Float delta = 0;
     Float minChange = 0;
-    Float weightUpdate = 0;
-    Float weightUpdateSum = 0;
     Float alpha = 1.0;
     Float neuronDiff = 0;
     Float neuronWeightFunction = 0;
-    Float gamma = 0;
+    Float bestDist = 0;
+    UINT bestIndex = 0;
     UINT iter = 0;
     bool keepTraining = true;
-    VectorFloat trainingSample;
     Vector< UINT > randomTrainingOrder(M);
     
+    //Copy the neuron weights into a contiguous matrix (one neuron per row) for training, the neurons are updated at the end
+    MatrixFloat weights(K,N);
+    for(UINT i=0; i<numClusters; i++){
+        for(UINT j=0; j<numClusters; j++){
+            Float *w = weights[i*numClusters+j];
+            for(UINT n=0; n<N; n++) w[n] = neurons[i][j][n];
+        }
+    }
+    
+    //The batch update has no randomness of its own, so seed each neuron with a random training sample to spread the map over the data
+    if( useBatchTraining ){
+        for(UINT k=0; k<K; k++){
+            const Float *x = data[ rand.getRandomNumberInt(0,M) ];
+            Float *w = weights[k];
+            for(UINT n=0; n<N; n++) w[n] = x[n];
+        }
+    }
+    
+    //The neighbourhood function is separable across the rows and columns of the map and its width is fixed, so the 1D
+    //kernel between any two map rows (or columns) is computed once here rather than for every neuron of every sample
+    const Float gamma = 2.0 * grt_sqr( numClusters * sigmaWeight );
+    MatrixFloat neighbourhood(numClusters,numClusters);
+    for(UINT a=0; a<numClusters; a++){
+        for(UINT b=0; b<numClusters; b++){
+            neighbourhood[a][b] = exp( -grt_sqr(Float(a)-Float(b))/gamma );
+        }
+    }
+    
     //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
     //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
     //training samples. This random order is then used at each epoch.
@@ -195,54 +225,60 @@ bool SelfOrganizingMap::train_( MatrixFloat &data ){
     }
     std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
+    //The batch algorithm searches for the best matching units of all the samples in parallel
+    Vector< UINT > bestMatchingUnits;
+    VectorFloat bestDistances;
+    if( useBatchTraining ){
+        bestMatchingUnits.resize( M );
+        bestDistances.resize( M );
+    }
+    
     //Enter the main training loop
     while( keepTraining ){
         
         //Update alpha based on the current iteration
         alpha = Util::scale(iter,0,maxNumEpochs,alphaStart,alphaEnd);
         
-        //Run one epoch of training using the online best-matching-unit algorithm
         error = 0;
-        for(UINT m=0; m<M; m++){
-            
-            trainingSampleError = 0;
-            
-            //Get the i'th random training sample
-            trainingSample = data.getRowVector( randomTrainingOrder[m] );
-            
-            //Find the best matching unit
-            Float dist = 0;
-            Float bestDist = grt_numeric_limits< Float >::max();
-            UINT bestIndexRow = 0;
-            UINT bestIndexCol = 0;
-            for(UINT i=0; i<numClusters; i++){
-                for(UINT j=0; j<numClusters; j++){
-                    dist = neurons[i][j].getSquaredWeightDistance( trainingSample );
-                    if( dist < bestDist ){
-                        bestDist = dist;
-                        bestIndexRow = i;
-                        bestIndexCol = j;
-                    }
+        if( useBatchTraining ){
+            //Run one epoch of training using the batch algorithm
+            ThreadPool::parallelFor( 0, M, 16, [this,&data,&weights,&bestMatchingUnits,&bestDistances](const UINT start,const UINT end){
+                for(UINT m=start; m<end; m++){
+                    bestMatchingUnits[m] = this->findBestMatchingUnit( data[m], weights, bestDistances[m] );
                 }
+                return true;
+            } );
+            for(UINT m=0; m<M; m++){
+                error += bestDistances[m];
             }
-            error += bestDist;
             
-            //Update the weights based on the distance to the winning neuron
-            //Neurons closer to the winning neuron will have their weights update more
-            const Float bir = bestIndexRow;
-            const Float bic = bestIndexCol;
-            for(UINT i=0; i<numClusters; i++){  
-                for(UINT j=0; j<numClusters; j++){
+            updateBatchWeights( data, bestMatchingUnits, neighbourhood, weights );
+            
+        }else{
+            //Run one epoch of training using the online best-matching-unit algorithm
+            for(UINT m=0; m<M; m++){
+                
+                //Get the i'th random training sample
+                const Float *trainingSample = data[ randomTrainingOrder[m] ];
+                
+                //Find the best matching unit
+                bestIndex = findBestMatchingUnit( trainingSample, weights, bestDist );
+                error += bestDist;
                 
-                    //Update the weights for all the neurons, pulling them a little closer to the input example
-                    neuronDiff = 0;
-                    gamma = 2.0 * grt_sqr( numClusters * sigmaWeight );
-                    neuronWeightFunction = exp( -grt_sqr(bir-i)/gamma ) * exp( -grt_sqr(bic-j)/gamma );
-                    //std::cout << "best index: " << bestIndexRow << " " << bestIndexCol << " bestDist: " << bestDist << " pos: " << i << " " << j << " neuronWeightFunction: " << neuronWeightFunction << std::endl;
-                    for(UINT n=0; n<N; n++){
-                        neuronDiff = trainingSample[n] - neurons[i][j][n];
-                        weightUpdate = neuronWeightFunction * alpha * neuronDiff;
-                        neurons[i][j][n] += weightUpdate;
+                //Update the weights based on the distance to the winning neuron
+                //Neurons closer to the winning neuron will have their weights update more
+                const Float *rowWeights = neighbourhood[ bestIndex / numClusters ];
+                const Float *colWeights = neighbourhood[ bestIndex % numClusters ];
+                for(UINT i=0; i<numClusters; i++){
+                    for(UINT j=0; j<numClusters; j++){
+                        
+                        //Update the weights for all the neurons, pulling them a little closer to the input example
+                        neuronWeightFunction = rowWeights[i] * colWeights[j];
+                        Float *w = weights[i*numClusters+j];
+                        for(UINT n=0; n<N; n++){
+                            neuronDiff = trainingSample[n] - w[n];
+                            w[n] += neuronWeightFunction * alpha * neuronDiff;
+                        }
                     }
                 }
             }
@@ -274,12 +310,96 @@ bool SelfOrganizingMap::train_( MatrixFloat &data ){
         trainingLog << "Epoch: " << iter << " Squared Error: " << error << " Delta: " << delta << " Alpha: " << alpha << std::endl;
     }
     
+    //Copy the trained weights back to the neurons
+    for(UINT i=0; i<numClusters; i++){
+        for(UINT j=0; j<numClusters; j++){
+            const Float *w = weights[i*numClusters+j];
+            for(UINT n=0; n<N; n++) neurons[i][j][n] = w[n];
+        }
+    }
+    
     numTrainingIterationsToConverge = iter;
     trained = true;
     
     return true;
 }
     
+UINT SelfOrganizingMap::findBestMatchingUnit( const Float *x, const MatrixFloat &weights, Float &bestDist ) const{
+    
+    const UINT K = weights.getNumRows();
+    const UINT N = weights.getNumCols();
+    UINT bestIndex = 0;
+    bestDist = grt_numeric_limits< Float >::max();
+    for(UINT k=0; k<K; k++){
+        const Float *w = weights[k];
+        Float dist = 0;
+        for(UINT n=0; n<N; n++){
+            dist += grt_sqr( x[n] - w[n] );
+        }
+        if( dist < bestDist ){
+            bestDist = dist;
+            bestIndex = k;
+        }
+    }
+    return bestIndex;
+}
+    
+void SelfOrganizingMap::updateBatchWeights( const MatrixFloat &data, const Vector< UINT > &bestMatchingUnits, const MatrixFloat &neighbourhood, MatrixFloat &weights ) const{
+    
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    const UINT C = numClusters;
+    const UINT K = C*C;
+    
+    //Sum the samples (and count them) at each best matching unit
+    MatrixFloat sums(K,N);
+    VectorFloat counts(K,0);
+    sums.setAll( 0 );
+    for(UINT m=0; m<M; m++){
+        const UINT k = bestMatchingUnits[m];
+        const Float *x = data[m];
+        Float *s = sums[k];
+        for(UINT n=0; n<N; n++) s[n] += x[n];
+        counts[k]++;
+    }
+    
+    //Smooth the sums along the map columns, then along the map rows
+    MatrixFloat colSums(K,N);
+    VectorFloat colCounts(K,0);
+    colSums.setAll( 0 );
+    for(UINT bi=0; bi<C; bi++){
+        for(UINT kj=0; kj<C; kj++){
+            Float *t = colSums[bi*C+kj];
+            for(UINT bj=0; bj<C; bj++){
+                const Float h = neighbourhood[kj][bj];
+                const Float *s = sums[bi*C+bj];
+                for(UINT n=0; n<N; n++) t[n] += h * s[n];
+                colCounts[bi*C+kj] += h * counts[bi*C+bj];
+            }
+        }
+    }
+    
+    VectorFloat numerator(N);
+    for(UINT ki=0; ki<C; ki++){
+        for(UINT kj=0; kj<C; kj++){
+            Float denominator = 0;
+            std::fill(numerator.begin(),numerator.end(),0);
+            for(UINT bi=0; bi<C; bi++){
+                const Float h = neighbourhood[ki][bi];
+                const Float *t = colSums[bi*C+kj];
+                for(UINT n=0; n<N; n++) numerator[n] += h * t[n];
+                denominator += h * colCounts[bi*C+kj];
+            }
+            
+            //Neurons that are too far from every sample keep their current weights
+            if( denominator > 1.0e-10 ){
+                Float *w = weights[ki*C+kj];
+                for(UINT n=0; n<N; n++) w[n] = numerator[n] / denominator;
+            }
+        }
+    }
+}
+    
 bool SelfOrganizingMap::train_(ClassificationData &trainingData){
     MatrixFloat data = trainingData.getDataAsMatrixFloat();
     return train_(data);
@@ -498,6 +618,15 @@ bool SelfOrganizingMap::setAlphaEnd( const Float alphaEnd ){
     return false;
 }
 
+bool SelfOrganizingMap::getBatchTrainingEnabled() const{
+    return useBatchTraining;
+}
+    
+bool SelfOrganizingMap::enableBatchTraining( const bool useBatchTraining ){
+    this->useBatchTraining = useBatchTraining;
+    return true;
+}
+
 bool SelfOrganizingMap::setSigmaWeight( const Float sigmaWeight ){
 
     if( sigmaWeight > 0 ){
@@ -344,11 +344,55 @@ public:
 
     bool setSigmaWeight( const Float sigmaWeight );
     
+    /**
+     Returns true if the SOM will be trained with the batch algorithm, false if it will be trained with the online algorithm.
+     
+     @return returns true if batch training is enabled, false otherwise
+     */
+    bool getBatchTrainingEnabled() const;
+    
+    /**
+     Sets if the SOM should be trained with the batch algorithm instead of the default online algorithm.
+     
+     The online algorithm updates every neuron after each training sample, so an epoch is inherently sequential. The batch
+     algorithm finds the best matching unit of every training sample against the current weights (in parallel across the
+     samples if C++11 is enabled), and then sets each neuron to the neighbourhood-weighted mean of the samples. This is
+     much faster for large datasets and does not depend on the order of the training samples, although the resulting
+     map will not be identical to one trained with the online algorithm.
+     
+     @param useBatchTraining: if true the batch algorithm will be used, otherwise the online algorithm will be used
+     @return returns true if the parameter was updated successfully, false otherwise
+     */
+    bool enableBatchTraining( const bool useBatchTraining );
+    
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
     
 protected:
+    /**
+     Finds the best matching unit for the sample x, by scanning the contiguous weights matrix (one neuron per row).
+     
+     @param x: a pointer to the (scaled) sample, this should have the same number of dimensions as the weights matrix has columns
+     @param weights: the neuron weights, with one row per neuron
+     @param bestDist: returns the squared distance between x and the best matching unit
+     @return returns the row index of the best matching unit in the weights matrix
+     */
+    UINT findBestMatchingUnit( const Float *x, const MatrixFloat &weights, Float &bestDist ) const;
+    
+    /**
+     Updates the weights using the batch SOM rule: each neuron is set to the neighbourhood-weighted mean of the samples,
+     given the best matching unit of each sample. The neighbourhood is separable across the rows and columns of the map,
+     so it is applied as two 1D passes using the precomputed neighbourhood table.
+     
+     @param data: the (scaled) training data
+     @param bestMatchingUnits: the index of the best matching neuron for each sample
+     @param neighbourhood: the 1D neighbourhood table, where neighbourhood[a][b] is the weight between map rows (or columns) a and b
+     @param weights: the neuron weights, with one row per neuron, these will be updated
+     */
+    void updateBatchWeights( const MatrixFloat &data, const Vector< UINT > &bestMatchingUnits, const MatrixFloat &neighbourhood, MatrixFloat &weights ) const;
+    
+    bool useBatchTraining;
     UINT networkTypology;
     Float sigmaWeight;
     Float alphaStart;
@@ -14,6 +14,7 @@ BernoulliRBM::BernoulliRBM(const UINT numHiddenUnits,const UINT maxNumEpochs,con
     this->useScaling = useScaling;
     this->randomiseTrainingOrder = randomiseTrainingOrder;
     randomizeWeightsForTraining = true;
+    usePersistentCD = false;
     batchSize = 100;
     batchStepSize = 1;
     minNumEpochs = 1;
@@ -193,7 +194,7 @@ bool BernoulliRBM::train_(MatrixFloat &data){
     }
     
     Timer timer;
-    UINT i,j,n,epoch,noChangeCounter = 0;
+    UINT i,j,epoch,noChangeCounter = 0;
     Float startTime = 0;
     Float alpha = learningRate;
     Float error = 0;
@@ -204,18 +205,17 @@ bool BernoulliRBM::train_(MatrixFloat &data){
     TrainingResult trainingResult;
     MatrixFloat wT( numVisibleUnits, numHiddenUnits );       //Stores a transposed copy of the weights vector
     MatrixFloat vW( numHiddenUnits, numVisibleUnits );       //Stores the weight velocity updates
-    MatrixFloat tmpW( numHiddenUnits, numVisibleUnits );     //Stores the weight values that will be used to update the main weights matrix at each batch update
     MatrixFloat v1( batchSize, numVisibleUnits );            //Stores the real batch data during a batch update
     MatrixFloat v2( batchSize, numVisibleUnits );            //Stores the sampled batch data during a batch update
     MatrixFloat h1( batchSize, numHiddenUnits );             //Stores the hidden states given v1 and the current weightsMatrix
-    MatrixFloat h2( batchSize, numHiddenUnits );             //Stores the sampled hidden states given v2 and the current weightsMatrix
-    MatrixFloat c1( numHiddenUnits, numVisibleUnits );       //Stores h1' * v1
-    MatrixFloat c2( numHiddenUnits, numVisibleUnits );       //Stores h2' * v2
-    MatrixFloat vDiff( batchSize, numVisibleUnits );         //Stores the difference between v1-v2
-    MatrixFloat hDiff( batchSize, numVisibleUnits );         //Stores the difference between h1-h2
-    MatrixFloat cDiff( numHiddenUnits, numVisibleUnits );    //Stores the difference between c1-c2
-    VectorFloat vDiffSum( numVisibleUnits );                 //Stores the column sum of vDiff
-    VectorFloat hDiffSum( numHiddenUnits );                  //Stores the column sum of hDiff
+    MatrixFloat h2( batchSize, numHiddenUnits );             //Stores the hidden probabilities given v2 and the current weightsMatrix
+    MatrixFloat hChain;                                      //Stores the hidden states of the persistent chains (only used for PCD)
+    MatrixFloat hNeg;                                        //Stores the hidden states the negative phase starts from (only used for PCD)
+    MatrixFloat hStack( 2*batchSize, numHiddenUnits );       //Stores [h1; -h2], so h1' * v1 - h2' * v2 can be computed with one product
+    MatrixFloat vStack( 2*batchSize, numVisibleUnits );      //Stores [v1; v2]
+    MatrixFloat cDiff( numHiddenUnits, numVisibleUnits );    //Stores the difference between h1' * v1 and h2' * v2
+    VectorFloat vDiffSum( numVisibleUnits );                 //Stores the column sum of v1-v2
+    VectorFloat hDiffSum( numHiddenUnits );                  //Stores the column sum of h1-h2
     VectorFloat visibleLayerBiasVelocity( numVisibleUnits ); //Stores the velocity update of the visibleLayerBias
     VectorFloat hiddenLayerBiasVelocity( numHiddenUnits );   //Stores the velocity update of the hiddenLayerBias
     
@@ -224,6 +224,10 @@ bool BernoulliRBM::train_(MatrixFloat &data){
     std::fill(visibleLayerBiasVelocity.begin(),visibleLayerBiasVelocity.end(),0);
     std::fill(hiddenLayerBiasVelocity.begin(),hiddenLayerBiasVelocity.end(),0);
     
+    //The hidden and visible units are sampled from a counter-based random stream, the key is drawn from the main random generator
+    const unsigned long long rngKey = (unsigned long long)rand.getRandomNumberInt(0,2147483647) << 32 | (unsigned long long)rand.getRandomNumberInt(0,2147483647);
+    unsigned long long rngCounter = 0;
+    
     //Randomize the order that the training samples will be used in
     for(UINT i=0; i<numTrainingSamples; i++) indexList[i] = i;
     if( randomiseTrainingOrder ){
@@ -242,122 +246,111 @@ bool BernoulliRBM::train_(MatrixFloat &data){
         //Run each of the batch updates
         for(UINT k=0; k<numBatches; k+=batchStepSize){
             
-            //Resize the data matrices, the matrices will only be resized if the rows cols are different
-            v1.resize( batchIndexs[k].batchSize, numVisibleUnits );
-            h1.resize( batchIndexs[k].batchSize, numHiddenUnits );
-            v2.resize( batchIndexs[k].batchSize, numVisibleUnits );
-            h2.resize( batchIndexs[k].batchSize, numHiddenUnits );
+            const UINT B = batchIndexs[k].batchSize;
             
-            //Setup the data pointers, using data pointers saves a few ms on large matrix updates
-            Float **w_p = weightsMatrix.getDataPointer();
-            Float **wT_p = wT.getDataPointer();
-            Float **vW_p = vW.getDataPointer();
-            Float **data_p = data.getDataPointer();
-            Float **v1_p = v1.getDataPointer();
-            Float **v2_p = v2.getDataPointer();
-            Float **h1_p = h1.getDataPointer();
-            Float **h2_p = h2.getDataPointer();
-            Float *vlb_p = &visibleLayerBias[0];
-            Float *hlb_p = &hiddenLayerBias[0];
+            //Resize the data matrices, the matrices will only be resized if the rows cols are different
+            v1.resize( B, numVisibleUnits );
+            h1.resize( B, numHiddenUnits );
+            v2.resize( B, numVisibleUnits );
+            h2.resize( B, numHiddenUnits );
+            hStack.resize( 2*B, numHiddenUnits );
+            vStack.resize( 2*B, numVisibleUnits );
             
             //Get the batch data
-            UINT index = 0;
-            for(i=batchIndexs[k].startIndex; i<batchIndexs[k].endIndex; i++){
-                for(j=0; j<numVisibleUnits; j++){
-                    v1_p[index][j] = data_p[ indexList[i] ][j];
-                }
-                index++;
+            for(i=0; i<B; i++){
+                const Float *src = data[ indexList[ batchIndexs[k].startIndex + i ] ];
+                std::copy( src, src + numVisibleUnits, v1[i] );
             }
             
             //Copy a transposed version of the weights matrix, this is used to compute h1 and h2
+            const Float *w_p = weightsMatrix.getData();
+            Float *wT_p = wT.getData();
             for(i=0; i<numHiddenUnits; i++)
             for(j=0; j<numVisibleUnits; j++)
-            wT_p[j][i] = w_p[i][j];
+            wT_p[j*numHiddenUnits+i] = w_p[i*numVisibleUnits+j];
             
             //Compute h1
             h1.multiple(v1, wT);
-            for(n=0; n<batchIndexs[k].batchSize; n++){
-                for(i=0; i<numHiddenUnits; i++){
-                    h1_p[n][i] = sigmoidRandom( h1_p[n][i] + hlb_p[i] );
-                }
-            }
+            sampleLayer( h1, hiddenLayerBias, rngKey, rngCounter );
             
-            //Compute v2
-            v2.multiple(h1, weightsMatrix);
-            for(n=0; n<batchIndexs[k].batchSize; n++){
-                for(i=0; i<numVisibleUnits; i++){
-                    v2_p[n][i] = sigmoidRandom( v2_p[n][i] + vlb_p[i] );
+            //Compute v2, for PCD the negative phase starts from the persistent chains rather than h1
+            if( usePersistentCD ){
+                if( hChain.getNumRows() < B ){
+                    hChain = h1;
                 }
+                hNeg.resize( B, numHiddenUnits );
+                std::copy( hChain.getData(), hChain.getData() + B*numHiddenUnits, hNeg.getData() );
+                v2.multiple(hNeg, weightsMatrix);
+            }else{
+                v2.multiple(h1, weightsMatrix);
             }
+            sampleLayer( v2, visibleLayerBias, rngKey, rngCounter );
             
             //Compute h2
-            h2.multiple(v2,wT);
-            for(n=0; n<batchIndexs[k].batchSize; n++){
-                for(i=0; i<numHiddenUnits; i++){
-                    h2_p[n][i] = grt_sigmoid( h2_p[n][i] + hlb_p[i] );
-                }
-            }
-            
-            //Compute c1, c2 and the difference between v1-v2
-            c1.multiple(h1,v1,true);
-            c2.multiple(h2,v2,true);
-            vDiff.subtract(v1, v2);
-            
-            //Compute the sum of vdiff
-            for(j=0; j<numVisibleUnits; j++){
-                vDiffSum[j] = 0;
-                for(i=0; i<batchIndexs[k].batchSize; i++){
-                    vDiffSum[j] += vDiff[i][j];
-                }
-            }
+            h2.multiple(v2, wT);
+            sigmoidLayer( h2, hiddenLayerBias );
             
-            //Compute the difference between h1 and h2
-            hDiff.subtract(h1, h2);
-            for(j=0; j<numHiddenUnits; j++){
-                hDiffSum[j] = 0;
-                for(i=0; i<batchIndexs[k].batchSize; i++){
-                    hDiffSum[j] += hDiff[i][j];
+            //Advance the persistent chains by sampling the hidden states from h2
+            if( usePersistentCD ){
+                Float *chain_p = hChain.getData();
+                const Float *h2_p = h2.getData();
+                for(i=0; i<B*numHiddenUnits; i++){
+                    chain_p[i] = h2_p[i] > counterRandom( rngKey, rngCounter+i ) ? 1.0 : 0.0;
                 }
+                rngCounter += B*numHiddenUnits;
             }
             
-            //Compute the difference between c1 and c2
-            cDiff.subtract(c1,c2);
-            
-            //Update the weight velocities
-            for(i=0; i<numHiddenUnits; i++){
+            //Compute the column sums of v1-v2 and h1-h2, the reconstruction error, and stack the batches so
+            //h1' * v1 - h2' * v2 can be computed with a single matrix product
+            std::fill(vDiffSum.begin(),vDiffSum.end(),0);
+            std::fill(hDiffSum.begin(),hDiffSum.end(),0);
+            err = 0;
+            for(i=0; i<B; i++){
+                const Float *v1_i = v1[i];
+                const Float *v2_i = v2[i];
+                const Float *h1_i = h1[i];
+                const Float *h2_i = h2[i];
+                Float *vPos = vStack[i];
+                Float *vNeg = vStack[B+i];
+                Float *hPos = hStack[i];
+                Float *hNegRow = hStack[B+i];
                 for(j=0; j<numVisibleUnits; j++){
-                    vW_p[i][j] = ((momentum * vW_p[i][j]) + (alpha * cDiff[i][j])) / batchIndexs[k].batchSize;
+                    const Float d = v1_i[j] - v2_i[j];
+                    vDiffSum[j] += d;
+                    err += d*d;
+                    vPos[j] = v1_i[j];
+                    vNeg[j] = v2_i[j];
+                }
+                for(j=0; j<numHiddenUnits; j++){
+                    hDiffSum[j] += h1_i[j] - h2_i[j];
+                    hPos[j] = h1_i[j];
+                    hNegRow[j] = -h2_i[j];
                 }
             }
-            for(i=0; i<numVisibleUnits; i++){
-                visibleLayerBiasVelocity[i] = ((momentum * visibleLayerBiasVelocity[i]) + (alpha * vDiffSum[i])) / batchIndexs[k].batchSize;
-            }
-            for(i=0; i<numHiddenUnits; i++){
-                hiddenLayerBiasVelocity[i] = ((momentum * hiddenLayerBiasVelocity[i]) + (alpha * hDiffSum[i])) / batchIndexs[k].batchSize;
-            }
+            cDiff.multiple(hStack, vStack, true);
             
-            //Update the weights
-            weightsMatrix.add( vW );
+            //Update the weight velocities and the weights
+            Float *vW_p = vW.getData();
+            Float *wUpdate_p = weightsMatrix.getData();
+            const Float *cDiff_p = cDiff.getData();
+            for(i=0; i<numHiddenUnits*numVisibleUnits; i++){
+                vW_p[i] = ((momentum * vW_p[i]) + (alpha * cDiff_p[i])) / B;
+                wUpdate_p[i] += vW_p[i];
+            }
             
             //Update the bias for the visible layer
             for(i=0; i<numVisibleUnits; i++){
+                visibleLayerBiasVelocity[i] = ((momentum * visibleLayerBiasVelocity[i]) + (alpha * vDiffSum[i])) / B;
                 visibleLayerBias[i] += visibleLayerBiasVelocity[i];
             }
             
-            //Update the bias for the visible layer
+            //Update the bias for the hidden layer
             for(i=0; i<numHiddenUnits; i++){
+                hiddenLayerBiasVelocity[i] = ((momentum * hiddenLayerBiasVelocity[i]) + (alpha * hDiffSum[i])) / B;
                 hiddenLayerBias[i] += hiddenLayerBiasVelocity[i];
             }
             
-            //Compute the reconstruction error
-            err = 0;
-            for(i=0; i<batchIndexs[k].batchSize; i++){
-                for(j=0; j<numVisibleUnits; j++){
-                    err += SQR( v1[i][j] - v2[i][j] );
-                }
-            }
-            
-            error += err / batchIndexs[k].batchSize;
+            error += err / B;
         }
         error /= numBatches;
         delta = lastError - error;
@@ -665,6 +658,10 @@ bool BernoulliRBM::getRandomizeWeightsForTraining() const{
     return randomizeWeightsForTraining;
 }
 
+bool BernoulliRBM::getPersistentContrastiveDivergenceEnabled() const{
+    return usePersistentCD;
+}
+
 UINT BernoulliRBM::getNumVisibleUnits() const{
     return numVisibleUnits;
 }
@@ -673,6 +670,14 @@ UINT BernoulliRBM::getNumHiddenUnits() const{
     return numHiddenUnits;
 }
 
+UINT BernoulliRBM::getBatchSize() const{
+    return batchSize;
+}
+
+UINT BernoulliRBM::getBatchStepSize() const{
+    return batchStepSize;
+}
+
 const MatrixFloat& BernoulliRBM::getWeights() const{
     return weightsMatrix;
 }
@@ -703,6 +708,10 @@ bool BernoulliRBM::setRandomizeWeightsForTraining(const bool randomizeWeightsFor
 }
 
 bool BernoulliRBM::setBatchSize(const UINT batchSize){
+    if( batchSize == 0 ){
+        warningLog << "setBatchSize(const UINT batchSize) - The batch size must be greater than zero!" << std::endl;
+        return false;
+    }
     this->batchSize = batchSize;
     return true;
 }
@@ -712,6 +721,43 @@ bool BernoulliRBM::setBatchStepSize(const UINT batchStepSize){
     return true;
 }
 
+bool BernoulliRBM::enablePersistentContrastiveDivergence(const bool usePersistentCD){
+    this->usePersistentCD = usePersistentCD;
+    return true;
+}
+
+void BernoulliRBM::sampleLayer(MatrixFloat &x,const VectorFloat &bias,const unsigned long long key,unsigned long long &counter) const{
+    
+    const UINT rows = x.getNumRows();
+    const UINT cols = x.getNumCols();
+    const Float *b = bias.getData();
+    Float *p = x.getData();
+    
+    for(UINT i=0; i<rows; i++){
+        Float *row = p + i*cols;
+        for(UINT j=0; j<cols; j++){
+            const Float prob = 1.0 / (1.0 + exp( -(row[j] + b[j]) ));
+            row[j] = prob > counterRandom( key, counter+j ) ? 1.0 : 0.0;
+        }
+        counter += cols;
+    }
+}
+
+void BernoulliRBM::sigmoidLayer(MatrixFloat &x,const VectorFloat &bias) const{
+    
+    const UINT rows = x.getNumRows();
+    const UINT cols = x.getNumCols();
+    const Float *b = bias.getData();
+    Float *p = x.getData();
+    
+    for(UINT i=0; i<rows; i++){
+        Float *row = p + i*cols;
+        for(UINT j=0; j<cols; j++){
+            row[j] = 1.0 / (1.0 + exp( -(row[j] + b[j]) ));
+        }
+    }
+}
+
 bool BernoulliRBM::loadLegacyModelFromFile( std::fstream &file ){
     
     std::string word;
@@ -123,8 +123,11 @@ class GRT_API BernoulliRBM : public MLBase{
     virtual bool print() const;
     
     bool getRandomizeWeightsForTraining() const;
+    bool getPersistentContrastiveDivergenceEnabled() const;
     UINT getNumVisibleUnits() const;
     UINT getNumHiddenUnits() const;
+    UINT getBatchSize() const;
+    UINT getBatchStepSize() const;
     VectorFloat getOutputData() const;
     const MatrixFloat& getWeights() const;
     
@@ -135,6 +138,16 @@ class GRT_API BernoulliRBM : public MLBase{
     bool setBatchSize(const UINT batchSize);
     bool setBatchStepSize(const UINT batchStepSize);
     
+    /**
+    Sets if the RBM should be trained with persistent contrastive divergence (PCD). With PCD the negative phase of each
+    batch update starts from a set of persistent Gibbs chains (one per batch row) that are carried over between batches,
+    rather than from the hidden states of the current batch as in standard CD-1.
+    
+    @param usePersistentCD: if true, the RBM will be trained with persistent contrastive divergence
+    @return returns true if the parameter was updated, false otherwise
+    */
+    bool enablePersistentContrastiveDivergence(const bool usePersistentCD);
+    
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
@@ -150,7 +163,44 @@ class GRT_API BernoulliRBM : public MLBase{
         return (1.0 / (1.0 + exp(-x)) > rand.getRandomNumberUniform(0.0,1.0)) ? 1.0 : 0.0;
     }
     
+    /**
+    Computes a uniform random number in the range [0 1) from a key and a counter (a counter-based random number generator).
+    The same key and counter will always give the same number, so a block of units can be sampled with no shared state.
+    
+    @param key: the key of the random stream, this is set once at the start of training
+    @param counter: the position in the random stream
+    @return returns a uniform random number in the range [0 1)
+    */
+    static inline Float counterRandom(const unsigned long long key,const unsigned long long counter){
+        unsigned long long z = key + (counter+1) * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        return (z >> 11) * (1.0/9007199254740992.0);
+    }
+    
+    /**
+    Adds the bias to each row of x, applies the sigmoid function and replaces each value with a Bernoulli sample of
+    that probability. The random numbers are taken from the counter-based stream, starting at counter, which is then
+    advanced by the number of values in x.
+    
+    @param x: the pre-activation values, these will be replaced with the binary samples
+    @param bias: the bias for each column of x
+    @param key: the key of the random stream
+    @param counter: the current position in the random stream
+    */
+    void sampleLayer(MatrixFloat &x,const VectorFloat &bias,const unsigned long long key,unsigned long long &counter) const;
+    
+    /**
+    Adds the bias to each row of x and applies the sigmoid function, giving the probability of each unit being on.
+    
+    @param x: the pre-activation values, these will be replaced with the unit probabilities
+    @param bias: the bias for each column of x
+    */
+    void sigmoidLayer(MatrixFloat &x,const VectorFloat &bias) const;
+    
     bool randomizeWeightsForTraining;
+    bool usePersistentCD;
     UINT numVisibleUnits;
     UINT numHiddenUnits;
     UINT batchSize;
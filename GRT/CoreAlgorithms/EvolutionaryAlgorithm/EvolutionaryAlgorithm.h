@@ -61,6 +61,7 @@ public:
         useElitism = true;
         storeHistory = true;
         baiseWeights = true;
+        parallelFitnessEvaluation = false;
         
         errorLog.setProceedingText("[EVO ERROR]");
         trainingLog.setProceedingText("[EVO TRAINING]");
@@ -159,29 +160,49 @@ public:
      */
     virtual bool estimatePopulationFitness( const MatrixFloat &trainingData, Float &bestFitness, UINT &bestIndex ){
         
-        UINT index = 0;
         bestFitness = 0;
         bestIndex = 0;
         
         if( !initialized ) return false;
         
-        typename Vector< INDIVIDUAL >::iterator populationIter = population.begin();
-        Vector< IndexedDouble >::iterator weightsIter = populationWeights.begin();
+        //Draw a single seed for this generation, each individual gets its own random stream derived from this seed and its
+        //index so the results do not depend on how the population is split across the threads
+        const unsigned long long generationSeed = (unsigned long long)rand.getRandomNumberInt(1,grt_numeric_limits< int >::max());
         
-        while( populationIter != population.end() ){
-            //Compute the fitness of the current individual
-            weightsIter->value = evaluateFitness( *populationIter, trainingData );
-            weightsIter->index = index++;
-            
-            //Check to see if this is the best fitness so far
-            if( weightsIter->value > bestFitness ){
-                bestFitness = weightsIter->value;
-                bestIndex = weightsIter->index;
+        ThreadPool::parallelFor( 0, populationSize, 1, [this,&trainingData,generationSeed](const UINT begin,const UINT end){
+            return this->estimateFitnessBlock( trainingData, generationSeed, begin, end );
+        }, parallelFitnessEvaluation ? 0 : 1 );
+        
+        //Find the individual with the best fitness
+        for(UINT i=0; i<populationSize; i++){
+            if( populationWeights[i].value > bestFitness ){
+                bestFitness = populationWeights[i].value;
+                bestIndex = i;
             }
+        }
+        
+        return true;
+    }
+    
+    /**
+     This function estimates the fitness of the individuals in the range [begin end). Each individual is given its own random
+     number generator, seeded from the generationSeed and the individual's index.
+     
+     @param trainingData: a reference to the trainingData that will be used to estimate the fitness
+     @param generationSeed: the seed for the current generation
+     @param begin: the index of the first individual that should be evaluated
+     @param end: one past the index of the last individual that should be evaluated
+     @return returns true if the fitness was estimated, false otherwise
+     */
+    bool estimateFitnessBlock( const MatrixFloat &trainingData, const unsigned long long generationSeed, const UINT begin, const UINT end ){
+        
+        for(UINT i=begin; i<end; i++){
+            unsigned long long seed = generationSeed ^ ( 0x9E3779B97F4A7C15ULL * (unsigned long long)(i+1) );
+            if( seed == 0 ) seed = 1; //A zero seed would be replaced by the system time
+            Random random( seed );
             
-            //Update the iterators
-            populationIter++;
-            weightsIter++;
+            populationWeights[i].value = evaluateFitness( population[i], trainingData, random );
+            populationWeights[i].index = i;
         }
         
         return true;
@@ -197,31 +218,20 @@ public:
         
         if( !initialized ) return false;
         
-        UINT i=0;
-        UINT index = 0;
         UINT mom = 0;
         UINT dad = 0;
         UINT crossOverPoint = 0;
         typename Vector< INDIVIDUAL >::iterator populationIter = population.begin();
-        Vector< IndexedDouble >::iterator weightsIter = populationWeights.begin();
         
-        //Get the current weights values
-        weightsIter = populationWeights.begin();
-        while( populationIter != population.end() ){
-            weightsIter->value = baiseWeights ? pow( populationIter->fitness, baiseCoeff ) : populationIter->fitness;
-            weightsIter->index = index++;
-            
-            populationIter++;
-            weightsIter++;
-        }
-        
-        //Sort the weighted values by value in ascending order (so the least likely value is first, the second least likely is second, etc...
-        sort(populationWeights.begin(),populationWeights.end(),IndexedDouble::sortIndexedDoubleByValueAscending);
-        
-        //Create the accumulated sum lookup table
-        accumSumLookup[0] = populationWeights[0].value;
-        for(unsigned int i=1; i<populationSize; i++){
-            accumSumLookup[i] = accumSumLookup[i-1] + populationWeights[i].value;
+        //Get the current weights values and create the accumulated sum lookup table, the selection uses a binary search
+        //over this table so the weights do not need to be sorted
+        Float sum = 0;
+        for(UINT i=0; i<populationSize; i++){
+            const Float fitness = population[i].fitness;
+            populationWeights[i].value = baiseWeights ? pow( fitness, baiseCoeff ) : fitness;
+            populationWeights[i].index = i;
+            sum += populationWeights[i].value;
+            accumSumLookup[i] = sum;
         }
         
         if( accumSumLookup[populationSize-1] == 0 ){
@@ -243,7 +253,6 @@ public:
         //- Create two individuals (if possible) by combining the gene data from mom and dad
         //- The first child will use the following genes [mom |crossOverPoint| dad], whereas the second child will use [dad |crossOverPoint| mom]
         //- After the cross over, each gene will be randomly mutated
-        index = 0;
         while( populationIter != population.end() ){
             
             //Randomly select the parents, individuals with higher weights will have a better chance of being selected
@@ -254,17 +263,10 @@ public:
             crossOverPoint = rand.getRandomNumberInt(0, geneSize);
             
             //Generate the new individual using cross over (this is the first child)
-            for(i=0; i<geneSize; i++){
-                if( i < crossOverPoint ) populationIter->gene[i] = parents[ mom ].gene[i];
-                else populationIter->gene[i] = parents[ dad ].gene[i];
-            }
+            crossOver( parents[ mom ].gene, parents[ dad ].gene, crossOverPoint, populationIter->gene );
             
             //Perform random mutation
-            for(i=0; i<geneSize; i++){
-                if( rand.getRandomNumberUniform(0.0,1.0) <= mutationRate ){
-                    populationIter->gene[ i ] = generateRandomGeneValue();
-                }
-            }
+            mutateGene( populationIter->gene );
             
             //Update the iterator
             populationIter++;
@@ -272,17 +274,10 @@ public:
             //Generate the second child (as long as we have not got to the end of the population)
             if( populationIter != population.end() ){
                 
-                for(i=0; i<geneSize; i++){
-                    if( i < crossOverPoint ) populationIter->gene[i] = parents[ dad ].gene[i];
-                    else populationIter->gene[i] = parents[ mom ].gene[i];
-                }
+                crossOver( parents[ dad ].gene, parents[ mom ].gene, crossOverPoint, populationIter->gene );
                 
                 //Perform random mutation
-                for(i=0; i<geneSize; i++){
-                    if( rand.getRandomNumberUniform(0.0,1.0) <= mutationRate ){
-                        populationIter->gene[ i ] = generateRandomGeneValue();
-                    }
-                }
+                mutateGene( populationIter->gene );
                 
                 //Update the iterator
                 populationIter++;
@@ -296,6 +291,51 @@ public:
         return true;
     }
     
+    /**
+     This function creates a child gene by combining the first crossOverPoint elements of the mom gene with the remaining
+     elements of the dad gene.
+     
+     @param mom: the gene that will be used for the elements before the crossOverPoint
+     @param dad: the gene that will be used for the elements from the crossOverPoint onwards
+     @param crossOverPoint: the index at which the child switches from the mom gene to the dad gene
+     @param child: the gene that will be set
+     */
+    void crossOver( const VectorFloat &mom, const VectorFloat &dad, const UINT crossOverPoint, VectorFloat &child ){
+        const UINT N = grt_min( crossOverPoint, geneSize );
+        std::copy( mom.begin(), mom.begin() + N, child.begin() );
+        std::copy( dad.begin() + N, dad.begin() + geneSize, child.begin() + N );
+    }
+    
+    /**
+     This function randomly mutates each element of the gene with a probability of mutationRate. Rather than drawing a random
+     number for every element, the gap to the next mutated element is drawn from the matching geometric distribution, so the
+     cost is proportional to the number of mutations rather than the geneSize.
+     
+     @param gene: the gene that will be mutated
+     */
+    void mutateGene( VectorFloat &gene ){
+        
+        if( mutationRate <= 0 ) return;
+        
+        if( mutationRate >= 1 ){
+            for(UINT i=0; i<geneSize; i++){
+                gene[i] = generateRandomGeneValue();
+            }
+            return;
+        }
+        
+        const Float logKeepRate = log( 1.0 - mutationRate );
+        Float i = -1;
+        while( true ){
+            //Draw the number of elements to skip before the next mutation
+            const Float u = rand.getRandomNumberUniform(0.0,1.0);
+            if( u <= 0 ) return;
+            i += 1 + floor( log( u ) / logKeepRate );
+            if( i >= geneSize ) return;
+            gene[ (UINT)i ] = generateRandomGeneValue();
+        }
+    }
+    
     /**
      This function evaluates the fitness of an individual, using the training data.  This function assumes that each row in the
      training data is an example, each column must therefore match the geneSize.  
@@ -312,15 +352,17 @@ public:
         
         if( trainingData.getNumCols() != geneSize ) return 0;
         
-        UINT M = trainingData.getNumRows();
+        const UINT M = trainingData.getNumRows();
+        const Float *gene = &individual.gene[0];
         Float error = 0;
         Float minError = grt_numeric_limits< Float >::max();
         
         for(UINT i=0; i<M; i++){
+            const Float *x = trainingData[i];
             error = 0;
             //Compute the squared distance
             for(UINT j=0; j<geneSize; j++){
-                error += ( trainingData[i][j] - individual.gene[j] ) * ( trainingData[i][j] - individual.gene[j] );
+                error += ( x[j] - gene[j] ) * ( x[j] - gene[j] );
             }
             if( error < minError ) minError = error;
         }
@@ -333,6 +375,24 @@ public:
         
         return individual.fitness;
     }
+    
+    /**
+     This function evaluates the fitness of an individual, using the training data and a random number generator that belongs to
+     this individual.  This is the function called by estimatePopulationFitness, by default it simply calls the evaluateFitness
+     function above.  Override this function if your fitness function is stochastic, using the random argument rather than the
+     rand member keeps the results deterministic and avoids sharing a generator across threads.
+     
+     If parallel fitness evaluation is enabled this function will be called concurrently for different individuals, so it must
+     only modify the individual it is given.
+     
+     @param individual: a reference to the individual you want to compute the fitness for
+     @param trainingData: a reference to the training data that will be used to compute the individual's fitness
+     @param random: a random number generator seeded for this individual and generation
+     @return returns the fitness of the individual
+     */
+    virtual Float evaluateFitness( INDIVIDUAL &individual, const MatrixFloat &trainingData, Random &random ){
+        return evaluateFitness( individual, trainingData );
+    }
 
     virtual bool train(const MatrixFloat &trainingData){
         
@@ -423,6 +483,10 @@ public:
         return population;
     }
     
+    bool getParallelFitnessEvaluation() const{
+        return parallelFitnessEvaluation;
+    }
+    
     bool setPopulationSize(const UINT populationSize){
         this->populationSize = populationSize;
         return true;
@@ -468,6 +532,19 @@ public:
         return true;
     }
     
+    /**
+     Sets if the fitness of the population should be estimated in parallel using the thread pool. If enabled, evaluateFitness
+     will be called concurrently for different individuals, so it must not modify any state shared between individuals.
+     Parallel evaluation is disabled by default, and is only used when GRT_CXX11_ENABLED is defined.
+     
+     @param parallelFitnessEvaluation: the new parallelFitnessEvaluation mode
+     @return returns true if the mode was updated
+     */
+    bool setParallelFitnessEvaluation(const bool parallelFitnessEvaluation){
+        this->parallelFitnessEvaluation = parallelFitnessEvaluation;
+        return true;
+    }
+    
     virtual bool setPopulation( const Vector< INDIVIDUAL > &newPopulation ){
         
         if( newPopulation.size() == 0 ) return false;
@@ -518,6 +595,7 @@ public:
     bool useElitism;
     bool storeHistory;
     bool baiseWeights;
+    bool parallelFitnessEvaluation;
     UINT populationSize;
     UINT geneSize;
     UINT minNumIterationsNoChange;
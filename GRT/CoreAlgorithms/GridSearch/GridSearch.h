@@ -3,6 +3,14 @@
  @version 1.0
  
  @brief This class implements a basic grid search algorithm. 
+
+ The grid search can be used in two ways:
+ - the original mode, where each parameter is set on a single shared model by a std::function< bool(unsigned int) > and
+   the grid points are evaluated one after the other by a std::function< Float () > evaluation function
+ - the model mode, where each parameter is set by a std::function< bool(T&,Float) > on a copy of the model. Each grid point
+   gets its own copy of the model, so the grid points can be evaluated concurrently on the thread pool. This mode supports
+   Float and log-scale ranges and optional successive halving, where every configuration is first evaluated on a small budget
+   (e.g. a fraction of the training data or epochs) and only the best 1/eta of the configurations are given a larger budget.
  */
 
 /**
@@ -32,25 +40,48 @@
 #include "../../CoreModules/GestureRecognitionPipeline.h"
 
 #include <functional>
+#include <atomic>
 
 GRT_BEGIN_NAMESPACE
 
 template< class T > 
 class GridSearchRange {
 public:
-    GridSearchRange( const T _min = T(), const T _max = T(), const T _inc = T() ):min(_min),max(_max),inc(_inc){ value = min; expired = false; }
+    /**
+     Default Constructor.
+
+     @param _min: the first value in the range
+     @param _max: the last value in the range
+     @param _inc: the step between each value, if logScale is true then this is the factor each value is multiplied by
+     @param _logScale: if true the values are spaced on a log scale (min, min*inc, min*inc^2, ..., max)
+     */
+    GridSearchRange( const T _min = T(), const T _max = T(), const T _inc = T(), const bool _logScale = false ):min(_min),max(_max),inc(_inc),logScale(_logScale){ value = min; expired = false; }
 
     GridSearchRange( const GridSearchRange &rhs ){
         this->value = rhs.value;
         this->min = rhs.min;
         this->max = rhs.max;
         this->inc = rhs.inc;
+        this->logScale = rhs.logScale;
         this->expired = rhs.expired;
     }
 
+    GridSearchRange& operator=( const GridSearchRange &rhs ){
+        if( this != &rhs ){
+            this->value = rhs.value;
+            this->min = rhs.min;
+            this->max = rhs.max;
+            this->inc = rhs.inc;
+            this->logScale = rhs.logScale;
+            this->expired = rhs.expired;
+        }
+        return *this;
+    }
+
     T next(){
         if( expired ) return value;
-        if( value + inc < max ) value += inc;
+        const T nextValue = logScale ? T( value * inc ) : T( value + inc );
+        if( nextValue < max && nextValue > value ) value = nextValue;
         else{ value = max; }
         return value;
     }
@@ -65,10 +96,33 @@ public:
     
     T get() { if( value >= max ) expired = true; return value; }
 
+    /**
+     Gets all the values in the range, in the same order they would be returned by next(). The values are computed from the
+     min value and the step index, so Float ranges do not accumulate rounding errors.
+
+     @return returns a Vector containing all the values in the range
+     */
+    Vector< T > getValues() const {
+        Vector< T > values;
+        values.push_back( min );
+        if( min >= max ) return values;
+        if( (logScale && !(inc > T(1))) || (!logScale && !(inc > T())) ){
+            values.push_back( max );
+            return values;
+        }
+        for(unsigned int k=1; ; k++){
+            const T v = logScale ? T( min * pow( Float(inc), Float(k) ) ) : T( min + inc * T(k) );
+            if( v < max && v > values.back() ) values.push_back( v );
+            else{ values.push_back( max ); break; }
+        }
+        return values;
+    }
+
     T value;
     T min;
     T max;
     T inc;
+    bool logScale;
     bool expired;
 };
 
@@ -108,12 +162,42 @@ public:
     GridSearchRange<T> range;
 };
 
+template < class T >
+class GridSearchModelParam {
+public:
+
+    GridSearchModelParam( std::function< bool(T&,Float) > func = nullptr, GridSearchRange<Float> range = GridSearchRange<Float>() ){
+        this->func = func;
+        this->range = range;
+    }
+
+    GridSearchModelParam( const GridSearchModelParam &rhs ){
+        this->func = rhs.func;
+        this->range = rhs.range;
+    }
+
+    bool set( T &model, const Float value ) const{
+        if( !func ) return false;
+        return func( model, value );
+    }
+
+    std::function< bool(T&,Float) > func;
+    GridSearchRange<Float> range;
+};
+
 template< class T >
 class GridSearch : public MLBase{
 public:
     enum SearchType {MaxValueSearch=0,MinValueSearch};
     GridSearch() {
         classType = "GridSearch";
+        evalType = MaxValueSearch;
+        bestResult = 0;
+        parallelSearch = true;
+        useSuccessiveHalving = false;
+        halvingRate = 3;
+        minBudget = 0.1;
+        numEvaluations = 0;
         infoLog.setProceedingText("[GridSearch]");
         debugLog.setProceedingText("[DEBUG GridSearch]");
         errorLog.setProceedingText("[ERROR GridSearch");
@@ -130,7 +214,31 @@ public:
         return true;
     }
     
+    /**
+     Adds a parameter that will be set on a copy of the model for each grid point. The function will be called with the
+     copy of the model and the value of the parameter at the current grid point, for example:
+     [](RandomForests &rf, Float v){ return rf.setForestSize( (UINT)v ); }
+
+     The model parameters are only used if a model evaluation function has been set with setModelEvaluationFunction.
+
+     @param f: the function that sets the parameter on a model
+     @param range: the range of values that will be searched, this can be a linear or log-scale range
+     @return returns true if the parameter was added, false otherwise
+     */
+    bool addModelParameter( std::function< bool(T&,Float) > f, GridSearchRange< Float > range ){
+        if( !f ){
+            errorLog << "addModelParameter(...) - The parameter function is not valid!" << std::endl;
+            return false;
+        }
+        modelParams.push_back( GridSearchModelParam<T>( f, range ) );
+        return true;
+    }
+
     bool search( ){
+
+        if( modelEvalFunc ){
+            return searchModels();
+        }
         
         if( params.getSize() == 0 ){
             warningLog << "No parameters to search! Add some parameters!" << std::endl;
@@ -139,7 +247,7 @@ public:
 
         switch( evalType ){
             case MaxValueSearch:
-                bestResult = 0;
+                bestResult = -grt_numeric_limits< Float >::max();
             break;
             case MinValueSearch:
                 bestResult = grt_numeric_limits< Float >::max();
@@ -159,6 +267,24 @@ public:
 
     T getBestModel() const { return bestModel; }
 
+    /**
+     Gets the parameter values of the best model found by the last model search, in the order the parameters were added.
+
+     @return returns a VectorFloat with the best parameter values, this will be empty if no model search has been run
+     */
+    VectorFloat getBestParameters() const { return bestParameters; }
+
+    /**
+     Gets the number of times the model evaluation function was called by the last model search.
+
+     @return returns the number of evaluations
+     */
+    unsigned int getNumEvaluations() const { return numEvaluations; }
+
+    bool getParallelSearch() const { return parallelSearch; }
+
+    bool getSuccessiveHalvingEnabled() const { return useSuccessiveHalving; }
+
     bool setModel( const T &model ){
         this->model = model;
         return true;
@@ -169,6 +295,61 @@ public:
         evalType = type;
         return true;
     }
+
+    /**
+     Sets the evaluation function used by the model search. The function will be called with a copy of the model that already
+     has the parameters of the current grid point set, the parameter values, and the budget. The budget is in the range (0 1],
+     it is always 1 unless successive halving is enabled, in which case the function should scale the resources it uses (e.g.
+     the fraction of the training data or the number of training epochs) by the budget.
+
+     If parallel search is enabled this function will be called concurrently, so it must only modify the model it is given.
+
+     @param f: the evaluation function, this should return the value that will be used for optimization
+     @param type: sets if the search should find the maximum or minimum value
+     @return returns true if the evaluation function was set
+     */
+    bool setModelEvaluationFunction( std::function< Float (T&,const VectorFloat&,Float) > f, SearchType type = MaxValueSearch ){
+        modelEvalFunc = f;
+        evalType = type;
+        return true;
+    }
+
+    /**
+     Sets if the model search should evaluate the grid points concurrently on the thread pool. Parallel search is only used when
+     GRT_CXX11_ENABLED is defined.
+
+     @param parallelSearch: the new parallelSearch mode
+     @return returns true if the mode was updated
+     */
+    bool setParallelSearch( const bool parallelSearch ){
+        this->parallelSearch = parallelSearch;
+        return true;
+    }
+
+    /**
+     Enables successive halving for the model search. All the grid points are first evaluated with a budget of minBudget, then
+     only the best 1/halvingRate of the grid points are kept and evaluated again with a budget that is halvingRate times larger.
+     This is repeated until the remaining grid points have been evaluated with the full budget of 1.
+
+     @param useSuccessiveHalving: if true successive halving will be used
+     @param halvingRate: the factor the number of grid points is reduced by (and the budget is increased by) at each round, must be greater than 1
+     @param minBudget: the budget used for the first round, must be in the range (0 1]
+     @return returns true if successive halving was updated, false otherwise
+     */
+    bool enableSuccessiveHalving( const bool useSuccessiveHalving, const Float halvingRate = 3, const Float minBudget = 0.1 ){
+        if( halvingRate <= 1 ){
+            errorLog << "enableSuccessiveHalving(...) - The halvingRate must be greater than 1!" << std::endl;
+            return false;
+        }
+        if( minBudget <= 0 || minBudget > 1 ){
+            errorLog << "enableSuccessiveHalving(...) - The minBudget must be in the range (0 1]!" << std::endl;
+            return false;
+        }
+        this->useSuccessiveHalving = useSuccessiveHalving;
+        this->halvingRate = halvingRate;
+        this->minBudget = minBudget;
+        return true;
+    }
  
 protected:
 
@@ -241,12 +422,191 @@ protected:
         return params[ paramIndex ].reset();
     }
 
+    /**
+     Runs the model search, building every grid point from the model parameter ranges and evaluating each one on its own copy of
+     the model. If successive halving is enabled the grid points are evaluated over several rounds with an increasing budget.
+
+     @return returns true if the search completed, false otherwise
+     */
+    bool searchModels(){
+
+        const unsigned int numParams = modelParams.getSize();
+        bestParameters.clear();
+        numEvaluations = 0;
+
+        if( numParams == 0 ){
+            warningLog << "searchModels() - No parameters to search! Add some parameters!" << std::endl;
+            return false;
+        }
+
+        //Build the grid, the first parameter changes the slowest to match the order of the recursive search
+        Vector< VectorFloat > grid( 1 );
+        for(unsigned int p=0; p<numParams; p++){
+            const Vector< Float > values = modelParams[p].range.getValues();
+            Vector< VectorFloat > expandedGrid;
+            expandedGrid.reserve( grid.getSize() * values.getSize() );
+            for(unsigned int i=0; i<grid.getSize(); i++){
+                for(unsigned int j=0; j<values.getSize(); j++){
+                    VectorFloat point( p+1 );
+                    std::copy( grid[i].begin(), grid[i].end(), point.begin() );
+                    point[p] = values[j];
+                    expandedGrid.push_back( point );
+                }
+            }
+            grid.swap( expandedGrid );
+        }
+
+        //Evaluate the grid, with successive halving only the best 1/halvingRate of the grid points survive each round
+        Vector< unsigned int > active( grid.getSize() );
+        for(unsigned int i=0; i<active.getSize(); i++) active[i] = i;
+
+        Float budget = useSuccessiveHalving ? minBudget : 1.0;
+        while( true ){
+
+            VectorFloat results;
+            unsigned int roundBestIndex = 0;
+            T roundBestModel;
+            if( !evaluateGridPoints( grid, active, budget, results, roundBestIndex, roundBestModel ) ){
+                return false;
+            }
+
+            trainingLog << "searchModels() - Evaluated " << active.getSize() << " grid points with a budget of " << budget << ", best result: " << results[ roundBestIndex ] << std::endl;
+
+            if( budget >= 1.0 ){
+                bestResult = results[ roundBestIndex ];
+                bestModel = roundBestModel;
+                bestParameters = grid[ active[ roundBestIndex ] ];
+                break;
+            }
+
+            //Keep the best grid points for the next round, ties are broken by the grid order so the search is deterministic
+            Vector< IndexedDouble > ranking( active.getSize() );
+            for(unsigned int i=0; i<active.getSize(); i++){
+                ranking[i].index = i;
+                ranking[i].value = evalType == MaxValueSearch ? -results[i] : results[i];
+            }
+            std::stable_sort( ranking.begin(), ranking.end(), IndexedDouble::sortIndexedDoubleByValueAscending );
+
+            const unsigned int numKeep = grt_max( (unsigned int)floor( active.getSize() / halvingRate ), (unsigned int)1 );
+            Vector< unsigned int > survivors( numKeep );
+            for(unsigned int i=0; i<numKeep; i++) survivors[i] = active[ ranking[i].index ];
+            std::sort( survivors.begin(), survivors.end() );
+            active.swap( survivors );
+
+            budget = grt_min( budget * halvingRate, Float(1.0) );
+        }
+
+        return true;
+    }
+
+    /**
+     Evaluates the active grid points with the given budget, each grid point is set on a new copy of the model.
+
+     @param grid: all the grid points
+     @param active: the indexes of the grid points that should be evaluated
+     @param budget: the budget that will be passed to the model evaluation function
+     @param results: returns the result of each active grid point
+     @param bestIndex: returns the index (in active) of the best grid point
+     @param best: returns the model of the best grid point
+     @return returns true if all the grid points were evaluated, false otherwise
+     */
+    bool evaluateGridPoints( const Vector< VectorFloat > &grid, const Vector< unsigned int > &active, const Float budget, VectorFloat &results, unsigned int &bestIndex, T &best ){
+
+        const unsigned int N = active.getSize();
+        results.resize( N );
+        Vector< unsigned int > valid( N, 0 );
+        bestIndex = 0;
+
+        //Only the best model is kept, each task keeps the best model from the grid points it has evaluated
+        bool bestFound = false;
+        auto evaluate = [&]( const unsigned int i, bool &found, unsigned int &index, T &target ){
+            T candidate( model );
+            const VectorFloat &point = grid[ active[i] ];
+            for(unsigned int p=0; p<point.getSize(); p++){
+                if( !modelParams[p].set( candidate, point[p] ) ){
+                    warningLog << "evaluateGridPoints(...) - Failed to set parameter " << p << " to " << point[p] << std::endl;
+                }
+            }
+            results[i] = modelEvalFunc( candidate, point, budget );
+            valid[i] = 1;
+            if( !found || isBetter( results[i], results[index] ) ){
+                found = true;
+                index = i;
+                target = candidate;
+            }
+        };
+
+#ifdef GRT_CXX11_ENABLED
+        const unsigned int numThreads = ThreadPool::getNumParallelBlocks( N, 1, parallelSearch ? 0 : 1 );
+
+        if( numThreads > 1 ){
+            //The grid points are handed out one at a time, as the cost of each evaluation can vary a lot between grid points
+            std::atomic< unsigned int > nextIndex( 0 );
+            Vector< T > threadBestModels( numThreads );
+            Vector< unsigned int > threadBestIndex( numThreads, 0 );
+            Vector< unsigned int > threadFound( numThreads, 0 );
+
+            ThreadPool::parallelFor( 0, numThreads, 1, [&](const unsigned int threadBegin,const unsigned int threadEnd){
+                for(unsigned int t=threadBegin; t<threadEnd; t++){
+                    bool found = false;
+                    unsigned int index = 0;
+                    unsigned int i = 0;
+                    while( (i = nextIndex++) < N ){
+                        evaluate( i, found, index, threadBestModels[t] );
+                    }
+                    threadFound[t] = found ? 1 : 0;
+                    threadBestIndex[t] = index;
+                }
+                return true;
+            }, numThreads );
+
+            //Merge the results, ties are broken by the grid order
+            for(unsigned int t=0; t<numThreads; t++){
+                if( !threadFound[t] ) continue;
+                const unsigned int i = threadBestIndex[t];
+                if( !bestFound || isBetter( results[i], results[bestIndex] ) || ( results[i] == results[bestIndex] && i < bestIndex ) ){
+                    bestFound = true;
+                    bestIndex = i;
+                    best = threadBestModels[t];
+                }
+            }
+        }else{
+            for(unsigned int i=0; i<N; i++) evaluate( i, bestFound, bestIndex, best );
+        }
+#else
+        for(unsigned int i=0; i<N; i++) evaluate( i, bestFound, bestIndex, best );
+#endif
+
+        numEvaluations += N;
+
+        for(unsigned int i=0; i<N; i++){
+            if( !valid[i] ){
+                errorLog << "evaluateGridPoints(...) - Failed to evaluate grid point " << active[i] << std::endl;
+                return false;
+            }
+        }
+
+        return bestFound;
+    }
+
+    bool isBetter( const Float result, const Float currentBest ) const{
+        return evalType == MaxValueSearch ? result > currentBest : result < currentBest;
+    }
+
     Vector< GridSearchParam<unsigned int> > params;
+    Vector< GridSearchModelParam<T> > modelParams;
     std::function< Float () >  evalFunc; 
+    std::function< Float (T&,const VectorFloat&,Float) > modelEvalFunc;
     SearchType evalType;
     Float bestResult;
     T model;
     T bestModel;
+    VectorFloat bestParameters;
+    bool parallelSearch;
+    bool useSuccessiveHalving;
+    Float halvingRate;
+    Float minBudget;
+    unsigned int numEvaluations;
 };
 
 GRT_END_NAMESPACE
@@ -0,0 +1,196 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define GRT_DLL_EXPORTS
+#include "LBFGS.h"
+
+GRT_BEGIN_NAMESPACE
+
+static Float lbfgsDot( const Float *a, const Float *b, const UINT N ){
+    Float sum = 0;
+    for(UINT i=0; i<N; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+LBFGS::LBFGS(const UINT memorySize,const UINT maxNumIterations,const Float minChange,const Float minGradientNorm) : errorLog("[ERROR LBFGS]"), warningLog("[WARNING LBFGS]"){
+    this->memorySize = memorySize > 0 ? memorySize : 1;
+    this->maxNumIterations = maxNumIterations;
+    this->maxNumLineSearchSteps = 40;
+    this->minChange = minChange;
+    this->minGradientNorm = minGradientNorm;
+    numIterations = 0;
+    converged = false;
+    minimumValue = 0;
+}
+
+LBFGS::~LBFGS(){
+}
+
+bool LBFGS::minimize(const ObjectiveFunction &objective,VectorFloat &x){
+
+    numIterations = 0;
+    converged = false;
+    minimumValue = 0;
+    objectiveValues.clear();
+
+    const UINT N = x.getSize();
+    if( N == 0 ){
+        errorLog << "minimize(...) - The starting point is empty!" << std::endl;
+        return false;
+    }
+
+    VectorFloat gradient( N );
+    VectorFloat direction( N );
+    VectorFloat xNew( N );
+    VectorFloat gradientNew( N );
+    VectorFloat sNew( N );
+    VectorFloat yNew( N );
+    Float value = objective( x, gradient );
+
+    if( grt_isnan(value) || grt_isinf(value) ){
+        errorLog << "minimize(...) - The objective function is not finite at the starting point!" << std::endl;
+        return false;
+    }
+    objectiveValues.push_back( value );
+
+    //The last memorySize position changes (s) and gradient changes (y) are stored in a ring buffer, one per row
+    MatrixFloat s( memorySize, N );
+    MatrixFloat y( memorySize, N );
+    VectorFloat rho( memorySize );
+    VectorFloat alpha( memorySize );
+    UINT numStored = 0;
+    UINT newest = 0;
+
+    while( numIterations < maxNumIterations ){
+
+        const Float gradientNorm = sqrt( lbfgsDot( &gradient[0], &gradient[0], N ) );
+        if( gradientNorm <= minGradientNorm ){
+            converged = true;
+            break;
+        }
+
+        //Compute the search direction with the two-loop recursion, starting from the newest update
+        for(UINT i=0; i<N; i++) direction[i] = gradient[i];
+        for(UINT j=0; j<numStored; j++){
+            const UINT k = (newest + memorySize - j) % memorySize;
+            alpha[k] = rho[k] * lbfgsDot( s.getData() + k*N, &direction[0], N );
+            const Float *yk = y.getData() + k*N;
+            for(UINT i=0; i<N; i++) direction[i] -= alpha[k] * yk[i];
+        }
+
+        //Scale the initial inverse Hessian, using a unit length step for the first iteration
+        Float gamma = 1.0 / gradientNorm;
+        if( numStored > 0 ){
+            const Float *yk = y.getData() + newest*N;
+            gamma = lbfgsDot( s.getData() + newest*N, yk, N ) / lbfgsDot( yk, yk, N );
+        }
+        for(UINT i=0; i<N; i++) direction[i] *= gamma;
+
+        for(UINT j=numStored; j>0; j--){
+            const UINT k = (newest + memorySize - (j-1)) % memorySize;
+            const Float beta = rho[k] * lbfgsDot( y.getData() + k*N, &direction[0], N );
+            const Float *sk = s.getData() + k*N;
+            for(UINT i=0; i<N; i++) direction[i] += sk[i] * (alpha[k] - beta);
+        }
+        for(UINT i=0; i<N; i++) direction[i] = -direction[i];
+
+        //If the direction is not a descent direction then the history is not useful anymore, so restart with steepest descent
+        Float directionalDerivative = lbfgsDot( &direction[0], &gradient[0], N );
+        if( directionalDerivative >= 0 ){
+            numStored = 0;
+            for(UINT i=0; i<N; i++) direction[i] = -gradient[i] / gradientNorm;
+            directionalDerivative = -gradientNorm;
+        }
+
+        //Backtracking line search, until the step gives a sufficient decrease in the function value
+        const Float c1 = 1.0e-4;
+        Float step = 1.0;
+        Float valueNew = value;
+        bool stepFound = false;
+        for(UINT n=0; n<maxNumLineSearchSteps; n++){
+            for(UINT i=0; i<N; i++) xNew[i] = x[i] + step * direction[i];
+            valueNew = objective( xNew, gradientNew );
+            if( !grt_isnan(valueNew) && !grt_isinf(valueNew) && valueNew <= value + c1 * step * directionalDerivative ){
+                stepFound = true;
+                break;
+            }
+            step *= 0.5;
+        }
+
+        if( !stepFound ){
+            warningLog << "minimize(...) - The line search failed to find a step that decreases the function, stopping at iteration " << numIterations << std::endl;
+            break;
+        }
+
+        //Store the update, skipping it if it would make the inverse Hessian approximation indefinite
+        for(UINT i=0; i<N; i++){
+            sNew[i] = xNew[i] - x[i];
+            yNew[i] = gradientNew[i] - gradient[i];
+        }
+        const Float sy = lbfgsDot( &sNew[0], &yNew[0], N );
+        if( sy > 1.0e-10 * lbfgsDot( &yNew[0], &yNew[0], N ) && sy > 0 ){
+            const UINT next = numStored == 0 ? 0 : (newest + 1) % memorySize;
+            std::copy( sNew.begin(), sNew.end(), s.getData() + next*N );
+            std::copy( yNew.begin(), yNew.end(), y.getData() + next*N );
+            rho[next] = 1.0 / sy;
+            newest = next;
+            if( numStored < memorySize ) numStored++;
+        }
+
+        const Float change = value - valueNew;
+        x.swap( xNew );
+        gradient.swap( gradientNew );
+        value = valueNew;
+        objectiveValues.push_back( value );
+        numIterations++;
+
+        if( fabs( change ) <= minChange ){
+            converged = true;
+            break;
+        }
+    }
+
+    minimumValue = value;
+
+    return true;
+}
+
+bool LBFGS::setMemorySize(const UINT memorySize){
+    if( memorySize == 0 ) return false;
+    this->memorySize = memorySize;
+    return true;
+}
+
+bool LBFGS::setMaxNumIterations(const UINT maxNumIterations){
+    this->maxNumIterations = maxNumIterations;
+    return true;
+}
+
+bool LBFGS::setMinChange(const Float minChange){
+    this->minChange = minChange;
+    return true;
+}
+
+bool LBFGS::setMinGradientNorm(const Float minGradientNorm){
+    this->minGradientNorm = minGradientNorm;
+    return true;
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,120 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This class implements the limited memory BFGS (L-BFGS) algorithm, which can be used to minimize a smooth function
+ given its value and gradient.
+
+ The search direction is computed from the last few position and gradient changes with the standard two-loop recursion,
+ and the step size is found with a backtracking line search that satisfies the Armijo condition.
+
+ @remark This implementation is based on: Nocedal, J. and Wright, S. (2006) Numerical Optimization, Algorithm 7.4 and 7.5.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LBFGS_HEADER
+#define GRT_LBFGS_HEADER
+
+#include "../../Util/ErrorLog.h"
+#include "../../Util/WarningLog.h"
+#include "../../DataStructures/VectorFloat.h"
+#include "../../DataStructures/MatrixFloat.h"
+#include <functional>
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API LBFGS{
+public:
+    /**
+     The function that will be minimized. It should return the value of the function at x, and store the gradient of the
+     function at x in gradient (which is already the same size as x).
+     */
+    typedef std::function< Float(const VectorFloat &x,VectorFloat &gradient) > ObjectiveFunction;
+
+    /**
+     Default Constructor.
+
+     @param memorySize: the number of previous updates used to approximate the inverse Hessian. Default value = 10
+     @param maxNumIterations: the maximum number of iterations. Default value = 100
+     @param minChange: the minimization stops when the change in the function value between two iterations is less than or equal to this. Default value = 1.0e-10
+     @param minGradientNorm: the minimization stops when the norm of the gradient is less than or equal to this. Default value = 1.0e-8
+     */
+    LBFGS(const UINT memorySize = 10,const UINT maxNumIterations = 100,const Float minChange = 1.0e-10,const Float minGradientNorm = 1.0e-8);
+
+    /**
+     Default Destructor.
+     */
+    ~LBFGS();
+
+    /**
+     Minimizes the objective function, starting from x.
+
+     @param objective: the function to minimize
+     @param x: the starting point, this will be set to the minimum that was found
+     @return returns true if the minimization was run, false if the starting point was invalid
+     */
+    bool minimize(const ObjectiveFunction &objective,VectorFloat &x);
+
+    /**
+     @return returns the number of iterations run by the last call to minimize
+     */
+    UINT getNumIterations() const { return numIterations; }
+
+    /**
+     @return returns true if the last call to minimize stopped because of the minChange or minGradientNorm criteria, rather than the maximum number of iterations
+     */
+    bool getConverged() const { return converged; }
+
+    /**
+     @return returns the value of the function at the minimum found by the last call to minimize
+     */
+    Float getMinimumValue() const { return minimumValue; }
+
+    /**
+     @return returns the value of the function at the start of the minimization and after each iteration
+     */
+    VectorFloat getObjectiveValues() const { return objectiveValues; }
+
+    bool setMemorySize(const UINT memorySize);
+    bool setMaxNumIterations(const UINT maxNumIterations);
+    bool setMinChange(const Float minChange);
+    bool setMinGradientNorm(const Float minGradientNorm);
+
+protected:
+    UINT memorySize;
+    UINT maxNumIterations;
+    UINT maxNumLineSearchSteps;
+    Float minChange;
+    Float minGradientNorm;
+    UINT numIterations;
+    bool converged;
+    Float minimumValue;
+    VectorFloat objectiveValues;
+
+    ErrorLog errorLog;
+    WarningLog warningLog;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_LBFGS_HEADER
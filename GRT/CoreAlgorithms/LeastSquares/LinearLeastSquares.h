@@ -6,6 +6,9 @@
  
  @brief This class implements a basic Linear Least Squares algorithm.
  
+ The solver can fit a line to one input dimension, or solve the multivariate (and multi-target) problem with the normal
+ equations and a Cholesky decomposition.
+ 
  @remark This implementation is based on TODO
  
  */
@@ -34,6 +37,7 @@
 #define GRT_LINEAR_LEAST_SQUARES_HEADER
 
 #include "../../CoreModules/MLBase.h"
+#include "../../Util/Cholesky.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -59,16 +63,17 @@ public:
     bool solve( const VectorFloat &x, const VectorFloat &y ){
         
         if( x.size() == 0 && y.size() == 0 ){
-            warningLog << "solve( const VectorFloat &x, const VectorFloat &y ) - Failed to compute solution, input vectors are empty!" << endl;
+            warningLog << "solve( const VectorFloat &x, const VectorFloat &y ) - Failed to compute solution, input vectors are empty!" << std::endl;
             return false;
         }
         
         if( x.size() != y.size() ){
-            warningLog << "solve( const VectorFloat &x, const VectorFloat &y ) - Failed to compute solution, input vectors do not have the same size!" << endl;
+            warningLog << "solve( const VectorFloat &x, const VectorFloat &y ) - Failed to compute solution, input vectors do not have the same size!" << std::endl;
             return false;
         }
         
         const unsigned int N = (unsigned int)x.size();
+        const Float n = N;
         Float sumx = 0.0;    //Stores the sum of x
         Float sumx2 = 0.0;   //Stores the sum of x^2
         Float sumxy = 0.0;   //Stores the sum of x * y
@@ -88,10 +93,10 @@ public:
             sumy2 += SQR(y[i]);
         }
         
-        denom = (n * sumx2 - sqr(sumx));
+        denom = (n * sumx2 - SQR(sumx));
         if (denom == 0) {
             // singular matrix. can't solve the problem.
-            warningLog << "solve( const VectorFloat &x, const VectorFloat &y ) - Failed to compute solution, singular matrix detected!" << endl;
+            warningLog << "solve( const VectorFloat &x, const VectorFloat &y ) - Failed to compute solution, singular matrix detected!" << std::endl;
             return false;
         }
         
@@ -99,19 +104,115 @@ public:
         b = (sumy * sumx2  -  sumx * sumxy) / denom;
         
         //compute correlation coeff
-        r = (sumxy - sumx * sumy / n) / sqrt( (sumx2 - sqr(sumx)/n) * (sumy2 - sqr(sumy)/n) );
+        r = (sumxy - sumx * sumy / n) / sqrt( (sumx2 - SQR(sumx)/n) * (sumy2 - SQR(sumy)/n) );
+        
+        return true;
+    }
+    
+    /**
+     Solves the multivariate least squares problem Y = [1 X] * W with the normal equations and a Cholesky decomposition.
+     The inputs and targets are centered first, so the intercept is not part of the linear system (which is then better
+     conditioned), and all the target columns are solved with the same decomposition. If the system is singular, a small
+     amount of regularization is added until it can be solved.
+     
+     @param X: the input data, with one sample per row
+     @param Y: the target data, with one sample per row, this must have the same number of rows as X
+     @param ridge: the L2 regularization coefficient, the intercept is not regularized. Default value = 0
+     @return returns true if the solution was computed, false otherwise
+     */
+    bool solve( const MatrixFloat &X, const MatrixFloat &Y, const Float ridge = 0 ){
+        
+        const unsigned int M = X.getNumRows();
+        const unsigned int N = X.getNumCols();
+        const unsigned int T = Y.getNumCols();
+        weights.clear();
+        
+        if( M == 0 || N == 0 || T == 0 ){
+            warningLog << "solve( const MatrixFloat &X, const MatrixFloat &Y, const Float ridge ) - Failed to compute solution, input matrices are empty!" << std::endl;
+            return false;
+        }
+        
+        if( Y.getNumRows() != M ){
+            warningLog << "solve( const MatrixFloat &X, const MatrixFloat &Y, const Float ridge ) - Failed to compute solution, input matrices do not have the same number of rows!" << std::endl;
+            return false;
+        }
+        
+        //Center the inputs and targets
+        VectorFloat xMean = X.getMean();
+        VectorFloat yMean = Y.getMean();
+        MatrixFloat Xc( M, N );
+        MatrixFloat Yc( M, T );
+        for(unsigned int i=0; i<M; i++){
+            for(unsigned int j=0; j<N; j++) Xc[i][j] = X[i][j] - xMean[j];
+            for(unsigned int t=0; t<T; t++) Yc[i][t] = Y[i][t] - yMean[t];
+        }
+        
+        //Build the normal equations: (Xc'Xc + ridge*I) W = Xc'Yc
+        MatrixFloat A;
+        MatrixFloat B;
+        A.multiple( Xc, Xc, true );
+        B.multiple( Xc, Yc, true );
+        
+        Float trace = 0;
+        for(unsigned int j=0; j<N; j++) trace += A[j][j];
+        const Float jitterScale = trace > 0 ? trace / N : 1.0;
+        
+        Float jitter = 0;
+        bool solved = false;
+        MatrixFloat W( N, T );
+        VectorFloat b( N );
+        VectorFloat w( N );
+        for(unsigned int attempt=0; attempt<10 && !solved; attempt++){
+            MatrixFloat regularizedA( A );
+            for(unsigned int j=0; j<N; j++) regularizedA[j][j] += ridge + jitter;
+            
+            Cholesky cholesky( regularizedA );
+            if( cholesky.getSuccess() ){
+                for(unsigned int t=0; t<T; t++){
+                    for(unsigned int j=0; j<N; j++) b[j] = B[j][t];
+                    cholesky.solve( b, w );
+                    for(unsigned int j=0; j<N; j++) W[j][t] = w[j];
+                }
+                solved = true;
+            }else{
+                jitter = jitter == 0 ? jitterScale * 1.0e-12 : jitter * 100;
+                warningLog << "solve( const MatrixFloat &X, const MatrixFloat &Y, const Float ridge ) - The normal equations are singular, adding regularization: " << jitter << std::endl;
+            }
+        }
+        
+        if( !solved ){
+            warningLog << "solve( const MatrixFloat &X, const MatrixFloat &Y, const Float ridge ) - Failed to compute solution, the normal equations are singular!" << std::endl;
+            return false;
+        }
+        
+        //Store the intercept in the first row, followed by the weights for each input dimension
+        weights.resize( N+1, T );
+        for(unsigned int t=0; t<T; t++){
+            Float intercept = yMean[t];
+            for(unsigned int j=0; j<N; j++){
+                weights[j+1][t] = W[j][t];
+                intercept -= xMean[j] * W[j][t];
+            }
+            weights[0][t] = intercept;
+        }
         
         return true;
     }
     
+    /**
+     @return returns the solution of the last multivariate solve, the first row contains the intercept of each target and row n+1 contains the weights of input dimension n
+     */
+    const MatrixFloat& getWeights() const { return weights; }
+    
 protected:
 
     Float m;
     Float b;
     Float r;
+    MatrixFloat weights;
     
 };
 
 GRT_END_NAMESPACE
 
-#endif //GRT_MEAN_SHIFT_HEADER
+#endif //GRT_LINEAR_LEAST_SQUARES_HEADER
@@ -7,6 +7,11 @@
  @brief This class implements the MeanShift clustering algorithm.
  
  @remark This implementation is based on http://en.wikipedia.org/wiki/Mean-shift
+
+ The neighbours of each mean are found using a KDTree, so each shift only visits the points within the search radius.
+ The findModes function runs a search from a set of seeds (either every point, or the mean of the points in each bin of a
+ grid with a cell size of searchRadius), in parallel if GRT_CXX11_ENABLED is defined, and merges the modes that converge
+ within the searchRadius of each other.
  
  */
 
@@ -34,6 +39,9 @@
 #define GRT_MEAN_SHIFT_HEADER
 
 #include "../../CoreModules/MLBase.h"
+#include "../../Util/KDTree.h"
+
+#include <map>
 
 GRT_BEGIN_NAMESPACE
 
@@ -46,99 +54,256 @@ public:
         errorLog.setProceedingText("[ERROR MeanShift]");
         trainingLog.setProceedingText("[TRAINING MeanShift]");
         warningLog.setProceedingText("[WARNING MeanShift]");
+        useBinSeeding = true;
+        minBinFrequency = 1;
+        parallelSearch = true;
     }
     
     virtual ~MeanShift(){
         
     }
     
+    /**
+     Runs a single mean shift search, starting at meanStart.
+
+     @param meanStart: the start of the search
+     @param points: the points that will be searched, each point must have the same size as meanStart
+     @param searchRadius: only the points within this radius of the mean are used to shift the mean
+     @param sigma: the sigma of the Gaussian kernel used to weight each point within the search radius
+     @return returns true if the search was run, false otherwise
+     */
     bool search( const VectorFloat &meanStart, const Vector< VectorFloat > &points, const Float searchRadius, const Float sigma = 20.0 ){
-        
+
         //clear the results from any previous search
         clear();
-        
+
         const unsigned int numDimensions = (unsigned int)meanStart.size();
         const unsigned int numPoints = (unsigned int)points.size();
-        const Float gamma = 1.0 / (2 * SQR(sigma) );
-        unsigned int iteration = 0;
-        VectorFloat numer(2,0);
-        VectorFloat denom(2,0);
-        VectorFloat kernelDist(2,0);
-        Float pointsWithinSearchRadius = 0;
-        
-        mean = meanStart;
-        VectorFloat lastMean = mean;
-        
-        //Start the search loop
-        while( true ){
-            
-            //Reset the counters
-            pointsWithinSearchRadius = 0;
-            std::fill(numer.begin(),numer.end(),0);
-            std::fill(denom.begin(),denom.end(),0);
-            std::fill(kernelDist.begin(),kernelDist.end(),0);
-            
-            //Update the numerator and denominator for points that are with the search radius
-            for(unsigned int i=0; i<numPoints; i++){
-                
-                //Compute the distance of the current point to the mean
-                Float distToMean = euclideanDist( mean, points[i] );
-                
-                //If the point is within the search radius then update numer and denom
-                if( distToMean < searchRadius ){
-                    
-                    for(unsigned int j=0; j<numDimensions; j++){
-                        kernelDist[j] = gaussKernel( points[i][j], mean[j], gamma );
-                        numer[j] += kernelDist[j] * points[i][j];
-                        denom[j] += kernelDist[j];
-                    }
-                    
-                    pointsWithinSearchRadius++;
-                }
-            }
-            
-            //Update the mean
-            Float change = 0;
-            for(unsigned int j=0; j<numDimensions; j++){
-                
-                mean[j] = numer[j] / denom[j];
-                
-                change += grt_sqr( mean[j] - lastMean[j] );
-                
-                lastMean[j] = mean[j];
+
+        if( numPoints == 0 || numDimensions == 0 ){
+            errorLog << "search(...) - There are no points to search!" << std::endl;
+            return false;
+        }
+
+        MatrixFloat data( numPoints, numDimensions );
+        for(unsigned int i=0; i<numPoints; i++){
+            if( points[i].getSize() != numDimensions ){
+                errorLog << "search(...) - The size of point " << i << " does not match the size of meanStart!" << std::endl;
+                return false;
             }
-            change = grt_sqrt( change );
-            
-            trainingLog << "iteration: " << iteration;
-            trainingLog << " mean: ";
-            for(unsigned int j=0; j<numDimensions; j++){
-                trainingLog << mean[j] << " ";
+            std::copy( points[i].begin(), points[i].end(), data[i] );
+        }
+
+        KDTree tree;
+        if( !tree.build( data ) ){
+            errorLog << "search(...) - Failed to build the search tree!" << std::endl;
+            return false;
+        }
+
+        mean = meanStart;
+        unsigned int numPointsWithinSearchRadius = 0;
+        unsigned int iteration = 0;
+        if( !shift( tree, mean, searchRadius, 1.0 / (2 * SQR(sigma) ), iteration, numPointsWithinSearchRadius ) ){
+            warningLog << "search(...) - There are no points within the search radius of the mean!" << std::endl;
+        }
+
+        trainingLog << "iterations: " << iteration << " mean: ";
+        for(unsigned int j=0; j<numDimensions; j++){
+            trainingLog << mean[j] << " ";
+        }
+        trainingLog << std::endl;
+
+        numTrainingIterationsToConverge = iteration;
+        trained = true;
+
+        return true;
+    }
+
+    /**
+     Finds the modes of the data. A mean shift search is started from each seed, the seeds are either every point in the data,
+     or if bin seeding is enabled, the mean of the points in each cell of a grid with a cell size of searchRadius. The searches
+     that converge within searchRadius of each other are merged, keeping the mode with the most points within its search radius.
+
+     @param data: the data that will be searched, each row is one point
+     @param searchRadius: only the points within this radius of the mean are used to shift the mean
+     @param sigma: the sigma of the Gaussian kernel used to weight each point within the search radius
+     @return returns true if the modes were found, false otherwise
+     */
+    bool findModes( const MatrixFloat &data, const Float searchRadius, const Float sigma ){
+
+        //clear the results from any previous search
+        clear();
+        modes.clear();
+        modeSizes.clear();
+        clusterLabels.clear();
+
+        const unsigned int numPoints = data.getNumRows();
+        const unsigned int numDimensions = data.getNumCols();
+
+        if( numPoints == 0 || numDimensions == 0 ){
+            errorLog << "findModes(...) - The data is empty!" << std::endl;
+            return false;
+        }
+
+        if( searchRadius <= 0 || sigma <= 0 ){
+            errorLog << "findModes(...) - The searchRadius and sigma must be greater than zero!" << std::endl;
+            return false;
+        }
+
+        KDTree tree;
+        if( !tree.build( data ) ){
+            errorLog << "findModes(...) - Failed to build the search tree!" << std::endl;
+            return false;
+        }
+
+        //Get the seeds
+        MatrixFloat seeds;
+        if( useBinSeeding ) seeds = getBinSeeds( data, searchRadius );
+        else seeds = data;
+        const unsigned int numSeeds = seeds.getNumRows();
+
+        trainingLog << "findModes(...) - Number of seeds: " << numSeeds << std::endl;
+
+        //Shift each seed, the seeds are independent so they can be run in parallel
+        const Float gamma = 1.0 / (2 * SQR(sigma) );
+        Vector< unsigned int > seedSizes( numSeeds, 0 );
+        Vector< unsigned int > seedIterations( numSeeds, 0 );
+        auto shiftSeeds = [&]( const unsigned int begin, const unsigned int end ){
+            VectorFloat seed( numDimensions );
+            for(unsigned int i=begin; i<end; i++){
+                std::copy( seeds[i], seeds[i] + numDimensions, seed.begin() );
+                if( !shift( tree, seed, searchRadius, gamma, seedIterations[i], seedSizes[i] ) ) seedSizes[i] = 0;
+                std::copy( seed.begin(), seed.end(), seeds[i] );
             }
-            trainingLog << " change: " << change << std::endl;
-            
-            if( change < minChange ){
-                trainingLog << "min changed limit reached - stopping search" << std::endl;
-                break;
+        };
+
+        ThreadPool::parallelFor( 0, numSeeds, 16, [&shiftSeeds](const unsigned int begin,const unsigned int end){
+            shiftSeeds( begin, end );
+            return true;
+        }, parallelSearch ? 0 : 1 );
+
+        //Merge the modes, starting with the modes that have the most points within their search radius
+        Vector< IndexedDouble > ranking;
+        for(unsigned int i=0; i<numSeeds; i++){
+            if( seedSizes[i] > 0 ) ranking.push_back( IndexedDouble( i, -Float( seedSizes[i] ) ) );
+            numTrainingIterationsToConverge = grt_max( numTrainingIterationsToConverge, seedIterations[i] );
+        }
+        if( ranking.size() == 0 ){
+            errorLog << "findModes(...) - None of the seeds converged!" << std::endl;
+            return false;
+        }
+        std::stable_sort( ranking.begin(), ranking.end(), IndexedDouble::sortIndexedDoubleByValueAscending );
+
+        MatrixFloat candidates( (unsigned int)ranking.size(), numDimensions );
+        for(unsigned int i=0; i<ranking.size(); i++){
+            std::copy( seeds[ ranking[i].index ], seeds[ ranking[i].index ] + numDimensions, candidates[i] );
+        }
+
+        KDTree modeTree;
+        modeTree.build( candidates );
+        Vector< bool > suppressed( candidates.getNumRows(), false );
+        Vector< UINT > neighbours;
+        VectorFloat squaredDistances;
+        for(unsigned int i=0; i<candidates.getNumRows(); i++){
+            if( suppressed[i] ) continue;
+            modes.push_back( candidates.getRow(i) );
+            modeSizes.push_back( seedSizes[ ranking[i].index ] );
+            modeTree.radiusSearch( candidates[i], searchRadius, neighbours, squaredDistances );
+            for(unsigned int k=0; k<neighbours.size(); k++){
+                suppressed[ neighbours[k] ] = true;
             }
-            
-            if( ++iteration >= maxNumEpochs ){
-                trainingLog << "max number of iterations reached - stopping search." << std::endl;
-                break;
+        }
+
+        //Assign each point to the closest mode
+        clusterLabels.resize( numPoints );
+        const unsigned int numModes = modes.getNumRows();
+        for(unsigned int i=0; i<numPoints; i++){
+            const Float *x = data[i];
+            Float bestDist = grt_numeric_limits< Float >::max();
+            for(unsigned int k=0; k<numModes; k++){
+                const Float *m = modes[k];
+                Float dist = 0;
+                for(unsigned int j=0; j<numDimensions; j++){
+                    dist += grt_sqr( x[j] - m[j] );
+                }
+                if( dist < bestDist ){
+                    bestDist = dist;
+                    clusterLabels[i] = k;
+                }
             }
-            
         }
-        numTrainingIterationsToConverge = iteration;
+
+        trainingLog << "findModes(...) - Number of modes: " << numModes << std::endl;
+
+        mean = modes.getRow( 0 );
         trained = true;
-        
+
         return true;
     }
-    
+
     VectorFloat getMean() const {
         return mean;
     }
+
+    /**
+     Gets the modes found by the last call to findModes, each row is one mode. The modes are sorted by the number of points
+     within their search radius, so the first mode has the most support.
+
+     @return returns a MatrixFloat containing the modes
+     */
+    MatrixFloat getModes() const {
+        return modes;
+    }
+
+    /**
+     Gets the number of points within the search radius of each mode found by the last call to findModes.
+
+     @return returns a Vector with the size of each mode
+     */
+    Vector< unsigned int > getModeSizes() const {
+        return modeSizes;
+    }
+
+    /**
+     Gets the index of the closest mode for each point in the data used by the last call to findModes.
+
+     @return returns a Vector with the cluster label of each point
+     */
+    Vector< unsigned int > getClusterLabels() const {
+        return clusterLabels;
+    }
+
+    bool getBinSeedingEnabled() const {
+        return useBinSeeding;
+    }
+
+    /**
+     Sets if findModes should seed the search with the mean of the points in each bin of a grid (with a cell size equal to the
+     search radius), rather than using every point as a seed.
+
+     @param useBinSeeding: if true the seeds will be computed by binning the data
+     @param minBinFrequency: only bins that contain at least this many points will be used as a seed. Default value = 1
+     @return returns true if the parameters were updated
+     */
+    bool enableBinSeeding( const bool useBinSeeding, const unsigned int minBinFrequency = 1 ){
+        this->useBinSeeding = useBinSeeding;
+        this->minBinFrequency = minBinFrequency;
+        return true;
+    }
+
+    /**
+     Sets if findModes should shift the seeds in parallel using the thread pool. Parallel search is only used when GRT_CXX11_ENABLED is defined.
+
+     @param parallelSearch: the new parallelSearch mode
+     @return returns true if the mode was updated
+     */
+    bool setParallelSearch( const bool parallelSearch ){
+        this->parallelSearch = parallelSearch;
+        return true;
+    }
     
     Float gaussKernel( const Float &x, const Float &mu, const Float gamma ){
-        return exp( gamma * grt_sqr(x-mu) );
+        return exp( -gamma * grt_sqr(x-mu) );
     }
     
     Float gaussKernel( const VectorFloat &x, const VectorFloat &mu, const Float gamma ){
@@ -148,7 +313,7 @@ public:
         for(UINT i=0; i<N; i++){
             y += grt_sqr(x[i]-mu[i]);
         }
-        return exp( gamma * y );
+        return exp( -gamma * y );
     }
     
     Float euclideanDist( const VectorFloat &x, const VectorFloat &y ){
@@ -164,7 +329,124 @@ public:
     
 protected:
 
+    /**
+     Shifts the mean until it converges, using the points in the tree that are within the search radius of the mean.
+
+     @param tree: the tree containing the points
+     @param mean: the start of the search, this will be set to the final mean
+     @param searchRadius: only the points within this radius of the mean are used to shift the mean
+     @param gamma: the kernel coefficient, 1/(2*sigma^2)
+     @param iteration: returns the number of iterations
+     @param numPointsWithinSearchRadius: returns the number of points within the search radius of the final mean
+     @return returns true if the mean was shifted, false if there were no points within the search radius
+     */
+    bool shift( const KDTree &tree, VectorFloat &mean, const Float searchRadius, const Float gamma, unsigned int &iteration, unsigned int &numPointsWithinSearchRadius ) const{
+
+        const unsigned int numDimensions = tree.getNumDimensions();
+        Vector< UINT > neighbours;
+        VectorFloat squaredDistances;
+        VectorFloat numer( numDimensions, 0 );
+
+        iteration = 0;
+        numPointsWithinSearchRadius = 0;
+
+        while( true ){
+
+            //Update the numerator and denominator for points that are within the search radius
+            tree.radiusSearch( &mean[0], searchRadius, neighbours, squaredDistances );
+            numPointsWithinSearchRadius = (unsigned int)neighbours.size();
+            if( numPointsWithinSearchRadius == 0 ) return false;
+
+            std::fill( numer.begin(), numer.end(), 0 );
+            Float denom = 0;
+            for(unsigned int i=0; i<numPointsWithinSearchRadius; i++){
+                const Float *x = tree.getPoint( neighbours[i] );
+                const Float w = exp( -gamma * squaredDistances[i] );
+                for(unsigned int j=0; j<numDimensions; j++){
+                    numer[j] += w * x[j];
+                }
+                denom += w;
+            }
+            if( denom <= 0 ) return false;
+
+            //Update the mean
+            Float change = 0;
+            for(unsigned int j=0; j<numDimensions; j++){
+                const Float m = numer[j] / denom;
+                change += grt_sqr( m - mean[j] );
+                mean[j] = m;
+            }
+            change = grt_sqrt( change );
+
+            if( change < minChange ) break;
+
+            if( ++iteration >= maxNumEpochs ) break;
+        }
+
+        return true;
+    }
+
+    /**
+     Bins the data into a grid with a cell size of binSize and returns the mean of the points in each bin that has at least
+     minBinFrequency points.
+     */
+    MatrixFloat getBinSeeds( const MatrixFloat &data, const Float binSize ) const{
+
+        const unsigned int numPoints = data.getNumRows();
+        const unsigned int numDimensions = data.getNumCols();
+        std::map< Vector< long long >, unsigned int > binLookup;
+        Vector< VectorFloat > binSums;
+        Vector< unsigned int > binCounts;
+        Vector< long long > key( numDimensions );
+
+        for(unsigned int i=0; i<numPoints; i++){
+            const Float *x = data[i];
+            for(unsigned int j=0; j<numDimensions; j++){
+                key[j] = (long long)floor( x[j] / binSize );
+            }
+            typename std::map< Vector< long long >, unsigned int >::iterator iter = binLookup.find( key );
+            unsigned int bin = 0;
+            if( iter == binLookup.end() ){
+                bin = (unsigned int)binSums.size();
+                binLookup[ key ] = bin;
+                binSums.push_back( VectorFloat( numDimensions, 0 ) );
+                binCounts.push_back( 0 );
+            }else bin = iter->second;
+
+            for(unsigned int j=0; j<numDimensions; j++){
+                binSums[bin][j] += x[j];
+            }
+            binCounts[bin]++;
+        }
+
+        unsigned int numSeeds = 0;
+        for(unsigned int k=0; k<binCounts.size(); k++){
+            if( binCounts[k] >= minBinFrequency ) numSeeds++;
+        }
+
+        //If none of the bins are frequent enough then use every point as a seed
+        if( numSeeds == 0 ) return data;
+
+        MatrixFloat seeds( numSeeds, numDimensions );
+        unsigned int seedIndex = 0;
+        for(unsigned int k=0; k<binCounts.size(); k++){
+            if( binCounts[k] < minBinFrequency ) continue;
+            for(unsigned int j=0; j<numDimensions; j++){
+                seeds[seedIndex][j] = binSums[k][j] / binCounts[k];
+            }
+            seedIndex++;
+        }
+
+        return seeds;
+    }
+
+    bool useBinSeeding;
+    bool parallelSearch;
+    unsigned int minBinFrequency;
     VectorFloat mean;
+    MatrixFloat modes;
+    Vector< unsigned int > modeSizes;
+    Vector< unsigned int > clusterLabels;
     
 };
 
@@ -48,6 +48,7 @@ public:
         initialized = false;
         verbose = true;
         normWeights = true;
+        parallelUpdate = false;
         initMode = INIT_MODE_UNIFORM;
         estimationMode = WEIGHTED_MEAN;
         numParticles = 0;
@@ -103,7 +104,7 @@ public:
      @return returns a reference to the i'th particle (if i is valid)
      */
     PARTICLE& operator()(const unsigned int &i){
-        return (&particles == &particleDistributionA ? particleDistributionB[i] : particleDistributionA[i]);
+        return particleDistributionB[i];
     }
     
     /**
@@ -113,7 +114,7 @@ public:
      @return returns a reference to the i'th particle (if i is valid)
      */
     const PARTICLE& operator()(const unsigned int &i) const {
-        return (&particles == &particleDistributionA ? particleDistributionB[i] : particleDistributionA[i]);
+        return particleDistributionB[i];
     }
     
     /**
@@ -124,6 +125,7 @@ public:
             this->initialized = rhs.initialized;
             this->verbose = rhs.verbose;
             this->normWeights = rhs.normWeights;
+            this->parallelUpdate = rhs.parallelUpdate;
             this->numParticles= rhs.numParticles;
             this->stateVectorSize = rhs.stateVectorSize;
             this->initMode = rhs.initMode;
@@ -141,11 +143,7 @@ public:
             this->measurementNoise = rhs.measurementNoise;
             this->particleDistributionA = rhs.particleDistributionA;
             this->particleDistributionB = rhs.particleDistributionB;
-            if( &rhs.particles == &rhs.particleDistributionA ){
-                this->particles = particleDistributionA;
-            }else{
-                this->particles = particleDistributionB;
-            }
+            this->weights = rhs.weights;
             this->cumsum = rhs.cumsum;
             this->warningLog = rhs.warningLog;
             this->errorLog = rhs.errorLog;
@@ -203,11 +201,12 @@ public:
         this->numParticles = numParticles;
         particleDistributionA.clear();
         particleDistributionB.clear();
+        weights.clear();
         cumsum.clear();
         particleDistributionA.resize( numParticles, PARTICLE(stateVectorSize) );
         particleDistributionB.resize( numParticles, PARTICLE(stateVectorSize) );
-        particles = particleDistributionA;
-        cumsum.resize( numParticles,0 );
+        weights.resize( numParticles, 0 );
+        cumsum.resize( numParticles, 0 );
         
         reset();
         
@@ -233,23 +232,18 @@ public:
             return false;
         }
         
-        unsigned int i = 0;
-        typename Vector< PARTICLE >::iterator iter;
+        const unsigned int N = (unsigned int)particles.size();
         
-        //The main particle prediction loop
-        for( iter = particles.begin(), i = 0; iter != particles.end(); ++iter, i++ ){
-            if( !predict( *iter ) ){
-                errorLog << "ERROR: Particle " << i << " failed prediction!" << std::endl;
-                return false;
-            }
+        //The main particle prediction step, this runs on the calling thread as most process models draw from the shared random generator
+        if( !predictBatch( 0, N ) ){
+            errorLog << "ERROR: Failed to predict particles!" << std::endl;
+            return false;
         }
         
-        //The main particle update loop
-        for( iter = particles.begin(), i = 0; iter != particles.end(); ++iter, i++ ){
-            if( !update( *iter, data ) ){
-                errorLog << "ERROR: Particle " << i << " failed update!" << std::endl;
-                return false;
-            }
+        //The main particle update step, the particles are split into contiguous blocks that can be weighted in parallel
+        if( !updateParticles( data ) ){
+            errorLog << "ERROR: Failed to update particles!" << std::endl;
+            return false;
         }
         
         //Normalize the particle weights so they sum to 1
@@ -303,6 +297,7 @@ public:
         measurementNoise.clear();
         particleDistributionA.clear();
         particleDistributionB.clear();
+        weights.clear();
         cumsum.clear();
         return true;
     }
@@ -350,6 +345,24 @@ public:
         return initialized ? (unsigned int)particles.size() : 0;
     }
     
+    /**
+     Gets if the particle update step is split across the thread pool. Parallel updates are disabled by default.
+     
+     @return returns true if parallel updates are enabled, false otherwise
+     */
+    bool getParallelUpdate() const{
+        return parallelUpdate;
+    }
+    
+    /**
+     Gets the current particle weights. These are stored contiguously, in the same order as the particles.
+     
+     @return returns a VectorFloat containing the weight of each particle
+     */
+    const VectorFloat& getWeights() const{
+        return weights;
+    }
+    
     /**
      Gets the number of dimensions in the state Vector.
      
@@ -420,7 +433,7 @@ public:
      @return returns a Vector with the current particles
      */
     Vector< PARTICLE > getParticles(){
-        return (&particles == &particleDistributionA ? particleDistributionA : particleDistributionB);
+        return particleDistributionA;
     }
     
     /**
@@ -429,7 +442,7 @@ public:
      @return returns a Vector with the old particles (i.e. before they were resampled
      */
     Vector< PARTICLE > getOldParticles(){
-        return (&particles == &particleDistributionA ? particleDistributionB : particleDistributionA);
+        return particleDistributionB;
     }
     
     /**
@@ -463,6 +476,20 @@ public:
         return true;
     }
     
+    /**
+     Sets if the particle update step should be split across the thread pool. If enabled, the #updateBatch function
+     will be called concurrently on disjoint particle ranges, so any custom update function must only modify the
+     particles it is given. The blocks run on the shared GRT thread pool, so no threads are created by filter().
+     Parallel updates are disabled by default, and are only used when GRT_CXX11_ENABLED is defined.
+     
+     @param const bool parallelUpdate: the new parallelUpdate mode
+     @return returns true if the parallelUpdate was successfully updated, false otherwise
+     */
+    bool setParallelUpdate(const bool parallelUpdate){
+        this->parallelUpdate = parallelUpdate;
+        return true;
+    }
+    
     /**
      Sets the threshold used to determine if the particles should be resampled.
      The particles will be resampled if the wNorm value is less than the resampleThreshold.
@@ -579,6 +606,47 @@ protected:
         return false;
     }
     
+    /**
+     The batch prediction function, this is called once per filter iteration with the full particle range.
+     The default implementation calls #predict for each particle, you can override it in your derived class if your
+     process model can be applied to a block of particles more efficiently.
+     
+     @param const unsigned int begin: the index of the first particle that should be predicted
+     @param const unsigned int end: one past the index of the last particle that should be predicted
+     @return returns true if the particles were predicted successfully, false otherwise
+     */
+    virtual bool predictBatch( const unsigned int begin, const unsigned int end ){
+        for(unsigned int i=begin; i<end; i++){
+            if( !predict( particles[i] ) ){
+                errorLog << "ERROR: Particle " << i << " failed prediction!" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    /**
+     The batch update function, this should set the weight (w) of each particle in the range [begin end).
+     The default implementation calls #update for each particle, you can override it in your derived class if your
+     measurement model can be applied to a block of particles more efficiently.
+     
+     If parallel updates are enabled, this function will be called concurrently on disjoint particle ranges.
+     
+     @param SENSOR_DATA &data: the current sensor data
+     @param const unsigned int begin: the index of the first particle that should be updated
+     @param const unsigned int end: one past the index of the last particle that should be updated
+     @return returns true if the particles were updated successfully, false otherwise
+     */
+    virtual bool updateBatch( SENSOR_DATA &data, const unsigned int begin, const unsigned int end ){
+        for(unsigned int i=begin; i<end; i++){
+            if( !update( particles[i], data ) ){
+                errorLog << "ERROR: Particle " << i << " failed update!" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+    
     /**
      This function normalizes the particle weights so they sum to 1.
      This is a virtual function, so you can override it in your derived class if needed.
@@ -588,16 +656,18 @@ protected:
     virtual bool normalizeWeights(){
         
         //Compute the total particle weight and number of dead particles
+        const unsigned int N = weights.getSize();
+        Float *w = weights.getData();
         wNorm = 0;
         wDotProduct = 0;
         numDeadParticles = 0;
-        typename Vector< PARTICLE >::iterator iter;
-        for( iter = particles.begin(); iter != particles.end(); ++iter ){
-            if( grt_isinf( iter->w ) ){
+        for(unsigned int i=0; i<N; i++){
+            if( grt_isinf( w[i] ) ){
                 numDeadParticles++;
-                iter->w = 0;
+                w[i] = 0;
+                particles[i].w = 0;
             }else{
-                wNorm += iter->w;
+                wNorm += w[i];
             }
         }
         
@@ -609,17 +679,16 @@ protected:
         
         //Normalized the weights so they sum to 1
         Float weightUpdate = 1.0 / wNorm;
-        for( iter = particles.begin(); iter != particles.end(); ++iter ){
+        for(unsigned int i=0; i<N; i++){
             
             //Normalize the weights (so they sum to 1)
-            iter->w *= weightUpdate;
+            w[i] *= weightUpdate;
+            particles[i].w = w[i];
             
             //Compute the total weights dot product (this is used later to test for degeneracy)
-            wDotProduct += iter->w * iter->w;
+            wDotProduct += w[i] * w[i];
         }
         wDotProduct = 1.0 / wDotProduct;
-        
-        //cout << "wNorm: " << wNorm << " wDotProduct: " << wDotProduct << std::endl;
 
         return true;
     }
@@ -633,24 +702,26 @@ protected:
      */
     virtual bool computeEstimate(){
         
-        typename Vector< PARTICLE >::iterator iter;
         const unsigned int N = (unsigned int)x.size();
+        const Float *w = weights.getData();
         unsigned int bestIndex = 0;
         unsigned int robustMeanParticleCounter = 0;
         Float bestWeight = 0;
         Float sum = 0;
         estimationLikelihood = 0;
+        
+        for(unsigned int j=0; j<N; j++){
+            x[j] = 0;
+        }
+        
         switch( estimationMode ){
             case MEAN:
-                for(unsigned int j=0; j<N; j++){
-                    x[j] = 0;
-                }
-                
-                for( iter = particles.begin(); iter != particles.end(); ++iter ){
+                for(unsigned int i=0; i<numParticles; i++){
+                    const Float *p = particles[i].x.getData();
                     for(unsigned int j=0; j<N; j++){
-                        x[j] += iter->x[j];
+                        x[j] += p[j];
                     }
-                    estimationLikelihood += grt_isnan(iter->w) ? 0 : iter->w;
+                    estimationLikelihood += grt_isnan(w[i]) ? 0 : w[i];
                 }
                 
                 for(unsigned int j=0; j<N; j++){
@@ -659,44 +730,38 @@ protected:
                 estimationLikelihood /= Float(numParticles);
                 break;
             case WEIGHTED_MEAN:
-                for(unsigned int j=0; j<N; j++){
-                    x[j] = 0;
-                    sum = 0;
-                    for( iter = particles.begin(); iter != particles.end(); ++iter ){
-                        x[j] += iter->x[j] * iter->w;
-                        sum += iter->w;
+                for(unsigned int i=0; i<numParticles; i++){
+                    const Float *p = particles[i].x.getData();
+                    for(unsigned int j=0; j<N; j++){
+                        x[j] += p[j] * w[i];
                     }
-                    x[j] /= sum;
+                    sum += w[i];
+                    estimationLikelihood += grt_isnan(w[i]) ? 0 : w[i];
                 }
                 
-                for( iter = particles.begin(); iter != particles.end(); ++iter ){
-                    estimationLikelihood += grt_isnan(iter->w) ? 0 : iter->w;
+                for(unsigned int j=0; j<N; j++){
+                    x[j] /= sum;
                 }
                 estimationLikelihood /= Float(numParticles);
                 break;
             case ROBUST_MEAN:
-                //Reset x
-                for(unsigned int j=0; j<N; j++){
-                    x[j] = 0;
-                }
-                sum = 0;
-                
                 //Find the particle with the best weight
                 for(unsigned int i=0; i<numParticles; i++){
-                    if( particles[i].w > bestWeight ){
-                        bestWeight = particles[i].w;
+                    if( w[i] > bestWeight ){
+                        bestWeight = w[i];
                         bestIndex = i;
                     }
                 }
                 
                 //Use all the particles within a given distance of that weight
-                for( iter = particles.begin(); iter != particles.end(); ++iter ){
-                    if( fabs( iter->w - particles[bestIndex].w ) <= robustMeanWeightDistance ){
+                for(unsigned int i=0; i<numParticles; i++){
+                    if( fabs( w[i] - w[bestIndex] ) <= robustMeanWeightDistance ){
+                        const Float *p = particles[i].x.getData();
                         for(unsigned int j=0; j<N; j++){
-                            x[j] += iter->x[j] * iter->w;
+                            x[j] += p[j] * w[i];
                         }
-                        estimationLikelihood += grt_isnan(iter->w) ? 0 : iter->w;
-                        sum += iter->w;
+                        estimationLikelihood += grt_isnan(w[i]) ? 0 : w[i];
+                        sum += w[i];
                         robustMeanParticleCounter++;
                     }
                 }
@@ -709,13 +774,13 @@ protected:
                 break;
             case BEST_PARTICLE:
                 for(unsigned int i=0; i<numParticles; i++){
-                    if( particles[i].w > bestWeight ){
-                        bestWeight = particles[i].w;
+                    if( w[i] > bestWeight ){
+                        bestWeight = w[i];
                         bestIndex = i;
                     }
                 }
                 x = particles[bestIndex].x;
-                estimationLikelihood = grt_isnan(particles[bestIndex].w) ? 0 : particles[bestIndex].w;
+                estimationLikelihood = grt_isnan(w[bestIndex]) ? 0 : w[bestIndex];
                 break;
             default:
                 errorLog << "ERROR: Unknown estimation mode!" << std::endl;
@@ -736,95 +801,129 @@ protected:
     }
     
     /**
-     The main resample function. Resamples the particles based on the particles weights.
+     The main resample function. Resamples the particles based on the particles weights, using low-variance systematic
+     resampling: a single random offset is drawn and the particles are selected at evenly spaced positions along the
+     cumulative weight distribution, which runs in O(N). A small proportion of the particles are randomly reinitialized
+     from the init model so the filter can recover if it locks onto the wrong state.
      This is a virtual function, so you can override it in your derived class if needed.
      
      @return returns true if the particles were correctly resampled, false otherwise
      */
     virtual bool resample(){
         
-        Vector< PARTICLE > *tempParticles = NULL;
+        //The resampled particles are written to the inactive distribution, which is then swapped with the active one
+        Vector< PARTICLE > &tempParticles = particleDistributionB;
+        const unsigned int N = (unsigned int)particles.size();
+        if( N == 0 ) return true;
         
-        //If the particles are currently reference the first particle distribution, then set the tempParticles to the second distribution
-        if( &particles == &particleDistributionA ) tempParticles = &particleDistributionB;
-        else tempParticles = &particleDistributionA;
-        
-        //Select any weight that is above the minimum weight threshold
-        Vector< IndexedDouble > weights;
-        weights.reserve(numParticles);
-        for(unsigned int i=0; i<numParticles; i++){
-            if( particles[i].w >= minimumWeightThreshold ){
-                weights.push_back( IndexedDouble(i,particles[i].w) );
+        //Compute the cumulative sum, ignoring any weight below the minimum weight threshold
+        Float total = 0;
+        for(unsigned int i=0; i<N; i++){
+            if( weights[i] >= minimumWeightThreshold ){
+                total += weights[i];
             }
+            cumsum[i] = total;
         }
         
-        //Sort the weights
-        sort(weights.begin(),weights.end(),IndexedDouble::sortIndexedDoubleByValueAscending);
-        const unsigned int numWeights = (unsigned int)weights.size();
-        unsigned int randIndex = 0;
-        
         //If there are no valid weights then we just pick N random particles
-        if( numWeights == 0 ){
-            for(unsigned int n=0; n<numParticles; n++){
-                (*tempParticles)[n] = particles[ rand.getRandomNumberInt(0, numParticles) ];
+        if( total == 0 ){
+            for(unsigned int n=0; n<N; n++){
+                tempParticles[n] = particles[ rand.getRandomNumberInt(0, N) ];
             }
-            if( &particles == &particleDistributionA ) particles = particleDistributionB;
-            else particles = particleDistributionA;
+            swapParticleDistributions();
             return true;
         }
         
-        //Compute the cumulative sum
-        cumsum[0] = weights[0].value;
-        for(unsigned int i=1; i<numWeights; i++){
-            cumsum[i] = cumsum[i-1] + weights[i].value;
-        }
-        
         //Resample the weights
-        const unsigned int numRandomParticles = (unsigned int) round(numParticles/100.0*10.0);
-        for(unsigned int n=0; n<numParticles; n++){
-            
-            if( numParticles-n > numParticles-numRandomParticles){
-            
-                //Pick a random number between 0 and the max cumsum
-                Float randValue = rand.getRandomNumberUniform(0,cumsum[numWeights-1]);
-                randIndex = 0;
+        const unsigned int numRandomParticles = (unsigned int) round(N/100.0*10.0);
+        const unsigned int numResampledParticles = N - numRandomParticles;
+        if( numResampledParticles > 0 ){
+            const Float step = total / Float(numResampledParticles);
+            Float u = rand.getRandomNumberUniform(0,step);
+            unsigned int i = 0;
+            for(unsigned int n=0; n<numResampledParticles; n++){
                 
-                //Find which bin the rand value falls into, set the random index to this value
-                for(unsigned int i=0; i<numWeights; i++){
-                    if( randValue <= cumsum[i] ){
-                        randIndex = i;
+                //Move to the bin the current position falls into, the positions are increasing so this is a single pass over the cumsum
+                while( i < N-1 && cumsum[i] < u ) i++;
+                
+                tempParticles[n] = particles[i];
+                u += step;
+            }
+        }
+        
+        //Randomly initalize the remaining particles
+        for(unsigned int n=numResampledParticles; n<N; n++){
+            PARTICLE &p = tempParticles[n];
+            for(unsigned int j=0; j<stateVectorSize; j++){
+                switch( initMode ){
+                    case INIT_MODE_UNIFORM:
+                        p.x[j] = rand.getRandomNumberUniform(initModel[j][0],initModel[j][1]);
+                        break;
+                    case INIT_MODE_GAUSSIAN:
+                        p.x[j] = initModel[j][0] + rand.getRandomNumberGauss(0,initModel[j][1]);
+                        break;
+                    default:
+                        errorLog << "ERROR: Unknown initMode!" << std::endl;
+                        return false;
                         break;
-                    }
                 }
                 
-                (*tempParticles)[n] = particles[ weights[randIndex].index ];
-            }else{
-                //Randomly initalize the weakest particles
-                PARTICLE &p = (*tempParticles)[n];
-                for(unsigned int j=0; j<stateVectorSize; j++){
-                    switch( initMode ){
-                        case INIT_MODE_UNIFORM:
-                            p.x[j] = rand.getRandomNumberUniform(initModel[j][0],initModel[j][1]);
-                            break;
-                        case INIT_MODE_GAUSSIAN:
-                            p.x[j] = initModel[j][0] + rand.getRandomNumberGauss(0,initModel[j][1]);
-                            break;
-                        default:
-                            errorLog << "ERROR: Unknown initMode!" << std::endl;
-                            return false;
-                            break;
-                    }
-                    
-                }
             }
         }
         
-        //Swap the particle references
-        if( &particles == &particleDistributionA ) particles = particleDistributionB;
-        else particles = particleDistributionA;
+        swapParticleDistributions();
+        
+        return true;
+    }
+    
+    /**
+     Runs the update step over all the particles and gathers the particle weights into the contiguous weights Vector.
+     If parallel updates are enabled, the particles are split into contiguous blocks which are updated on the thread pool.
+     
+     @param SENSOR_DATA &data: the current sensor data
+     @return returns true if all the particles were updated successfully, false otherwise
+     */
+    bool updateParticles( SENSOR_DATA &data ){
+        
+        const unsigned int N = (unsigned int)particles.size();
+        if( weights.getSize() != N ) weights.resize( N, 0 );
         
+        //Only split the update if each thread will get a reasonable amount of work
+        const unsigned int minBlockSize = 2048;
+        return ThreadPool::parallelFor( 0, N, minBlockSize, [this,&data](const unsigned int begin,const unsigned int end){
+            return this->updateBlock( data, begin, end );
+        }, parallelUpdate ? 0 : 1 );
+    }
+    
+    /**
+     Updates the particles in the range [begin end) and copies their weights into the weights Vector.
+     
+     @param SENSOR_DATA &data: the current sensor data
+     @param const unsigned int begin: the index of the first particle that should be updated
+     @param const unsigned int end: one past the index of the last particle that should be updated
+     @return returns true if the particles were updated successfully, false otherwise
+     */
+    bool updateBlock( SENSOR_DATA &data, const unsigned int begin, const unsigned int end ){
+        if( !updateBatch( data, begin, end ) ){
+            return false;
+        }
+        for(unsigned int i=begin; i<end; i++){
+            weights[i] = particles[i].w;
+        }
         return true;
     }
+    
+    /**
+     Swaps the active and inactive particle distributions (the storage is exchanged, the particles are not copied)
+     and gathers the weights of the new active particles into the weights Vector.
+     */
+    void swapParticleDistributions(){
+        particleDistributionA.swap( particleDistributionB );
+        const unsigned int N = (unsigned int)particles.size();
+        for(unsigned int i=0; i<N; i++){
+            weights[i] = particles[i].w;
+        }
+    }
 
     /**
       	This function lets you define a custom pre filter update if needed.
@@ -902,6 +1001,7 @@ protected:
     bool initialized;                               ///<A flag that indicates if the filter has been initialized
     bool verbose;                                   ///<A flag that indicates if warning and info messages should be printed
     bool normWeights;                               ///<A flag that indicates if the weights should be normalized at each filter iteration
+    bool parallelUpdate;                            ///<A flag that indicates if the particle update step should be split across the thread pool
     unsigned int numParticles;                      ///<The number of particles in the filter
     unsigned int stateVectorSize;                   ///<The size of the state Vector (x)
     unsigned int initMode;                          ///<The mode used to initialize the particles, this should be one of the InitModes enums.
@@ -917,9 +1017,10 @@ protected:
     Vector< VectorFloat > initModel;           ///<The noise model for the initial starting guess
     VectorFloat processNoise;                      ///<The noise covariance in the system
     VectorFloat measurementNoise;                  ///<The noise covariance in the measurement
-    Vector< PARTICLE > &particles;              ///<A reference to the current active particle Vector
-    Vector< PARTICLE > particleDistributionA;   ///<A Vector of particles, this will either hold the particles before or after a resample
-    Vector< PARTICLE > particleDistributionB;   ///<A Vector of particles, this will either hold the particles before or after a resample
+    Vector< PARTICLE > &particles;              ///<A reference to the current active particle Vector (this always refers to particleDistributionA)
+    Vector< PARTICLE > particleDistributionA;   ///<A Vector holding the active particles
+    Vector< PARTICLE > particleDistributionB;   ///<A Vector holding the particles before the last resample, this is also used as the resampling buffer
+    VectorFloat weights;                           ///<The weight of each particle, stored contiguously so the normalization, estimation and resampling passes do not touch the particle states
     VectorFloat cumsum;                            ///<The cumulative sum Vector used for resampling the particles
     Random rand;                                    ///<A random number generator
     WarningLog warningLog;
@@ -35,12 +35,26 @@
 #include "../../Util/GRTCommon.h"
 #include "PSOParticle.h"
 
+#include <functional>
+
 GRT_BEGIN_NAMESPACE
 
+/**
+ By default the swarm is searched by calling the propagate, evaluate, update and reset functions of each particle, so a custom
+ PARTICLE_TYPE can override any of them (and can set its own w, c1 and c2 weights).
+
+ The swarm can also be stored in contiguous MatrixFloat buffers (one row per particle) by calling setUseSwarmMatrix(true) before
+ init. In that mode the position, velocity and local best position of every particle are updated by the PSO algorithm itself,
+ using the w, c1 and c2 weights of the PSO algorithm, and the PARTICLE_TYPE is only used to evaluate each particle (its x state
+ Vector is set to the particle's current position before it is evaluated). A batch evaluation function can also be set with
+ setBatchEvaluationFunction, which is given the position matrix of the whole swarm and must return the cost of every particle.
+ */
 template<class PARTICLE_TYPE,class OBSERVATION_TYPE>
 class ParticleSwarmOptimization{
     
 public:
+    typedef std::function< bool(const MatrixFloat &positions,OBSERVATION_TYPE &observation,VectorFloat &costs) > BatchEvaluationFunction;
+
     /**
      Default Constructor.
      */
@@ -49,6 +63,15 @@ public:
         minImprovement = 1.0e-10;
         maxIter = 500;
         maxNumIterNoChange = 10;
+        numParticles = 0;
+        K = 0;
+        w = 1.0;
+        c1 = 2.0;
+        c2 = 2.0;
+        randomSeed = 0;
+        parallelSearch = false;
+        storeHistory = true;
+        useSwarmMatrix = false;
     }
     
     /**
@@ -61,6 +84,8 @@ public:
     
     /**
      Provides direct access to the i'th particle. It is up to the user to ensure that i is within the range [0 numParticles-1].
+     If the swarm matrix is used, the x state Vector of the particle is set to the position the particle had when it was last
+     evaluated, use getPosition to get the current position of a particle.
      
      @param index: the index of the particle you want to access
      @return returns a reference to the i'th particle
@@ -91,6 +116,7 @@ public:
         
         if( K != xMin.size() || K != xMax.size() ) return false;
         
+        this->numParticles = numParticles;
         this->K = K;
         this->xMin = xMin;
         this->xMax = xMax;
@@ -99,28 +125,49 @@ public:
         //Clear any previous searches
         particles.clear();
         iterHistory.clear();
+        positionHistory.clear();
         globalBestXHistory.clear();
         
         //Reset the global variables
         globalBestCost = 0;
         globalBestX.clear();
         globalBestX.resize(K,0);
+        costs.resize( numParticles );
         
+        //Allocate the swarm matrix if needed, each particle has its own random stream so the updates can be run in parallel and
+        //still give the same result for a fixed seed
+        if( useSwarmMatrix ){
+            positions.resize( numParticles, K );
+            velocities.resize( numParticles, K );
+            localBestPositions.resize( numParticles, K );
+            particleMin.resize( numParticles, K );
+            particleMax.resize( numParticles, K );
+            localBestCosts.resize( numParticles );
+            randoms.resize( numParticles );
+        }else{
+            positions.clear();
+            velocities.clear();
+            localBestPositions.clear();
+            particleMin.clear();
+            particleMax.clear();
+            localBestCosts.clear();
+            randoms.clear();
+        }
+
         //Initialize the new particles with random positions and velocities
-        Random random;
+        Random random( randomSeed );
         particles.resize(numParticles);
-        typename Vector< PARTICLE_TYPE >::iterator pIter = particles.begin();
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            pIter->setRandomSeed( random.getRandomNumberInt(0, 100000) );
-            pIter->init(K,xMin,xMax);
+        for(unsigned int i=0; i<numParticles; i++){
+            if( useSwarmMatrix ) randoms[i].setSeed( (unsigned long long)random.getRandomNumberInt(1, 100000000) );
+            particles[i].setRandomSeed( (unsigned long long)random.getRandomNumberInt(1, 100000000) );
+            particles[i].init(K,xMin,xMax);
         }
         
-        //Store the initial distrubution
-        iterHistory.push_back( particles );
-        globalBestXHistory.push_back( globalBestX );
-        
-        //Flag that everything has been initialized
         initialized = true;
+        if( useSwarmMatrix ) reset();
+
+        //Store the initial distrubution
+        storeIteration();
         
         return true;
     }
@@ -134,9 +181,27 @@ public:
         
         if( !initialized ) return false;
         
-        typename Vector< PARTICLE_TYPE >::iterator pIter = particles.begin();
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            pIter->reset();
+        if( !useSwarmMatrix ){
+            for(unsigned int i=0; i<numParticles; i++){
+                if( !particles[i].reset() ) return false;
+            }
+            return true;
+        }
+        
+        for(unsigned int i=0; i<numParticles; i++){
+            Random &random = randoms[i];
+            Float *x = positions[i];
+            Float *v = velocities[i];
+            for(unsigned int k=0; k<K; k++){
+                x[k] = random.getRandomNumberUniform(xMin[k],xMax[k]);
+                v[k] = random.getRandomNumberUniform(-1.0,1);
+            }
+
+            //Set the local best state Vector to the current x state Vector
+            std::copy( x, x+K, localBestPositions[i] );
+            std::copy( xMin.begin(), xMin.end(), particleMin[i] );
+            std::copy( xMax.begin(), xMax.end(), particleMax[i] );
+            localBestCosts[i] = 0;
         }
         
         return true;
@@ -152,13 +217,15 @@ public:
         
         if( !initialized ) return false;
 
+        if( batchEvaluationFunction && !useSwarmMatrix ){
+            errorLog << "search(...) - A batch evaluation function can only be used with the swarm matrix, call setUseSwarmMatrix(true) before init!" << std::endl;
+            return false;
+        }
+
         //Propagate all the particles
-        typename Vector< PARTICLE_TYPE >::iterator pIter;
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            if( !pIter->propagate( propagationModel ) ){
-                errorLog << "search(...) - Particle propagation failed!" << std::endl;
-                return false;
-            }
+        if( !propagateSwarm() ){
+            errorLog << "search(...) - Particle propagation failed!" << std::endl;
+            return false;
         }
         
         unsigned int iterCounter = 0;
@@ -174,8 +241,7 @@ public:
         while( keepSearching ){
             currentMaxima = searchIteration( observation );
             
-            iterHistory.push_back( particles );
-            globalBestXHistory.push_back( globalBestX );
+            storeIteration();
             
             delta = fabs( currentMaxima - lastMaxima );
             lastMaxima = currentMaxima;
@@ -210,36 +276,43 @@ public:
         
         if( !initialized ) return 0;
         
-        unsigned int index = 0;
         unsigned int bestIndex = 0;
         Float currentBestMaxima = 0;
-        Float epsilon = 0;
-        typename Vector< PARTICLE_TYPE >::iterator pIter;
         
-        //Compute the cost for each particle, tracking the best cost of all the particles in the swarm
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
+        //Compute the cost for each particle
+        if( !evaluateSwarm( observation ) ){
+            errorLog << "searchIteration(...) - Failed to evaluate the swarm!" << std::endl;
+            return 0;
+        }
             
-            //Evaluate the current particle
-            epsilon = pIter->evaluate(observation);
+        //Track the best cost of all the particles in the swarm, and the local best of each particle (particles that are not
+        //stored in the swarm matrix track their own local best when they are evaluated)
+        for(unsigned int i=0; i<numParticles; i++){
+            const Float epsilon = costs[i];
+
+            //Check to see if we have found a local maxima, if so store the values of x that achieved it
+            if( useSwarmMatrix && epsilon > localBestCosts[i] ){
+                localBestCosts[i] = epsilon;
+                std::copy( positions[i], positions[i]+K, localBestPositions[i] );
+            }
 
             //Check to see if this is the best
-            if( epsilon >  currentBestMaxima ){
+            if( epsilon > currentBestMaxima ){
                 currentBestMaxima = epsilon;
-                bestIndex = index;
+                bestIndex = i;
             }
-            
-            index++;
         }
         
         //Check to see if we need to update the global cost and position
         if( currentBestMaxima > globalBestCost ){
             globalBestCost = currentBestMaxima;
-            globalBestX = particles[ bestIndex ].x;
+            if( useSwarmMatrix ) std::copy( positions[bestIndex], positions[bestIndex]+K, globalBestX.begin() );
+            else globalBestX = particles[ bestIndex ].x;
         }
 
         //Update the position and velocity of all of the particles
-        for(pIter = particles.begin(); pIter != particles.end(); pIter++){
-            pIter->update( globalBestX );
+        if( !updateSwarm() ){
+            errorLog << "searchIteration(...) - Failed to update the swarm!" << std::endl;
         }
         
         return currentBestMaxima;
@@ -260,20 +333,273 @@ public:
         return true;
     }
 
+    /**
+     Sets the seed used to initialize the particles. If the seed is zero then the particles will be seeded using the current
+     system time. For a fixed (non-zero) seed, the search will give the same result whether or not the search is run in parallel.
+     This should be set before the init function is called.
+
+     @param randomSeed: the new seed
+     @return returns true if the seed was updated
+     */
+    bool setRandomSeed( const unsigned long long randomSeed ){
+        this->randomSeed = randomSeed;
+        return true;
+    }
+
+    /**
+     Sets if the particles should be evaluated and updated in parallel using the thread pool. If enabled, the evaluate and update
+     functions of different particles will be called concurrently with the same observation, so they must not modify any state
+     that is shared between particles. Parallel search is disabled by default, and is only used when GRT_CXX11_ENABLED is defined.
+
+     @param parallelSearch: the new parallelSearch mode
+     @return returns true if the mode was updated
+     */
+    bool setParallelSearch( const bool parallelSearch ){
+        this->parallelSearch = parallelSearch;
+        return true;
+    }
+
+    /**
+     Sets if the state of the swarm should be stored in contiguous matrices that are updated by the PSO algorithm itself, see the
+     class description for more info. This is disabled by default. Changing this mode clears the swarm, so init must be called
+     again before the next search.
+
+     @param useSwarmMatrix: the new useSwarmMatrix mode
+     @return returns true if the mode was updated
+     */
+    bool setUseSwarmMatrix( const bool useSwarmMatrix ){
+        if( this->useSwarmMatrix != useSwarmMatrix ) initialized = false;
+        this->useSwarmMatrix = useSwarmMatrix;
+        return true;
+    }
+
+    bool getUseSwarmMatrix() const{ return useSwarmMatrix; }
+
+    bool getParallelSearch() const{ return parallelSearch; }
+
+    /**
+     Sets if the state of every particle should be stored at each iteration of the search. The particles are stored in iterHistory,
+     or the position matrix of the swarm is stored in positionHistory if the swarm matrix is used.
+
+     @param storeHistory: the new storeHistory mode
+     @return returns true if the mode was updated
+     */
+    bool setStoreHistory( const bool storeHistory ){
+        this->storeHistory = storeHistory;
+        return true;
+    }
+
+    /**
+     Sets a function that evaluates all the particles at once. The function is given the position matrix of the swarm, where
+     each row is the position of one particle, and must set the cost of every particle (a higher cost is better). If a batch
+     evaluation function is set then the evaluate function of each particle will not be used. The batch evaluation function can
+     only be used with the swarm matrix (see setUseSwarmMatrix), the search will fail if one is set otherwise. Pass nullptr to remove it.
+
+     @param batchEvaluationFunction: the new batch evaluation function
+     @return returns true if the function was updated
+     */
+    bool setBatchEvaluationFunction( BatchEvaluationFunction batchEvaluationFunction ){
+        this->batchEvaluationFunction = batchEvaluationFunction;
+        return true;
+    }
+
+    /**
+     Gets the current position of the i'th particle. It is up to the user to ensure that i is within the range [0 numParticles-1].
+
+     @param index: the index of the particle
+     @return returns the position of the particle
+     */
+    VectorFloat getPosition( const unsigned int index ) const{
+        if( !useSwarmMatrix ) return particles[ index ].x;
+        return positions.getRow( index );
+    }
+
+    //The following matrices are only set if the swarm matrix is used
+    const MatrixFloat& getPositions() const{ return positions; }
+
+    const MatrixFloat& getVelocities() const{ return velocities; }
+
+    const MatrixFloat& getLocalBestPositions() const{ return localBestPositions; }
+
+    const VectorFloat& getCosts() const{ return costs; }
+
+protected:
+    /**
+     Propagates each particle using the propagation model, the default model adds Gaussian noise to each dimension.
+
+     @return returns true if the particles were propagated, false otherwise
+     */
+    virtual bool propagateSwarm(){
+
+        if( !useSwarmMatrix ){
+            for(unsigned int i=0; i<numParticles; i++){
+                if( !particles[i].propagate( propagationModel ) ) return false;
+            }
+            return true;
+        }
+
+        if( propagationModel.getSize() != K ) return false;
+
+        for(unsigned int i=0; i<numParticles; i++){
+            Random &random = randoms[i];
+            Float *x = positions[i];
+
+            //Update the current position
+            for(unsigned int k=0; k<K; k++){
+                x[k] += random.getRandomNumberGauss(0,propagationModel[k]);
+            }
+
+            //Decrease the local best cost
+            localBestCosts[i] *= 0.9;
+        }
+
+        return true;
+    }
+
+    /**
+     Computes the cost of each particle, either using the batch evaluation function or the evaluate function of each particle.
+
+     @param observation: a reference to the observation data used for the search
+     @return returns true if the particles were evaluated, false otherwise
+     */
+    virtual bool evaluateSwarm(OBSERVATION_TYPE &observation){
+
+        if( batchEvaluationFunction ){
+            if( !useSwarmMatrix ){
+                errorLog << "evaluateSwarm(...) - A batch evaluation function can only be used with the swarm matrix!" << std::endl;
+                return false;
+            }
+            if( !batchEvaluationFunction( positions, observation, costs ) ) return false;
+            if( costs.getSize() != numParticles ){
+                errorLog << "evaluateSwarm(...) - The batch evaluation function returned " << costs.getSize() << " costs, expected " << numParticles << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        return runBlocks( [this,&observation](const unsigned int begin,const unsigned int end){ return this->evaluateBlock( observation, begin, end ); }, 16 );
+    }
+
+    /**
+     Evaluates the particles in the range [begin end) using the evaluate function of each particle.
+     */
+    bool evaluateBlock(OBSERVATION_TYPE &observation,const unsigned int begin,const unsigned int end){
+        for(unsigned int i=begin; i<end; i++){
+            if( useSwarmMatrix ) std::copy( positions[i], positions[i]+K, particles[i].x.begin() );
+            costs[i] = particles[i].evaluate( observation );
+        }
+        return true;
+    }
+
+    /**
+     Updates the velocity and position of each particle, using the local best position of each particle and the global best position.
+
+     @return returns true if the particles were updated, false otherwise
+     */
+    virtual bool updateSwarm(){
+
+        //The update is cheap, so only split it if each block has a reasonable number of elements to update
+        return runBlocks( [this](const unsigned int begin,const unsigned int end){ return this->updateBlock( begin, end ); }, grt_max( (unsigned int)(65536 / grt_max(K,(unsigned int)1)), (unsigned int)1 ) );
+    }
+
+    /**
+     Updates the particles in the range [begin end).
+     */
+    bool updateBlock(const unsigned int begin,const unsigned int end){
+
+        if( !useSwarmMatrix ){
+            bool ok = true;
+            for(unsigned int i=begin; i<end; i++){
+                if( !particles[i].update( globalBestX ) ) ok = false;
+            }
+            return ok;
+        }
+
+        const Float *g = &globalBestX[0];
+        for(unsigned int i=begin; i<end; i++){
+            Random &random = randoms[i];
+            Float *x = positions[i];
+            Float *v = velocities[i];
+            const Float *l = localBestPositions[i];
+            Float *pMin = particleMin[i];
+            Float *pMax = particleMax[i];
+
+            for(unsigned int k=0; k<K; k++){
+                const Float r1 = random.getRandomNumberUniform(0.0,1.0);
+                const Float r2 = random.getRandomNumberUniform(0.0,1.0);
+
+                //Update the velocity
+                Float vk = ( w * v[k] ) + ( c1 * r1 * (l[k]-x[k]) ) + ( c2 * r2 * (g[k]-x[k]) );
+
+                //Velocity Clamping
+                const Float vMax = 0.1 * ((pMax[k]-pMin[k])/2.0);
+                if( vk > vMax ){ vk = vMax; }
+                else if( vk < -vMax ){ vk = -vMax; }
+                v[k] = vk;
+
+                //Position Update
+                x[k] += vk;
+
+                //Update the xMax xMin values
+                if( x[k] > pMax[k] ){ pMax[k] = x[k]; }
+                else if( x[k] < pMin[k] ){ pMin[k] = x[k]; }
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     Stores the current state of the swarm and the global best state Vector, if the history is being stored.
+     */
+    void storeIteration(){
+        if( !storeHistory ) return;
+        if( useSwarmMatrix ) positionHistory.push_back( positions );
+        else iterHistory.push_back( particles );
+        globalBestXHistory.push_back( globalBestX );
+    }
+
+    /**
+     Splits the particles into contiguous blocks and runs the function on each block, using the thread pool if parallel search
+     is enabled and each block has at least minBlockSize particles.
+     */
+    bool runBlocks( const std::function< bool(const unsigned int,const unsigned int) > &func, const unsigned int minBlockSize ){
+        return ThreadPool::parallelFor( 0, numParticles, minBlockSize, func, parallelSearch ? 0 : 1 );
+    }
+
+public:
     bool initialized;   ///< A flag to indicate if the PSO algorithm has been initialized
+    bool parallelSearch;   ///< A flag that indicates if the particles should be evaluated and updated using the thread pool
+    bool storeHistory;   ///< A flag that indicates if the search history should be stored
+    bool useSwarmMatrix;   ///< A flag that indicates if the state of the swarm is stored in the matrices below and updated by the PSO algorithm
+    unsigned int numParticles;   ///< The number of particles in the swarm
     unsigned int K;     ///< The size of the particles state Vector
     Float minImprovement;
     unsigned int maxIter;
     unsigned int maxNumIterNoChange;
+    unsigned long long randomSeed;   ///< The seed used to initialize the particles, zero uses the system time
+    Float w;   ///< The inertia weight used for the velocity update of the swarm matrix
+    Float c1;   ///< The weight of the local best position used for the velocity update of the swarm matrix
+    Float c2;   ///< The weight of the global best position used for the velocity update of the swarm matrix
     Float globalBestCost;  ///< The current global best cost over all the particles
     VectorFloat finalX;  ///< The final estimate
     VectorFloat globalBestX;   ///< The state Vector of the particle with the best cost
     VectorFloat xMin;  ///< The minimum range of the state space
     VectorFloat xMax;  ///< The maximum range of the state space
     VectorFloat propagationModel;  ///<The propagation model used to update each particle
+    MatrixFloat positions;   ///< The position of each particle, one row per particle
+    MatrixFloat velocities;   ///< The velocity of each particle, one row per particle
+    MatrixFloat localBestPositions;   ///< The position that achieved the local best cost of each particle, one row per particle
+    MatrixFloat particleMin;   ///< The minimum range of each particle, this grows if the particle leaves the initial range
+    MatrixFloat particleMax;   ///< The maximum range of each particle, this grows if the particle leaves the initial range
+    VectorFloat localBestCosts;   ///< The local best cost of each particle
+    VectorFloat costs;   ///< The cost of each particle at the last evaluation
+    Vector< Random > randoms;   ///< The random number generator of each particle
     Vector< PARTICLE_TYPE > particles;  ///< A Vector containing all the particles used for the search
     Vector< VectorFloat > globalBestXHistory;  ///< A buffer to keep track of the search history
     Vector< Vector< PARTICLE_TYPE > > iterHistory;  ///< A buffer to keep track of the search history
+    Vector< MatrixFloat > positionHistory;  ///< A buffer to keep track of the search history if the swarm matrix is used, each element is the position matrix of the swarm at one iteration
+    BatchEvaluationFunction batchEvaluationFunction;   ///< An optional function used to evaluate all the particles at once
     
     InfoLog infoLog;
     ErrorLog errorLog;
@@ -28,9 +28,31 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 GRT_BEGIN_NAMESPACE
 
+//Orthonormalizes the columns of the matrix in place using modified Gram-Schmidt, any (near) linearly dependent columns are set to zero
+static void orthonormalizeColumns(MatrixFloat &a){
+    const UINT M = a.getNumRows();
+    const UINT N = a.getNumCols();
+    for(UINT j=0; j<N; j++){
+        for(UINT k=0; k<j; k++){
+            Float dot = 0;
+            for(UINT i=0; i<M; i++) dot += a[i][j] * a[i][k];
+            for(UINT i=0; i<M; i++) a[i][j] -= dot * a[i][k];
+        }
+        Float norm = 0;
+        for(UINT i=0; i<M; i++) norm += a[i][j] * a[i][j];
+        norm = sqrt( norm );
+        const Float scale = norm > 1.0e-12 ? 1.0/norm : 0;
+        for(UINT i=0; i<M; i++) a[i][j] *= scale;
+    }
+}
+
 PrincipalComponentAnalysis::PrincipalComponentAnalysis(){
     trained = false;
     normData = false;
+    useRandomizedSolver = false;
+    numOversamples = 10;
+    numPowerIterations = 2;
+    numTrainingSamples = 0;
     numInputDimensions = 0;
     numPrincipalComponents = 0;
     maxVariance = 0;
@@ -44,7 +66,7 @@ PrincipalComponentAnalysis::~PrincipalComponentAnalysis(){
     
 }
 
-bool PrincipalComponentAnalysis::computeFeatureVector(const MatrixFloat &data,double maxVariance,bool normData){
+bool PrincipalComponentAnalysis::computeFeatureVector(const MatrixFloat &data,Float maxVariance,bool normData){
     trained = false;
     this->maxVariance = maxVariance;
     this->normData = normData;
@@ -69,6 +91,9 @@ bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixFloat &data,c
     const UINT M = data.getNumRows();
     const UINT N = data.getNumCols();
     this->numInputDimensions = N;
+    this->numTrainingSamples = M;
+    singularValues.clear();
+    sumSquaredDeviations.clear();
     
     MatrixFloat msData( M, N );
     
@@ -89,8 +114,22 @@ bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixFloat &data,c
         msData[i][j] = data[i][j] - mean[j];
     }
     
-    //Get the covariance matrix
-    MatrixFloat cov = msData.getCovarianceMatrix();
+    //If only the top few components are needed, then these can be found without building the full covariance matrix
+    if( analysisMode == MAX_NUM_PCS && useRandomizedSolver ){
+        return computeRandomizedFeatureVector( msData );
+    }
+    
+    if( useRandomizedSolver ){
+        warningLog << "computeFeatureVector(const MatrixFloat &data,UINT analysisMode) - The randomized solver needs a fixed number of principal components, the full solver will be used!" << std::endl;
+    }
+    
+    //Get the covariance matrix, the data is already mean subtracted so this is just (msData' * msData) / (M-1)
+    MatrixFloat cov;
+    cov.multiple( msData, msData, true );
+    const Float norm = 1.0 / Float( grt_max(M,2u) - 1 );
+    for(UINT i=0; i<N; i++)
+    for(UINT j=0; j<N; j++)
+    cov[i][j] *= norm;
     
     //Use Eigen Value Decomposition to find eigenvectors of the covariance matrix
     EigenvalueDecomposition eig;
@@ -176,6 +215,254 @@ bool PrincipalComponentAnalysis::computeFeatureVector_(const MatrixFloat &data,c
     return true;
 }
 
+bool PrincipalComponentAnalysis::computeRandomizedFeatureVector(const MatrixFloat &msData){
+    
+    const UINT M = msData.getNumRows();
+    const UINT N = msData.getNumCols();
+    const UINT K = numPrincipalComponents;
+    const UINT L = grt_min( K + numOversamples, grt_min(M,N) );
+    
+    if( K == 0 || L == 0 ){
+        errorLog << "computeRandomizedFeatureVector(const MatrixFloat &msData) - The number of principal components and samples must be greater than 0!" << std::endl;
+        return false;
+    }
+    
+    //Sample the range of the data with a random Gaussian matrix
+    Random random;
+    MatrixFloat omega(N,L);
+    for(UINT i=0; i<N; i++)
+    for(UINT j=0; j<L; j++)
+    omega[i][j] = random.getRandomNumberGauss();
+    
+    MatrixFloat y, z;
+    y.multiple( msData, omega );
+    
+    //Power iterations sharpen the range estimate when the eigenvalues decay slowly
+    for(UINT q=0; q<numPowerIterations; q++){
+        orthonormalizeColumns( y );
+        z.multiple( msData, y, true );
+        orthonormalizeColumns( z );
+        y.multiple( msData, z );
+    }
+    orthonormalizeColumns( y );
+    
+    //Project the data onto the [L N] subspace and decompose this small matrix
+    MatrixFloat b;
+    b.multiple( y, msData, true );
+    
+    MatrixFloat components;
+    VectorFloat values;
+    if( !computeTopComponents( b, K, components, values ) ){
+        clear();
+        errorLog << "computeRandomizedFeatureVector(const MatrixFloat &msData) - Failed to decompose the projected data!" << std::endl;
+        return false;
+    }
+    
+    //The total variance is the trace of the covariance matrix
+    Float totalVariance = 0;
+    for(UINT i=0; i<M; i++)
+    for(UINT j=0; j<N; j++)
+    totalVariance += msData[i][j] * msData[i][j];
+    totalVariance /= Float( grt_max(M,2u) - 1 );
+    
+    numPrincipalComponents = grt_min( K, values.getSize() );
+    setSortedComponents( components, values, totalVariance );
+    singularValues.clear();
+    
+    trained = true;
+    
+    return true;
+}
+
+bool PrincipalComponentAnalysis::updateFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents){
+    
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    const bool newModel = !trained || singularValues.getSize() == 0;
+    
+    if( M == 0 ){
+        errorLog << "updateFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents) - The input data is empty!" << std::endl;
+        return false;
+    }
+    
+    if( !newModel && N != numInputDimensions ){
+        errorLog << "updateFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents) - The number of columns in the data (" << N << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << std::endl;
+        return false;
+    }
+    
+    if( numPrincipalComponents == 0 || numPrincipalComponents > N ){
+        errorLog << "updateFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents) - The number of principal components (" << numPrincipalComponents << ") must be in the range [1 " << N << "]!" << std::endl;
+        return false;
+    }
+    
+    const VectorFloat batchMean = data.getMean();
+    VectorFloat batchSumSquaredDeviations(N,0);
+    for(UINT i=0; i<M; i++)
+    for(UINT j=0; j<N; j++)
+    batchSumSquaredDeviations[j] += grt_sqr( data[i][j] - batchMean[j] );
+    
+    //The new components are the top singular vectors of the old components (scaled by their singular values) stacked on top of
+    //the mean subtracted batch, plus one row that corrects for the shift between the old mean and the batch mean
+    MatrixFloat a;
+    if( newModel ){
+        a.resize( M, N );
+        for(UINT i=0; i<M; i++)
+        for(UINT j=0; j<N; j++)
+        a[i][j] = data[i][j] - batchMean[j];
+        
+        mean = batchMean;
+        sumSquaredDeviations = batchSumSquaredDeviations;
+        numTrainingSamples = M;
+    }else{
+        const UINT K = singularValues.getSize();
+        const Float n = numTrainingSamples;
+        const Float m = M;
+        const Float total = n + m;
+        
+        a.resize( K+M+1, N );
+        for(UINT k=0; k<K; k++)
+        for(UINT j=0; j<N; j++)
+        a[k][j] = singularValues[k] * eigenvectors[j][k];
+        
+        for(UINT i=0; i<M; i++)
+        for(UINT j=0; j<N; j++)
+        a[K+i][j] = data[i][j] - batchMean[j];
+        
+        const Float meanCorrection = sqrt( n*m/total );
+        for(UINT j=0; j<N; j++){
+            const Float delta = batchMean[j] - mean[j];
+            a[K+M][j] = meanCorrection * delta;
+            sumSquaredDeviations[j] += batchSumSquaredDeviations[j] + delta*delta*n*m/total;
+            mean[j] += delta*m/total;
+        }
+        numTrainingSamples += M;
+    }
+    
+    MatrixFloat components;
+    VectorFloat values;
+    if( !computeTopComponents( a, numPrincipalComponents, components, values ) ){
+        clear();
+        errorLog << "updateFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents) - Failed to decompose the batch data!" << std::endl;
+        return false;
+    }
+    
+    const Float norm = 1.0 / Float( grt_max(numTrainingSamples,2u) - 1 );
+    Float totalVariance = 0;
+    stdDev.resize( N );
+    for(UINT j=0; j<N; j++){
+        stdDev[j] = sqrt( sumSquaredDeviations[j] * norm );
+        totalVariance += sumSquaredDeviations[j] * norm;
+    }
+    
+    this->numInputDimensions = N;
+    this->numPrincipalComponents = grt_min( numPrincipalComponents, values.getSize() );
+    this->normData = false;
+    setSortedComponents( components, values, totalVariance );
+    singularValues = values;
+    
+    trained = true;
+    
+    return true;
+}
+
+bool PrincipalComponentAnalysis::computeTopComponents(const MatrixFloat &a,const UINT K,MatrixFloat &components,VectorFloat &values){
+    
+    const UINT R = a.getNumRows();
+    const UINT N = a.getNumCols();
+    
+    if( R == 0 || N == 0 ) return false;
+    
+    //The right singular vectors of a are found from the smaller of the two Gram matrices, a*a' [R R] or a'*a [N N]
+    const bool useRowGram = R <= N;
+    MatrixFloat gram;
+    if( useRowGram ){
+        gram.resize( R, R );
+        for(UINT i=0; i<R; i++){
+            const Float *ai = a[i];
+            for(UINT j=i; j<R; j++){
+                const Float *aj = a[j];
+                Float sum = 0;
+                for(UINT n=0; n<N; n++) sum += ai[n] * aj[n];
+                gram[i][j] = gram[j][i] = sum;
+            }
+        }
+    }else gram.multiple( a, a, true );
+    
+    EigenvalueDecomposition eig;
+    if( !eig.decompose( gram ) ) return false;
+    
+    const VectorFloat eigenvalues = eig.getRealEigenvalues();
+    const MatrixFloat eigenvectors = eig.getEigenvectors();
+    
+    Vector< IndexedDouble > sorted( eigenvalues.getSize() );
+    for(UINT i=0; i<eigenvalues.getSize(); i++) sorted[i] = IndexedDouble( i, eigenvalues[i] );
+    std::sort( sorted.begin(), sorted.end(), IndexedDouble::sortIndexedDoubleByValueDescending );
+    
+    const UINT numComponents = grt_min( K, sorted.getSize() );
+    components.resize( N, numComponents );
+    components.setAllValues( 0 );
+    values.resize( numComponents );
+    
+    for(UINT k=0; k<numComponents; k++){
+        const UINT index = sorted[k].index;
+        const Float s = sqrt( grt_max( sorted[k].value, 0.0 ) );
+        values[k] = s;
+        if( useRowGram ){
+            //v = a' * u / s
+            if( s <= 1.0e-12 ) continue;
+            for(UINT i=0; i<R; i++){
+                const Float w = eigenvectors[i][index] / s;
+                const Float *ai = a[i];
+                for(UINT n=0; n<N; n++) components[n][k] += ai[n] * w;
+            }
+        }else{
+            for(UINT n=0; n<N; n++) components[n][k] = eigenvectors[n][index];
+        }
+    }
+    
+    return true;
+}
+
+bool PrincipalComponentAnalysis::setSortedComponents(const MatrixFloat &components,const VectorFloat &values,const Float totalVariance){
+    
+    const UINT K = values.getSize();
+    const Float norm = 1.0 / Float( grt_max(numTrainingSamples,2u) - 1 );
+    
+    //The components are already sorted, so the sorted eigenvalues just hold the default index
+    eigenvectors = components;
+    eigenvalues.resize( K );
+    componentWeights.resize( K );
+    sortedEigenvalues.resize( K );
+    maxVariance = 0;
+    for(UINT k=0; k<K; k++){
+        eigenvalues[k] = values[k] * values[k] * norm;
+        componentWeights[k] = totalVariance > 0 ? eigenvalues[k] / totalVariance : 0;
+        sortedEigenvalues[k] = IndexedDouble( k, eigenvalues[k] );
+        if( k < numPrincipalComponents ) maxVariance += componentWeights[k];
+    }
+    
+    return true;
+}
+
+bool PrincipalComponentAnalysis::clear(){
+    
+    MLBase::clear();
+    
+    numPrincipalComponents = 0;
+    numTrainingSamples = 0;
+    maxVariance = 0;
+    mean.clear();
+    stdDev.clear();
+    componentWeights.clear();
+    eigenvalues.clear();
+    sortedEigenvalues.clear();
+    eigenvectors.clear();
+    singularValues.clear();
+    sumSquaredDeviations.clear();
+    
+    return true;
+}
+
 bool PrincipalComponentAnalysis::project(const MatrixFloat &data,MatrixFloat &prjData){
     
     if( !trained ){
@@ -189,7 +476,6 @@ bool PrincipalComponentAnalysis::project(const MatrixFloat &data,MatrixFloat &pr
     }
     
     MatrixFloat msData( data );
-    prjData.resize(data.getNumRows(),numPrincipalComponents);
     
     if( normData ){
         //Mean subtract the data
@@ -203,16 +489,13 @@ bool PrincipalComponentAnalysis::project(const MatrixFloat &data,MatrixFloat &pr
         msData[i][j] -= mean[j];
     }
     
-    //Projected Data
-    for(UINT row=0; row<msData.getNumRows(); row++){//For each row in the final data
-        for(UINT i=0; i<numPrincipalComponents; i++){//For each PC
-            prjData[row][i]=0;
-            for(UINT j=0; j<data.getNumCols(); j++)//For each feature
-            prjData[row][i] += msData[row][j] * eigenvectors[j][sortedEigenvalues[i].index];
-        }
-    }
+    //Gather the sorted principal components into a contiguous [N K] matrix, so all the rows can be projected with a single matrix product
+    MatrixFloat components(numInputDimensions,numPrincipalComponents);
+    for(UINT j=0; j<numInputDimensions; j++)
+    for(UINT i=0; i<numPrincipalComponents; i++)
+    components[j][i] = eigenvectors[j][sortedEigenvalues[i].index];
     
-    return true;
+    return prjData.multiple( msData, components );
 }
 
 bool PrincipalComponentAnalysis::project(const VectorFloat &data,VectorFloat &prjData){
@@ -276,22 +559,25 @@ bool PrincipalComponentAnalysis::save( std::fstream &file ) const {
         }
         file << std::endl;
         
+        //The randomized and incremental solvers only compute the top components, so any missing components are written as zero
         file << "ComponentWeights: ";
         for(unsigned int i=0; i<numInputDimensions; i++){
-            file << componentWeights[i] << " ";
+            file << (i < componentWeights.size() ? componentWeights[i] : 0) << " ";
         }
         file << std::endl;
         
         file << "Eigenvalues: ";
         for(unsigned int i=0; i<numInputDimensions; i++){
-            file << eigenvalues[i] << " ";
+            file << (i < eigenvalues.size() ? eigenvalues[i] : 0) << " ";
         }
         file << std::endl;
         
         file << "SortedEigenvalues: ";
         for(unsigned int i=0; i<numInputDimensions; i++){
-            file << sortedEigenvalues[i].index << " ";
-            file << sortedEigenvalues[i].value << " ";
+            if( i < sortedEigenvalues.size() ){
+                file << sortedEigenvalues[i].index << " ";
+                file << sortedEigenvalues[i].value << " ";
+            }else file << i << " " << 0 << " ";
         }
         file << std::endl;
         
@@ -452,6 +738,21 @@ bool PrincipalComponentAnalysis::print( std::string title ) const{
     return true;
 }
 
+bool PrincipalComponentAnalysis::enableRandomizedSolver(const bool useRandomizedSolver){
+    this->useRandomizedSolver = useRandomizedSolver;
+    return true;
+}
+
+bool PrincipalComponentAnalysis::setNumOversamples(const UINT numOversamples){
+    this->numOversamples = numOversamples;
+    return true;
+}
+
+bool PrincipalComponentAnalysis::setNumPowerIterations(const UINT numPowerIterations){
+    this->numPowerIterations = numPowerIterations;
+    return true;
+}
+
 MatrixFloat PrincipalComponentAnalysis::getEigenVectors() const{
     return eigenvectors;
 }
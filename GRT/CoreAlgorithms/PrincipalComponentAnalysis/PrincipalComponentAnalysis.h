@@ -88,6 +88,21 @@ public:
     */
     bool computeFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents,bool normData=false);
     
+    /**
+    Updates the principal components with a new batch of data, without needing any of the previous data. This can be used to run
+    incremental PCA over a stream of batches that would be too large to hold in memory at once. The first call (or the first call after
+    computeFeatureVector or clear) starts a new model, each following call merges the new batch into the existing components.
+    
+    Only the top numPrincipalComponents are tracked, so the component weights are computed relative to the total variance of all the
+    data seen so far. The data is mean subtracted but not z-normalized. The incremental state (the number of samples seen) is not saved
+    with the model.
+    
+    @param data: a matrix containing the next batch of data. This should be an [M N] matrix, where M==samples and N==dimensions, N must match any previous batches
+    @param numPrincipalComponents: sets the number of principal components to track. This must be a value be less than or equal to the number of dimensions in the input data
+    @return returns true if the principal components were updated, false otherwise
+    */
+    bool updateFeatureVector(const MatrixFloat &data,UINT numPrincipalComponents);
+    
     /**
     Projects the input data matrix onto the principal subspace. The new projected data will be stored in the prjData
     matrix. The computeFeatureVector function should have been called at least once before this function is called.
@@ -99,6 +114,13 @@ public:
     */
     bool project(const MatrixFloat &data,MatrixFloat &prjData);
     
+    /**
+    Clears the trained model and any incremental state.
+    
+    @return returns true if the model was cleared, false otherwise
+    */
+    virtual bool clear();
+    
     /**
     Projects the input data vector onto the principal subspace. The new projected data will be stored in the prjData vector.
     The computeFeatureVector function should have been called at least once before this function is called.
@@ -156,6 +178,30 @@ public:
     */
     Float getMaxVariance() const { return maxVariance; }
     
+    /**
+    Returns true if the randomized solver will be used when a fixed number of principal components is requested.
+    @return returns true if the randomized solver is enabled, false otherwise
+    */
+    bool getUseRandomizedSolver() const { return useRandomizedSolver; }
+    
+    /**
+    Returns the number of extra random samples used by the randomized solver.
+    @return returns the number of oversamples
+    */
+    UINT getNumOversamples() const { return numOversamples; }
+    
+    /**
+    Returns the number of power iterations used by the randomized solver.
+    @return returns the number of power iterations
+    */
+    UINT getNumPowerIterations() const { return numPowerIterations; }
+    
+    /**
+    Returns the number of samples that have been used to compute the current model.
+    @return returns the number of training samples
+    */
+    UINT getNumTrainingSamples() const { return numTrainingSamples; }
+    
     /**
     Returns the mean shift vector, computed during the computeFeatureVector function. New data will be subtracted
     by this value before it is projected onto the principal subspace.
@@ -196,6 +242,35 @@ public:
     MatrixFloat getEigenVectors() const;
     
     bool setModel( const VectorFloat &mean, const MatrixFloat &eigenvectors );
+    
+    /**
+    Sets if a randomized range finder should be used to compute the principal components when a fixed number of principal components
+    is requested. Rather than decomposing the full [N N] covariance matrix, the data is projected onto a small random subspace that
+    captures the top components, which is much faster and uses much less memory when the number of components is small compared with
+    the number of dimensions. The full solver is always used when the number of components is chosen by the maxVariance.
+    
+    @param useRandomizedSolver: sets if the randomized solver should be used
+    @return returns true if the parameter was updated, false otherwise
+    */
+    bool enableRandomizedSolver(const bool useRandomizedSolver);
+    
+    /**
+    Sets the number of extra random samples used by the randomized solver, on top of the number of principal components.
+    Larger values give a more accurate result at a higher cost. Default value=10
+    
+    @param numOversamples: the number of oversamples
+    @return returns true if the parameter was updated, false otherwise
+    */
+    bool setNumOversamples(const UINT numOversamples);
+    
+    /**
+    Sets the number of power iterations used by the randomized solver. Each iteration makes the solver more accurate when the
+    eigenvalues decay slowly, at the cost of two extra passes over the data. Default value=2
+    
+    @param numPowerIterations: the number of power iterations
+    @return returns true if the parameter was updated, false otherwise
+    */
+    bool setNumPowerIterations(const UINT numPowerIterations);
 
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::save;
@@ -203,8 +278,15 @@ public:
     
 protected:
     bool computeFeatureVector_(const MatrixFloat &data,UINT analysisMode);
+    bool computeRandomizedFeatureVector(const MatrixFloat &msData);
+    bool computeTopComponents(const MatrixFloat &a,const UINT K,MatrixFloat &components,VectorFloat &singularValues);
+    bool setSortedComponents(const MatrixFloat &components,const VectorFloat &singularValues,const Float totalVariance);
     
     bool normData;
+    bool useRandomizedSolver;
+    UINT numOversamples;
+    UINT numPowerIterations;
+    UINT numTrainingSamples;
     UINT numPrincipalComponents;
     Float maxVariance;
     VectorFloat mean;
@@ -213,6 +295,8 @@ protected:
     VectorFloat eigenvalues;
     Vector< IndexedDouble > sortedEigenvalues;
     MatrixFloat eigenvectors;
+    VectorFloat singularValues;
+    VectorFloat sumSquaredDeviations;
     
     enum AnalysisMode{MAX_VARIANCE=0,MAX_NUM_PCS};
 };
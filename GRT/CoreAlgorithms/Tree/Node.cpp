@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
 
 Node::StringNodeMap* Node::stringNodeMap = NULL;
-UINT Node::numNodeInstances = 0;
+InstanceCounter Node::numNodeInstances( 0 );
 
 Node* Node::createInstanceFromString( std::string const &nodeType ){
     
@@ -273,6 +273,107 @@ bool Node::load( std::fstream &file ){
     return true;
 }
 
+bool Node::saveBinary( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    file.writeString( nodeType );
+    file.writeUInt( depth );
+    file.writeUInt( nodeID );
+    file.writeBool( isLeafNode );
+    file.writeBool( getHasLeftChild() );
+    file.writeBool( getHasRightChild() );
+    
+    if( getHasLeftChild() ){
+        if( !leftChild->saveBinary( file ) ){
+            errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save left child at depth: " << depth << std::endl;
+            return false;
+        }
+    }
+    
+    if( getHasRightChild() ){
+        if( !rightChild->saveBinary( file ) ){
+            errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save right child at depth: " << depth << std::endl;
+            return false;
+        }
+    }
+    
+    //Save the custom parameters to the file
+    if( !saveParametersToBinaryFile( file ) ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save parameters to file at depth: " << depth << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool Node::loadBinary( BinaryModelReader &file ){
+    
+    //Clear any previous nodes
+    clear();
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBinary(BinaryModelReader &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    bool hasLeftChild = false;
+    bool hasRightChild = false;
+    
+    if( !file.readString( nodeType ) || !file.readUInt( depth ) || !file.readUInt( nodeID ) || !file.readBool( isLeafNode ) ||
+        !file.readBool( hasLeftChild ) || !file.readBool( hasRightChild ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the node header!" << std::endl;
+        return false;
+    }
+    
+    if( hasLeftChild ){
+        leftChild = createNewInstance();
+        if( leftChild == NULL ){
+            errorLog << "loadBinary(BinaryModelReader &file) - Failed to create left child of type: " << nodeType << std::endl;
+            return false;
+        }
+        leftChild->setParent( this );
+        if( !leftChild->loadBinary( file ) ){
+            errorLog << "loadBinary(BinaryModelReader &file) - Failed to load left child at depth: " << depth << std::endl;
+            return false;
+        }
+    }
+    
+    if( hasRightChild ){
+        rightChild = createNewInstance();
+        if( rightChild == NULL ){
+            errorLog << "loadBinary(BinaryModelReader &file) - Failed to create right child of type: " << nodeType << std::endl;
+            return false;
+        }
+        rightChild->setParent( this );
+        if( !rightChild->loadBinary( file ) ){
+            errorLog << "loadBinary(BinaryModelReader &file) - Failed to load right child at depth: " << depth << std::endl;
+            return false;
+        }
+    }
+    
+    //Load the custom parameters from the file
+    if( !loadParametersFromBinaryFile( file ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to load parameters from file at depth: " << depth << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool Node::saveParametersToBinaryFile( BinaryModelWriter &file ) const{
+    if( !saveParametersToFile( file.beginText() ) ) return false;
+    return file.endText();
+}
+
+bool Node::loadParametersFromBinaryFile( BinaryModelReader &file ){
+    if( !loadParametersFromFile( file.beginText() ) ) return false;
+    return file.endText();
+}
+
 Node* Node::deepCopyNode() const{
     
     Node *node = createNewInstance();
@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_NODE_HEADER
 
 #include "../../CoreModules/GRTBase.h"
+#include "../../Util/BinaryModelFile.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -124,6 +125,22 @@ public:
     */
     virtual bool load( std::fstream &file );
     
+    /**
+    This saves the Node, and all it's children, to a binary model file.
+    
+    @param file: a reference to the binary file the Node model will be saved to
+    @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveBinary( BinaryModelWriter &file ) const;
+    
+    /**
+    This loads the Node, and all it's children, from a binary model file.
+    
+    @param file: a reference to the binary file the Node model will be loaded from
+    @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadBinary( BinaryModelReader &file );
+    
     /**
     This function returns a deep copy of the Node and all it's children.
     The user is responsible for managing the dynamic data that is returned from this function as a pointer.
@@ -249,6 +266,23 @@ protected:
     */
     virtual bool loadParametersFromFile( std::fstream &file ){ return true; }
     
+    /**
+    This saves the custom parameters to a binary file. By default the parameters are saved as text using saveParametersToFile, any
+    class that inherits from the Node class can override this function (and loadParametersFromBinaryFile) to save them in binary.
+    
+    @param file: a reference to the binary file the parameters will be saved to
+    @return returns true if the parameters were saved successfully, false otherwise
+    */
+    virtual bool saveParametersToBinaryFile( BinaryModelWriter &file ) const;
+    
+    /**
+    This loads the custom parameters from a binary file. By default the parameters are loaded as text using loadParametersFromFile.
+    
+    @param file: a reference to the binary file the parameters will be loaded from
+    @return returns true if the parameters were loaded successfully, false otherwise
+    */
+    virtual bool loadParametersFromBinaryFile( BinaryModelReader &file );
+    
     std::string nodeType;
     UINT depth;
     UINT nodeID;
@@ -265,7 +299,7 @@ protected:
     
     private:
     static StringNodeMap *stringNodeMap;
-    static UINT numNodeInstances;
+    static InstanceCounter numNodeInstances;
     
 };
 
@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 Classifier::StringClassifierMap* Classifier::stringClassifierMap = NULL;
-UINT Classifier::numClassifierInstances = 0;
+InstanceCounter Classifier::numClassifierInstances( 0 );
     
 Classifier* Classifier::createInstanceFromString(std::string const &classifierType){
     
@@ -51,6 +51,63 @@ Classifier* Classifier::deepCopy() const{
     return newInstance;
 }
     
+bool Classifier::predict(const VectorFloat &inputVector,PredictionContext &context) const{
+    
+    if( !trained ){
+        errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The classifier has not been trained!" << std::endl;
+        return false;
+    }
+    
+    //The prediction may modify the input (e.g. scaling), so run it on a copy
+    VectorFloat x = inputVector;
+    return predictWithContext_( x, context );
+}
+    
+bool Classifier::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
+    
+    //This classifier does not support const prediction, so run the prediction with the copy of this classifier owned by the context
+    if( context.classifier == NULL || context.owner != this ){
+        context.clear();
+        context.classifier = deepCopy();
+        if( context.classifier == NULL ){
+            errorLog << "predictWithContext_(VectorFloat &inputVector,PredictionContext &context) - Failed to copy the classifier to the context!" << std::endl;
+            return false;
+        }
+        context.owner = this;
+    }
+    
+    if( !context.classifier->predict_( inputVector ) ){
+        errorLog << "predictWithContext_(VectorFloat &inputVector,PredictionContext &context) - Prediction failed! " << context.classifier->getLastErrorMessage() << std::endl;
+        return false;
+    }
+    
+    context.predictedClassLabel = context.classifier->predictedClassLabel;
+    context.maxLikelihood = context.classifier->maxLikelihood;
+    context.bestDistance = context.classifier->bestDistance;
+    context.phase = context.classifier->phase;
+    context.classLikelihoods = context.classifier->classLikelihoods;
+    context.classDistances = context.classifier->classDistances;
+    
+    return true;
+}
+    
+void Classifier::swapPredictionResults(PredictionContext &context){
+    std::swap( predictedClassLabel, context.predictedClassLabel );
+    std::swap( maxLikelihood, context.maxLikelihood );
+    std::swap( bestDistance, context.bestDistance );
+    std::swap( phase, context.phase );
+    classLikelihoods.swap( context.classLikelihoods );
+    classDistances.swap( context.classDistances );
+}
+    
+bool Classifier::predictAndStoreResults(VectorFloat &inputVector){
+    PredictionContext context;
+    swapPredictionResults( context );
+    bool result = predictWithContext_( inputVector, context );
+    swapPredictionResults( context );
+    return result;
+}
+    
 const Classifier* Classifier::getClassifierPointer() const{
     return this;
 }
@@ -400,5 +457,80 @@ bool Classifier::loadBaseSettingsFromFile( std::fstream &file ){
     return true;
 }
 
+bool Classifier::saveBaseSettingsToBinaryFile( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBaseSettingsToBinaryFile(BinaryModelWriter &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    if( !MLBase::saveBaseSettingsToBinaryFile( file ) ) return false;
+    
+    file.writeBool( useNullRejection );
+    file.writeUInt( classifierMode );
+    file.writeFloat( nullRejectionCoeff );
+    
+    if( trained ){
+        file.writeUInt( numClasses );
+        
+        //Match the text format, which always stores one threshold per class
+        if( useNullRejection && nullRejectionThresholds.getSize() == numClasses ){
+            file.writeVector( nullRejectionThresholds );
+        }else file.writeVector( VectorFloat(numClasses,0) );
+        
+        file.writeVector( classLabels );
+        
+        if( useScaling ){
+            file.writeVector( ranges );
+        }
+    }
+    
+    return true;
+}
+
+bool Classifier::loadBaseSettingsFromBinaryFile( BinaryModelReader &file ){
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    //Try and load the base settings from the file
+    if( !MLBase::loadBaseSettingsFromBinaryFile( file ) ){
+        return false;
+    }
+    
+    if( !file.readBool( useNullRejection ) || !file.readUInt( classifierMode ) || !file.readFloat( nullRejectionCoeff ) ){
+        errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - Failed to read the classifier settings!" << std::endl;
+        clear();
+        return false;
+    }
+    
+    //If the model is trained then load the model settings
+    if( trained ){
+        if( !file.readUInt( numClasses ) || !file.readVector( nullRejectionThresholds ) || !file.readVector( classLabels ) ){
+            errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - Failed to read the class labels!" << std::endl;
+            clear();
+            return false;
+        }
+        
+        if( nullRejectionThresholds.getSize() != numClasses || classLabels.getSize() != numClasses ){
+            errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - The number of class labels does not match the number of classes!" << std::endl;
+            clear();
+            return false;
+        }
+        
+        if( useScaling ){
+            if( !file.readVector( ranges ) || ranges.getSize() != numInputDimensions ){
+                errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - Failed to read the ranges!" << std::endl;
+                clear();
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
 GRT_END_NAMESPACE
 
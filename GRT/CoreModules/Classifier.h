@@ -32,6 +32,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_CLASSIFIER_HEADER
 
 #include "MLBase.h"
+#include "PredictionContext.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -86,6 +87,18 @@ public:
     */
     virtual bool clear();
     
+    /**
+    This is the const prediction interface for the classifier modules. Unlike the main predict function, this only reads the trained model
+    and stores the results (and any state that needs to be kept between predictions, such as buffered input data) in the context.
+    This means one trained classifier can be used by several streams or threads at once, as long as each one uses its own context.
+    The results can be accessed via the context, the results stored in the classifier are not updated.
+    
+    @param inputVector: the new input vector for prediction
+    @param context: the context that will be used for the prediction, this will be updated with the results of the prediction
+    @return returns true if the prediction was completed succesfully, false otherwise
+    */
+    bool predict(const VectorFloat &inputVector,PredictionContext &context) const;
+    
     /**
     Returns the classifier type as a string.
     
@@ -295,7 +308,37 @@ public:
     */
     static Vector< std::string > getRegisteredClassifiers();
     
+    //Tell the compiler we are using the base class predict method to stop hidden virtual function warnings
+    using MLBase::predict;
+    
 protected:
+    /**
+    This is the const prediction function that should be overwritten by any derived class that can predict without changing the model.
+    The default function runs the prediction with a copy of this classifier that is stored in the context, so any classifier can be used
+    with a context, but only the classifiers that overwrite this function will share their model between contexts.
+    
+    @param inputVector: a reference to the input vector for prediction, this may be modified by the prediction (e.g. scaled)
+    @param context: the context that will be used for the prediction
+    @return returns true if the prediction was completed succesfully, false otherwise
+    */
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    
+    /**
+    Swaps the prediction results of this classifier with those in the context. A derived class can use this to implement its predict_ function
+    using its predictWithContext_ function: swap the results into a context, run the prediction, then swap the updated results back.
+    
+    @param context: the context the results should be swapped with
+    */
+    void swapPredictionResults(PredictionContext &context);
+    
+    /**
+    Runs the predictWithContext_ function, using the results of this classifier as the context, so the results are stored in this classifier.
+    
+    @param inputVector: a reference to the input vector for prediction
+    @return returns true if the prediction was completed succesfully, false otherwise
+    */
+    bool predictAndStoreResults(VectorFloat &inputVector);
+    
     /**
     Saves the core base settings to a file.
     
@@ -310,6 +353,20 @@ protected:
     */
     bool loadBaseSettingsFromFile( std::fstream &file );
     
+    /**
+    Saves the core base settings to a binary file.
+    
+    @return returns true if the base settings were saved, false otherwise
+    */
+    bool saveBaseSettingsToBinaryFile( BinaryModelWriter &file ) const;
+    
+    /**
+    Loads the core base settings from a binary file.
+    
+    @return returns true if the base settings were loaded, false otherwise
+    */
+    bool loadBaseSettingsFromBinaryFile( BinaryModelReader &file );
+    
     bool supportsNullRejection;
     bool useNullRejection;
     UINT numClasses;
@@ -337,7 +394,7 @@ protected:
     
 private:
     static StringClassifierMap *stringClassifierMap;
-    static UINT numClassifierInstances;
+    static InstanceCounter numClassifierInstances;
     
 };
 
@@ -355,4 +412,4 @@ public:
 GRT_END_NAMESPACE
 
 #endif //GRT_CLASSIFIER_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
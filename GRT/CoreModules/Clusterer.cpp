@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 Clusterer::StringClustererMap* Clusterer::stringClustererMap = NULL;
-UINT Clusterer::numClustererInstances = 0;
+InstanceCounter Clusterer::numClustererInstances( 0 );
     
 Clusterer* Clusterer::createInstanceFromString( std::string const &clustererType ){
     
@@ -52,6 +52,61 @@ Clusterer* Clusterer::deepCopy() const{
     return newInstance;
 }
 
+bool Clusterer::predict(const VectorFloat &inputVector,PredictionContext &context) const{
+    
+    if( !trained ){
+        errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The clusterer has not been trained!" << std::endl;
+        return false;
+    }
+    
+    //The prediction may modify the input (e.g. scaling), so run it on a copy
+    VectorFloat x = inputVector;
+    return predictWithContext_( x, context );
+}
+    
+bool Clusterer::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
+    
+    //This clusterer does not support const prediction, so run the prediction with the copy of this clusterer owned by the context
+    if( context.clusterer == NULL || context.owner != this ){
+        context.clear();
+        context.clusterer = deepCopy();
+        if( context.clusterer == NULL ){
+            errorLog << "predictWithContext_(VectorFloat &inputVector,PredictionContext &context) - Failed to copy the clusterer to the context!" << std::endl;
+            return false;
+        }
+        context.owner = this;
+    }
+    
+    if( !context.clusterer->predict_( inputVector ) ){
+        errorLog << "predictWithContext_(VectorFloat &inputVector,PredictionContext &context) - Prediction failed! " << context.clusterer->getLastErrorMessage() << std::endl;
+        return false;
+    }
+    
+    context.predictedClusterLabel = context.clusterer->predictedClusterLabel;
+    context.maxLikelihood = context.clusterer->maxLikelihood;
+    context.bestDistance = context.clusterer->bestDistance;
+    context.clusterLikelihoods = context.clusterer->clusterLikelihoods;
+    context.clusterDistances = context.clusterer->clusterDistances;
+    
+    return true;
+}
+    
+void Clusterer::swapPredictionResults(PredictionContext &context){
+    std::swap( predictedClusterLabel, context.predictedClusterLabel );
+    std::swap( maxLikelihood, context.maxLikelihood );
+    std::swap( bestDistance, context.bestDistance );
+    clusterLikelihoods.swap( context.clusterLikelihoods );
+    clusterDistances.swap( context.clusterDistances );
+}
+    
+bool Clusterer::predictAndStoreResults(VectorFloat &inputVector){
+    PredictionContext context;
+    swapPredictionResults( context );
+    bool result = predictWithContext_( inputVector, context );
+    swapPredictionResults( context );
+    return result;
+}
+
 Vector< std::string > Clusterer::getRegisteredClusterers(){
 	Vector< std::string > registeredClusterers;
 	
@@ -32,6 +32,7 @@
 #define GRT_CLUSTERER_HEADER
 
 #include "MLBase.h"
+#include "PredictionContext.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -104,6 +105,18 @@ public:
      */
     virtual bool clear();
     
+    /**
+     This is the const prediction interface for the clusterer modules. Unlike the main predict function, this only reads the trained model
+     and stores the results (and any state that needs to be kept between predictions) in the context. This means one trained clusterer
+     can be used by several streams or threads at once, as long as each one uses its own context.
+     The results can be accessed via the context, the results stored in the clusterer are not updated.
+     
+     @param inputVector: the new input vector for prediction
+     @param context: the context that will be used for the prediction, this will be updated with the results of the prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    bool predict(const VectorFloat &inputVector,PredictionContext &context) const;
+    
     /**
      Returns true if the training algorithm converged during the most recent training process.
      This function will return false if the model has not been trained.
@@ -229,8 +242,36 @@ public:
 	
 	//Tell the compiler we are explicitly using the following classes from the base class (this stops hidden overloaded virtual function warnings)
     using MLBase::train;
+    using MLBase::predict;
     
 protected:
+    /**
+     This is the const prediction function that should be overwritten by any derived class that can predict without changing the model.
+     The default function runs the prediction with a copy of this clusterer that is stored in the context, so any clusterer can be used
+     with a context, but only the clusterers that overwrite this function will share their model between contexts.
+     
+     @param inputVector: a reference to the input vector for prediction, this may be modified by the prediction (e.g. scaled)
+     @param context: the context that will be used for the prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    
+    /**
+     Swaps the prediction results of this clusterer with those in the context. A derived class can use this to implement its predict_ function
+     using its predictWithContext_ function: swap the results into a context, run the prediction, then swap the updated results back.
+     
+     @param context: the context the results should be swapped with
+     */
+    void swapPredictionResults(PredictionContext &context);
+    
+    /**
+     Runs the predictWithContext_ function, using the results of this clusterer as the context, so the results are stored in this clusterer.
+     
+     @param inputVector: a reference to the input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    bool predictAndStoreResults(VectorFloat &inputVector);
+    
     /**
      Saves the core clusterer settings to a file.
      
@@ -263,7 +304,7 @@ protected:
     
 private:
     static StringClustererMap *stringClustererMap;
-    static UINT numClustererInstances;
+    static InstanceCounter numClustererInstances;
     
 };
     
@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 Context::StringContextMap* Context::stringContextMap = NULL;
-UINT Context::numContextInstances = 0;
+InstanceCounter Context::numContextInstances( 0 );
     
 Context* Context::createInstanceFromString( const std::string &contextType ){
     
@@ -149,7 +149,7 @@ protected:
 
 private:
     static StringContextMap *stringContextMap;
-    static UINT numContextInstances;
+    static InstanceCounter numContextInstances;
 };
 
 //These two functions/classes are used to register any new Context Module with the Context base class
@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 FeatureExtraction::StringFeatureExtractionMap* FeatureExtraction::stringFeatureExtractionMap = NULL;
-UINT FeatureExtraction::numFeatureExtractionInstances = 0;
+InstanceCounter FeatureExtraction::numFeatureExtractionInstances( 0 );
     
 FeatureExtraction* FeatureExtraction::createInstanceFromString( const std::string &featureExtractionType){
     
@@ -222,7 +222,7 @@ protected:
     
 private:
     static StringFeatureExtractionMap *stringFeatureExtractionMap;
-    static UINT numFeatureExtractionInstances;
+    static InstanceCounter numFeatureExtractionInstances;
     
 };
     
@@ -20,9 +20,20 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "GestureRecognitionPipeline.h"
+#include "../Util/ThreadPool.h"
 
 GRT_BEGIN_NAMESPACE
 
+//Runs the cross validation function for each fold, in parallel if C++11 is enabled. Each fold should only write its own results,
+//so the results do not depend on the order the folds are run in
+template< class FoldFunction >
+static void runCrossValidationFolds( const UINT K, FoldFunction foldFunction ){
+    ThreadPool::parallelFor( 0, K, 1, [&foldFunction](const UINT begin,const UINT end){
+        for(UINT k=begin; k<end; k++) foldFunction( k );
+        return true;
+    } );
+}
+
 GestureRecognitionPipeline::GestureRecognitionPipeline(void)
 {
     init();
@@ -78,6 +89,9 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 	    this->testConfusionMatrix = rhs.testConfusionMatrix;
         this->crossValidationResults = rhs.crossValidationResults;
         this->testResults = rhs.testResults;
+        this->crossValidationRandomSeed = rhs.crossValidationRandomSeed;
+        this->profilingEnabled = rhs.profilingEnabled;
+        this->profiler = rhs.profiler;
 
         //Copy the GRT Base variables
         this->debugLog = rhs.debugLog;
@@ -291,37 +305,47 @@ bool GestureRecognitionPipeline::train(const ClassificationData &trainingData,co
 	ClassificationData data = trainingData;
 
     //Spilt the data into K folds
-    bool spiltResult = data.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling);
+    bool spiltResult = data.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling, crossValidationRandomSeed);
     
     if( !spiltResult ){
         return false;
     }
     
-    //Run the k-fold training and testing
+    //Train and test each fold with its own copy of the pipeline, so the folds can run in parallel. Each fold is tested
+    //with the indexes of its test samples in the shared dataset, so only the training data is copied for each fold
+    Vector< GestureRecognitionPipeline > foldPipelines( kFoldValue, *this );
+    Vector< unsigned int > foldTrained( kFoldValue, 0 );
+
+    runCrossValidationFolds( kFoldValue, [&]( const UINT k ){
+        GestureRecognitionPipeline &foldPipeline = foldPipelines[k];
+
+        if( !foldPipeline.train( data.getTrainingFoldData(k) ) ){
+            errorLog << "train(const ClassificationData &trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to train pipeline for fold " << k << "." << std::endl;
+            return;
+        }
+
+        if( !foldPipeline.testSubset( data, data.getTestFoldIndexes(k) ) ){
+            errorLog << "train(const ClassificationData &trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to test pipeline for fold " << k << "." << std::endl;
+            return;
+        }
+
+        foldTrained[k] = 1;
+    } );
+
+    //Merge the fold results in fold order, so they do not depend on the order the folds finished in
     Float crossValidationAccuracy = 0;
-    ClassificationData foldTrainingData;
-    ClassificationData foldTestData;
     Vector< TestResult > cvResults(kFoldValue);
-
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = data.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
+        if( !foldTrained[k] ){
             return false;
         }
-        
-        //Test the classification system
-        foldTestData = data.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
-            return false;
-        }
-        
-        crossValidationAccuracy += getTestAccuracy();
-        cvResults[k] = getTestResults();
+        crossValidationAccuracy += foldPipelines[k].getTestAccuracy();
+        cvResults[k] = foldPipelines[k].getTestResults();
     }
 
+    //Keep the pipeline that was trained with the last fold, along with its test results
+    *this = foldPipelines[kFoldValue-1];
+
     //Flag that the model has been trained
     trained = true;
     
@@ -561,41 +585,52 @@ bool GestureRecognitionPipeline::train(const TimeSeriesClassificationData &train
 	TimeSeriesClassificationData data = trainingData;
     
     //Spilt the data into K folds
-    if( !data.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling) ){
+    if( !data.spiltDataIntoKFolds(kFoldValue, useStratifiedSampling, crossValidationRandomSeed) ){
         errorLog << "train(const TimeSeriesClassificationData &trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed To Spilt Dataset into KFolds!" << std::endl;
         return false;
     }
     
-    //Run the k-fold training and testing
-    Float crossValidationAccuracy = 0;
-    TimeSeriesClassificationData foldTrainingData;
-    TimeSeriesClassificationData foldTestData;
-    
-    for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = data.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
+    //Train and test each fold with its own copy of the pipeline, so the folds can run in parallel. Each fold is tested
+    //with the indexes of its test samples in the shared dataset, so only the training data is copied for each fold
+    Vector< GestureRecognitionPipeline > foldPipelines( kFoldValue, *this );
+    Vector< unsigned int > foldTrained( kFoldValue, 0 );
+
+    runCrossValidationFolds( kFoldValue, [&]( const UINT k ){
+        GestureRecognitionPipeline &foldPipeline = foldPipelines[k];
+
+        if( !foldPipeline.train( data.getTrainingFoldData(k) ) ){
             errorLog << "train(const TimeSeriesClassificationData &trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to train pipeline for fold " << k << "." << std::endl;
-            return false;
+            return;
         }
-        
-        //Test the classification system
-        foldTestData = data.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
+
+        if( !foldPipeline.testSubset( data, data.getTestFoldIndexes(k) ) ){
             errorLog << "train(const TimeSeriesClassificationData &trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to test pipeline for fold " << k << "." << std::endl;
+            return;
+        }
+
+        foldTrained[k] = 1;
+    } );
+
+    //Merge the fold results in fold order, so they do not depend on the order the folds finished in
+    Float crossValidationAccuracy = 0;
+    Vector< TestResult > cvResults(kFoldValue);
+    for(UINT k=0; k<kFoldValue; k++){
+        if( !foldTrained[k] ){
             return false;
         }
-        
-        crossValidationAccuracy += getTestAccuracy();
+        crossValidationAccuracy += foldPipelines[k].getTestAccuracy();
+        cvResults[k] = foldPipelines[k].getTestResults();
     }
 
+    //Keep the pipeline that was trained with the last fold, along with its test results
+    *this = foldPipelines[kFoldValue-1];
+
     //Flag that the model has been trained
     trained = true;
     
     //Set the accuracy of the classification system averaged over the kfolds
     testAccuracy = crossValidationAccuracy / Float(kFoldValue);
+    crossValidationResults = cvResults;
     
     //Store the training time
     trainingTime = timer.getMilliSeconds();
@@ -830,39 +865,52 @@ bool GestureRecognitionPipeline::train(const RegressionData &trainingData,const
 	RegressionData data = trainingData;
 
     //Spilt the data into K folds
-    bool spiltResult = data.spiltDataIntoKFolds(kFoldValue);
+    bool spiltResult = data.spiltDataIntoKFolds(kFoldValue, crossValidationRandomSeed);
     
     if( !spiltResult ){
         return false;
     }
     
-    //Run the k-fold training and testing
+    //Train and test each fold with its own copy of the pipeline, so the folds can run in parallel. Each fold is tested
+    //with the indexes of its test samples in the shared dataset, so only the training data is copied for each fold
+    Vector< GestureRecognitionPipeline > foldPipelines( kFoldValue, *this );
+    Vector< unsigned int > foldTrained( kFoldValue, 0 );
+
+    runCrossValidationFolds( kFoldValue, [&]( const UINT k ){
+        GestureRecognitionPipeline &foldPipeline = foldPipelines[k];
+
+        if( !foldPipeline.train( data.getTrainingFoldData(k) ) ){
+            errorLog << "train(const RegressionData &trainingData,const UINT kFoldValue) - Failed to train pipeline for fold " << k << "." << std::endl;
+            return;
+        }
+
+        if( !foldPipeline.testSubset( data, data.getTestFoldIndexes(k) ) ){
+            errorLog << "train(const RegressionData &trainingData,const UINT kFoldValue) - Failed to test pipeline for fold " << k << "." << std::endl;
+            return;
+        }
+
+        foldTrained[k] = 1;
+    } );
+
+    //Merge the fold results in fold order, so they do not depend on the order the folds finished in
     Float crossValidationAccuracy = 0;
-    RegressionData foldTrainingData;
-    RegressionData foldTestData;
+    Vector< TestResult > cvResults(kFoldValue);
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-        foldTrainingData = data.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
+        if( !foldTrained[k] ){
             return false;
         }
-        
-        //Test the classification system
-        foldTestData = data.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
-            return false;
-        }
-
-        crossValidationAccuracy += getTestRMSError();
-        
+        crossValidationAccuracy += foldPipelines[k].getTestRMSError();
+        cvResults[k] = foldPipelines[k].getTestResults();
     }
 
+    //Keep the pipeline that was trained with the last fold, along with its test results
+    *this = foldPipelines[kFoldValue-1];
+
     //Flag that the model has been trained
     trained = true;
 
     testAccuracy = crossValidationAccuracy / Float(kFoldValue);
+    crossValidationResults = cvResults;
     
     //Store the training time
     trainingTime = timer.getMilliSeconds();
@@ -974,6 +1022,15 @@ bool GestureRecognitionPipeline::train(const UnlabelledData &trainingData){
 }
     
 bool GestureRecognitionPipeline::test(const ClassificationData &testData){
+
+    //Test the pipeline with all the samples in the dataset
+    Vector< UINT > testIndexes( testData.getNumSamples() );
+    for(UINT i=0; i<testIndexes.getSize(); i++) testIndexes[i] = i;
+
+    return testSubset( testData, testIndexes );
+}
+
+bool GestureRecognitionPipeline::testSubset(const ClassificationData &testData,const Vector< UINT > &testIndexes){
     
     //Clear any previous test results
     clearTestResults();
@@ -1042,8 +1099,8 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
     testPrecision.resize(getNumClassesInModel(), 0);
     testRecall.resize(getNumClassesInModel(), 0);
     testFMeasure.resize(getNumClassesInModel(), 0);
-    testResults.resize(testData.getNumSamples());
-    numTestSamples = testData.getNumSamples();
+    numTestSamples = testIndexes.getSize();
+    testResults.resize(numTestSamples);
     
     //Start the test timer
     Timer timer;
@@ -1051,8 +1108,9 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
 
     //Run the test
     for(UINT i=0; i<numTestSamples; i++){
-        UINT classLabel = testData[i].getClassLabel();
-        VectorFloat testSample = testData[i].getSample();
+        const UINT index = testIndexes[i];
+        UINT classLabel = testData[index].getClassLabel();
+        VectorFloat testSample = testData[index].getSample();
         
         //Pass the test sample through the pipeline
         if( !predict( testSample ) ){
@@ -1088,6 +1146,15 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
     
 bool GestureRecognitionPipeline::test(const TimeSeriesClassificationData &testData){
 
+    //Test the pipeline with all the samples in the dataset
+    Vector< UINT > testIndexes( testData.getNumSamples() );
+    for(UINT i=0; i<testIndexes.getSize(); i++) testIndexes[i] = i;
+
+    return testSubset( testData, testIndexes );
+}
+
+bool GestureRecognitionPipeline::testSubset(const TimeSeriesClassificationData &testData,const Vector< UINT > &testIndexes){
+
     //Clear any previous test results
     clearTestResults();
     
@@ -1127,17 +1194,18 @@ bool GestureRecognitionPipeline::test(const TimeSeriesClassificationData &testDa
     testPrecision.resize(K, 0);
     testRecall.resize(K, 0);
     testFMeasure.resize(K, 0);
-    numTestSamples = testData.getNumSamples();
+    numTestSamples = testIndexes.getSize();
     
     //Start the test timer
     Timer timer;
     timer.start();
     
     //Run the test
-	const UINT M = testData.getNumSamples();
+	const UINT M = testIndexes.getSize();
     for(UINT i=0; i<M; i++){
-        UINT classLabel = testData[i].getClassLabel();
-        MatrixFloat timeseries = testData[i].getData();
+        const UINT index = testIndexes[i];
+        UINT classLabel = testData[index].getClassLabel();
+        MatrixFloat timeseries = testData[index].getData();
             
         //Pass the test timeseries through the pipeline
         if( !predict( timeseries ) ){
@@ -1270,6 +1338,15 @@ bool GestureRecognitionPipeline::test(const ClassificationDataStream &testData){
 }
     
 bool GestureRecognitionPipeline::test(const RegressionData &testData){
+
+    //Test the pipeline with all the samples in the dataset
+    Vector< UINT > testIndexes( testData.getNumSamples() );
+    for(UINT i=0; i<testIndexes.getSize(); i++) testIndexes[i] = i;
+
+    return testSubset( testData, testIndexes );
+}
+
+bool GestureRecognitionPipeline::testSubset(const RegressionData &testData,const Vector< UINT > &testIndexes){
     
     //Clear any previous test results
     clearTestResults();
@@ -1299,7 +1376,7 @@ bool GestureRecognitionPipeline::test(const RegressionData &testData){
     //Reset all the modules
     reset();
     
-    numTestSamples = testData.getNumSamples();
+    numTestSamples = testIndexes.getSize();
     testResults.resize( numTestSamples );
     
     //Start the test timer
@@ -1310,8 +1387,9 @@ bool GestureRecognitionPipeline::test(const RegressionData &testData){
     testSquaredError = 0;
     testRMSError = 0;
     for(UINT i=0; i<numTestSamples; i++){
-        VectorFloat inputVector = testData[i].getInputVector();
-        VectorFloat targetVector = testData[i].getTargetVector();
+        const UINT index = testIndexes[i];
+        VectorFloat inputVector = testData[index].getInputVector();
+        VectorFloat targetVector = testData[index].getTargetVector();
         
         //Pass the test sample through the pipeline
         if( !map( inputVector ) ){
@@ -1336,7 +1414,7 @@ bool GestureRecognitionPipeline::test(const RegressionData &testData){
     }
     
     //Compute the test metrics
-    testRMSError = sqrt( testSquaredError / Float( testData.getNumSamples() ) );
+    testRMSError = sqrt( testSquaredError / Float( numTestSamples ) );
     
     testTime = timer.getMilliSeconds();
     
@@ -1357,23 +1435,214 @@ bool GestureRecognitionPipeline::predict(const VectorFloat &inputVector){
         return false;
     }
 
+    if( !getIsClassifierSet() && !getIsRegressifierSet() && !getIsClustererSet() ){
+        errorLog << "predict(const VectorFloat &inputVector) - Neither a classifier, regressifer or clusterer is set" << std::endl;
+        return false;
+    }
+
+    if( profilingEnabled ) profiler.startPrediction();
+
+    bool predictionSuccess = false;
 	if( getIsClassifierSet() ){
-        return predict_classifier( inputVector );
+        predictionSuccess = predict_classifier( inputVector );
+    }else if( getIsRegressifierSet() ){
+        predictionSuccess = predict_regressifier( inputVector );
+    }else{
+        predictionSuccess = predict_clusterer( inputVector );
     }
 
-	if( getIsRegressifierSet() ){
-        return predict_regressifier( inputVector );
+    if( profilingEnabled ){
+        profiler.stopPrediction( predictionSuccess, predictionSuccess && getIsClassifierSet() && predictedClassLabel == GRT_DEFAULT_NULL_CLASS_LABEL );
+    }
+
+	return predictionSuccess;
+}
+
+bool GestureRecognitionPipeline::predict(const VectorFloat &inputVector,PredictionContext &context) const{
+    
+    //Make sure the model has been trained
+    if( !trained ){
+        errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The pipeline has not been trained" << std::endl;
+        return false;
     }
     
-    if( getIsClustererSet() ){
-        return predict_clusterer( inputVector );
+    //Make sure the dimensionality of the input Vector matches the inputVectorDimensions
+    if( inputVector.size() != inputVectorDimensions ){
+        errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The dimensionality of the input Vector (" << int(inputVector.size()) << ") does not match that of the input Vector dimensions of the pipeline (" << inputVectorDimensions << ")" << std::endl;
+        return false;
     }
-
-    errorLog << "predict(const VectorFloat &inputVector) - Neither a classifier, regressifer or clusterer is set" << std::endl;
-	return false;
+    
+    const bool classifierSet = getIsClassifierSet();
+    const bool regressifierSet = getIsRegressifierSet();
+    const bool clustererSet = getIsClustererSet();
+    if( !classifierSet && !regressifierSet && !clustererSet ){
+        errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Neither a classifier, regressifer or clusterer is set" << std::endl;
+        return false;
+    }
+    
+    //Create the modules for this stream the first time the context is used with this pipeline
+    if( context.owner != this || context.modelContext == NULL ){
+        if( !setupPredictionContext( context ) ){
+            return false;
+        }
+    }
+    
+    context.predictedClassLabel = 0;
+    context.predictedClusterLabel = 0;
+    VectorFloat data = inputVector;
+    bool okToContinue = true;
+    
+    //Update the context modules
+    if( !processContextModules( START_OF_PIPELINE, data, context, okToContinue ) ) return false;
+    if( !okToContinue ) return true;
+    
+    //Perform any pre-processing
+    for(UINT moduleIndex=0; moduleIndex<context.preProcessingModules.getSize(); moduleIndex++){
+        if( !context.preProcessingModules[moduleIndex]->process( data ) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << std::endl;
+            return false;
+        }
+        data = context.preProcessingModules[moduleIndex]->getProcessedData();
+    }
+    
+    //Update the context modules
+    if( !processContextModules( AFTER_PREPROCESSING, data, context, okToContinue ) ) return false;
+    if( !okToContinue ) return false;
+    
+    //Perform any feature extraction
+    for(UINT moduleIndex=0; moduleIndex<context.featureExtractionModules.getSize(); moduleIndex++){
+        if( !context.featureExtractionModules[moduleIndex]->computeFeatures( data ) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << std::endl;
+            return false;
+        }
+        data = context.featureExtractionModules[moduleIndex]->getFeatureVector();
+    }
+    
+    //Update the context modules
+    if( !processContextModules( AFTER_FEATURE_EXTRACTION, data, context, okToContinue ) ) return false;
+    if( !okToContinue ) return false;
+    
+    //Run the prediction, the model is shared by all the contexts but each pipeline context has its own context for the model
+    PredictionContext &modelContext = *context.modelContext;
+    if( classifierSet ){
+        if( !classifier->predict( data, modelContext ) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Prediction Failed! " << classifier->getLastErrorMessage() << std::endl;
+            return false;
+        }
+        context.predictedClassLabel = modelContext.predictedClassLabel;
+        context.maxLikelihood = modelContext.maxLikelihood;
+        context.bestDistance = modelContext.bestDistance;
+        context.phase = modelContext.phase;
+        context.classLikelihoods = modelContext.classLikelihoods;
+        context.classDistances = modelContext.classDistances;
+    }else if( regressifierSet ){
+        if( !regressifier->predict( data, modelContext ) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Prediction Failed! " << regressifier->getLastErrorMessage() << std::endl;
+            return false;
+        }
+        context.regressionData = modelContext.regressionData;
+    }else{
+        if( !clusterer->predict( data, modelContext ) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Prediction Failed! " << clusterer->getLastErrorMessage() << std::endl;
+            return false;
+        }
+        context.predictedClusterLabel = modelContext.predictedClusterLabel;
+        context.maxLikelihood = modelContext.maxLikelihood;
+        context.bestDistance = modelContext.bestDistance;
+        context.clusterLikelihoods = modelContext.clusterLikelihoods;
+        context.clusterDistances = modelContext.clusterDistances;
+    }
+    
+    //The classifier and clusterer pass their predicted label through the rest of the pipeline, the regressifier passes the regression data
+    UINT &predictedLabel = classifierSet ? context.predictedClassLabel : context.predictedClusterLabel;
+    if( regressifierSet ) data = context.regressionData;
+    else data = VectorFloat(1,predictedLabel);
+    
+    //Update the context modules
+    if( !processContextModules( AFTER_CLASSIFIER, data, context, okToContinue ) ) return false;
+    if( !okToContinue ) return false;
+    if( regressifierSet ) context.regressionData = data;
+    else predictedLabel = (UINT)data[0];
+    
+    //Perform any post processing
+    if( context.postProcessingModules.getSize() > 0 ){
+        
+        if( pipelineMode != (regressifierSet ? REGRESSION_MODE : CLASSIFICATION_MODE) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The pipeline mode does not match the post processing modules!" << std::endl;
+            return false;
+        }
+        
+        for(UINT moduleIndex=0; moduleIndex<context.postProcessingModules.getSize(); moduleIndex++){
+            PostProcessing *postProcessingModule = context.postProcessingModules[moduleIndex];
+            
+            if( regressifierSet ){
+                if( context.regressionData.size() != postProcessingModule->getNumInputDimensions() ){
+                    errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The size of the regression Vector (" << int(context.regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModule->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << std::endl;
+                    return false;
+                }
+                if( !postProcessingModule->process( context.regressionData ) ){
+                    errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
+                    return false;
+                }
+                context.regressionData = postProcessingModule->getProcessedData();
+                continue;
+            }
+            
+            //Select which input we should give the postprocessing module
+            if( postProcessingModule->getIsPostProcessingInputModePredictedClassLabel() ){
+                data.resize(1);
+                data[0] = predictedLabel;
+                
+                if( data.size() != postProcessingModule->getNumInputDimensions() ){
+                    errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The size of the data Vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModule->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << std::endl;
+                    return false;
+                }
+                
+                if( !postProcessingModule->process( data ) ){
+                    errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
+                    return false;
+                }
+            }
+            
+            //Select which output we should update
+            if( postProcessingModule->getIsPostProcessingOutputModePredictedClassLabel() ){
+                data = postProcessingModule->getProcessedData();
+                
+                if( data.size() != 1 ){
+                    errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The size of the processed data Vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << std::endl;
+                    return false;
+                }
+                
+                predictedLabel = (UINT)data[0];
+            }
+        }
+    }
+    
+    //Update the context modules
+    if( regressifierSet ) data = context.regressionData;
+    else data = VectorFloat(1,predictedLabel);
+    if( !processContextModules( END_OF_PIPELINE, data, context, okToContinue ) ) return false;
+    if( !okToContinue ) return false;
+    if( regressifierSet ) context.regressionData = data;
+    else predictedLabel = (UINT)data[0];
+    
+    return true;
 }
 
 bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
+
+    if( !profilingEnabled ){
+        return predict_timeseries( input );
+    }
+
+    profiler.startPrediction();
+    const bool predictionSuccess = predict_timeseries( input );
+    profiler.stopPrediction( predictionSuccess, predictionSuccess && predictedClassLabel == GRT_DEFAULT_NULL_CLASS_LABEL );
+
+    return predictionSuccess;
+}
+
+bool GestureRecognitionPipeline::predict_timeseries(const MatrixFloat &input){
 	
 	//Make sure the classification model has been trained
     if( !trained ){
@@ -1443,6 +1712,7 @@ bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
             outputType = featureExtractionModules[ moduleIndex ]->getOutputType();
 
             //Run the feature extraction algorithm
+            if( profilingEnabled ) profiler.startModule();
             switch( inputType ){
                 case DATA_TYPE_VECTOR:
                     if( !featureExtractionModules[ moduleIndex ]->computeFeatures( *static_cast< const VectorFloat* >( feInput ) ) ){
@@ -1461,6 +1731,7 @@ bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
                     return false;
                 break;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::FEATURE_EXTRACTION_STAGE, moduleIndex );
             
             //Get the results and store them in the feOutput pointer
             switch( outputType ){
@@ -1491,6 +1762,7 @@ bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
 
     //Perform the classification
+    if( profilingEnabled ) profiler.startModule();
     switch( dataType ){
         case DATA_TYPE_VECTOR:
             if( !classifier->predict_( *(VectorFloat*)data ) ){
@@ -1509,6 +1781,7 @@ bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
             return false;
         break;
     }
+    if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CLASSIFIER_STAGE, 0 );
     
     predictedClassLabel = classifier->getPredictedClassLabel();
     
@@ -1541,10 +1814,12 @@ bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
                 }
                 
                 //Postprocess the data
+                if( profilingEnabled ) profiler.startModule();
                 if( !postProcessingModules[moduleIndex]->process( data ) ){
                     errorLog << "predict_timeseries(const MatrixFloat &inputMatrix) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
                     return false;
                 }
+                if( profilingEnabled ) profiler.stopModule( PipelineProfiler::POST_PROCESSING_STAGE, moduleIndex );
                 
                 //Select which output we should update
                 data = postProcessingModules[moduleIndex]->getProcessedData();  
@@ -1575,7 +1850,90 @@ bool GestureRecognitionPipeline::predict(const MatrixFloat &input){
 }
 
 bool GestureRecognitionPipeline::map(const VectorFloat &inputVector){
-	return predict_regressifier( inputVector );
+
+    if( !profilingEnabled ){
+        return predict_regressifier( inputVector );
+    }
+
+    profiler.startPrediction();
+    const bool predictionSuccess = predict_regressifier( inputVector );
+    profiler.stopPrediction( predictionSuccess, false );
+
+    return predictionSuccess;
+}
+
+bool GestureRecognitionPipeline::setupPredictionContext(PredictionContext &context) const{
+    
+    context.clear();
+    
+    //Copy the modules that keep their own state, so each context can process its own stream
+    for(UINT i=0; i<preProcessingModules.getSize(); i++){
+        PreProcessing *module = PredictionContext::copyModule( preProcessingModules[i] );
+        if( module == NULL ){
+            errorLog << "setupPredictionContext(PredictionContext &context) - Failed to copy PreProcessing module " << i << " to the context!" << std::endl;
+            context.clear();
+            return false;
+        }
+        context.preProcessingModules.push_back( module );
+    }
+    
+    for(UINT i=0; i<featureExtractionModules.getSize(); i++){
+        FeatureExtraction *module = PredictionContext::copyModule( featureExtractionModules[i] );
+        if( module == NULL ){
+            errorLog << "setupPredictionContext(PredictionContext &context) - Failed to copy FeatureExtraction module " << i << " to the context!" << std::endl;
+            context.clear();
+            return false;
+        }
+        context.featureExtractionModules.push_back( module );
+    }
+    
+    for(UINT i=0; i<postProcessingModules.getSize(); i++){
+        PostProcessing *module = PredictionContext::copyModule( postProcessingModules[i] );
+        if( module == NULL ){
+            errorLog << "setupPredictionContext(PredictionContext &context) - Failed to copy PostProcessing module " << i << " to the context!" << std::endl;
+            context.clear();
+            return false;
+        }
+        context.postProcessingModules.push_back( module );
+    }
+    
+    context.contextModules.resize( NUM_CONTEXT_LEVELS );
+    for(UINT k=0; k<NUM_CONTEXT_LEVELS; k++){
+        for(UINT i=0; i<contextModules[k].getSize(); i++){
+            Context *module = PredictionContext::copyModule( contextModules[k][i] );
+            if( module == NULL ){
+                errorLog << "setupPredictionContext(PredictionContext &context) - Failed to copy Context module " << i << " at level " << k << " to the context!" << std::endl;
+                context.clear();
+                return false;
+            }
+            context.contextModules[k].push_back( module );
+        }
+    }
+    
+    context.modelContext = new PredictionContext();
+    context.owner = this;
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::processContextModules(const UINT contextLevel,VectorFloat &data,PredictionContext &context,bool &okToContinue) const{
+    
+    okToContinue = true;
+    
+    for(UINT moduleIndex=0; moduleIndex<context.contextModules[ contextLevel ].getSize(); moduleIndex++){
+        Context *module = context.contextModules[ contextLevel ][ moduleIndex ];
+        if( !module->process( data ) ){
+            errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - Context Module Failed at context level: " << contextLevel << ". ModuleIndex: " << moduleIndex << std::endl;
+            return false;
+        }
+        if( !module->getOK() ){
+            okToContinue = false;
+            return true;
+        }
+        data = module->getProcessedData();
+    }
+    
+    return true;
 }
 
 bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
@@ -1586,6 +1944,7 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() > 0 ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(const VectorFloat &inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << std::endl;
@@ -1596,15 +1955,18 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
             }
             inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, START_OF_PIPELINE );
     }
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+            if( profilingEnabled ) profiler.startModule();
             if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(const VectorFloat &inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::PREPROCESSING_STAGE, moduleIndex );
             inputVector = preProcessingModules[moduleIndex]->getProcessedData();
         }
     }
@@ -1612,6 +1974,7 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(VectorFloat inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << std::endl;
@@ -1623,15 +1986,18 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
             }
             inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_PREPROCESSING );
     }
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            if( profilingEnabled ) profiler.startModule();
             if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
                 errorLog << "predict_classifier(VectorFloat inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::FEATURE_EXTRACTION_STAGE, moduleIndex );
             inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
@@ -1639,6 +2005,7 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_classifier(VectorFloat inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << std::endl;
@@ -1650,17 +2017,21 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
             }
             inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_FEATURE_EXTRACTION );
     }
     
     //Perform the classification
+    if( profilingEnabled ) profiler.startModule();
     if( !classifier->predict(inputVector) ){
         errorLog << "predict_classifier(VectorFloat inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << std::endl;
         return false;
     }
+    if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CLASSIFIER_STAGE, 0 );
     predictedClassLabel = classifier->getPredictedClassLabel();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( VectorFloat(1,predictedClassLabel) ) ){
                 errorLog << "predict_classifier(VectorFloat inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << std::endl;
@@ -1672,6 +2043,7 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
             }
             predictedClassLabel = (UINT)contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getProcessedData()[0];
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_CLASSIFIER );
     }
     
     //Perform any post processing
@@ -1699,10 +2071,12 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
                 }
                 
                 //Postprocess the data
+                if( profilingEnabled ) profiler.startModule();
                 if( !postProcessingModules[moduleIndex]->process( data ) ){
                     errorLog << "predict_classifier(VectorFloat inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
                     return false;
                 }
+                if( profilingEnabled ) profiler.stopModule( PipelineProfiler::POST_PROCESSING_STAGE, moduleIndex );
                 
                 //Select which output we should update
                 data = postProcessingModules[moduleIndex]->getProcessedData();  
@@ -1729,6 +2103,7 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
             if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( VectorFloat(1,predictedClassLabel) ) ){
                 errorLog << "predict_classifier(VectorFloat inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << std::endl;
@@ -1740,6 +2115,7 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
             }
             predictedClassLabel = (UINT)contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData()[0];
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, END_OF_PIPELINE );
     }
     
     return true;
@@ -1752,6 +2128,7 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << std::endl;
@@ -1762,15 +2139,18 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
             }
             inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, START_OF_PIPELINE );
     }
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+            if( profilingEnabled ) profiler.startModule();
             if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::PREPROCESSING_STAGE, moduleIndex );
             inputVector = preProcessingModules[moduleIndex]->getProcessedData();
         }
     }
@@ -1778,6 +2158,7 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << std::endl;
@@ -1789,15 +2170,18 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
             }
             inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_PREPROCESSING );
     }
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            if( profilingEnabled ) profiler.startModule();
             if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::FEATURE_EXTRACTION_STAGE, moduleIndex );
             inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
@@ -1805,6 +2189,7 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << std::endl;
@@ -1816,17 +2201,21 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
             }
             inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_FEATURE_EXTRACTION );
     }
     
     //Perform the regression
+    if( profilingEnabled ) profiler.startModule();
     if( !regressifier->predict(inputVector) ){
         errorLog << "predict_regressifier(VectorFloat inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << std::endl;
         return false;
     }
+    if( profilingEnabled ) profiler.stopModule( PipelineProfiler::REGRESSIFIER_STAGE, 0 );
     regressionData = regressifier->getRegressionData();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( regressionData ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << std::endl;
@@ -1838,6 +2227,7 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
             }
             regressionData = contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_CLASSIFIER );
     }
     
     //Perform any post processing
@@ -1855,10 +2245,12 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
                 return false;
             }
             
+            if( profilingEnabled ) profiler.startModule();
             if( !postProcessingModules[moduleIndex]->process( regressionData ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::POST_PROCESSING_STAGE, moduleIndex );
             regressionData = postProcessingModules[moduleIndex]->getProcessedData();        
         }
         
@@ -1867,6 +2259,7 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
             if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_regressifier(VectorFloat inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << std::endl;
@@ -1878,6 +2271,7 @@ bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
             }
             regressionData = contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, END_OF_PIPELINE );
     }
     
     return true;
@@ -1891,6 +2285,7 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = START_OF_PIPELINE;
     if( contextModules[ START_OF_PIPELINE ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
             if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << std::endl;
@@ -1901,15 +2296,18 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
             }
             inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, START_OF_PIPELINE );
     }
     
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+            if( profilingEnabled ) profiler.startModule();
             if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::PREPROCESSING_STAGE, moduleIndex );
             inputVector = preProcessingModules[moduleIndex]->getProcessedData();
         }
     }
@@ -1917,6 +2315,7 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = AFTER_PREPROCESSING;
     if( contextModules[ AFTER_PREPROCESSING ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
             if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << std::endl;
@@ -1928,15 +2327,18 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
             }
             inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_PREPROCESSING );
     }
     
     //Perform any feature extraction
     if( getIsFeatureExtractionSet() ){
         for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            if( profilingEnabled ) profiler.startModule();
             if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << std::endl;
                 return false;
             }
+            if( profilingEnabled ) profiler.stopModule( PipelineProfiler::FEATURE_EXTRACTION_STAGE, moduleIndex );
             inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
         }
     }
@@ -1944,6 +2346,7 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
     if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
             if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << std::endl;
@@ -1955,17 +2358,21 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
             }
             inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_FEATURE_EXTRACTION );
     }
     
     //Perform the classification
+    if( profilingEnabled ) profiler.startModule();
     if( !clusterer->predict(inputVector) ){
         errorLog << "predict_clusterer(VectorFloat inputVector) - Prediction Failed! " << clusterer->getLastErrorMessage() << std::endl;
         return false;
     }
+    if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CLUSTERER_STAGE, 0 );
     predictedClusterLabel = clusterer->getPredictedClusterLabel();
     
     //Update the context module
     if( contextModules[ AFTER_CLASSIFIER ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
             if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( VectorFloat(1,predictedClusterLabel) ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << std::endl;
@@ -1977,6 +2384,7 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
             }
             predictedClusterLabel = (UINT)contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getProcessedData()[0];
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, AFTER_CLASSIFIER );
     }
     
     //Perform any post processing
@@ -2004,10 +2412,12 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
                 }
                 
                 //Postprocess the data
+                if( profilingEnabled ) profiler.startModule();
                 if( !postProcessingModules[moduleIndex]->process( data ) ){
                     errorLog << "predict_clusterer(VectorFloat inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
                     return false;
                 }
+                if( profilingEnabled ) profiler.stopModule( PipelineProfiler::POST_PROCESSING_STAGE, moduleIndex );
                 
                 //Select which output we should update
                 data = postProcessingModules[moduleIndex]->getProcessedData();
@@ -2034,6 +2444,7 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
     //Update the context module
     predictionModuleIndex = END_OF_PIPELINE;
     if( contextModules[ END_OF_PIPELINE ].size() ){
+        if( profilingEnabled ) profiler.startModule();
         for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
             if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( VectorFloat(1,predictedClassLabel) ) ){
                 errorLog << "predict_clusterer(VectorFloat inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << std::endl;
@@ -2045,6 +2456,7 @@ bool GestureRecognitionPipeline::predict_clusterer(const VectorFloat &input){
             }
             predictedClusterLabel = (UINT)contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData()[0];
         }
+        if( profilingEnabled ) profiler.stopModule( PipelineProfiler::CONTEXT_STAGE, END_OF_PIPELINE );
     }
     
     return true;
@@ -2111,6 +2523,32 @@ bool GestureRecognitionPipeline::reset(){
 
 bool GestureRecognitionPipeline::clearAll(){ return clear(); }
 
+bool GestureRecognitionPipeline::setCrossValidationRandomSeed(const unsigned long long crossValidationRandomSeed){
+    this->crossValidationRandomSeed = crossValidationRandomSeed;
+    return true;
+}
+
+unsigned long long GestureRecognitionPipeline::getCrossValidationRandomSeed() const{
+    return crossValidationRandomSeed;
+}
+
+bool GestureRecognitionPipeline::setProfilingEnabled(const bool profilingEnabled){
+    this->profilingEnabled = profilingEnabled;
+    return true;
+}
+
+bool GestureRecognitionPipeline::getProfilingEnabled() const{
+    return profilingEnabled;
+}
+
+const PipelineProfiler& GestureRecognitionPipeline::getProfiler() const{
+    return profiler;
+}
+
+bool GestureRecognitionPipeline::resetProfiler(){
+    return profiler.reset();
+}
+
 bool GestureRecognitionPipeline::clear(){
 
     //Clear the entire pipeline
@@ -2313,6 +2751,11 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const std::string &filenam
     
 bool GestureRecognitionPipeline::load(const std::string &filename){
     
+    //Binary pipeline files are detected from their header
+    if( BinaryModelReader::isBinaryModelFile( filename ) ){
+        return loadBinary( filename );
+    }
+    
     std::fstream file;
 
 	//Clear any previous setup
@@ -2576,36 +3019,287 @@ bool GestureRecognitionPipeline::load(const std::string &filename){
     file.close();
     
     //Set the expected input Vector size
+    updateInputVectorDimensions();
+
+    //Flag that the pipeline is now initialized
+    initialized = true;
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::saveBinary(const std::string &filename) const {
+    
+    if( !initialized ){
+        errorLog << "saveBinary(string filename) - Failed to write pipeline to file as the pipeline has not been initialized yet!" << std::endl;
+        return false;
+    }
+    
+    BinaryModelWriter file;
+    
+    if( !file.open( filename ) ){
+        errorLog << "saveBinary(string filename) - Failed to open file with filename: " << filename << std::endl;
+        return false;
+    }
+    
+    //Write the pipeline header info
+    file.beginSection( "GRT_PIPELINE" );
+    file.writeUInt( pipelineMode );
+    file.writeBool( getTrained() );
+    file.writeString( info );
+    
+    //Write the module datatype names, so the loader can create each module before it is loaded
+    file.writeUInt( getNumPreProcessingModules() );
+    for(UINT i=0; i<getNumPreProcessingModules(); i++){
+        file.writeString( preProcessingModules[i]->getPreProcessingType() );
+    }
+    
+    file.writeUInt( getNumFeatureExtractionModules() );
+    for(UINT i=0; i<getNumFeatureExtractionModules(); i++){
+        file.writeString( featureExtractionModules[i]->getFeatureExtractionType() );
+    }
+    
+    const MLBase *model = NULL;
+    std::string modelType = "NOT_SET";
+    switch( pipelineMode ){
+        case CLASSIFICATION_MODE:
+            if( getIsClassifierSet() ){ model = classifier; modelType = classifier->getClassifierType(); }
+            break;
+        case REGRESSION_MODE:
+            if( getIsRegressifierSet() ){ model = regressifier; modelType = regressifier->getRegressifierType(); }
+            break;
+        case CLUSTER_MODE:
+            if( getIsClustererSet() ){ model = clusterer; modelType = clusterer->getClustererType(); }
+            break;
+        default:
+            break;
+    }
+    file.writeString( modelType );
+    
+    file.writeUInt( getNumPostProcessingModules() );
+    for(UINT i=0; i<getNumPostProcessingModules(); i++){
+        file.writeString( postProcessingModules[i]->getPostProcessingType() );
+    }
+    
+    //Write each module to its own section
+    for(UINT i=0; i<getNumPreProcessingModules(); i++){
+        file.beginSection( "PreProcessingModule_" + Util::intToString(i+1) );
+        if( !preProcessingModules[i]->saveBinary( file ) ){
+            errorLog << "saveBinary(string filename) - Failed to write preprocessing module " << i << " settings to file!" << std::endl;
+            return false;
+        }
+        file.endSection();
+    }
+    
+    for(UINT i=0; i<getNumFeatureExtractionModules(); i++){
+        file.beginSection( "FeatureExtractionModule_" + Util::intToString(i+1) );
+        if( !featureExtractionModules[i]->saveBinary( file ) ){
+            errorLog << "saveBinary(string filename) - Failed to write feature extraction module " << i << " settings to file!" << std::endl;
+            return false;
+        }
+        file.endSection();
+    }
+    
+    if( model != NULL ){
+        file.beginSection( "Model" );
+        if( !model->saveBinary( file ) ){
+            errorLog << "saveBinary(string filename) - Failed to write " << modelType << " model to file!" << std::endl;
+            return false;
+        }
+        file.endSection();
+    }
+    
+    for(UINT i=0; i<getNumPostProcessingModules(); i++){
+        file.beginSection( "PostProcessingModule_" + Util::intToString(i+1) );
+        if( !postProcessingModules[i]->saveBinary( file ) ){
+            errorLog << "saveBinary(string filename) - Failed to write post processing module " << i << " settings to file!" << std::endl;
+            return false;
+        }
+        file.endSection();
+    }
+    
+    file.endSection();
+    
+    if( !file.close() ){
+        errorLog << "saveBinary(string filename) - Failed to close file: " << filename << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
+bool GestureRecognitionPipeline::loadBinary(const std::string &filename){
+    
+    //Clear any previous setup
+    clear();
+    
+    BinaryModelReader file;
+    
+    if( !file.open( filename ) ){
+        errorLog << "loadBinary(string filename) - Failed to open file with filename: " << filename << std::endl;
+        return false;
+    }
+    
+    if( !file.beginSection( "GRT_PIPELINE" ) ){
+        errorLog << "loadBinary(string filename) - Failed to read file header" << std::endl;
+        return false;
+    }
+    
+    UINT numModules = 0;
+    std::string moduleType;
+    bool pipelineTrained = false;
+    if( !file.readUInt( pipelineMode ) || !file.readBool( pipelineTrained ) || !file.readString( info ) ){
+        errorLog << "loadBinary(string filename) - Failed to read the pipeline settings" << std::endl;
+        clear();
+        return false;
+    }
+    
+    //Create each of the modules
+    if( !file.readUInt( numModules ) ){
+        errorLog << "loadBinary(string filename) - Failed to read the number of preprocessing modules" << std::endl;
+        clear();
+        return false;
+    }
+    preProcessingModules.resize( numModules, NULL );
+    for(UINT i=0; i<numModules; i++){
+        if( file.readString( moduleType ) ) preProcessingModules[i] = PreProcessing::createInstanceFromString( moduleType );
+        if( preProcessingModules[i] == NULL ){
+            errorLog << "loadBinary(string filename) - Failed to create preprocessing instance from string: " << moduleType << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    if( !file.readUInt( numModules ) ){
+        errorLog << "loadBinary(string filename) - Failed to read the number of feature extraction modules" << std::endl;
+        clear();
+        return false;
+    }
+    featureExtractionModules.resize( numModules, NULL );
+    for(UINT i=0; i<numModules; i++){
+        if( file.readString( moduleType ) ) featureExtractionModules[i] = FeatureExtraction::createInstanceFromString( moduleType );
+        if( featureExtractionModules[i] == NULL ){
+            errorLog << "loadBinary(string filename) - Failed to create feature extraction instance from string: " << moduleType << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    MLBase *model = NULL;
+    if( !file.readString( moduleType ) ){
+        errorLog << "loadBinary(string filename) - Failed to read the model type" << std::endl;
+        clear();
+        return false;
+    }
+    if( moduleType != "NOT_SET" ){
+        switch( pipelineMode ){
+            case CLASSIFICATION_MODE:
+                model = classifier = Classifier::createInstanceFromString( moduleType );
+                break;
+            case REGRESSION_MODE:
+                model = regressifier = Regressifier::createInstanceFromString( moduleType );
+                break;
+            case CLUSTER_MODE:
+                model = clusterer = Clusterer::createInstanceFromString( moduleType );
+                break;
+            default:
+                break;
+        }
+        if( model == NULL ){
+            errorLog << "loadBinary(string filename) - Failed to create model instance from string: " << moduleType << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    if( !file.readUInt( numModules ) ){
+        errorLog << "loadBinary(string filename) - Failed to read the number of post processing modules" << std::endl;
+        clear();
+        return false;
+    }
+    postProcessingModules.resize( numModules, NULL );
+    for(UINT i=0; i<numModules; i++){
+        if( file.readString( moduleType ) ) postProcessingModules[i] = PostProcessing::createInstanceFromString( moduleType );
+        if( postProcessingModules[i] == NULL ){
+            errorLog << "loadBinary(string filename) - Failed to create post processing instance from string: " << moduleType << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    //Load the module data from each section
+    for(UINT i=0; i<preProcessingModules.getSize(); i++){
+        if( !file.beginSection( "PreProcessingModule_" + Util::intToString(i+1) ) || !preProcessingModules[i]->loadBinary( file ) || !file.endSection() ){
+            errorLog << "loadBinary(string filename) - Failed to load preprocessing module " << i << " settings from file!" << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    for(UINT i=0; i<featureExtractionModules.getSize(); i++){
+        if( !file.beginSection( "FeatureExtractionModule_" + Util::intToString(i+1) ) || !featureExtractionModules[i]->loadBinary( file ) || !file.endSection() ){
+            errorLog << "loadBinary(string filename) - Failed to load feature extraction module " << i << " settings from file!" << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    if( model != NULL ){
+        if( !file.beginSection( "Model" ) || !model->loadBinary( file ) || !file.endSection() ){
+            errorLog << "loadBinary(string filename) - Failed to load model from file!" << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    for(UINT i=0; i<postProcessingModules.getSize(); i++){
+        if( !file.beginSection( "PostProcessingModule_" + Util::intToString(i+1) ) || !postProcessingModules[i]->loadBinary( file ) || !file.endSection() ){
+            errorLog << "loadBinary(string filename) - Failed to load post processing module " << i << " settings from file!" << std::endl;
+            clear();
+            return false;
+        }
+    }
+    
+    file.endSection();
+    file.close();
+    
+    trained = pipelineTrained;
+    
+    //Set the expected input Vector size
+    updateInputVectorDimensions();
+    
+    //Flag that the pipeline is now initialized
+    initialized = true;
+    
+    return true;
+}
+
+void GestureRecognitionPipeline::updateInputVectorDimensions(){
+    
     inputVectorDimensions = 0;
     
-    if( numPreprocessingModules > 0 ){
+    if( getNumPreProcessingModules() > 0 ){
         inputVectorDimensions = preProcessingModules[0]->getNumInputDimensions();
     }else{
-        if( numFeatureExtractionModules > 0 ){
+        if( getNumFeatureExtractionModules() > 0 ){
             inputVectorDimensions = featureExtractionModules[0]->getNumInputDimensions();
         }else{
             switch( pipelineMode ){
                 case PIPELINE_MODE_NOT_SET:
                     break;
                 case CLASSIFICATION_MODE:
-                    inputVectorDimensions = classifier->getNumInputDimensions();
+                    if( getIsClassifierSet() ) inputVectorDimensions = classifier->getNumInputDimensions();
                     break;
                 case REGRESSION_MODE:
-                    inputVectorDimensions = regressifier->getNumInputDimensions();
+                    if( getIsRegressifierSet() ) inputVectorDimensions = regressifier->getNumInputDimensions();
                     break;
                 case CLUSTER_MODE:
-                    inputVectorDimensions = clusterer->getNumInputDimensions();
+                    if( getIsClustererSet() ) inputVectorDimensions = clusterer->getNumInputDimensions();
                     break;
                 default:
                     break;
             }
         }
     }
-
-    //Flag that the pipeline is now initialized
-    initialized = true;
-    
-    return true;
 }
     
 bool GestureRecognitionPipeline::preProcessData(VectorFloat inputVector,bool computeFeatures){
@@ -3531,6 +4225,9 @@ bool GestureRecognitionPipeline::init(){
     testRejectionRecall = 0;
     testTime = 0;
     trainingTime = 0;
+    crossValidationRandomSeed = 0;
+    profilingEnabled = false;
+    profiler.reset();
     classifier = NULL;
     regressifier = NULL;
     clusterer = NULL;
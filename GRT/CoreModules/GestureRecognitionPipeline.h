@@ -46,6 +46,7 @@
 #include "../DataStructures/ClassificationDataStream.h"
 #include "../Util/ClassificationResult.h"
 #include "../Util/TestResult.h"
+#include "../Util/PipelineProfiler.h"
 
 GRT_BEGIN_NAMESPACE
     
@@ -140,6 +141,9 @@ public:
      the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the 
      training function of the Classification module that has been added to the GestureRecognitionPipeline.  
      The function will return true if the classifier was trained successfully, false otherwise.
+     The folds are trained and tested in parallel (using up to ThreadPool::getThreadPoolSize() threads), each with its own copy of the pipeline, and the
+     results are merged in fold order. After training, the pipeline is set to the copy that was trained with the last fold. Any training or test results
+     observers will be notified from several threads, so they should be thread safe.
 
 	@param trainingData: the labelled classification training data that will be used to train the classifier at the core of the pipeline
 	@param kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples int the LabelledClassificationData
@@ -163,6 +167,9 @@ public:
      This is the main training interface for training a Classifier with TimeSeriesClassificationData using K-fold cross validation.
      This function will pass the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the training function of the Classification module that has been added to the GestureRecognitionPipeline.
      The function will return true if the classifier was trained successfully, false otherwise.
+     The folds are trained and tested in parallel (using up to ThreadPool::getThreadPoolSize() threads), each with its own copy of the pipeline, and the
+     results are merged in fold order. After training, the pipeline is set to the copy that was trained with the last fold. Any training or test results
+     observers will be notified from several threads, so they should be thread safe.
      
      @param trainingData: the labelled time-series classification training data that will be used to train the classifier at the core of the pipeline
      @param kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples in the LabelledClassificationData
@@ -198,6 +205,9 @@ public:
      the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the
      training function of the Regression module that has been added to the GestureRecognitionPipeline.
      The function will return true if the regressifier was trained successfully, false otherwise.
+     The folds are trained and tested in parallel (using up to ThreadPool::getThreadPoolSize() threads), each with its own copy of the pipeline, and the
+     results are merged in fold order. After training, the pipeline is set to the copy that was trained with the last fold. Any training or test results
+     observers will be notified from several threads, so they should be thread safe.
      
      @param trainingData: the labelled regression training data that will be used to train the regressifier at the core of the pipeline
      @param kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples in the LabelledRegressionData
@@ -277,6 +287,21 @@ public:
      @return bool returns true if the prediction was successful, false otherwise
      */
     bool predict(const MatrixFloat &inputMatrix);
+    
+    /**
+     This function is the const prediction interface for the gesture recognition pipeline, it can be used for classification, regression and clustering.
+     Unlike the main predict function, this does not change the pipeline, the results (and any state that needs to be kept between predictions) are stored
+     in the context instead. This means one trained pipeline can be used by several streams or threads at once, as long as each one uses its own context.
+     
+     The pre processing, feature extraction, post processing and context modules keep their own state (e.g. filter buffers), so each context
+     has its own copy of these modules, which are created the first time the context is used with this pipeline. The classifier, regressifier or clusterer
+     is shared by all the contexts (if it supports const prediction). The context should be cleared if the pipeline is retrained or changed.
+     
+     @param inputVector: the input data that will be passed through the pipeline
+     @param context: the context that will be used for the prediction, this will be updated with the results of the prediction
+     @return bool returns true if the prediction was successful, false otherwise
+     */
+    bool predict(const VectorFloat &inputVector,PredictionContext &context) const;
 
     /**
      This function is now depreciated, you should use the predict function instead.
@@ -330,7 +355,7 @@ public:
 
     /**
      This function will load an entire pipeline from a file.  This includes all the modules types, settings, and models.
-     This calls the older loadPipelineFromFile function
+     Binary pipeline files (saved with saveBinary) are detected automatically and loaded with loadBinary.
      
      @param filename: the name of the file you want to load the pipeline from
      @return bool returns true if the pipeline was loaded successful, false otherwise
@@ -344,6 +369,24 @@ public:
 	*/
     GRT_DEPRECATED_MSG( "loadPipelineFromFile(std::string filename) is deprecated, use load(std::string &filename) instead", bool loadPipelineFromFile(const std::string &filename) );
     
+    /**
+     This function will save the entire pipeline to a binary model file.  Each module is written to its own section in the file,
+     modules that do not have a native binary format are stored using their text format.  Binary files are faster to load than
+     text files, and large models can be read directly from a memory mapped file.
+     
+     @param filename: the name of the file you want to save the pipeline to
+     @return bool returns true if the pipeline was saved successful, false otherwise
+     */
+    bool saveBinary(const std::string &filename) const;
+    
+    /**
+     This function will load an entire pipeline from a binary model file that was saved with saveBinary.
+     
+     @param filename: the name of the file you want to load the pipeline from
+     @return bool returns true if the pipeline was loaded successful, false otherwise
+     */
+    bool loadBinary(const std::string &filename);
+    
     /**
      This function will pass the input Vector through any preprocessing or feature extraction modules added to the pipeline.  This function
      can be useful for testing and validating a preprocessing or feature extraction module, without having to acutally train a classification or
@@ -1186,13 +1229,67 @@ public:
      */
     bool setInfo(const std::string &info);
 
+    /**
+     Sets the seed used to randomly split the training data into folds when the pipeline is trained with cross validation. If the seed is
+     zero (the default) the seed is set from the system time, so each call to train uses different folds. With a fixed seed the folds are
+     the same for every call to train, so the cross validation results only depend on the modules in the pipeline.
+
+     @param crossValidationRandomSeed: the new seed
+     @return returns true if the seed was updated successfully, false otherwise
+     */
+    bool setCrossValidationRandomSeed(const unsigned long long crossValidationRandomSeed);
+
+    /**
+     Gets the seed used to randomly split the training data into folds when the pipeline is trained with cross validation.
+
+     @return returns the seed, zero means the seed is set from the system time
+     */
+    unsigned long long getCrossValidationRandomSeed() const;
+
+    /**
+     Enables or disables the profiling of the predictions. If profiling is enabled, the latency of each prediction and of each module in the
+     pipeline is recorded, along with the number of predictions, rejections and allocations, these can be accessed via getProfiler().
+     Profiling is disabled by default, when it is disabled the pipeline does not record anything. The predictions made with a PredictionContext
+     are not profiled.
+
+     @param profilingEnabled: true if the predictions should be profiled, false otherwise
+     @return returns true if the profiling state was updated successfully, false otherwise
+     */
+    bool setProfilingEnabled(const bool profilingEnabled);
+
+    /**
+     Gets if the predictions are being profiled.
+
+     @return returns true if profiling is enabled, false otherwise
+     */
+    bool getProfilingEnabled() const;
+
+    /**
+     Gets the profiler that records the latencies and counters of the predictions. The latencies are recorded per stage and per module index,
+     so the profiler should be reset if any modules are added or removed. For example, pipeline.getProfiler().getStatsAsString() returns a table
+     with the latency percentiles of each module.
+
+     @return returns a reference to the pipeline's profiler
+     */
+    const PipelineProfiler& getProfiler() const;
+
+    /**
+     Clears all the latencies and counters recorded by the profiler.
+
+     @return returns true if the profiler was reset successfully, false otherwise
+     */
+    bool resetProfiler();
+
 protected:
     bool predict_classifier(const VectorFloat &inputVector);
     bool predict_timeseries( const MatrixFloat &input );
     bool predict_frame( const MatrixFloat &input );
     bool predict_regressifier(const VectorFloat &inputVector);
     bool predict_clusterer(const VectorFloat &inputVector);
+    bool setupPredictionContext(PredictionContext &context) const;
+    bool processContextModules(const UINT contextLevel,VectorFloat &data,PredictionContext &context,bool &okToContinue) const;
     bool init();
+    void updateInputVectorDimensions();
     void deleteAllPreProcessingModules();
     void deleteAllFeatureExtractionModules();
     void deleteClassifier();
@@ -1202,6 +1299,9 @@ protected:
     void deleteAllContextModules();
     bool updateTestMetrics(const UINT classLabel,const UINT predictedClassLabel,VectorFloat &precisionCounter,VectorFloat &recallCounter,Float &rejectionPrecisionCounter,Float &rejectionRecallCounter,VectorFloat &confusionMatrixCounter);
     bool computeTestMetrics(VectorFloat &precisionCounter,VectorFloat &recallCounter,Float &rejectionPrecisionCounter,Float &rejectionRecallCounter,VectorFloat &confusionMatrixCounter,const UINT numTestSamples);
+    bool testSubset(const ClassificationData &testData,const Vector< UINT > &testIndexes);
+    bool testSubset(const TimeSeriesClassificationData &testData,const Vector< UINT > &testIndexes);
+    bool testSubset(const RegressionData &testData,const Vector< UINT > &testIndexes);
     
     bool initialized;
     bool trained;
@@ -1228,6 +1328,9 @@ protected:
     MatrixFloat testConfusionMatrix;
     Vector< TestResult > crossValidationResults;
     Vector< TestInstanceResult > testResults;
+    unsigned long long crossValidationRandomSeed;
+    bool profilingEnabled;
+    PipelineProfiler profiler;
     
     Vector< PreProcessing* > preProcessingModules;
     Vector< FeatureExtraction* > featureExtractionModules;
@@ -169,6 +169,11 @@ bool MLBase::saveModelToFile(std::fstream &file) const { return save( file ); }
 
 bool MLBase::load(const std::string filename){
     
+    //Check to see if this is a binary model file
+    if( BinaryModelReader::isBinaryModelFile( filename ) ){
+        return loadBinary( filename );
+    }
+    
     std::fstream file;
     file.open(filename.c_str(), std::ios::in);
     
@@ -186,6 +191,78 @@ bool MLBase::load(std::fstream &file) {
     return false; //The base class returns false, as this should be overwritten by the inheriting class
 }
 
+bool MLBase::saveBinary(const std::string filename) const {
+    
+    if( !trained ) return false;
+    
+    BinaryModelWriter file;
+    if( !file.open( filename ) ){
+        errorLog << "saveBinary(const std::string filename) - Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    
+    //Store the type of the model, so the file can only be loaded by the same type of model
+    file.beginSection( "GRT_MODEL" );
+    file.writeUInt( baseType );
+    file.writeString( classType );
+    
+    if( !saveBinary( file ) ){
+        errorLog << "saveBinary(const std::string filename) - Failed to save model to file: " << filename << std::endl;
+        return false;
+    }
+    
+    file.endSection();
+    
+    return file.close();
+}
+
+bool MLBase::loadBinary(const std::string filename){
+    
+    BinaryModelReader file;
+    if( !file.open( filename ) ){
+        errorLog << "loadBinary(const std::string filename) - Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    
+    UINT modelBaseType = 0;
+    std::string modelType;
+    if( !file.beginSection( "GRT_MODEL" ) || !file.readUInt( modelBaseType ) || !file.readString( modelType ) ){
+        errorLog << "loadBinary(const std::string filename) - Failed to read model header from file: " << filename << std::endl;
+        return false;
+    }
+    
+    if( modelBaseType != baseType || modelType != classType ){
+        errorLog << "loadBinary(const std::string filename) - The file contains a " << modelType << " model, which can not be loaded by a " << classType << " model!" << std::endl;
+        return false;
+    }
+    
+    if( !loadBinary( file ) ){
+        errorLog << "loadBinary(const std::string filename) - Failed to load model from file: " << filename << std::endl;
+        return false;
+    }
+    
+    return file.endSection();
+}
+
+bool MLBase::saveBinary(BinaryModelWriter &file) const {
+    
+    //Store the text model in the binary file
+    if( !save( file.beginText() ) ){
+        file.endText();
+        return false;
+    }
+    
+    return file.endText();
+}
+
+bool MLBase::loadBinary(BinaryModelReader &file) {
+    
+    //Load the text model stored by the base class saveBinary function
+    const bool modelLoaded = load( file.beginText() );
+    
+    return file.endText() && modelLoaded;
+}
+
 bool MLBase::loadModelFromFile(std::string filename){ return load( filename ); }
 
 bool MLBase::loadModelFromFile(std::fstream &file){ return load( file ); }
@@ -517,4 +594,48 @@ bool MLBase::loadBaseSettingsFromFile( std::fstream &file ){
     return true;
 }
 
+bool MLBase::saveBaseSettingsToBinaryFile( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBaseSettingsToBinaryFile(BinaryModelWriter &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    file.writeBool( trained );
+    file.writeBool( useScaling );
+    file.writeUInt( numInputDimensions );
+    file.writeUInt( numOutputDimensions );
+    file.writeUInt( numTrainingIterationsToConverge );
+    file.writeUInt( minNumEpochs );
+    file.writeUInt( maxNumEpochs );
+    file.writeUInt( validationSetSize );
+    file.writeFloat( learningRate );
+    file.writeFloat( minChange );
+    file.writeBool( useValidationSet );
+    
+    return file.writeBool( randomiseTrainingOrder );
+}
+
+bool MLBase::loadBaseSettingsFromBinaryFile( BinaryModelReader &file ){
+    
+    //Clear any previous setup
+    clear();
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    if( !file.readBool( trained ) || !file.readBool( useScaling ) || !file.readUInt( numInputDimensions ) || !file.readUInt( numOutputDimensions ) ||
+        !file.readUInt( numTrainingIterationsToConverge ) || !file.readUInt( minNumEpochs ) || !file.readUInt( maxNumEpochs ) ||
+        !file.readUInt( validationSetSize ) || !file.readFloat( learningRate ) || !file.readFloat( minChange ) ||
+        !file.readBool( useValidationSet ) || !file.readBool( randomiseTrainingOrder ) ){
+        errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - Failed to read the base settings!" << std::endl;
+        clear();
+        return false;
+    }
+    
+    return true;
+}
+
 GRT_END_NAMESPACE
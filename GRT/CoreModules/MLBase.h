@@ -37,6 +37,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../DataStructures/ClassificationDataStream.h"
 #include "../DataStructures/RegressionData.h"
 #include "../DataStructures/TimeSeriesClassificationData.h"
+#include "../Util/BinaryModelFile.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -278,6 +279,7 @@ public:
     
     /**
     This saves the model to a file, it calls the loadModelFromFile(std::string filename) function unless it is overwritten by the derived class.
+    If the file is a binary model file (see saveBinary) then it will be loaded with the loadBinary(std::string filename) function.
     
     @param filename: the name of the file to save the model to
     @return returns true if the model was saved successfully, false otherwise
@@ -302,6 +304,42 @@ public:
     */
     virtual bool load(std::fstream &file);
     
+    /**
+    This saves the trained model to a binary model file. Binary files are smaller and much faster to load than text files, and can be
+    loaded with either the load(std::string filename) or loadBinary(std::string filename) functions.
+    
+    @param filename: the name of the file to save the model to
+    @return returns true if the model was saved successfully, false otherwise
+    */
+    bool saveBinary(const std::string filename) const;
+    
+    /**
+    This loads a trained model from a binary model file. The file must contain the same type of model as this instance.
+    
+    @param filename: the name of the file to load the model from
+    @return returns true if the model was loaded successfully, false otherwise
+    */
+    bool loadBinary(const std::string filename);
+    
+    /**
+    This saves the trained model to a binary model file.
+    The base class stores the text model from the save(std::fstream &file) function in the binary file, classes with large models
+    should override this function (and loadBinary) to write the model in the binary format.
+    
+    @param file: a reference to the binary file the model will be saved to
+    @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveBinary(BinaryModelWriter &file) const;
+    
+    /**
+    This loads a trained model from a binary model file.
+    The base class loads the text model that was stored by the base class saveBinary function.
+    
+    @param file: a reference to the binary file the model will be loaded from
+    @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadBinary(BinaryModelReader &file);
+    
     /**
     @deprecated use save(std::string filename) instead
     @param the name of the file to save the model to
@@ -350,7 +388,7 @@ public:
     @param constrain: sets if the scaled value should be constrained to the target range
     @return returns a new value that has been scaled based on the input parameters
     */
-    Float inline scale(const Float &x,const Float &minSource,const Float &maxSource,const Float &minTarget,const Float &maxTarget,const bool constrain=false){
+    Float inline scale(const Float &x,const Float &minSource,const Float &maxSource,const Float &minTarget,const Float &maxTarget,const bool constrain=false) const{
         if( constrain ){
             if( x <= minSource ) return minTarget;
             if( x >= maxSource ) return maxTarget;
@@ -744,6 +782,20 @@ protected:
     */
     bool loadBaseSettingsFromFile( std::fstream &file );
     
+    /**
+    Saves the core base settings to a binary file.
+    
+    @return returns true if the base settings were saved, false otherwise
+    */
+    bool saveBaseSettingsToBinaryFile( BinaryModelWriter &file ) const;
+    
+    /**
+    Loads the core base settings from a binary file.
+    
+    @return returns true if the base settings were loaded, false otherwise
+    */
+    bool loadBaseSettingsFromBinaryFile( BinaryModelReader &file );
+    
     bool trained;
     bool useScaling;
     DataType inputType;
@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 PostProcessing::StringPostProcessingMap* PostProcessing::stringPostProcessingMap = NULL;
-UINT PostProcessing::numPostProcessingInstances = 0;
+InstanceCounter PostProcessing::numPostProcessingInstances( 0 );
     
 PostProcessing* PostProcessing::createInstanceFromString(std::string const &postProcessingType){
     
@@ -234,7 +234,7 @@ protected:
 
 private:
     static StringPostProcessingMap *stringPostProcessingMap;
-    static UINT numPostProcessingInstances;
+    static InstanceCounter numPostProcessingInstances;
 };
 
 //These two functions/classes are used to register any new PostProcessing Module with the PostProcessing base class
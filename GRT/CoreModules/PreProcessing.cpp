@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 PreProcessing::StringPreProcessingMap* PreProcessing::stringPreProcessingMap = NULL;
-UINT PreProcessing::numPreProcessingInstances = 0;
+InstanceCounter PreProcessing::numPreProcessingInstances( 0 );
     
 PreProcessing* PreProcessing::createInstanceFromString( const std::string &preProcessingType ){
     
@@ -171,7 +171,7 @@ protected:
 
 private:
     static StringPreProcessingMap *stringPreProcessingMap;
-    static UINT numPreProcessingInstances;
+    static InstanceCounter numPreProcessingInstances;
 };
 
 //These two functions/classes are used to register any new PreProcessing Module with the PreProcessing base class
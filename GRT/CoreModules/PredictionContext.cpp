@@ -0,0 +1,186 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "PredictionContext.h"
+#include "Classifier.h"
+#include "Regressifier.h"
+#include "Clusterer.h"
+#include "PreProcessing.h"
+#include "FeatureExtraction.h"
+#include "PostProcessing.h"
+#include "Context.h"
+
+GRT_BEGIN_NAMESPACE
+
+PredictionContext::PredictionContext(){
+    owner = NULL;
+    classifier = NULL;
+    regressifier = NULL;
+    clusterer = NULL;
+    modelContext = NULL;
+    clear();
+}
+
+PredictionContext::PredictionContext(const PredictionContext &rhs){
+    owner = NULL;
+    classifier = NULL;
+    regressifier = NULL;
+    clusterer = NULL;
+    modelContext = NULL;
+    copyFrom( rhs );
+}
+
+PredictionContext::~PredictionContext(){
+    clearModules();
+}
+
+PredictionContext& PredictionContext::operator=(const PredictionContext &rhs){
+    if( this != &rhs ){
+        copyFrom( rhs );
+    }
+    return *this;
+}
+
+bool PredictionContext::clear(){
+
+    predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+    predictedClusterLabel = 0;
+    maxLikelihood = 0;
+    bestDistance = 0;
+    phase = 0;
+    classLikelihoods.clear();
+    classDistances.clear();
+    clusterLikelihoods.clear();
+    clusterDistances.clear();
+    regressionData.clear();
+    workspace.clear();
+    inputDataBuffer.clear();
+
+    return clearModules();
+}
+
+bool PredictionContext::copyFrom(const PredictionContext &rhs){
+
+    clearModules();
+
+    predictedClassLabel = rhs.predictedClassLabel;
+    predictedClusterLabel = rhs.predictedClusterLabel;
+    maxLikelihood = rhs.maxLikelihood;
+    bestDistance = rhs.bestDistance;
+    phase = rhs.phase;
+    classLikelihoods = rhs.classLikelihoods;
+    classDistances = rhs.classDistances;
+    clusterLikelihoods = rhs.clusterLikelihoods;
+    clusterDistances = rhs.clusterDistances;
+    regressionData = rhs.regressionData;
+    workspace = rhs.workspace;
+    inputDataBuffer = rhs.inputDataBuffer;
+    owner = rhs.owner;
+
+    //Deep copy the per-stream modules, so the new context continues from the same state as the rhs context
+    bool ok = true;
+    if( rhs.classifier != NULL ){
+        classifier = rhs.classifier->deepCopy();
+        if( classifier == NULL ) ok = false;
+    }
+    if( rhs.regressifier != NULL ){
+        regressifier = rhs.regressifier->deepCopy();
+        if( regressifier == NULL ) ok = false;
+    }
+    if( rhs.clusterer != NULL ){
+        clusterer = rhs.clusterer->deepCopy();
+        if( clusterer == NULL ) ok = false;
+    }
+    for(UINT i=0; i<rhs.preProcessingModules.getSize(); i++){
+        preProcessingModules.push_back( copyModule( rhs.preProcessingModules[i] ) );
+        if( preProcessingModules.back() == NULL ) ok = false;
+    }
+    for(UINT i=0; i<rhs.featureExtractionModules.getSize(); i++){
+        featureExtractionModules.push_back( copyModule( rhs.featureExtractionModules[i] ) );
+        if( featureExtractionModules.back() == NULL ) ok = false;
+    }
+    for(UINT i=0; i<rhs.postProcessingModules.getSize(); i++){
+        postProcessingModules.push_back( copyModule( rhs.postProcessingModules[i] ) );
+        if( postProcessingModules.back() == NULL ) ok = false;
+    }
+    contextModules.resize( rhs.contextModules.getSize() );
+    for(UINT k=0; k<rhs.contextModules.getSize(); k++){
+        for(UINT i=0; i<rhs.contextModules[k].getSize(); i++){
+            contextModules[k].push_back( copyModule( rhs.contextModules[k][i] ) );
+            if( contextModules[k].back() == NULL ) ok = false;
+        }
+    }
+    if( rhs.modelContext != NULL ){
+        modelContext = new PredictionContext( *rhs.modelContext );
+    }
+
+    //If any of the modules could not be copied then the per-stream state is incomplete, so remove it all and start again from the next prediction
+    if( !ok ){
+        clearModules();
+        inputDataBuffer.clear();
+    }
+
+    return ok;
+}
+
+bool PredictionContext::clearModules(){
+
+    owner = NULL;
+
+    if( classifier != NULL ){
+        delete classifier;
+        classifier = NULL;
+    }
+    if( regressifier != NULL ){
+        delete regressifier;
+        regressifier = NULL;
+    }
+    if( clusterer != NULL ){
+        delete clusterer;
+        clusterer = NULL;
+    }
+    for(UINT i=0; i<preProcessingModules.getSize(); i++){
+        if( preProcessingModules[i] != NULL ) delete preProcessingModules[i];
+    }
+    preProcessingModules.clear();
+    for(UINT i=0; i<featureExtractionModules.getSize(); i++){
+        if( featureExtractionModules[i] != NULL ) delete featureExtractionModules[i];
+    }
+    featureExtractionModules.clear();
+    for(UINT i=0; i<postProcessingModules.getSize(); i++){
+        if( postProcessingModules[i] != NULL ) delete postProcessingModules[i];
+    }
+    postProcessingModules.clear();
+    for(UINT k=0; k<contextModules.getSize(); k++){
+        for(UINT i=0; i<contextModules[k].getSize(); i++){
+            if( contextModules[k][i] != NULL ) delete contextModules[k][i];
+        }
+    }
+    contextModules.clear();
+    if( modelContext != NULL ){
+        delete modelContext;
+        modelContext = NULL;
+    }
+
+    return true;
+}
+
+GRT_END_NAMESPACE
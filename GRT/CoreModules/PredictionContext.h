@@ -0,0 +1,134 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GRT_PREDICTION_CONTEXT_HEADER
+#define GRT_PREDICTION_CONTEXT_HEADER
+
+#include "../Util/GRTCommon.h"
+
+GRT_BEGIN_NAMESPACE
+
+class Classifier;
+class Regressifier;
+class Clusterer;
+class PreProcessing;
+class FeatureExtraction;
+class PostProcessing;
+class Context;
+
+/**
+ PredictionContext holds the state of one stream of predictions, together with the results of the most recent prediction.
+
+ The const predict(const VectorFloat &inputVector,PredictionContext &context) functions in the Classifier, Regressifier, Clusterer
+ and GestureRecognitionPipeline classes only read the trained model, storing everything that changes from one prediction to the next
+ in the context instead. This lets a single trained model be shared by several streams (or threads), with each stream using its own context.
+
+ Modules that do not support const prediction yet keep a copy of the model in the context, so they still work but do not save any memory.
+ A context should be cleared if the model that uses it is retrained or loaded.
+*/
+class GRT_API PredictionContext{
+public:
+    /**
+    Default Constructor
+    */
+    PredictionContext();
+
+    /**
+    Copy Constructor, copies the results and deep copies any per-stream state from the rhs context.
+
+    @param rhs: another instance of a PredictionContext
+    */
+    PredictionContext(const PredictionContext &rhs);
+
+    /**
+    Default Destructor
+    */
+    ~PredictionContext();
+
+    /**
+    Sets the equals operator, copies the results and deep copies any per-stream state from the rhs context.
+
+    @param rhs: another instance of a PredictionContext
+    @return returns a reference to this instance
+    */
+    PredictionContext& operator=(const PredictionContext &rhs);
+
+    /**
+    Clears the results and any per-stream state, such as buffered input data or the copies of any modules that need their own state.
+    This should be called if the model that uses this context is retrained or loaded.
+
+    @return returns true if the context was cleared, false otherwise
+    */
+    bool clear();
+
+    UINT predictedClassLabel;                       ///< The predicted class label from the most recent prediction
+    UINT predictedClusterLabel;                     ///< The predicted cluster label from the most recent prediction
+    Float maxLikelihood;                            ///< The likelihood of the most likely class (or cluster) from the most recent prediction
+    Float bestDistance;                             ///< The best distance from the most recent prediction
+    Float phase;                                    ///< The estimated gesture phase from the most recent prediction (timeseries classifiers only)
+    VectorFloat classLikelihoods;                   ///< The class likelihoods from the most recent prediction
+    VectorFloat classDistances;                     ///< The class distances from the most recent prediction
+    VectorFloat clusterLikelihoods;                 ///< The cluster likelihoods from the most recent prediction
+    VectorFloat clusterDistances;                   ///< The cluster distances from the most recent prediction
+    VectorFloat regressionData;                     ///< The regression output from the most recent prediction
+    VectorFloat workspace;                          ///< A buffer a module can use for intermediate values, so they are not reallocated for each prediction
+    MultichannelCircularBuffer< Float > inputDataBuffer;  ///< The buffered input data for this stream, used by the timeseries classifiers (e.g. DTW)
+
+protected:
+    bool copyFrom(const PredictionContext &rhs);
+    bool clearModules();
+
+    /**
+    Creates a new instance of the module and deep copies the module into it.
+
+    @param module: a pointer to the module that should be copied
+    @return returns a pointer to the new module, or NULL if the module could not be copied
+    */
+    template< class T >
+    static T* copyModule(const T *module){
+        if( module == NULL ) return NULL;
+        T *newInstance = module->createNewInstance();
+        if( newInstance == NULL ) return NULL;
+        if( !newInstance->deepCopyFrom( module ) ){
+            delete newInstance;
+            return NULL;
+        }
+        return newInstance;
+    }
+
+    const void *owner;                                  ///< The model (or pipeline) that created the modules in this context
+    Classifier *classifier;                             ///< A copy of a classifier that does not support const prediction
+    Regressifier *regressifier;                         ///< A copy of a regressifier that does not support const prediction
+    Clusterer *clusterer;                               ///< A copy of a clusterer that does not support const prediction
+    Vector< PreProcessing* > preProcessingModules;      ///< The pipeline pre processing modules for this stream
+    Vector< FeatureExtraction* > featureExtractionModules; ///< The pipeline feature extraction modules for this stream
+    Vector< PostProcessing* > postProcessingModules;    ///< The pipeline post processing modules for this stream
+    Vector< Vector< Context* > > contextModules;        ///< The pipeline context modules for this stream
+    PredictionContext *modelContext;                    ///< The context used by the pipeline's classifier, regressifier or clusterer
+
+    friend class Classifier;
+    friend class Regressifier;
+    friend class Clusterer;
+    friend class GestureRecognitionPipeline;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_PREDICTION_CONTEXT_HEADER
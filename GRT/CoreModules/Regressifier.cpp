@@ -24,7 +24,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
     
 Regressifier::StringRegressifierMap* Regressifier::stringRegressifierMap = NULL;
-UINT Regressifier::numRegressifierInstances = 0;
+InstanceCounter Regressifier::numRegressifierInstances( 0 );
     
 Regressifier* Regressifier::createInstanceFromString( const std::string &regressifierType ){
     
@@ -52,6 +52,53 @@ Regressifier* Regressifier::deepCopy() const{
     return newInstance;
 }
     
+bool Regressifier::predict(const VectorFloat &inputVector,PredictionContext &context) const{
+    
+    if( !trained ){
+        errorLog << "predict(const VectorFloat &inputVector,PredictionContext &context) - The regressifier has not been trained!" << std::endl;
+        return false;
+    }
+    
+    //The prediction may modify the input (e.g. scaling), so run it on a copy
+    VectorFloat x = inputVector;
+    return predictWithContext_( x, context );
+}
+    
+bool Regressifier::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
+    
+    //This regressifier does not support const prediction, so run the prediction with the copy of this regressifier owned by the context
+    if( context.regressifier == NULL || context.owner != this ){
+        context.clear();
+        context.regressifier = deepCopy();
+        if( context.regressifier == NULL ){
+            errorLog << "predictWithContext_(VectorFloat &inputVector,PredictionContext &context) - Failed to copy the regressifier to the context!" << std::endl;
+            return false;
+        }
+        context.owner = this;
+    }
+    
+    if( !context.regressifier->predict_( inputVector ) ){
+        errorLog << "predictWithContext_(VectorFloat &inputVector,PredictionContext &context) - Prediction failed! " << context.regressifier->getLastErrorMessage() << std::endl;
+        return false;
+    }
+    
+    context.regressionData = context.regressifier->regressionData;
+    
+    return true;
+}
+    
+void Regressifier::swapPredictionResults(PredictionContext &context){
+    regressionData.swap( context.regressionData );
+}
+    
+bool Regressifier::predictAndStoreResults(VectorFloat &inputVector){
+    PredictionContext context;
+    swapPredictionResults( context );
+    bool result = predictWithContext_( inputVector, context );
+    swapPredictionResults( context );
+    return result;
+}
+    
 Regressifier::Regressifier(void){
     baseType = MLBase::REGRESSIFIER;
     regressifierType = "NOT_SET";
@@ -202,4 +249,50 @@ bool Regressifier::loadBaseSettingsFromFile( std::fstream &file ){
     return true;
 }
     
+bool Regressifier::saveBaseSettingsToBinaryFile( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBaseSettingsToBinaryFile(BinaryModelWriter &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    if( !MLBase::saveBaseSettingsToBinaryFile( file ) ) return false;
+    
+    //Write the ranges to the file
+    if( useScaling ){
+        file.writeVector( inputVectorRanges );
+        file.writeVector( targetVectorRanges );
+    }
+    
+    return true;
+}
+
+bool Regressifier::loadBaseSettingsFromBinaryFile( BinaryModelReader &file ){
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - The file is not open!" << std::endl;
+        return false;
+    }
+    
+    //Try and load the base settings from the file
+    if( !MLBase::loadBaseSettingsFromBinaryFile( file ) ){
+        return false;
+    }
+    
+    if( useScaling ){
+        if( !file.readVector( inputVectorRanges ) || !file.readVector( targetVectorRanges ) ){
+            errorLog << "loadBaseSettingsFromBinaryFile(BinaryModelReader &file) - Failed to read the ranges!" << std::endl;
+            return false;
+        }
+    }
+    
+    if( trained ){
+        //Resize the regression data Vector
+        regressionData.clear();
+        regressionData.resize(numOutputDimensions,0);
+    }
+    
+    return true;
+}
+    
 GRT_END_NAMESPACE
@@ -32,6 +32,7 @@
 #define GRT_REGRESSIFIER_HEADER
 
 #include "MLBase.h"
+#include "PredictionContext.h"
 #include "../DataStructures/ClassificationData.h"
 #include "../DataStructures/TimeSeriesClassificationData.h"
 
@@ -85,6 +86,18 @@ public:
      */
     virtual bool clear();
     
+    /**
+     This is the const prediction interface for the regressifier modules. Unlike the main predict function, this only reads the trained model
+     and stores the results (and any state that needs to be kept between predictions) in the context. This means one trained regressifier
+     can be used by several streams or threads at once, as long as each one uses its own context.
+     The results can be accessed via the context, the results stored in the regressifier are not updated.
+     
+     @param inputVector: the new input vector for prediction
+     @param context: the context that will be used for the prediction, this will be updated with the results of the prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    bool predict(const VectorFloat &inputVector,PredictionContext &context) const;
+    
     /**
      Gets the regressifier type as a string. This is the name of the regression algorithm, such as "LinearRegression".
      
@@ -158,8 +171,36 @@ public:
 	
 	//Tell the compiler we are explicitly using the following classes from the base class (this stops hidden overloaded virtual function warnings)
     using MLBase::train;
+    using MLBase::predict;
     
 protected:
+    /**
+     This is the const prediction function that should be overwritten by any derived class that can predict without changing the model.
+     The default function runs the prediction with a copy of this regressifier that is stored in the context, so any regressifier can be used
+     with a context, but only the regressifiers that overwrite this function will share their model between contexts.
+     
+     @param inputVector: a reference to the input vector for prediction, this may be modified by the prediction (e.g. scaled)
+     @param context: the context that will be used for the prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    
+    /**
+     Swaps the prediction results of this regressifier with those in the context. A derived class can use this to implement its predict_ function
+     using its predictWithContext_ function: swap the results into a context, run the prediction, then swap the updated results back.
+     
+     @param context: the context the results should be swapped with
+     */
+    void swapPredictionResults(PredictionContext &context);
+    
+    /**
+     Runs the predictWithContext_ function, using the results of this regressifier as the context, so the results are stored in this regressifier.
+     
+     @param inputVector: a reference to the input vector for prediction
+     @return returns true if the prediction was completed succesfully, false otherwise
+     */
+    bool predictAndStoreResults(VectorFloat &inputVector);
+    
     /**
      Saves the core base settings to a file.
      
@@ -173,6 +214,20 @@ protected:
      @return returns true if the base settings were loaded, false otherwise
      */
     bool loadBaseSettingsFromFile( std::fstream &file );
+    
+    /**
+     Saves the core base settings to a binary file.
+     
+     @return returns true if the base settings were saved, false otherwise
+     */
+    bool saveBaseSettingsToBinaryFile( BinaryModelWriter &file ) const;
+    
+    /**
+     Loads the core base settings from a binary file.
+     
+     @return returns true if the base settings were loaded, false otherwise
+     */
+    bool loadBaseSettingsFromBinaryFile( BinaryModelReader &file );
 
     std::string regressifierType;
     VectorFloat regressionData;
@@ -186,7 +241,7 @@ protected:
     
 private:
     static StringRegressifierMap *stringRegressifierMap;
-    static UINT numRegressifierInstances;
+    static InstanceCounter numRegressifierInstances;
 
 };
     
@@ -838,7 +838,7 @@ bool ClassificationData::merge(const ClassificationData &otherData){
     return true;
 }
 
-bool ClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling){
+bool ClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -876,7 +876,7 @@ bool ClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifi
     crossValidationIndexs.resize(K);
 
 	//Create the random partion indexs
-	Random random;
+	Random random( randomSeed );
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -1010,6 +1010,13 @@ ClassificationData ClassificationData::getTestFoldData(const UINT foldIndex) con
     return testData;
 }
 
+Vector< UINT > ClassificationData::getTestFoldIndexes(const UINT foldIndex) const{
+
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return Vector< UINT >();
+
+    return crossValidationIndexs[ foldIndex ];
+}
+
 ClassificationData ClassificationData::getClassData(const UINT classLabel) const{
     
     ClassificationData classData;
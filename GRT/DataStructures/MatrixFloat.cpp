@@ -20,8 +20,76 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "MatrixFloat.h"
+#include "../Util/ThreadPool.h"
+#include "../Util/Lapack.h"
 
 GRT_BEGIN_NAMESPACE
+
+//Computes rows [rowBegin rowEnd) of c = a * b (or a' * b), where a is MxK (or KxM if aTranspose), b is KxL and c is MxL, all
+//stored contiguously in row-major order. The output rows must be zeroed first. The shared dimension is blocked so the rows
+//of b that are being used stay in the cache, and each 4x4 tile of c is accumulated in registers over the block, so each
+//value loaded from a and b is used four times.
+static void multiplyRows(const Float *pa,const Float *pb,Float *pc,const unsigned int rowBegin,const unsigned int rowEnd,
+                         const unsigned int M,const unsigned int K,const unsigned int L,const bool aTranspose){
+    
+    const unsigned int blockSize = 256;
+    for(unsigned int kk=0; kk<K; kk+=blockSize){
+        const unsigned int kEnd = kk+blockSize < K ? kk+blockSize : K;
+        unsigned int i = rowBegin;
+        for(; i+4<=rowEnd; i+=4){
+            unsigned int j = 0;
+            for(; j+4<=L; j+=4){
+                Float c00=0, c01=0, c02=0, c03=0, c10=0, c11=0, c12=0, c13=0;
+                Float c20=0, c21=0, c22=0, c23=0, c30=0, c31=0, c32=0, c33=0;
+                for(unsigned int k=kk; k<kEnd; k++){
+                    const Float *bk = pb + k*L + j;
+                    const Float b0 = bk[0], b1 = bk[1], b2 = bk[2], b3 = bk[3];
+                    Float a0, a1, a2, a3;
+                    if( aTranspose ){
+                        const Float *ak = pa + k*M + i;
+                        a0 = ak[0]; a1 = ak[1]; a2 = ak[2]; a3 = ak[3];
+                    }else{
+                        const Float *ai = pa + i*K + k;
+                        a0 = ai[0]; a1 = ai[K]; a2 = ai[2*K]; a3 = ai[3*K];
+                    }
+                    c00 += a0*b0; c01 += a0*b1; c02 += a0*b2; c03 += a0*b3;
+                    c10 += a1*b0; c11 += a1*b1; c12 += a1*b2; c13 += a1*b3;
+                    c20 += a2*b0; c21 += a2*b1; c22 += a2*b2; c23 += a2*b3;
+                    c30 += a3*b0; c31 += a3*b1; c32 += a3*b2; c33 += a3*b3;
+                }
+                Float *c = pc + i*L + j;
+                c[0] += c00; c[1] += c01; c[2] += c02; c[3] += c03; c += L;
+                c[0] += c10; c[1] += c11; c[2] += c12; c[3] += c13; c += L;
+                c[0] += c20; c[1] += c21; c[2] += c22; c[3] += c23; c += L;
+                c[0] += c30; c[1] += c31; c[2] += c32; c[3] += c33;
+            }
+            
+            //Any remaining columns
+            for(; j<L; j++){
+                for(unsigned int r=0; r<4; r++){
+                    Float sum = 0;
+                    for(unsigned int k=kk; k<kEnd; k++){
+                        sum += (aTranspose ? pa[k*M+i+r] : pa[(i+r)*K+k]) * pb[k*L+j];
+                    }
+                    pc[(i+r)*L+j] += sum;
+                }
+            }
+        }
+        
+        //Any remaining rows, these are accumulated one row of b at a time so the inner loop runs over contiguous memory
+        for(; i<rowEnd; i++){
+            Float *ci = pc + i*L;
+            for(unsigned int k=kk; k<kEnd; k++){
+                const Float aik = aTranspose ? pa[k*M+i] : pa[i*K+k];
+                const Float *bk = pb + k*L;
+                for(unsigned int j=0; j<L; j++){
+                    ci[j] += aik * bk[j];
+                }
+            }
+        }
+    }
+}
+
    
 MatrixFloat::MatrixFloat(){
     warningLog.setProceedingText("[WARNING MatrixFloat]");
@@ -241,19 +309,8 @@ MatrixFloat MatrixFloat::multiple(const MatrixFloat &b) const{
         return MatrixFloat();
     }
     
-    MatrixFloat c(M,L);
-    Float **pb = b.getDataPointer();
-    Float **pc = c.getDataPointer();
-    
-    unsigned int i,j,k = 0;
-    for(i=0; i<M; i++){
-        for(j=0; j<L; j++){
-            pc[i][j] = 0;
-            for(k=0; k<K; k++){
-                pc[i][j] += dataPtr[i*cols+k] * pb[k][j];
-            }
-        }
-    }
+    MatrixFloat c;
+    c.multiple( *this, b );
     
     return c;
 }
@@ -275,37 +332,42 @@ bool MatrixFloat::multiple(const MatrixFloat &a,const MatrixFloat &b,const bool
         return false;
     }
     
-    unsigned int i, j, k = 0;
-    
-    //Using direct pointers really helps speed up the computation time
-    Float **pa = a.getDataPointer();
-    Float **pb = b.getDataPointer();
+    if( M == 0 || L == 0 ) return true;
     
-    if( aTranspose ){
-        
-        for(j=0; j<L; j++){
-            for(i=0; i<M; i++){
-                dataPtr[i*cols+j] = 0;
-                for(k=0; k<K; k++){
-                    dataPtr[i*cols+j] += pa[k][i] * pb[k][j];
-                }
-            }
-        }
-        
-    }else{
-        
-        for(j=0; j<L; j++){
-            for(i=0; i<M; i++){
-                dataPtr[i*cols+j] = 0;
-                for(k=0; k<K; k++){
-                    dataPtr[i*cols+j] += pa[i][k] * pb[k][j];
-                }
-            }
-        }
-        
-    }
+    const Float *pa = a.getData();
+    const Float *pb = b.getData();
     
-    return true;
+#ifdef GRT_USE_LAPACK
+    //A row-major matrix is the column-major view of its transpose, so c' = b' * a' gives c in row-major order
+    {
+        const int m = (int)L;
+        const int n = (int)M;
+        const int k = (int)K;
+        const int lda = (int)L;
+        const int ldb = aTranspose ? (int)M : (int)K;
+        const int ldc = (int)L;
+        const Float alpha = 1.0;
+        const Float beta = 0.0;
+        grt_blas_gemm("N", aTranspose ? "T" : "N", &m, &n, &k, &alpha, pb, &lda, pa, &ldb, &beta, dataPtr, &ldc);
+        return true;
+    }
+#endif
+    
+    for(unsigned int i=0; i<M*L; i++) dataPtr[i] = 0;
+    
+    if( K == 0 ) return true;
+    
+    //Large products are split into blocks of rows, which are computed in parallel. The blocks are split on groups of 4 rows, which
+    //is the number of rows the kernel computes at once, and each block must have enough work to justify the thread
+    const unsigned int numRowGroups = (M + 3) / 4;
+    const unsigned long long minOpsPerBlock = 1 << 21;
+    const unsigned long long opsPerRowGroup = 4ULL * K * L;
+    const unsigned int minRowGroupsPerBlock = (unsigned int)( (minOpsPerBlock + opsPerRowGroup - 1) / opsPerRowGroup );
+    Float *pc = dataPtr;
+    return ThreadPool::parallelFor( 0, numRowGroups, minRowGroupsPerBlock, [pa,pb,pc,M,K,L,aTranspose](const unsigned int groupBegin,const unsigned int groupEnd){
+        multiplyRows( pa, pb, pc, groupBegin*4, grt_min( groupEnd*4, M ), M, K, L, aTranspose );
+        return true;
+    } );
 }
     
 bool MatrixFloat::add(const MatrixFloat &b){
@@ -446,12 +508,13 @@ VectorFloat MatrixFloat::getMean() const{
     
     VectorFloat mean(cols);
     
+    //The sums are accumulated in double precision, so the mean is accurate even if Float is single precision
     for(unsigned int c=0; c<cols; c++){
-        mean[c] = 0;
+        AccumFloat sum = 0;
         for(unsigned int r=0; r<rows; r++){
-            mean[c] += dataPtr[r*cols+c];
+            sum += dataPtr[r*cols+c];
         }
-        mean[c] /= Float( rows );
+        mean[c] = Float( sum / rows );
     }
     
     return mean;
@@ -463,10 +526,12 @@ VectorFloat MatrixFloat::getStdDev() const{
 	VectorFloat stdDev(cols,0);
 	
 	for(unsigned int j=0; j<cols; j++){
+		AccumFloat sum = 0;
 		for(unsigned int i=0; i<rows; i++){
-			stdDev[j] += (dataPtr[i*cols+j]-mean[j])*(dataPtr[i*cols+j]-mean[j]);
+			const AccumFloat x = dataPtr[i*cols+j]-mean[j];
+			sum += x*x;
 		}
-		stdDev[j] = sqrt( stdDev[j] / Float(rows-1) );
+		stdDev[j] = Float( sqrt( sum / AccumFloat(rows-1) ) );
 	}
     return stdDev;
 }
@@ -476,13 +541,14 @@ MatrixFloat MatrixFloat::getCovarianceMatrix() const{
     Vector<Float> mean = getMean();
     MatrixFloat covMatrix(cols,cols);
     
+    //The products are accumulated in double precision, as the sum of many small terms loses precision quickly if Float is single precision
     for(unsigned int j=0; j<cols; j++){
         for(unsigned int k=0; k<cols; k++){
-            covMatrix[j][k] = 0;
+            AccumFloat sum = 0;
             for(unsigned int i=0; i<rows; i++){
-                covMatrix[j][k] += (dataPtr[i*cols+j]-mean[j]) * (dataPtr[i*cols+k]-mean[k]);
+                sum += AccumFloat(dataPtr[i*cols+j]-mean[j]) * AccumFloat(dataPtr[i*cols+k]-mean[k]);
             }
-            covMatrix[j][k] /= Float(rows-1);
+            covMatrix[j][k] = Float( sum / AccumFloat(rows-1) );
         }
     }
     
@@ -329,7 +329,7 @@ bool RegressionData::merge(const RegressionData &regressionData){
     return true;
 }
 
-bool RegressionData::spiltDataIntoKFolds(const UINT K){
+bool RegressionData::spiltDataIntoKFolds(const UINT K,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -357,7 +357,7 @@ bool RegressionData::spiltDataIntoKFolds(const UINT K){
     crossValidationIndexs.resize(K);
 
     //Create the random partion indexs
-    Random random;
+    Random random( randomSeed );
     UINT randomIndex = 0;
 
     //Randomize the order of the data
@@ -435,6 +435,13 @@ RegressionData RegressionData::getTestFoldData(const UINT foldIndex) const{
     return testData;
 }
 
+Vector< UINT > RegressionData::getTestFoldIndexes(const UINT foldIndex) const{
+
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return Vector< UINT >();
+
+    return crossValidationIndexs[ foldIndex ];
+}
+
 UINT RegressionData::removeDuplicateSamples(){
 
     UINT numSamplesRemoved = 0;
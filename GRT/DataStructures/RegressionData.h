@@ -282,9 +282,10 @@ public:
      This function prepares the dataset for k-fold cross validation and should be called prior to calling the getTrainingFold(UINT foldIndex) or getTestingFold(UINT foldIndex) functions.  It will spilt the dataset into K-folds, as long as K < M, where M is the number of samples in the dataset.
      
      @param K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
+     @param randomSeed: the seed used to randomly assign the samples to the folds, if zero the seed is set from the system time, default value is 0
 	 @return returns true if the dataset was split correctly, false otherwise
      */
-    bool spiltDataIntoKFolds(const UINT K);
+    bool spiltDataIntoKFolds(const UINT K,const unsigned long long randomSeed = 0);
     
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
@@ -304,6 +305,15 @@ public:
      */
     RegressionData getTestFoldData(const UINT foldIndex) const;
 
+    /**
+     Returns the indexes of the samples in the test dataset for the k-th fold for cross validation, these can be used to test a model with the k-th fold
+     without copying the samples.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
+
+     @param foldIndex: the index of the fold you want the test indexes for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexes of the test samples in this dataset, this will be empty if the cross validation has not been setup
+    */
+    Vector< UINT > getTestFoldIndexes(const UINT foldIndex) const;
+
     UINT removeDuplicateSamples();
     
     /**
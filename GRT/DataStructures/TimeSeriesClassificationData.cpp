@@ -816,7 +816,7 @@ bool TimeSeriesClassificationData::merge(const TimeSeriesClassificationData &lab
     return true;
 }
 
-bool TimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling){
+bool TimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool useStratifiedSampling,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -854,7 +854,7 @@ bool TimeSeriesClassificationData::spiltDataIntoKFolds(const UINT K,const bool u
     crossValidationIndexs.resize( K );
 
     //Create the random partion indexs
-    Random random;
+    Random random( randomSeed );
     UINT randomIndex = 0;
 
     if( useStratifiedSampling ){
@@ -969,6 +969,13 @@ TimeSeriesClassificationData TimeSeriesClassificationData::getTestFoldData(const
     return testData;
 }
 
+Vector< UINT > TimeSeriesClassificationData::getTestFoldIndexes(const UINT foldIndex) const{
+
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return Vector< UINT >();
+
+    return crossValidationIndexs[ foldIndex ];
+}
+
 TimeSeriesClassificationData TimeSeriesClassificationData::getClassData(const UINT classLabel) const {
     TimeSeriesClassificationData classData(numDimensions);
     for(UINT x=0; x<totalNumSamples; x++){
@@ -330,9 +330,10 @@ public:
      
 	 @param const UINT K: the number of folds the dataset will be split into, K should be less than the number of samples in the dataset
      @param const bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt, default value is false
+     @param const unsigned long long randomSeed: the seed used to randomly assign the samples to the folds, if zero the seed is set from the system time, default value is 0
 	 @return returns true if the dataset was split correctly, false otherwise
      */
-    bool spiltDataIntoKFolds(const UINT K, const bool useStratifiedSampling = false);
+    bool spiltDataIntoKFolds(const UINT K, const bool useStratifiedSampling = false, const unsigned long long randomSeed = 0);
     
     /**
      Returns the training dataset for the k-th fold for cross validation.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
@@ -351,6 +352,15 @@ public:
 	 @return returns a test dataset
      */
     TimeSeriesClassificationData getTestFoldData(const UINT foldIndex) const;
+
+    /**
+     Returns the indexes of the samples in the test dataset for the k-th fold for cross validation, these can be used to test a model with the k-th fold
+     without copying the samples.  The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
+
+     @param foldIndex: the index of the fold you want the test indexes for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexes of the test samples in this dataset, this will be empty if the cross validation has not been setup
+    */
+    Vector< UINT > getTestFoldIndexes(const UINT foldIndex) const;
     
     /**
      Returns the all the data with the class label set by classLabel.
@@ -483,7 +483,7 @@ bool UnlabelledData::merge(const UnlabelledData &unlabelledData){
     return true;
 }
 
-bool UnlabelledData::spiltDataIntoKFolds(const UINT K){
+bool UnlabelledData::spiltDataIntoKFolds(const UINT K,const unsigned long long randomSeed){
 
     crossValidationSetup = false;
     crossValidationIndexs.clear();
@@ -511,7 +511,7 @@ bool UnlabelledData::spiltDataIntoKFolds(const UINT K){
     crossValidationIndexs.resize(K);
 
 	//Create the random partion indexs
-	Random random;
+	Random random( randomSeed );
     UINT randomIndex = 0;
 
     //Randomize the order of the data
@@ -73,10 +73,6 @@ FFT& FFT::operator=(const FFT &rhs){
         this->windowSizeMap = rhs.windowSizeMap;
         
         copyBaseVariables( (FeatureExtraction*)&rhs );
-        
-        for(UINT i=0; i<dataBufferSize; i++){
-            dataBuffer[i].resize( numInputDimensions, 0 );
-        }
     }
     return *this;
 }
@@ -221,17 +217,9 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     //Resize the output feature vector
     featureVector.resize( numOutputDimensions, 0);
     
-    dataBuffer.resize( dataBufferSize );
+    dataBuffer.resize( dataBufferSize, numInputDimensions, 0 );
     tempBuffer.resize( dataBufferSize );
     
-    for(UINT i=0; i<dataBufferSize; i++){
-        dataBuffer[i].resize( numInputDimensions, 0 );
-    }
-    
-    for(UINT i=0; i<dataBufferSize; i++){
-        dataBuffer[i].resize( numInputDimensions, 0 );
-    }
-    
     //Setup the fft for each dimension
     fft.resize(numInputDimensions);
     for(unsigned int i=0; i<numInputDimensions; i++){
@@ -283,7 +271,7 @@ bool FFT::update(const VectorFloat &x){
     }
     
     //Add the current input to the data buffers
-    dataBuffer.push_back( x );
+    dataBuffer.push_back( &x[0] );
     
     featureDataReady = false;
     
@@ -293,9 +281,7 @@ bool FFT::update(const VectorFloat &x){
         for(UINT j=0; j<numInputDimensions; j++){
             
             //Copy the input data for this dimension into the temp buffer
-            for(UINT i=0; i<dataBufferSize; i++){
-                tempBuffer[i] = dataBuffer[i][j];
-            }
+            dataBuffer.getChannel( j ).copyTo( tempBuffer );
             
             //Compute the FFT
             if( !fft[j].computeFFT( tempBuffer ) ){
@@ -345,7 +331,7 @@ bool FFT::update(const MatrixFloat &x){
     for(UINT k=0; k<x.getNumRows(); k++){
         
         //Add the current input to the data buffers
-        dataBuffer.push_back( x.getRow(k) );
+        dataBuffer.push_back( x[k] );
         
         if( ++hopCounter == hopSize ){
             hopCounter = 0;
@@ -353,9 +339,7 @@ bool FFT::update(const MatrixFloat &x){
             for(UINT j=0; j<numInputDimensions; j++){
                 
                 //Copy the input data for this dimension into the temp buffer
-                for(UINT i=0; i<dataBufferSize; i++){
-                    tempBuffer[i] = dataBuffer[i][j];
-                }
+                dataBuffer.getChannel( j ).copyTo( tempBuffer );
                 
                 //Compute the FFT
                 if( !fft[j].computeFFT( tempBuffer ) ){
@@ -334,7 +334,7 @@ protected:
     bool computeMagnitude;                                      ///< Tracks if the magnitude (and power) of the FFT need to be computed
     bool computePhase;                                          ///< Tracks if the phase of the FFT needs to be computed
     VectorFloat tempBuffer;                                     ///< A temporary buffer used to store the input data for the FFT
-    CircularBuffer< VectorFloat > dataBuffer;                  ///< A circular buffer used to store the previous M inputs
+    MultichannelCircularBuffer< Float > dataBuffer;            ///< A circular buffer used to store the previous M inputs
     Vector< FastFourierTransform > fft;                         ///< A buffer used to store the FFT results
     std::map< unsigned int, unsigned int > windowSizeMap;       ///< A map to relate the FFTWindowSize enumerations to actual values
     
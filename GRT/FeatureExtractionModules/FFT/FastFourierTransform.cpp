@@ -215,6 +215,15 @@ bool FastFourierTransform::computeFFT( VectorFloat &data ){
     return true;
 }
     
+bool FastFourierTransform::computeComplexFFT( Float *realIn, Float *imagIn, Float *realOut, Float *imagOut, const bool inverseTransform ){
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    return FFT( (int)windowSize, inverseTransform, realIn, imagIn, realOut, imagOut );
+}
+    
 bool FastFourierTransform::windowData( VectorFloat &data ){
    
 	const unsigned int N = (unsigned int)data.size();
@@ -375,7 +384,7 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,Float *realI
     int i, j, k, n;
     int BlockSize, BlockEnd;
     
-    Float angle_numerator = 2.0 * PI;
+    AccumFloat angle_numerator = 2.0 * PI;
     Float tr, ti;                /* temp real, temp imaginary */
     
     if( !isPowerOfTwo(numSamples) ) {
@@ -400,14 +409,15 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,Float *realI
     BlockEnd = 1;
     for (BlockSize = 2; BlockSize <= numSamples; BlockSize <<= 1) {
         
-        Float delta_angle = angle_numerator / (Float) BlockSize;
+        //The twiddle factors are generated with a recurrence, which drifts in single precision builds, so the recurrence is run in AccumFloat
+        AccumFloat delta_angle = angle_numerator / (AccumFloat) BlockSize;
         
-        Float sm2 = sin(-2 * delta_angle);
-        Float sm1 = sin(-delta_angle);
-        Float cm2 = cos(-2 * delta_angle);
-        Float cm1 = cos(-delta_angle);
-        Float w = 2 * cm1;
-        Float ar0, ar1, ar2, ai0, ai1, ai2;
+        AccumFloat sm2 = sin(-2 * delta_angle);
+        AccumFloat sm1 = sin(-delta_angle);
+        AccumFloat cm2 = cos(-2 * delta_angle);
+        AccumFloat cm1 = cos(-delta_angle);
+        AccumFloat w = 2 * cm1;
+        AccumFloat ar0, ar1, ar2, ai0, ai1, ai2;
         
         for (i = 0; i < numSamples; i += BlockSize) {
             ar2 = cm2;
@@ -426,8 +436,8 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,Float *realI
                 ai1 = ai0;
                 
                 k = j + BlockEnd;
-                tr = ar0 * realOut[k] - ai0 * imagOut[k];
-                ti = ar0 * imagOut[k] + ai0 * realOut[k];
+                tr = Float( ar0 * realOut[k] - ai0 * imagOut[k] );
+                ti = Float( ar0 * imagOut[k] + ai0 * realOut[k] );
                 
                 realOut[k] = realOut[j] - tr;
                 imagOut[k] = imagOut[j] - ti;
@@ -47,6 +47,10 @@ public:
     
     bool computeFFT( VectorFloat &data );
     
+    //Computes the complex FFT (or the inverse FFT, which is normalized by the FFT size) of windowSize values, without windowing the data.
+    //This can be used for fast convolution, the imagIn pointer can be NULL if the input is real.
+    bool computeComplexFFT( Float *realIn, Float *imagIn, Float *realOut, Float *imagOut, const bool inverseTransform = false );
+    
 	VectorFloat getMagnitudeData();
 	VectorFloat getPhaseData();
 	VectorFloat getPowerData();
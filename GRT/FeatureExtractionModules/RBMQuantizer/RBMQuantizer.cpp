@@ -311,4 +311,12 @@ bool RBMQuantizer::setNumClusters(const UINT numClusters){
     return true;
 }
 
+bool RBMQuantizer::setBatchSize(const UINT batchSize){
+    return rbm.setBatchSize( batchSize );
+}
+
+bool RBMQuantizer::enablePersistentContrastiveDivergence(const bool usePersistentCD){
+    return rbm.enablePersistentContrastiveDivergence( usePersistentCD );
+}
+
 GRT_END_NAMESPACE
@@ -226,6 +226,21 @@ public:
     */
     bool setNumClusters(const UINT numClusters);
     
+    /**
+    Sets the batch size used to train the internal BernoulliRBM.
+    
+    @return returns true if the batch size was updated, false otherwise
+    */
+    bool setBatchSize(const UINT batchSize);
+    
+    /**
+    Sets if the internal BernoulliRBM should be trained with persistent contrastive divergence.
+    See BernoulliRBM::enablePersistentContrastiveDivergence for more details.
+    
+    @return returns true if the parameter was updated, false otherwise
+    */
+    bool enablePersistentContrastiveDivergence(const bool usePersistentCD);
+    
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
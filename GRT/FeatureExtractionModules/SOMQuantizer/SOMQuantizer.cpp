@@ -323,4 +323,8 @@ bool SOMQuantizer::setNumClusters(const UINT numClusters){
     return true;
 }
 
+bool SOMQuantizer::enableBatchTraining(const bool useBatchTraining){
+    return som.enableBatchTraining( useBatchTraining );
+}
+
 GRT_END_NAMESPACE
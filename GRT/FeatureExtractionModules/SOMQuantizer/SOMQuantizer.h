@@ -225,6 +225,14 @@ public:
     */
     bool setNumClusters(const UINT numClusters);
     
+    /**
+    Sets if the internal SelfOrganizingMap should be trained with the batch algorithm, which is faster for large datasets.
+    See SelfOrganizingMap::enableBatchTraining for more details.
+    
+    @return returns true if the parameter was updated, false otherwise
+    */
+    bool enableBatchTraining(const bool useBatchTraining);
+    
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
@@ -244,4 +252,4 @@ protected:
 GRT_END_NAMESPACE
 
 #endif //GRT_SOM_QUANTIZER_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
@@ -267,7 +267,7 @@ bool TimeDomainFeatures::init(UINT bufferLength,UINT numFrames,UINT numDimension
     featureVector.resize(numOutputDimensions);
     
     //Resize the raw data buffer
-    dataBuffer.resize( bufferLength, VectorFloat(numInputDimensions,0) );
+    dataBuffer.resize( bufferLength, numInputDimensions, 0 );
     
     //Flag that the time domain features has been initialized
     initialized = true;
@@ -293,7 +293,7 @@ VectorFloat TimeDomainFeatures::update(const VectorFloat &x){
     }
     
     //Add the new data to the data buffer
-    dataBuffer.push_back( x );
+    dataBuffer.push_back( &x[0] );
     
     //Only flag that the feature data is ready if the data is full
     if( dataBuffer.getBufferFilled() ){
@@ -308,17 +308,15 @@ VectorFloat TimeDomainFeatures::update(const VectorFloat &x){
     
     if( offsetInput ){
         for(UINT n=0; n<numInputDimensions; n++){
-            data[0][n] = dataBuffer[0][n];
+            data[0][n] = dataBuffer(0,n);
             for(UINT i=1; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n]-dataBuffer[0][n];
+                data[i][n] = dataBuffer(i,n)-dataBuffer(0,n);
             }
         }
     }else{
-        for(UINT n=0; n<numInputDimensions; n++){
-            for(UINT i=0; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n];
-            }
-        }
+        //The buffered frames are stored contiguously, so they can be copied straight into the data matrix
+        const Float *window = dataBuffer.getWindow();
+        std::copy( window, window + bufferLength*numInputDimensions, data.getData() );
     }
     
     if( useMean || useStdDev ){ meanFeatures.setAllValues(0); stdDevFeatures.setAllValues(0); }
@@ -409,14 +407,19 @@ VectorFloat TimeDomainFeatures::update(const VectorFloat &x){
     return featureVector;
 }
 
-CircularBuffer< VectorFloat > TimeDomainFeatures::getBufferData(){
+CircularBuffer< VectorFloat > TimeDomainFeatures::getBufferData() const{
+    CircularBuffer< VectorFloat > buffer;
     if( initialized ){
-        return dataBuffer;
+        buffer.resize( bufferLength, VectorFloat(numInputDimensions,0) );
+        const Vector< VectorFloat > frames = dataBuffer.getData< VectorFloat >();
+        for(UINT i=0; i<frames.getSize(); i++){
+            buffer.push_back( frames[i] );
+        }
     }
-    return CircularBuffer< VectorFloat >();
+    return buffer;
 }
 
-const CircularBuffer< VectorFloat > &TimeDomainFeatures::getBufferData() const {
+const MultichannelCircularBuffer< Float > &TimeDomainFeatures::getMultichannelBufferData() const {
     return dataBuffer;
 }
 
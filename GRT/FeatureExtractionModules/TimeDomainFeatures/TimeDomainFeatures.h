@@ -142,18 +142,19 @@ public:
     VectorFloat update(const VectorFloat &x);
     
     /**
-    Get the circular buffer.
+    Get the circular buffer, with one VectorFloat per frame. The data is stored in a MultichannelCircularBuffer, so this
+    builds a copy of the buffer in the older format. Use getMultichannelBufferData() to access the buffer without a copy.
     
-    @return a copy of the circular buffer
+    @return a copy of the circular buffer, or an empty buffer if the module has not been initialized
     */
-    CircularBuffer< VectorFloat > getBufferData();
+    CircularBuffer< VectorFloat > getBufferData() const;
     
     /**
-    Gets a reference to the circular buffer.
+    Gets a reference to the circular buffer, which stores all the input dimensions of each frame contiguously.
     
     @return a reference to the circular buffer
     */
-    const CircularBuffer< VectorFloat > &getBufferData() const;
+    const MultichannelCircularBuffer< Float > &getMultichannelBufferData() const;
     
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::save;
@@ -171,7 +172,7 @@ protected:
     bool useStdDev;
     bool useEuclideanNorm;
     bool useRMS;
-    CircularBuffer< VectorFloat > dataBuffer;
+    MultichannelCircularBuffer< Float > dataBuffer;
     
     static RegisterFeatureExtractionModule< TimeDomainFeatures > registerModule;
 };
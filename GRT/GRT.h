@@ -54,12 +54,16 @@
 #include "Util/SVD.h"
 #include "Util/LUDecomposition.h"
 #include "Util/Cholesky.h"
+#include "Util/KDTree.h"
 #include "Util/EigenvalueDecomposition.h"
 #include "Util/TestResult.h"
 #include "Util/ClassificationResult.h"
 #include "Util/PeakDetection.h"
 #include "Util/ThresholdCrossingDetector.h"
 #include "Util/CommandLineParser.h"
+#include "Util/BinaryModelFile.h"
+#include "Util/SPSCQueue.h"
+#include "Util/PipelineProfiler.h"
 
 //Include the data structures
 #include "DataStructures/Vector.h"
@@ -82,6 +86,7 @@
 #include "CoreAlgorithms/Tree/Tree.h"
 #include "CoreAlgorithms/MeanShift/MeanShift.h"
 #include "CoreAlgorithms/GridSearch/GridSearch.h"
+#include "CoreAlgorithms/LBFGS/LBFGS.h"
 
 //Include the PreProcessing Modules
 #include "PreProcessingModules/Derivative.h"
@@ -75,6 +75,9 @@ FIRFilter& FIRFilter::operator=(const FIRFilter &rhs){
         this->gain = rhs.gain;
         this->y = rhs.y;
         this->z = rhs.z;
+        this->fft = rhs.fft;
+        this->fftKernelReal = rhs.fftKernelReal;
+        this->fftKernelImag = rhs.fftKernelImag;
         
         copyBaseVariables( (PreProcessing*)&rhs );
     }
@@ -126,11 +129,7 @@ bool FIRFilter::reset(){
     
     if( initialized ){
         //Set the data history buffer to zero
-        for(UINT n=0; n<numInputDimensions; n++){
-            for(UINT i=0; i<numTaps; i++){
-                y[n][i] = 0;
-            }
-        }
+        y.reset();
     }
     
     return true;
@@ -143,6 +142,8 @@ bool FIRFilter::clear(){
     
     y.clear();
     z.clear();
+    fftKernelReal.clear();
+    fftKernelImag.clear();
     
     return true;
 }
@@ -278,8 +279,10 @@ bool FIRFilter::load( std::fstream &file ){
     if( initialized ){
         
         //Setup the memory and then load z
-        y.resize( numTaps, VectorFloat(numInputDimensions,0) );
+        y.resize( numTaps, numInputDimensions, 0 );
         z.resize( numTaps );
+        fftKernelReal.clear();
+        fftKernelImag.clear();
         
         //Load z
         file >> word;
@@ -313,8 +316,10 @@ bool FIRFilter::buildFilter(){
     //Reset the memory
     y.clear();
     z.clear();
-    y.resize( numTaps, VectorFloat(numInputDimensions,0) );
+    y.resize( numTaps, numInputDimensions, 0 );
     z.resize( numTaps, 0 );
+    fftKernelReal.clear();
+    fftKernelImag.clear();
     
     //Design the filter coeffients (z)
     Float alpha = 0;
@@ -396,20 +401,160 @@ VectorFloat FIRFilter::filter(const VectorFloat &x){
     }
     
     //Add the new sample to the buffer
-    y.push_back( x );
+    y.push_back( &x[0] );
     
-    const UINT K = numTaps-1;
+    //Run the filter
+    filterFrame( &processedData[0] );
     
-    //Run the filter for each input dimension
-    for(UINT n=0; n<numInputDimensions; n++){
-        processedData[n] = 0;
-        for(UINT i=0; i<numTaps; i++){
-            processedData[n] += y[K-i][n] * z[i];
+    return processedData;
+}
+
+MatrixFloat FIRFilter::filter(const MatrixFloat &x){
+    
+    if( !initialized ){
+        errorLog << "filter(const MatrixFloat &x) - Not Initialized!" << std::endl;
+        return MatrixFloat();
+    }
+    
+    if( x.getNumCols() != numInputDimensions ){
+        errorLog << "filter(const MatrixFloat &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the number of columns in the input matrix (" << x.getNumCols() << ")!" << std::endl;
+        return MatrixFloat();
+    }
+    
+    const UINT numSamples = x.getNumRows();
+    if( numSamples == 0 ){
+        errorLog << "filter(const MatrixFloat &x) - The input matrix is empty!" << std::endl;
+        return MatrixFloat();
+    }
+    
+    MatrixFloat output( numSamples, numInputDimensions );
+    
+    if( numTaps < FFT_CONVOLUTION_MIN_NUM_TAPS ){
+        //Short filters are run in the time domain, one sample at a time
+        for(UINT n=0; n<numSamples; n++){
+            y.push_back( x[n] );
+            filterFrame( output[n] );
+        }
+    }else{
+        if( !filterOverlapSave( x, output ) ){
+            errorLog << "filter(const MatrixFloat &x) - Failed to run the overlap-save convolution!" << std::endl;
+            return MatrixFloat();
+        }
+        
+        //Add the most recent samples to the filter history, so the next sample or block continues from the end of this block
+        const UINT numHistorySamples = grt_min( numSamples, numTaps );
+        for(UINT n=numSamples-numHistorySamples; n<numSamples; n++){
+            y.push_back( x[n] );
         }
-        processedData[n] *= gain;
     }
     
-    return processedData;
+    //The processed data is the most recent filtered sample
+    for(UINT j=0; j<numInputDimensions; j++){
+        processedData[j] = output[numSamples-1][j];
+    }
+    
+    return output;
+}
+
+void FIRFilter::filterFrame( Float *output ) const{
+    
+    //The frames in the history are contiguous, so each tap is applied to all the input dimensions at once.
+    //The first tap is applied to the most recent frame, which is the last frame in the window
+    const Float *frame = y.getWindow() + (numTaps-1)*numInputDimensions;
+    for(UINT n=0; n<numInputDimensions; n++) output[n] = 0;
+    for(UINT i=0; i<numTaps; i++){
+        const Float coeff = z[i];
+        for(UINT n=0; n<numInputDimensions; n++){
+            output[n] += frame[n] * coeff;
+        }
+        frame -= numInputDimensions;
+    }
+    for(UINT n=0; n<numInputDimensions; n++) output[n] *= gain;
+}
+
+bool FIRFilter::filterOverlapSave( const MatrixFloat &x, MatrixFloat &output ){
+    
+    const UINT M = numTaps;
+    const UINT N = numInputDimensions;
+    const UINT numSamples = x.getNumRows();
+    
+    //The FFT size is the smallest power of two that is at least twice the filter length, each block of the overlap-save
+    //convolution then filters fftSize-M+1 new samples
+    UINT fftSize = 1;
+    while( fftSize < 2*M ) fftSize <<= 1;
+    const UINT blockSize = fftSize - M + 1;
+    
+    //Compute the spectrum of the filter coefficients, this only needs to be done once for each filter design
+    if( fftKernelReal.getSize() != fftSize || fftKernelImag.getSize() != fftSize ){
+        if( !fft.init( fftSize, FastFourierTransform::RECTANGULAR_WINDOW, false, false, false ) ){
+            errorLog << "filterOverlapSave(...) - Failed to initialize the FFT!" << std::endl;
+            return false;
+        }
+        VectorFloat kernel( fftSize, 0 );
+        for(UINT i=0; i<M; i++) kernel[i] = z[i];
+        fftKernelReal.resize( fftSize );
+        fftKernelImag.resize( fftSize );
+        if( !fft.computeComplexFFT( &kernel[0], NULL, &fftKernelReal[0], &fftKernelImag[0] ) ){
+            fftKernelReal.clear();
+            fftKernelImag.clear();
+            return false;
+        }
+    }
+    
+    VectorFloat segmentReal( fftSize );
+    VectorFloat segmentImag( fftSize );
+    VectorFloat spectrumReal( fftSize );
+    VectorFloat spectrumImag( fftSize );
+    
+    //The filter coefficients are real, so two dimensions can be filtered with each complex FFT: one dimension is stored in the
+    //real part of the segment and the other dimension in the imaginary part, and their results are split the same way
+    for(UINT c=0; c<N; c+=2){
+        const bool filterPair = c+1 < N;
+        
+        for(UINT blockStart=0; blockStart<numSamples; blockStart+=blockSize){
+            
+            //Each segment holds the M-1 samples before the block, followed by the block. Samples before the start of x come from
+            //the filter history, where the most recent frame is the last frame in the buffer
+            for(UINT j=0; j<fftSize; j++){
+                const int n = int(blockStart + j) - int(M-1);
+                if( n < 0 ){
+                    segmentReal[j] = y( M + n, c );
+                    segmentImag[j] = filterPair ? y( M + n, c+1 ) : 0;
+                }else if( n < int(numSamples) ){
+                    segmentReal[j] = x[n][c];
+                    segmentImag[j] = filterPair ? x[n][c+1] : 0;
+                }else{
+                    segmentReal[j] = segmentImag[j] = 0;
+                }
+            }
+            
+            if( !fft.computeComplexFFT( &segmentReal[0], &segmentImag[0], &spectrumReal[0], &spectrumImag[0] ) ){
+                return false;
+            }
+            
+            //Multiply the spectrum of the segment with the spectrum of the filter
+            for(UINT j=0; j<fftSize; j++){
+                const Float re = spectrumReal[j] * fftKernelReal[j] - spectrumImag[j] * fftKernelImag[j];
+                const Float im = spectrumReal[j] * fftKernelImag[j] + spectrumImag[j] * fftKernelReal[j];
+                spectrumReal[j] = re;
+                spectrumImag[j] = im;
+            }
+            
+            if( !fft.computeComplexFFT( &spectrumReal[0], &spectrumImag[0], &segmentReal[0], &segmentImag[0], true ) ){
+                return false;
+            }
+            
+            //The first M-1 values are corrupted by the circular convolution, the remaining values are the filtered block
+            for(UINT j=M-1; j<fftSize; j++){
+                const UINT n = blockStart + j - (M-1);
+                if( n >= numSamples ) break;
+                output[n][c] = segmentReal[j] * gain;
+                if( filterPair ) output[n][c+1] = segmentImag[j] * gain;
+            }
+        }
+    }
+    
+    return true;
 }
 
 UINT FIRFilter::getFilterType() const{
@@ -442,7 +587,7 @@ Float FIRFilter::getGain() const{
 
 Vector< VectorFloat > FIRFilter::getInputBuffer() const{
     if( initialized ){
-        return y.getData();
+        return y.getData< VectorFloat >();
     }
     return Vector< VectorFloat >();
 }
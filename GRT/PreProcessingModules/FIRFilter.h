@@ -28,6 +28,7 @@
 #define GRT_FIR_FILTER_HEADER
 
 #include "../CoreModules/PreProcessing.h"
+#include "../FeatureExtractionModules/FFT/FastFourierTransform.h"
 
 GRT_BEGIN_NAMESPACE
     
@@ -37,6 +38,9 @@ GRT_BEGIN_NAMESPACE
 class GRT_API FIRFilter : public PreProcessing{
 public:
     enum FilterTypes{LPF=0, HPF, BPF};
+    
+    //Filters with at least this many taps are run with FFT overlap-save convolution when a block of samples is filtered
+    enum ConvolutionSettings{FFT_CONVOLUTION_MIN_NUM_TAPS=64};
 
     /**
      Constructor, sets the filter factor, gain and dimensionality of the low pass filter.
@@ -151,6 +155,17 @@ public:
      */
     VectorFloat filter(const VectorFloat &x);
     
+    /**
+     Filters a block of samples, where each row of x is one sample and the number of columns should match the dimensionality of the filter.
+     This gives the same result as calling filter(const VectorFloat &x) for each row, and the filter history is updated, so block and
+     sample by sample filtering can be mixed. Filters with at least FFT_CONVOLUTION_MIN_NUM_TAPS taps are run with FFT overlap-save
+     convolution, shorter filters are run in the time domain.
+     
+     @param x: the samples to filter, each row should be one sample
+	 @return the filtered samples, with one row per input sample.  An empty matrix will be returned if the samples were not filtered
+     */
+    MatrixFloat filter(const MatrixFloat &x);
+    
     /**
      Gets the filter type, this should be one of the FilterTypes enums.
      
@@ -272,6 +287,9 @@ public:
     using MLBase::load;
 
 protected:
+    void filterFrame( Float *output ) const;
+    bool filterOverlapSave( const MatrixFloat &x, MatrixFloat &output );
+    
     UINT filterType;
     UINT numTaps;
     Float sampleRate;
@@ -279,8 +297,11 @@ protected:
     Float cutoffFrequencyLower;
     Float cutoffFrequencyUpper;
     Float gain;
-    CircularBuffer< VectorFloat > y;
+    MultichannelCircularBuffer< Float > y;
     VectorFloat z;
+    FastFourierTransform fft;               ///< Used for the overlap-save convolution of long filters
+    VectorFloat fftKernelReal;              ///< The spectrum of the zero padded filter coefficients, this is computed the first time a block is filtered
+    VectorFloat fftKernelImag;
     
     static RegisterPreProcessingModule< FIRFilter > registerModule;
 };
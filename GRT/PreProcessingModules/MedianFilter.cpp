@@ -189,7 +189,7 @@ bool MedianFilter::init(const UINT filterSize,const UINT numDimensions){
     this->numOutputDimensions = numDimensions;
     processedData.clear();
     processedData.resize(numDimensions,0);
-    initialized = dataBuffer.resize( filterSize, VectorFloat(numInputDimensions,0) );
+    initialized = dataBuffer.resize( filterSize, numInputDimensions, 0 );
     
     if( !initialized ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to resize dataBuffer!" << std::endl;
@@ -222,14 +222,12 @@ VectorFloat MedianFilter::filter(const VectorFloat &x){
     if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
     
     //Add the new value to the buffer
-    dataBuffer.push_back( x );
+    dataBuffer.push_back( &x[0] );
     
-    //Compute the median value for each dimension
+    //Compute the median value for each dimension, using the most recent inputSampleCounter values
     VectorFloat tmp( inputSampleCounter );
     for(unsigned int j=0; j<numInputDimensions; j++){
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            tmp[i] = dataBuffer[i][j];
-        }
+        dataBuffer.getChannel( j, inputSampleCounter ).copyTo( tmp );
         std::sort(tmp.begin(),tmp.end());
         
         //Get the median value
@@ -252,9 +250,7 @@ Vector< VectorFloat > MedianFilter::getDataBuffer() const {
     
     Vector< VectorFloat > data(numInputDimensions,VectorFloat(inputSampleCounter));
     for(unsigned int j=0; j<numInputDimensions; j++){
-        for(unsigned int i=0; i<inputSampleCounter; i++){
-            data[j][i] = dataBuffer[i][j];
-        }
+        dataBuffer.getChannel( j, inputSampleCounter ).copyTo( data[j] );
     }
     return data;
 }
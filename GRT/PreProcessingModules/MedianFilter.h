@@ -168,7 +168,7 @@ class GRT_API MedianFilter : public PreProcessing {
 protected:
     UINT filterSize;                                        ///< The size of the filter
     UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
-    CircularBuffer< VectorFloat > dataBuffer;           ///< A buffer to store the previous N values, N = filterSize
+    MultichannelCircularBuffer< Float > dataBuffer;     ///< A buffer to store the previous N values, N = filterSize
     
     static RegisterPreProcessingModule< MedianFilter > registerModule;
 };
@@ -113,7 +113,7 @@ bool SavitzkyGolayFilter::process(const VectorFloat &inputVector){
 
 bool SavitzkyGolayFilter::reset(){
     if( initialized ){
-        data.setAllValues(VectorFloat(numInputDimensions,0));
+        data.reset();
         yy.clear();
         yy.resize(numInputDimensions,0);
         processedData.clear();
@@ -241,7 +241,7 @@ bool SavitzkyGolayFilter::init(UINT numLeftHandPoints,UINT numRightHandPoints,UI
     yy.resize(numDimensions,0);
     processedData.clear();
     processedData.resize(numDimensions,0);
-    data.resize(numPoints,VectorFloat(numDimensions,0));
+    data.resize(numPoints,numDimensions,0);
     
     if( !calCoeff() ){
         errorLog << "init(UINT NL,UINT NR,UINT LD,UINT M,UINT numDimensions) - Failed to compute filter coefficents!" << std::endl;
@@ -280,13 +280,14 @@ VectorFloat SavitzkyGolayFilter::filter(const VectorFloat &x){
     }
     
     //Add the new input data to the data buffer
-    data.push_back( x );
-    
-    //Filter the data
-    for(UINT j=0; j<x.size(); j++){
-        processedData[j] = 0;
-        for(UINT i=0; i<numPoints; i++)
-        processedData[j] += data[i][j] * coeff[i];
+    data.push_back( &x[0] );
+    
+    //Filter the data, the frames are contiguous so each coefficient is applied to all the input dimensions at once
+    for(UINT j=0; j<numInputDimensions; j++) processedData[j] = 0;
+    for(UINT i=0; i<numPoints; i++){
+        const Float *frame = data.getFrame( i );
+        for(UINT j=0; j<numInputDimensions; j++)
+        processedData[j] += frame[j] * coeff[i];
     }
     
     return processedData;
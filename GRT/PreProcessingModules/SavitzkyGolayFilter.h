@@ -161,7 +161,7 @@ protected:
     UINT numRightHandPoints;                     //Num of rightward (future) points to use
     UINT derivativeOrder;                        //Order of the derivative desired
     UINT smoothingPolynomialOrder;               //Order of smoothing polynomial
-    CircularBuffer< VectorFloat > data;    //A buffer to hold the input data
+    MultichannelCircularBuffer< Float > data;    //A buffer to hold the input data
     VectorFloat yy;                       //The filtered values
     VectorFloat coeff;                    //Buffer for the filter coefficients
     
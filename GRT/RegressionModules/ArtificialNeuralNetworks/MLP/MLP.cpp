@@ -441,14 +441,19 @@ bool MLP::trainOnlineGradientDescentClassification(const RegressionData &trainin
     //Reset the indexList, this is used to randomize the order of the training examples, if needed
     for(UINT i=0; i<M; i++) indexList[i] = i;
     
+    const Vector< MinMax > inputRanges = inputVectorRanges;
+    const Vector< MinMax > targetRanges = targetVectorRanges;
+    
     for(UINT iter=0; iter<numRandomTrainingIterations; iter++){
         
         epoch = 0;
         keepTraining = true;
         tempTrainingErrorLog.clear();
         
-        //Randomise the start values of the neurons
+        //Randomise the start values of the neurons, init clears the model so the scaling ranges need to be restored
         init(numInputNeurons,numHiddenNeurons,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
+        inputVectorRanges = inputRanges;
+        targetVectorRanges = targetRanges;
         
         if( randomiseTrainingOrder ){
             for(UINT i=0; i<M; i++){
@@ -720,14 +725,19 @@ bool MLP::trainOnlineGradientDescentRegression(const RegressionData &trainingDat
     //Reset the indexList, this is used to randomize the order of the training examples, if needed
     for(UINT i=0; i<M; i++) indexList[i] = i;
     
+    const Vector< MinMax > inputRanges = inputVectorRanges;
+    const Vector< MinMax > targetRanges = targetVectorRanges;
+    
     for(UINT iter=0; iter<numRandomTrainingIterations; iter++){
         
         epoch = 0;
         keepTraining = true;
         tempTrainingErrorLog.clear();
         
-        //Randomise the start values of the neurons
+        //Randomise the start values of the neurons, init clears the model so the scaling ranges need to be restored
         init(numInputNeurons,numHiddenNeurons,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
+        inputVectorRanges = inputRanges;
+        targetVectorRanges = targetRanges;
         
         if( randomiseTrainingOrder ){
             for(UINT i=0; i<M; i++){
@@ -1490,6 +1500,132 @@ bool MLP::load( std::fstream &file ){
     return true;
 }
 
+bool MLP::saveBinary( BinaryModelWriter &file ) const{
+    
+    if( !file.getIsOpen() ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    file.writeString( "GRT_MLP_BINARY_MODEL_V1.0" );
+    
+    //Write the regressifier settings to the file
+    if( !Regressifier::saveBaseSettingsToBinaryFile( file ) ){
+        errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save Regressifier base settings to file!" << std::endl;
+        return false;
+    }
+    
+    file.writeUInt( numInputNeurons );
+    file.writeUInt( numHiddenNeurons );
+    file.writeUInt( numOutputNeurons );
+    file.writeUInt( inputLayerActivationFunction );
+    file.writeUInt( hiddenLayerActivationFunction );
+    file.writeUInt( outputLayerActivationFunction );
+    file.writeUInt( numRandomTrainingIterations );
+    file.writeFloat( momentum );
+    file.writeFloat( gamma );
+    file.writeBool( classificationModeActive );
+    file.writeBool( useNullRejection );
+    file.writeFloat( nullRejectionThreshold );
+    
+    if( trained ){
+        if( !saveLayerToBinaryFile( file, inputLayer ) || !saveLayerToBinaryFile( file, hiddenLayer ) || !saveLayerToBinaryFile( file, outputLayer ) ){
+            errorLog << "saveBinary(BinaryModelWriter &file) - Failed to save the neurons to file!" << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool MLP::loadBinary( BinaryModelReader &file ){
+    
+    //Clear any previous models
+    clear();
+    
+    if( !file.getIsOpen() ){
+        errorLog << "loadBinary(BinaryModelReader &file) - File is not open!" << std::endl;
+        return false;
+    }
+    
+    std::string header;
+    if( !file.readString( header ) || header != "GRT_MLP_BINARY_MODEL_V1.0" ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to find file header!" << std::endl;
+        return false;
+    }
+    
+    //Load the base settings from the file
+    if( !Regressifier::loadBaseSettingsFromBinaryFile( file ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to load regressifier base settings from file!" << std::endl;
+        return false;
+    }
+    
+    UINT inputActivationFunction = 0;
+    UINT hiddenActivationFunction = 0;
+    UINT outputActivationFunction = 0;
+    if( !file.readUInt( numInputNeurons ) || !file.readUInt( numHiddenNeurons ) || !file.readUInt( numOutputNeurons ) ||
+        !file.readUInt( inputActivationFunction ) || !file.readUInt( hiddenActivationFunction ) || !file.readUInt( outputActivationFunction ) ||
+        !file.readUInt( numRandomTrainingIterations ) || !file.readFloat( momentum ) || !file.readFloat( gamma ) ||
+        !file.readBool( classificationModeActive ) || !file.readBool( useNullRejection ) || !file.readFloat( nullRejectionThreshold ) ){
+        errorLog << "loadBinary(BinaryModelReader &file) - Failed to read the MLP settings!" << std::endl;
+        return false;
+    }
+    numInputDimensions = numInputNeurons;
+    inputLayerActivationFunction = (Neuron::Type)inputActivationFunction;
+    hiddenLayerActivationFunction = (Neuron::Type)hiddenActivationFunction;
+    outputLayerActivationFunction = (Neuron::Type)outputActivationFunction;
+    
+    //Clean up any previous data and setup the model
+    if( trained ) initialized = true;
+    else init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+    
+    if( trained ){
+        if( !loadLayerFromBinaryFile( file, inputLayer, numInputNeurons ) || !loadLayerFromBinaryFile( file, hiddenLayer, numHiddenNeurons ) ||
+            !loadLayerFromBinaryFile( file, outputLayer, numOutputNeurons ) ){
+            errorLog << "loadBinary(BinaryModelReader &file) - Failed to load the neurons from file!" << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool MLP::saveLayerToBinaryFile(BinaryModelWriter &file,const Vector< Neuron > &layer) const{
+    
+    for(UINT i=0; i<layer.getSize(); i++){
+        file.writeUInt( layer[i].activationFunction );
+        file.writeFloat( layer[i].bias );
+        file.writeFloat( layer[i].gamma );
+        if( !file.writeVector( layer[i].weights ) ) return false;
+    }
+    
+    return true;
+}
+
+bool MLP::loadLayerFromBinaryFile(BinaryModelReader &file,Vector< Neuron > &layer,const UINT numNeurons){
+    
+    layer.resize( numNeurons );
+    
+    for(UINT i=0; i<numNeurons; i++){
+        if( !file.readUInt( layer[i].activationFunction ) || !file.readFloat( layer[i].bias ) ||
+            !file.readFloat( layer[i].gamma ) || !file.readVector( layer[i].weights ) ){
+            return false;
+        }
+        
+        if( !Neuron::validateActivationFunction( (Neuron::Type)layer[i].activationFunction ) ){
+            errorLog << "loadLayerFromBinaryFile(...) - Unknown activation function: " << layer[i].activationFunction << std::endl;
+            return false;
+        }
+        
+        layer[i].numInputs = layer[i].weights.getSize();
+        layer[i].previousBiasUpdate = 0;
+        layer[i].previousUpdate.clear();
+        layer[i].previousUpdate.resize( layer[i].numInputs, 0 );
+    }
+    
+    return true;
+}
+
 UINT MLP::getNumClasses() const{
     if( classificationModeActive )
     return numOutputNeurons;
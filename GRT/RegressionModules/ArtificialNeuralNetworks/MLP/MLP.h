@@ -133,6 +133,24 @@ public:
     */
     virtual bool load( std::fstream &file );
     
+    /**
+    This saves the trained MLP model to a binary model file.
+    This overrides the saveBinary function in the MLBase base class.
+    
+    @param file: a reference to the binary file the MLP model will be saved to
+    @return returns true if the model was saved successfully, false otherwise
+    */
+    virtual bool saveBinary( BinaryModelWriter &file ) const;
+    
+    /**
+    This loads a trained MLP model from a binary model file.
+    This overrides the loadBinary function in the MLBase base class.
+    
+    @param file: a reference to the binary file the MLP model will be loaded from
+    @return returns true if the model was loaded successfully, false otherwise
+    */
+    virtual bool loadBinary( BinaryModelReader &file );
+    
     /**
     Returns the number of classes in the MLP model if the MLP is in classification mode.
     The number of classes in the model is the same as the number of output neurons.
@@ -485,9 +503,11 @@ public:
     //Tell the compiler we are using the following functions from the MLBase class to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
+    using MLBase::saveBinary;
+    using MLBase::loadBinary;
     using MLBase::train;
     using MLBase::train_;
-    using MLBase::predict;
+    using Regressifier::predict;
     using MLBase::predict_;
     
 protected:
@@ -530,6 +550,9 @@ protected:
     */
     void feedforward(const VectorFloat &data,VectorFloat &inputNeuronsOuput,VectorFloat &hiddenNeuronsOutput,VectorFloat &outputNeuronsOutput);
     
+    bool saveLayerToBinaryFile(BinaryModelWriter &file,const Vector< Neuron > &layer) const;
+    bool loadLayerFromBinaryFile(BinaryModelReader &file,Vector< Neuron > &layer,const UINT numNeurons);
+    
     UINT numInputNeurons;
     UINT numHiddenNeurons;
     UINT numOutputNeurons;
@@ -32,6 +32,9 @@ LinearRegression::LinearRegression(bool useScaling)
     minChange = 1.0e-5;
     maxNumEpochs = 500;
     learningRate = 0.01;
+    trainingMethod = NORMAL_EQUATIONS;
+    batchSize = 1;
+    regularizationCoeff = 0;
     classType = "LinearRegression";
     regressifierType = classType;
     debugLog.setProceedingText("[DEBUG LinearRegression]");
@@ -48,6 +51,9 @@ LinearRegression& LinearRegression::operator=(const LinearRegression &rhs){
     if( this != &rhs ){
         this->w0 = rhs.w0;
         this->w = rhs.w;
+        this->trainingMethod = rhs.trainingMethod;
+        this->batchSize = rhs.batchSize;
+        this->regularizationCoeff = rhs.regularizationCoeff;
         
         //Copy the base variables
         copyBaseVariables( (Regressifier*)&rhs );
@@ -65,6 +71,9 @@ bool LinearRegression::deepCopyFrom(const Regressifier *regressifier){
         
         this->w0 = ptr->w0;
         this->w = ptr->w;
+        this->trainingMethod = ptr->trainingMethod;
+        this->batchSize = ptr->batchSize;
+        this->regularizationCoeff = ptr->regularizationCoeff;
         
         //Copy the base variables
         return copyBaseVariables( regressifier );
@@ -107,6 +116,95 @@ bool LinearRegression::train_(RegressionData &trainingData){
         trainingData.scale(inputVectorRanges,targetVectorRanges,0.0,1.0);
     }
     
+    //Copy the training data into contiguous buffers, so the solvers can run over it without copying each sample
+    MatrixFloat X(M,N);
+    VectorFloat y(M);
+    for(UINT i=0; i<M; i++){
+        const VectorFloat &x = trainingData[i].getInputVector();
+        for(UINT j=0; j<N; j++){
+            X[i][j] = x[j];
+        }
+        y[i] = trainingData[i].getTargetVector()[0];
+    }
+    
+    bool result = false;
+    switch( trainingMethod ){
+        case NORMAL_EQUATIONS:
+            result = trainNormalEquations( X, y );
+            break;
+        case STOCHASTIC_GRADIENT_DESCENT:
+            result = trainGradientDescent( X, y );
+            break;
+        default:
+            errorLog << "train_(RegressionData &trainingData) - Unknown training method: " << trainingMethod << std::endl;
+            break;
+    }
+    
+    if( !result ) return false;
+    
+    //Flag that the algorithm has been trained
+    regressionData.resize(1,0);
+    trained = true;
+    return trained;
+}
+
+bool LinearRegression::trainNormalEquations(const MatrixFloat &X,const VectorFloat &y){
+    
+    const UINT M = X.getNumRows();
+    const UINT N = X.getNumCols();
+    
+    MatrixFloat Y(M,1);
+    for(UINT i=0; i<M; i++) Y[i][0] = y[i];
+    
+    //Solve for the weights in closed form
+    LinearLeastSquares solver;
+    if( !solver.solve( X, Y, regularizationCoeff ) ){
+        errorLog << "trainNormalEquations(...) - Failed to solve the normal equations!" << std::endl;
+        return false;
+    }
+    
+    const MatrixFloat &weights = solver.getWeights();
+    w0 = weights[0][0];
+    w.resize(N);
+    for(UINT j=0; j<N; j++){
+        w[j] = weights[j+1][0];
+    }
+    
+    //Compute the training error
+    totalSquaredTrainingError = 0;
+    for(UINT i=0; i<M; i++){
+        const Float *x = X[i];
+        Float h = w0;
+        for(UINT j=0; j<N; j++){
+            h += x[j] * w[j];
+        }
+        totalSquaredTrainingError += SQR( y[i] - h );
+    }
+    
+    if( grt_isinf( totalSquaredTrainingError ) || grt_isnan( totalSquaredTrainingError ) ){
+        errorLog << "trainNormalEquations(...) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << std::endl;
+        return false;
+    }
+    
+    //Store the training results
+    TrainingResult result;
+    rmsTrainingError = sqrt( totalSquaredTrainingError / Float(M) );
+    result.setRegressionResult(1,totalSquaredTrainingError,rmsTrainingError,this);
+    trainingResults.push_back( result );
+    
+    //Notify any observers of the new result
+    trainingResultsObserverManager.notifyObservers( result );
+    
+    trainingLog << "Normal Equations SSE: " << totalSquaredTrainingError << std::endl;
+    
+    return true;
+}
+
+bool LinearRegression::trainGradientDescent(const MatrixFloat &X,const VectorFloat &y){
+    
+    const UINT M = X.getNumRows();
+    const UINT N = X.getNumCols();
+    
     //Reset the weights
     Random rand;
     w0 = rand.getRandomNumberUniform(-0.1,0.1);
@@ -115,14 +213,15 @@ bool LinearRegression::train_(RegressionData &trainingData){
         w[j] = rand.getRandomNumberUniform(-0.1,0.1);
     }
     
-    Float error = 0;
     Float lastError = 0;
     Float delta = 0;
     UINT iter = 0;
     bool keepTraining = true;
     Vector< UINT > randomTrainingOrder(M);
+    VectorFloat errors(batchSize);
+    VectorFloat gradient(N);
     TrainingResult result;
-    trainingResults.reserve(M);
+    trainingResults.reserve(maxNumEpochs);
     
     //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
     //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
@@ -135,28 +234,44 @@ bool LinearRegression::train_(RegressionData &trainingData){
     //Run the main stochastic gradient descent training algorithm
     while( keepTraining ){
         
-        //Run one epoch of training using stochastic gradient descent
+        //Run one epoch of training using mini-batch stochastic gradient descent
         totalSquaredTrainingError = 0;
-        for(UINT m=0; m<M; m++){
+        UINT m = 0;
+        while( m < M ){
+            const UINT roundSize = m+batchSize < M ? batchSize : M-m;
             
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            VectorFloat x = trainingData[i].getInputVector();
-            VectorFloat y = trainingData[i].getTargetVector();
-            Float h = w0;
-            for(UINT j=0; j<N; j++){
-                h += x[j] * w[j];
+            //Compute the error for each sample in the batch, given the current weights
+            Float *wData = &w[0];
+            Float errorSum = 0;
+            for(UINT b=0; b<roundSize; b++){
+                const UINT i = randomTrainingOrder[m+b];
+                const Float *x = X[i];
+                Float h = w0;
+                for(UINT j=0; j<N; j++){
+                    h += x[j] * wData[j];
+                }
+                errors[b] = y[i] - h;
+                errorSum += errors[b];
+                totalSquaredTrainingError += SQR( errors[b] );
             }
-            error = y[0] - h;
-            totalSquaredTrainingError += SQR( error );
             
-            //Update the weights
+            //Update the weights with the mean gradient of the batch
+            std::fill(gradient.begin(),gradient.end(),0);
+            Float *g = &gradient[0];
+            for(UINT b=0; b<roundSize; b++){
+                const Float *x = X[ randomTrainingOrder[m+b] ];
+                const Float e = errors[b];
+                for(UINT j=0; j<N; j++){
+                    g[j] += e * x[j];
+                }
+            }
+            const Float stepSize = learningRate / roundSize;
             for(UINT j=0; j<N; j++){
-                w[j] += learningRate * error * x[j];
+                wData[j] += stepSize * g[j];
             }
-            w0 += learningRate * error;
+            w0 += stepSize * errorSum;
+            
+            m += roundSize;
         }
         
         //Compute the error
@@ -188,13 +303,14 @@ bool LinearRegression::train_(RegressionData &trainingData){
         trainingLog << "Epoch: " << iter << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << std::endl;
     }
     
-    //Flag that the algorithm has been trained
-    regressionData.resize(1,0);
-    trained = true;
-    return trained;
+    return true;
 }
 
 bool LinearRegression::predict_(VectorFloat &inputVector){
+    return predictAndStoreResults( inputVector );
+}
+
+bool LinearRegression::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
     
     if( !trained ){
         errorLog << "predict_(VectorFloat &inputVector) - Model Not Trained!" << std::endl;
@@ -214,6 +330,9 @@ bool LinearRegression::predict_(VectorFloat &inputVector){
         }
     }
     
+    VectorFloat &regressionData = context.regressionData;
+    if( regressionData.getSize() != numOutputDimensions ) regressionData.resize( numOutputDimensions );
+    
     regressionData[0] =  w0;
     for(UINT j=0; j<numInputDimensions; j++){
         regressionData[0] += inputVector[j] * w[j];
@@ -318,6 +437,45 @@ UINT LinearRegression::getMaxNumIterations() const{
     return getMaxNumEpochs();
 }
 
+UINT LinearRegression::getTrainingMethod() const{
+    return trainingMethod;
+}
+
+UINT LinearRegression::getBatchSize() const{
+    return batchSize;
+}
+
+Float LinearRegression::getRegularizationCoeff() const{
+    return regularizationCoeff;
+}
+
+bool LinearRegression::setTrainingMethod(const UINT trainingMethod){
+    if( trainingMethod != STOCHASTIC_GRADIENT_DESCENT && trainingMethod != NORMAL_EQUATIONS ){
+        warningLog << "setTrainingMethod(const UINT trainingMethod) - Unknown training method: " << trainingMethod << std::endl;
+        return false;
+    }
+    this->trainingMethod = trainingMethod;
+    return true;
+}
+
+bool LinearRegression::setBatchSize(const UINT batchSize){
+    if( batchSize == 0 ){
+        warningLog << "setBatchSize(const UINT batchSize) - The batch size must be greater than zero!" << std::endl;
+        return false;
+    }
+    this->batchSize = batchSize;
+    return true;
+}
+
+bool LinearRegression::setRegularizationCoeff(const Float regularizationCoeff){
+    if( regularizationCoeff < 0 ){
+        warningLog << "setRegularizationCoeff(const Float regularizationCoeff) - The regularization coefficient must be greater than or equal to zero!" << std::endl;
+        return false;
+    }
+    this->regularizationCoeff = regularizationCoeff;
+    return true;
+}
+
 bool LinearRegression::loadLegacyModelFromFile( std::fstream &file ){
     
     std::string word;
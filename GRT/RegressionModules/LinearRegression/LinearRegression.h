@@ -34,12 +34,15 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_LINEAR_REGRESSION_HEADER
 
 #include "../../CoreModules/Regressifier.h"
+#include "../../CoreAlgorithms/LeastSquares/LinearLeastSquares.h"
 
 GRT_BEGIN_NAMESPACE
 
 class GRT_API LinearRegression : public Regressifier
 {
     public:
+    enum TrainingMethods{ STOCHASTIC_GRADIENT_DESCENT=0, NORMAL_EQUATIONS };
+    
     /**
     Default Constructor
     
@@ -70,8 +73,9 @@ class GRT_API LinearRegression : public Regressifier
     virtual bool deepCopyFrom(const Regressifier *regressifier);
     
     /**
-    This trains the Logistic Regression model, using the labelled regression data.
+    This trains the Linear Regression model, using the labelled regression data.
     This overrides the train function in the Regression base class.
+    By default the weights are solved in closed form with the normal equations, see setTrainingMethod.
     
     @param trainingData: the training data that will be used to train the regression model
     @return returns true if the LRC model was trained, false otherwise
@@ -121,13 +125,61 @@ class GRT_API LinearRegression : public Regressifier
     */
     bool setMaxNumIterations(const UINT maxNumIterations);
     
+    /**
+    @return returns the training method, this will be one of the TrainingMethods enums
+    */
+    UINT getTrainingMethod() const;
+    
+    /**
+    @return returns the number of training samples used in each batch to update the weights with stochastic gradient descent
+    */
+    UINT getBatchSize() const;
+    
+    /**
+    @return returns the L2 regularization coefficient
+    */
+    Float getRegularizationCoeff() const;
+    
+    /**
+    Sets the training method. This should be NORMAL_EQUATIONS (the default), which solves for the weights in closed form with a
+    Cholesky decomposition, or STOCHASTIC_GRADIENT_DESCENT, which uses the learningRate, batchSize, minChange and maxNumEpochs.
+    
+    @param trainingMethod: the new training method
+    @return returns true if the training method was updated, false otherwise
+    */
+    bool setTrainingMethod(const UINT trainingMethod);
+    
+    /**
+    Sets the number of training samples used in each batch to update the weights with stochastic gradient descent.
+    A batch size of 1 updates the weights after every sample.
+    
+    @param batchSize: the new batch size, must be greater than zero. Default value = 1
+    @return returns true if the batch size was updated, false otherwise
+    */
+    bool setBatchSize(const UINT batchSize);
+    
+    /**
+    Sets the L2 regularization coefficient. The bias is not regularized.
+    
+    @param regularizationCoeff: the new regularization coefficient, must be greater than or equal to zero. Default value = 0
+    @return returns true if the regularization coefficient was updated, false otherwise
+    */
+    bool setRegularizationCoeff(const Float regularizationCoeff);
+    
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
     
     protected:
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    
+    bool trainNormalEquations(const MatrixFloat &X,const VectorFloat &y);
+    bool trainGradientDescent(const MatrixFloat &X,const VectorFloat &y);
     bool loadLegacyModelFromFile( std::fstream &file );
     
+    UINT trainingMethod;
+    UINT batchSize;
+    Float regularizationCoeff;
     Float w0;
     VectorFloat w;
     static RegisterRegressifierModule< LinearRegression > registerModule;
@@ -136,4 +188,4 @@ class GRT_API LinearRegression : public Regressifier
 GRT_END_NAMESPACE
 
 #endif //GRT_LINEAR_REGRESSION_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
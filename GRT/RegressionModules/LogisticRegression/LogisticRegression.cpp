@@ -32,6 +32,9 @@ LogisticRegression::LogisticRegression(const bool useScaling)
     minChange = 1.0e-5;
     maxNumEpochs = 500;
     learningRate = 0.01;
+    trainingMethod = NEWTON_IRLS;
+    batchSize = 1;
+    regularizationCoeff = 0;
     classType = "LogisticRegression";
     regressifierType = classType;
     debugLog.setProceedingText("[DEBUG LogisticRegression]");
@@ -48,6 +51,9 @@ LogisticRegression& LogisticRegression::operator=(const LogisticRegression &rhs)
     if( this != &rhs ){
         this->w0 = rhs.w0;
         this->w = rhs.w;
+        this->trainingMethod = rhs.trainingMethod;
+        this->batchSize = rhs.batchSize;
+        this->regularizationCoeff = rhs.regularizationCoeff;
         
         //Copy the base variables
         copyBaseVariables( (Regressifier*)&rhs );
@@ -64,6 +70,9 @@ bool LogisticRegression::deepCopyFrom(const Regressifier *regressifier){
         
         this->w0 = ptr->w0;
         this->w = ptr->w;
+        this->trainingMethod = ptr->trainingMethod;
+        this->batchSize = ptr->batchSize;
+        this->regularizationCoeff = ptr->regularizationCoeff;
         
         //Copy the base variables
         return copyBaseVariables( regressifier );
@@ -106,23 +115,261 @@ bool LogisticRegression::train_(RegressionData &trainingData){
         trainingData.scale(inputVectorRanges,targetVectorRanges,0.0,1.0);
     }
     
-    //Reset the weights
+    //Copy the training data into contiguous buffers, the first column of X is set to 1 for the bias
+    MatrixFloat X(M,N+1);
+    VectorFloat y(M);
+    for(UINT i=0; i<M; i++){
+        const VectorFloat &x = trainingData[i].getInputVector();
+        X[i][0] = 1.0;
+        for(UINT j=0; j<N; j++){
+            X[i][j+1] = x[j];
+        }
+        y[i] = trainingData[i].getTargetVector()[0];
+    }
+    
+    bool result = false;
+    switch( trainingMethod ){
+        case NEWTON_IRLS:
+            result = trainNewton( X, y );
+            break;
+        case LIMITED_MEMORY_BFGS:
+            result = trainLBFGS( X, y );
+            break;
+        case STOCHASTIC_GRADIENT_DESCENT:
+            result = trainGradientDescent( X, y );
+            break;
+        default:
+            errorLog << "train_(RegressionData &trainingData) - Unknown training method: " << trainingMethod << std::endl;
+            break;
+    }
+    
+    if( !result ) return false;
+    
+    //Flag that the algorithm has been trained
+    regressionData.resize(1,0);
+    trained = true;
+    return trained;
+}
+
+Float LogisticRegression::computeLoss(const MatrixFloat &X,const VectorFloat &y,const VectorFloat &theta,VectorFloat &p,Float &squaredError,VectorFloat *gradient) const{
+    
+    const UINT M = X.getNumRows();
+    const UINT D = X.getNumCols();
+    const Float *t = &theta[0];
+    
+    //Compute the cross entropy loss, using log(1+exp(h)) - y*h so the loss stays finite for large |h|
+    Float loss = 0;
+    squaredError = 0;
+    for(UINT i=0; i<M; i++){
+        const Float *x = X[i];
+        Float h = 0;
+        for(UINT j=0; j<D; j++){
+            h += x[j] * t[j];
+        }
+        p[i] = sigmoid( h );
+        loss += (h > 0 ? h + log( 1.0 + exp(-h) ) : log( 1.0 + exp(h) )) - y[i] * h;
+        squaredError += SQR( y[i] - p[i] );
+    }
+    
+    //The bias (theta[0]) is not regularized
+    Float sumSquares = 0;
+    for(UINT j=1; j<D; j++){
+        sumSquares += t[j] * t[j];
+    }
+    loss += 0.5 * regularizationCoeff * sumSquares;
+    
+    if( gradient != NULL ){
+        Float *g = &(*gradient)[0];
+        std::fill(gradient->begin(),gradient->end(),0);
+        for(UINT i=0; i<M; i++){
+            const Float *x = X[i];
+            const Float e = p[i] - y[i];
+            for(UINT j=0; j<D; j++){
+                g[j] += e * x[j];
+            }
+        }
+        for(UINT j=1; j<D; j++){
+            g[j] += regularizationCoeff * t[j];
+        }
+    }
+    
+    return loss;
+}
+
+bool LogisticRegression::trainNewton(const MatrixFloat &X,const VectorFloat &y){
+    
+    const UINT M = X.getNumRows();
+    const UINT D = X.getNumCols();
+    VectorFloat theta(D,0);
+    VectorFloat thetaNew(D);
+    VectorFloat p(M);
+    VectorFloat gradient(D);
+    VectorFloat direction(D);
+    MatrixFloat weightedX(M,D);
+    MatrixFloat hessian;
+    TrainingResult result;
+    Float squaredError = 0;
+    
+    Float loss = computeLoss( X, y, theta, p, squaredError, &gradient );
+    UINT iter = 0;
+    bool keepTraining = true;
+    
+    //Run iteratively reweighted least squares: each iteration solves (X'SX + ridge) d = g, where S = diag(p(1-p))
+    while( keepTraining ){
+        
+        //Compute the Hessian with one matrix product, scaling each row of X by sqrt(p(1-p))
+        for(UINT i=0; i<M; i++){
+            const Float s = sqrt( p[i] * (1.0 - p[i]) );
+            const Float *x = X[i];
+            Float *wx = weightedX[i];
+            for(UINT j=0; j<D; j++){
+                wx[j] = x[j] * s;
+            }
+        }
+        hessian.multiple( weightedX, weightedX, true );
+        for(UINT j=1; j<D; j++){
+            hessian[j][j] += regularizationCoeff;
+        }
+        
+        //Add a small amount of regularization if the Hessian is singular (for example when the data is separable)
+        Float trace = 0;
+        for(UINT j=0; j<D; j++) trace += hessian[j][j];
+        Float jitter = 0;
+        bool solved = false;
+        for(UINT attempt=0; attempt<10 && !solved; attempt++){
+            MatrixFloat regularizedHessian( hessian );
+            for(UINT j=0; j<D; j++) regularizedHessian[j][j] += jitter;
+            Cholesky cholesky( regularizedHessian );
+            if( cholesky.getSuccess() ){
+                cholesky.solve( gradient, direction );
+                solved = true;
+            }else jitter = jitter == 0 ? (trace > 0 ? trace / D : 1.0) * 1.0e-10 : jitter * 100;
+        }
+        if( !solved ){
+            errorLog << "trainNewton(...) - Failed to solve the Newton step, the Hessian is singular!" << std::endl;
+            return false;
+        }
+        
+        //Backtracking line search on the Newton step
+        Float decrease = 0;
+        for(UINT j=0; j<D; j++) decrease += gradient[j] * direction[j];
+        Float step = 1.0;
+        Float newLoss = loss;
+        bool stepFound = false;
+        for(UINT n=0; n<30; n++){
+            for(UINT j=0; j<D; j++) thetaNew[j] = theta[j] - step * direction[j];
+            newLoss = computeLoss( X, y, thetaNew, p, squaredError, NULL );
+            if( newLoss <= loss - 1.0e-4 * step * decrease ){
+                stepFound = true;
+                break;
+            }
+            step *= 0.5;
+        }
+        
+        Float delta = 0;
+        if( stepFound ){
+            theta.swap( thetaNew );
+            newLoss = computeLoss( X, y, theta, p, squaredError, &gradient );
+            delta = fabs( loss - newLoss );
+            loss = newLoss;
+        }else{
+            //The loss can not be decreased any further
+            computeLoss( X, y, theta, p, squaredError, NULL );
+            keepTraining = false;
+        }
+        
+        if( grt_isinf( loss ) || grt_isnan( loss ) ){
+            errorLog << "trainNewton(...) - Training failed! The training loss is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << std::endl;
+            return false;
+        }
+        
+        if( delta <= minChange ){
+            keepTraining = false;
+        }
+        
+        if( ++iter >= maxNumEpochs ){
+            keepTraining = false;
+        }
+        
+        //Store the training results
+        totalSquaredTrainingError = squaredError;
+        rmsTrainingError = sqrt( totalSquaredTrainingError / Float(M) );
+        result.setRegressionResult(iter,totalSquaredTrainingError,rmsTrainingError,this);
+        trainingResults.push_back( result );
+        
+        //Notify any observers of the new result
+        trainingResultsObserverManager.notifyObservers( result );
+        
+        trainingLog << "Iteration: " << iter << " Loss: " << loss << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << std::endl;
+    }
+    
+    setWeights( theta );
+    
+    return true;
+}
+
+bool LogisticRegression::trainLBFGS(const MatrixFloat &X,const VectorFloat &y){
+    
+    const UINT M = X.getNumRows();
+    const UINT D = X.getNumCols();
+    VectorFloat p(M);
+    Float squaredError = 0;
+    
+    LBFGS::ObjectiveFunction objective = [&]( const VectorFloat &theta, VectorFloat &gradient ){
+        return computeLoss( X, y, theta, p, squaredError, &gradient );
+    };
+    
+    VectorFloat theta(D,0);
+    LBFGS optimizer( 10, maxNumEpochs, minChange );
+    if( !optimizer.minimize( objective, theta ) ){
+        errorLog << "trainLBFGS(...) - Failed to minimize the training loss!" << std::endl;
+        return false;
+    }
+    
+    //Compute the training error of the final weights
+    const Float loss = computeLoss( X, y, theta, p, squaredError, NULL );
+    if( grt_isinf( loss ) || grt_isnan( loss ) ){
+        errorLog << "trainLBFGS(...) - Training failed! The training loss is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << std::endl;
+        return false;
+    }
+    
+    TrainingResult result;
+    totalSquaredTrainingError = squaredError;
+    rmsTrainingError = sqrt( totalSquaredTrainingError / Float(M) );
+    result.setRegressionResult(optimizer.getNumIterations(),totalSquaredTrainingError,rmsTrainingError,this);
+    trainingResults.push_back( result );
+    
+    //Notify any observers of the new result
+    trainingResultsObserverManager.notifyObservers( result );
+    
+    trainingLog << "Iterations: " << optimizer.getNumIterations() << " Loss: " << loss << " SSE: " << totalSquaredTrainingError << std::endl;
+    
+    setWeights( theta );
+    
+    return true;
+}
+
+bool LogisticRegression::trainGradientDescent(const MatrixFloat &X,const VectorFloat &y){
+    
+    const UINT M = X.getNumRows();
+    const UINT D = X.getNumCols();
+    
+    //Reset the weights, theta[0] is the bias
     Random rand;
-    w0 = rand.getRandomNumberUniform(-0.1,0.1);
-    w.resize(N);
-    for(UINT j=0; j<N; j++){
-        w[j] = rand.getRandomNumberUniform(-0.1,0.1);
+    VectorFloat theta(D);
+    for(UINT j=0; j<D; j++){
+        theta[j] = rand.getRandomNumberUniform(-0.1,0.1);
     }
     
-    Float error = 0;
     Float lastSquaredError = 0;
     Float delta = 0;
     UINT iter = 0;
     bool keepTraining = true;
-    Random random;
     Vector< UINT > randomTrainingOrder(M);
+    VectorFloat errors(batchSize);
+    VectorFloat gradient(D);
     TrainingResult result;
-    trainingResults.reserve(M);
+    trainingResults.reserve(maxNumEpochs);
     
     //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
     //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
@@ -135,28 +382,41 @@ bool LogisticRegression::train_(RegressionData &trainingData){
     //Run the main stochastic gradient descent training algorithm
     while( keepTraining ){
         
-        //Run one epoch of training using stochastic gradient descent
+        //Run one epoch of training using mini-batch stochastic gradient descent
         totalSquaredTrainingError = 0;
-        for(UINT m=0; m<M; m++){
+        UINT m = 0;
+        while( m < M ){
+            const UINT roundSize = m+batchSize < M ? batchSize : M-m;
+            Float *t = &theta[0];
             
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            VectorFloat x = trainingData[i].getInputVector();
-            VectorFloat y = trainingData[i].getTargetVector();
-            Float h = w0;
-            for(UINT j=0; j<N; j++){
-                h += x[j] * w[j];
+            //Compute the error for each sample in the batch, given the current weights
+            for(UINT b=0; b<roundSize; b++){
+                const UINT i = randomTrainingOrder[m+b];
+                const Float *x = X[i];
+                Float h = 0;
+                for(UINT j=0; j<D; j++){
+                    h += x[j] * t[j];
+                }
+                errors[b] = y[i] - sigmoid( h );
+                totalSquaredTrainingError += SQR( errors[b] );
             }
-            error = y[0] - sigmoid( h );
-            totalSquaredTrainingError += SQR(error);
             
-            //Update the weights
-            for(UINT j=0; j<N; j++){
-                w[j] += learningRate * error * x[j];
+            //Update the weights with the mean gradient of the batch
+            std::fill(gradient.begin(),gradient.end(),0);
+            Float *g = &gradient[0];
+            for(UINT b=0; b<roundSize; b++){
+                const Float *x = X[ randomTrainingOrder[m+b] ];
+                const Float e = errors[b];
+                for(UINT j=0; j<D; j++){
+                    g[j] += e * x[j];
+                }
+            }
+            const Float stepSize = learningRate / roundSize;
+            for(UINT j=0; j<D; j++){
+                t[j] += stepSize * g[j];
             }
-            w0 += learningRate * error;
+            
+            m += roundSize;
         }
         
         //Compute the error
@@ -188,13 +448,24 @@ bool LogisticRegression::train_(RegressionData &trainingData){
         trainingLog << "Epoch: " << iter << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << std::endl;
     }
     
-    //Flag that the algorithm has been trained
-    regressionData.resize(1,0);
-    trained = true;
-    return trained;
+    setWeights( theta );
+    
+    return true;
+}
+
+void LogisticRegression::setWeights(const VectorFloat &theta){
+    w0 = theta[0];
+    w.resize( theta.getSize()-1 );
+    for(UINT j=1; j<theta.getSize(); j++){
+        w[j-1] = theta[j];
+    }
 }
 
 bool LogisticRegression::predict_(VectorFloat &inputVector){
+    return predictAndStoreResults( inputVector );
+}
+
+bool LogisticRegression::predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const{
     
     if( !trained ){
         errorLog << "predict_(VectorFloat &inputVector) - Model Not Trained!" << std::endl;
@@ -214,13 +485,14 @@ bool LogisticRegression::predict_(VectorFloat &inputVector){
         }
     }
     
+    VectorFloat &regressionData = context.regressionData;
+    if( regressionData.getSize() != numOutputDimensions ) regressionData.resize( numOutputDimensions );
+    
     regressionData[0] =  w0;
     for(UINT j=0; j<numInputDimensions; j++){
         regressionData[0] += inputVector[j] * w[j];
     }
-    Float sum = regressionData[0];
     regressionData[0] = sigmoid( regressionData[0] );
-    std::cout << "reg sum: " << sum << " sig: " << regressionData[0] << std::endl;
     if( useScaling ){
         for(UINT n=0; n<numOutputDimensions; n++){
             regressionData[n] = grt_scale(regressionData[n], 0.0, 1.0, targetVectorRanges[n].minValue, targetVectorRanges[n].maxValue);
@@ -248,12 +520,15 @@ bool LogisticRegression::save( std::fstream &file ) const{
     }
     
     if( trained ){
+        //Write the weights with enough digits to load exactly the same model
+        const std::streamsize precision = file.precision( std::numeric_limits< Float >::digits10 + 3 );
         file << "Weights: ";
         file << w0;
         for(UINT j=0; j<numInputDimensions; j++){
             file << " " << w[j];
         }
         file << std::endl;
+        file.precision( precision );
     }
     
     return true;
@@ -327,6 +602,45 @@ Float LogisticRegression::sigmoid(const Float x) const{
     return 1.0 / (1 + exp(-x));
 }
 
+UINT LogisticRegression::getTrainingMethod() const{
+    return trainingMethod;
+}
+
+UINT LogisticRegression::getBatchSize() const{
+    return batchSize;
+}
+
+Float LogisticRegression::getRegularizationCoeff() const{
+    return regularizationCoeff;
+}
+
+bool LogisticRegression::setTrainingMethod(const UINT trainingMethod){
+    if( trainingMethod != STOCHASTIC_GRADIENT_DESCENT && trainingMethod != NEWTON_IRLS && trainingMethod != LIMITED_MEMORY_BFGS ){
+        warningLog << "setTrainingMethod(const UINT trainingMethod) - Unknown training method: " << trainingMethod << std::endl;
+        return false;
+    }
+    this->trainingMethod = trainingMethod;
+    return true;
+}
+
+bool LogisticRegression::setBatchSize(const UINT batchSize){
+    if( batchSize == 0 ){
+        warningLog << "setBatchSize(const UINT batchSize) - The batch size must be greater than zero!" << std::endl;
+        return false;
+    }
+    this->batchSize = batchSize;
+    return true;
+}
+
+bool LogisticRegression::setRegularizationCoeff(const Float regularizationCoeff){
+    if( regularizationCoeff < 0 ){
+        warningLog << "setRegularizationCoeff(const Float regularizationCoeff) - The regularization coefficient must be greater than or equal to zero!" << std::endl;
+        return false;
+    }
+    this->regularizationCoeff = regularizationCoeff;
+    return true;
+}
+
 bool LogisticRegression::loadLegacyModelFromFile( std::fstream &file ){
     
     std::string word;
@@ -34,12 +34,16 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_LOGISTIC_REGRESSION_HEADER
 
 #include "../../CoreModules/Regressifier.h"
+#include "../../CoreAlgorithms/LBFGS/LBFGS.h"
+#include "../../Util/Cholesky.h"
 
 GRT_BEGIN_NAMESPACE
 
 class GRT_API LogisticRegression : public Regressifier
 {
     public:
+    enum TrainingMethods{ STOCHASTIC_GRADIENT_DESCENT=0, NEWTON_IRLS, LIMITED_MEMORY_BFGS };
+    
     /**
     Default Constructor
     
@@ -72,6 +76,7 @@ class GRT_API LogisticRegression : public Regressifier
     /**
     This trains the Logistic Regression model, using the labelled regression data.
     This overrides the train function in the Regression base class.
+    By default the cross entropy loss is minimized with Newton's method, see setTrainingMethod.
     
     @param trainingData: the training data that will be used to train the regression model
     @return returns true if the LRC model was trained, false otherwise
@@ -121,14 +126,67 @@ class GRT_API LogisticRegression : public Regressifier
     */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+    @return returns the training method, this will be one of the TrainingMethods enums
+    */
+    UINT getTrainingMethod() const;
+    
+    /**
+    @return returns the number of training samples used in each batch to update the weights with stochastic gradient descent
+    */
+    UINT getBatchSize() const;
+    
+    /**
+    @return returns the L2 regularization coefficient
+    */
+    Float getRegularizationCoeff() const;
+    
+    /**
+    Sets the training method, which minimizes the cross entropy loss. This should be NEWTON_IRLS (the default), which runs
+    Newton's method as iteratively reweighted least squares, LIMITED_MEMORY_BFGS, or STOCHASTIC_GRADIENT_DESCENT, which uses
+    the learningRate and batchSize. All the methods use maxNumEpochs as the maximum number of iterations and minChange as the
+    minimum change between two iterations.
+    
+    @param trainingMethod: the new training method
+    @return returns true if the training method was updated, false otherwise
+    */
+    bool setTrainingMethod(const UINT trainingMethod);
+    
+    /**
+    Sets the number of training samples used in each batch to update the weights with stochastic gradient descent.
+    A batch size of 1 updates the weights after every sample.
+    
+    @param batchSize: the new batch size, must be greater than zero. Default value = 1
+    @return returns true if the batch size was updated, false otherwise
+    */
+    bool setBatchSize(const UINT batchSize);
+    
+    /**
+    Sets the L2 regularization coefficient. The bias is not regularized.
+    
+    @param regularizationCoeff: the new regularization coefficient, must be greater than or equal to zero. Default value = 0
+    @return returns true if the regularization coefficient was updated, false otherwise
+    */
+    bool setRegularizationCoeff(const Float regularizationCoeff);
+    
     //Tell the compiler we are using the base class train method to stop hidden virtual function warnings
     using MLBase::save;
     using MLBase::load;
     
 protected:
+    virtual bool predictWithContext_(VectorFloat &inputVector,PredictionContext &context) const;
+    
     inline Float sigmoid(const Float x) const;
+    Float computeLoss(const MatrixFloat &X,const VectorFloat &y,const VectorFloat &theta,VectorFloat &p,Float &squaredError,VectorFloat *gradient) const;
+    bool trainNewton(const MatrixFloat &X,const VectorFloat &y);
+    bool trainLBFGS(const MatrixFloat &X,const VectorFloat &y);
+    bool trainGradientDescent(const MatrixFloat &X,const VectorFloat &y);
+    void setWeights(const VectorFloat &theta);
     bool loadLegacyModelFromFile( std::fstream &file );
     
+    UINT trainingMethod;
+    UINT batchSize;
+    Float regularizationCoeff;
     Float w0; ///<The bias
     VectorFloat w; ///<The weights vector
     static RegisterRegressifierModule< LogisticRegression > registerModule;
@@ -137,4 +195,4 @@ protected:
 GRT_END_NAMESPACE
 
 #endif //GRT_LOGISTIC_REGRESSION_HEADER
-    
\ No newline at end of file
+    
\ No newline at end of file
@@ -139,19 +139,22 @@ bool MultidimensionalRegression::train_(RegressionData &trainingData){
         }
     }
     
-    //Train each regression module
-    for(UINT k=0; k<K; k++){
+    //Train each regression module, the modules are independent so they are trained in parallel
+    auto trainModule = [&]( const UINT k ){
         
         trainingLog << "Training regression module: " << k << std::endl;
         
         //We need to create a 1 dimensional training dataset for the k'th target dimension
         RegressionData data;
         data.setInputAndTargetDimensions(N, 1);
+        data.reserve(M);
         
+        VectorFloat target(1);
         for(UINT i=0; i<M; i++){
-            if( !data.addSample(trainingData[i].getInputVector(), VectorFloat(1,trainingData[i].getTargetVector()[k]) ) ){
+            target[0] = trainingData[i].getTargetVector()[k];
+            if( !data.addSample(trainingData[i].getInputVector(), target ) ){
                 errorLog << "train_(RegressionData &trainingData) - Failed to add sample to dataset for regression module " << k << std::endl;
-                    return false;
+                return false;
             }
         }
         
@@ -159,6 +162,17 @@ bool MultidimensionalRegression::train_(RegressionData &trainingData){
             errorLog << "train_(RegressionData &trainingData) - Failed to train regression module " << k << std::endl;
             return false;
         }
+        return true;
+    };
+    
+    Vector< unsigned int > moduleTrained( K, 0 );
+    ThreadPool::parallelFor( 0, K, 1, [&trainModule,&moduleTrained](const UINT begin,const UINT end){
+        for(UINT k=begin; k<end; k++) moduleTrained[k] = trainModule( k ) ? 1 : 0;
+        return true;
+    } );
+    
+    for(UINT k=0; k<K; k++){
+        if( !moduleTrained[k] ) return false;
     }
     
     //Flag that the algorithm has been trained
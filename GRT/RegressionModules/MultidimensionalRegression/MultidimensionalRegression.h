@@ -79,6 +79,7 @@ public:
     /**
      This trains the Multidimensional Regression model, using the labelled regression data.
      This overrides the train function in the ML base class.
+     The regression module for each target dimension is trained in parallel if GRT_CXX11_ENABLED is defined.
      
      @param trainingData: the training data that will be used to train the regression model
      @return returns true if the Multidimensional Regression model was trained, false otherwise
@@ -0,0 +1,779 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define GRT_DLL_EXPORTS
+#include "BinaryModelFile.h"
+#include <string.h>
+#include <stdint.h>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GRT_BINARY_MODEL_FILE_USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __GRT_WINDOWS_BUILD__
+#define GRT_NULL_DEVICE "NUL"
+#else
+#define GRT_NULL_DEVICE "/dev/null"
+#endif
+
+GRT_BEGIN_NAMESPACE
+
+//The file header is: the magic string (8 bytes), the endian tag, the format version, the size of the Float type and the large block alignment
+//(4 bytes each), followed by 8 reserved bytes
+static const char BINARY_MODEL_FILE_MAGIC[8] = {'G','R','T','_','B','I','N','\n'};
+static const uint32_t BINARY_MODEL_FILE_ENDIAN_TAG = 0x01020304;
+static const uint32_t BINARY_MODEL_FILE_VERSION = 1;
+static const uint32_t BINARY_MODEL_FILE_SECTION_TAG = 0x54434553;
+static const unsigned long long BINARY_MODEL_FILE_HEADER_SIZE = 32;
+static const unsigned long long BINARY_MODEL_FILE_LARGE_BLOCK_SIZE = 256;
+static const unsigned long long BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT = 64;
+
+//Blocks of at least BINARY_MODEL_FILE_LARGE_BLOCK_SIZE bytes are cache line aligned, smaller blocks only need to be aligned for their values
+static unsigned long long getBlockAlignment(const unsigned long long numBytes,const unsigned int valueSize){
+    return numBytes >= BINARY_MODEL_FILE_LARGE_BLOCK_SIZE ? BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT : valueSize;
+}
+
+/////////////////////////////// BinaryModelWriter ///////////////////////////////
+
+BinaryModelWriter::BinaryModelWriter() : errorLog("[ERROR BinaryModelWriter]"){
+    position = 0;
+    fileFloatSize = sizeof(Float);
+    textFileBuffer = NULL;
+}
+
+BinaryModelWriter::~BinaryModelWriter(){
+    if( textFileBuffer != NULL ){
+        static_cast< std::ios& >( textFile ).rdbuf( textFileBuffer );
+        textFileBuffer = NULL;
+    }
+    if( file.is_open() ) file.close();
+}
+
+bool BinaryModelWriter::open(const std::string &filename,const UINT floatSize){
+
+    if( file.is_open() ) close();
+
+    if( floatSize != sizeof(float) && floatSize != sizeof(double) ){
+        errorLog << "open(const std::string &filename,const UINT floatSize) - The float size must be " << sizeof(float) << " or " << sizeof(double) << "!" << std::endl;
+        return false;
+    }
+
+    file.open( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+    if( !file.is_open() ){
+        errorLog << "open(const std::string &filename) - Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    position = 0;
+    fileFloatSize = floatSize;
+    sectionStack.clear();
+
+    const uint32_t floatSizeValue = fileFloatSize;
+    const uint32_t largeBlockAlignment = (uint32_t)BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT;
+    const uint64_t reserved = 0;
+    writeBytes( BINARY_MODEL_FILE_MAGIC, sizeof(BINARY_MODEL_FILE_MAGIC) );
+    writeBytes( &BINARY_MODEL_FILE_ENDIAN_TAG, sizeof(uint32_t) );
+    writeBytes( &BINARY_MODEL_FILE_VERSION, sizeof(uint32_t) );
+    writeBytes( &floatSizeValue, sizeof(uint32_t) );
+    writeBytes( &largeBlockAlignment, sizeof(uint32_t) );
+
+    return writeBytes( &reserved, sizeof(uint64_t) );
+}
+
+bool BinaryModelWriter::close(){
+
+    if( !file.is_open() ) return false;
+
+    const bool ok = sectionStack.getSize() == 0 && file.good();
+    if( sectionStack.getSize() != 0 ){
+        errorLog << "close() - Not all sections have been ended!" << std::endl;
+    }
+
+    file.close();
+    sectionStack.clear();
+
+    return ok;
+}
+
+bool BinaryModelWriter::getIsOpen() const{
+    return file.is_open();
+}
+
+bool BinaryModelWriter::beginSection(const std::string &name){
+
+    if( !writeBytes( &BINARY_MODEL_FILE_SECTION_TAG, sizeof(uint32_t) ) ) return false;
+    if( !writeString( name ) ) return false;
+
+    //Write a placeholder for the section size, this is filled in when the section is ended
+    sectionStack.push_back( position );
+    const uint64_t sectionSize = 0;
+    return writeBytes( &sectionSize, sizeof(uint64_t) );
+}
+
+bool BinaryModelWriter::endSection(){
+
+    if( sectionStack.getSize() == 0 ){
+        errorLog << "endSection() - There is no section to end!" << std::endl;
+        return false;
+    }
+
+    const unsigned long long sizePosition = sectionStack.back();
+    sectionStack.pop_back();
+    const uint64_t sectionSize = position - (sizePosition + sizeof(uint64_t));
+
+    file.seekp( sizePosition );
+    file.write( reinterpret_cast< const char* >( &sectionSize ), sizeof(uint64_t) );
+    file.seekp( position );
+
+    if( !file.good() ){
+        errorLog << "endSection() - Failed to write the section size!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelWriter::writeUInt(const UINT value){
+    const uint32_t v = value;
+    return writeBytes( &v, sizeof(uint32_t) );
+}
+
+bool BinaryModelWriter::writeInt(const int value){
+    const int32_t v = value;
+    return writeBytes( &v, sizeof(int32_t) );
+}
+
+bool BinaryModelWriter::writeBool(const bool value){
+    const uint8_t v = value ? 1 : 0;
+    return writeBytes( &v, sizeof(uint8_t) );
+}
+
+bool BinaryModelWriter::writeFloat(const Float value){
+    if( fileFloatSize == sizeof(Float) ) return writeBytes( &value, sizeof(Float) );
+    if( fileFloatSize == sizeof(double) ){
+        const double v = value;
+        return writeBytes( &v, sizeof(double) );
+    }
+    const float v = (float)value;
+    return writeBytes( &v, sizeof(float) );
+}
+
+bool BinaryModelWriter::writeString(const std::string &value){
+    const uint32_t length = (uint32_t)value.length();
+    if( !writeBytes( &length, sizeof(uint32_t) ) ) return false;
+    return writeBytes( value.c_str(), length );
+}
+
+bool BinaryModelWriter::writeVector(const VectorFloat &data){
+    return writeFloatBlock( data.getSize() > 0 ? &data[0] : NULL, data.getSize() );
+}
+
+bool BinaryModelWriter::writeVector(const Vector< UINT > &data){
+    const uint64_t size = data.getSize();
+    if( !writeBytes( &size, sizeof(uint64_t) ) ) return false;
+    for(UINT i=0; i<data.getSize(); i++){
+        if( !writeUInt( data[i] ) ) return false;
+    }
+    return true;
+}
+
+bool BinaryModelWriter::writeVector(const Vector< MinMax > &data){
+    const uint64_t size = data.getSize();
+    if( !writeBytes( &size, sizeof(uint64_t) ) ) return false;
+    for(UINT i=0; i<data.getSize(); i++){
+        if( !writeFloat( data[i].minValue ) || !writeFloat( data[i].maxValue ) ) return false;
+    }
+    return true;
+}
+
+bool BinaryModelWriter::writeMatrix(const MatrixFloat &data){
+    if( !writeUInt( data.getNumRows() ) ) return false;
+    if( !writeUInt( data.getNumCols() ) ) return false;
+    return writeFloatBlock( data.getData(), data.getSize() );
+}
+
+bool BinaryModelWriter::writeFloatBlock(const Float *data,const UINT size){
+
+    const uint64_t numValues = size;
+    const unsigned long long numBytes = numValues * fileFloatSize;
+    if( !writeBytes( &numValues, sizeof(uint64_t) ) ) return false;
+    if( !writePadding( getBlockAlignment( numBytes, fileFloatSize ) ) ) return false;
+    if( numBytes == 0 ) return true;
+    if( fileFloatSize == sizeof(Float) ) return writeBytes( data, numBytes );
+
+    //The values are converted one at a time if the file uses a different Float size
+    for(UINT i=0; i<size; i++){
+        if( !writeFloat( data[i] ) ) return false;
+    }
+    return true;
+}
+
+std::fstream& BinaryModelWriter::beginText(){
+
+    if( textFileBuffer != NULL ){
+        errorLog << "beginText() - The previous text has not been ended!" << std::endl;
+        return textFile;
+    }
+
+    //The text stream is opened on the null device so the text save functions see an open file, but the text is written to the string buffer
+    textBuffer.str( "" );
+    textFile.clear();
+    textFile.open( GRT_NULL_DEVICE, std::ios::out );
+    if( !textFile.is_open() ){
+        errorLog << "beginText() - Failed to open the text stream!" << std::endl;
+        return textFile;
+    }
+    textFileBuffer = static_cast< std::ios& >( textFile ).rdbuf( &textBuffer );
+
+    //Write the values with enough digits that they are loaded back exactly, unlike the default text precision
+    textFile.precision( std::numeric_limits< Float >::digits10 + 3 );
+
+    return textFile;
+}
+
+bool BinaryModelWriter::endText(){
+
+    if( textFileBuffer == NULL ){
+        errorLog << "endText() - The text has not been started!" << std::endl;
+        return false;
+    }
+
+    static_cast< std::ios& >( textFile ).rdbuf( textFileBuffer );
+    textFileBuffer = NULL;
+    textFile.close();
+
+    return writeString( textBuffer.str() );
+}
+
+bool BinaryModelWriter::writeBytes(const void *data,const unsigned long long numBytes){
+
+    if( !file.is_open() ){
+        errorLog << "writeBytes(...) - The file is not open!" << std::endl;
+        return false;
+    }
+
+    file.write( reinterpret_cast< const char* >( data ), numBytes );
+    position += numBytes;
+
+    if( !file.good() ){
+        errorLog << "writeBytes(...) - Failed to write to file!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelWriter::writePadding(const unsigned long long alignment){
+    static const char zeros[ BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT ] = {0};
+    const unsigned long long remainder = position % alignment;
+    if( remainder == 0 ) return true;
+    return writeBytes( zeros, alignment - remainder );
+}
+
+/////////////////////////////// BinaryModelReader ///////////////////////////////
+
+BinaryModelReader::BinaryModelReader() : errorLog("[ERROR BinaryModelReader]"){
+    data = NULL;
+    dataSize = 0;
+    position = 0;
+    memoryMapped = false;
+    byteSwapped = false;
+    fileFloatSize = sizeof(Float);
+    textFileBuffer = NULL;
+}
+
+BinaryModelReader::~BinaryModelReader(){
+    if( textFileBuffer != NULL ){
+        static_cast< std::ios& >( textFile ).rdbuf( textFileBuffer );
+        textFileBuffer = NULL;
+    }
+    close();
+}
+
+bool BinaryModelReader::open(const std::string &filename,const bool useMemoryMap){
+
+    close();
+
+#ifdef GRT_BINARY_MODEL_FILE_USE_MMAP
+    if( useMemoryMap ){
+        int fd = ::open( filename.c_str(), O_RDONLY );
+        if( fd < 0 ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - Failed to open file: " << filename << std::endl;
+            return false;
+        }
+        struct stat fileInfo;
+        if( fstat( fd, &fileInfo ) != 0 || fileInfo.st_size <= 0 ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - Failed to get the size of file: " << filename << std::endl;
+            ::close( fd );
+            return false;
+        }
+        void *mappedData = mmap( NULL, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        if( mappedData == MAP_FAILED ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - Failed to memory map file: " << filename << std::endl;
+            return false;
+        }
+        data = static_cast< const char* >( mappedData );
+        dataSize = (unsigned long long)fileInfo.st_size;
+        memoryMapped = true;
+    }
+#endif
+
+    if( !memoryMapped ){
+        std::fstream file;
+        file.open( filename.c_str(), std::ios::in | std::ios::binary );
+        if( !file.is_open() ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - Failed to open file: " << filename << std::endl;
+            return false;
+        }
+        file.seekg( 0, std::ios::end );
+        const std::streamoff fileSize = file.tellg();
+        file.seekg( 0, std::ios::beg );
+        if( fileSize <= 0 ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - The file is empty: " << filename << std::endl;
+            return false;
+        }
+        //Offset the data in the buffer so it has the same alignment as a mapped file, otherwise the float blocks could not be used in place
+        buffer.resize( (size_t)(fileSize + BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT) );
+        const size_t offset = ((size_t)BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT - ((size_t)&buffer[0] % BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT)) % BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT;
+        file.read( &buffer[offset], fileSize );
+        if( !file.good() ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - Failed to read file: " << filename << std::endl;
+            buffer.clear();
+            return false;
+        }
+        data = &buffer[offset];
+        dataSize = (unsigned long long)fileSize;
+    }
+
+    //Check the file header
+    char magic[ sizeof(BINARY_MODEL_FILE_MAGIC) ];
+    uint32_t endianTag = 0;
+    uint32_t version = 0;
+    uint32_t floatSize = 0;
+    uint32_t largeBlockAlignment = 0;
+    if( dataSize < BINARY_MODEL_FILE_HEADER_SIZE || !readBytes( magic, sizeof(magic) ) || memcmp( magic, BINARY_MODEL_FILE_MAGIC, sizeof(magic) ) != 0 ){
+        errorLog << "open(const std::string &filename,const bool useMemoryMap) - The file is not a GRT binary model file: " << filename << std::endl;
+        close();
+        return false;
+    }
+
+    readBytes( &endianTag, sizeof(uint32_t) );
+    if( endianTag != BINARY_MODEL_FILE_ENDIAN_TAG ){
+        swapBytes( &endianTag, sizeof(uint32_t) );
+        if( endianTag != BINARY_MODEL_FILE_ENDIAN_TAG ){
+            errorLog << "open(const std::string &filename,const bool useMemoryMap) - Unknown endian tag in file: " << filename << std::endl;
+            close();
+            return false;
+        }
+        byteSwapped = true;
+    }
+
+    readBytes( &version, sizeof(uint32_t) );
+    readBytes( &floatSize, sizeof(uint32_t) );
+    readBytes( &largeBlockAlignment, sizeof(uint32_t) );
+    if( byteSwapped ){
+        swapBytes( &version, sizeof(uint32_t) );
+        swapBytes( &floatSize, sizeof(uint32_t) );
+        swapBytes( &largeBlockAlignment, sizeof(uint32_t) );
+    }
+
+    if( version > BINARY_MODEL_FILE_VERSION ){
+        errorLog << "open(const std::string &filename,const bool useMemoryMap) - The file version (" << version << ") is newer than the supported version (" << BINARY_MODEL_FILE_VERSION << ")!" << std::endl;
+        close();
+        return false;
+    }
+
+    if( (floatSize != sizeof(float) && floatSize != sizeof(double)) || largeBlockAlignment != BINARY_MODEL_FILE_LARGE_BLOCK_ALIGNMENT ){
+        errorLog << "open(const std::string &filename,const bool useMemoryMap) - Unsupported Float size or block alignment in file: " << filename << std::endl;
+        close();
+        return false;
+    }
+    fileFloatSize = floatSize;
+    position = BINARY_MODEL_FILE_HEADER_SIZE;
+
+    return true;
+}
+
+bool BinaryModelReader::close(){
+
+#ifdef GRT_BINARY_MODEL_FILE_USE_MMAP
+    if( memoryMapped && data != NULL ){
+        munmap( const_cast< char* >( data ), (size_t)dataSize );
+    }
+#endif
+
+    data = NULL;
+    dataSize = 0;
+    position = 0;
+    memoryMapped = false;
+    byteSwapped = false;
+    fileFloatSize = sizeof(Float);
+    buffer.clear();
+    sectionStack.clear();
+
+    return true;
+}
+
+bool BinaryModelReader::getIsOpen() const{
+    return data != NULL;
+}
+
+bool BinaryModelReader::getIsMemoryMapped() const{
+    return memoryMapped;
+}
+
+bool BinaryModelReader::getIsByteSwapped() const{
+    return byteSwapped;
+}
+
+bool BinaryModelReader::beginSection(const std::string &name){
+
+    uint32_t tag = 0;
+    if( !readBytes( &tag, sizeof(uint32_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &tag, sizeof(uint32_t) );
+    if( tag != BINARY_MODEL_FILE_SECTION_TAG ){
+        errorLog << "beginSection(const std::string &name) - Failed to find the section header for section: " << name << std::endl;
+        return false;
+    }
+
+    std::string sectionName;
+    if( !readString( sectionName ) ) return false;
+    if( sectionName != name ){
+        errorLog << "beginSection(const std::string &name) - Expected section " << name << " but found section " << sectionName << std::endl;
+        return false;
+    }
+
+    uint64_t sectionSize = 0;
+    if( !readBytes( &sectionSize, sizeof(uint64_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &sectionSize, sizeof(uint64_t) );
+    if( sectionSize > dataSize - position ){
+        errorLog << "beginSection(const std::string &name) - The size of section " << name << " is larger than the file!" << std::endl;
+        return false;
+    }
+
+    sectionStack.push_back( position + sectionSize );
+
+    return true;
+}
+
+bool BinaryModelReader::endSection(){
+
+    if( sectionStack.getSize() == 0 ){
+        errorLog << "endSection() - There is no section to end!" << std::endl;
+        return false;
+    }
+
+    const unsigned long long sectionEnd = sectionStack.back();
+    sectionStack.pop_back();
+
+    if( position > sectionEnd ){
+        errorLog << "endSection() - Read past the end of the section!" << std::endl;
+        return false;
+    }
+
+    //Skip any data in the section that was not read
+    position = sectionEnd;
+
+    return true;
+}
+
+bool BinaryModelReader::readUInt(UINT &value){
+    uint32_t v = 0;
+    if( !readBytes( &v, sizeof(uint32_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &v, sizeof(uint32_t) );
+    value = v;
+    return true;
+}
+
+bool BinaryModelReader::readInt(int &value){
+    int32_t v = 0;
+    if( !readBytes( &v, sizeof(int32_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &v, sizeof(int32_t) );
+    value = v;
+    return true;
+}
+
+bool BinaryModelReader::readBool(bool &value){
+    uint8_t v = 0;
+    if( !readBytes( &v, sizeof(uint8_t) ) ) return false;
+    value = v != 0;
+    return true;
+}
+
+bool BinaryModelReader::readFloat(Float &value){
+    if( fileFloatSize == sizeof(double) ){
+        double v = 0;
+        if( !readBytes( &v, sizeof(double) ) ) return false;
+        if( byteSwapped ) swapBytes( &v, sizeof(double) );
+        value = (Float)v;
+    }else{
+        float v = 0;
+        if( !readBytes( &v, sizeof(float) ) ) return false;
+        if( byteSwapped ) swapBytes( &v, sizeof(float) );
+        value = (Float)v;
+    }
+    return true;
+}
+
+bool BinaryModelReader::readString(std::string &value){
+    uint32_t length = 0;
+    if( !readBytes( &length, sizeof(uint32_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &length, sizeof(uint32_t) );
+    if( length > dataSize - position ){
+        errorLog << "readString(std::string &value) - The length of the string is larger than the file!" << std::endl;
+        return false;
+    }
+    value.assign( data + position, length );
+    position += length;
+    return true;
+}
+
+bool BinaryModelReader::readVector(VectorFloat &values){
+
+    const unsigned long long startPosition = position;
+    unsigned long long size = 0;
+    unsigned long long numBytes = 0;
+    if( !readBlockHeader( size, numBytes ) ) return false;
+
+    position = startPosition;
+    if( !values.resize( (UINT)size ) ) return false;
+    return readFloatBlock( size > 0 ? &values[0] : NULL, (UINT)size );
+}
+
+bool BinaryModelReader::readVector(Vector< UINT > &values){
+
+    uint64_t size = 0;
+    if( !readBytes( &size, sizeof(uint64_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &size, sizeof(uint64_t) );
+    if( size > (dataSize - position) / sizeof(uint32_t) ){
+        errorLog << "readVector(Vector< UINT > &values) - The size of the vector is larger than the file!" << std::endl;
+        return false;
+    }
+
+    values.resize( (UINT)size );
+    for(UINT i=0; i<values.getSize(); i++){
+        if( !readUInt( values[i] ) ) return false;
+    }
+    return true;
+}
+
+bool BinaryModelReader::readVector(Vector< MinMax > &values){
+
+    uint64_t size = 0;
+    if( !readBytes( &size, sizeof(uint64_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &size, sizeof(uint64_t) );
+    if( size > (dataSize - position) / (2*fileFloatSize) ){
+        errorLog << "readVector(Vector< MinMax > &values) - The size of the vector is larger than the file!" << std::endl;
+        return false;
+    }
+
+    values.resize( (UINT)size );
+    for(UINT i=0; i<values.getSize(); i++){
+        if( !readFloat( values[i].minValue ) || !readFloat( values[i].maxValue ) ) return false;
+    }
+    return true;
+}
+
+bool BinaryModelReader::readMatrix(MatrixFloat &values){
+
+    UINT rows = 0;
+    UINT cols = 0;
+    if( !readUInt( rows ) || !readUInt( cols ) ) return false;
+
+    if( rows == 0 || cols == 0 ){
+        values.clear();
+        return readFloatBlock( NULL, 0 );
+    }
+
+    //Check the matrix fits in the rest of the file before allocating it, so a corrupt header can not trigger a huge allocation
+    const unsigned long long numValues = (unsigned long long)rows * (unsigned long long)cols;
+    if( numValues > (dataSize - position) / fileFloatSize ){
+        errorLog << "readMatrix(MatrixFloat &values) - The size of the matrix is larger than the file!" << std::endl;
+        return false;
+    }
+
+    if( !values.resize( rows, cols ) ) return false;
+    return readFloatBlock( values.getData(), rows*cols );
+}
+
+bool BinaryModelReader::readFloatBlock(Float *values,const UINT size){
+
+    unsigned long long numValues = 0;
+    unsigned long long numBytes = 0;
+    if( !readBlockHeader( numValues, numBytes ) ) return false;
+
+    if( numValues != size ){
+        errorLog << "readFloatBlock(Float *data,const UINT size) - Expected " << size << " values but the block contains " << numValues << " values!" << std::endl;
+        return false;
+    }
+
+    //If the block was written with the same Float type and byte order then the values can be copied directly
+    if( fileFloatSize == sizeof(Float) && !byteSwapped ){
+        if( numBytes > 0 ) memcpy( values, data + position, numBytes );
+        position += numBytes;
+        return true;
+    }
+
+    for(UINT i=0; i<size; i++){
+        if( !readFloat( values[i] ) ) return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelReader::mapFloatBlock(const Float *&values,UINT &size){
+
+    if( fileFloatSize != sizeof(Float) || byteSwapped ){
+        return false;
+    }
+
+    const unsigned long long startPosition = position;
+    unsigned long long numValues = 0;
+    unsigned long long numBytes = 0;
+    if( !readBlockHeader( numValues, numBytes ) ){
+        position = startPosition;
+        return false;
+    }
+
+    values = reinterpret_cast< const Float* >( data + position );
+    size = (UINT)numValues;
+    position += numBytes;
+
+    return true;
+}
+
+std::fstream& BinaryModelReader::beginText(){
+
+    if( textFileBuffer != NULL ){
+        errorLog << "beginText() - The previous text has not been ended!" << std::endl;
+        return textFile;
+    }
+
+    std::string text;
+    textFile.clear();
+    if( !readString( text ) ) return textFile;
+
+    //The text stream is opened on the null device so the text load functions see an open file, but the text is read from the string buffer
+    textBuffer.str( text );
+    textFile.open( GRT_NULL_DEVICE, std::ios::in );
+    if( !textFile.is_open() ){
+        errorLog << "beginText() - Failed to open the text stream!" << std::endl;
+        return textFile;
+    }
+    textFileBuffer = static_cast< std::ios& >( textFile ).rdbuf( &textBuffer );
+
+    return textFile;
+}
+
+bool BinaryModelReader::endText(){
+
+    if( textFileBuffer == NULL ){
+        errorLog << "endText() - The text has not been started!" << std::endl;
+        return false;
+    }
+
+    static_cast< std::ios& >( textFile ).rdbuf( textFileBuffer );
+    textFileBuffer = NULL;
+    textFile.close();
+    textBuffer.str( "" );
+
+    return true;
+}
+
+bool BinaryModelReader::isBinaryModelFile(const std::string &filename){
+
+    std::fstream file;
+    file.open( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ) return false;
+
+    char magic[ sizeof(BINARY_MODEL_FILE_MAGIC) ];
+    file.read( magic, sizeof(magic) );
+    if( !file.good() ) return false;
+
+    return memcmp( magic, BINARY_MODEL_FILE_MAGIC, sizeof(magic) ) == 0;
+}
+
+bool BinaryModelReader::readBytes(void *values,const unsigned long long numBytes){
+
+    if( data == NULL ){
+        errorLog << "readBytes(...) - The file is not open!" << std::endl;
+        return false;
+    }
+
+    if( numBytes > dataSize - position ){
+        errorLog << "readBytes(...) - Tried to read past the end of the file!" << std::endl;
+        return false;
+    }
+
+    memcpy( values, data + position, numBytes );
+    position += numBytes;
+
+    return true;
+}
+
+bool BinaryModelReader::readBlockHeader(unsigned long long &size,unsigned long long &numBytes){
+
+    uint64_t numValues = 0;
+    if( !readBytes( &numValues, sizeof(uint64_t) ) ) return false;
+    if( byteSwapped ) swapBytes( &numValues, sizeof(uint64_t) );
+
+    if( numValues > dataSize / fileFloatSize ){
+        errorLog << "readBlockHeader(...) - The size of the block is larger than the file!" << std::endl;
+        return false;
+    }
+
+    size = numValues;
+    numBytes = numValues * fileFloatSize;
+    if( !skipPadding( getBlockAlignment( numBytes, fileFloatSize ) ) ) return false;
+
+    if( numBytes > dataSize - position ){
+        errorLog << "readBlockHeader(...) - The size of the block is larger than the file!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryModelReader::skipPadding(const unsigned long long alignment){
+    const unsigned long long remainder = position % alignment;
+    if( remainder == 0 ) return true;
+    if( alignment - remainder > dataSize - position ){
+        errorLog << "skipPadding(...) - Tried to read past the end of the file!" << std::endl;
+        return false;
+    }
+    position += alignment - remainder;
+    return true;
+}
+
+void BinaryModelReader::swapBytes(void *values,const unsigned int numBytes) const{
+    char *bytes = static_cast< char* >( values );
+    for(unsigned int i=0; i<numBytes/2; i++){
+        std::swap( bytes[i], bytes[numBytes-i-1] );
+    }
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,289 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This file contains the BinaryModelWriter and BinaryModelReader classes, which write and read the GRT binary model file format.
+
+ A binary model file starts with a fixed size header that contains a magic string, an endianness tag, the format version and the size of the
+ Float type the file was written with. This is followed by a list of named sections, one for each module, which can be nested. Each section
+ stores the size of its contents, so a reader can skip any data in a section it does not need.
+
+ Large Float arrays are written as raw blocks, aligned to a 64 byte boundary relative to the start of the file. When the reader memory maps
+ the file, these blocks can be accessed directly in the mapped file without copying or parsing them.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_BINARY_MODEL_FILE_HEADER
+#define GRT_BINARY_MODEL_FILE_HEADER
+
+#include "ErrorLog.h"
+#include "MinMax.h"
+#include "../DataStructures/VectorFloat.h"
+#include "../DataStructures/MatrixFloat.h"
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API BinaryModelWriter{
+public:
+    /**
+     Default Constructor.
+     */
+    BinaryModelWriter();
+
+    /**
+     Default Destructor, closes the file if it is still open.
+     */
+    ~BinaryModelWriter();
+
+    /**
+     Creates a new binary model file and writes the file header. Any existing file with the same name will be overwritten.
+
+     By default the Float values are written with the size of the GRT Float type. The floatSize can be set to write the values as
+     float (4) or double (8) instead, for example to write a file from a single precision (GRT_USE_FLOAT32) build that can be memory
+     mapped by a double precision build. Files with either size can be read by both builds.
+
+     @param filename: the name of the file that should be created
+     @param floatSize: the size, in bytes, of the Float values in the file, this must be 4 or 8
+     @return returns true if the file was created, false otherwise
+     */
+    bool open(const std::string &filename,const UINT floatSize = sizeof(Float));
+
+    /**
+     Closes the file. This will fail if any section has not been ended.
+
+     @return returns true if the file was closed successfully, false otherwise
+     */
+    bool close();
+
+    /**
+     Gets if the file is open.
+
+     @return returns true if the file is open, false otherwise
+     */
+    bool getIsOpen() const;
+
+    /**
+     Starts a new section in the file. Sections can be nested, and each section must be ended by calling endSection().
+
+     @param name: the name of the section, the reader must use the same name to begin the section
+     @return returns true if the section was started, false otherwise
+     */
+    bool beginSection(const std::string &name);
+
+    /**
+     Ends the current section, writing its size into the section header.
+
+     @return returns true if the section was ended, false otherwise
+     */
+    bool endSection();
+
+    bool writeUInt(const UINT value);
+    bool writeInt(const int value);
+    bool writeBool(const bool value);
+    bool writeFloat(const Float value);
+    bool writeString(const std::string &value);
+    bool writeVector(const VectorFloat &data);
+    bool writeVector(const Vector< UINT > &data);
+    bool writeVector(const Vector< MinMax > &data);
+    bool writeMatrix(const MatrixFloat &data);
+
+    /**
+     Writes a raw block of Float values to the file. Blocks of 256 bytes or more are aligned to a 64 byte boundary, so they can be
+     used directly from a memory mapped file.
+
+     @param data: a pointer to the values that should be written
+     @param size: the number of values that should be written
+     @return returns true if the block was written, false otherwise
+     */
+    bool writeFloatBlock(const Float *data,const UINT size);
+
+    /**
+     Returns a stream that can be passed to a module's text save(std::fstream &file) function. The text is stored in the binary file
+     as a single string when endText() is called. This lets modules that do not have a binary format be stored in a binary file.
+
+     @return returns a reference to the text stream
+     */
+    std::fstream& beginText();
+
+    /**
+     Writes any text that was written to the stream returned by beginText() to the file.
+
+     @return returns true if the text was written, false otherwise
+     */
+    bool endText();
+
+protected:
+    bool writeBytes(const void *data,const unsigned long long numBytes);
+    bool writePadding(const unsigned long long alignment);
+
+    std::fstream file;
+    unsigned long long position;
+    unsigned int fileFloatSize;
+    Vector< unsigned long long > sectionStack;
+    std::fstream textFile;
+    std::stringbuf textBuffer;
+    std::streambuf *textFileBuffer;
+    ErrorLog errorLog;
+};
+
+class GRT_API BinaryModelReader{
+public:
+    /**
+     Default Constructor.
+     */
+    BinaryModelReader();
+
+    /**
+     Default Destructor, closes the file if it is still open.
+     */
+    ~BinaryModelReader();
+
+    /**
+     Opens a binary model file and checks the file header. If useMemoryMap is true (and memory mapping is supported on the current
+     platform) the file will be mapped into memory, otherwise the file will be read into a buffer.
+
+     @param filename: the name of the file that should be opened
+     @param useMemoryMap: if true, the file will be memory mapped. Default value = true
+     @return returns true if the file was opened, false otherwise
+     */
+    bool open(const std::string &filename,const bool useMemoryMap = true);
+
+    /**
+     Closes the file, any pointers returned by mapFloatBlock will no longer be valid after this is called.
+
+     @return returns true if the file was closed
+     */
+    bool close();
+
+    /**
+     Gets if the file is open.
+
+     @return returns true if the file is open, false otherwise
+     */
+    bool getIsOpen() const;
+
+    /**
+     Gets if the file is memory mapped.
+
+     @return returns true if the file is memory mapped, false otherwise
+     */
+    bool getIsMemoryMapped() const;
+
+    /**
+     Gets if the file was written on a machine with a different byte order, in which case the values are byte swapped as they are read.
+
+     @return returns true if the values need to be byte swapped, false otherwise
+     */
+    bool getIsByteSwapped() const;
+
+    /**
+     Starts reading the next section in the file, the section must have the same name as the section written by the writer.
+
+     @param name: the expected name of the section
+     @return returns true if the section was found, false otherwise
+     */
+    bool beginSection(const std::string &name);
+
+    /**
+     Ends the current section, moving to the end of the section even if some of its contents were not read.
+
+     @return returns true if the section was ended, false otherwise
+     */
+    bool endSection();
+
+    bool readUInt(UINT &value);
+    bool readInt(int &value);
+    bool readBool(bool &value);
+    bool readFloat(Float &value);
+    bool readString(std::string &value);
+    bool readVector(VectorFloat &values);
+    bool readVector(Vector< UINT > &values);
+    bool readVector(Vector< MinMax > &values);
+    bool readMatrix(MatrixFloat &values);
+
+    /**
+     Reads a raw block of Float values, copying them into the data buffer.
+
+     @param values: the buffer the values will be copied to, this must have space for size values
+     @param size: the expected number of values in the block
+     @return returns true if the block was read, false otherwise
+     */
+    bool readFloatBlock(Float *values,const UINT size);
+
+    /**
+     Gets a pointer to the next raw block of Float values in the file, without copying the values. The pointer is valid until the file
+     is closed. This is only possible if the block was written with the same Float type and byte order as the current machine, if not
+     this function returns false without moving to the next value, and readFloatBlock should be used instead.
+
+     @param values: a reference to the pointer that will be set to the start of the block
+     @param size: a reference that will be set to the number of values in the block
+     @return returns true if the block was mapped, false otherwise
+     */
+    bool mapFloatBlock(const Float *&values,UINT &size);
+
+    /**
+     Returns a stream that can be passed to a module's text load(std::fstream &file) function, containing the text that was stored
+     by the writer's beginText() and endText() functions.
+
+     @return returns a reference to the text stream
+     */
+    std::fstream& beginText();
+
+    /**
+     Closes the stream returned by beginText().
+
+     @return returns true if the text stream was closed, false otherwise
+     */
+    bool endText();
+
+    /**
+     Checks if a file starts with the binary model file header. This can be used to decide if a file should be loaded as a binary or text file.
+
+     @param filename: the name of the file that should be checked
+     @return returns true if the file is a binary model file, false otherwise
+     */
+    static bool isBinaryModelFile(const std::string &filename);
+
+protected:
+    bool readBytes(void *values,const unsigned long long numBytes);
+    bool readBlockHeader(unsigned long long &size,unsigned long long &numBytes);
+    bool skipPadding(const unsigned long long alignment);
+    void swapBytes(void *values,const unsigned int numBytes) const;
+
+    const char *data;
+    unsigned long long dataSize;
+    unsigned long long position;
+    bool memoryMapped;
+    bool byteSwapped;
+    unsigned int fileFloatSize;
+    std::vector< char > buffer;
+    Vector< unsigned long long > sectionStack;
+    std::fstream textFile;
+    std::stringbuf textBuffer;
+    std::streambuf *textFileBuffer;
+    ErrorLog errorLog;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_BINARY_MODEL_FILE_HEADER
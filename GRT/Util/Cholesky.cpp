@@ -23,6 +23,7 @@
 
 #define GRT_DLL_EXPORTS
 #include "Cholesky.h"
+#include "Lapack.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -43,25 +44,47 @@ Cholesky::Cholesky(MatrixFloat &a) : N(a.getNumRows()), el(a) {
     
 	int i,j,k; //k has to an int (rather than a UINT)
  	VectorFloat tmp;
-	Float sum = 0;
+	AccumFloat sum = 0; //The dot products are accumulated in double precision, even if Float is single precision
 	if( el.getNumCols() != N ){
         errorLog << "The input matrix is not square!" << std::endl;
 		return;
 	}
 
 	const int n = int(N);
+#ifdef GRT_USE_LAPACK
+	//The row-major matrix is its own column-major view, so LAPACK's upper factor U lands in the lower triangle as L = U'
+	int info = 0;
+#ifdef GRT_USE_FLOAT32
+	//Factorise a double precision copy of the matrix, so the factor has the same accuracy as the native code
+	std::vector< double > a( el.getData(), el.getData() + N*N );
+	if( n > 0 ) dpotrf_("U",&n,&a[0],&n,&info);
+	for(i=0; i<n*n; i++) el.getData()[i] = Float( a[i] );
+#else
+	if( n > 0 ) grt_lapack_potrf("U",&n,el.getData(),&n,&info);
+#endif
+	if( info != 0 ){
+		errorLog << "Sum is <=0.0" << std::endl;
+		return;
+	}
+#else
+	Float *rowI = NULL;
+	Float *rowJ = NULL;
 	for (i=0;i<n;i++) {
+		rowI = el[i];
 		for (j=i;j<n;j++) {
-			for (sum=el[i][j],k=i-1;k>=0;k--) sum -= el[i][k]*el[j][k];
+			//Rows i and j of the factor are contiguous, so run the dot product forwards along them
+			rowJ = el[j];
+			for (sum=rowI[j],k=0;k<i;k++) sum -= AccumFloat(rowI[k])*rowJ[k];
 			if (i == j) {
 				if (sum <= 0.0){
 					errorLog << "Sum is <=0.0" << std::endl;
                     return;
 				}
-				el[i][i]=sqrt(sum);
-			}else el[j][i]=sum/el[i][i];
+				el[i][i]=Float( sqrt(sum) );
+			}else el[j][i]=Float( sum/el[i][i] );
 		}
 	}
+#endif
 	for(i=0; i<n; i++) 
 		for (j=0; j<i; j++) 
 			el[j][i] = 0.;
@@ -72,19 +95,19 @@ Cholesky::Cholesky(MatrixFloat &a) : N(a.getNumRows()), el(a) {
 bool Cholesky::solve(VectorFloat &b,VectorFloat &x) {
 	int i,k;
 	const int n = int(N);
-	Float sum;
+	AccumFloat sum;
 	
 	if (b.size() != N || x.size() != N){
 		errorLog << ":solve(vector<Float> &b, vector<Float> &x) - The input vectors are not the same size!" << std::endl;
 		return false;
 	}
 	for(i=0; i<n; i++) {
-		for(sum=b[i],k=i-1;k>=0;k--) sum -= el[i][k]*x[k];
-		x[i]=sum/el[i][i];
+		for(sum=b[i],k=i-1;k>=0;k--) sum -= AccumFloat(el[i][k])*x[k];
+		x[i]=Float( sum/el[i][i] );
 	}
 	for (i=n-1; i>=0; i--) {
-		for (sum=x[i],k=i+1;k<n;k++) sum -= el[k][i]*x[k];
-		x[i]=sum/el[i][i];
+		for (sum=x[i],k=i+1;k<n;k++) sum -= AccumFloat(el[k][i])*x[k];
+		x[i]=Float( sum/el[i][i] );
 	}		
     return true;
 }
@@ -104,15 +127,15 @@ bool Cholesky::elmult(VectorFloat &y,VectorFloat &b){
 
 bool Cholesky::elsolve(VectorFloat &b,VectorFloat &y){
 	UINT i,j;
-	Float sum = 0;
+	AccumFloat sum = 0;
 	
 	if (b.size() != N || y.size() != N){
 		errorLog << "elsolve(vector<Float> &b vector<Float> &y) - The input vectors are not the same size!" << std::endl;
 		return false;
 	}
 	for (i=0; i<N; i++) {
-		for (sum=b[i],j=0; j<i; j++) sum -= el[i][j]*y[j];
-		y[i] = sum/el[i][i];
+		for (sum=b[i],j=0; j<i; j++) sum -= AccumFloat(el[i][j])*y[j];
+		y[i] = Float( sum/el[i][i] );
 	}
     return true;
 }
@@ -120,26 +143,26 @@ bool Cholesky::elsolve(VectorFloat &b,VectorFloat &y){
 bool Cholesky::inverse(MatrixFloat &ainv){
 	int i,j,k;
 	const int n = int(N);
-	Float sum = 0;
+	AccumFloat sum = 0;
 	ainv.resize(N,N);
 	
 	for(i=0; i<n; i++) for(j=0; j<=i; j++){
 		sum = (i==j? 1. : 0.);
-		for(k=i-1; k>=j; k--) sum -= el[i][k]*ainv[j][k];
-		ainv[j][i]= sum/el[i][i];
+		for(k=i-1; k>=j; k--) sum -= AccumFloat(el[i][k])*ainv[j][k];
+		ainv[j][i]= Float( sum/el[i][i] );
 	}
 	for(i=n-1; i>=0; i--) for(j=0; j<=i; j++){
 		sum = (i<j? 0. : ainv[j][i]);
-		for(k=i+1; k<n; k++) sum -= el[k][i]*ainv[j][k];
-		ainv[i][j] = ainv[j][i] = sum/el[i][i];
+		for(k=i+1; k<n; k++) sum -= AccumFloat(el[k][i])*ainv[j][k];
+		ainv[i][j] = ainv[j][i] = Float( sum/el[i][i] );
 	}		
     return true;
 }
 
 Float Cholesky::logdet(){
-	Float sum = 0.;
-	for(unsigned int i=0; i<N; i++) sum += log(el[i][i]);
-	return 2.*sum;
+	AccumFloat sum = 0.;
+	for(unsigned int i=0; i<N; i++) sum += log(AccumFloat(el[i][i]));
+	return Float( 2.*sum );
 }
 
 GRT_END_NAMESPACE
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace GRT{
 
-bool DebugLog::debugLoggingEnabled = true;
+Log::LoggingFlag DebugLog::debugLoggingEnabled( true );
 ObserverManager< DebugLogMessage > DebugLog::observerManager;
     
 bool DebugLog::enableLogging(bool loggingEnabled){
@@ -48,7 +48,7 @@ public:
     std::string message;
 };
 
-class DebugLog : public Log{
+class DebugLog : public LogStream< DebugLog, GRT_LOG_LEVEL_DEBUG >{
 public:
     DebugLog(std::string proceedingText = ""){ setProceedingText(proceedingText); Log::loggingEnabledPtr = &debugLoggingEnabled; }
 
@@ -57,9 +57,7 @@ public:
     DebugLog& operator=(const DebugLog &rhs){
         if( this != &rhs ){
             this->proceedingText = rhs.proceedingText;
-            this->writeProceedingText = rhs.writeProceedingText;
             this->loggingEnabledPtr = &debugLoggingEnabled;
-            this->writeProceedingTextPtr = &writeProceedingText;
         }
         return *this;
     }
@@ -81,7 +79,7 @@ protected:
     }
     
     static ObserverManager< DebugLogMessage > observerManager;
-    static bool debugLoggingEnabled;
+    static LoggingFlag debugLoggingEnabled;
 };
 
 GRT_END_NAMESPACE
@@ -17,8 +17,29 @@
 
 #define GRT_DLL_EXPORTS
 #include "EigenvalueDecomposition.h"
+#include "Lapack.h"
 
 GRT_BEGIN_NAMESPACE
+
+#ifdef GRT_USE_LAPACK
+//Symmetric decomposition using the system LAPACK. The row-major input is its own column-major view, and the
+//column-major eigenvectors come back as rows, so they are transposed to match the native layout.
+static bool lapackSymmetricDecompose(const MatrixFloat &a,MatrixFloat &eigenvectors,VectorFloat &eigenvalues){
+    const int n = (int)a.getNumRows();
+    int lwork = -1;
+    int info = 0;
+    Float workSize = 0;
+    eigenvectors = a;
+    grt_lapack_syev("V","L",&n,eigenvectors.getData(),&n,&eigenvalues[0],&workSize,&lwork,&info);
+    if( info != 0 ) return false;
+    lwork = (int)workSize;
+    VectorFloat work( lwork );
+    grt_lapack_syev("V","L",&n,eigenvectors.getData(),&n,&eigenvalues[0],&work[0],&lwork,&info);
+    if( info != 0 ) return false;
+    eigenvectors.transpose();
+    return true;
+}
+#endif
    
 EigenvalueDecomposition::EigenvalueDecomposition(){
     warningLog.setProceedingText("[WARNING EigenvalueDecomposition]");
@@ -43,6 +64,12 @@ bool EigenvalueDecomposition::decompose(const MatrixFloat &a){
     }
     
     if (issymmetric) {
+#ifdef GRT_USE_LAPACK
+        if( n > 0 && lapackSymmetricDecompose(a,eigenvectors,realEigenvalues) ){
+            std::fill(complexEigenvalues.begin(),complexEigenvalues.end(),0.0);
+            return true;
+        }
+#endif
         for(int i = 0; i < n; i++) {
             for(int j = 0; j < n; j++) {
                 eigenvectors[i][j] = a[i][j];
@@ -117,15 +144,21 @@ void EigenvalueDecomposition::tred2(){
             }
             
             // Apply similarity transformation to remaining columns.
-            for (int j = 0; j < i; j++) {
-                f = realEigenvalues[j];
-                eigenvectors[j][i] = f;
-                g = complexEigenvalues[j] + eigenvectors[j][j] * f;
-                for (int k = j+1; k <= i-1; k++) {
-                    g += eigenvectors[k][j] * realEigenvalues[k];
-                    complexEigenvalues[k] += eigenvectors[k][j] * f;
+            // The lower triangle is walked row by row so the inner loops run over contiguous memory,
+            // each element of complexEigenvalues still receives its terms in the original order
+            for (int k = 0; k < i; k++) {
+                const Float *vk = eigenvectors[k];
+                const Float dk = realEigenvalues[k];
+                eigenvectors[k][i] = dk;
+                Float sum = complexEigenvalues[k];
+                for (int j = 0; j < k; j++) {
+                    sum += vk[j] * realEigenvalues[j];
+                }
+                complexEigenvalues[k] = sum;
+                complexEigenvalues[k] += vk[k] * dk;
+                for (int j = 0; j < k; j++) {
+                    complexEigenvalues[j] += vk[j] * dk;
                 }
-                complexEigenvalues[j] = g;
             }
             f = 0.0;
             for (int j = 0; j < i; j++) {
@@ -136,12 +169,15 @@ void EigenvalueDecomposition::tred2(){
             for (int j = 0; j < i; j++) {
                 complexEigenvalues[j] -= hh * realEigenvalues[j];
             }
-            for (int j = 0; j < i; j++) {
-                f = realEigenvalues[j];
-                g = complexEigenvalues[j];
-                for (int k = j; k <= i-1; k++) {
-                    eigenvectors[k][j] -= (f * complexEigenvalues[k] + g * realEigenvalues[k]);
+            for (int k = 0; k < i; k++) {
+                Float *vk = eigenvectors[k];
+                const Float ek = complexEigenvalues[k];
+                const Float dk = realEigenvalues[k];
+                for (int j = 0; j <= k; j++) {
+                    vk[j] -= (realEigenvalues[j] * ek + complexEigenvalues[j] * dk);
                 }
+            }
+            for (int j = 0; j < i; j++) {
                 realEigenvalues[j] = eigenvectors[i-1][j];
                 eigenvectors[i][j] = 0.0;
             }
@@ -149,7 +185,8 @@ void EigenvalueDecomposition::tred2(){
         realEigenvalues[i] = h;
     }
     
-    // Accumulate transformations.
+    // Accumulate transformations, the column dot products are gathered a row at a time into g
+    VectorFloat g(n);
     for(int i = 0; i < n-1; i++) {
         eigenvectors[n-1][i] = eigenvectors[i][i];
         eigenvectors[i][i] = 1.0;
@@ -159,12 +196,20 @@ void EigenvalueDecomposition::tred2(){
                 realEigenvalues[k] = eigenvectors[k][i+1] / h;
             }
             for (int j = 0; j <= i; j++) {
-                Float g = 0.0;
-                for (int k = 0; k <= i; k++) {
-                    g += eigenvectors[k][i+1] * eigenvectors[k][j];
+                g[j] = 0.0;
+            }
+            for (int k = 0; k <= i; k++) {
+                const Float *vk = eigenvectors[k];
+                const Float vki = vk[i+1];
+                for (int j = 0; j <= i; j++) {
+                    g[j] += vki * vk[j];
                 }
-                for (int k = 0; k <= i; k++) {
-                    eigenvectors[k][j] -= g * realEigenvalues[k];
+            }
+            for (int k = 0; k <= i; k++) {
+                Float *vk = eigenvectors[k];
+                const Float dk = realEigenvalues[k];
+                for (int j = 0; j <= i; j++) {
+                    vk[j] -= g[j] * dk;
                 }
             }
         }
@@ -189,13 +234,16 @@ void EigenvalueDecomposition::tql2(){
     }
     complexEigenvalues[n-1] = 0.0;
     
+    // The QL iterations rotate pairs of eigenvector columns, so work on the transpose where each column is a contiguous row
+    transposeEigenvectors();
+    
     Float f = 0.0;
     Float tst1 = 0.0;
-    Float eps = pow(2.0,-52.0);
+    Float eps = std::numeric_limits< Float >::epsilon();
     for (int l = 0; l < n; l++) {
         
         // Find small subdiagonal element
-        tst1 = findMax(tst1,fabs(realEigenvalues[l]) + fabs(complexEigenvalues[l]));
+        tst1 = findMax< Float >(tst1,fabs(realEigenvalues[l]) + fabs(complexEigenvalues[l]));
         int m = l;
         while (m < n) {
             if(fabs(complexEigenvalues[m]) <= eps*tst1) {
@@ -213,7 +261,7 @@ void EigenvalueDecomposition::tql2(){
                 // Compute implicit shift
                 Float g = realEigenvalues[l];
                 Float p = (realEigenvalues[l+1] - g) / (2.0 * complexEigenvalues[l]);
-                Float r = hypot(p,1.0);
+                Float r = hypot< Float >(p,1.0);
                 if (p < 0) {
                     r = -r;
                 }
@@ -248,10 +296,12 @@ void EigenvalueDecomposition::tql2(){
                     realEigenvalues[i+1] = h + s * (c * g + s * realEigenvalues[i]);
                     
                     // Accumulate transformation.
+                    Float *vi = eigenvectors[i];
+                    Float *vi1 = eigenvectors[i+1];
                     for(int k = 0; k < n; k++) {
-                        h = eigenvectors[k][i+1];
-                        eigenvectors[k][i+1] = s * eigenvectors[k][i] + c * h;
-                        eigenvectors[k][i] = c * eigenvectors[k][i] - s * h;
+                        h = vi1[k];
+                        vi1[k] = s * vi[k] + c * h;
+                        vi[k] = c * vi[k] - s * h;
                     }
                 }
                 p = -s * s2 * c3 * el1 * complexEigenvalues[l] / dl1;
@@ -278,13 +328,18 @@ void EigenvalueDecomposition::tql2(){
         if (k != i) {
             realEigenvalues[k] = realEigenvalues[i];
             realEigenvalues[i] = p;
+            Float *vi = eigenvectors[i];
+            Float *vk = eigenvectors[k];
             for (int j = 0; j < n; j++) {
-                p = eigenvectors[j][i];
-                eigenvectors[j][i] = eigenvectors[j][k];
-                eigenvectors[j][k] = p;
+                p = vi[j];
+                vi[j] = vk[j];
+                vk[j] = p;
             }
         }
     }
+    
+    transposeEigenvectors();
+    
     return;
 }
 
@@ -378,7 +433,7 @@ void EigenvalueDecomposition::hqr2(){
     int n = nn-1;
     int low = 0;
     int high = nn-1;
-    Float eps = pow(2.0,-52.0);
+    Float eps = std::numeric_limits< Float >::epsilon();
     Float exshift = 0.0;
     Float p=0,q=0,r=0,s=0,z=0,t,w,x,y;
     
@@ -742,7 +797,7 @@ void EigenvalueDecomposition::hqr2(){
                     }
                     
                     // Overflow control
-                    t = findMax(fabs(h[i][n-1]),fabs(h[i][n]));
+                    t = findMax< Float >(fabs(h[i][n-1]),fabs(h[i][n]));
                     if ((eps * t) * t > 1) {
                         for(int j = i; j <= n; j++) {
                             h[j][n-1] = h[j][n-1] / t;
@@ -777,6 +832,16 @@ void EigenvalueDecomposition::hqr2(){
     return;
 }
     
+void EigenvalueDecomposition::transposeEigenvectors(){
+    for(int i = 0; i < n; i++) {
+        for(int j = i+1; j < n; j++) {
+            Float tmp = eigenvectors[i][j];
+            eigenvectors[i][j] = eigenvectors[j][i];
+            eigenvectors[j][i] = tmp;
+        }
+    }
+}
+
 void EigenvalueDecomposition::cdiv(Float xr, Float xi, Float yr, Float yi){
     Float r,d;
     if(fabs(yr) > fabs(yi)){
@@ -99,6 +99,11 @@ protected:
      */
     void hqr2();
     
+    /**
+      Transposes the eigenvector matrix in place.
+     */
+    void transposeEigenvectors();
+    
     /**
       Complex scalar division.
      */
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 GRT_BEGIN_NAMESPACE
 
-bool ErrorLog::errorLoggingEnabled = true;
+Log::LoggingFlag ErrorLog::errorLoggingEnabled( true );
 ObserverManager< ErrorLogMessage > ErrorLog::observerManager;
     
 bool ErrorLog::enableLogging(bool loggingEnabled){
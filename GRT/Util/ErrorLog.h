@@ -48,7 +48,7 @@ public:
     std::string message;
 };
     
-class GRT_API ErrorLog : public Log {
+class GRT_API ErrorLog : public LogStream< ErrorLog, GRT_LOG_LEVEL_ERROR >{
 public:
     ErrorLog(std::string proceedingText = ""){
         setProceedingText(proceedingText);
@@ -59,11 +59,8 @@ public:
     ErrorLog& operator=(const ErrorLog &rhs){
         if( this != &rhs ){
             this->proceedingText = rhs.proceedingText;
-            this->writeProceedingText = rhs.writeProceedingText;
             this->lastMessage = rhs.lastMessage;
             this->loggingEnabledPtr = &errorLoggingEnabled;
-            this->writeProceedingTextPtr = &writeProceedingText;
-            this->lastMessagePtr = &lastMessage;
         }
         return *this;
     }
@@ -85,7 +82,7 @@ protected:
     }
     
     static ObserverManager< ErrorLogMessage > observerManager;
-    static bool errorLoggingEnabled;
+    static LoggingFlag errorLoggingEnabled;
 };
 
 GRT_END_NAMESPACE
@@ -68,6 +68,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "TestInstanceResult.h"
 #include "TestResult.h"
 #include "CircularBuffer.h"
+#include "MultichannelCircularBuffer.h"
 #include "Timer.h"
 #include "TimeStamp.h"
 #include "Random.h"
@@ -33,6 +33,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <limits>
 #include <cmath>
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif //GRT_CXX11_ENABLED
+
 #ifdef __GRT_WINDOWS_BUILD__
 
 #define NOMINMAX
@@ -48,7 +52,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 GRT_BEGIN_NAMESPACE
 
 //Define any common GRT OS independent typedefs
+#ifdef GRT_USE_FLOAT32
+typedef float Float; ///<This typedef is used to set floating-point precision throughout the GRT, GRT_USE_FLOAT32 sets this to single precision
+#else
 typedef double Float; ///<This typedef is used to set floating-point precision throughout the GRT
+#endif
+typedef double AccumFloat; ///<This typedef is used for the accumulators of numerically sensitive algorithms (such as the covariance, Cholesky and HMM scaling), which are always double precision
 typedef long double LongFloat; ///<This typedef is used to set long floating-point precision throughout the GRT
 	
 //Declare any common definitions that are not OS specific
@@ -99,6 +108,11 @@ T grt_scale(const T &x,const T &minSource,const T &maxSource,const T &minTarget,
     return (((x-minSource)*(maxTarget-minTarget))/(maxSource-minSource))+minTarget;
 }
 
+//Non-template version of grt_scale, this is used when the arguments are a mix of Float and double (i.e. a literal), which happens when Float is float
+inline Float grt_scale(const Float x,const Float minSource,const Float maxSource,const Float minTarget,const Float maxTarget,const bool constrain = false){
+    return grt_scale< Float >( x, minSource, maxSource, minTarget, maxTarget, constrain );
+}
+
 template< class T >
 std::string grt_to_str( const T &value ){
     std::ostringstream s;
@@ -179,6 +193,13 @@ typedef signed int SINT;
 typedef unsigned long ULONG;
 #endif
 
+//The type used to count the instances of the module base classes, this is atomic if C++11 is enabled so modules can be created and deleted on several threads
+#ifdef GRT_CXX11_ENABLED
+typedef std::atomic< UINT > InstanceCounter;
+#else
+typedef UINT InstanceCounter;
+#endif //GRT_CXX11_ENABLED
+
 // Cross-platform deprecation warning, based on openFrameworks OF_DEPRECATED
 #ifdef __GNUC__
 // clang also has this defined. deprecated(message) is only for gcc>=4.5
@@ -23,11 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 GRT_BEGIN_NAMESPACE
 
-#ifdef GRT_CXX11_ENABLED
-std::mutex Log::logMutex;
-#endif
-
-bool InfoLog::infoLoggingEnabled = true;
+Log::LoggingFlag InfoLog::infoLoggingEnabled( true );
 ObserverManager< InfoLogMessage > InfoLog::observerManager;
     
 bool InfoLog::enableLogging(bool loggingEnabled){
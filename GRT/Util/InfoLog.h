@@ -48,7 +48,7 @@ public:
     std::string message;
 };
 
-class GRT_API InfoLog : public Log{
+class GRT_API InfoLog : public LogStream< InfoLog, GRT_LOG_LEVEL_INFO >{
 public:
     InfoLog(std::string proceedingText = ""){ setProceedingText(proceedingText); Log::loggingEnabledPtr = &infoLoggingEnabled; }
 
@@ -57,9 +57,7 @@ public:
     InfoLog& operator=(const InfoLog &rhs){
         if( this != &rhs ){
             this->proceedingText = rhs.proceedingText;
-            this->writeProceedingText = rhs.writeProceedingText;
             this->loggingEnabledPtr = &infoLoggingEnabled;
-            this->writeProceedingTextPtr = &writeProceedingText;
         }
         return *this;
     }
@@ -81,7 +79,7 @@ protected:
     }
     
     static ObserverManager< InfoLogMessage > observerManager;
-    static bool infoLoggingEnabled;
+    static LoggingFlag infoLoggingEnabled;
 };
 
 GRT_END_NAMESPACE
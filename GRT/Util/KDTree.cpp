@@ -0,0 +1,192 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define GRT_DLL_EXPORTS
+#include "KDTree.h"
+
+GRT_BEGIN_NAMESPACE
+
+KDTree::KDTree() : errorLog("[ERROR KDTree]"){
+    built = false;
+    numPoints = 0;
+    numDimensions = 0;
+    leafSize = 16;
+}
+
+KDTree::~KDTree(){
+}
+
+bool KDTree::build( const MatrixFloat &data, const UINT leafSize ){
+
+    clear();
+
+    if( data.getNumRows() == 0 || data.getNumCols() == 0 ){
+        errorLog << "build( const MatrixFloat &data, const UINT leafSize ) - The data is empty!" << std::endl;
+        return false;
+    }
+
+    if( leafSize == 0 ){
+        errorLog << "build( const MatrixFloat &data, const UINT leafSize ) - The leafSize must be greater than zero!" << std::endl;
+        return false;
+    }
+
+    this->leafSize = leafSize;
+    numPoints = data.getNumRows();
+    numDimensions = data.getNumCols();
+
+    pointIndexes.resize( numPoints );
+    for(UINT i=0; i<numPoints; i++) pointIndexes[i] = i;
+
+    //Build the tree, this reorders the pointIndexes so each node covers a contiguous range
+    nodes.reserve( 2 * (numPoints / leafSize + 1) );
+    buildNode( 0, numPoints, data );
+
+    //Copy the points into the tree order, so the leaf scans read contiguous memory
+    points.resize( numPoints, numDimensions );
+    pointLookup.resize( numPoints );
+    for(UINT i=0; i<numPoints; i++){
+        const Float *x = data[ pointIndexes[i] ];
+        std::copy( x, x + numDimensions, points[i] );
+        pointLookup[ pointIndexes[i] ] = i;
+    }
+
+    built = true;
+
+    return true;
+}
+
+bool KDTree::clear(){
+    built = false;
+    numPoints = 0;
+    numDimensions = 0;
+    points.clear();
+    pointIndexes.clear();
+    pointLookup.clear();
+    nodes.clear();
+    return true;
+}
+
+int KDTree::buildNode( const UINT begin, const UINT end, const MatrixFloat &data ){
+
+    const int nodeIndex = (int)nodes.size();
+    Node node;
+    node.begin = begin;
+    node.end = end;
+    node.splitDimension = 0;
+    node.splitValue = 0;
+    node.left = -1;
+    node.right = -1;
+    nodes.push_back( node );
+
+    if( end - begin <= leafSize ) return nodeIndex;
+
+    //Split the node along the dimension with the largest range
+    UINT splitDimension = 0;
+    Float maxRange = -1;
+    for(UINT j=0; j<numDimensions; j++){
+        Float minValue = data[ pointIndexes[begin] ][j];
+        Float maxValue = minValue;
+        for(UINT i=begin+1; i<end; i++){
+            const Float v = data[ pointIndexes[i] ][j];
+            if( v < minValue ) minValue = v;
+            else if( v > maxValue ) maxValue = v;
+        }
+        if( maxValue - minValue > maxRange ){
+            maxRange = maxValue - minValue;
+            splitDimension = j;
+        }
+    }
+
+    //If all the points are the same then there is nothing to split
+    if( maxRange <= 0 ) return nodeIndex;
+
+    //Partition the points around the median
+    const UINT mid = begin + (end - begin) / 2;
+    std::nth_element( pointIndexes.begin() + begin, pointIndexes.begin() + mid, pointIndexes.begin() + end, [&data,splitDimension](const UINT a,const UINT b){
+        return data[a][splitDimension] < data[b][splitDimension];
+    } );
+
+    const Float splitValue = data[ pointIndexes[mid] ][ splitDimension ];
+    const int left = buildNode( begin, mid, data );
+    const int right = buildNode( mid, end, data );
+
+    nodes[ nodeIndex ].splitDimension = splitDimension;
+    nodes[ nodeIndex ].splitValue = splitValue;
+    nodes[ nodeIndex ].left = left;
+    nodes[ nodeIndex ].right = right;
+
+    return nodeIndex;
+}
+
+bool KDTree::radiusSearch( const Float *query, const Float radius, Vector< UINT > &indexes, VectorFloat &squaredDistances ) const{
+
+    indexes.clear();
+    squaredDistances.clear();
+
+    if( !built ) return false;
+
+    searchNode( 0, query, radius, radius*radius, indexes, squaredDistances );
+
+    return true;
+}
+
+bool KDTree::radiusSearch( const VectorFloat &query, const Float radius, Vector< UINT > &indexes ) const{
+
+    if( query.getSize() != numDimensions ){
+        indexes.clear();
+        return false;
+    }
+
+    VectorFloat squaredDistances;
+    return radiusSearch( &query[0], radius, indexes, squaredDistances );
+}
+
+void KDTree::searchNode( const int nodeIndex, const Float *query, const Float radius, const Float radiusSquared, Vector< UINT > &indexes, VectorFloat &squaredDistances ) const{
+
+    const Node &node = nodes[ nodeIndex ];
+
+    if( node.left < 0 ){
+        for(UINT i=node.begin; i<node.end; i++){
+            const Float *x = points[i];
+            Float dist = 0;
+            for(UINT j=0; j<numDimensions; j++){
+                const Float d = x[j] - query[j];
+                dist += d*d;
+            }
+            if( dist <= radiusSquared ){
+                indexes.push_back( pointIndexes[i] );
+                squaredDistances.push_back( dist );
+            }
+        }
+        return;
+    }
+
+    //Search the side of the split containing the query first, the other side only needs to be searched if the split is within the radius
+    const Float diff = query[ node.splitDimension ] - node.splitValue;
+    if( diff < 0 ){
+        searchNode( node.left, query, radius, radiusSquared, indexes, squaredDistances );
+        if( -diff <= radius ) searchNode( node.right, query, radius, radiusSquared, indexes, squaredDistances );
+    }else{
+        searchNode( node.right, query, radius, radiusSquared, indexes, squaredDistances );
+        if( diff <= radius ) searchNode( node.left, query, radius, radiusSquared, indexes, squaredDistances );
+    }
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,131 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief This class implements a basic KD-tree, that can be used to find all the points within a radius of a query point.
+
+ The points are copied into a contiguous buffer, reordered so the points in each node of the tree are stored next to each
+ other. Each node is split at the median of the dimension with the largest range, until the number of points in a node is
+ less than or equal to the leaf size.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_KD_TREE_HEADER
+#define GRT_KD_TREE_HEADER
+
+#include "ErrorLog.h"
+#include "../DataStructures/VectorFloat.h"
+#include "../DataStructures/MatrixFloat.h"
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API KDTree{
+public:
+    /**
+     Default Constructor.
+     */
+    KDTree();
+
+    /**
+     Default Destructor.
+     */
+    ~KDTree();
+
+    /**
+     Builds the tree from the data, each row in the data is one point. Any previous tree will be cleared.
+
+     @param data: the points that will be stored in the tree
+     @param leafSize: the maximum number of points in a leaf node, must be greater than zero. Default value = 16
+     @return returns true if the tree was built, false otherwise
+     */
+    bool build( const MatrixFloat &data, const UINT leafSize = 16 );
+
+    /**
+     Clears the tree.
+
+     @return returns true if the tree was cleared
+     */
+    bool clear();
+
+    /**
+     Finds all the points whose Euclidean distance to the query is less than or equal to the radius. This function does not
+     modify the tree, so it can be called concurrently from several threads.
+
+     @param query: a pointer to the query point, this must have getNumDimensions() elements
+     @param radius: the search radius
+     @param indexes: returns the indexes (the row in the data used to build the tree) of the points within the radius
+     @param squaredDistances: returns the squared distance between the query and each point in indexes
+     @return returns true if the search was run, false otherwise
+     */
+    bool radiusSearch( const Float *query, const Float radius, Vector< UINT > &indexes, VectorFloat &squaredDistances ) const;
+
+    /**
+     Finds all the points whose Euclidean distance to the query is less than or equal to the radius.
+
+     @param query: the query point, the size of this must match getNumDimensions()
+     @param radius: the search radius
+     @param indexes: returns the indexes (the row in the data used to build the tree) of the points within the radius
+     @return returns true if the search was run, false otherwise
+     */
+    bool radiusSearch( const VectorFloat &query, const Float radius, Vector< UINT > &indexes ) const;
+
+    /**
+     Gets a pointer to the i'th point in the tree, where i is the row in the data used to build the tree.
+
+     @param index: the index of the point
+     @return returns a pointer to the point
+     */
+    const Float* getPoint( const UINT index ) const { return points[ pointLookup[index] ]; }
+
+    bool getBuilt() const { return built; }
+    UINT getNumPoints() const { return numPoints; }
+    UINT getNumDimensions() const { return numDimensions; }
+
+protected:
+    struct Node{
+        UINT begin;
+        UINT end;
+        UINT splitDimension;
+        Float splitValue;
+        int left;
+        int right;
+    };
+
+    int buildNode( const UINT begin, const UINT end, const MatrixFloat &data );
+    void searchNode( const int nodeIndex, const Float *query, const Float radius, const Float radiusSquared, Vector< UINT > &indexes, VectorFloat &squaredDistances ) const;
+
+    bool built;
+    UINT numPoints;
+    UINT numDimensions;
+    UINT leafSize;
+    MatrixFloat points;             ///< The points, reordered so each node is a contiguous range of rows
+    Vector< UINT > pointIndexes;    ///< The row in the original data of each row in points
+    Vector< UINT > pointLookup;     ///< The row in points of each row in the original data
+    Vector< Node > nodes;
+
+    ErrorLog errorLog;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_KD_TREE_HEADER
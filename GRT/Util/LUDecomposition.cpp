@@ -23,9 +23,31 @@
 
 #define GRT_DLL_EXPORTS
 #include "LUDecomposition.h"
+#include "Lapack.h"
 
 GRT_BEGIN_NAMESPACE
 
+#ifdef GRT_USE_LAPACK
+//LU decomposition using the system LAPACK. The matrix is transposed into column-major order and back, LAPACK's
+//1-based sequence of row interchanges has the same meaning as indx. Returns false for an exactly singular matrix,
+//in which case the native decomposition is used so the singular handling stays the same.
+static bool lapackDecompose(const MatrixFloat &a,MatrixFloat &lu,Vector< int > &indx,Float &d){
+	const int n = (int)a.getNumRows();
+	int info = 0;
+	lu = a;
+	lu.transpose();
+	grt_lapack_getrf(&n,&n,lu.getData(),&n,&indx[0],&info);
+	if( info != 0 ) return false;
+	lu.transpose();
+	d = 1.0;
+	for(int i=0; i<n; i++){
+		indx[i] -= 1;
+		if( indx[i] != i ) d = -d;
+	}
+	return true;
+}
+#endif
+
 LUDecomposition::LUDecomposition(const MatrixFloat &a) : sing(false){
     
     debugLog.setProceedingText("[DEBUG LUDecomposition]");
@@ -37,9 +59,16 @@ LUDecomposition::LUDecomposition(const MatrixFloat &a) : sing(false){
 	aref = a;
 	indx.resize( N );
 
+#ifdef GRT_USE_LAPACK
+	if( N > 0 && a.getNumCols() == N && lapackDecompose(a,lu,indx,d) ) return;
+	lu = a;
+#endif
+
 	const Float TINY=1.0e-20;
 	unsigned int i,imax,j,k;
 	Float big,temp;
+	Float *rowI = NULL;
+	Float *rowK = NULL;
 	VectorFloat vv(N);
 	d=1.0;
     imax = 0;
@@ -64,20 +93,24 @@ LUDecomposition::LUDecomposition(const MatrixFloat &a) : sing(false){
 			}
 		}
 		if (k != imax) {
+			rowI = lu[imax];
+			rowK = lu[k];
 			for (j=0;j<N;j++) {
-				temp=lu[imax][j];
-				lu[imax][j] = lu[k][j];
-				lu[k][j] = temp;
+				temp=rowI[j];
+				rowI[j] = rowK[j];
+				rowK[j] = temp;
 			}
 			d = -d;
 			vv[imax]=vv[k];
 		}
 		indx[k]=imax;
-		if (lu[k][k] == 0.0) lu[k][k] = TINY;
+		rowK = lu[k];
+		if (rowK[k] == 0.0) rowK[k] = TINY;
 		for (i=k+1; i<N; i++) {
-			temp = lu[i][k] /= lu[k][k];
+			rowI = lu[i];
+			temp = rowI[k] /= rowK[k];
 			for (j=k+1;j<N;j++)
-				lu[i][j] -= temp * lu[k][j];
+				rowI[j] -= temp * rowK[j];
 		}
 	}
 	
@@ -124,11 +157,40 @@ bool LUDecomposition::solve(const MatrixFloat &b,MatrixFloat &x)
         errorLog << "solve(const MatrixFloat &b,MatrixFloat &x) - the size of the two matrices does not match!" << std::endl;
 		return false;
     }
-	VectorFloat  xx(N);
-	for (unsigned int j=0; j<m; j++) {
-		for(unsigned int i=0; i<N; i++) xx[i] = b[i][j];
-		solve_vector(xx,xx);
-		for(unsigned int i=0; i<N; i++) x[i][j] = xx[i];
+	
+	//Solve for all the right-hand sides together, working on whole rows of x so the inner loops are contiguous
+	if( &x != &b ) x = b;
+	unsigned int i,j,k;
+	Float *rowI = NULL;
+	Float *rowJ = NULL;
+	Float temp = 0;
+	for (i=0; i<N; i++) {
+		k = (unsigned int)indx[i];
+		if (k != i) {
+			rowI = x[i];
+			rowJ = x[k];
+			for (j=0; j<m; j++) { temp = rowI[j]; rowI[j] = rowJ[j]; rowJ[j] = temp; }
+		}
+	}
+	for (i=0; i<N; i++) {
+		rowI = x[i];
+		for (k=0; k<i; k++) {
+			temp = lu[i][k];
+			if (temp == 0.0) continue;
+			rowJ = x[k];
+			for (j=0; j<m; j++) rowI[j] -= temp * rowJ[j];
+		}
+	}
+	for (i=N; i-- > 0; ) {
+		rowI = x[i];
+		for (k=i+1; k<N; k++) {
+			temp = lu[i][k];
+			if (temp == 0.0) continue;
+			rowJ = x[k];
+			for (j=0; j<m; j++) rowI[j] -= temp * rowJ[j];
+		}
+		temp = lu[i][i];
+		for (j=0; j<m; j++) rowI[j] /= temp;
 	}
     return true;
 }
@@ -144,9 +206,10 @@ bool LUDecomposition::inverse(MatrixFloat &ainv)
 	return solve(ainv,ainv);
 }
     
-Float LUDecomposition::det()
+AccumFloat LUDecomposition::det()
 {
-	Float dd = d;
+	//The product of the pivots quickly leaves the range of a float, so it is accumulated in double
+	AccumFloat dd = d;
 	for (unsigned int i=0;i<N;i++) dd *= lu[i][i];
 	return dd;
 }
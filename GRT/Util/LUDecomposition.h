@@ -36,7 +36,7 @@ public:
 	bool solve_vector(const VectorFloat &b,VectorFloat &x);
 	bool solve(const MatrixFloat &b,MatrixFloat &x);
 	bool inverse(MatrixFloat &ainv);
-	Float det();
+	AccumFloat det();
 	bool mprove(const VectorFloat &b,VectorFloat &x);
 	bool getIsSingular();
 	MatrixFloat getLU();
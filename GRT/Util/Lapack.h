@@ -0,0 +1,82 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @brief Declarations for the subset of the system LAPACK routines used by the GRT linear algebra classes.
+ 
+ These are only used when the GRT is built with the USE_LAPACK CMake option, which defines GRT_USE_LAPACK and links
+ the library against the system LAPACK. The grt_lapack_* and grt_blas_* macros select the single or double precision
+ routine that matches the GRT Float type. The LAPACK routines work on column-major data, so the callers are responsible
+ for transposing (or exploiting symmetry) when passing the row-major MatrixFloat buffers.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ and associated documentation files (the "Software"), to deal in the Software without restriction, 
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial 
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LAPACK_HEADER
+#define GRT_LAPACK_HEADER
+
+#ifdef GRT_USE_LAPACK
+
+extern "C" {
+
+//Symmetric eigenvalue decomposition
+void dsyev_(const char *jobz, const char *uplo, const int *n, double *a, const int *lda, double *w, double *work, const int *lwork, int *info);
+
+//Singular value decomposition
+void dgesvd_(const char *jobu, const char *jobvt, const int *m, const int *n, double *a, const int *lda, double *s, double *u, const int *ldu, double *vt, const int *ldvt, double *work, const int *lwork, int *info);
+
+//LU decomposition with partial pivoting
+void dgetrf_(const int *m, const int *n, double *a, const int *lda, int *ipiv, int *info);
+
+//Cholesky decomposition
+void dpotrf_(const char *uplo, const int *n, double *a, const int *lda, int *info);
+
+//General matrix multiplication (BLAS level 3)
+void dgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const double *alpha, const double *a, const int *lda, const double *b, const int *ldb, const double *beta, double *c, const int *ldc);
+
+//Single precision versions of the routines above, these are used when the GRT is built with GRT_USE_FLOAT32
+void ssyev_(const char *jobz, const char *uplo, const int *n, float *a, const int *lda, float *w, float *work, const int *lwork, int *info);
+void sgesvd_(const char *jobu, const char *jobvt, const int *m, const int *n, float *a, const int *lda, float *s, float *u, const int *ldu, float *vt, const int *ldvt, float *work, const int *lwork, int *info);
+void sgetrf_(const int *m, const int *n, float *a, const int *lda, int *ipiv, int *info);
+void spotrf_(const char *uplo, const int *n, float *a, const int *lda, int *info);
+void sgemm_(const char *transa, const char *transb, const int *m, const int *n, const int *k, const float *alpha, const float *a, const int *lda, const float *b, const int *ldb, const float *beta, float *c, const int *ldc);
+
+}
+
+//The routines that match the precision of the GRT Float type
+#ifdef GRT_USE_FLOAT32
+#define grt_lapack_syev ssyev_
+#define grt_lapack_gesvd sgesvd_
+#define grt_lapack_getrf sgetrf_
+#define grt_lapack_potrf spotrf_
+#define grt_blas_gemm sgemm_
+#else
+#define grt_lapack_syev dsyev_
+#define grt_lapack_gesvd dgesvd_
+#define grt_lapack_getrf dgetrf_
+#define grt_lapack_potrf dpotrf_
+#define grt_blas_gemm dgemm_
+#endif
+
+#endif //GRT_USE_LAPACK
+
+#endif //GRT_LAPACK_HEADER
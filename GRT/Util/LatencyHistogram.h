@@ -0,0 +1,218 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The LatencyHistogram class records latencies (in nanoseconds) in a fixed size, log-linear histogram (in the style of an HDR
+ histogram). Each power of two range is split into 32 linear sub buckets, so any recorded value is stored with a relative error of
+ less than about 3%, from 1 nanosecond up to several hours. Recording a value is constant time and never allocates memory, so it can
+ be used inside a real-time prediction loop.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_LATENCY_HISTOGRAM_HEADER
+#define GRT_LATENCY_HISTOGRAM_HEADER
+
+#include "GRTTypedefs.h"
+
+GRT_BEGIN_NAMESPACE
+
+class LatencyHistogram{
+public:
+    enum{ SUB_BUCKET_BITS=5, NUM_SUB_BUCKETS=(1<<SUB_BUCKET_BITS), MAX_VALUE_BITS=44, NUM_BUCKETS=NUM_SUB_BUCKETS*(MAX_VALUE_BITS-SUB_BUCKET_BITS+1) };
+
+    /**
+     Default Constructor, creates an empty histogram.
+     */
+    LatencyHistogram(){
+        reset();
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~LatencyHistogram(){}
+
+    /**
+     Clears all the values recorded by the histogram.
+
+     @return returns true if the histogram was reset
+     */
+    bool reset(){
+        for(UINT i=0; i<NUM_BUCKETS; i++) counts[i] = 0;
+        count = 0;
+        sum = 0;
+        minValue = 0;
+        maxValue = 0;
+        return true;
+    }
+
+    /**
+     Records one value. Values larger than the range of the histogram (2^44 nanoseconds) are clamped to the last bucket, the min, max
+     and mean values are always computed from the exact values.
+
+     @param value: the value you want to record, this should be in nanoseconds
+     */
+    void record(const unsigned long long value){
+        counts[ getBucketIndex( value ) ]++;
+        if( count == 0 || value < minValue ) minValue = value;
+        if( count == 0 || value > maxValue ) maxValue = value;
+        count++;
+        sum += value;
+    }
+
+    /**
+     Adds all the values recorded by another histogram to this histogram.
+
+     @param rhs: the histogram you want to merge into this histogram
+     @return returns true if the histograms were merged
+     */
+    bool merge(const LatencyHistogram &rhs){
+        if( rhs.count == 0 ) return true;
+        for(UINT i=0; i<NUM_BUCKETS; i++) counts[i] += rhs.counts[i];
+        if( count == 0 || rhs.minValue < minValue ) minValue = rhs.minValue;
+        if( count == 0 || rhs.maxValue > maxValue ) maxValue = rhs.maxValue;
+        count += rhs.count;
+        sum += rhs.sum;
+        return true;
+    }
+
+    /**
+     Gets the number of values that have been recorded.
+
+     @return returns the number of values that have been recorded
+     */
+    unsigned long long getCount() const { return count; }
+
+    /**
+     Gets the sum of all the values that have been recorded.
+
+     @return returns the sum of all the recorded values, in nanoseconds
+     */
+    unsigned long long getSum() const { return sum; }
+
+    /**
+     Gets the smallest value that has been recorded.
+
+     @return returns the smallest recorded value in nanoseconds, or 0 if no values have been recorded
+     */
+    unsigned long long getMin() const { return minValue; }
+
+    /**
+     Gets the largest value that has been recorded.
+
+     @return returns the largest recorded value in nanoseconds, or 0 if no values have been recorded
+     */
+    unsigned long long getMax() const { return maxValue; }
+
+    /**
+     Gets the mean of all the values that have been recorded.
+
+     @return returns the mean of the recorded values in nanoseconds, or 0 if no values have been recorded
+     */
+    Float getMean() const { return count > 0 ? Float( sum ) / Float( count ) : 0; }
+
+    /**
+     Gets the value at the given percentile, for example getPercentile( 99 ) returns the value that 99% of the recorded values are less
+     than or equal to. The value is the midpoint of the bucket the percentile falls in, limited to the range [min max] of the recorded values.
+
+     @param percentile: the percentile you want the value for, this should be in the range [0 100]
+     @return returns the value at the percentile in nanoseconds, or 0 if no values have been recorded
+     */
+    unsigned long long getPercentile(const Float percentile) const {
+        if( count == 0 ) return 0;
+        if( percentile <= 0 ) return minValue;
+        if( percentile >= 100 ) return maxValue;
+
+        //Find the bucket that contains the value at the percentile
+        unsigned long long target = (unsigned long long)( percentile / 100.0 * count + 0.5 );
+        if( target < 1 ) target = 1;
+        unsigned long long total = 0;
+        for(UINT i=0; i<NUM_BUCKETS; i++){
+            total += counts[i];
+            if( total >= target ){
+                const unsigned long long value = getBucketLowerBound(i) + getBucketWidth(i)/2;
+                return value < minValue ? minValue : (value > maxValue ? maxValue : value);
+            }
+        }
+        return maxValue;
+    }
+
+    /**
+     Gets the index of the bucket a value would be recorded in.
+
+     @param value: the value you want the bucket index for, in nanoseconds
+     @return returns the index of the bucket, this will be in the range [0 NUM_BUCKETS-1]
+     */
+    static UINT getBucketIndex(const unsigned long long value){
+        if( value < NUM_SUB_BUCKETS ) return (UINT)value;
+        const UINT msb = getMostSignificantBit( value );
+        if( msb >= MAX_VALUE_BITS ) return NUM_BUCKETS-1;
+        const UINT shift = msb - SUB_BUCKET_BITS;
+        return NUM_SUB_BUCKETS + shift*NUM_SUB_BUCKETS + (UINT)( (value >> shift) - NUM_SUB_BUCKETS );
+    }
+
+    /**
+     Gets the smallest value that is recorded in a bucket.
+
+     @param bucketIndex: the index of the bucket, this should be in the range [0 NUM_BUCKETS-1]
+     @return returns the smallest value of the bucket in nanoseconds
+     */
+    static unsigned long long getBucketLowerBound(const UINT bucketIndex){
+        if( bucketIndex < NUM_SUB_BUCKETS ) return bucketIndex;
+        const UINT shift = (bucketIndex - NUM_SUB_BUCKETS) / NUM_SUB_BUCKETS;
+        const UINT subBucket = (bucketIndex - NUM_SUB_BUCKETS) % NUM_SUB_BUCKETS;
+        return (unsigned long long)( NUM_SUB_BUCKETS + subBucket ) << shift;
+    }
+
+    /**
+     Gets the range of values that are recorded in a bucket.
+
+     @param bucketIndex: the index of the bucket, this should be in the range [0 NUM_BUCKETS-1]
+     @return returns the width of the bucket in nanoseconds
+     */
+    static unsigned long long getBucketWidth(const UINT bucketIndex){
+        if( bucketIndex < NUM_SUB_BUCKETS ) return 1;
+        return 1ULL << ( (bucketIndex - NUM_SUB_BUCKETS) / NUM_SUB_BUCKETS );
+    }
+
+protected:
+    static UINT getMostSignificantBit(unsigned long long value){
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - (UINT)__builtin_clzll( value );
+#else
+        UINT msb = 0;
+        while( value >>= 1 ) msb++;
+        return msb;
+#endif
+    }
+
+    unsigned long long counts[ NUM_BUCKETS ];
+    unsigned long long count;
+    unsigned long long sum;
+    unsigned long long minValue;
+    unsigned long long maxValue;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_LATENCY_HISTOGRAM_HEADER
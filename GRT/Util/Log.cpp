@@ -0,0 +1,337 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "Log.h"
+
+#ifdef GRT_CXX11_ENABLED
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#endif
+
+GRT_BEGIN_NAMESPACE
+
+#ifdef GRT_CXX11_ENABLED
+std::mutex Log::logMutex;
+#endif
+
+/*
+ LogMessageBuffer holds the message that is currently being written by one thread. The stream appends directly
+ to the message string, so formatting a value does not need a temporary std::stringstream.
+*/
+class LogMessageBuffer : public std::streambuf{
+public:
+    LogMessageBuffer() : stream( this ){
+        ownerId = 0;
+        messageStart = 0;
+        active = false;
+    }
+
+    ~LogMessageBuffer();
+
+    std::ostream stream;
+    std::string message;
+    unsigned long long ownerId;     //The instance id of the log that is writing the current message
+    size_t messageStart;            //The index in message after the proceeding text
+    bool active;
+
+protected:
+    virtual int_type overflow( int_type c ){
+        if( !traits_type::eq_int_type( c, traits_type::eof() ) ){
+            message.push_back( traits_type::to_char_type( c ) );
+        }
+        return traits_type::not_eof( c );
+    }
+
+    virtual std::streamsize xsputn( const char *s, std::streamsize n ){
+        message.append( s, (size_t)n );
+        return n;
+    }
+};
+
+static LogMessageBuffer& getLogMessageBuffer(){
+#ifdef GRT_CXX11_ENABLED
+    static thread_local LogMessageBuffer buffer;
+#else
+    static LogMessageBuffer buffer;
+#endif
+    return buffer;
+}
+
+#ifdef GRT_CXX11_ENABLED
+/*
+ LogMessageQueue is a bounded, lock-free, multi-producer single-consumer ring of finished messages.
+ Each slot has a sequence number that tells the producers and the consumer if the slot is free or full.
+*/
+class LogMessageQueue{
+public:
+    LogMessageQueue(const size_t capacity) : slots( new Slot[capacity] ), mask( capacity-1 ){
+        for(size_t i=0; i<capacity; i++){
+            slots[i].sequence.store( i, std::memory_order_relaxed );
+        }
+        head.store( 0, std::memory_order_relaxed );
+        tail = 0;
+    }
+
+    //Moves the message into the queue, returns false if the queue is full
+    bool push( std::string &message ){
+        size_t pos = head.load( std::memory_order_relaxed );
+        Slot *slot = NULL;
+        while( true ){
+            slot = &slots[ pos & mask ];
+            const size_t sequence = slot->sequence.load( std::memory_order_acquire );
+            const long long diff = (long long)sequence - (long long)pos;
+            if( diff == 0 ){
+                if( head.compare_exchange_weak( pos, pos+1, std::memory_order_relaxed ) ) break;
+            }else if( diff < 0 ){
+                return false;
+            }else pos = head.load( std::memory_order_relaxed );
+        }
+        slot->message.swap( message );
+        slot->sequence.store( pos+1, std::memory_order_release );
+        return true;
+    }
+
+    //Moves the oldest message out of the queue, this should only be called by the writer thread
+    bool pop( std::string &message ){
+        Slot &slot = slots[ tail & mask ];
+        if( slot.sequence.load( std::memory_order_acquire ) != tail+1 ){
+            return false;
+        }
+        message.swap( slot.message );
+        slot.sequence.store( tail+mask+1, std::memory_order_release );
+        tail++;
+        return true;
+    }
+
+protected:
+    struct Slot{
+        std::atomic< size_t > sequence;
+        std::string message;
+    };
+
+    std::unique_ptr< Slot[] > slots;
+    const size_t mask;
+    std::atomic< size_t > head;
+    size_t tail;
+};
+#endif //GRT_CXX11_ENABLED
+
+/*
+ LogWriter writes the finished messages to std::cout, either from a background thread or directly from the calling thread.
+*/
+class LogWriter{
+public:
+    static LogWriter& getInstance(){
+        //The writer is never deleted, so it is still valid for any logs used while static objects are being destroyed
+        static LogWriter *writer = new LogWriter();
+        return *writer;
+    }
+
+    void write( std::string &message ){
+#ifdef GRT_CXX11_ENABLED
+        if( asyncLoggingEnabled.load( std::memory_order_relaxed ) ){
+            std::call_once( startFlag, [this]{ start(); } );
+            while( !queue.push( message ) ){
+                //The queue is full, so wait for the writer thread to catch up
+                condition.notify_one();
+                std::this_thread::yield();
+            }
+            numMessagesQueued.fetch_add( 1, std::memory_order_release );
+            condition.notify_one();
+            message.clear();
+            return;
+        }
+        std::unique_lock<std::mutex> lock( outputMutex );
+#endif
+        std::cout << message;
+        std::cout.flush();
+        message.clear();
+    }
+
+    bool flush(){
+#ifdef GRT_CXX11_ENABLED
+        const unsigned long long target = numMessagesQueued.load( std::memory_order_acquire );
+        while( numMessagesWritten.load( std::memory_order_acquire ) < target ){
+            condition.notify_one();
+            std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+        }
+#endif
+        std::cout.flush();
+        return true;
+    }
+
+    bool setAsyncLoggingEnabled( const bool enabled ){
+#ifdef GRT_CXX11_ENABLED
+        flush();
+        asyncLoggingEnabled.store( enabled );
+        return true;
+#else
+        return !enabled;
+#endif
+    }
+
+    bool getAsyncLoggingEnabled() const{
+#ifdef GRT_CXX11_ENABLED
+        return asyncLoggingEnabled.load();
+#else
+        return false;
+#endif
+    }
+
+protected:
+#ifdef GRT_CXX11_ENABLED
+    LogWriter() : queue( 4096 ){
+        asyncLoggingEnabled.store( true );
+        numMessagesQueued.store( 0 );
+        numMessagesWritten.store( 0 );
+    }
+
+    static void flushAtExit(){
+        getInstance().flush();
+    }
+
+    void start(){
+        std::thread( [this]{ run(); } ).detach();
+        std::atexit( flushAtExit );
+    }
+
+    void run(){
+        std::string message;
+        while( true ){
+            unsigned long long numMessages = 0;
+            while( queue.pop( message ) ){
+                std::cout << message;
+                numMessages++;
+            }
+            if( numMessages > 0 ){
+                std::cout.flush();
+                numMessagesWritten.fetch_add( numMessages, std::memory_order_release );
+                continue;
+            }
+
+            //The producers notify without taking the lock, so use a timeout in case a notification is missed
+            std::unique_lock<std::mutex> lock( waitMutex );
+            condition.wait_for( lock, std::chrono::milliseconds( 10 ) );
+        }
+    }
+
+    LogMessageQueue queue;
+    std::atomic< bool > asyncLoggingEnabled;
+    std::atomic< unsigned long long > numMessagesQueued;
+    std::atomic< unsigned long long > numMessagesWritten;
+    std::once_flag startFlag;
+    std::mutex waitMutex;
+    std::mutex outputMutex;
+    std::condition_variable condition;
+#else
+    LogWriter(){}
+#endif
+};
+
+LogMessageBuffer::~LogMessageBuffer(){
+    //Pass on anything that was written without a std::endl before the thread finished
+    if( active && message.size() > 0 ){
+        LogWriter::getInstance().write( message );
+    }
+}
+
+std::string Log::getLastMessage() const{
+#ifdef GRT_CXX11_ENABLED
+    std::unique_lock<std::mutex> lock( logMutex );
+#endif
+    return lastMessage;
+}
+
+bool Log::flush(){
+    return LogWriter::getInstance().flush();
+}
+
+bool Log::setAsyncLoggingEnabled(const bool asyncLoggingEnabled){
+    return LogWriter::getInstance().setAsyncLoggingEnabled( asyncLoggingEnabled );
+}
+
+bool Log::getAsyncLoggingEnabled(){
+    return LogWriter::getInstance().getAsyncLoggingEnabled();
+}
+
+std::ostream& Log::getMessageStream() const{
+
+    LogMessageBuffer &buffer = getLogMessageBuffer();
+
+    if( buffer.active && buffer.ownerId != instanceId ){
+        //Another log on this thread has not finished its message, so pass on what it has written so far
+        LogWriter::getInstance().write( buffer.message );
+        buffer.active = false;
+    }
+
+    if( !buffer.active ){
+        buffer.active = true;
+        buffer.ownerId = instanceId;
+        buffer.message.assign( proceedingText );
+        buffer.messageStart = buffer.message.size();
+    }
+
+    return buffer.stream;
+}
+
+void Log::endMessage( const StandardEndLine manip ) const{
+
+    LogMessageBuffer &buffer = getLogMessageBuffer();
+
+    if( buffer.active && buffer.ownerId != instanceId ){
+        LogWriter::getInstance().write( buffer.message );
+        buffer.active = false;
+    }
+
+    const bool hasMessage = buffer.active;
+    std::string message;
+    if( hasMessage ) message = buffer.message.substr( buffer.messageStart );
+    else buffer.message.clear();
+
+    // call the function, but we cannot return it's value
+    manip( buffer.stream );
+    buffer.active = false;
+
+    //Update the last message and trigger any logging callbacks
+    {
+#ifdef GRT_CXX11_ENABLED
+        std::unique_lock<std::mutex> lock( logMutex );
+#endif
+        if( hasMessage ) lastMessage = message;
+        else message = lastMessage;
+        triggerCallback( message );
+    }
+
+    LogWriter::getInstance().write( buffer.message );
+}
+
+unsigned long long Log::getNextInstanceId(){
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< unsigned long long > nextInstanceId( 1 );
+    return nextInstanceId.fetch_add( 1, std::memory_order_relaxed );
+#else
+    static unsigned long long nextInstanceId = 1;
+    return nextInstanceId++;
+#endif
+}
+
+GRT_END_NAMESPACE
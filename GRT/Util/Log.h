@@ -2,19 +2,19 @@
 GRT MIT License
 Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
 
-Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
-and associated documentation files (the "Software"), to deal in the Software without restriction, 
-including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
-and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
 subject to the following conditions:
 
-The above copyright notice and this permission notice shall be included in all copies or substantial 
+The above copyright notice and this permission notice shall be included in all copies or substantial
 portions of the Software.
 
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
-LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
-IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
-WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
 SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
@@ -29,88 +29,130 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <mutex>
 #endif //GRT_CXX11_ENABLED
 
+//The level of each log, any log with a level below GRT_LOG_MIN_LEVEL is removed at compile time
+#define GRT_LOG_LEVEL_DEBUG 0
+#define GRT_LOG_LEVEL_TRAINING 1
+#define GRT_LOG_LEVEL_TESTING 1
+#define GRT_LOG_LEVEL_INFO 2
+#define GRT_LOG_LEVEL_WARNING 3
+#define GRT_LOG_LEVEL_ERROR 4
+
+#ifndef GRT_LOG_MIN_LEVEL
+#define GRT_LOG_MIN_LEVEL GRT_LOG_LEVEL_DEBUG
+#endif
+
 GRT_BEGIN_NAMESPACE
 
+/**
+ The Log class is the base class for all the GRT logs (e.g. errorLog, warningLog, trainingLog).
+
+ Each message is formatted into a buffer owned by the calling thread, so writing to a log does not take any locks.
+ When a message is finished (i.e. std::endl is written to the log), the last message and any callbacks are updated
+ and the message is handed to a background thread that writes it to std::cout. Use Log::flush() to wait for all
+ the messages written so far to reach std::cout, or Log::setAsyncLoggingEnabled(false) to write them directly.
+*/
 class GRT_API Log{
 public:
+#ifdef GRT_CXX11_ENABLED
+    typedef std::atomic< bool > LoggingFlag;
+#else
+    typedef bool LoggingFlag;
+#endif
+
     Log(std::string proceedingText = ""){
         setProceedingText(proceedingText);
         loggingEnabledPtr = NULL;
         instanceLoggingEnabled = true;
-        writeProceedingText = true;
-        writeProceedingTextPtr = &writeProceedingText;
-        lastMessagePtr = &lastMessage;
+        instanceId = getNextInstanceId();
+    }
+
+    Log(const Log &rhs){
+        this->proceedingText = rhs.proceedingText;
+        this->lastMessage = rhs.getLastMessage();
+        this->instanceLoggingEnabled = rhs.instanceLoggingEnabled;
+        this->loggingEnabledPtr = rhs.loggingEnabledPtr;
+        this->instanceId = getNextInstanceId();
     }
 
     virtual ~Log(){}
 
     template < class T >
-    const Log& operator<< (const T val ) const{
-
-#ifdef GRT_CXX11_ENABLED
-        std::unique_lock<std::mutex> lock( logMutex );
-#endif
-        
-        if( *loggingEnabledPtr && instanceLoggingEnabled ){
-            if( *writeProceedingTextPtr ){
-                *writeProceedingTextPtr = false;
-                std::cout << proceedingText.c_str();
-                *lastMessagePtr = "";
-            }
-            std::cout << val;
-            std::stringstream stream;
-            stream << val;
-            *lastMessagePtr += stream.str();
+    const Log& operator<< (const T &val ) const{
+        if( isLoggingEnabled() ){
+            write( val );
         }
         return *this;
     }
 
     // this is the type of std::cout
     typedef std::basic_ostream<char, std::char_traits<char> > CoutType;
-    
+
     // this is the function signature of std::endl
     typedef CoutType& (*StandardEndLine)(CoutType&);
-    
+
     // define an operator<< to take in std::endl
     const Log& operator<<(const StandardEndLine manip) const{
-
-#ifdef GRT_CXX11_ENABLED
-        std::unique_lock<std::mutex> lock( logMutex );
-#endif
-
-        if( *loggingEnabledPtr && instanceLoggingEnabled ){
-            // call the function, but we cannot return it's value
-            manip(std::cout);
-            *writeProceedingTextPtr = true;
-            
-            //Trigger any logging callbacks
-            triggerCallback( lastMessage );
+        if( isLoggingEnabled() ){
+            endMessage( manip );
         }
-        
         return *this;
     }
 
     //Getters
     virtual bool getLoggingEnabled() const{ return false; }
-    
+
     bool getInstanceLoggingEnabled() const { return instanceLoggingEnabled; };
 
     std::string getProceedingText() const{ return proceedingText; }
 
-    virtual std::string getLastMessage() const{ return lastMessage; }
-    
+    virtual std::string getLastMessage() const;
+
     //Setters
     void setProceedingText(const std::string &proceedingText){
         if( proceedingText.length() == 0 ) this->proceedingText = "";
         else this->proceedingText = proceedingText + " ";
     }
-    
+
     bool setEnableInstanceLogging(bool loggingEnabled){
         this->instanceLoggingEnabled = loggingEnabled;
         return true;
     }
 
+    /**
+    Blocks until all the messages that have been finished so far have been written to std::cout.
+
+    @return returns true if the messages were written, false otherwise
+    */
+    static bool flush();
+
+    /**
+    Sets if finished messages should be written to std::cout by a background thread (the default), or directly
+    by the thread that wrote the message. Any pending messages are flushed before the mode is changed.
+    Asynchronous logging requires C++11 support, without it messages are always written directly.
+
+    @param asyncLoggingEnabled: if true, messages will be written by the background thread
+    @return returns true if the mode was updated, false otherwise
+    */
+    static bool setAsyncLoggingEnabled(const bool asyncLoggingEnabled);
+
+    /**
+    @return returns true if finished messages are written to std::cout by a background thread, false otherwise
+    */
+    static bool getAsyncLoggingEnabled();
+
 protected:
+    bool isLoggingEnabled() const{
+        return instanceLoggingEnabled && loggingEnabledPtr != NULL && *loggingEnabledPtr;
+    }
+
+    template< class T >
+    void write( const T &val ) const{
+        getMessageStream() << val;
+    }
+
+    std::ostream& getMessageStream() const;
+    void endMessage( const StandardEndLine manip ) const;
+
     virtual void triggerCallback( const std::string &message ) const{
         return;
     }
@@ -121,18 +163,68 @@ protected:
         s << val;
         return s.str();
     }
-    
+
     std::string proceedingText;
-    std::string lastMessage;
+    mutable std::string lastMessage;
     bool instanceLoggingEnabled;
-    bool *loggingEnabledPtr;
-    bool *writeProceedingTextPtr;
-    std::string *lastMessagePtr;
-    bool writeProceedingText;
+    LoggingFlag *loggingEnabledPtr;
+    unsigned long long instanceId;
 
 #ifdef GRT_CXX11_ENABLED
     static std::mutex logMutex;
 #endif
+
+private:
+    static unsigned long long getNextInstanceId();
+};
+
+template< bool enabled >
+struct LogLevelEnabled{};
+
+/**
+ LogStream is the base class for each of the GRT log types. It is templated on the log level, so that any log with a level
+ below GRT_LOG_MIN_LEVEL is compiled out (the values passed to it are never formatted and the enabled flag is never checked).
+*/
+template< class LogType, int LOG_LEVEL >
+class LogStream : public Log{
+public:
+    enum{ logLevel = LOG_LEVEL };
+
+    LogStream(std::string proceedingText = "") : Log(proceedingText){}
+
+    virtual ~LogStream(){}
+
+    template < class T >
+    const LogType& operator<< (const T &val ) const{
+        write( val, LevelEnabled() );
+        return static_cast< const LogType& >( *this );
+    }
+
+    const LogType& operator<<(const StandardEndLine manip) const{
+        endMessage( manip, LevelEnabled() );
+        return static_cast< const LogType& >( *this );
+    }
+
+protected:
+    typedef LogLevelEnabled< (LOG_LEVEL >= GRT_LOG_MIN_LEVEL) > LevelEnabled;
+
+    template< class T >
+    void write( const T &val, LogLevelEnabled< true > ) const{
+        if( isLoggingEnabled() ){
+            Log::write( val );
+        }
+    }
+
+    template< class T >
+    void write( const T &val, LogLevelEnabled< false > ) const{}
+
+    void endMessage( const StandardEndLine manip, LogLevelEnabled< true > ) const{
+        if( isLoggingEnabled() ){
+            Log::endMessage( manip );
+        }
+    }
+
+    void endMessage( const StandardEndLine manip, LogLevelEnabled< false > ) const{}
 };
 
 GRT_END_NAMESPACE
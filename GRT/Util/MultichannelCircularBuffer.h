@@ -0,0 +1,370 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The MultichannelCircularBuffer class provides a circular buffer for multichannel streams (such as the input of a
+ FIR filter or a DTW classifier). Unlike a CircularBuffer< VectorFloat >, where every element is a separate heap allocated
+ vector, all the frames are stored in one contiguous frames x channels block, so adding a frame never allocates memory and
+ each frame is copied with a single block copy.
+
+ The block uses a mirrored layout: every frame is written twice, once in the first half of the block and once in the second
+ half. This means the most recent N frames (for any N up to the size of the buffer) are always stored contiguously, oldest
+ to newest, so the window can be accessed through a single pointer without copying the data and without computing a modulo
+ for each access. A single channel of the window can be accessed through a ChannelView, which strides over the window.
+
+ The buffer always contains getNumFrames() frames, which are set to the default value when the buffer is resized. Frame 0
+ is the oldest frame and frame getNumFrames()-1 is the most recent frame.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_MULTICHANNEL_CIRCULAR_BUFFER_HEADER
+#define GRT_MULTICHANNEL_CIRCULAR_BUFFER_HEADER
+
+#include <algorithm>
+#include "GRTTypedefs.h"
+#include "ErrorLog.h"
+#include "../DataStructures/Vector.h"
+
+GRT_BEGIN_NAMESPACE
+
+template <class T>
+class MultichannelCircularBuffer{
+public:
+
+    /**
+     The ChannelView class gives access to the values of one channel over a number of consecutive frames, without copying
+     the data. The view is only valid until the next frame is added to the buffer.
+     */
+    class ChannelView{
+    public:
+        ChannelView(const T *data = NULL,const UINT size = 0,const UINT stride = 1) : data(data), size(size), stride(stride) {}
+
+        /**
+         Gets the value of the channel at the index, where 0 is the oldest frame in the view.
+
+         @param index: the index of the frame, should be in the range [0 getSize()-1]
+         @return returns a const reference to the value
+         */
+        inline const T& operator[](const UINT index) const { return data[ index*stride ]; }
+
+        /**
+         @return returns the number of frames in the view
+         */
+        UINT getSize() const { return size; }
+
+        /**
+         @return returns the distance (in elements) between two consecutive values of the channel
+         */
+        UINT getStride() const { return stride; }
+
+        /**
+         @return returns a pointer to the first (oldest) value of the view
+         */
+        const T* getData() const { return data; }
+
+        /**
+         Copies the values of the view into a vector, the vector will be resized if needed.
+
+         @param values: the vector the values will be copied to
+         @return returns true if the values were copied
+         */
+        bool copyTo(Vector< T > &values) const {
+            if( values.getSize() != size ) values.resize( size );
+            for(UINT i=0; i<size; i++) values[i] = data[ i*stride ];
+            return true;
+        }
+
+    protected:
+        const T *data;
+        UINT size;
+        UINT stride;
+    };
+
+    /**
+     Default Constructor
+     */
+    MultichannelCircularBuffer(){
+        errorLog.setProceedingText("[ERROR: MultichannelCircularBuffer]");
+        clear();
+    }
+
+    /**
+     Init Constructor. Resizes the buffer to hold numFrames frames with numChannels channels.
+
+     @param numFrames: the number of frames the buffer holds
+     @param numChannels: the number of channels in each frame
+     @param defaultValue: the value every element is set to
+     */
+    MultichannelCircularBuffer(const UINT numFrames,const UINT numChannels,const T &defaultValue = T()){
+        errorLog.setProceedingText("[ERROR: MultichannelCircularBuffer]");
+        clear();
+        resize( numFrames, numChannels, defaultValue );
+    }
+
+    /**
+     Default Destructor.
+     */
+    virtual ~MultichannelCircularBuffer(){
+    }
+
+    /**
+     Resizes the buffer to hold numFrames frames with numChannels channels, both must be greater than zero. Every element is
+     set to the default value and the number of values in the buffer is set to zero.
+
+     @param numFrames: the number of frames the buffer holds
+     @param numChannels: the number of channels in each frame
+     @param defaultValue: the value every element is set to
+     @return returns true if the buffer was resized
+     */
+    bool resize(const UINT numFrames,const UINT numChannels,const T &defaultValue = T()){
+
+        clear();
+
+        if( numFrames == 0 || numChannels == 0 ){
+            errorLog << "resize(...) - The number of frames and the number of channels must be greater than zero!" << std::endl;
+            return false;
+        }
+
+        this->numFrames = numFrames;
+        this->numChannels = numChannels;
+        this->defaultValue = defaultValue;
+        buffer.resize( 2 * numFrames * numChannels, defaultValue );
+        bufferInit = true;
+
+        return true;
+    }
+
+    /**
+     Adds a new frame to the end of the buffer, removing the oldest frame.
+
+     @param frame: a pointer to the numChannels values of the new frame
+     @return returns true if the frame was added, false otherwise
+     */
+    bool push_back(const T *frame){
+
+        if( !bufferInit ){
+            errorLog << "push_back(const T *frame) - The buffer has not been initialized!" << std::endl;
+            return false;
+        }
+
+        //The new frame replaces the oldest frame, in both halves of the mirrored block
+        T *first = &buffer[ readIndex * numChannels ];
+        std::copy( frame, frame + numChannels, first );
+        std::copy( frame, frame + numChannels, first + numFrames * numChannels );
+
+        if( ++readIndex == numFrames ) readIndex = 0;
+        if( numValuesInBuffer < numFrames ) numValuesInBuffer++;
+
+        return true;
+    }
+
+    /**
+     Adds a new frame to the end of the buffer, removing the oldest frame. The size of the frame must match the number of channels.
+
+     @param frame: the new frame
+     @return returns true if the frame was added, false otherwise
+     */
+    bool push_back(const Vector< T > &frame){
+
+        if( frame.getSize() != numChannels ){
+            errorLog << "push_back(const Vector< T > &frame) - The size of the frame (" << frame.getSize() << ") does not match the number of channels (" << numChannels << ")!" << std::endl;
+            return false;
+        }
+
+        return push_back( &frame[0] );
+    }
+
+    /**
+     Sets every element in the buffer to the value and flags the buffer as filled, as if getNumFrames() frames of the value had been added.
+
+     @param value: the value every element is set to
+     @return returns true if the buffer was updated, false otherwise
+     */
+    bool fill(const T &value){
+
+        if( !bufferInit ) return false;
+
+        std::fill( buffer.begin(), buffer.end(), value );
+        readIndex = 0;
+        numValuesInBuffer = numFrames;
+
+        return true;
+    }
+
+    /**
+     Sets every element in the buffer back to the default value and sets the number of values in the buffer to zero.
+
+     @return returns true if the buffer was reset, false otherwise
+     */
+    bool reset(){
+
+        if( !bufferInit ) return false;
+
+        std::fill( buffer.begin(), buffer.end(), defaultValue );
+        readIndex = 0;
+        numValuesInBuffer = 0;
+
+        return true;
+    }
+
+    /**
+     Clears the buffer, setting the size to 0.
+     */
+    void clear(){
+        bufferInit = false;
+        numFrames = 0;
+        numChannels = 0;
+        numValuesInBuffer = 0;
+        readIndex = 0;
+        defaultValue = T();
+        buffer.clear();
+    }
+
+    /**
+     Gets the value of one channel of one frame.
+
+     @param frameIndex: the index of the frame, 0 is the oldest frame and getNumFrames()-1 is the most recent frame
+     @param channel: the channel, should be in the range [0 getNumChannels()-1]
+     @return returns a const reference to the value
+     */
+    inline const T& operator()(const UINT frameIndex,const UINT channel) const{
+        return buffer[ (readIndex + frameIndex) * numChannels + channel ];
+    }
+
+    /**
+     Gets a pointer to the numChannels values of a frame.
+
+     @param frameIndex: the index of the frame, 0 is the oldest frame and getNumFrames()-1 is the most recent frame
+     @return returns a pointer to the frame
+     */
+    inline const T* getFrame(const UINT frameIndex) const{
+        return &buffer[ (readIndex + frameIndex) * numChannels ];
+    }
+
+    /**
+     Gets a pointer to the most recent frame.
+
+     @return returns a pointer to the most recent frame
+     */
+    inline const T* getBack() const{
+        return getFrame( numFrames-1 );
+    }
+
+    /**
+     Gets a pointer to the most recent windowSize frames. The frames are stored contiguously from the oldest to the most recent
+     frame, so the window can be read as a windowSize x numChannels row major matrix. The pointer is only valid until the next
+     frame is added to the buffer.
+
+     @param windowSize: the number of frames in the window, should be in the range [1 getNumFrames()]
+     @return returns a pointer to the oldest frame in the window
+     */
+    inline const T* getWindow(const UINT windowSize) const{
+        return getFrame( numFrames - windowSize );
+    }
+
+    /**
+     Gets a pointer to all the frames in the buffer, see getWindow(const UINT windowSize).
+
+     @return returns a pointer to the oldest frame in the buffer
+     */
+    inline const T* getWindow() const{
+        return getFrame( 0 );
+    }
+
+    /**
+     Gets a view of one channel over the most recent windowSize frames.
+
+     @param channel: the channel, should be in the range [0 getNumChannels()-1]
+     @param windowSize: the number of frames in the view, should be in the range [1 getNumFrames()]
+     @return returns a view of the channel
+     */
+    ChannelView getChannel(const UINT channel,const UINT windowSize) const{
+        return ChannelView( getWindow( windowSize ) + channel, windowSize, numChannels );
+    }
+
+    /**
+     Gets a view of one channel over all the frames in the buffer.
+
+     @param channel: the channel, should be in the range [0 getNumChannels()-1]
+     @return returns a view of the channel
+     */
+    ChannelView getChannel(const UINT channel) const{
+        return getChannel( channel, numFrames );
+    }
+
+    /**
+     Gets a copy of the frames that have been added to the buffer, in order from the oldest to the most recent frame.
+     The frame type can be set to any vector type that can be assigned from a range of T, such as VectorFloat.
+
+     @return returns the frames that have been added to the buffer
+     */
+    template< class FrameType = Vector< T > >
+    Vector< FrameType > getData() const{
+        Vector< FrameType > data( numValuesInBuffer );
+        for(UINT i=0; i<numValuesInBuffer; i++){
+            const T *frame = getFrame( numFrames - numValuesInBuffer + i );
+            data[i].assign( frame, frame + numChannels );
+        }
+        return data;
+    }
+
+    /**
+     @return returns true if the buffer has been initialized, false otherwise
+     */
+    bool getInit() const { return bufferInit; }
+
+    /**
+     @return returns true if at least getNumFrames() frames have been added since the buffer was resized or reset
+     */
+    bool getBufferFilled() const { return bufferInit ? numValuesInBuffer == numFrames : false; }
+
+    /**
+     @return returns the number of frames in the buffer
+     */
+    UINT getNumFrames() const { return numFrames; }
+
+    /**
+     @return returns the number of channels in each frame
+     */
+    UINT getNumChannels() const { return numChannels; }
+
+    /**
+     @return returns the number of frames that have been added since the buffer was resized or reset, up to getNumFrames()
+     */
+    UINT getNumValuesInBuffer() const { return numValuesInBuffer; }
+
+protected:
+    bool bufferInit;
+    UINT numFrames;
+    UINT numChannels;
+    UINT numValuesInBuffer;
+    UINT readIndex;                 ///< The index of the oldest frame in the first half of the mirrored block
+    T defaultValue;
+    Vector< T > buffer;             ///< The mirrored block, this holds 2 x numFrames x numChannels values
+
+    ErrorLog errorLog;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_MULTICHANNEL_CIRCULAR_BUFFER_HEADER
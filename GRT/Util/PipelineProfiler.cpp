@@ -0,0 +1,248 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define GRT_DLL_EXPORTS
+#include "PipelineProfiler.h"
+#include <sstream>
+#include <iomanip>
+
+//Allocations are counted by replacing the global operator new, this is only done if it has been requested at build time
+#if defined(GRT_PROFILE_ALLOCATIONS) && defined(GRT_CXX11_ENABLED)
+#define GRT_PIPELINE_PROFILER_COUNT_ALLOCATIONS
+#include <new>
+#include <cstdlib>
+
+static thread_local unsigned long long grtThreadAllocationCounter = 0;
+
+void* operator new(std::size_t size){
+    grtThreadAllocationCounter++;
+    void *ptr = std::malloc( size > 0 ? size : 1 );
+    if( ptr == NULL ) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](std::size_t size){
+    grtThreadAllocationCounter++;
+    void *ptr = std::malloc( size > 0 ? size : 1 );
+    if( ptr == NULL ) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept{
+    std::free( ptr );
+}
+
+void operator delete[](void *ptr) noexcept{
+    std::free( ptr );
+}
+
+void operator delete(void *ptr,std::size_t) noexcept{
+    std::free( ptr );
+}
+
+void operator delete[](void *ptr,std::size_t) noexcept{
+    std::free( ptr );
+}
+#endif
+
+GRT_BEGIN_NAMESPACE
+
+PipelineProfiler::PipelineProfiler(){
+    predictionStartTime = 0;
+    predictionStartAllocations = 0;
+    moduleStartTime = 0;
+    reset();
+}
+
+PipelineProfiler::~PipelineProfiler(){
+}
+
+bool PipelineProfiler::reset(){
+    numPredictions = 0;
+    numFailedPredictions = 0;
+    numRejections = 0;
+    numAllocations = 0;
+    maxAllocationsPerPrediction = 0;
+    pipelineLatency.reset();
+    moduleLatency.clear();
+    moduleLatency.resize( NUM_PROFILER_STAGES );
+    return true;
+}
+
+bool PipelineProfiler::recordModuleLatency(const UINT stage,const UINT moduleIndex,const unsigned long long nanoSeconds){
+
+    if( stage >= NUM_PROFILER_STAGES ) return false;
+
+    //Add a histogram for the module the first time it is recorded
+    if( moduleIndex >= moduleLatency[stage].getSize() ){
+        moduleLatency[stage].resize( moduleIndex+1 );
+    }
+
+    moduleLatency[stage][moduleIndex].record( nanoSeconds );
+
+    return true;
+}
+
+unsigned long long PipelineProfiler::getNumPredictions() const{
+    return numPredictions;
+}
+
+unsigned long long PipelineProfiler::getNumFailedPredictions() const{
+    return numFailedPredictions;
+}
+
+unsigned long long PipelineProfiler::getNumRejections() const{
+    return numRejections;
+}
+
+unsigned long long PipelineProfiler::getNumAllocations() const{
+    return numAllocations;
+}
+
+unsigned long long PipelineProfiler::getMaxAllocationsPerPrediction() const{
+    return maxAllocationsPerPrediction;
+}
+
+const LatencyHistogram& PipelineProfiler::getPipelineLatency() const{
+    return pipelineLatency;
+}
+
+UINT PipelineProfiler::getNumModules(const UINT stage) const{
+    if( stage >= NUM_PROFILER_STAGES ) return 0;
+    return moduleLatency[stage].getSize();
+}
+
+LatencyHistogram PipelineProfiler::getModuleLatency(const UINT stage,const UINT moduleIndex) const{
+    if( stage >= NUM_PROFILER_STAGES || moduleIndex >= moduleLatency[stage].getSize() ) return LatencyHistogram();
+    return moduleLatency[stage][moduleIndex];
+}
+
+LatencyHistogram PipelineProfiler::getStageLatency(const UINT stage) const{
+    LatencyHistogram histogram;
+    if( stage >= NUM_PROFILER_STAGES ) return histogram;
+    for(UINT i=0; i<moduleLatency[stage].getSize(); i++){
+        histogram.merge( moduleLatency[stage][i] );
+    }
+    return histogram;
+}
+
+std::string PipelineProfiler::getStatsAsString() const{
+
+    std::ostringstream stream;
+    stream << "Predictions: " << numPredictions << " Failed: " << numFailedPredictions << " Rejections: " << numRejections;
+    stream << " Allocations: " << numAllocations << " MaxAllocationsPerPrediction: " << maxAllocationsPerPrediction;
+    if( !getAllocationCountingEnabled() ) stream << " (allocation counting disabled)";
+    stream << std::endl;
+
+    stream << std::setw(26) << std::left << "Module" << std::right << std::setw(12) << "Count" << std::setw(14) << "Mean(ns)";
+    stream << std::setw(12) << "Min(ns)" << std::setw(12) << "P50(ns)" << std::setw(12) << "P90(ns)" << std::setw(12) << "P99(ns)";
+    stream << std::setw(12) << "P99.9(ns)" << std::setw(12) << "Max(ns)" << std::endl;
+
+    //Write one row for the complete pipeline and one row for each module
+    for(int stage=-1; stage<NUM_PROFILER_STAGES; stage++){
+        const UINT numModules = stage < 0 ? 1 : moduleLatency[stage].getSize();
+        for(UINT i=0; i<numModules; i++){
+            const LatencyHistogram &histogram = stage < 0 ? pipelineLatency : moduleLatency[stage][i];
+            if( stage >= 0 && histogram.getCount() == 0 ) continue;
+            std::ostringstream name;
+            if( stage < 0 ) name << "pipeline";
+            else name << getStageName( stage ) << "[" << i << "]";
+            stream << std::setw(26) << std::left << name.str() << std::right << std::setw(12) << histogram.getCount();
+            stream << std::setw(14) << std::fixed << std::setprecision(1) << histogram.getMean();
+            stream << std::setw(12) << histogram.getMin() << std::setw(12) << histogram.getPercentile(50);
+            stream << std::setw(12) << histogram.getPercentile(90) << std::setw(12) << histogram.getPercentile(99);
+            stream << std::setw(12) << histogram.getPercentile(99.9) << std::setw(12) << histogram.getMax() << std::endl;
+        }
+    }
+
+    return stream.str();
+}
+
+std::string PipelineProfiler::getStatsAsJSON() const{
+
+    //Writes the summary of a histogram as a JSON object
+    struct HistogramWriter{
+        static void write(std::ostringstream &stream,const LatencyHistogram &histogram){
+            stream << "{\"count\":" << histogram.getCount() << ",\"mean\":" << std::fixed << std::setprecision(1) << histogram.getMean();
+            stream << ",\"min\":" << histogram.getMin() << ",\"p50\":" << histogram.getPercentile(50) << ",\"p90\":" << histogram.getPercentile(90);
+            stream << ",\"p99\":" << histogram.getPercentile(99) << ",\"p999\":" << histogram.getPercentile(99.9) << ",\"max\":" << histogram.getMax() << "}";
+        }
+    };
+
+    std::ostringstream stream;
+    stream << "{\"predictions\":" << numPredictions << ",\"failedPredictions\":" << numFailedPredictions << ",\"rejections\":" << numRejections;
+    stream << ",\"allocationCountingEnabled\":" << (getAllocationCountingEnabled() ? "true" : "false");
+    stream << ",\"allocations\":" << numAllocations << ",\"maxAllocationsPerPrediction\":" << maxAllocationsPerPrediction;
+    stream << ",\"pipeline\":";
+    HistogramWriter::write( stream, pipelineLatency );
+    stream << ",\"stages\":{";
+    for(UINT stage=0; stage<NUM_PROFILER_STAGES; stage++){
+        if( stage > 0 ) stream << ",";
+        stream << "\"" << getStageName( stage ) << "\":[";
+        for(UINT i=0; i<moduleLatency[stage].getSize(); i++){
+            if( i > 0 ) stream << ",";
+            HistogramWriter::write( stream, moduleLatency[stage][i] );
+        }
+        stream << "]";
+    }
+    stream << "}}";
+
+    return stream.str();
+}
+
+std::string PipelineProfiler::getStageName(const UINT stage){
+    switch( stage ){
+        case PREPROCESSING_STAGE:
+            return "preProcessing";
+        case FEATURE_EXTRACTION_STAGE:
+            return "featureExtraction";
+        case CLASSIFIER_STAGE:
+            return "classifier";
+        case REGRESSIFIER_STAGE:
+            return "regressifier";
+        case CLUSTERER_STAGE:
+            return "clusterer";
+        case POST_PROCESSING_STAGE:
+            return "postProcessing";
+        case CONTEXT_STAGE:
+            return "context";
+        default:
+            break;
+    }
+    return "";
+}
+
+unsigned long long PipelineProfiler::getNumThreadAllocations(){
+#ifdef GRT_PIPELINE_PROFILER_COUNT_ALLOCATIONS
+    return grtThreadAllocationCounter;
+#else
+    return 0;
+#endif
+}
+
+bool PipelineProfiler::getAllocationCountingEnabled(){
+#ifdef GRT_PIPELINE_PROFILER_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,239 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The PipelineProfiler class records the latency of each stage and each module of a GestureRecognitionPipeline, along with
+ counters for the number of predictions, failed predictions, rejections and memory allocations. The latencies are measured with a
+ monotonic nanosecond clock and stored in LatencyHistogram instances, so percentiles (such as the 99th percentile) can be reported.
+ The statistics can be exported as text or as JSON.
+
+ Profiling is disabled by default and is enabled per pipeline with GestureRecognitionPipeline::setProfilingEnabled( true ). When it
+ is disabled, the pipeline only pays for a single branch per module.
+
+ Allocations are only counted if the GRT is built with GRT_PROFILE_ALLOCATIONS (the PROFILE_ALLOCATIONS CMake option) and
+ GRT_CXX11_ENABLED, in which case the global operator new is replaced with a version that counts the allocations made by each thread.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_PIPELINE_PROFILER_HEADER
+#define GRT_PIPELINE_PROFILER_HEADER
+
+#include "GRTTypedefs.h"
+#include "Timer.h"
+#include "LatencyHistogram.h"
+#include "../DataStructures/Vector.h"
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API PipelineProfiler{
+public:
+    enum ProfilerStages{ PREPROCESSING_STAGE=0, FEATURE_EXTRACTION_STAGE, CLASSIFIER_STAGE, REGRESSIFIER_STAGE, CLUSTERER_STAGE, POST_PROCESSING_STAGE, CONTEXT_STAGE, NUM_PROFILER_STAGES };
+
+    /**
+     Default Constructor.
+     */
+    PipelineProfiler();
+
+    /**
+     Default Destructor.
+     */
+    ~PipelineProfiler();
+
+    /**
+     Clears all the latencies and counters recorded by the profiler.
+
+     @return returns true if the profiler was reset
+     */
+    bool reset();
+
+    /**
+     Starts timing a new prediction. This is called by the GestureRecognitionPipeline at the start of each prediction.
+     */
+    void startPrediction(){
+        predictionStartAllocations = getNumThreadAllocations();
+        predictionStartTime = Timer::getMonotonicTimeNanoSeconds();
+    }
+
+    /**
+     Stops timing the current prediction and updates the prediction counters. This is called by the GestureRecognitionPipeline at
+     the end of each prediction.
+
+     @param success: true if the prediction was successful, false otherwise
+     @param rejected: true if the predicted class label was the null rejection label, false otherwise
+     */
+    void stopPrediction(const bool success,const bool rejected){
+        pipelineLatency.record( Timer::getMonotonicTimeNanoSeconds() - predictionStartTime );
+        const unsigned long long allocations = getNumThreadAllocations() - predictionStartAllocations;
+        numPredictions++;
+        if( !success ) numFailedPredictions++;
+        if( rejected ) numRejections++;
+        numAllocations += allocations;
+        if( allocations > maxAllocationsPerPrediction ) maxAllocationsPerPrediction = allocations;
+    }
+
+    /**
+     Starts timing a module. This is called by the GestureRecognitionPipeline before each module is run.
+     */
+    void startModule(){
+        moduleStartTime = Timer::getMonotonicTimeNanoSeconds();
+    }
+
+    /**
+     Stops timing a module and records its latency. This is called by the GestureRecognitionPipeline after each module is run.
+
+     @param stage: the stage of the module, this should be one of the ProfilerStages enums
+     @param moduleIndex: the index of the module in its stage. For the CONTEXT_STAGE, this is the context level and all the context modules at that level are timed together
+     */
+    void stopModule(const UINT stage,const UINT moduleIndex){
+        recordModuleLatency( stage, moduleIndex, Timer::getMonotonicTimeNanoSeconds() - moduleStartTime );
+    }
+
+    /**
+     Records the latency of a module.
+
+     @param stage: the stage of the module, this should be one of the ProfilerStages enums
+     @param moduleIndex: the index of the module in its stage
+     @param nanoSeconds: the latency of the module, in nanoseconds
+     @return returns true if the latency was recorded, false otherwise
+     */
+    bool recordModuleLatency(const UINT stage,const UINT moduleIndex,const unsigned long long nanoSeconds);
+
+    /**
+     Gets the number of predictions that have been recorded.
+
+     @return returns the number of predictions that have been recorded
+     */
+    unsigned long long getNumPredictions() const;
+
+    /**
+     Gets the number of predictions that failed.
+
+     @return returns the number of predictions that failed
+     */
+    unsigned long long getNumFailedPredictions() const;
+
+    /**
+     Gets the number of predictions where the predicted class label was the null rejection label (GRT_DEFAULT_NULL_CLASS_LABEL).
+
+     @return returns the number of rejections
+     */
+    unsigned long long getNumRejections() const;
+
+    /**
+     Gets the total number of memory allocations made during all the predictions. This is always zero if allocation counting is not enabled.
+
+     @return returns the total number of allocations
+     */
+    unsigned long long getNumAllocations() const;
+
+    /**
+     Gets the largest number of memory allocations made during a single prediction. This is always zero if allocation counting is not enabled.
+
+     @return returns the largest number of allocations made by one prediction
+     */
+    unsigned long long getMaxAllocationsPerPrediction() const;
+
+    /**
+     Gets the latency histogram for the complete prediction (i.e. from the input of the pipeline to the output of the pipeline).
+
+     @return returns a reference to the pipeline latency histogram
+     */
+    const LatencyHistogram& getPipelineLatency() const;
+
+    /**
+     Gets the number of modules that have latencies recorded for a stage.
+
+     @param stage: the stage, this should be one of the ProfilerStages enums
+     @return returns the number of modules in the stage, or 0 if the stage is not valid
+     */
+    UINT getNumModules(const UINT stage) const;
+
+    /**
+     Gets the latency histogram for a single module.
+
+     @param stage: the stage of the module, this should be one of the ProfilerStages enums
+     @param moduleIndex: the index of the module in the stage, this should be in the range [0 getNumModules(stage)-1]
+     @return returns the latency histogram of the module, this will be empty if the stage or module index are not valid
+     */
+    LatencyHistogram getModuleLatency(const UINT stage,const UINT moduleIndex) const;
+
+    /**
+     Gets the latency histogram for a stage, this contains the latencies of all the modules in the stage.
+
+     @param stage: the stage, this should be one of the ProfilerStages enums
+     @return returns the latency histogram of the stage, this will be empty if the stage is not valid
+     */
+    LatencyHistogram getStageLatency(const UINT stage) const;
+
+    /**
+     Gets the statistics recorded by the profiler as a human readable table.
+
+     @return returns a string containing the statistics
+     */
+    std::string getStatsAsString() const;
+
+    /**
+     Gets the statistics recorded by the profiler as a JSON object. All the latencies are in nanoseconds.
+
+     @return returns a string containing the statistics as JSON
+     */
+    std::string getStatsAsJSON() const;
+
+    /**
+     Gets the name of a stage.
+
+     @param stage: the stage, this should be one of the ProfilerStages enums
+     @return returns the name of the stage, or an empty string if the stage is not valid
+     */
+    static std::string getStageName(const UINT stage);
+
+    /**
+     Gets the number of memory allocations that have been made by the calling thread.
+
+     @return returns the number of allocations made by the calling thread, this is always zero if allocation counting is not enabled
+     */
+    static unsigned long long getNumThreadAllocations();
+
+    /**
+     Gets if the GRT was built with allocation counting enabled.
+
+     @return returns true if allocations are counted, false otherwise
+     */
+    static bool getAllocationCountingEnabled();
+
+protected:
+    unsigned long long numPredictions;
+    unsigned long long numFailedPredictions;
+    unsigned long long numRejections;
+    unsigned long long numAllocations;
+    unsigned long long maxAllocationsPerPrediction;
+    unsigned long long predictionStartTime;
+    unsigned long long predictionStartAllocations;
+    unsigned long long moduleStartTime;
+    LatencyHistogram pipelineLatency;
+    Vector< Vector< LatencyHistogram > > moduleLatency;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_PIPELINE_PROFILER_HEADER
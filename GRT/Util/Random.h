@@ -157,8 +157,9 @@ public:
     
     /**
      This function is similar to the getRandomNumberWeighted(Vector< IndexedDouble > weightedValues), with the exception that the user needs
-     to sort the weightedValues Vector and create the accumulated lookup table (x). This is useful if you need to call the same function 
-     multiple times on the same weightedValues, allowing you to only sort and build the loopup table once.
+     to create the accumulated lookup table (x). This is useful if you need to call the same function multiple times on the same
+     weightedValues, allowing you to only build the loopup table once. The weightedValues do not need to be sorted, and each call
+     runs in O(log N).
      
      Gets a random integer from the input Vector. The probability of choosing a specific integer is given by the
      corresponding weight of that value. The weights do not need to sum to 1.
@@ -176,15 +177,14 @@ public:
         
         if( weightedValues.size() != x.size() ) return 0;
         
+        if( N == 0 ) return 0;
+        
         //Generate a random value between min and the max weighted Float values
         Float randValue = getRandomNumberUniform(0,x[N-1]);
         
-        //Find which bin the rand value falls into, return the index of that bin
-        for(unsigned int i=0; i<N; i++){
-            if( randValue <= x[i] ){
-                return weightedValues[ i ].index;
-            }
-        }
+        //Find which bin the rand value falls into, the lookup table is increasing so this can be found with a binary search
+        const unsigned int i = (unsigned int)(std::lower_bound( x.begin(), x.end(), randValue ) - x.begin());
+        if( i < N ) return weightedValues[ i ].index;
         return 0;
     }
     
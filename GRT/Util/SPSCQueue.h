@@ -0,0 +1,196 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @brief The SPSCQueue class implements a bounded, lock-free, single-producer single-consumer queue. One thread can push
+ values into the queue while another thread pops them, without either thread taking a lock. It is used to hand samples
+ and predictions between the threads of a real-time runtime (e.g. the grt-serve tool).
+
+ This class requires GRT_CXX11_ENABLED, otherwise the SPSCQueue class will be empty (as it requires C++11 support).
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_SPSC_QUEUE_HEADER
+#define GRT_SPSC_QUEUE_HEADER
+
+#include "GRTTypedefs.h"
+
+//Only include the C++ 11 code if C++11 support it is enabled
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#include <memory>
+#endif //GRT_CXX11_ENABLED
+
+GRT_BEGIN_NAMESPACE
+
+#ifdef GRT_CXX11_ENABLED
+
+template< class T >
+class SPSCQueue{
+public:
+    /**
+     Default Constructor, the capacity is rounded up to the next power of two.
+
+     @param capacity: the maximum number of values the queue can hold
+     */
+    SPSCQueue(const size_t capacity = 1024) : capacity( roundUpToPowerOfTwo( capacity ) ), mask( this->capacity-1 ), data( new T[ this->capacity ] ){
+        head.store( 0, std::memory_order_relaxed );
+        tail.store( 0, std::memory_order_relaxed );
+        cachedHead = 0;
+        cachedTail = 0;
+    }
+
+    /**
+     Default Destructor
+     */
+    ~SPSCQueue(){}
+
+    /**
+     Copies the value into the queue. This should only be called by the producer thread.
+
+     @param value: the value to add to the queue
+     @return returns true if the value was added, false if the queue is full
+     */
+    bool push(const T &value){
+        const size_t h = head.load( std::memory_order_relaxed );
+        if( h - cachedTail >= capacity ){
+            cachedTail = tail.load( std::memory_order_acquire );
+            if( h - cachedTail >= capacity ) return false;
+        }
+        data[ h & mask ] = value;
+        head.store( h+1, std::memory_order_release );
+        return true;
+    }
+
+    /**
+     Returns a pointer to the next free slot in the queue, so a producer can fill the value in place (e.g. to avoid
+     allocating memory for every sample). The value is not visible to the consumer until commitPush() is called.
+     This should only be called by the producer thread.
+
+     @return returns a pointer to the next free slot, or NULL if the queue is full
+     */
+    T* getPushSlot(){
+        const size_t h = head.load( std::memory_order_relaxed );
+        if( h - cachedTail >= capacity ){
+            cachedTail = tail.load( std::memory_order_acquire );
+            if( h - cachedTail >= capacity ) return NULL;
+        }
+        return &data[ h & mask ];
+    }
+
+    /**
+     Publishes the slot returned by the last call to getPushSlot(). This should only be called by the producer thread.
+     */
+    void commitPush(){
+        head.store( head.load( std::memory_order_relaxed )+1, std::memory_order_release );
+    }
+
+    /**
+     Copies the oldest value out of the queue. This should only be called by the consumer thread.
+
+     @param value: the value that will be set to the oldest value in the queue
+     @return returns true if a value was removed from the queue, false if the queue is empty
+     */
+    bool pop(T &value){
+        T *slot = getPopSlot();
+        if( slot == NULL ) return false;
+        value = *slot;
+        commitPop();
+        return true;
+    }
+
+    /**
+     Returns a pointer to the oldest value in the queue, so the consumer can use the value in place. The slot is not
+     released to the producer until commitPop() is called. This should only be called by the consumer thread.
+
+     @return returns a pointer to the oldest value, or NULL if the queue is empty
+     */
+    T* getPopSlot(){
+        const size_t t = tail.load( std::memory_order_relaxed );
+        if( t == cachedHead ){
+            cachedHead = head.load( std::memory_order_acquire );
+            if( t == cachedHead ) return NULL;
+        }
+        return &data[ t & mask ];
+    }
+
+    /**
+     Releases the slot returned by the last call to getPopSlot(). This should only be called by the consumer thread.
+     */
+    void commitPop(){
+        tail.store( tail.load( std::memory_order_relaxed )+1, std::memory_order_release );
+    }
+
+    /**
+     @return returns the number of values currently in the queue (this is only a snapshot if the other thread is active)
+     */
+    size_t getSize() const{
+        return head.load( std::memory_order_acquire ) - tail.load( std::memory_order_acquire );
+    }
+
+    /**
+     @return returns the maximum number of values the queue can hold
+     */
+    size_t getCapacity() const{
+        return capacity;
+    }
+
+    /**
+     @return returns true if the queue is empty (this is only a snapshot if the other thread is active)
+     */
+    bool getIsEmpty() const{
+        return getSize() == 0;
+    }
+
+protected:
+    static size_t roundUpToPowerOfTwo(const size_t value){
+        size_t n = 1;
+        while( n < value ) n <<= 1;
+        return n;
+    }
+
+    enum{ CACHE_LINE_SIZE=64 };
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr< T[] > data;
+
+    //The producer and consumer indices live on separate cache lines, so the two threads do not share a line they write to
+    char padding0[ CACHE_LINE_SIZE ];
+    std::atomic< size_t > head;     //Written by the producer
+    size_t cachedTail;              //The producer's last view of the tail
+    char padding1[ CACHE_LINE_SIZE ];
+    std::atomic< size_t > tail;     //Written by the consumer
+    size_t cachedHead;              //The consumer's last view of the head
+    char padding2[ CACHE_LINE_SIZE ];
+
+private:
+    SPSCQueue(const SPSCQueue &rhs);
+    SPSCQueue& operator=(const SPSCQueue &rhs);
+};
+
+#endif //GRT_CXX11_ENABLED
+
+GRT_END_NAMESPACE
+
+#endif //GRT_SPSC_QUEUE_HEADER
@@ -19,8 +19,32 @@
  */
 #define GRT_DLL_EXPORTS
 #include "SVD.h"
+#include "Lapack.h"
 
 GRT_BEGIN_NAMESPACE
+
+#ifdef GRT_USE_LAPACK
+//Thin SVD using the system LAPACK, for m >= n. The row-major m x n input is the column-major n x m matrix B = A',
+//so if B = Ub S Vb' then A = Vb S Ub'. LAPACK's column-major Vb' is then the row-major U directly, and Ub is V'.
+static bool lapackDecompose(const MatrixFloat &a,MatrixFloat &u,MatrixFloat &v,VectorFloat &w){
+	const int m = (int)a.getNumRows();
+	const int n = (int)a.getNumCols();
+	MatrixFloat b = a;
+	int lwork = -1;
+	int info = 0;
+	Float workSize = 0;
+	u.resize(m,n);
+	v.resize(n,n);
+	grt_lapack_gesvd("S","S",&n,&m,b.getData(),&n,&w[0],v.getData(),&n,u.getData(),&n,&workSize,&lwork,&info);
+	if( info != 0 ) return false;
+	lwork = (int)workSize;
+	VectorFloat work( lwork );
+	grt_lapack_gesvd("S","S",&n,&m,b.getData(),&n,&w[0],v.getData(),&n,u.getData(),&n,&work[0],&lwork,&info);
+	if( info != 0 ) return false;
+	v.transpose();
+	return true;
+}
+#endif
 	
 bool SVD::solve(MatrixFloat &a){
 	
@@ -32,6 +56,16 @@ bool SVD::solve(MatrixFloat &a){
 	w.resize(n);
 	
 	eps = std::numeric_limits< Float >::epsilon();
+#ifdef GRT_USE_LAPACK
+	if( m >= n && n > 0 && lapackDecompose(a,u,v,w) ){
+		//The singular values are already sorted, reorder just applies the same sign convention as the native path
+		if( !reorder() ) return false;
+		tsh = 0.5*grt_sqrt(m+n+1.)*w[0]*eps;
+		return true;
+	}
+	u = a;
+	v.resize(n,n);
+#endif
 	if( !decompose() ) return false;
 	if( !reorder() ) return false;
 	
@@ -124,6 +158,9 @@ bool SVD::decompose() {
 	int i,its,j,jj,k,l,nm,N,M;
 	Float anorm,c,f,g,h,s,scale,x,y,z;
 	VectorFloat rv1(n);
+	VectorFloat tmp(n);
+	Float *ui = NULL;
+	Float *uk = NULL;
 	g = scale = anorm = 0.0;
 	N = int(n);
 	M = int(m);
@@ -143,10 +180,16 @@ bool SVD::decompose() {
 				g = -SIGN(grt_sqrt(s),f);
 				h=f*g-s;
 				u[i][i]=f-g;
-				for (j=l-1;j<N;j++) {
-					for (s=0.0,k=i;k<M;k++) s += u[k][i] * u[k][j];
-					f=s/h;
-					for (k=i;k<M;k++) u[k][j] += f * u[k][i];
+				//Apply the reflection to the trailing columns a row at a time, so the inner loops are contiguous
+				for (j=l-1;j<N;j++) tmp[j] = 0.0;
+				for (k=i;k<M;k++) {
+					uk = u[k];
+					for (j=l-1;j<N;j++) tmp[j] += uk[i] * uk[j];
+				}
+				for (j=l-1;j<N;j++) tmp[j] /= h;
+				for (k=i;k<M;k++) {
+					uk = u[k];
+					for (j=l-1;j<N;j++) uk[j] += tmp[j] * uk[i];
 				}
 				for (k=i;k<M;k++) u[k][i] *= scale; 
 			}
@@ -165,9 +208,11 @@ bool SVD::decompose() {
 				h=f*g-s;
 				u[i][l-1]=f-g;
 				for (k=l-1;k<N;k++) rv1[k]=u[i][k]/h;
+				ui = u[i];
 				for (j=l-1;j<M;j++) {
-					for (s=0.0,k=l-1;k<N;k++) s += u[j][k]*u[i][k];
-					for (k=l-1;k<N;k++) u[j][k] += s*rv1[k];
+					uk = u[j];
+					for (s=0.0,k=l-1;k<N;k++) s += uk[k]*ui[k];
+					for (k=l-1;k<N;k++) uk[k] += s*rv1[k];
 				}
 				for (k=l-1;k<N;k++) u[i][k]*= scale;
 			}
@@ -179,9 +224,15 @@ bool SVD::decompose() {
 			if (g != 0.0) {
 				for (j=l;j<N;j++)
 					v[j][i]=u[i][j]/u[i][l]/g;
-				for (j=l;j<N;j++) {
-					for (s=0.0,k=l;k<N;k++) s += u[i][k]*v[k][j];
-					for (k=l;k<N;k++) v[k][j] += s*v[k][i];
+				ui = u[i];
+				for (j=l;j<N;j++) tmp[j] = 0.0;
+				for (k=l;k<N;k++) {
+					uk = v[k];
+					for (j=l;j<N;j++) tmp[j] += ui[k]*uk[j];
+				}
+				for (k=l;k<N;k++) {
+					uk = v[k];
+					for (j=l;j<N;j++) uk[j] += tmp[j]*uk[i];
 				}
 			}
 			for (j=l;j<N;j++) v[i][j]=v[j][i]=0.0;
@@ -196,15 +247,28 @@ bool SVD::decompose() {
 		for (j=l;j<N;j++) u[i][j]=0.0;
 		if (g != 0.0) {
 			g=1.0/g;
-			for (j=l;j<N;j++) {
-				for (s=0.0,k=l;k<M;k++) s += u[k][i]*u[k][j];
-				f=(s/u[i][i])*g;
-				for (k=i;k<M;k++) u[k][j] += f*u[k][i];
+			for (j=l;j<N;j++) tmp[j] = 0.0;
+			for (k=l;k<M;k++) {
+				uk = u[k];
+				for (j=l;j<N;j++) tmp[j] += uk[i]*uk[j];
+			}
+			for (j=l;j<N;j++) tmp[j] = (tmp[j]/u[i][i])*g;
+			for (k=i;k<M;k++) {
+				uk = u[k];
+				for (j=l;j<N;j++) uk[j] += tmp[j]*uk[i];
 			}
 			for (j=i;j<M;j++) u[j][i] *= g;
 		} else for (j=i;j<M;j++) u[j][i] =0.0;
 		++u[i][i];
 	}
+	
+	//The QR sweeps below rotate pairs of columns of u and v, so run them on the transposes where each column is a contiguous row
+	MatrixFloat ut = u;
+	MatrixFloat vt = v;
+	ut.transpose();
+	vt.transpose();
+	Float *ua = NULL;
+	Float *ub = NULL;
 	for (k=N-1;k>=0;k--) {
 		for (its=0;its<MAX_NUM_SVD_ITER;its++) {
 			flag=true;
@@ -229,11 +293,13 @@ bool SVD::decompose() {
 					h=1.0/h;
 					c=g*h;
 					s = -f*h;
+					ua = ut[nm];
+					ub = ut[i];
 					for (j=0;j<M;j++) {
-						y=u[j][nm];
-						z=u[j][i];
-						u[j][nm]=y*c+z*s;
-						u[j][i]=z*c-y*s;
+						y=ua[j];
+						z=ub[j];
+						ua[j]=y*c+z*s;
+						ub[j]=z*c-y*s;
 					}
 				}
 			}
@@ -241,7 +307,8 @@ bool SVD::decompose() {
 			if (l == k) {
 				if (z < 0.0) {
 					w[k] = -z;
-					for (j=0;j<N;j++) v[j][k] = -v[j][k];
+					ua = vt[k];
+					for (j=0;j<N;j++) ua[j] = -ua[j];
 				}
 				break;
 			}
@@ -271,11 +338,13 @@ bool SVD::decompose() {
 				g=g*c-x*s;
 				h=y*s;
 				y *= c;
+				ua = vt[j];
+				ub = vt[i];
 				for (jj=0;jj<N;jj++) {
-					x=v[jj][j];
-					z=v[jj][i];
-					v[jj][j]=x*c+z*s;
-					v[jj][i]=z*c-x*s;
+					x=ua[jj];
+					z=ub[jj];
+					ua[jj]=x*c+z*s;
+					ub[jj]=z*c-x*s;
 				}
 				z=pythag(f,h);
 				w[j]=z;
@@ -286,11 +355,13 @@ bool SVD::decompose() {
 				}
 				f=c*g+s*y;
 				x=c*y-s*g;
+				ua = ut[j];
+				ub = ut[i];
 				for (jj=0;jj<M;jj++) {
-					y=u[jj][j];
-					z=u[jj][i];
-					u[jj][j]=y*c+z*s;
-					u[jj][i]=z*c-y*s;
+					y=ua[jj];
+					z=ub[jj];
+					ua[jj]=y*c+z*s;
+					ub[jj]=z*c-y*s;
 				}
 			}
 			rv1[l]=0.0;
@@ -299,6 +370,11 @@ bool SVD::decompose() {
 		}
 	}
 	
+	u = ut;
+	v = vt;
+	u.transpose();
+	v.transpose();
+	
 	return true;
 }
 
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 GRT_BEGIN_NAMESPACE
 
-bool TestingLog::testingLoggingEnabled = true;
+Log::LoggingFlag TestingLog::testingLoggingEnabled( true );
 ObserverManager< TestingLogMessage > TestingLog::observerManager;
     
 bool TestingLog::enableLogging(bool loggingEnabled){
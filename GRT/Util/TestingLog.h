@@ -48,7 +48,7 @@ public:
     std::string message;
 };
 
-class GRT_API TestingLog : public Log{
+class GRT_API TestingLog : public LogStream< TestingLog, GRT_LOG_LEVEL_TESTING >{
 public:
     TestingLog(std::string proceedingText =""){ setProceedingText(proceedingText); Log::loggingEnabledPtr = &testingLoggingEnabled; }
 
@@ -57,11 +57,8 @@ public:
     TestingLog& operator=(const TestingLog &rhs){
         if( this != &rhs ){
             this->proceedingText = rhs.proceedingText;
-            this->writeProceedingText = rhs.writeProceedingText;
             this->lastMessage = rhs.lastMessage;
             this->loggingEnabledPtr = &testingLoggingEnabled;
-            this->writeProceedingTextPtr = &writeProceedingText;
-            this->lastMessagePtr = &lastMessage;
         }
         return *this;
     }
@@ -83,7 +80,7 @@ protected:
     }
     
     static ObserverManager< TestingLogMessage > observerManager;
-    static bool testingLoggingEnabled;
+    static LoggingFlag testingLoggingEnabled;
 };
 
 GRT_END_NAMESPACE
@@ -7,6 +7,18 @@ using namespace GRT;
 #ifdef GRT_CXX11_ENABLED
 //Initalize the static thread pool size to the systems suggested thread limit
 std::atomic< unsigned int > ThreadPool::threadPoolSize( std::thread::hardware_concurrency() );
+
+//Set while the current thread is running a parallelFor block, any parallelFor calls made from inside the block are run serially
+static thread_local bool insideParallelBlock = false;
+
+//Flags the current thread as running a parallelFor block, until the guard goes out of scope
+class ParallelBlockGuard{
+public:
+    ParallelBlockGuard() : wasInside( insideParallelBlock ){ insideParallelBlock = true; }
+    ~ParallelBlockGuard(){ insideParallelBlock = wasInside; }
+protected:
+    bool wasInside;
+};
 #endif
 
 ThreadPool::ThreadPool()
@@ -28,7 +40,6 @@ ThreadPool::ThreadPool(const unsigned int poolSize)
 // the destructor joins all threads
 ThreadPool::~ThreadPool()
 {
-std::cout << "~ThreadPool()\n";
 #ifdef GRT_CXX11_ENABLED
     stop = true;
     condition.notify_all();
@@ -38,8 +49,11 @@ std::cout << "~ThreadPool()\n";
 }
 
 #ifdef GRT_CXX11_ENABLED
-void ThreadPool::launchThreads( const unsigned int poolSize ){
+void ThreadPool::launchThreads( const unsigned int poolSize_ ){
     
+    //hardware_concurrency() can return 0 if the value is not computable, so always launch at least one worker
+    const unsigned int poolSize = poolSize_ > 0 ? poolSize_ : 1;
+
     //Start the worker thread, each thread will wait for incoming tasks and pop them off the queue when ready
     for(unsigned int i = 0; i<poolSize; ++i)
         workers.emplace_back(
@@ -55,7 +69,6 @@ void ThreadPool::launchThreads( const unsigned int poolSize ){
                                          this->condition.wait(lock,
                                                               [this]{ return this->stop || !this->tasks.empty(); });
                                          if(this->stop && this->tasks.empty()){
-                                            std::cout << "stopping worker!" << std::endl;
                                             return;
                                          }
                                          task = std::move(this->tasks.front());
@@ -75,6 +88,82 @@ void ThreadPool::launchThreads( const unsigned int poolSize ){
 }
 #endif
 
+#ifdef GRT_CXX11_ENABLED
+ThreadPool& ThreadPool::getSharedThreadPool( const unsigned int minNumThreads ){
+    
+    //The shared pool is never deleted, so it can still be used by static destructors and its threads are not joined at exit
+    static ThreadPool *sharedPool = new ThreadPool( minNumThreads );
+    static std::mutex sharedPoolMutex;
+    
+    //The thread pool size can be increased after the shared pool was created, in which case more workers are started
+    std::unique_lock< std::mutex > lock( sharedPoolMutex );
+    if( sharedPool->workers.size() < minNumThreads ){
+        sharedPool->launchThreads( minNumThreads - (unsigned int)sharedPool->workers.size() );
+    }
+    return *sharedPool;
+}
+#endif
+
+bool ThreadPool::parallelFor( const unsigned int begin, const unsigned int end, const unsigned int minBlockSize, const std::function< bool(const unsigned int,const unsigned int) > &func, const unsigned int maxNumBlocks ){
+    
+    if( begin >= end ) return true;
+    
+    const unsigned int numItems = end - begin;
+    const unsigned int numBlocks = getNumParallelBlocks( numItems, minBlockSize, maxNumBlocks );
+    
+#ifdef GRT_CXX11_ENABLED
+    if( numBlocks > 1 ){
+        //The calling thread runs the first block, so the shared pool only needs a worker for each of the other blocks
+        ThreadPool &pool = getSharedThreadPool( numBlocks-1 );
+        std::vector< std::future< bool > > tasks;
+        tasks.reserve( numBlocks-1 );
+        for(unsigned int b=1; b<numBlocks; b++){
+            const unsigned int blockBegin = begin + (unsigned int)( (unsigned long long)numItems * b / numBlocks );
+            const unsigned int blockEnd = begin + (unsigned int)( (unsigned long long)numItems * (b+1) / numBlocks );
+            tasks.push_back( pool.enqueue( [&func,blockBegin,blockEnd](){
+                ParallelBlockGuard guard;
+                return func( blockBegin, blockEnd );
+            } ) );
+        }
+        
+        //The other blocks can reference the caller's data, so wait for all of them before returning (or rethrowing an exception)
+        bool result = false;
+        std::exception_ptr exception;
+        try{
+            ParallelBlockGuard guard;
+            result = func( begin, begin + (unsigned int)( (unsigned long long)numItems / numBlocks ) );
+        }catch(...){
+            exception = std::current_exception();
+        }
+        for(size_t t=0; t<tasks.size(); t++){
+            try{
+                if( !tasks[t].get() ) result = false;
+            }catch(...){
+                if( !exception ) exception = std::current_exception();
+            }
+        }
+        if( exception ) std::rethrow_exception( exception );
+        return result;
+    }
+#endif
+    
+    return func( begin, end );
+}
+
+unsigned int ThreadPool::getNumParallelBlocks( const unsigned int numItems, const unsigned int minBlockSize, const unsigned int maxNumBlocks ){
+#ifdef GRT_CXX11_ENABLED
+    if( insideParallelBlock ) return 1;
+    
+    unsigned int numBlocks = threadPoolSize;
+    if( maxNumBlocks > 0 && maxNumBlocks < numBlocks ) numBlocks = maxNumBlocks;
+    const unsigned int maxNumBlocksForSize = numItems / (minBlockSize > 0 ? minBlockSize : 1);
+    if( maxNumBlocksForSize < numBlocks ) numBlocks = maxNumBlocksForSize;
+    return numBlocks > 0 ? numBlocks : 1;
+#else
+    return 1;
+#endif
+}
+
 unsigned int ThreadPool::getThreadPoolSize(){
 #ifdef GRT_CXX11_ENABLED
     return threadPoolSize;
@@ -35,6 +35,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <queue>
 #include <stdexcept>
+#include <functional>
 
 #ifdef GRT_CXX11_ENABLED
 #include <memory>
@@ -42,7 +43,6 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <mutex>
 #include <condition_variable>
 #include <future>
-#include <functional>
 #endif //GRT_CXX11_ENABLED
 
 #include "GRTTypedefs.h"
@@ -100,10 +100,41 @@ public:
      */
     static bool setThreadPoolSize( const unsigned int threadPoolSize );
     
+    /**
+     This function runs func over the range [begin end), which is split into contiguous blocks of at least minBlockSize indexes. The blocks
+     are run on a single thread pool that is shared by the whole library and kept alive between calls, so no threads are started or joined
+     per call. The calling thread runs the first block itself, and the function returns once all the blocks have finished.
+     
+     If this function is called from inside a block (for example by a model that is trained in one of the parallel cross validation folds)
+     then the range is run as a single block on the calling thread, so nested parallel code does not oversubscribe the machine. The range is
+     also run as a single block if it is too small to split, or if the GRT is not compiled with GRT_CXX11_ENABLED.
+     
+     @param begin: the first index in the range
+     @param end: one past the last index in the range
+     @param minBlockSize: the minimum number of indexes in each block
+     @param func: the function run for each block, it is given the range [blockBegin blockEnd) of the block and should return true if it succeeded
+     @param maxNumBlocks: the maximum number of blocks, if zero then the thread pool size is used
+     @return returns true if func returned true for every block, false otherwise
+     */
+    static bool parallelFor(const unsigned int begin,const unsigned int end,const unsigned int minBlockSize,const std::function< bool(const unsigned int,const unsigned int) > &func,const unsigned int maxNumBlocks = 0);
+    
+    /**
+     This function returns the number of blocks that parallelFor would split a range of numItems indexes into. Block b covers the indexes
+     [begin + numItems*b/numBlocks, begin + numItems*(b+1)/numBlocks). This is useful if each block needs to store its own result.
+     
+     @param numItems: the number of indexes in the range
+     @param minBlockSize: the minimum number of indexes in each block
+     @param maxNumBlocks: the maximum number of blocks, if zero then the thread pool size is used
+     @return returns the number of blocks, this is always at least 1
+     */
+    static unsigned int getNumParallelBlocks(const unsigned int numItems,const unsigned int minBlockSize,const unsigned int maxNumBlocks = 0);
+    
 protected:
 #ifdef GRT_CXX11_ENABLED
     void launchThreads(const unsigned int threads);
     
+    static ThreadPool& getSharedThreadPool(const unsigned int minNumThreads);
+    
     std::vector< std::thread > workers;
     std::queue< std::function<void()> > tasks;
     
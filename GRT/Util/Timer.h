@@ -38,6 +38,13 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
     #include <sys/time.h>
 #endif
 
+//Include the monotonic clock headers
+#ifdef GRT_CXX11_ENABLED
+    #include <chrono>
+#elif !defined(__GRT_WINDOWS_BUILD__)
+    #include <time.h>
+#endif
+
 GRT_BEGIN_NAMESPACE
 
 class Timer{
@@ -227,6 +234,28 @@ public:
         return 0;
     }
 
+    /**
+    Gets the current time of a monotonic clock in nanoseconds. Unlike getSystemTime(), this clock is not changed if the system time is changed,
+    so it can be used to measure short intervals, such as the latency of a single prediction. The value itself has no meaning, only the
+    difference between two values.
+
+    @return returns the current monotonic time in nanoseconds
+    */
+    static unsigned long long getMonotonicTimeNanoSeconds(){
+#if defined(GRT_CXX11_ENABLED)
+        return (unsigned long long)std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#elif defined(__GRT_WINDOWS_BUILD__)
+        LARGE_INTEGER frequency, counter;
+        QueryPerformanceFrequency( &frequency );
+        QueryPerformanceCounter( &counter );
+        return (unsigned long long)( counter.QuadPart * (1.0e9 / frequency.QuadPart) );
+#else
+        struct timespec now;
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        return (unsigned long long)now.tv_sec*1000000000ULL + (unsigned long long)now.tv_nsec;
+#endif
+    }
+
 protected:
     enum TimerMode {NORMAL_MODE=0,COUNTDOWN_MODE};
     enum TimerState {NOT_RUNNING=0,RUNNING,COUNTDOWN_STATE,PREP_STATE};
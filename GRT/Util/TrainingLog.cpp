@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace GRT{
 
-bool TrainingLog::trainingLoggingEnabled = true;
+Log::LoggingFlag TrainingLog::trainingLoggingEnabled( true );
 ObserverManager< TrainingLogMessage > TrainingLog::observerManager;
     
 bool TrainingLog::enableLogging(bool loggingEnabled){
@@ -48,7 +48,7 @@ public:
     std::string message;
 };
 
-class GRT_API TrainingLog : public Log{
+class GRT_API TrainingLog : public LogStream< TrainingLog, GRT_LOG_LEVEL_TRAINING >{
 public:
     TrainingLog(std::string proceedingText = ""){ setProceedingText(proceedingText); Log::loggingEnabledPtr = &trainingLoggingEnabled; }
 
@@ -57,11 +57,8 @@ public:
     TrainingLog& operator=(const TrainingLog &rhs){
         if( this != &rhs ){
             this->proceedingText = rhs.proceedingText;
-            this->writeProceedingText = rhs.writeProceedingText;
             this->lastMessage = rhs.lastMessage;
             this->loggingEnabledPtr = &trainingLoggingEnabled;
-            this->writeProceedingTextPtr = &writeProceedingText;
-            this->lastMessagePtr = &lastMessage;
         }
         return *this;
     }
@@ -82,7 +79,7 @@ protected:
         return;
     }
     
-    static bool trainingLoggingEnabled;
+    static LoggingFlag trainingLoggingEnabled;
     static ObserverManager< TrainingLogMessage > observerManager;
 };
 
@@ -112,7 +112,7 @@ std::string Util::toString(const bool &b){
     return b ? "1" : "0";
 }
 
-std::string Util::toString(const Float &v){
+std::string Util::toString(const double &v){
 	std::stringstream s;
     s << v;
     return s.str();
@@ -357,6 +357,31 @@ unsigned int Util::getOS(){
 	return OS_UNKNOWN;
 }
     
+unsigned long long Util::getAvailableMemory(){
+#if defined( __GRT_WINDOWS_BUILD__ )
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if( GlobalMemoryStatusEx( &status ) ) return (unsigned long long)status.ullAvailPhys;
+    return 0;
+#endif
+
+#if defined( __GRT_OSX_BUILD__ )
+    const long pages = sysconf( _SC_PHYS_PAGES );
+    const long pageSize = sysconf( _SC_PAGE_SIZE );
+    if( pages <= 0 || pageSize <= 0 ) return 0;
+    return (unsigned long long)pages * (unsigned long long)pageSize;
+#endif
+
+#if defined( __GRT_LINUX_BUILD__ )
+    const long pages = sysconf( _SC_AVPHYS_PAGES );
+    const long pageSize = sysconf( _SC_PAGE_SIZE );
+    if( pages <= 0 || pageSize <= 0 ) return 0;
+    return (unsigned long long)pages * (unsigned long long)pageSize;
+#endif
+
+    return 0;
+}
+
 void Util::cartToPolar(const Float x,const Float y,Float &r, Float &theta){
     
 #ifndef PI
@@ -372,6 +372,15 @@ public:
 	@return unsigned int: the current operating system (which will be one of the Util::OperatingSystems enums)
 	*/
 	static unsigned int getOS();
+
+    /**
+    Gets the amount of physical memory that is currently available on this machine.
+
+    @note on OSX this returns the total physical memory, as the free memory is not exposed via sysconf.
+
+	@return unsigned long long: the available physical memory in bytes, or 0 if it could not be determined
+	*/
+    static unsigned long long getAvailableMemory();
     
     /**
      Converts the cartesian values {x y} into polar values {r theta}
@@ -23,7 +23,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace GRT{
 
-bool WarningLog::warningLoggingEnabled = true;
+Log::LoggingFlag WarningLog::warningLoggingEnabled( true );
 ObserverManager< WarningLogMessage > WarningLog::observerManager;
     
 bool WarningLog::enableLogging(bool loggingEnabled){
@@ -48,7 +48,7 @@ public:
     std::string message;
 };
 
-class GRT_API WarningLog : public GRT::Log{
+class GRT_API WarningLog : public LogStream< WarningLog, GRT_LOG_LEVEL_WARNING >{
 public:
     WarningLog(std::string proceedingText =""){
         setProceedingText(proceedingText);
@@ -60,11 +60,8 @@ public:
     WarningLog& operator=(const WarningLog &rhs){
         if( this != &rhs ){
             this->proceedingText = rhs.proceedingText;
-            this->writeProceedingText = rhs.writeProceedingText;
             this->lastMessage = rhs.lastMessage;
             this->loggingEnabledPtr = &warningLoggingEnabled;
-            this->writeProceedingTextPtr = &writeProceedingText;
-            this->lastMessagePtr = &lastMessage;
         }
         return *this;
     }
@@ -86,7 +83,7 @@ protected:
     }
     
     static ObserverManager< WarningLogMessage > observerManager;
-    static bool warningLoggingEnabled;
+    static LoggingFlag warningLoggingEnabled;
 };
 
 GRT_END_NAMESPACE
@@ -0,0 +1,512 @@
+/**
+ @author Nicholas Gillian <nick@nickgillian.com>
+ @brief This file implements the GRT microbenchmark suite. It times the hot paths of the library (the matrix kernels, the training and
+ prediction functions of the main classifiers, the filters, the feature extraction modules, the pipeline and the data loaders) on
+ synthetic datasets generated with ClassificationData::generateGaussDataset, so runs on different builds or commits can be compared.
+
+ Each benchmark is first run until it takes at least --min-time seconds to find how many iterations to time, then it is timed for
+ --repetitions repetitions of that many iterations. The results (the median, mean, min and max time per iteration in nanoseconds and
+ the number of items processed per second) are written as JSON or CSV to the --output file, or to stdout if the output is set to -.
+
+ The benchmarks are only built if the GRT is configured with -DBUILD_BENCHMARKS=ON, they can then be run with the 'benchmark' target.
+*/
+
+//You might need to set the specific path of the GRT header relative to your project
+#include <GRT/GRT.h>
+using namespace GRT;
+using namespace std;
+
+InfoLog infoLog("[grt-benchmark]");
+WarningLog warningLog("[WARNING grt-benchmark]");
+ErrorLog errorLog("[ERROR grt-benchmark]");
+
+bool printUsage(){
+    infoLog << "grt-benchmark [options]\n";
+    infoLog << "\t--samples: sets the number of samples in the synthetic classification dataset (default 1000)\n";
+    infoLog << "\t--classes: sets the number of classes in the synthetic datasets (default 5)\n";
+    infoLog << "\t--dimensions: sets the number of dimensions of the synthetic datasets and of the filters (default 8)\n";
+    infoLog << "\t--matrix-size: sets the number of rows and columns of the matrices used by the matrix benchmarks (default 64)\n";
+    infoLog << "\t--timeseries-length: sets the length of each timeseries in the synthetic timeseries dataset (default 50)\n";
+    infoLog << "\t--fft-size: sets the window size of the FFT benchmark (default 256)\n";
+    infoLog << "\t--fir-taps: sets the number of taps of the FIR filter benchmark (default 64)\n";
+    infoLog << "\t--min-time: sets the minimum time, in seconds, of each timed repetition (default 0.1)\n";
+    infoLog << "\t--repetitions: sets the number of timed repetitions of each benchmark (default 5)\n";
+    infoLog << "\t--filter: only runs the benchmarks whose name contains this text (default all)\n";
+    infoLog << "\t--format: sets the format of the results, can be json or csv (default json)\n";
+    infoLog << "\t--output: sets the name of the file the results are written to, use - to write them to stdout (default grt-benchmark-results.json or .csv)\n";
+    infoLog << endl;
+    return true;
+}
+
+#ifdef GRT_CXX11_ENABLED
+
+#include <functional>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+//The results of the benchmarks are added to this value, so the compiler can not remove the code being timed
+volatile Float benchmarkSink = 0;
+
+//Used to silence the LIBSVM training messages
+void silentPrint( const char * ){}
+
+//The settings used to generate the synthetic data
+struct BenchmarkSettings{
+    UINT numSamples;
+    UINT numClasses;
+    UINT numDimensions;
+    UINT matrixSize;
+    UINT timeseriesLength;
+    UINT fftSize;
+    UINT firTaps;
+    Float minTime;
+    UINT numRepetitions;
+};
+
+//A single benchmark, the setup function is called once before the benchmark is timed and returns false if the benchmark can not be run.
+//The run function is the code being timed, it is called once per iteration. Each iteration processes itemsPerIteration items (e.g. samples).
+struct Benchmark{
+    string name;
+    UINT itemsPerIteration;
+    std::function< bool() > setup;
+    std::function< void() > run;
+};
+
+struct BenchmarkResult{
+    string name;
+    unsigned long long iterations;
+    UINT repetitions;
+    UINT itemsPerIteration;
+    Float medianTime;
+    Float meanTime;
+    Float minTime;
+    Float maxTime;
+    Float itemsPerSecond;
+};
+
+//Times the benchmark, returns the time per iteration (in nanoseconds) for each repetition
+bool runBenchmark( Benchmark &benchmark, const BenchmarkSettings &settings, BenchmarkResult &result ){
+
+    if( !benchmark.setup() ){
+        errorLog << "Failed to setup benchmark: " << benchmark.name << ", it will be skipped" << endl;
+        return false;
+    }
+
+    //Warm up, then double the number of iterations until they take at least the minimum time
+    benchmark.run();
+    const unsigned long long minTime = (unsigned long long)( settings.minTime * 1.0e9 );
+    unsigned long long iterations = 1;
+    while( true ){
+        const unsigned long long startTime = Timer::getMonotonicTimeNanoSeconds();
+        for(unsigned long long i=0; i<iterations; i++) benchmark.run();
+        const unsigned long long elapsed = Timer::getMonotonicTimeNanoSeconds() - startTime;
+        if( elapsed >= minTime || iterations >= (1ULL << 30) ) break;
+
+        //Jump straight to the expected number of iterations once the time is large enough to be measured
+        if( elapsed > minTime / 10 ){
+            iterations = (unsigned long long)( iterations * 1.2 * minTime / elapsed ) + 1;
+        }else{
+            iterations *= 10;
+        }
+    }
+
+    //Time the repetitions
+    Vector< Float > times( settings.numRepetitions );
+    for(UINT r=0; r<settings.numRepetitions; r++){
+        const unsigned long long startTime = Timer::getMonotonicTimeNanoSeconds();
+        for(unsigned long long i=0; i<iterations; i++) benchmark.run();
+        times[r] = Float( Timer::getMonotonicTimeNanoSeconds() - startTime ) / iterations;
+    }
+
+    Vector< Float > sortedTimes = times;
+    std::sort( sortedTimes.begin(), sortedTimes.end() );
+    const UINT R = sortedTimes.getSize();
+
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.repetitions = R;
+    result.itemsPerIteration = benchmark.itemsPerIteration;
+    result.medianTime = R % 2 == 1 ? sortedTimes[R/2] : (sortedTimes[R/2-1] + sortedTimes[R/2]) / 2.0;
+    result.meanTime = 0;
+    for(UINT r=0; r<R; r++) result.meanTime += sortedTimes[r] / R;
+    result.minTime = sortedTimes[0];
+    result.maxTime = sortedTimes[R-1];
+    result.itemsPerSecond = result.medianTime > 0 ? benchmark.itemsPerIteration * 1.0e9 / result.medianTime : 0;
+
+    return true;
+}
+
+//Generates a timeseries dataset, each class is a noisy sine wave with a different frequency in each dimension
+TimeSeriesClassificationData generateTimeSeriesData( const BenchmarkSettings &settings, const UINT numSamplesPerClass ){
+    TimeSeriesClassificationData data( settings.numDimensions );
+    Random random;
+    MatrixFloat timeseries( settings.timeseriesLength, settings.numDimensions );
+    for(UINT k=0; k<settings.numClasses; k++){
+        for(UINT n=0; n<numSamplesPerClass; n++){
+            for(UINT i=0; i<settings.timeseriesLength; i++){
+                for(UINT j=0; j<settings.numDimensions; j++){
+                    timeseries[i][j] = sin( (k+1) * (j+1) * i * 0.05 ) + random.getRandomNumberGauss( 0, 0.1 );
+                }
+            }
+            data.addSample( k+1, timeseries );
+        }
+    }
+    return data;
+}
+
+//Adds the benchmarks for training a classifier and predicting with it
+void addClassifierBenchmarks( Vector< Benchmark > &benchmarks, const string &name, std::shared_ptr< Classifier > classifier, const ClassificationData &data, const bool benchmarkTraining ){
+
+    std::shared_ptr< UINT > index = std::make_shared< UINT >( 0 );
+
+    if( benchmarkTraining ){
+        Benchmark train;
+        train.name = "classifier/" + name + "/train";
+        train.itemsPerIteration = data.getNumSamples();
+        train.setup = [](){ return true; };
+        train.run = [classifier,&data](){ classifier->train( data ); benchmarkSink = benchmarkSink + classifier->getNumClasses(); };
+        benchmarks.push_back( train );
+    }
+
+    Benchmark predict;
+    predict.name = "classifier/" + name + "/predict";
+    predict.itemsPerIteration = 1;
+    predict.setup = [classifier,&data](){ return classifier->getTrained() || classifier->train( data ); };
+    predict.run = [classifier,&data,index](){
+        classifier->predict( data[ *index ].getSample() );
+        benchmarkSink = benchmarkSink + classifier->getPredictedClassLabel();
+        if( ++(*index) >= data.getNumSamples() ) *index = 0;
+    };
+    benchmarks.push_back( predict );
+}
+
+//Adds a benchmark that filters a random signal with a preprocessing module, one sample per iteration
+void addFilterBenchmark( Vector< Benchmark > &benchmarks, const string &name, std::shared_ptr< PreProcessing > filter, const MatrixFloat &signal ){
+    std::shared_ptr< UINT > index = std::make_shared< UINT >( 0 );
+    Benchmark benchmark;
+    benchmark.name = "filter/" + name;
+    benchmark.itemsPerIteration = 1;
+    benchmark.setup = [filter](){ return filter->reset(); };
+    benchmark.run = [filter,&signal,index](){
+        filter->process( signal.getRow( *index ) );
+        benchmarkSink = benchmarkSink + filter->getProcessedData()[0];
+        if( ++(*index) >= signal.getNumRows() ) *index = 0;
+    };
+    benchmarks.push_back( benchmark );
+}
+
+//Adds a benchmark that computes the features of a random signal with a feature extraction module, one sample per iteration
+void addFeatureBenchmark( Vector< Benchmark > &benchmarks, const string &name, std::shared_ptr< FeatureExtraction > module, const MatrixFloat &signal ){
+    std::shared_ptr< UINT > index = std::make_shared< UINT >( 0 );
+    Benchmark benchmark;
+    benchmark.name = "feature/" + name;
+    benchmark.itemsPerIteration = 1;
+    benchmark.setup = [module](){ return module->reset(); };
+    benchmark.run = [module,&signal,index](){
+        module->computeFeatures( signal.getRow( *index ) );
+        benchmarkSink = benchmarkSink + module->getFeatureVector().getSize();
+        if( ++(*index) >= signal.getNumRows() ) *index = 0;
+    };
+    benchmarks.push_back( benchmark );
+}
+
+void writeResultsAsJSON( ostream &stream, const BenchmarkSettings &settings, const Vector< BenchmarkResult > &results ){
+    stream << "{\n  \"context\": {\"grtVersion\": \"" << GRT_VERSION << "\", \"floatSize\": " << sizeof(Float);
+    stream << ", \"samples\": " << settings.numSamples << ", \"classes\": " << settings.numClasses << ", \"dimensions\": " << settings.numDimensions;
+    stream << ", \"matrixSize\": " << settings.matrixSize << ", \"timeseriesLength\": " << settings.timeseriesLength;
+    stream << ", \"fftSize\": " << settings.fftSize << ", \"firTaps\": " << settings.firTaps << ", \"repetitions\": " << settings.numRepetitions << "},\n";
+    stream << "  \"benchmarks\": [";
+    stream << std::fixed << std::setprecision(1);
+    for(UINT i=0; i<results.getSize(); i++){
+        const BenchmarkResult &r = results[i];
+        stream << (i == 0 ? "\n" : ",\n");
+        stream << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations << ", \"repetitions\": " << r.repetitions;
+        stream << ", \"itemsPerIteration\": " << r.itemsPerIteration << ", \"medianNs\": " << r.medianTime << ", \"meanNs\": " << r.meanTime;
+        stream << ", \"minNs\": " << r.minTime << ", \"maxNs\": " << r.maxTime << ", \"itemsPerSecond\": " << r.itemsPerSecond << "}";
+    }
+    stream << "\n  ]\n}\n";
+}
+
+void writeResultsAsCSV( ostream &stream, const Vector< BenchmarkResult > &results ){
+    stream << "name,iterations,repetitions,items_per_iteration,median_ns,mean_ns,min_ns,max_ns,items_per_second\n";
+    stream << std::fixed << std::setprecision(1);
+    for(UINT i=0; i<results.getSize(); i++){
+        const BenchmarkResult &r = results[i];
+        stream << r.name << "," << r.iterations << "," << r.repetitions << "," << r.itemsPerIteration << "," << r.medianTime << ",";
+        stream << r.meanTime << "," << r.minTime << "," << r.maxTime << "," << r.itemsPerSecond << "\n";
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    //Create an instance of the parser
+    CommandLineParser parser;
+
+    //Disable warning messages
+    parser.setWarningLoggingEnabled( false );
+
+    //Add the options, along with their default values
+    parser.addOption( "--samples", "samples", 1000 );
+    parser.addOption( "--classes", "classes", 5 );
+    parser.addOption( "--dimensions", "dimensions", 8 );
+    parser.addOption( "--matrix-size", "matrix-size", 64 );
+    parser.addOption( "--timeseries-length", "timeseries-length", 50 );
+    parser.addOption( "--fft-size", "fft-size", 256 );
+    parser.addOption( "--fir-taps", "fir-taps", 64 );
+    parser.addOption( "--min-time", "min-time", 0.1 );
+    parser.addOption( "--repetitions", "repetitions", 5 );
+    parser.addOption( "--filter", "filter", string("") );
+    parser.addOption( "--format", "format", string("json") );
+    parser.addOption( "--output", "output", string("") );
+    parser.addOption( "-h", "help" );
+    parser.addOption( "--help", "help" );
+
+    //Parse the command line
+    parser.parse( argc, argv );
+
+    if( parser.getOptionParsed( "help" ) ){
+        printUsage();
+        return EXIT_SUCCESS;
+    }
+
+    BenchmarkSettings settings;
+    string filter = "";
+    string format = "";
+    string outputFilename = "";
+    parser.get( "samples", settings.numSamples );
+    parser.get( "classes", settings.numClasses );
+    parser.get( "dimensions", settings.numDimensions );
+    parser.get( "matrix-size", settings.matrixSize );
+    parser.get( "timeseries-length", settings.timeseriesLength );
+    parser.get( "fft-size", settings.fftSize );
+    parser.get( "fir-taps", settings.firTaps );
+    parser.get( "min-time", settings.minTime );
+    parser.get( "repetitions", settings.numRepetitions );
+    parser.get( "filter", filter );
+    parser.get( "format", format );
+    parser.get( "output", outputFilename );
+
+    if( settings.numSamples < settings.numClasses || settings.numClasses < 2 || settings.numDimensions == 0 || settings.matrixSize == 0 ||
+        settings.timeseriesLength == 0 || settings.fftSize == 0 || settings.firTaps == 0 || settings.numRepetitions == 0 ){
+        errorLog << "Invalid settings, the dataset needs at least 2 classes, as many samples as classes, and all the sizes must be larger than zero!" << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    if( format != "json" && format != "csv" ){
+        errorLog << "Unknown format: " << format << ", the format should be json or csv" << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    if( outputFilename == "" ){
+        outputFilename = "grt-benchmark-results." + format;
+    }
+
+    //Disable the training and warning messages of the modules, so they do not slow down the benchmarks
+    TrainingLog::enableLogging( false );
+    TestingLog::enableLogging( false );
+    WarningLog::enableLogging( false );
+    LIBSVM::svm_set_print_string_function( &silentPrint );
+
+    //Only the results should be written to stdout if they are being written to stdout
+    if( outputFilename == "-" ){
+        infoLog.setEnableInstanceLogging( false );
+    }
+
+    //Generate the synthetic datasets
+    const string gaussDatasetFilename = "grt_benchmark_data.grt";
+    const string gaussDatasetCSVFilename = "grt_benchmark_data.csv";
+    if( !ClassificationData::generateGaussDataset( gaussDatasetFilename, settings.numSamples, settings.numClasses, settings.numDimensions, 10, 1 ) ){
+        errorLog << "Failed to generate the synthetic dataset!" << endl;
+        return EXIT_FAILURE;
+    }
+    ClassificationData data;
+    if( !data.load( gaussDatasetFilename ) || !data.save( gaussDatasetCSVFilename ) ){
+        errorLog << "Failed to load the synthetic dataset!" << endl;
+        return EXIT_FAILURE;
+    }
+
+    const UINT numTimeseriesPerClass = grt_max( settings.numSamples / (settings.numClasses * 20), (UINT)2 );
+    TimeSeriesClassificationData timeseriesData = generateTimeSeriesData( settings, numTimeseriesPerClass );
+
+    Random random;
+    const UINT signalLength = 4096;
+    MatrixFloat signal( signalLength, settings.numDimensions );
+    for(UINT i=0; i<signalLength; i++){
+        for(UINT j=0; j<settings.numDimensions; j++){
+            signal[i][j] = random.getRandomNumberUniform( -1, 1 );
+        }
+    }
+
+    MatrixFloat a( settings.matrixSize, settings.matrixSize );
+    MatrixFloat b( settings.matrixSize, settings.matrixSize );
+    VectorFloat v( settings.matrixSize );
+    for(UINT i=0; i<settings.matrixSize; i++){
+        v[i] = random.getRandomNumberUniform( -1, 1 );
+        for(UINT j=0; j<settings.matrixSize; j++){
+            a[i][j] = random.getRandomNumberUniform( -1, 1 );
+            b[i][j] = random.getRandomNumberUniform( -1, 1 );
+        }
+    }
+
+    Vector< Benchmark > benchmarks;
+    Benchmark benchmark;
+    benchmark.setup = [](){ return true; };
+
+    //Matrix kernels
+    benchmark.name = "matrix/multiple_matrix";
+    benchmark.itemsPerIteration = settings.matrixSize * settings.matrixSize * settings.matrixSize;
+    benchmark.run = [&a,&b](){ MatrixFloat c = a.multiple( b ); benchmarkSink = benchmarkSink + c[0][0]; };
+    benchmarks.push_back( benchmark );
+
+    benchmark.name = "matrix/multiple_vector";
+    benchmark.itemsPerIteration = settings.matrixSize * settings.matrixSize;
+    benchmark.run = [&a,&v](){ VectorFloat c = a.multiple( v ); benchmarkSink = benchmarkSink + c[0]; };
+    benchmarks.push_back( benchmark );
+
+    benchmark.name = "matrix/covariance";
+    benchmark.itemsPerIteration = settings.matrixSize * settings.matrixSize;
+    benchmark.run = [&a](){ MatrixFloat c = a.getCovarianceMatrix(); benchmarkSink = benchmarkSink + c[0][0]; };
+    benchmarks.push_back( benchmark );
+
+    //Classifiers
+    addClassifierBenchmarks( benchmarks, "anbc", std::make_shared< ANBC >(), data, true );
+    addClassifierBenchmarks( benchmarks, "knn", std::make_shared< KNN >( 10 ), data, true );
+    addClassifierBenchmarks( benchmarks, "mindist", std::make_shared< MinDist >(), data, true );
+    addClassifierBenchmarks( benchmarks, "gmm", std::make_shared< GMM >( 2 ), data, true );
+    addClassifierBenchmarks( benchmarks, "softmax", std::make_shared< Softmax >(), data, true );
+    addClassifierBenchmarks( benchmarks, "svm", std::make_shared< SVM >(), data, true );
+    addClassifierBenchmarks( benchmarks, "decision_tree", std::make_shared< DecisionTree >(), data, true );
+    addClassifierBenchmarks( benchmarks, "random_forests", std::make_shared< RandomForests >( DecisionTreeClusterNode(), 10 ), data, true );
+
+    //DTW, the training and prediction both run the DTW distance between the timeseries
+    std::shared_ptr< DTW > dtw = std::make_shared< DTW >();
+    std::shared_ptr< UINT > dtwIndex = std::make_shared< UINT >( 0 );
+    benchmark.name = "classifier/dtw/train";
+    benchmark.itemsPerIteration = timeseriesData.getNumSamples();
+    benchmark.setup = [](){ return true; };
+    benchmark.run = [dtw,&timeseriesData](){ dtw->train( timeseriesData ); benchmarkSink = benchmarkSink + dtw->getNumClasses(); };
+    benchmarks.push_back( benchmark );
+
+    benchmark.name = "classifier/dtw/predict";
+    benchmark.itemsPerIteration = 1;
+    benchmark.setup = [dtw,&timeseriesData](){ return dtw->getTrained() || dtw->train( timeseriesData ); };
+    benchmark.run = [dtw,&timeseriesData,dtwIndex](){
+        MatrixFloat timeseries = timeseriesData[ *dtwIndex ].getData();
+        dtw->predict( timeseries );
+        benchmarkSink = benchmarkSink + dtw->getPredictedClassLabel();
+        if( ++(*dtwIndex) >= timeseriesData.getNumSamples() ) *dtwIndex = 0;
+    };
+    benchmarks.push_back( benchmark );
+
+    //Filters
+    const UINT N = settings.numDimensions;
+    addFilterBenchmark( benchmarks, "moving_average", std::make_shared< MovingAverageFilter >( 10, N ), signal );
+    addFilterBenchmark( benchmarks, "double_moving_average", std::make_shared< DoubleMovingAverageFilter >( 10, N ), signal );
+    addFilterBenchmark( benchmarks, "low_pass", std::make_shared< LowPassFilter >( 0.1, 1, N ), signal );
+    addFilterBenchmark( benchmarks, "high_pass", std::make_shared< HighPassFilter >( 0.1, 1, N ), signal );
+    addFilterBenchmark( benchmarks, "median", std::make_shared< MedianFilter >( 11, N ), signal );
+    addFilterBenchmark( benchmarks, "savitzky_golay", std::make_shared< SavitzkyGolayFilter >( 10, 10, 0, 2, N ), signal );
+    addFilterBenchmark( benchmarks, "fir", std::make_shared< FIRFilter >( FIRFilter::LPF, settings.firTaps, 100, 10, 1, N ), signal );
+
+    //FIR block filtering, this filters the complete signal per iteration
+    std::shared_ptr< FIRFilter > firBlock = std::make_shared< FIRFilter >( FIRFilter::LPF, settings.firTaps, 100, 10, 1, N );
+    benchmark.name = "filter/fir_block";
+    benchmark.itemsPerIteration = signal.getNumRows();
+    benchmark.setup = [firBlock](){ return firBlock->reset(); };
+    benchmark.run = [firBlock,&signal](){
+        MatrixFloat filtered = firBlock->filter( signal );
+        benchmarkSink = benchmarkSink + filtered[0][0];
+    };
+    benchmarks.push_back( benchmark );
+
+    //Feature extraction
+    addFeatureBenchmark( benchmarks, "fft", std::make_shared< FFT >( settings.fftSize, 1, N, FFT::HAMMING_WINDOW, true, false ), signal );
+    addFeatureBenchmark( benchmarks, "time_domain_features", std::make_shared< TimeDomainFeatures >( 100, 5, N ), signal );
+    addFeatureBenchmark( benchmarks, "zero_crossing_counter", std::make_shared< ZeroCrossingCounter >( 20, 0.01, N ), signal );
+    addFeatureBenchmark( benchmarks, "movement_index", std::make_shared< MovementIndex >( 100, N ), signal );
+
+    //Pipeline
+    std::shared_ptr< GestureRecognitionPipeline > pipeline = std::make_shared< GestureRecognitionPipeline >();
+    std::shared_ptr< UINT > pipelineIndex = std::make_shared< UINT >( 0 );
+    benchmark.name = "pipeline/predict";
+    benchmark.itemsPerIteration = 1;
+    benchmark.setup = [pipeline,&data](){
+        *pipeline << MovingAverageFilter( 5, data.getNumDimensions() );
+        *pipeline << KNN( 10 );
+        *pipeline << ClassLabelFilter( 3, 5 );
+        return pipeline->train( data );
+    };
+    benchmark.run = [pipeline,&data,pipelineIndex](){
+        pipeline->predict( data[ *pipelineIndex ].getSample() );
+        benchmarkSink = benchmarkSink + pipeline->getPredictedClassLabel();
+        if( ++(*pipelineIndex) >= data.getNumSamples() ) *pipelineIndex = 0;
+    };
+    benchmarks.push_back( benchmark );
+
+    //Data loaders
+    benchmark.setup = [](){ return true; };
+    benchmark.itemsPerIteration = data.getNumSamples();
+    benchmark.name = "data/classification_data/load_grt";
+    benchmark.run = [&gaussDatasetFilename](){ ClassificationData d; d.load( gaussDatasetFilename ); benchmarkSink = benchmarkSink + d.getNumSamples(); };
+    benchmarks.push_back( benchmark );
+
+    benchmark.name = "data/classification_data/load_csv";
+    benchmark.run = [&gaussDatasetCSVFilename](){ ClassificationData d; d.load( gaussDatasetCSVFilename ); benchmarkSink = benchmarkSink + d.getNumSamples(); };
+    benchmarks.push_back( benchmark );
+
+    benchmark.name = "data/classification_data/save_grt";
+    benchmark.run = [&data](){ benchmarkSink = benchmarkSink + data.save( "grt_benchmark_save.grt" ); };
+    benchmarks.push_back( benchmark );
+
+    //Run the benchmarks
+    Vector< BenchmarkResult > results;
+    UINT numFailedBenchmarks = 0;
+    for(UINT i=0; i<benchmarks.getSize(); i++){
+        if( filter != "" && benchmarks[i].name.find( filter ) == string::npos ) continue;
+
+        infoLog << "Running " << benchmarks[i].name << endl;
+        BenchmarkResult result;
+        if( !runBenchmark( benchmarks[i], settings, result ) ){
+            numFailedBenchmarks++;
+            continue;
+        }
+        results.push_back( result );
+    }
+
+    //Write the results
+    if( outputFilename == "-" ){
+        if( format == "json" ) writeResultsAsJSON( cout, settings, results );
+        else writeResultsAsCSV( cout, results );
+    }else{
+        std::fstream file( outputFilename.c_str(), std::ios::out );
+        if( !file.is_open() ){
+            errorLog << "Failed to open output file: " << outputFilename << endl;
+            return EXIT_FAILURE;
+        }
+        if( format == "json" ) writeResultsAsJSON( file, settings, results );
+        else writeResultsAsCSV( file, results );
+        file.close();
+        infoLog << "Results saved to: " << outputFilename << endl;
+    }
+
+    if( numFailedBenchmarks > 0 ){
+        errorLog << numFailedBenchmarks << " benchmarks failed to run!" << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(int argc, char * argv[])
+{
+    errorLog << "grt-benchmark requires the GRT to be built with C++11 support (ENABLE_CXX11_SUPPORT)" << endl;
+    printUsage();
+    return EXIT_FAILURE;
+}
+
+#endif //GRT_CXX11_ENABLED
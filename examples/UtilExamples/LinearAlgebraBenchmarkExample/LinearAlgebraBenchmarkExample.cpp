@@ -0,0 +1,81 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+ and associated documentation files (the "Software"), to deal in the Software without restriction, 
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial 
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ GRT Util Example.
+ 
+ This example benchmarks the GRT linear algebra classes (EigenvalueDecomposition, SVD, LUDecomposition and Cholesky)
+ for square matrices of size 16, 32, ... up to a maximum size (2048 by default). Each decomposition is repeated until
+ at least minTime milliseconds have elapsed and the average time per call is printed as a tab separated table.
+ 
+ Build the GRT with the USE_LAPACK CMake option to compare the native code against the system LAPACK.
+ 
+ Usage: LinearAlgebraBenchmarkExample [maxSize] [minTime]
+*/
+
+//You might need to set the specific path of the GRT header relative to your project
+#include <GRT/GRT.h>
+using namespace GRT;
+using namespace std;
+
+//Runs the function until minTime milliseconds have elapsed and returns the average time per call in milliseconds
+template< class Func >
+double benchmark( Func func, const unsigned long minTime ){
+	Timer timer;
+	unsigned long numCalls = 0;
+	timer.start();
+	do{
+		func();
+		numCalls++;
+	}while( (unsigned long)timer.getMilliSeconds() < minTime );
+	return timer.getMilliSeconds() / double(numCalls);
+}
+
+int main (int argc, const char * argv[])
+{
+	const UINT maxSize = argc > 1 ? (UINT)atoi( argv[1] ) : 2048;
+	const unsigned long minTime = argc > 2 ? (unsigned long)atol( argv[2] ) : 500;
+	
+	Random random;
+	
+	cout << "size\teigen\tsvd\tlu\tcholesky" << endl;
+	
+	for(UINT N=16; N<=maxSize; N*=2){
+		
+		//Create a random matrix and a symmetric positive definite matrix from it
+		MatrixFloat a(N,N);
+		for(UINT i=0; i<N; i++)
+			for(UINT j=0; j<N; j++)
+				a[i][j] = random.getRandomNumberUniform(-1.0,1.0);
+		
+		MatrixFloat s(N,N);
+		s.multiple( a, a, true );
+		for(UINT i=0; i<N; i++) s[i][i] += N;
+		
+		const double eigenTime = benchmark( [&](){ EigenvalueDecomposition eig; eig.decompose( s ); }, minTime );
+		const double svdTime = benchmark( [&](){ SVD svd; svd.solve( a ); }, minTime );
+		const double luTime = benchmark( [&](){ LUDecomposition lu( a ); }, minTime );
+		const double cholTime = benchmark( [&](){ Cholesky chol( s ); }, minTime );
+		
+		cout << N << "\t" << eigenTime << "\t" << svdTime << "\t" << luTime << "\t" << cholTime << endl;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -60,6 +60,137 @@ TEST(AdaBoost, TrainBasicDataset) {
 
 }
 
+// Tests the DecisionStump finds the exact best weighted split
+TEST(AdaBoost, DecisionStumpFindsBestSplit) {
+
+  Random random;
+  const UINT numSamples = 200;
+  const UINT numDimensions = 5;
+  ClassificationData data;
+  data.setNumDimensions( numDimensions );
+  VectorFloat weights( numSamples );
+  for(UINT i=0; i<numSamples; i++){
+    VectorFloat x( numDimensions );
+    for(UINT j=0; j<numDimensions; j++) x[j] = random.getRandomNumberInt( 0, 20 ) / 20.0; //Repeated values
+    const UINT label = x[2] + random.getRandomNumberGauss( 0, 0.2 ) > 0.5 ? WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL : WEAK_CLASSIFIER_NEGATIVE_CLASS_LABEL;
+    data.addSample( label, x );
+    weights[i] = random.getRandomNumberUniform( 0.1, 1.0 );
+  }
+
+  auto weightedError = [&]( DecisionStump &stump ){
+    Float e = 0;
+    for(UINT i=0; i<numSamples; i++){
+      const bool positive = data[i].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
+      if( (stump.predict( data[i].getSample() ) == 1) != positive ) e += weights[i];
+    }
+    return e;
+  };
+
+  DecisionStump stump;
+  EXPECT_TRUE( stump.train( data, weights ) );
+  EXPECT_TRUE( stump.getTrained() );
+  const Float error = weightedError( stump );
+
+  //No threshold on any feature should beat the trained stump
+  for(UINT j=0; j<numDimensions; j++){
+    for(UINT i=0; i<numSamples; i++){
+      for(UINT dir=0; dir<2; dir++){
+        Float e = 0;
+        for(UINT n=0; n<numSamples; n++){
+          const bool positive = data[n].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
+          const bool predicted = dir == 1 ? data[n][j] >= data[i][j] : data[n][j] <= data[i][j];
+          if( predicted != positive ) e += weights[n];
+        }
+        EXPECT_TRUE( error <= e + 1.0e-9 );
+      }
+    }
+  }
+
+  //The stump should give the same result when the sort orders are prepared up front
+  DecisionStump preparedStump;
+  EXPECT_TRUE( preparedStump.prepareTrainingData( data ) );
+  EXPECT_TRUE( preparedStump.train( data, weights ) );
+  EXPECT_EQ( preparedStump.getDecisionFeatureIndex(), stump.getDecisionFeatureIndex() );
+  EXPECT_EQ( preparedStump.getDirection(), stump.getDirection() );
+  EXPECT_EQ( preparedStump.getDecisionValue(), stump.getDecisionValue() );
+  EXPECT_TRUE( preparedStump.clearTrainingData() );
+}
+
+// Tests the DecisionStump finds the same split when it searches the features in parallel and when it is limited to one thread
+TEST(AdaBoost, DecisionStumpThreadLimit) {
+
+  Random random;
+  const UINT numSamples = 2000;
+  const UINT numDimensions = 20;
+  ClassificationData data;
+  data.setNumDimensions( numDimensions );
+  VectorFloat weights( numSamples, 1.0 / numSamples );
+  for(UINT i=0; i<numSamples; i++){
+    VectorFloat x( numDimensions );
+    for(UINT j=0; j<numDimensions; j++) x[j] = random.getRandomNumberUniform( 0, 1 );
+    const UINT label = x[13] + random.getRandomNumberGauss( 0, 0.2 ) > 0.5 ? WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL : WEAK_CLASSIFIER_NEGATIVE_CLASS_LABEL;
+    data.addSample( label, x );
+  }
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  DecisionStump parallelStump;
+  EXPECT_EQ( parallelStump.getMaxNumTrainingThreads(), 0 );
+  EXPECT_TRUE( parallelStump.train( data, weights ) );
+
+  DecisionStump serialStump;
+  EXPECT_TRUE( serialStump.setMaxNumTrainingThreads( 1 ) );
+  EXPECT_TRUE( serialStump.train( data, weights ) );
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  EXPECT_EQ( serialStump.getDecisionFeatureIndex(), parallelStump.getDecisionFeatureIndex() );
+  EXPECT_EQ( serialStump.getDirection(), parallelStump.getDirection() );
+  EXPECT_EQ( serialStump.getDecisionValue(), parallelStump.getDecisionValue() );
+
+  //Copies should keep the thread limit
+  DecisionStump copy;
+  EXPECT_TRUE( copy.deepCopyFrom( &serialStump ) );
+  EXPECT_EQ( copy.getMaxNumTrainingThreads(), 1 );
+}
+
+// Tests the classes trained in parallel give the same model as the classes trained one at a time
+TEST(AdaBoost, ParallelTrainingMatchesSerial) {
+
+  const UINT numSamples = 1000;
+  const UINT numClasses = 5;
+  const UINT numDimensions = 10;
+  ClassificationData::generateGaussDataset( "gauss_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData trainingData;
+  EXPECT_TRUE( trainingData.load( "gauss_data.csv" ) );
+  ClassificationData testData = trainingData.split( 50 );
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+
+  AdaBoost serial( DecisionStump(), true, false, 10.0, 50 );
+  ThreadPool::setThreadPoolSize( 1 );
+  ClassificationData serialData( trainingData );
+  EXPECT_TRUE( serial.train( serialData ) );
+
+  AdaBoost parallel( DecisionStump(), true, false, 10.0, 50 );
+  ThreadPool::setThreadPoolSize( 4 );
+  ClassificationData parallelData( trainingData );
+  EXPECT_TRUE( parallel.train( parallelData ) );
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  EXPECT_EQ( serial.getTrainingResults().getSize(), parallel.getTrainingResults().getSize() );
+
+  UINT numCorrect = 0;
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( serial.predict( testData[i].getSample() ) );
+    EXPECT_TRUE( parallel.predict( testData[i].getSample() ) );
+    EXPECT_EQ( serial.getPredictedClassLabel(), parallel.getPredictedClassLabel() );
+    EXPECT_EQ( serial.getMaximumLikelihood(), parallel.getMaximumLikelihood() );
+    if( parallel.getPredictedClassLabel() == testData[i].getClassLabel() ) numCorrect++;
+  }
+  EXPECT_TRUE( numCorrect > testData.getNumSamples() * 0.9 );
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
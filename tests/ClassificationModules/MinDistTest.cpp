@@ -62,6 +62,118 @@ TEST(MinDist, TrainBasicDataset) {
 
 }
 
+// Tests that the packed centres give the same distances as the individual class models
+TEST(MinDist, PackedCentresMatchModels) {
+
+  MinDist md(false,false,10.0,5);
+
+  const UINT numSamples = 500;
+  const UINT numClasses = 4;
+  const UINT numDimensions = 7;
+  ClassificationData::generateGaussDataset( "gauss_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData trainingData;
+  EXPECT_TRUE( trainingData.load( "gauss_data.csv" ) );
+  ClassificationData testData = trainingData.split( 50 );
+
+  EXPECT_TRUE( md.train( trainingData ) );
+
+  //Check the packed centres contain every centre of every model
+  Vector< MinDistModel > models = md.getModels();
+  const MatrixFloat &packedCentres = md.getPackedCentres();
+  EXPECT_EQ( packedCentres.getNumRows(), numDimensions );
+  EXPECT_EQ( packedCentres.getNumCols(), numClasses*5 );
+
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    const VectorFloat x = testData[i].getSample();
+    EXPECT_TRUE( md.predict( x ) );
+    const VectorFloat classDistances = md.getClassDistances();
+    EXPECT_EQ( classDistances.getSize(), numClasses );
+    for(UINT k=0; k<numClasses; k++){
+      EXPECT_NEAR( classDistances[k], models[k].predict( x ), 1.0e-9 );
+    }
+  }
+}
+
+// Tests the incremental update of a trained model
+TEST(MinDist, Update) {
+
+  MinDist md(true,true,10.0,3);
+
+  const UINT numSamples = 600;
+  const UINT numClasses = 3;
+  const UINT numDimensions = 4;
+  ClassificationData::generateGaussDataset( "gauss_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData trainingData;
+  EXPECT_TRUE( trainingData.load( "gauss_data.csv" ) );
+  ClassificationData updateData = trainingData.split( 50 );
+
+  //The model must be trained before it can be updated
+  EXPECT_FALSE( md.update( updateData[0].getSample(), updateData[0].getClassLabel() ) );
+
+  EXPECT_TRUE( md.train( trainingData ) );
+
+  UINT numTrainingSamples = 0;
+  Vector< MinDistModel > models = md.getModels();
+  for(UINT k=0; k<models.getSize(); k++){
+    Vector< UINT > counts = models[k].getClusterCounts();
+    EXPECT_EQ( counts.getSize(), 3 );
+    for(UINT i=0; i<counts.getSize(); i++) numTrainingSamples += counts[i];
+  }
+  EXPECT_EQ( numTrainingSamples, trainingData.getNumSamples() );
+
+  //Add the remaining samples one at a time
+  const MatrixFloat centresBefore = md.getPackedCentres();
+  for(UINT i=0; i<updateData.getNumSamples(); i++){
+    EXPECT_TRUE( md.update( updateData[i].getSample(), updateData[i].getClassLabel() ) );
+  }
+
+  //Unknown classes and samples with the wrong size should be rejected
+  EXPECT_FALSE( md.update( updateData[0].getSample(), 1000 ) );
+  EXPECT_FALSE( md.update( VectorFloat(numDimensions+1,0), updateData[0].getClassLabel() ) );
+
+  //The packed centres should have moved, and should still match the class models
+  models = md.getModels();
+  const MatrixFloat &centres = md.getPackedCentres();
+  Float change = 0;
+  UINT numUpdatedSamples = 0;
+  UINT column = 0;
+  for(UINT k=0; k<models.getSize(); k++){
+    const MatrixFloat clusters = models[k].getClusters();
+    Vector< UINT > counts = models[k].getClusterCounts();
+    for(UINT i=0; i<clusters.getNumRows(); i++){
+      numUpdatedSamples += counts[i];
+      for(UINT n=0; n<numDimensions; n++){
+        EXPECT_EQ( centres[n][column], clusters[i][n] );
+        change += fabs( centres[n][column] - centresBefore[n][column] );
+      }
+      column++;
+    }
+    EXPECT_EQ( md.getNullRejectionThresholds()[k], models[k].getRejectionThreshold() );
+  }
+  EXPECT_GT( change, 0 );
+  EXPECT_EQ( numUpdatedSamples, numSamples );
+
+  //The updated model should still classify the data it was updated with
+  UINT numCorrect = 0;
+  for(UINT i=0; i<updateData.getNumSamples(); i++){
+    EXPECT_TRUE( md.predict( updateData[i].getSample() ) );
+    if( md.getPredictedClassLabel() == updateData[i].getClassLabel() ) numCorrect++;
+  }
+  EXPECT_GT( numCorrect, updateData.getNumSamples() * 0.9 );
+
+  //The cluster counts should be saved with the model
+  EXPECT_TRUE( md.save( "min_dist_model.grt" ) );
+  MinDist loaded;
+  EXPECT_TRUE( loaded.load( "min_dist_model.grt" ) );
+  Vector< MinDistModel > loadedModels = loaded.getModels();
+  EXPECT_EQ( loadedModels.getSize(), models.getSize() );
+  for(UINT k=0; k<loadedModels.getSize(); k++){
+    EXPECT_EQ( loadedModels[k].getClusterCounts(), models[k].getClusterCounts() );
+  }
+  EXPECT_EQ( loaded.getPackedCentres().getNumCols(), centres.getNumCols() );
+  EXPECT_TRUE( loaded.update( updateData[0].getSample(), updateData[0].getClassLabel() ) );
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -60,6 +60,43 @@ TEST(SVM, TrainBasicDataset) {
 
 }
 
+// Tests the C/gamma grid search
+TEST(SVM, TrainWithGridSearch) {
+  
+  SVM svm( SVM::RBF_KERNEL );
+
+  //Generate a basic dataset
+  const UINT numSamples = 300;
+  const UINT numClasses = 3;
+  const UINT numDimensions = 5;
+  ClassificationData trainingData;
+  ClassificationData::generateGaussDataset( "gauss_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  EXPECT_TRUE( trainingData.load( "gauss_data.csv" ) );
+
+  VectorFloat cValues(3);
+  cValues[0] = 0.1; cValues[1] = 1.0; cValues[2] = 10.0;
+  VectorFloat gammaValues(2);
+  gammaValues[0] = 0.1; gammaValues[1] = 1.0;
+
+  EXPECT_TRUE( svm.setGridSearchRange( cValues, gammaValues ) );
+  EXPECT_TRUE( svm.setKFoldCrossValidationValue( 5 ) );
+  EXPECT_TRUE( svm.enableGridSearch( true ) );
+  EXPECT_TRUE( svm.getIsGridSearchEnabled() );
+
+  //Train the classifier, the best grid point should be used for the final model
+  EXPECT_TRUE( svm.train( trainingData ) );
+  EXPECT_TRUE( svm.getTrained() );
+  EXPECT_TRUE( svm.getC() == Float(0.1) || svm.getC() == 1.0 || svm.getC() == 10.0 );
+  EXPECT_TRUE( svm.getGamma() == Float(0.1) || svm.getGamma() == 1.0 );
+  EXPECT_GT( svm.getCrossValidationResult(), 0.0 );
+
+  //Invalid grid values should be rejected
+  EXPECT_FALSE( svm.setGridSearchRange( VectorFloat(), gammaValues ) );
+  EXPECT_FALSE( svm.setKernelCacheSize( -1 ) );
+  EXPECT_TRUE( svm.setKernelCacheSize( 50 ) );
+  EXPECT_EQ( svm.getKernelCacheSize(), 50 );
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -1,5 +1,6 @@
 #include <GRT.h>
 #include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
 using namespace GRT;
 
 //Unit tests for the GRT Softmax module
@@ -62,6 +63,60 @@ TEST(Softmax, TrainBasicDataset) {
 
 }
 
+// Tests both training methods reach a good accuracy, and the model gives the same predictions after it is saved and loaded
+TEST(Softmax, TrainingMethods) {
+
+  const UINT numSamples = 1000;
+  const UINT numClasses = 5;
+  const UINT numDimensions = 10;
+  ClassificationData::generateGaussDataset( "gauss_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData data;
+  EXPECT_TRUE( data.load( "gauss_data.csv" ) );
+  ClassificationData testData = data.split( 50 );
+
+  for(UINT method=Softmax::MINI_BATCH_GRADIENT_DESCENT; method<=Softmax::LIMITED_MEMORY_BFGS; method++){
+    Softmax sm( true, 0.1, 1.0e-10, 200 );
+    EXPECT_TRUE( sm.setTrainingMethod( method ) );
+    EXPECT_TRUE( sm.setRegularizationCoeff( 1.0e-4 ) );
+    EXPECT_EQ( sm.getTrainingMethod(), method );
+
+    ClassificationData trainingData( data );
+    EXPECT_TRUE( sm.train( trainingData ) );
+    EXPECT_TRUE( sm.getTrained() );
+
+    //The training loss should go down
+    Vector< TrainingResult > results = sm.getTrainingResults();
+    EXPECT_TRUE( results.getSize() > 1 );
+    EXPECT_TRUE( results.back().getAccuracy() < results.front().getAccuracy() );
+
+    MatrixFloat weights = sm.getWeights();
+    EXPECT_EQ( weights.getNumRows(), numDimensions+1 );
+    EXPECT_EQ( weights.getNumCols(), numClasses );
+
+    UINT numCorrect = 0;
+    VectorFloat predictions( testData.getNumSamples() );
+    for(UINT i=0; i<testData.getNumSamples(); i++){
+      EXPECT_TRUE( sm.predict( testData[i].getSample() ) );
+      VectorFloat likelihoods = sm.getClassLikelihoods();
+      Float sum = 0;
+      for(UINT k=0; k<likelihoods.getSize(); k++) sum += likelihoods[k];
+      EXPECT_NEAR( sum, 1.0, tolerance( 1.0e-9 ) );
+      predictions[i] = sm.getMaximumLikelihood();
+      if( sm.getPredictedClassLabel() == testData[i].getClassLabel() ) numCorrect++;
+    }
+    EXPECT_TRUE( numCorrect > testData.getNumSamples() * 0.9 );
+
+    EXPECT_TRUE( sm.save( "sm_model.grt" ) );
+    Softmax loaded;
+    EXPECT_TRUE( loaded.load( "sm_model.grt" ) );
+    for(UINT i=0; i<testData.getNumSamples(); i++){
+      EXPECT_TRUE( loaded.predict( testData[i].getSample() ) );
+      EXPECT_NEAR( loaded.getMaximumLikelihood(), predictions[i], 1.0e-4 );
+    }
+  }
+
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -0,0 +1,108 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT HierarchicalClustering module
+
+//Checks the samples of the single cluster created at the given level
+void checkLevel( const Vector< ClusterLevel > &levels, const UINT level, const UINT uniqueClusterID, const Vector< UINT > &expectedIndexs ){
+  ASSERT_EQ( levels[level].getNumClusters(), 1 );
+  const ClusterInfo cluster = levels[level][0];
+  EXPECT_EQ( cluster.getUniqueClusterID(), uniqueClusterID );
+  ASSERT_EQ( cluster.getNumSamplesInCluster(), expectedIndexs.getSize() );
+  for(UINT i=0; i<expectedIndexs.getSize(); i++){
+    EXPECT_EQ( cluster[i], expectedIndexs[i] );
+  }
+}
+
+// Tests the merge order on a small 1D dataset
+TEST(HierarchicalClustering, MergeOrder) {
+  MatrixFloat data(4,1);
+  data[0][0] = 0;
+  data[1][0] = 1;
+  data[2][0] = 3;
+  data[3][0] = 7;
+
+  HierarchicalClustering hc;
+  EXPECT_TRUE( hc.train_( data ) );
+  EXPECT_TRUE( hc.getTrained() );
+
+  Vector< ClusterLevel > levels = hc.getClusters();
+  ASSERT_EQ( levels.getSize(), 4 );
+  EXPECT_EQ( levels[0].getNumClusters(), 4 );
+
+  //The existing clusters come before any newly merged cluster, so each merged cluster lists the older cluster's samples first
+  Vector< UINT > level1(2);
+  level1[0] = 0; level1[1] = 1;
+  checkLevel( levels, 1, 4, level1 );
+
+  Vector< UINT > level2(3);
+  level2[0] = 2; level2[1] = 0; level2[2] = 1;
+  checkLevel( levels, 2, 5, level2 );
+
+  Vector< UINT > level3(4);
+  level3[0] = 3; level3[1] = 2; level3[2] = 0; level3[3] = 1;
+  checkLevel( levels, 3, 6, level3 );
+}
+
+// Tests that tied distances are merged in the order of the clusters
+TEST(HierarchicalClustering, TiedDistances) {
+  MatrixFloat data(4,2);
+  data[0][0] = 5; data[0][1] = 5;
+  data[1][0] = 0; data[1][1] = 0;
+  data[2][0] = 5; data[2][1] = 5;
+  data[3][0] = 0; data[3][1] = 0;
+
+  HierarchicalClustering hc;
+  EXPECT_TRUE( hc.train_( data ) );
+
+  Vector< ClusterLevel > levels = hc.getClusters();
+  ASSERT_EQ( levels.getSize(), 4 );
+
+  Vector< UINT > level1(2);
+  level1[0] = 0; level1[1] = 2;
+  checkLevel( levels, 1, 4, level1 );
+
+  Vector< UINT > level2(2);
+  level2[0] = 1; level2[1] = 3;
+  checkLevel( levels, 2, 5, level2 );
+
+  Vector< UINT > level3(4);
+  level3[0] = 0; level3[1] = 2; level3[2] = 1; level3[3] = 3;
+  checkLevel( levels, 3, 6, level3 );
+}
+
+// Tests that a larger dataset is merged into a single cluster, one merge per level
+TEST(HierarchicalClustering, TrainLargeDataset) {
+  const UINT M = 2000;
+  const UINT N = 3;
+  Random random;
+  MatrixFloat data(M,N);
+  for(UINT i=0; i<M; i++)
+    for(UINT j=0; j<N; j++)
+      data[i][j] = (i % 4) * 10.0 + random.getRandomNumberGauss();
+
+  HierarchicalClustering hc;
+  EXPECT_TRUE( hc.train_( data ) );
+
+  Vector< ClusterLevel > levels = hc.getClusters();
+  ASSERT_EQ( levels.getSize(), M );
+  for(UINT k=1; k<M; k++){
+    EXPECT_EQ( levels[k].getLevel(), k );
+    EXPECT_EQ( levels[k].getNumClusters(), 1 );
+  }
+
+  //The last level should contain every sample exactly once
+  const ClusterInfo last = levels[M-1][0];
+  ASSERT_EQ( last.getNumSamplesInCluster(), M );
+  Vector< bool > found( M, false );
+  for(UINT i=0; i<M; i++){
+    EXPECT_FALSE( found[ last[i] ] );
+    found[ last[i] ] = true;
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
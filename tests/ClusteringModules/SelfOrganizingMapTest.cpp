@@ -0,0 +1,88 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT SelfOrganizingMap module
+
+//Builds a dataset with numClusters well separated clusters along the diagonal
+MatrixFloat generateClusterData( const UINT numSamples, const UINT numDimensions, const UINT numClusters ){
+  Random random;
+  MatrixFloat data(numSamples,numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<numDimensions; j++){
+      data[i][j] = (i % numClusters) * 5.0 + random.getRandomNumberGauss(0,0.2);
+    }
+  }
+  return data;
+}
+
+//Returns the index of the neuron with the largest response to x
+UINT getBestNeuron( SelfOrganizingMap &som, const VectorFloat &sample ){
+  VectorFloat x = sample;
+  EXPECT_TRUE( som.map( x ) );
+  VectorFloat y = som.getMappedData();
+  UINT bestIndex = 0;
+  for(UINT k=1; k<y.getSize(); k++){
+    if( y[k] > y[bestIndex] ) bestIndex = k;
+  }
+  return bestIndex;
+}
+
+//Checks that no neuron is the best match for samples from more than one cluster
+void checkClusterMapping( SelfOrganizingMap &som, const MatrixFloat &data, const UINT numClusters ){
+  const UINT numNeurons = som.getNetworkSize() * som.getNetworkSize();
+  Vector< int > neuronClusters( numNeurons, -1 );
+  for(UINT i=0; i<data.getNumRows(); i++){
+    VectorFloat x; x = data.getRowVector( i );
+    const UINT k = getBestNeuron( som, x );
+    const int cluster = int( i % numClusters );
+    if( neuronClusters[k] == -1 ) neuronClusters[k] = cluster;
+    EXPECT_EQ( neuronClusters[k], cluster );
+  }
+}
+
+// Tests the default constructor
+TEST(SelfOrganizingMap, Constructor) {
+  SelfOrganizingMap som;
+  EXPECT_FALSE( som.getTrained() );
+  EXPECT_FALSE( som.getBatchTrainingEnabled() );
+  EXPECT_TRUE( som.enableBatchTraining( true ) );
+  EXPECT_TRUE( som.getBatchTrainingEnabled() );
+}
+
+// Tests the online training algorithm
+TEST(SelfOrganizingMap, TrainOnline) {
+  const UINT numClusters = 3;
+  MatrixFloat data = generateClusterData( 300, 4, numClusters );
+
+  SelfOrganizingMap som( 4, SelfOrganizingMap::RANDOM_NETWORK, 100 );
+  MatrixFloat trainingData = data;
+  EXPECT_TRUE( som.train_( trainingData ) );
+  EXPECT_TRUE( som.getTrained() );
+
+  checkClusterMapping( som, data, numClusters );
+}
+
+// Tests the batch training algorithm
+TEST(SelfOrganizingMap, TrainBatch) {
+  const UINT numClusters = 3;
+  MatrixFloat data = generateClusterData( 300, 4, numClusters );
+
+  SelfOrganizingMap som( 4, SelfOrganizingMap::RANDOM_NETWORK, 50 );
+  som.enableBatchTraining( true );
+  MatrixFloat trainingData = data;
+  EXPECT_TRUE( som.train_( trainingData ) );
+  EXPECT_TRUE( som.getTrained() );
+
+  checkClusterMapping( som, data, numClusters );
+
+  //The deep copy should keep the training mode and the model
+  SelfOrganizingMap copy( som );
+  EXPECT_TRUE( copy.getBatchTrainingEnabled() );
+  EXPECT_TRUE( copy.getTrained() );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
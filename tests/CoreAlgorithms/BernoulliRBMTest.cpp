@@ -0,0 +1,78 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT BernoulliRBM module
+
+//Builds binary data from a few prototype patterns, with a small number of bits flipped in each sample
+MatrixFloat generatePatternData( const UINT numSamples, const UINT numDimensions, const UINT numPatterns ){
+  Random random;
+  MatrixFloat patterns(numPatterns,numDimensions);
+  for(UINT k=0; k<numPatterns; k++)
+    for(UINT j=0; j<numDimensions; j++)
+      patterns[k][j] = random.getRandomNumberUniform(0,1) > 0.5 ? 1 : 0;
+
+  MatrixFloat data(numSamples,numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    const UINT k = random.getRandomNumberInt(0,numPatterns);
+    for(UINT j=0; j<numDimensions; j++){
+      const bool flip = random.getRandomNumberUniform(0,1) < 0.05;
+      data[i][j] = flip ? 1-patterns[k][j] : patterns[k][j];
+    }
+  }
+  return data;
+}
+
+//Trains the RBM and checks the reconstruction error is lower after training than for the first epoch
+void trainAndCheck( BernoulliRBM &rbm, MatrixFloat data ){
+  EXPECT_TRUE( rbm.train_( data ) );
+  EXPECT_TRUE( rbm.getTrained() );
+  EXPECT_EQ( rbm.getNumVisibleUnits(), data.getNumCols() );
+
+  const Vector< TrainingResult > results = rbm.getTrainingResults();
+  EXPECT_TRUE( results.size() > 1 );
+  EXPECT_LT( results.back().getAccuracy(), results.front().getAccuracy() );
+
+  VectorFloat input;
+  input = data.getRowVector(0);
+  EXPECT_TRUE( rbm.predict( input ) );
+  const VectorFloat output = rbm.getOutputData();
+  EXPECT_EQ( output.getSize(), rbm.getNumHiddenUnits() );
+  for(UINT j=0; j<output.getSize(); j++){
+    EXPECT_TRUE( output[j] >= 0 && output[j] <= 1 );
+  }
+}
+
+// Tests the default constructor
+TEST(BernoulliRBM, Constructor) {
+  BernoulliRBM rbm;
+  EXPECT_TRUE( !rbm.getTrained() );
+  EXPECT_EQ( rbm.getBatchSize(), 100 );
+  EXPECT_FALSE( rbm.getPersistentContrastiveDivergenceEnabled() );
+  EXPECT_FALSE( rbm.setBatchSize( 0 ) );
+}
+
+// Tests training with standard contrastive divergence, using a batch size that does not divide the dataset
+TEST(BernoulliRBM, TrainCD) {
+  TrainingLog::enableLogging( false );
+  BernoulliRBM rbm( 32, 20 );
+  rbm.setMinChange( 0 );
+  EXPECT_TRUE( rbm.setBatchSize( 64 ) );
+  EXPECT_EQ( rbm.getBatchSize(), 64 );
+  trainAndCheck( rbm, generatePatternData( 500, 64, 4 ) );
+}
+
+// Tests training with persistent contrastive divergence
+TEST(BernoulliRBM, TrainPCD) {
+  TrainingLog::enableLogging( false );
+  BernoulliRBM rbm( 32, 20 );
+  rbm.setMinChange( 0 );
+  EXPECT_TRUE( rbm.enablePersistentContrastiveDivergence( true ) );
+  EXPECT_TRUE( rbm.getPersistentContrastiveDivergenceEnabled() );
+  trainAndCheck( rbm, generatePatternData( 500, 64, 4 ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT EvolutionaryAlgorithm module
+
+//An evolutionary algorithm with a noisy fitness function, the noise is drawn from the random generator of each individual
+class NoisyEvolutionaryAlgorithm : public EvolutionaryAlgorithm< Individual >{
+public:
+  NoisyEvolutionaryAlgorithm(const UINT populationSize,const UINT geneSize) : EvolutionaryAlgorithm< Individual >(populationSize,geneSize){}
+  virtual ~NoisyEvolutionaryAlgorithm(){}
+
+  virtual Float evaluateFitness( Individual &individual, const MatrixFloat &trainingData, Random &random ){
+    EvolutionaryAlgorithm< Individual >::evaluateFitness( individual, trainingData );
+    individual.fitness *= random.getRandomNumberUniform(0.9,1.1);
+    return individual.fitness;
+  }
+};
+
+MatrixFloat generateTargets(){
+  MatrixFloat targets(2,3);
+  targets[0][0] = 0.2; targets[0][1] = 0.4; targets[0][2] = 0.6;
+  targets[1][0] = 0.8; targets[1][1] = 0.7; targets[1][2] = 0.1;
+  return targets;
+}
+
+// Tests the default constructor
+TEST(EvolutionaryAlgorithm, Constructor) {
+  EvolutionaryAlgorithm< Individual > evo;
+  EXPECT_FALSE( evo.getInitialized() );
+  EXPECT_FALSE( evo.getParallelFitnessEvaluation() );
+  EXPECT_TRUE( evo.initPopulation( 10, 3 ) );
+  EXPECT_TRUE( evo.getInitialized() );
+  EXPECT_EQ( evo.getPopulationSize(), 10 );
+}
+
+// Tests the algorithm evolves an individual close to one of the targets
+TEST(EvolutionaryAlgorithm, Train) {
+  const MatrixFloat targets = generateTargets();
+  EvolutionaryAlgorithm< Individual > evo( 200, 3 );
+  evo.rand.setSeed( 42 );
+  evo.setMaxIterations( 100 );
+  evo.setMinNumIterationsNoChange( 20 );
+  evo.setStoreHistory( false );
+  EXPECT_TRUE( evo.train( targets ) );
+
+  const Individual &best = evo[ evo.bestIndividualIndex ];
+  Float minError = grt_numeric_limits< Float >::max();
+  for(UINT i=0; i<targets.getNumRows(); i++){
+    Float error = 0;
+    for(UINT j=0; j<3; j++) error += SQR( targets[i][j] - best.gene[j] );
+    minError = grt_min( minError, error );
+  }
+  EXPECT_LT( minError, 0.01 );
+}
+
+// Tests the parallel and serial fitness evaluation give identical results for a stochastic fitness function
+TEST(EvolutionaryAlgorithm, ParallelMatchesSerial) {
+  const MatrixFloat targets = generateTargets();
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  NoisyEvolutionaryAlgorithm serial( 101, 3 );
+  NoisyEvolutionaryAlgorithm parallel( 101, 3 );
+  EXPECT_TRUE( serial.setParallelFitnessEvaluation( false ) );
+  EXPECT_TRUE( parallel.setParallelFitnessEvaluation( true ) );
+
+  NoisyEvolutionaryAlgorithm *evos[2] = { &serial, &parallel };
+  for(UINT k=0; k<2; k++){
+    evos[k]->rand.setSeed( 7 );
+    evos[k]->setMaxIterations( 20 );
+    evos[k]->setMinChange( 0 );
+    evos[k]->setStoreHistory( false );
+    EXPECT_TRUE( evos[k]->train( targets ) );
+  }
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  EXPECT_EQ( serial.bestIndividualIndex, parallel.bestIndividualIndex );
+  EXPECT_EQ( serial.bestIndividualFitness, parallel.bestIndividualFitness );
+  for(UINT i=0; i<serial.getPopulationSize(); i++){
+    EXPECT_EQ( serial[i].fitness, parallel[i].fitness );
+    for(UINT j=0; j<3; j++){
+      EXPECT_EQ( serial[i].gene[j], parallel[i].gene[j] );
+    }
+  }
+}
+
+// Tests the mutation rate is respected at the extremes and on average
+TEST(EvolutionaryAlgorithm, MutationRate) {
+  EvolutionaryAlgorithm< Individual > evo( 1, 10000 );
+  evo.rand.setSeed( 3 );
+  VectorFloat gene( 10000, -1 );
+
+  evo.setMutationRate( 0 );
+  evo.mutateGene( gene );
+  for(UINT i=0; i<gene.getSize(); i++) EXPECT_EQ( gene[i], -1 );
+
+  evo.setMutationRate( 0.1 );
+  evo.mutateGene( gene );
+  UINT numMutations = 0;
+  for(UINT i=0; i<gene.getSize(); i++) if( gene[i] != -1 ) numMutations++;
+  EXPECT_NEAR( numMutations, 1000, 100 );
+
+  evo.setMutationRate( 1 );
+  evo.mutateGene( gene );
+  for(UINT i=0; i<gene.getSize(); i++) EXPECT_TRUE( gene[i] >= 0 && gene[i] <= 1 );
+}
+
+// Tests the weighted random selection with an unsorted accumulated lookup table
+TEST(EvolutionaryAlgorithm, WeightedSelection) {
+  Random random( 11 );
+  Vector< IndexedDouble > weights(4);
+  VectorFloat lookup(4);
+  const Float w[4] = {0.5,0.0,0.1,0.4};
+  Float sum = 0;
+  for(UINT i=0; i<4; i++){
+    weights[i].index = i;
+    weights[i].value = w[i];
+    sum += w[i];
+    lookup[i] = sum;
+  }
+  VectorFloat counts(4,0);
+  const UINT N = 20000;
+  for(UINT i=0; i<N; i++){
+    counts[ random.getRandomNumberWeighted( weights, lookup ) ]++;
+  }
+  for(UINT i=0; i<4; i++){
+    EXPECT_NEAR( counts[i]/N, w[i], 0.02 );
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
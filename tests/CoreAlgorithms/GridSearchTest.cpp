@@ -0,0 +1,113 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT GridSearch module
+
+//A simple model with two parameters, the best model is a = 0.3 and b = 10
+class QuadraticModel{
+public:
+  QuadraticModel(){ a = 0; b = 0; }
+  bool setA( const Float a ){ this->a = a; return true; }
+  bool setB( const Float b ){ this->b = b; return true; }
+  Float score() const { return -SQR(a-0.3) - SQR(log10(b)-1.0); }
+  Float a;
+  Float b;
+};
+
+// Tests the linear and log-scale ranges
+TEST(GridSearch, Ranges) {
+  GridSearchRange< unsigned int > intRange(1,10,3);
+  Vector< unsigned int > intValues = intRange.getValues();
+  ASSERT_EQ( intValues.getSize(), 4 );
+  EXPECT_EQ( intValues[0], 1 ); EXPECT_EQ( intValues[1], 4 ); EXPECT_EQ( intValues[2], 7 ); EXPECT_EQ( intValues[3], 10 );
+
+  GridSearchRange< Float > floatRange(0.0,1.0,0.1);
+  Vector< Float > floatValues = floatRange.getValues();
+  ASSERT_EQ( floatValues.getSize(), 11 );
+  EXPECT_NEAR( floatValues[3], 0.3, tolerance( 1.0e-12 ) );
+  EXPECT_EQ( floatValues[10], 1.0 );
+
+  GridSearchRange< Float > logRange(0.001,1000,10,true);
+  Vector< Float > logValues = logRange.getValues();
+  ASSERT_EQ( logValues.getSize(), 7 );
+  EXPECT_NEAR( logValues[1], 0.01, tolerance( 1.0e-12 ) );
+  EXPECT_EQ( logValues[6], 1000 );
+
+  //The iterator interface should visit the same values
+  logRange.reset();
+  for(unsigned int i=0; i<logValues.getSize(); i++){
+    EXPECT_NEAR( logRange.get(), logValues[i], tolerance( 1.0e-9 ) );
+    logRange.next();
+  }
+  EXPECT_TRUE( logRange.getExpired() );
+}
+
+// Tests the original search over a single shared model
+TEST(GridSearch, SharedModelSearch) {
+  GridSearch< QuadraticModel > gridSearch;
+  QuadraticModel model;
+  gridSearch.addParameter( [&](unsigned int v){ return model.setA( v/10.0 ); }, GridSearchRange< unsigned int >(0,10,1) );
+  gridSearch.addParameter( [&](unsigned int v){ return model.setB( v ); }, GridSearchRange< unsigned int >(1,20,1) );
+  gridSearch.setEvaluationFunction( [&](){ gridSearch.setModel( model ); return model.score(); }, GridSearch< QuadraticModel >::MaxValueSearch );
+  EXPECT_TRUE( gridSearch.search() );
+  EXPECT_NEAR( gridSearch.getBestModel().a, 0.3, tolerance( 1.0e-9 ) );
+  EXPECT_NEAR( gridSearch.getBestModel().b, 10, tolerance( 1.0e-9 ) );
+}
+
+// Tests the model search finds the same best model with a serial and parallel search
+TEST(GridSearch, ModelSearch) {
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  for(unsigned int k=0; k<2; k++){
+    GridSearch< QuadraticModel > gridSearch;
+    EXPECT_TRUE( gridSearch.setParallelSearch( k == 1 ) );
+    EXPECT_TRUE( gridSearch.addModelParameter( [](QuadraticModel &m, Float v){ return m.setA( v ); }, GridSearchRange< Float >(0,1,0.05) ) );
+    EXPECT_TRUE( gridSearch.addModelParameter( [](QuadraticModel &m, Float v){ return m.setB( v ); }, GridSearchRange< Float >(0.01,10000,10,true) ) );
+    gridSearch.setModelEvaluationFunction( [](QuadraticModel &m, const VectorFloat &params, Float budget){ return m.score(); }, GridSearch< QuadraticModel >::MaxValueSearch );
+    EXPECT_TRUE( gridSearch.search() );
+
+    EXPECT_EQ( gridSearch.getNumEvaluations(), 21*7 );
+    EXPECT_NEAR( gridSearch.getBestModel().a, 0.3, tolerance( 1.0e-9 ) );
+    EXPECT_NEAR( gridSearch.getBestModel().b, 10, tolerance( 1.0e-9 ) );
+    EXPECT_NEAR( gridSearch.getBestResult(), 0, tolerance( 1.0e-9 ) );
+    const VectorFloat bestParameters = gridSearch.getBestParameters();
+    ASSERT_EQ( bestParameters.getSize(), 2 );
+    EXPECT_NEAR( bestParameters[0], 0.3, tolerance( 1.0e-9 ) );
+    EXPECT_NEAR( bestParameters[1], 10, tolerance( 1.0e-9 ) );
+  }
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+}
+
+// Tests successive halving uses fewer evaluations and still finds the best model with a minimum value search
+TEST(GridSearch, SuccessiveHalving) {
+  GridSearch< QuadraticModel > gridSearch;
+  EXPECT_FALSE( gridSearch.enableSuccessiveHalving( true, 1.0 ) );
+  EXPECT_FALSE( gridSearch.enableSuccessiveHalving( true, 3.0, 0 ) );
+  EXPECT_TRUE( gridSearch.enableSuccessiveHalving( true, 3.0, 1.0/9.0 ) );
+  EXPECT_TRUE( gridSearch.getSuccessiveHalvingEnabled() );
+  gridSearch.addModelParameter( [](QuadraticModel &m, Float v){ return m.setA( v ); }, GridSearchRange< Float >(0,1,0.01) );
+
+  //The error is less accurate when evaluated with a smaller budget
+  unsigned int numFullBudget = 0;
+  gridSearch.setModelEvaluationFunction( [&](QuadraticModel &m, const VectorFloat &params, Float budget){
+      if( budget == 1.0 ) numFullBudget++;
+      return SQR( m.a - 0.3 ) + 0.001 * (1.0 - budget) * m.a;
+    }, GridSearch< QuadraticModel >::MinValueSearch );
+  EXPECT_TRUE( gridSearch.setParallelSearch( false ) );
+  EXPECT_TRUE( gridSearch.search() );
+
+  //101 grid points -> 33 -> 11 at the full budget
+  EXPECT_EQ( gridSearch.getNumEvaluations(), 101 + 33 + 11 );
+  EXPECT_EQ( numFullBudget, 11 );
+  EXPECT_NEAR( gridSearch.getBestModel().a, 0.3, tolerance( 1.0e-9 ) );
+  EXPECT_NEAR( gridSearch.getBestResult(), 0, tolerance( 1.0e-9 ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
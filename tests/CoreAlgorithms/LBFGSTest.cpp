@@ -0,0 +1,71 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT LBFGS module
+
+// Tests the minimum of the Rosenbrock function is found
+TEST(LBFGS, Rosenbrock) {
+
+  LBFGS::ObjectiveFunction rosenbrock = []( const VectorFloat &x, VectorFloat &g ){
+    Float f = 0;
+    std::fill( g.begin(), g.end(), 0.0 );
+    for(UINT i=0; i+1<x.getSize(); i++){
+      const Float a = x[i+1] - x[i]*x[i];
+      const Float b = 1.0 - x[i];
+      f += 100.0*a*a + b*b;
+      g[i] += -400.0*a*x[i] - 2.0*b;
+      g[i+1] += 200.0*a;
+    }
+    return f;
+  };
+
+  LBFGS optimizer( 10, 1000, 0, 1.0e-10 );
+  VectorFloat x( 10, -1.2 );
+  EXPECT_TRUE( optimizer.minimize( rosenbrock, x ) );
+  EXPECT_TRUE( optimizer.getConverged() );
+  EXPECT_TRUE( optimizer.getNumIterations() < 1000 );
+  EXPECT_NEAR( optimizer.getMinimumValue(), 0.0, 1.0e-8 );
+  for(UINT i=0; i<x.getSize(); i++){
+    EXPECT_NEAR( x[i], 1.0, 1.0e-4 );
+  }
+
+  //The objective values should never go up
+  VectorFloat values = optimizer.getObjectiveValues();
+  EXPECT_EQ( values.getSize(), optimizer.getNumIterations()+1 );
+  for(UINT i=1; i<values.getSize(); i++){
+    EXPECT_TRUE( values[i] <= values[i-1] );
+  }
+}
+
+// Tests a badly scaled quadratic is minimized in a few iterations
+TEST(LBFGS, Quadratic) {
+
+  const UINT N = 20;
+  LBFGS::ObjectiveFunction quadratic = [N]( const VectorFloat &x, VectorFloat &g ){
+    Float f = 0;
+    for(UINT i=0; i<N; i++){
+      const Float scale = 1.0 + i*i;
+      f += 0.5 * scale * (x[i]-i) * (x[i]-i);
+      g[i] = scale * (x[i]-i);
+    }
+    return f;
+  };
+
+  LBFGS optimizer;
+  VectorFloat x( N, 0.0 );
+  EXPECT_TRUE( optimizer.minimize( quadratic, x ) );
+  EXPECT_TRUE( optimizer.getNumIterations() < 100 );
+  for(UINT i=0; i<N; i++){
+    EXPECT_NEAR( x[i], Float(i), 1.0e-4 );
+  }
+
+  //An empty starting point is invalid
+  VectorFloat empty;
+  EXPECT_FALSE( optimizer.minimize( quadratic, empty ) );
+}
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest( &argc, argv );
+	return RUN_ALL_TESTS();
+}
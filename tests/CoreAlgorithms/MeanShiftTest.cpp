@@ -0,0 +1,92 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT MeanShift module
+
+MatrixFloat generateClusters( const UINT numPointsPerCluster, MatrixFloat &centers ){
+  Random random( 3 );
+  centers.resize( 3, 2 );
+  centers[0][0] = 0; centers[0][1] = 0;
+  centers[1][0] = 5; centers[1][1] = 5;
+  centers[2][0] = -5; centers[2][1] = 4;
+  MatrixFloat data( numPointsPerCluster*3, 2 );
+  for(UINT k=0; k<3; k++){
+    for(UINT i=0; i<numPointsPerCluster; i++){
+      for(UINT j=0; j<2; j++){
+        data[k*numPointsPerCluster+i][j] = centers[k][j] + random.getRandomNumberGauss(0,0.5);
+      }
+    }
+  }
+  return data;
+}
+
+// Tests a single search from a start point converges on the closest cluster
+TEST(MeanShift, Search) {
+  MatrixFloat centers;
+  MatrixFloat data = generateClusters( 200, centers );
+  Vector< VectorFloat > points( data.getNumRows() );
+  for(UINT i=0; i<data.getNumRows(); i++) points[i] = data.getRow(i);
+
+  MeanShift meanShift;
+  VectorFloat start(2);
+  start[0] = 4; start[1] = 4;
+  EXPECT_TRUE( meanShift.search( start, points, 2.0, 1.0 ) );
+  VectorFloat mean = meanShift.getMean();
+  EXPECT_NEAR( mean[0], 5, 0.2 );
+  EXPECT_NEAR( mean[1], 5, 0.2 );
+}
+
+// Tests findModes finds the clusters with and without bin seeding, and with a parallel search
+TEST(MeanShift, FindModes) {
+  MatrixFloat centers;
+  MatrixFloat data = generateClusters( 500, centers );
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  for(UINT mode=0; mode<3; mode++){
+    MeanShift meanShift;
+    EXPECT_TRUE( meanShift.enableBinSeeding( mode != 1 ) );
+    EXPECT_TRUE( meanShift.setParallelSearch( mode != 2 ) );
+    EXPECT_TRUE( meanShift.findModes( data, 2.0, 1.0 ) );
+
+    MatrixFloat modes = meanShift.getModes();
+    Vector< unsigned int > modeSizes = meanShift.getModeSizes();
+    ASSERT_EQ( modes.getNumRows(), 3 );
+    ASSERT_EQ( modeSizes.size(), 3 );
+
+    //Each cluster should have a mode close to its center
+    for(UINT k=0; k<3; k++){
+      Float bestDist = grt_numeric_limits< Float >::max();
+      for(UINT m=0; m<3; m++){
+        bestDist = grt_min( bestDist, SQR(modes[m][0]-centers[k][0]) + SQR(modes[m][1]-centers[k][1]) );
+      }
+      EXPECT_LT( bestDist, 0.1 );
+      EXPECT_GT( modeSizes[k], 400 );
+    }
+
+    //All the points from one cluster should have the same label
+    Vector< unsigned int > labels = meanShift.getClusterLabels();
+    ASSERT_EQ( labels.size(), data.getNumRows() );
+    for(UINT k=0; k<3; k++){
+      for(UINT i=1; i<500; i++){
+        EXPECT_EQ( labels[k*500+i], labels[k*500] );
+      }
+    }
+  }
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+}
+
+// Tests findModes rejects invalid input
+TEST(MeanShift, InvalidInput) {
+  MeanShift meanShift;
+  EXPECT_FALSE( meanShift.findModes( MatrixFloat(), 1.0, 1.0 ) );
+  EXPECT_FALSE( meanShift.findModes( MatrixFloat(10,2), 0.0, 1.0 ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT ParticleFilter module
+
+//A simple particle filter that tracks a point moving in 2D, the sensor directly observes the position with some noise
+class PointTracker : public ParticleFilter< Particle, VectorFloat >{
+public:
+  PointTracker(){}
+  virtual ~PointTracker(){}
+
+  //Sets the particle weights and runs the protected resample function directly
+  bool resampleWithWeights( const VectorFloat &w ){
+    for(UINT i=0; i<numParticles; i++){
+      particles[i].w = w[i];
+      weights[i] = w[i];
+    }
+    return resample();
+  }
+
+protected:
+  virtual bool predict( Particle &p ){
+    for(UINT j=0; j<p.x.getSize(); j++){
+      p.x[j] += rand.getRandomNumberGauss(0,processNoise[j]);
+    }
+    return true;
+  }
+
+  virtual bool update( Particle &p, VectorFloat &data ){
+    p.w = 1;
+    for(UINT j=0; j<p.x.getSize(); j++){
+      p.w *= gauss( data[j], p.x[j], measurementNoise[j] );
+    }
+    return true;
+  }
+};
+
+//Runs the tracker over a noisy random walk and returns the mean absolute tracking error
+Float runTracker( PointTracker &tracker, const UINT numParticles ){
+  Random random;
+  Vector< VectorFloat > initModel( 2, VectorFloat(2,0) );
+  initModel[0][0] = -1; initModel[0][1] = 1;
+  initModel[1][0] = -1; initModel[1][1] = 1;
+  VectorFloat processNoise(2,0.05);
+  VectorFloat measurementNoise(2,0.1);
+  EXPECT_TRUE( tracker.init( numParticles, initModel, processNoise, measurementNoise ) );
+  EXPECT_EQ( tracker.getNumParticles(), numParticles );
+
+  VectorFloat position(2,0);
+  VectorFloat data(2,0);
+  Float error = 0;
+  const UINT numSteps = 50;
+  for(UINT t=0; t<numSteps; t++){
+    for(UINT j=0; j<2; j++){
+      position[j] += 0.02;
+      data[j] = position[j] + random.getRandomNumberGauss(0,0.01);
+    }
+    EXPECT_TRUE( tracker.filter( data ) );
+
+    //The weights should be normalized and mirrored in the particles
+    const VectorFloat &weights = tracker.getWeights();
+    EXPECT_EQ( weights.getSize(), numParticles );
+    Float sum = 0;
+    for(UINT i=0; i<numParticles; i++){
+      sum += weights[i];
+      EXPECT_EQ( weights[i], tracker[i].w );
+    }
+    EXPECT_NEAR( sum, 1.0, tolerance( 1.0e-6 ) );
+
+    const VectorFloat estimate = tracker.getStateEstimation();
+    if( t >= numSteps/2 ){
+      error += (fabs( estimate[0] - position[0] ) + fabs( estimate[1] - position[1] )) / 2.0;
+    }
+  }
+  return error / (numSteps/2);
+}
+
+// Tests the filter tracks a moving point with a serial update
+TEST(ParticleFilter, TrackSerial) {
+  PointTracker tracker;
+  tracker.setVerbose( false );
+  EXPECT_FALSE( tracker.getParallelUpdate() );
+  EXPECT_LT( runTracker( tracker, 500 ), 0.1 );
+}
+
+// Tests the filter tracks a moving point when the update is split across the thread pool
+TEST(ParticleFilter, TrackParallel) {
+  PointTracker tracker;
+  tracker.setVerbose( false );
+  EXPECT_TRUE( tracker.setParallelUpdate( true ) );
+  EXPECT_TRUE( tracker.getParallelUpdate() );
+  EXPECT_LT( runTracker( tracker, 20000 ), 0.1 );
+}
+
+// Tests systematic resampling keeps the particles in proportion to their weights
+TEST(ParticleFilter, SystematicResample) {
+  PointTracker tracker;
+  tracker.setVerbose( false );
+  const UINT numParticles = 1000;
+  Vector< VectorFloat > initModel( 1, VectorFloat(2,0) );
+  initModel[0][0] = 0; initModel[0][1] = 1;
+  EXPECT_TRUE( tracker.init( numParticles, initModel, VectorFloat(1,0.1), VectorFloat(1,0.1) ) );
+
+  //Give two particles all the weight, 3:1, and move them well outside the init range
+  tracker[10].x[0] = 10;
+  tracker[20].x[0] = 20;
+  VectorFloat w(numParticles,0);
+  w[10] = 0.75;
+  w[20] = 0.25;
+  EXPECT_TRUE( tracker.resampleWithWeights( w ) );
+
+  //10% of the particles are randomly reinitialized, the rest should be split 3:1 between the two particles
+  UINT numA = 0, numB = 0;
+  for(UINT i=0; i<numParticles; i++){
+    if( tracker[i].x[0] == 10 ) numA++;
+    else if( tracker[i].x[0] == 20 ) numB++;
+    else EXPECT_TRUE( tracker[i].x[0] >= 0 && tracker[i].x[0] <= 1 );
+  }
+  EXPECT_NEAR( numA, 675, 1 );
+  EXPECT_NEAR( numB, 225, 1 );
+  EXPECT_EQ( tracker.getWeights()[0], tracker[0].w );
+
+  //The particles before the resample should still be available
+  EXPECT_EQ( tracker(10).x[0], 10 );
+  EXPECT_EQ( tracker(20).x[0], 20 );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
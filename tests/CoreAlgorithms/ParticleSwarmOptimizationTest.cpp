@@ -0,0 +1,148 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT ParticleSwarmOptimization module
+
+typedef ParticleSwarmOptimization< PSOParticle< VectorFloat >, VectorFloat > PSO;
+
+//A particle that counts how many times the search calls each of its functions
+class CountingParticle : public PSOParticle< VectorFloat >{
+public:
+  CountingParticle(){ numPropagate = numUpdate = numReset = 0; }
+  virtual bool propagate(const VectorFloat &model){ numPropagate++; return PSOParticle< VectorFloat >::propagate( model ); }
+  virtual bool update(const VectorFloat &globalBestX){ numUpdate++; return PSOParticle< VectorFloat >::update( globalBestX ); }
+  virtual bool reset(){ numReset++; return PSOParticle< VectorFloat >::reset(); }
+  unsigned int numPropagate;
+  unsigned int numUpdate;
+  unsigned int numReset;
+};
+
+template< class PSO_TYPE >
+bool initSwarm( PSO_TYPE &pso, const unsigned int numParticles, const unsigned long long seed, const bool useSwarmMatrix = false ){
+  const unsigned int K = 3;
+  pso.setUseSwarmMatrix( useSwarmMatrix );
+  pso.setRandomSeed( seed );
+  pso.setStoreHistory( false );
+  pso.maxIter = 200;
+  return pso.init( numParticles, K, VectorFloat(K,-1), VectorFloat(K,1), VectorFloat(K,0.01) );
+}
+
+// Tests the default settings
+TEST(ParticleSwarmOptimization, Constructor) {
+  PSO pso;
+  EXPECT_FALSE( pso.initialized );
+  EXPECT_FALSE( pso.getParallelSearch() );
+  EXPECT_FALSE( pso.getUseSwarmMatrix() );
+}
+
+// Tests the swarm finds the observation with the default particle evaluation, with and without the swarm matrix
+TEST(ParticleSwarmOptimization, Search) {
+  VectorFloat observation(3);
+  observation[0] = 0.5; observation[1] = -0.25; observation[2] = 0.1;
+
+  for(unsigned int m=0; m<2; m++){
+    const bool useSwarmMatrix = m == 1;
+    PSO pso;
+    EXPECT_TRUE( initSwarm( pso, 50, 42, useSwarmMatrix ) );
+    EXPECT_EQ( pso.getPositions().getNumRows(), useSwarmMatrix ? 50 : 0 );
+    EXPECT_EQ( pso.getPosition( 0 ).getSize(), 3 );
+    EXPECT_TRUE( pso.search( observation ) );
+
+    for(unsigned int k=0; k<3; k++){
+      EXPECT_NEAR( pso.finalX[k], observation[k], 0.05 );
+    }
+  }
+}
+
+// Tests the search calls the propagate, update and reset functions of each particle, unless the swarm matrix is used
+TEST(ParticleSwarmOptimization, ParticleFunctions) {
+  VectorFloat observation(3,0.2);
+
+  for(unsigned int m=0; m<2; m++){
+    const bool useSwarmMatrix = m == 1;
+    ParticleSwarmOptimization< CountingParticle, VectorFloat > pso;
+    EXPECT_TRUE( initSwarm( pso, 20, 3, useSwarmMatrix ) );
+    pso.maxIter = 10;
+    pso.maxNumIterNoChange = 10;
+    EXPECT_TRUE( pso.search( observation ) );
+    EXPECT_TRUE( pso.reset() );
+
+    for(unsigned int i=0; i<20; i++){
+      EXPECT_EQ( pso[i].numPropagate, useSwarmMatrix ? 0 : 1 );
+      EXPECT_EQ( pso[i].numUpdate, useSwarmMatrix ? 0 : 10 );
+      EXPECT_EQ( pso[i].numReset, useSwarmMatrix ? 1 : 2 );
+    }
+  }
+}
+
+// Tests a fixed seed gives the same search with and without the thread pool
+TEST(ParticleSwarmOptimization, ParallelMatchesSerial) {
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  VectorFloat observation(3,0.2);
+  for(unsigned int m=0; m<2; m++){
+    const bool useSwarmMatrix = m == 1;
+    PSO serial, parallel;
+    EXPECT_TRUE( serial.setParallelSearch( false ) );
+    EXPECT_TRUE( parallel.setParallelSearch( true ) );
+    EXPECT_TRUE( initSwarm( serial, 200, 7, useSwarmMatrix ) );
+    EXPECT_TRUE( initSwarm( parallel, 200, 7, useSwarmMatrix ) );
+    EXPECT_TRUE( serial.search( observation ) );
+    EXPECT_TRUE( parallel.search( observation ) );
+
+    EXPECT_EQ( serial.globalBestCost, parallel.globalBestCost );
+    for(unsigned int k=0; k<3; k++){
+      EXPECT_EQ( serial.finalX[k], parallel.finalX[k] );
+    }
+    for(unsigned int i=0; i<200; i++){
+      const VectorFloat a = serial.getPosition( i );
+      const VectorFloat b = parallel.getPosition( i );
+      for(unsigned int k=0; k<3; k++){
+        EXPECT_EQ( a[k], b[k] );
+      }
+    }
+  }
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+}
+
+// Tests the batch evaluation function gives the same result as the particle evaluation, and can only be used with the swarm matrix
+TEST(ParticleSwarmOptimization, BatchEvaluation) {
+  VectorFloat observation(3,-0.3);
+  PSO pso, batch;
+  EXPECT_TRUE( initSwarm( pso, 100, 11, true ) );
+  EXPECT_TRUE( initSwarm( batch, 100, 11, false ) );
+
+  unsigned int numCalls = 0;
+  EXPECT_TRUE( batch.setBatchEvaluationFunction( [&](const MatrixFloat &positions, VectorFloat &obs, VectorFloat &costs){
+      numCalls++;
+      costs.resize( positions.getNumRows() );
+      for(unsigned int i=0; i<positions.getNumRows(); i++){
+        Float cost = 0;
+        for(unsigned int k=0; k<positions.getNumCols(); k++){
+          cost += SQR( positions[i][k] - obs[k] );
+        }
+        cost += 0.0001;
+        costs[i] = 1.0/(cost*cost);
+      }
+      return true;
+    } ) );
+
+  EXPECT_FALSE( batch.search( observation ) );
+  EXPECT_EQ( numCalls, 0 );
+  EXPECT_TRUE( initSwarm( batch, 100, 11, true ) );
+
+  EXPECT_TRUE( pso.search( observation ) );
+  EXPECT_TRUE( batch.search( observation ) );
+  EXPECT_GT( numCalls, 0 );
+  for(unsigned int k=0; k<3; k++){
+    EXPECT_EQ( pso.finalX[k], batch.finalX[k] );
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT PrincipalComponentAnalysis module
+
+//Builds a dataset with a few dominant directions of decreasing variance plus some small noise
+MatrixFloat generateLowRankData( const UINT numSamples, const UINT numDimensions, const UINT rank ){
+  Random random;
+  MatrixFloat basis(rank,numDimensions);
+  for(UINT k=0; k<rank; k++)
+    for(UINT j=0; j<numDimensions; j++)
+      basis[k][j] = random.getRandomNumberGauss();
+
+  MatrixFloat data(numSamples,numDimensions);
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<numDimensions; j++) data[i][j] = 5.0 + 0.01*random.getRandomNumberGauss();
+    for(UINT k=0; k<rank; k++){
+      const Float c = random.getRandomNumberGauss() * (10.0/(k+1));
+      for(UINT j=0; j<numDimensions; j++) data[i][j] += c * basis[k][j];
+    }
+  }
+  return data;
+}
+
+//Returns the absolute correlation between the k'th column of a and b (the sign of a principal component is arbitrary)
+Float getColumnCorrelation( const MatrixFloat &a, const MatrixFloat &b, const UINT k ){
+  Float ab = 0, aa = 0, bb = 0;
+  for(UINT i=0; i<a.getNumRows(); i++){
+    ab += a[i][k] * b[i][k];
+    aa += a[i][k] * a[i][k];
+    bb += b[i][k] * b[i][k];
+  }
+  return fabs( ab / sqrt( aa*bb ) );
+}
+
+// Tests the full eigen decomposition solver
+TEST(PrincipalComponentAnalysis, ComputeFeatureVector) {
+
+  const UINT numComponents = 3;
+  MatrixFloat data = generateLowRankData( 500, 20, numComponents );
+
+  PrincipalComponentAnalysis pca;
+  EXPECT_TRUE( pca.computeFeatureVector( data, numComponents ) );
+  EXPECT_TRUE( pca.getTrained() );
+  EXPECT_EQ( pca.getNumPrincipalComponents(), numComponents );
+  EXPECT_GT( pca.getMaxVariance(), 0.99 );
+
+  //The batch and single vector projections should match
+  MatrixFloat prjData;
+  EXPECT_TRUE( pca.project( data, prjData ) );
+  EXPECT_EQ( prjData.getNumRows(), data.getNumRows() );
+  EXPECT_EQ( prjData.getNumCols(), numComponents );
+  for(UINT i=0; i<10; i++){
+    VectorFloat prjVector;
+    EXPECT_TRUE( pca.project( data.getRow(i), prjVector ) );
+    for(UINT k=0; k<numComponents; k++) EXPECT_NEAR( prjVector[k], prjData[i][k], 1.0e-6 );
+  }
+}
+
+// Tests the randomized solver matches the full solver
+TEST(PrincipalComponentAnalysis, RandomizedSolver) {
+
+  const UINT numComponents = 3;
+  MatrixFloat data = generateLowRankData( 500, 50, numComponents );
+
+  PrincipalComponentAnalysis full;
+  PrincipalComponentAnalysis randomized;
+  EXPECT_TRUE( randomized.enableRandomizedSolver( true ) );
+  EXPECT_TRUE( full.computeFeatureVector( data, numComponents ) );
+  EXPECT_TRUE( randomized.computeFeatureVector( data, numComponents ) );
+  EXPECT_EQ( randomized.getNumPrincipalComponents(), numComponents );
+
+  MatrixFloat fullPrj, randomizedPrj;
+  EXPECT_TRUE( full.project( data, fullPrj ) );
+  EXPECT_TRUE( randomized.project( data, randomizedPrj ) );
+  for(UINT k=0; k<numComponents; k++){
+    EXPECT_NEAR( getColumnCorrelation( fullPrj, randomizedPrj, k ), 1.0, 1.0e-4 );
+    EXPECT_NEAR( full.getComponentWeights()[k], randomized.getComponentWeights()[k], 1.0e-4 );
+  }
+
+  //Save and load the model, only the top components are stored
+  EXPECT_TRUE( randomized.save( "pca_model.grt" ) );
+  PrincipalComponentAnalysis loaded;
+  EXPECT_TRUE( loaded.load( "pca_model.grt" ) );
+  MatrixFloat loadedPrj;
+  EXPECT_TRUE( loaded.project( data, loadedPrj ) );
+  for(UINT k=0; k<numComponents; k++){
+    EXPECT_NEAR( getColumnCorrelation( randomizedPrj, loadedPrj, k ), 1.0, 1.0e-4 );
+  }
+}
+
+// Tests the incremental solver matches the full solver
+TEST(PrincipalComponentAnalysis, UpdateFeatureVector) {
+
+  const UINT numComponents = 3;
+  const UINT numSamples = 600;
+  const UINT numDimensions = 30;
+  const UINT batchSize = 100;
+  MatrixFloat data = generateLowRankData( numSamples, numDimensions, numComponents );
+
+  PrincipalComponentAnalysis full;
+  EXPECT_TRUE( full.computeFeatureVector( data, numComponents ) );
+
+  PrincipalComponentAnalysis incremental;
+  for(UINT i=0; i<numSamples; i+=batchSize){
+    MatrixFloat batch(batchSize,numDimensions);
+    for(UINT n=0; n<batchSize; n++)
+      for(UINT j=0; j<numDimensions; j++)
+        batch[n][j] = data[i+n][j];
+    EXPECT_TRUE( incremental.updateFeatureVector( batch, numComponents ) );
+  }
+  EXPECT_EQ( incremental.getNumTrainingSamples(), numSamples );
+
+  //The running mean should match the mean of all the data
+  VectorFloat mean = data.getMean();
+  for(UINT j=0; j<numDimensions; j++) EXPECT_NEAR( incremental.getMeanVector()[j], mean[j], 1.0e-6 );
+
+  MatrixFloat fullPrj, incrementalPrj;
+  EXPECT_TRUE( full.project( data, fullPrj ) );
+  EXPECT_TRUE( incremental.project( data, incrementalPrj ) );
+  for(UINT k=0; k<numComponents; k++){
+    EXPECT_NEAR( getColumnCorrelation( fullPrj, incrementalPrj, k ), 1.0, 1.0e-4 );
+    EXPECT_NEAR( full.getComponentWeights()[k], incremental.getComponentWeights()[k], 1.0e-4 );
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
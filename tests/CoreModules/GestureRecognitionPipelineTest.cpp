@@ -0,0 +1,155 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT GestureRecognitionPipeline class
+
+ClassificationData generateClassificationData(){
+  const UINT numSamples = 500;
+  const UINT numClasses = 5;
+  const UINT numDimensions = 3;
+  ClassificationData::generateGaussDataset( "pipeline_test_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData data;
+  EXPECT_TRUE( data.load( "pipeline_test_data.csv" ) );
+  return data;
+}
+
+//Checks that the cross validation results are consistent with the test accuracy and cover every sample once
+void expectValidCrossValidationResults( const GestureRecognitionPipeline &pipeline, const UINT kFoldValue, const UINT numSamples, const bool classification ){
+  Vector< TestResult > results = pipeline.getCrossValidationResults();
+  ASSERT_EQ( results.getSize(), kFoldValue );
+
+  UINT numTestSamples = 0;
+  Float meanResult = 0;
+  for(UINT k=0; k<kFoldValue; k++){
+    numTestSamples += results[k].numTestSamples;
+    meanResult += classification ? results[k].accuracy : results[k].rmsError;
+  }
+  meanResult /= kFoldValue;
+
+  EXPECT_EQ( numTestSamples, numSamples );
+  EXPECT_NEAR( pipeline.getTestAccuracy(), meanResult, 1.0e-10 );
+  EXPECT_TRUE( pipeline.getTrained() );
+}
+
+// Tests that the test fold indexes match the test fold data
+TEST(GestureRecognitionPipeline, TestFoldIndexes) {
+
+  ClassificationData data = generateClassificationData();
+  const UINT kFoldValue = 5;
+  ASSERT_TRUE( data.spiltDataIntoKFolds( kFoldValue ) );
+
+  Vector< UINT > counter( data.getNumSamples(), 0 );
+  for(UINT k=0; k<kFoldValue; k++){
+    Vector< UINT > indexes = data.getTestFoldIndexes( k );
+    ClassificationData foldData = data.getTestFoldData( k );
+    ASSERT_EQ( indexes.getSize(), foldData.getNumSamples() );
+    for(UINT i=0; i<indexes.getSize(); i++){
+      ASSERT_LT( indexes[i], data.getNumSamples() );
+      counter[ indexes[i] ]++;
+      EXPECT_EQ( data[ indexes[i] ].getClassLabel(), foldData[i].getClassLabel() );
+      EXPECT_EQ( data[ indexes[i] ].getSample()[0], foldData[i].getSample()[0] );
+    }
+  }
+
+  //Each sample should be in exactly one test fold
+  for(UINT i=0; i<counter.getSize(); i++){
+    EXPECT_EQ( counter[i], 1 );
+  }
+
+  EXPECT_EQ( data.getTestFoldIndexes( kFoldValue ).getSize(), 0 );
+}
+
+// Tests the cross validation training with a classifier, using one thread and several threads
+TEST(GestureRecognitionPipeline, ClassificationCrossValidation) {
+
+  ClassificationData data = generateClassificationData();
+  const UINT kFoldValue = 10;
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  Float serialAccuracy = 0;
+  Vector< TestResult > serialResults;
+
+  for(unsigned int numThreads=1; numThreads<=4; numThreads+=3){
+    ThreadPool::setThreadPoolSize( numThreads );
+
+    //Use the same folds for each run
+    GestureRecognitionPipeline pipeline;
+    EXPECT_TRUE( pipeline.setCrossValidationRandomSeed( 42 ) );
+    EXPECT_EQ( pipeline.getCrossValidationRandomSeed(), 42 );
+    pipeline << MovingAverageFilter( 3, data.getNumDimensions() );
+    pipeline << KNN( 5 );
+    EXPECT_TRUE( pipeline.train( data, kFoldValue, true ) );
+    expectValidCrossValidationResults( pipeline, kFoldValue, data.getNumSamples(), true );
+    EXPECT_GT( pipeline.getTestAccuracy(), 80 );
+
+    //The folds are deterministic, so running them in parallel should give exactly the same results as running them serially
+    Vector< TestResult > results = pipeline.getCrossValidationResults();
+    if( numThreads == 1 ){
+      serialAccuracy = pipeline.getTestAccuracy();
+      serialResults = results;
+    }else{
+      EXPECT_EQ( pipeline.getTestAccuracy(), serialAccuracy );
+      ASSERT_EQ( results.getSize(), serialResults.getSize() );
+      for(UINT k=0; k<results.getSize(); k++){
+        EXPECT_EQ( results[k].numTestSamples, serialResults[k].numTestSamples );
+        EXPECT_EQ( results[k].accuracy, serialResults[k].accuracy );
+      }
+    }
+
+    //The pipeline should be trained with the last fold, so it should be ready to use
+    for(UINT i=0; i<10; i++){
+      EXPECT_TRUE( pipeline.predict( data[i].getSample() ) );
+    }
+  }
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+}
+
+// Tests the cross validation training with a regressifier
+TEST(GestureRecognitionPipeline, RegressionCrossValidation) {
+
+  RegressionData data( 2, 1 );
+  Random random;
+  VectorFloat input( 2 );
+  VectorFloat target( 1 );
+  for(UINT i=0; i<300; i++){
+    input[0] = random.getRandomNumberUniform( -1, 1 );
+    input[1] = random.getRandomNumberUniform( -1, 1 );
+    target[0] = 0.5 * input[0] - 0.25 * input[1] + 0.1;
+    EXPECT_TRUE( data.addSample( input, target ) );
+  }
+
+  const UINT kFoldValue = 5;
+  GestureRecognitionPipeline pipeline;
+  pipeline << LinearRegression();
+  EXPECT_TRUE( pipeline.train( data, kFoldValue ) );
+  expectValidCrossValidationResults( pipeline, kFoldValue, data.getNumSamples(), false );
+  EXPECT_LT( pipeline.getTestAccuracy(), 0.01 );
+}
+
+// Tests the cross validation training with a timeseries classifier
+TEST(GestureRecognitionPipeline, TimeSeriesCrossValidation) {
+
+  TimeSeriesClassificationData data( 1 );
+  Random random;
+  for(UINT k=1; k<=2; k++){
+    for(UINT n=0; n<10; n++){
+      MatrixFloat timeseries( 20, 1 );
+      for(UINT i=0; i<20; i++){
+        timeseries[i][0] = (k == 1 ? sin( i / 3.0 ) : cos( i / 3.0 )) + random.getRandomNumberUniform( -0.1, 0.1 );
+      }
+      EXPECT_TRUE( data.addSample( k, timeseries ) );
+    }
+  }
+
+  const UINT kFoldValue = 4;
+  GestureRecognitionPipeline pipeline;
+  pipeline << DTW();
+  EXPECT_TRUE( pipeline.train( data, kFoldValue ) );
+  expectValidCrossValidationResults( pipeline, kFoldValue, data.getNumSamples(), true );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
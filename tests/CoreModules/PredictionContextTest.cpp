@@ -0,0 +1,236 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#ifdef GRT_CXX11_ENABLED
+#include <thread>
+#endif
+using namespace GRT;
+
+//Unit tests for the const prediction interface that uses the GRT PredictionContext
+
+ClassificationData generateClassificationData(){
+  const UINT numSamples = 500;
+  const UINT numClasses = 5;
+  const UINT numDimensions = 4;
+  ClassificationData::generateGaussDataset( "prediction_context_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData data;
+  EXPECT_TRUE( data.load( "prediction_context_data.csv" ) );
+  return data;
+}
+
+TimeSeriesClassificationData generateTimeSeriesData(){
+  Random random;
+  TimeSeriesClassificationData data( 2 );
+  for(UINT classLabel=1; classLabel<=3; classLabel++){
+    for(UINT n=0; n<10; n++){
+      MatrixFloat timeseries( 20, 2 );
+      for(UINT i=0; i<20; i++){
+        timeseries[i][0] = sin( classLabel * i * 0.2 ) + random.getRandomNumberUniform(-0.05,0.05);
+        timeseries[i][1] = cos( classLabel * i * 0.1 ) + random.getRandomNumberUniform(-0.05,0.05);
+      }
+      EXPECT_TRUE( data.addSample( classLabel, timeseries ) );
+    }
+  }
+  return data;
+}
+
+//Checks that the const prediction gives the same results as the standard prediction
+void expectMatchingPredictions( Classifier &classifier, const ClassificationData &data ){
+  PredictionContext context;
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    const VectorFloat &x = data[i].getSample();
+    ASSERT_TRUE( classifier.predict( x, context ) );
+    ASSERT_TRUE( classifier.predict( x ) );
+    EXPECT_EQ( context.predictedClassLabel, classifier.getPredictedClassLabel() );
+    EXPECT_NEAR( context.maxLikelihood, classifier.getMaximumLikelihood(), 1.0e-10 );
+    const VectorFloat likelihoods = classifier.getClassLikelihoods();
+    ASSERT_EQ( context.classLikelihoods.getSize(), likelihoods.getSize() );
+    for(UINT k=0; k<likelihoods.getSize(); k++){
+      EXPECT_NEAR( context.classLikelihoods[k], likelihoods[k], 1.0e-10 );
+    }
+  }
+}
+
+// Tests the classifiers that support const prediction, and one that uses the default copy of the model
+TEST(PredictionContext, Classifiers) {
+
+  ClassificationData trainingData = generateClassificationData();
+  ClassificationData testData = trainingData.split( 80 );
+
+  KNN knn;
+  EXPECT_TRUE( knn.train( trainingData ) );
+  expectMatchingPredictions( knn, testData );
+
+  RandomForests randomForests;
+  randomForests.setForestSize( 10 );
+  EXPECT_TRUE( randomForests.train( trainingData ) );
+  expectMatchingPredictions( randomForests, testData );
+
+  MinDist minDist;
+  EXPECT_TRUE( minDist.train( trainingData ) );
+  expectMatchingPredictions( minDist, testData );
+
+  ANBC anbc;
+  EXPECT_TRUE( anbc.train( trainingData ) );
+  expectMatchingPredictions( anbc, testData );
+
+  //A model that has not been trained should fail
+  PredictionContext context;
+  KNN untrained;
+  EXPECT_FALSE( untrained.predict( testData[0].getSample(), context ) );
+}
+
+// Tests that several streams can be classified by one DTW model, with each stream using its own context
+TEST(PredictionContext, DTWStreams) {
+
+  TimeSeriesClassificationData trainingData = generateTimeSeriesData();
+
+  DTW dtw;
+  EXPECT_TRUE( dtw.train( trainingData ) );
+
+  //Each stream should give the same results as its own copy of the model
+  DTW streamA( dtw );
+  DTW streamB( dtw );
+  PredictionContext contextA;
+  PredictionContext contextB;
+  PredictionContext contextCopy;
+  for(UINT i=0; i<60; i++){
+    VectorFloat a(2), b(2);
+    a[0] = sin( i * 0.2 ); a[1] = cos( i * 0.1 );
+    b[0] = sin( 3 * i * 0.2 ); b[1] = cos( 3 * i * 0.1 );
+
+    ASSERT_TRUE( dtw.predict( a, contextA ) );
+    ASSERT_TRUE( dtw.predict( b, contextB ) );
+    ASSERT_TRUE( streamA.predict( a ) );
+    ASSERT_TRUE( streamB.predict( b ) );
+    EXPECT_EQ( contextA.predictedClassLabel, streamA.getPredictedClassLabel() );
+    EXPECT_EQ( contextB.predictedClassLabel, streamB.getPredictedClassLabel() );
+    EXPECT_NEAR( contextA.maxLikelihood, streamA.getMaximumLikelihood(), 1.0e-10 );
+    EXPECT_NEAR( contextB.maxLikelihood, streamB.getMaximumLikelihood(), 1.0e-10 );
+
+    //A copy of a context should continue from the same point in the stream
+    if( i == 30 ) contextCopy = contextA;
+    if( i > 30 ){
+      ASSERT_TRUE( dtw.predict( a, contextCopy ) );
+      EXPECT_EQ( contextCopy.predictedClassLabel, contextA.predictedClassLabel );
+      EXPECT_NEAR( contextCopy.maxLikelihood, contextA.maxLikelihood, 1.0e-10 );
+    }
+  }
+
+  //The shared model should not have been changed by the context predictions
+  EXPECT_EQ( dtw.getPredictedClassLabel(), 0 );
+  EXPECT_EQ( dtw.getMaximumLikelihood(), 0 );
+}
+
+// Tests the const prediction for the regressifiers and clusterers
+TEST(PredictionContext, RegressifiersAndClusterers) {
+
+  ClassificationData classificationData = generateClassificationData();
+  UnlabelledData unlabelledData = classificationData.reformatAsUnlabelledData();
+  RegressionData regressionData( classificationData.getNumDimensions(), 1 );
+  for(UINT i=0; i<classificationData.getNumSamples(); i++){
+    EXPECT_TRUE( regressionData.addSample( classificationData[i].getSample(), VectorFloat(1,classificationData[i].getClassLabel()) ) );
+  }
+
+  LinearRegression linearRegression;
+  EXPECT_TRUE( linearRegression.train( regressionData ) );
+
+  KMeans kmeans;
+  kmeans.setNumClusters( 5 );
+  kmeans.enableScaling( true );
+  EXPECT_TRUE( kmeans.train( unlabelledData ) );
+
+  PredictionContext regressionContext;
+  PredictionContext clusterContext;
+  for(UINT i=0; i<classificationData.getNumSamples(); i+=10){
+    const VectorFloat &x = classificationData[i].getSample();
+
+    ASSERT_TRUE( linearRegression.predict( x, regressionContext ) );
+    ASSERT_TRUE( linearRegression.predict( x ) );
+    ASSERT_EQ( regressionContext.regressionData.getSize(), 1 );
+    EXPECT_NEAR( regressionContext.regressionData[0], linearRegression.getRegressionData()[0], 1.0e-10 );
+
+    ASSERT_TRUE( kmeans.predict( x, clusterContext ) );
+    ASSERT_TRUE( kmeans.predict( x ) );
+    EXPECT_EQ( clusterContext.predictedClusterLabel, kmeans.getPredictedClusterLabel() );
+    EXPECT_NEAR( clusterContext.maxLikelihood, kmeans.getMaximumLikelihood(), 1.0e-10 );
+  }
+}
+
+// Tests that several streams can share one pipeline, with each stream using its own context
+TEST(PredictionContext, Pipeline) {
+
+  ClassificationData trainingData = generateClassificationData();
+  ClassificationData testData = trainingData.split( 80 );
+
+  GestureRecognitionPipeline pipeline;
+  pipeline << MovingAverageFilter( 5, trainingData.getNumDimensions() );
+  pipeline << KNN();
+  pipeline << ClassLabelFilter( 2, 3 );
+  EXPECT_TRUE( pipeline.train( trainingData ) );
+
+  //Each stream should give the same results as its own copy of the pipeline, as the filters keep their own state
+  GestureRecognitionPipeline pipelineA( pipeline );
+  GestureRecognitionPipeline pipelineB( pipeline );
+  PredictionContext contextA;
+  PredictionContext contextB;
+  const UINT numTestSamples = testData.getNumSamples();
+  for(UINT i=0; i<numTestSamples; i++){
+    const VectorFloat &a = testData[i].getSample();
+    const VectorFloat &b = testData[numTestSamples-i-1].getSample();
+
+    ASSERT_TRUE( pipeline.predict( a, contextA ) );
+    ASSERT_TRUE( pipeline.predict( b, contextB ) );
+    ASSERT_TRUE( pipelineA.predict( a ) );
+    ASSERT_TRUE( pipelineB.predict( b ) );
+    EXPECT_EQ( contextA.predictedClassLabel, pipelineA.getPredictedClassLabel() );
+    EXPECT_EQ( contextB.predictedClassLabel, pipelineB.getPredictedClassLabel() );
+    EXPECT_NEAR( contextA.maxLikelihood, pipelineA.getMaximumLikelihood(), 1.0e-10 );
+    EXPECT_NEAR( contextB.maxLikelihood, pipelineB.getMaximumLikelihood(), 1.0e-10 );
+  }
+}
+
+#ifdef GRT_CXX11_ENABLED
+// Tests that one model can be used by several threads at once
+TEST(PredictionContext, MultipleThreads) {
+
+  ClassificationData trainingData = generateClassificationData();
+  ClassificationData testData = trainingData.split( 80 );
+
+  RandomForests randomForests;
+  randomForests.setForestSize( 10 );
+  EXPECT_TRUE( randomForests.train( trainingData ) );
+
+  Vector< UINT > expectedLabels( testData.getNumSamples() );
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( randomForests.predict( testData[i].getSample() ) );
+    expectedLabels[i] = randomForests.getPredictedClassLabel();
+  }
+
+  const UINT numThreads = 4;
+  Vector< UINT > numErrors( numThreads, 0 );
+  std::vector< std::thread > threads;
+  const RandomForests &model = randomForests;
+  for(UINT t=0; t<numThreads; t++){
+    threads.push_back( std::thread( [&model,&testData,&expectedLabels,&numErrors,t]{
+      PredictionContext context;
+      for(UINT n=0; n<10; n++){
+        for(UINT i=0; i<testData.getNumSamples(); i++){
+          if( !model.predict( testData[i].getSample(), context ) || context.predictedClassLabel != expectedLabels[i] ){
+            numErrors[t]++;
+          }
+        }
+      }
+    } ) );
+  }
+  for(UINT t=0; t<numThreads; t++) threads[t].join();
+
+  for(UINT t=0; t<numThreads; t++){
+    EXPECT_EQ( numErrors[t], 0 );
+  }
+}
+#endif
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
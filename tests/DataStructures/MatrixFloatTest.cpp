@@ -0,0 +1,59 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT MatrixFloat module
+
+//Computes a * b (or a' * b) with the textbook triple loop, used as the reference for the optimized product
+MatrixFloat referenceProduct( const MatrixFloat &a, const MatrixFloat &b, const bool aTranspose ){
+  const UINT M = aTranspose ? a.getNumCols() : a.getNumRows();
+  const UINT K = b.getNumRows();
+  const UINT L = b.getNumCols();
+  MatrixFloat c(M,L);
+  for(UINT i=0; i<M; i++){
+    for(UINT j=0; j<L; j++){
+      Float sum = 0;
+      for(UINT k=0; k<K; k++) sum += (aTranspose ? a[k][i] : a[i][k]) * b[k][j];
+      c[i][j] = sum;
+    }
+  }
+  return c;
+}
+
+// Tests the matrix product against the reference, using sizes that do not divide into the kernel tiles
+TEST(MatrixFloat, Multiple) {
+  Random random;
+  const UINT sizes[][3] = { {1,1,1}, {3,5,7}, {4,4,4}, {17,33,9}, {130,300,65} };
+  for(UINT n=0; n<5; n++){
+    for(UINT t=0; t<2; t++){
+      const UINT M = sizes[n][0], K = sizes[n][1], L = sizes[n][2];
+      const bool aTranspose = t == 1;
+      MatrixFloat a( aTranspose ? K : M, aTranspose ? M : K );
+      MatrixFloat b( K, L );
+      for(UINT i=0; i<a.getNumRows(); i++) for(UINT j=0; j<a.getNumCols(); j++) a[i][j] = random.getRandomNumberUniform(-1,1);
+      for(UINT i=0; i<K; i++) for(UINT j=0; j<L; j++) b[i][j] = random.getRandomNumberUniform(-1,1);
+
+      MatrixFloat c;
+      EXPECT_TRUE( c.multiple( a, b, aTranspose ) );
+      EXPECT_EQ( c.getNumRows(), M );
+      EXPECT_EQ( c.getNumCols(), L );
+
+      const MatrixFloat expected = referenceProduct( a, b, aTranspose );
+      for(UINT i=0; i<M; i++){
+        for(UINT j=0; j<L; j++){
+          EXPECT_NEAR( c[i][j], expected[i][j], tolerance( 1.0e-10 ) );
+        }
+      }
+    }
+  }
+
+  //The inner dimensions must match
+  MatrixFloat a(3,4), b(5,2), c;
+  EXPECT_FALSE( c.multiple( a, b ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
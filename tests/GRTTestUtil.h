@@ -0,0 +1,15 @@
+//Shared helpers for the GRT unit tests
+
+#ifndef GRT_TEST_UTIL_HEADER
+#define GRT_TEST_UTIL_HEADER
+
+#include <GRT.h>
+#include <limits>
+
+//Gets the tolerance for comparing two Float values. The tolerances in the tests are for double precision, so they are widened to
+//the precision of Float if the GRT is built with GRT_USE_FLOAT32
+inline GRT::Float tolerance( const GRT::Float value ){
+  return grt_max( value, GRT::Float( 1000 * std::numeric_limits< GRT::Float >::epsilon() ) );
+}
+
+#endif //GRT_TEST_UTIL_HEADER
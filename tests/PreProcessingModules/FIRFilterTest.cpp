@@ -0,0 +1,112 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT FIRFilter module
+
+//Filters a signal in blocks of blockSize samples and checks that the result matches filtering the signal one sample at a time
+void expectBlockMatchesStreaming( FIRFilter &blockFilter, const MatrixFloat &signal, const UINT blockSize ){
+
+  FIRFilter streamingFilter( blockFilter );
+  const UINT numDimensions = signal.getNumCols();
+
+  UINT blockStart = 0;
+  while( blockStart < signal.getNumRows() ){
+    const UINT numSamples = grt_min( blockSize, signal.getNumRows() - blockStart );
+    MatrixFloat block( numSamples, numDimensions );
+    for(UINT i=0; i<numSamples; i++){
+      for(UINT j=0; j<numDimensions; j++) block[i][j] = signal[blockStart+i][j];
+    }
+
+    MatrixFloat filtered = blockFilter.filter( block );
+    ASSERT_EQ( filtered.getNumRows(), numSamples );
+    ASSERT_EQ( filtered.getNumCols(), numDimensions );
+
+    for(UINT i=0; i<numSamples; i++){
+      VectorFloat expected = streamingFilter.filter( signal.getRow( blockStart+i ) );
+      for(UINT j=0; j<numDimensions; j++){
+        EXPECT_NEAR( filtered[i][j], expected[j], tolerance( 1.0e-9 ) );
+      }
+    }
+    blockStart += numSamples;
+  }
+
+  //The processed data should be the most recent filtered sample
+  VectorFloat processedData = blockFilter.getProcessedData();
+  VectorFloat expected = streamingFilter.getProcessedData();
+  for(UINT j=0; j<numDimensions; j++){
+    EXPECT_NEAR( processedData[j], expected[j], tolerance( 1.0e-9 ) );
+  }
+}
+
+// Tests the default constructor
+TEST(FIRFilter, Constructor) {
+
+  FIRFilter filter;
+
+  //Check the type matches
+  EXPECT_TRUE( filter.getPreProcessingType() == "FIRFilter" );
+
+  //The default filter should be built
+  EXPECT_TRUE( filter.getInitialized() );
+  EXPECT_EQ( filter.getNumTaps(), 50 );
+  EXPECT_EQ( filter.getFilterCoefficents().getSize(), 50 );
+}
+
+// Tests that block filtering with a short filter (which runs in the time domain) matches sample by sample filtering
+TEST(FIRFilter, BlockFilterTimeDomain) {
+
+  const UINT numDimensions = 3;
+  FIRFilter filter( FIRFilter::LPF, 20, 100, 10, 2, numDimensions );
+  ASSERT_TRUE( filter.getInitialized() );
+  ASSERT_LT( filter.getNumTaps(), (UINT)FIRFilter::FFT_CONVOLUTION_MIN_NUM_TAPS );
+
+  Random random;
+  MatrixFloat signal( 200, numDimensions );
+  for(UINT i=0; i<signal.getNumRows(); i++){
+    for(UINT j=0; j<numDimensions; j++) signal[i][j] = random.getRandomNumberUniform(-1,1);
+  }
+
+  expectBlockMatchesStreaming( filter, signal, 64 );
+}
+
+// Tests that block filtering with a long filter (which runs with FFT overlap-save convolution) matches sample by sample filtering
+TEST(FIRFilter, BlockFilterOverlapSave) {
+
+  Random random;
+  const UINT numTaps[3] = { 64, 257, 1024 };
+  for(UINT k=0; k<3; k++){
+    //Use an odd number of dimensions, so the last dimension is not filtered as part of a pair
+    const UINT numDimensions = 3;
+    FIRFilter filter( FIRFilter::BPF, numTaps[k], 1000, 50, 0.5, numDimensions );
+    ASSERT_TRUE( filter.setCutoffFrequency( 20, 80 ) );
+    ASSERT_TRUE( filter.buildFilter() );
+    ASSERT_GE( filter.getNumTaps(), (UINT)FIRFilter::FFT_CONVOLUTION_MIN_NUM_TAPS );
+
+    MatrixFloat signal( 3000, numDimensions );
+    for(UINT i=0; i<signal.getNumRows(); i++){
+      for(UINT j=0; j<numDimensions; j++) signal[i][j] = random.getRandomNumberUniform(-1,1);
+    }
+
+    //Use blocks that are shorter and longer than the filter, so the history is carried over between blocks
+    expectBlockMatchesStreaming( filter, signal, 1000 );
+    expectBlockMatchesStreaming( filter, signal, numTaps[k]/3 + 1 );
+  }
+}
+
+// Tests that the block filter fails for invalid input
+TEST(FIRFilter, BlockFilterInvalidInput) {
+
+  FIRFilter filter( FIRFilter::LPF, 128, 100, 10, 1, 2 );
+  EXPECT_EQ( filter.filter( MatrixFloat( 10, 3 ) ).getNumRows(), 0 );
+  EXPECT_EQ( filter.filter( MatrixFloat() ).getNumRows(), 0 );
+
+  filter.clear();
+  EXPECT_EQ( filter.filter( MatrixFloat( 10, 2 ) ).getNumRows(), 0 );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
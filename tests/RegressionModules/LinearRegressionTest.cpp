@@ -0,0 +1,96 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT LinearRegression module
+
+//Generates noisy samples of y = 2 + x0 - 3*x1 + 0.5*x2
+RegressionData generateLinearData( const UINT numSamples, const Float noise ){
+  Random random;
+  RegressionData data;
+  data.setInputAndTargetDimensions( 3, 1 );
+  VectorFloat x(3);
+  VectorFloat y(1);
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<3; j++) x[j] = random.getRandomNumberUniform( -1.0, 1.0 );
+    y[0] = 2.0 + x[0] - 3.0*x[1] + 0.5*x[2] + random.getRandomNumberGauss( 0, noise );
+    data.addSample( x, y );
+  }
+  return data;
+}
+
+// Tests the default constructor
+TEST(LinearRegression, Constructor) {
+
+  LinearRegression regression;
+
+  //Check the module is not trained
+  EXPECT_TRUE( !regression.getTrained() );
+
+  //The normal equations should be the default training method
+  EXPECT_EQ( regression.getTrainingMethod(), (UINT)LinearRegression::NORMAL_EQUATIONS );
+  EXPECT_FALSE( regression.setTrainingMethod( 10 ) );
+  EXPECT_FALSE( regression.setBatchSize( 0 ) );
+  EXPECT_FALSE( regression.setRegularizationCoeff( -1 ) );
+}
+
+// Tests the normal equations recover the exact weights
+TEST(LinearRegression, NormalEquations) {
+
+  RegressionData data = generateLinearData( 500, 0 );
+
+  LinearRegression regression;
+  EXPECT_TRUE( regression.train( data ) );
+  EXPECT_TRUE( regression.getTrained() );
+  EXPECT_NEAR( regression.getRMSTrainingError(), 0.0, tolerance( 1.0e-9 ) );
+
+  VectorFloat x(3);
+  x[0] = 0.5; x[1] = -0.25; x[2] = 1.0;
+  EXPECT_TRUE( regression.predict( x ) );
+  EXPECT_NEAR( regression.getRegressionData()[0], 2.0 + 0.5 + 0.75 + 0.5, tolerance( 1.0e-9 ) );
+
+  //The model should give the same prediction after it is saved and loaded
+  EXPECT_TRUE( regression.save( "linear_regression_model.grt" ) );
+  LinearRegression loaded;
+  EXPECT_TRUE( loaded.load( "linear_regression_model.grt" ) );
+  EXPECT_TRUE( loaded.predict( x ) );
+  EXPECT_NEAR( loaded.getRegressionData()[0], 3.75, tolerance( 1.0e-6 ) );
+
+  //Duplicate input dimensions make the normal equations singular, but a solution should still be found
+  RegressionData duplicated;
+  duplicated.setInputAndTargetDimensions( 4, 1 );
+  VectorFloat x4(4);
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    const VectorFloat &input = data[i].getInputVector();
+    x4[0] = input[0]; x4[1] = input[1]; x4[2] = input[2]; x4[3] = input[0];
+    duplicated.addSample( x4, data[i].getTargetVector() );
+  }
+  EXPECT_TRUE( regression.train( duplicated ) );
+  EXPECT_NEAR( regression.getRMSTrainingError(), 0.0, 1.0e-4 );
+}
+
+// Tests mini-batch gradient descent converges to the same solution
+TEST(LinearRegression, GradientDescent) {
+
+  RegressionData data = generateLinearData( 500, 0.01 );
+
+  LinearRegression closedForm;
+  RegressionData closedFormData( data );
+  EXPECT_TRUE( closedForm.train( closedFormData ) );
+
+  LinearRegression regression;
+  EXPECT_TRUE( regression.setTrainingMethod( LinearRegression::STOCHASTIC_GRADIENT_DESCENT ) );
+  EXPECT_TRUE( regression.setBatchSize( 10 ) );
+  EXPECT_TRUE( regression.setLearningRate( 0.1 ) );
+  EXPECT_TRUE( regression.setMaxNumEpochs( 1000 ) );
+  EXPECT_TRUE( regression.setMinChange( 1.0e-10 ) );
+  EXPECT_TRUE( regression.train( data ) );
+  EXPECT_TRUE( regression.getTrained() );
+  EXPECT_NEAR( regression.getRMSTrainingError(), closedForm.getRMSTrainingError(), 1.0e-3 );
+}
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest( &argc, argv );
+	return RUN_ALL_TESTS();
+}
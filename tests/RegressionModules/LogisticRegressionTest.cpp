@@ -0,0 +1,95 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT LogisticRegression module
+
+// Tests all the training methods converge to the same model on noisy (non separable) data
+TEST(LogisticRegression, TrainingMethods) {
+
+  //Generate samples where the probability of a positive target is sigmoid( 1 + 2*x0 - x1 )
+  Random random( 1234 );
+  RegressionData data;
+  data.setInputAndTargetDimensions( 2, 1 );
+  VectorFloat x(2);
+  VectorFloat y(1);
+  for(UINT i=0; i<2000; i++){
+    x[0] = random.getRandomNumberUniform( -2.0, 2.0 );
+    x[1] = random.getRandomNumberUniform( -2.0, 2.0 );
+    const Float p = 1.0 / (1.0 + exp( -(1.0 + 2.0*x[0] - x[1]) ));
+    y[0] = random.getRandomNumberUniform( 0.0, 1.0 ) < p ? 1.0 : 0.0;
+    data.addSample( x, y );
+  }
+
+  VectorFloat test(2);
+  test[0] = 0.5; test[1] = 1.0;
+
+  LogisticRegression newton( false );
+  EXPECT_EQ( newton.getTrainingMethod(), (UINT)LogisticRegression::NEWTON_IRLS );
+  EXPECT_TRUE( newton.setMinChange( 1.0e-10 ) );
+  RegressionData newtonData( data );
+  EXPECT_TRUE( newton.train( newtonData ) );
+  EXPECT_TRUE( newton.getTrained() );
+  EXPECT_TRUE( newton.getTrainingResults().getSize() < 20 );
+  EXPECT_TRUE( newton.predict( test ) );
+  const Float newtonPrediction = newton.getRegressionData()[0];
+
+  //The prediction should be close to the true probability
+  EXPECT_NEAR( newtonPrediction, 1.0 / (1.0 + exp( -1.0 )), 0.1 );
+
+  LogisticRegression lbfgs( false );
+  EXPECT_TRUE( lbfgs.setTrainingMethod( LogisticRegression::LIMITED_MEMORY_BFGS ) );
+  EXPECT_TRUE( lbfgs.setMinChange( 1.0e-12 ) );
+  RegressionData lbfgsData( data );
+  EXPECT_TRUE( lbfgs.train( lbfgsData ) );
+  EXPECT_TRUE( lbfgs.predict( test ) );
+  //L-BFGS stops on the change in the loss, which only fixes the optimum to about the square root of the Float epsilon
+  const Float lbfgsTolerance = grt_max( Float(1.0e-4), Float( 4 * sqrt( std::numeric_limits< Float >::epsilon() ) ) );
+  EXPECT_NEAR( lbfgs.getRegressionData()[0], newtonPrediction, lbfgsTolerance );
+
+  LogisticRegression sgd( false );
+  EXPECT_TRUE( sgd.setTrainingMethod( LogisticRegression::STOCHASTIC_GRADIENT_DESCENT ) );
+  EXPECT_TRUE( sgd.setBatchSize( 50 ) );
+  EXPECT_TRUE( sgd.setLearningRate( 0.1 ) );
+  EXPECT_TRUE( sgd.setMaxNumEpochs( 500 ) );
+  EXPECT_TRUE( sgd.setMinChange( 1.0e-10 ) );
+  RegressionData sgdData( data );
+  EXPECT_TRUE( sgd.train( sgdData ) );
+  EXPECT_TRUE( sgd.predict( test ) );
+  EXPECT_NEAR( sgd.getRegressionData()[0], newtonPrediction, 0.05 );
+
+  //The model should give the same prediction after it is saved and loaded
+  EXPECT_TRUE( newton.save( "logistic_regression_model.grt" ) );
+  LogisticRegression loaded;
+  EXPECT_TRUE( loaded.load( "logistic_regression_model.grt" ) );
+  EXPECT_TRUE( loaded.predict( test ) );
+  EXPECT_NEAR( loaded.getRegressionData()[0], newtonPrediction, 1.0e-6 );
+}
+
+// Tests separable data does not break the Newton solver
+TEST(LogisticRegression, SeparableData) {
+
+  RegressionData data;
+  data.setInputAndTargetDimensions( 1, 1 );
+  VectorFloat x(1);
+  VectorFloat y(1);
+  for(UINT i=0; i<100; i++){
+    x[0] = i / 100.0;
+    y[0] = x[0] > 0.5 ? 1.0 : 0.0;
+    data.addSample( x, y );
+  }
+
+  LogisticRegression regression( false );
+  EXPECT_TRUE( regression.train( data ) );
+  x[0] = 0.9;
+  EXPECT_TRUE( regression.predict( x ) );
+  EXPECT_TRUE( regression.getRegressionData()[0] > 0.99 );
+  x[0] = 0.1;
+  EXPECT_TRUE( regression.predict( x ) );
+  EXPECT_TRUE( regression.getRegressionData()[0] < 0.01 );
+}
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest( &argc, argv );
+	return RUN_ALL_TESTS();
+}
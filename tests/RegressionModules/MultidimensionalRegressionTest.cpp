@@ -0,0 +1,60 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT MultidimensionalRegression module
+
+// Tests the output modules trained in parallel give the same model as the modules trained one at a time
+TEST(MultidimensionalRegression, ParallelTraining) {
+
+  //Generate a linear mapping from 10 inputs to 50 outputs
+  const UINT numInputs = 10;
+  const UINT numOutputs = 50;
+  Random random;
+  MatrixFloat weights( numOutputs, numInputs );
+  for(UINT k=0; k<numOutputs; k++){
+    for(UINT j=0; j<numInputs; j++) weights[k][j] = random.getRandomNumberUniform( -1.0, 1.0 );
+  }
+  RegressionData data;
+  data.setInputAndTargetDimensions( numInputs, numOutputs );
+  VectorFloat x( numInputs );
+  for(UINT i=0; i<1000; i++){
+    for(UINT j=0; j<numInputs; j++) x[j] = random.getRandomNumberUniform( -1.0, 1.0 );
+    data.addSample( x, weights.multiple( x ) );
+  }
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+
+  MultidimensionalRegression serial( LinearRegression(), true );
+  ThreadPool::setThreadPoolSize( 1 );
+  RegressionData serialData( data );
+  EXPECT_TRUE( serial.train( serialData ) );
+
+  MultidimensionalRegression parallel( LinearRegression(), true );
+  ThreadPool::setThreadPoolSize( 4 );
+  RegressionData parallelData( data );
+  EXPECT_TRUE( parallel.train( parallelData ) );
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  EXPECT_TRUE( parallel.getTrained() );
+  EXPECT_EQ( parallel.getNumOutputDimensions(), numOutputs );
+
+  for(UINT i=0; i<10; i++){
+    for(UINT j=0; j<numInputs; j++) x[j] = random.getRandomNumberUniform( -1.0, 1.0 );
+    VectorFloat expected = weights.multiple( x );
+    EXPECT_TRUE( serial.predict( x ) );
+    EXPECT_TRUE( parallel.predict( x ) );
+    VectorFloat serialPrediction = serial.getRegressionData();
+    VectorFloat parallelPrediction = parallel.getRegressionData();
+    for(UINT k=0; k<numOutputs; k++){
+      EXPECT_EQ( serialPrediction[k], parallelPrediction[k] );
+      EXPECT_NEAR( parallelPrediction[k], expected[k], tolerance( 1.0e-6 ) );
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest( &argc, argv );
+	return RUN_ALL_TESTS();
+}
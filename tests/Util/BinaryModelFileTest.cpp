@@ -0,0 +1,354 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT binary model file format
+
+ClassificationData generateClassificationData(){
+  const UINT numSamples = 500;
+  const UINT numClasses = 5;
+  const UINT numDimensions = 4;
+  ClassificationData::generateGaussDataset( "binary_model_data.csv", numSamples, numClasses, numDimensions, 10, 1 );
+  ClassificationData data;
+  EXPECT_TRUE( data.load( "binary_model_data.csv" ) );
+  return data;
+}
+
+//Checks that two classifiers give the same predictions. Models that keep double precision values internally (such as the SVM) are
+//rounded to Float when they are saved, so the likelihoods are only compared to the precision of Float
+void expectMatchingPredictions( Classifier &a, Classifier &b, const ClassificationData &data ){
+  const Float tolerance = grt_max( Float(1.0e-10), Float( 1000 * std::numeric_limits< Float >::epsilon() ) );
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    ASSERT_TRUE( a.predict( data[i].getSample() ) );
+    ASSERT_TRUE( b.predict( data[i].getSample() ) );
+    EXPECT_EQ( a.getPredictedClassLabel(), b.getPredictedClassLabel() );
+    EXPECT_NEAR( a.getMaximumLikelihood(), b.getMaximumLikelihood(), tolerance );
+  }
+}
+
+// Tests writing and reading the basic values and sections
+TEST(BinaryModelFile, WriteAndRead) {
+
+  VectorFloat smallVector( 3 );
+  smallVector[0] = 1.5; smallVector[1] = -2.25; smallVector[2] = 1.0e-20;
+  VectorFloat largeVector( 100 );
+  for(UINT i=0; i<largeVector.getSize(); i++) largeVector[i] = i * 0.1;
+  MatrixFloat matrix( 10, 7 );
+  for(UINT i=0; i<matrix.getNumRows(); i++)
+    for(UINT j=0; j<matrix.getNumCols(); j++) matrix[i][j] = i - j * 0.5;
+  Vector< UINT > labels( 4 );
+  labels[0] = 1; labels[1] = 2; labels[2] = 99; labels[3] = 0;
+
+  BinaryModelWriter writer;
+  EXPECT_TRUE( writer.open( "binary_model_test.grtb" ) );
+  EXPECT_TRUE( writer.beginSection( "Outer" ) );
+  EXPECT_TRUE( writer.writeUInt( 42 ) );
+  EXPECT_TRUE( writer.writeInt( -7 ) );
+  EXPECT_TRUE( writer.writeBool( true ) );
+  EXPECT_TRUE( writer.writeFloat( 3.25 ) );
+  EXPECT_TRUE( writer.writeString( "some text" ) );
+  EXPECT_TRUE( writer.beginSection( "Skipped" ) );
+  EXPECT_TRUE( writer.writeVector( largeVector ) );
+  EXPECT_TRUE( writer.writeString( "not read" ) );
+  EXPECT_TRUE( writer.endSection() );
+  EXPECT_TRUE( writer.writeVector( smallVector ) );
+  EXPECT_TRUE( writer.writeVector( largeVector ) );
+  EXPECT_TRUE( writer.writeMatrix( matrix ) );
+  EXPECT_TRUE( writer.writeVector( labels ) );
+  std::fstream &text = writer.beginText();
+  EXPECT_TRUE( text.is_open() );
+  text << "TextValue: " << 5 << std::endl;
+  EXPECT_TRUE( writer.endText() );
+  EXPECT_TRUE( writer.endSection() );
+  EXPECT_TRUE( writer.close() );
+
+  EXPECT_TRUE( BinaryModelReader::isBinaryModelFile( "binary_model_test.grtb" ) );
+
+  //Read the file back with and without memory mapping
+  for(UINT k=0; k<2; k++){
+    const bool useMemoryMap = k == 0;
+    BinaryModelReader reader;
+    ASSERT_TRUE( reader.open( "binary_model_test.grtb", useMemoryMap ) );
+    EXPECT_FALSE( reader.getIsByteSwapped() );
+
+    UINT u = 0; int n = 0; bool b = false; Float f = 0; std::string s;
+    EXPECT_TRUE( reader.beginSection( "Outer" ) );
+    EXPECT_TRUE( reader.readUInt( u ) );
+    EXPECT_TRUE( reader.readInt( n ) );
+    EXPECT_TRUE( reader.readBool( b ) );
+    EXPECT_TRUE( reader.readFloat( f ) );
+    EXPECT_TRUE( reader.readString( s ) );
+    EXPECT_EQ( u, 42 );
+    EXPECT_EQ( n, -7 );
+    EXPECT_TRUE( b );
+    EXPECT_EQ( f, 3.25 );
+    EXPECT_EQ( s, "some text" );
+
+    //Any data in a section that is not read should be skipped
+    EXPECT_TRUE( reader.beginSection( "Skipped" ) );
+    EXPECT_TRUE( reader.endSection() );
+
+    VectorFloat v;
+    EXPECT_TRUE( reader.readVector( v ) );
+    ASSERT_EQ( v.getSize(), smallVector.getSize() );
+    for(UINT i=0; i<v.getSize(); i++) EXPECT_EQ( v[i], smallVector[i] );
+
+    //Large blocks should be aligned and readable in place
+    const Float *block = NULL;
+    UINT blockSize = 0;
+    ASSERT_TRUE( reader.mapFloatBlock( block, blockSize ) );
+    ASSERT_EQ( blockSize, largeVector.getSize() );
+    EXPECT_EQ( ((size_t)block) % 64, 0 );
+    for(UINT i=0; i<blockSize; i++) EXPECT_EQ( block[i], largeVector[i] );
+
+    MatrixFloat m;
+    EXPECT_TRUE( reader.readMatrix( m ) );
+    ASSERT_EQ( m.getNumRows(), matrix.getNumRows() );
+    ASSERT_EQ( m.getNumCols(), matrix.getNumCols() );
+    for(UINT i=0; i<m.getNumRows(); i++)
+      for(UINT j=0; j<m.getNumCols(); j++) EXPECT_EQ( m[i][j], matrix[i][j] );
+
+    Vector< UINT > l;
+    EXPECT_TRUE( reader.readVector( l ) );
+    ASSERT_EQ( l.getSize(), labels.getSize() );
+    for(UINT i=0; i<l.getSize(); i++) EXPECT_EQ( l[i], labels[i] );
+
+    std::fstream &textIn = reader.beginText();
+    EXPECT_TRUE( textIn.is_open() );
+    std::string word;
+    UINT value = 0;
+    textIn >> word >> value;
+    EXPECT_EQ( word, "TextValue:" );
+    EXPECT_EQ( value, 5 );
+    EXPECT_TRUE( reader.endText() );
+    EXPECT_TRUE( reader.endSection() );
+
+    //Reading past the end of the file should fail
+    EXPECT_FALSE( reader.readUInt( u ) );
+    EXPECT_TRUE( reader.close() );
+  }
+
+  //Text files should not be opened as binary files
+  std::fstream file;
+  file.open( "binary_model_text.grt", std::ios::out );
+  file << "GRT_PIPELINE_FILE_V3.0\n";
+  file.close();
+  EXPECT_FALSE( BinaryModelReader::isBinaryModelFile( "binary_model_text.grt" ) );
+  BinaryModelReader reader;
+  EXPECT_FALSE( reader.open( "binary_model_text.grt" ) );
+  EXPECT_FALSE( reader.getIsOpen() );
+
+  //Sections must be read with the name they were written with
+  EXPECT_TRUE( reader.open( "binary_model_test.grtb" ) );
+  EXPECT_FALSE( reader.beginSection( "Inner" ) );
+}
+
+// Tests that a matrix header that is larger than the file is rejected before the matrix is allocated
+TEST(BinaryModelFile, CorruptMatrixSize) {
+
+  BinaryModelWriter writer;
+  EXPECT_TRUE( writer.open( "binary_model_corrupt.grtb" ) );
+  EXPECT_TRUE( writer.writeUInt( 100000 ) );
+  EXPECT_TRUE( writer.writeUInt( 100000 ) );
+  EXPECT_TRUE( writer.writeVector( VectorFloat( 4, 1.0 ) ) );
+  EXPECT_TRUE( writer.close() );
+
+  BinaryModelReader reader;
+  ASSERT_TRUE( reader.open( "binary_model_corrupt.grtb" ) );
+  MatrixFloat m( 2, 2 );
+  EXPECT_FALSE( reader.readMatrix( m ) );
+  EXPECT_EQ( m.getNumRows(), 2 );
+  EXPECT_EQ( m.getNumCols(), 2 );
+  EXPECT_TRUE( reader.close() );
+}
+
+// Tests that files written with either Float size can be read, so the files are interchangeable between the float and double builds
+TEST(BinaryModelFile, FloatSizes) {
+
+  VectorFloat vector( 100 );
+  for(UINT i=0; i<vector.getSize(); i++) vector[i] = i * 0.5 - 20;
+  MatrixFloat matrix( 10, 7 );
+  for(UINT i=0; i<matrix.getNumRows(); i++)
+    for(UINT j=0; j<matrix.getNumCols(); j++) matrix[i][j] = i - j * 0.25;
+
+  const UINT floatSizes[2] = { sizeof(float), sizeof(double) };
+  for(UINT k=0; k<2; k++){
+    BinaryModelWriter writer;
+    ASSERT_TRUE( writer.open( "binary_model_float_size.grtb", floatSizes[k] ) );
+    EXPECT_TRUE( writer.beginSection( "Values" ) );
+    EXPECT_TRUE( writer.writeFloat( 0.125 ) );
+    EXPECT_TRUE( writer.writeVector( vector ) );
+    EXPECT_TRUE( writer.writeMatrix( matrix ) );
+    EXPECT_TRUE( writer.endSection() );
+    EXPECT_TRUE( writer.close() );
+
+    BinaryModelReader reader;
+    ASSERT_TRUE( reader.open( "binary_model_float_size.grtb" ) );
+    EXPECT_TRUE( reader.beginSection( "Values" ) );
+    Float value = 0;
+    EXPECT_TRUE( reader.readFloat( value ) );
+    EXPECT_EQ( value, 0.125 );
+
+    //Blocks can only be mapped if they were written with the size of Float, otherwise they must be converted when they are read
+    const Float *block = NULL;
+    UINT blockSize = 0;
+    EXPECT_EQ( reader.mapFloatBlock( block, blockSize ), floatSizes[k] == sizeof(Float) );
+    if( floatSizes[k] == sizeof(Float) ){
+      ASSERT_EQ( blockSize, vector.getSize() );
+      for(UINT i=0; i<blockSize; i++) EXPECT_EQ( block[i], vector[i] );
+    }else{
+      VectorFloat v;
+      EXPECT_TRUE( reader.readVector( v ) );
+      ASSERT_EQ( v.getSize(), vector.getSize() );
+      for(UINT i=0; i<v.getSize(); i++) EXPECT_EQ( v[i], vector[i] );
+    }
+
+    MatrixFloat m;
+    EXPECT_TRUE( reader.readMatrix( m ) );
+    ASSERT_EQ( m.getNumRows(), matrix.getNumRows() );
+    ASSERT_EQ( m.getNumCols(), matrix.getNumCols() );
+    for(UINT i=0; i<m.getNumRows(); i++)
+      for(UINT j=0; j<m.getNumCols(); j++) EXPECT_EQ( m[i][j], matrix[i][j] );
+    EXPECT_TRUE( reader.endSection() );
+    EXPECT_TRUE( reader.close() );
+  }
+
+  //Only float and double values are supported
+  BinaryModelWriter writer;
+  EXPECT_FALSE( writer.open( "binary_model_float_size.grtb", 2 ) );
+}
+
+// Tests saving and loading the classifiers with a binary format, and one that is stored as text in the binary file
+TEST(BinaryModelFile, Classifiers) {
+
+  ClassificationData trainingData = generateClassificationData();
+  ClassificationData testData = trainingData.split( 80 );
+
+  KNN knn;
+  knn.enableScaling( true );
+  knn.enableNullRejection( true );
+  EXPECT_TRUE( knn.train( trainingData ) );
+  EXPECT_TRUE( knn.saveBinary( "knn_model.grtb" ) );
+  KNN knnCopy;
+  EXPECT_TRUE( knnCopy.load( "knn_model.grtb" ) );
+  EXPECT_TRUE( knnCopy.getTrained() );
+  EXPECT_EQ( knnCopy.getK(), knn.getK() );
+  expectMatchingPredictions( knn, knnCopy, testData );
+
+  RandomForests randomForests;
+  randomForests.setForestSize( 10 );
+  EXPECT_TRUE( randomForests.train( trainingData ) );
+  EXPECT_TRUE( randomForests.saveBinary( "rf_model.grtb" ) );
+  RandomForests randomForestsCopy;
+  EXPECT_TRUE( randomForestsCopy.loadBinary( "rf_model.grtb" ) );
+  EXPECT_EQ( randomForestsCopy.getForestSize(), 10 );
+  expectMatchingPredictions( randomForests, randomForestsCopy, testData );
+
+  SVM svm;
+  EXPECT_TRUE( svm.train( trainingData ) );
+  EXPECT_TRUE( svm.saveBinary( "svm_model.grtb" ) );
+  SVM svmCopy;
+  EXPECT_TRUE( svmCopy.load( "svm_model.grtb" ) );
+  expectMatchingPredictions( svm, svmCopy, testData );
+
+  MinDist minDist;
+  EXPECT_TRUE( minDist.train( trainingData ) );
+  EXPECT_TRUE( minDist.saveBinary( "mindist_model.grtb" ) );
+  MinDist minDistCopy;
+  EXPECT_TRUE( minDistCopy.load( "mindist_model.grtb" ) );
+  expectMatchingPredictions( minDist, minDistCopy, testData );
+
+  //A binary model should not load into a different type of model
+  KNN wrongModel;
+  EXPECT_FALSE( wrongModel.load( "rf_model.grtb" ) );
+}
+
+// Tests saving and loading the MLP with the binary format
+TEST(BinaryModelFile, MLP) {
+
+  TrainingLog::enableLogging( false );
+
+  RegressionData data;
+  data.setInputAndTargetDimensions( 2, 1 );
+  Random random;
+  for(UINT i=0; i<100; i++){
+    VectorFloat x(2);
+    VectorFloat y(1);
+    x[0] = random.getRandomNumberUniform(-1,1);
+    x[1] = random.getRandomNumberUniform(-1,1);
+    y[0] = x[0] * x[1];
+    data.addSample( x, y );
+  }
+
+  MLP mlp;
+  mlp.init( 2, 5, 1, Neuron::LINEAR, Neuron::TANH, Neuron::LINEAR );
+  mlp.setMaxNumEpochs( 50 );
+  mlp.setNumRandomTrainingIterations( 1 );
+  mlp.setUseValidationSet( false );
+  EXPECT_TRUE( mlp.train( data ) );
+  EXPECT_TRUE( mlp.saveBinary( "mlp_model.grtb" ) );
+
+  MLP mlpCopy;
+  EXPECT_TRUE( mlpCopy.load( "mlp_model.grtb" ) );
+  EXPECT_TRUE( mlpCopy.getTrained() );
+  EXPECT_EQ( mlpCopy.getNumHiddenNeurons(), 5 );
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    ASSERT_TRUE( mlp.predict( data[i].getInputVector() ) );
+    ASSERT_TRUE( mlpCopy.predict( data[i].getInputVector() ) );
+    EXPECT_NEAR( mlp.getRegressionData()[0], mlpCopy.getRegressionData()[0], 1.0e-10 );
+  }
+}
+
+// Tests saving and loading a pipeline with the binary format, and converting it to and from the text format
+TEST(BinaryModelFile, Pipeline) {
+
+  ClassificationData trainingData = generateClassificationData();
+  ClassificationData testData = trainingData.split( 80 );
+
+  GestureRecognitionPipeline pipeline;
+  pipeline << MovingAverageFilter( 5, trainingData.getNumDimensions() );
+  RandomForests randomForests;
+  randomForests.setForestSize( 10 );
+  pipeline << randomForests;
+  pipeline << ClassLabelFilter( 2, 3 );
+  EXPECT_TRUE( pipeline.train( trainingData ) );
+
+  EXPECT_TRUE( pipeline.saveBinary( "pipeline.grtb" ) );
+  EXPECT_TRUE( pipeline.save( "pipeline.grt" ) );
+
+  //The binary pipeline should give the same results as the pipeline it was saved from
+  GestureRecognitionPipeline binaryPipeline;
+  GestureRecognitionPipeline textPipeline;
+  EXPECT_TRUE( binaryPipeline.load( "pipeline.grtb" ) );
+  EXPECT_TRUE( textPipeline.load( "pipeline.grt" ) );
+  EXPECT_TRUE( binaryPipeline.getTrained() );
+  EXPECT_EQ( binaryPipeline.getNumPreProcessingModules(), 1 );
+  EXPECT_EQ( binaryPipeline.getNumPostProcessingModules(), 1 );
+
+  //Convert the text pipeline to binary, and back to text again
+  EXPECT_TRUE( textPipeline.saveBinary( "pipeline_converted.grtb" ) );
+  GestureRecognitionPipeline convertedPipeline;
+  EXPECT_TRUE( convertedPipeline.loadBinary( "pipeline_converted.grtb" ) );
+
+  //Reset the filters, so the reference does not keep the filter state from the training data
+  GestureRecognitionPipeline reference( pipeline );
+  EXPECT_TRUE( reference.reset() );
+  EXPECT_TRUE( binaryPipeline.reset() );
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    ASSERT_TRUE( reference.predict( testData[i].getSample() ) );
+    ASSERT_TRUE( binaryPipeline.predict( testData[i].getSample() ) );
+    ASSERT_TRUE( textPipeline.predict( testData[i].getSample() ) );
+    ASSERT_TRUE( convertedPipeline.predict( testData[i].getSample() ) );
+    EXPECT_EQ( binaryPipeline.getPredictedClassLabel(), reference.getPredictedClassLabel() );
+    EXPECT_NEAR( binaryPipeline.getMaximumLikelihood(), reference.getMaximumLikelihood(), 1.0e-10 );
+
+    //The text format rounds the values, so the converted pipeline should match the text pipeline
+    EXPECT_EQ( convertedPipeline.getPredictedClassLabel(), textPipeline.getPredictedClassLabel() );
+    EXPECT_NEAR( convertedPipeline.getMaximumLikelihood(), textPipeline.getMaximumLikelihood(), 1.0e-10 );
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT Cholesky class
+
+//Builds a random symmetric positive definite matrix, a' a + N I
+MatrixFloat generatePositiveDefiniteMatrix( const UINT N ){
+  Random random;
+  MatrixFloat a(N,N);
+  for(UINT i=0; i<N; i++)
+    for(UINT j=0; j<N; j++)
+      a[i][j] = random.getRandomNumberUniform(-1.0,1.0);
+  MatrixFloat s(N,N);
+  s.multiple( a, a, true );
+  for(UINT i=0; i<N; i++) s[i][i] += N;
+  return s;
+}
+
+// Tests the factor of a small matrix against known results
+TEST(Cholesky, KnownValues) {
+  MatrixFloat a(3,3);
+  a[0][0] = 4;   a[0][1] = 12;  a[0][2] = -16;
+  a[1][0] = 12;  a[1][1] = 37;  a[1][2] = -43;
+  a[2][0] = -16; a[2][1] = -43; a[2][2] = 98;
+
+  Cholesky chol( a );
+  EXPECT_TRUE( chol.getSuccess() );
+  EXPECT_NEAR( chol.el[0][0], 2.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[1][0], 6.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[1][1], 1.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[2][0], -8.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[2][1], 5.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[2][2], 3.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[0][1], 0.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[0][2], 0.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.el[1][2], 0.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( chol.logdet(), log(36.0), tolerance( 1.0e-10 ) );
+}
+
+// Tests that L L' reconstructs a larger matrix and that the inverse is correct
+TEST(Cholesky, ReconstructionAndInverse) {
+  const UINT N = 64;
+  MatrixFloat a = generatePositiveDefiniteMatrix( N );
+
+  Cholesky chol( a );
+  EXPECT_TRUE( chol.getSuccess() );
+
+  Float maxError = 0;
+  for(UINT i=0; i<N; i++){
+    for(UINT j=0; j<N; j++){
+      Float x = 0;
+      for(UINT k=0; k<N; k++) x += chol.el[i][k] * chol.el[j][k];
+      maxError = grt_max( maxError, fabs( x - a[i][j] ) );
+    }
+  }
+  EXPECT_LT( maxError, tolerance( 1.0e-9 ) );
+
+  MatrixFloat ainv;
+  EXPECT_TRUE( chol.inverse( ainv ) );
+  maxError = 0;
+  for(UINT i=0; i<N; i++){
+    for(UINT j=0; j<N; j++){
+      Float x = 0;
+      for(UINT k=0; k<N; k++) x += a[i][k] * ainv[k][j];
+      maxError = grt_max( maxError, fabs( x - (i==j ? 1.0 : 0.0) ) );
+    }
+  }
+  EXPECT_LT( maxError, tolerance( 1.0e-9 ) );
+
+  //The log determinant should match the LU decomposition
+  //The determinant itself overflows if Float is single precision, so it is only compared if it is finite
+  LUDecomposition lu( a );
+  if( !grt_isinf( lu.det() ) ){
+    EXPECT_NEAR( chol.logdet(), log( lu.det() ), tolerance( 1.0e-8 ) );
+  }
+}
+
+// Tests that a matrix that is not positive definite is rejected
+TEST(Cholesky, NotPositiveDefinite) {
+  MatrixFloat a(2,2);
+  a[0][0] = 1; a[0][1] = 2;
+  a[1][0] = 2; a[1][1] = 1;
+  Cholesky chol( a );
+  EXPECT_FALSE( chol.getSuccess() );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT EigenvalueDecomposition class
+
+//Builds a random symmetric matrix
+MatrixFloat generateSymmetricMatrix( const UINT N ){
+  Random random;
+  MatrixFloat a(N,N);
+  for(UINT i=0; i<N; i++){
+    for(UINT j=0; j<=i; j++){
+      a[i][j] = a[j][i] = random.getRandomNumberUniform(-1.0,1.0);
+    }
+  }
+  return a;
+}
+
+// Tests the decomposition of a small symmetric matrix with known eigenvalues
+TEST(EigenvalueDecomposition, SymmetricKnownValues) {
+  MatrixFloat a(3,3);
+  a[0][0] = 2; a[0][1] = 1; a[0][2] = 0;
+  a[1][0] = 1; a[1][1] = 2; a[1][2] = 1;
+  a[2][0] = 0; a[2][1] = 1; a[2][2] = 2;
+
+  EigenvalueDecomposition eig;
+  EXPECT_TRUE( eig.decompose( a ) );
+
+  //The eigenvalues of a symmetric matrix are returned in ascending order
+  VectorFloat values = eig.getRealEigenvalues();
+  VectorFloat complexValues = eig.getComplexEigenvalues();
+  EXPECT_EQ( values.getSize(), 3 );
+  EXPECT_NEAR( values[0], 2.0 - sqrt(2.0), tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( values[1], 2.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( values[2], 2.0 + sqrt(2.0), tolerance( 1.0e-10 ) );
+  for(UINT i=0; i<3; i++) EXPECT_NEAR( complexValues[i], 0.0, tolerance( 1.0e-10 ) );
+
+  //The eigenvector of the smallest eigenvalue is [1 -sqrt(2) 1]/2, up to its sign
+  MatrixFloat v = eig.getEigenvectors();
+  const Float sign = v[0][0] > 0 ? 1.0 : -1.0;
+  EXPECT_NEAR( sign*v[0][0], 0.5, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( sign*v[1][0], -sqrt(2.0)/2.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( sign*v[2][0], 0.5, tolerance( 1.0e-10 ) );
+}
+
+// Tests that a larger symmetric decomposition satisfies A V = V D with orthonormal eigenvectors
+TEST(EigenvalueDecomposition, SymmetricReconstruction) {
+  const UINT N = 64;
+  MatrixFloat a = generateSymmetricMatrix( N );
+
+  EigenvalueDecomposition eig;
+  EXPECT_TRUE( eig.decompose( a ) );
+
+  MatrixFloat v = eig.getEigenvectors();
+  VectorFloat d = eig.getRealEigenvalues();
+  EXPECT_EQ( v.getNumRows(), N );
+  EXPECT_EQ( v.getNumCols(), N );
+
+  for(UINT k=1; k<N; k++) EXPECT_LE( d[k-1], d[k] );
+
+  Float maxError = 0;
+  Float maxOrthError = 0;
+  for(UINT i=0; i<N; i++){
+    for(UINT k=0; k<N; k++){
+      Float av = 0;
+      for(UINT j=0; j<N; j++) av += a[i][j] * v[j][k];
+      maxError = grt_max( maxError, fabs( av - v[i][k]*d[k] ) );
+
+      Float vv = 0;
+      for(UINT j=0; j<N; j++) vv += v[j][i] * v[j][k];
+      maxOrthError = grt_max( maxOrthError, fabs( vv - (i==k ? 1.0 : 0.0) ) );
+    }
+  }
+  EXPECT_LT( maxError, tolerance( 1.0e-10 ) );
+  EXPECT_LT( maxOrthError, tolerance( 1.0e-10 ) );
+}
+
+// Tests the decomposition of a nonsymmetric matrix with real eigenvalues
+TEST(EigenvalueDecomposition, NonsymmetricKnownValues) {
+  MatrixFloat a(2,2);
+  a[0][0] = 0;  a[0][1] = 1;
+  a[1][0] = -2; a[1][1] = -3;
+
+  EigenvalueDecomposition eig;
+  EXPECT_TRUE( eig.decompose( a ) );
+
+  VectorFloat values = eig.getRealEigenvalues();
+  VectorFloat complexValues = eig.getComplexEigenvalues();
+  EXPECT_NEAR( grt_min( values[0], values[1] ), -2.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( grt_max( values[0], values[1] ), -1.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( complexValues[0], 0.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( complexValues[1], 0.0, tolerance( 1.0e-10 ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
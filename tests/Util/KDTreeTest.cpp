@@ -0,0 +1,74 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT KDTree module
+
+// Tests the radius search returns the same points as a brute force search
+TEST(KDTree, RadiusSearch) {
+  Random random( 5 );
+  const UINT numPoints = 2000;
+  const UINT numDimensions = 3;
+  MatrixFloat data( numPoints, numDimensions );
+  for(UINT i=0; i<numPoints; i++){
+    for(UINT j=0; j<numDimensions; j++){
+      data[i][j] = random.getRandomNumberUniform(-1.0,1.0);
+    }
+  }
+
+  KDTree tree;
+  EXPECT_FALSE( tree.getBuilt() );
+  EXPECT_TRUE( tree.build( data, 8 ) );
+  EXPECT_TRUE( tree.getBuilt() );
+  EXPECT_EQ( tree.getNumPoints(), numPoints );
+  EXPECT_EQ( tree.getNumDimensions(), numDimensions );
+  for(UINT j=0; j<numDimensions; j++){
+    EXPECT_EQ( tree.getPoint(10)[j], data[10][j] );
+  }
+
+  const Float radius = 0.3;
+  for(UINT q=0; q<20; q++){
+    VectorFloat query( numDimensions );
+    for(UINT j=0; j<numDimensions; j++) query[j] = random.getRandomNumberUniform(-1.0,1.0);
+
+    Vector< UINT > indexes;
+    EXPECT_TRUE( tree.radiusSearch( query, radius, indexes ) );
+    std::sort( indexes.begin(), indexes.end() );
+
+    Vector< UINT > expected;
+    for(UINT i=0; i<numPoints; i++){
+      Float dist = 0;
+      for(UINT j=0; j<numDimensions; j++) dist += SQR( data[i][j] - query[j] );
+      if( dist <= radius*radius ) expected.push_back( i );
+    }
+
+    ASSERT_EQ( indexes.size(), expected.size() );
+    for(UINT i=0; i<expected.size(); i++){
+      EXPECT_EQ( indexes[i], expected[i] );
+    }
+  }
+}
+
+// Tests the tree handles duplicate points and invalid input
+TEST(KDTree, EdgeCases) {
+  KDTree tree;
+  EXPECT_FALSE( tree.build( MatrixFloat() ) );
+  EXPECT_FALSE( tree.build( MatrixFloat(10,2), 0 ) );
+
+  MatrixFloat data( 100, 2 );
+  data.setAllValues( 1.0 );
+  EXPECT_TRUE( tree.build( data, 4 ) );
+
+  Vector< UINT > indexes;
+  EXPECT_TRUE( tree.radiusSearch( VectorFloat(2,1.0), 0.1, indexes ) );
+  EXPECT_EQ( indexes.size(), 100 );
+  EXPECT_FALSE( tree.radiusSearch( VectorFloat(3,1.0), 0.1, indexes ) );
+
+  EXPECT_TRUE( tree.clear() );
+  EXPECT_FALSE( tree.getBuilt() );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT LUDecomposition class
+
+// Tests the determinant and solution of a small system with known results
+TEST(LUDecomposition, KnownValues) {
+  MatrixFloat a(3,3);
+  a[0][0] = 2;  a[0][1] = 1;  a[0][2] = 1;
+  a[1][0] = 4;  a[1][1] = -6; a[1][2] = 0;
+  a[2][0] = -2; a[2][1] = 7;  a[2][2] = 2;
+
+  LUDecomposition lu( a );
+  EXPECT_FALSE( lu.getIsSingular() );
+  EXPECT_NEAR( lu.det(), -16.0, tolerance( 1.0e-10 ) );
+
+  //The solution of a x = [5 -2 9] is [1 1 2]
+  VectorFloat b(3);
+  VectorFloat x(3);
+  b[0] = 5; b[1] = -2; b[2] = 9;
+  EXPECT_TRUE( lu.solve_vector( b, x ) );
+  EXPECT_NEAR( x[0], 1.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( x[1], 1.0, tolerance( 1.0e-10 ) );
+  EXPECT_NEAR( x[2], 2.0, tolerance( 1.0e-10 ) );
+}
+
+// Tests that the inverse and the multiple right-hand side solve agree with the input matrix
+TEST(LUDecomposition, InverseAndSolve) {
+  const UINT N = 64;
+  const UINT K = 5;
+  Random random;
+  MatrixFloat a(N,N);
+  MatrixFloat b(N,K);
+  for(UINT i=0; i<N; i++){
+    for(UINT j=0; j<N; j++) a[i][j] = random.getRandomNumberUniform(-1.0,1.0);
+    for(UINT k=0; k<K; k++) b[i][k] = random.getRandomNumberUniform(-1.0,1.0);
+  }
+
+  LUDecomposition lu( a );
+  EXPECT_FALSE( lu.getIsSingular() );
+
+  MatrixFloat ainv;
+  EXPECT_TRUE( lu.inverse( ainv ) );
+  Float maxError = 0;
+  for(UINT i=0; i<N; i++){
+    for(UINT j=0; j<N; j++){
+      Float x = 0;
+      for(UINT k=0; k<N; k++) x += a[i][k] * ainv[k][j];
+      maxError = grt_max( maxError, fabs( x - (i==j ? 1.0 : 0.0) ) );
+    }
+  }
+  EXPECT_LT( maxError, tolerance( 1.0e-9 ) );
+
+  //Each column of the matrix solve should match the single vector solve
+  MatrixFloat x(N,K);
+  EXPECT_TRUE( lu.solve( b, x ) );
+  VectorFloat bk(N);
+  VectorFloat xk(N);
+  maxError = 0;
+  for(UINT k=0; k<K; k++){
+    for(UINT i=0; i<N; i++) bk[i] = b[i][k];
+    EXPECT_TRUE( lu.solve_vector( bk, xk ) );
+    for(UINT i=0; i<N; i++) maxError = grt_max( maxError, fabs( xk[i] - x[i][k] ) );
+  }
+  EXPECT_LT( maxError, tolerance( 1.0e-9 ) );
+}
+
+// Tests that a matrix with a zero row is flagged as singular
+TEST(LUDecomposition, Singular) {
+  MatrixFloat a(3,3);
+  a.setAll( 0 );
+  a[0][0] = 1; a[2][2] = 1;
+  LUDecomposition lu( a );
+  EXPECT_TRUE( lu.getIsSingular() );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+using namespace GRT;
+
+//Unit tests for the GRT Log classes
+
+class ErrorLogRecorder : public Observer< ErrorLogMessage >{
+public:
+  virtual void notify(const ErrorLogMessage &data){
+    std::unique_lock< std::mutex > lock( mutex );
+    proceedingText.push_back( data.getProceedingText() );
+    messages.push_back( data.getMessage() );
+  }
+  std::mutex mutex;
+  Vector< std::string > proceedingText;
+  Vector< std::string > messages;
+};
+
+//A value that counts how many times it has been formatted
+struct FormatCounter{
+  static unsigned int count;
+};
+unsigned int FormatCounter::count = 0;
+std::ostream& operator<<(std::ostream &stream, const FormatCounter &counter){
+  FormatCounter::count++;
+  return stream << "counter";
+}
+
+//A log with a level below the minimum log level, so it should be compiled out
+class BelowMinimumLevelLog : public LogStream< BelowMinimumLevelLog, GRT_LOG_MIN_LEVEL-1 >{
+public:
+  BelowMinimumLevelLog() : LogStream< BelowMinimumLevelLog, GRT_LOG_MIN_LEVEL-1 >("[BELOW]"){ loggingEnabledPtr = &enabled; }
+  static LoggingFlag enabled;
+};
+Log::LoggingFlag BelowMinimumLevelLog::enabled( true );
+
+// Tests the last message and the callbacks
+TEST(Log, LastMessageAndCallbacks) {
+
+  ErrorLogRecorder recorder;
+  EXPECT_TRUE( ErrorLog::registerObserver( recorder ) );
+
+  ErrorLog log("[LOG_TEST]");
+  log << "value: " << 42 << " " << 0.5 << std::endl;
+  EXPECT_EQ( log.getLastMessage(), "value: 42 0.5" );
+
+  log << "second message";
+  log << " continued" << std::endl;
+  EXPECT_EQ( log.getLastMessage(), "second message continued" );
+
+  EXPECT_TRUE( ErrorLog::removeObserver( recorder ) );
+
+  ASSERT_EQ( recorder.messages.getSize(), 2 );
+  EXPECT_EQ( recorder.proceedingText[0], "[LOG_TEST] " );
+  EXPECT_EQ( recorder.messages[0], "value: 42 0.5" );
+  EXPECT_EQ( recorder.messages[1], "second message continued" );
+
+  //Copies should keep the last message, but write their own messages
+  ErrorLog copy( log );
+  EXPECT_EQ( copy.getLastMessage(), "second message continued" );
+  copy << "copy message" << std::endl;
+  EXPECT_EQ( copy.getLastMessage(), "copy message" );
+  EXPECT_EQ( log.getLastMessage(), "second message continued" );
+
+  EXPECT_TRUE( Log::flush() );
+}
+
+// Tests that disabled logs do not update the last message or trigger the callbacks
+TEST(Log, Disabled) {
+
+  ErrorLogRecorder recorder;
+  EXPECT_TRUE( ErrorLog::registerObserver( recorder ) );
+
+  ErrorLog log("[LOG_TEST]");
+  log << "enabled" << std::endl;
+
+  ErrorLog::enableLogging( false );
+  log << "globally disabled" << std::endl;
+  ErrorLog::enableLogging( true );
+
+  log.setEnableInstanceLogging( false );
+  log << "instance disabled" << std::endl;
+  log.setEnableInstanceLogging( true );
+
+  EXPECT_TRUE( ErrorLog::removeObserver( recorder ) );
+  EXPECT_EQ( log.getLastMessage(), "enabled" );
+  EXPECT_EQ( recorder.messages.getSize(), 1 );
+
+  //Logs below the minimum level should never format their values
+  BelowMinimumLevelLog below;
+  FormatCounter::count = 0;
+  below << FormatCounter() << std::endl;
+  EXPECT_EQ( FormatCounter::count, 0 );
+  EXPECT_EQ( below.getLastMessage(), "" );
+
+  //Logs above the minimum level should format them
+  log << FormatCounter() << std::endl;
+  EXPECT_EQ( FormatCounter::count, 1 );
+  EXPECT_EQ( log.getLastMessage(), "counter" );
+}
+
+// Tests that messages written by several threads to the same log are not interleaved
+TEST(Log, MultipleThreads) {
+
+  ErrorLogRecorder recorder;
+  EXPECT_TRUE( ErrorLog::registerObserver( recorder ) );
+
+  const unsigned int numThreads = 4;
+  const unsigned int numMessages = 500;
+  ErrorLog log("[LOG_TEST]");
+  std::vector< std::thread > threads;
+  for(unsigned int t=0; t<numThreads; t++){
+    threads.push_back( std::thread( [&log,t,numMessages]{
+      for(unsigned int i=0; i<numMessages; i++){
+        log << "thread " << t << " message " << i << std::endl;
+      }
+    } ) );
+  }
+  for(unsigned int t=0; t<numThreads; t++) threads[t].join();
+
+  EXPECT_TRUE( ErrorLog::removeObserver( recorder ) );
+  EXPECT_TRUE( Log::flush() );
+
+  ASSERT_EQ( recorder.messages.getSize(), numThreads*numMessages );
+  Vector< unsigned int > nextMessage( numThreads, 0 );
+  for(UINT i=0; i<recorder.messages.getSize(); i++){
+    unsigned int t = 0;
+    unsigned int m = 0;
+    std::string threadText, messageText;
+    std::stringstream stream( recorder.messages[i] );
+    stream >> threadText >> t >> messageText >> m;
+    ASSERT_EQ( threadText, "thread" );
+    ASSERT_EQ( messageText, "message" );
+    ASSERT_LT( t, numThreads );
+
+    //The messages from each thread should arrive in order
+    EXPECT_EQ( m, nextMessage[t] );
+    nextMessage[t] = m+1;
+  }
+}
+
+// Tests switching between asynchronous and synchronous logging
+TEST(Log, AsyncLogging) {
+
+  const bool asyncLoggingEnabled = Log::getAsyncLoggingEnabled();
+
+  ErrorLog log("[LOG_TEST]");
+  EXPECT_TRUE( Log::setAsyncLoggingEnabled( false ) );
+  EXPECT_FALSE( Log::getAsyncLoggingEnabled() );
+  log << "synchronous message" << std::endl;
+  EXPECT_EQ( log.getLastMessage(), "synchronous message" );
+
+  EXPECT_TRUE( Log::setAsyncLoggingEnabled( true ) );
+  EXPECT_TRUE( Log::getAsyncLoggingEnabled() );
+  log << "asynchronous message" << std::endl;
+  EXPECT_EQ( log.getLastMessage(), "asynchronous message" );
+  EXPECT_TRUE( Log::flush() );
+
+  Log::setAsyncLoggingEnabled( asyncLoggingEnabled );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT MultichannelCircularBuffer class
+
+// Tests the default constructor and resize
+TEST(MultichannelCircularBuffer, Resize) {
+
+  MultichannelCircularBuffer< Float > buffer;
+  EXPECT_FALSE( buffer.getInit() );
+  EXPECT_FALSE( buffer.getBufferFilled() );
+  EXPECT_EQ( buffer.getNumFrames(), 0 );
+
+  Float frame[3] = {1,2,3};
+  EXPECT_FALSE( buffer.push_back( frame ) );
+  EXPECT_FALSE( buffer.resize( 0, 3 ) );
+  EXPECT_FALSE( buffer.resize( 4, 0 ) );
+
+  EXPECT_TRUE( buffer.resize( 4, 3, 5 ) );
+  EXPECT_TRUE( buffer.getInit() );
+  EXPECT_EQ( buffer.getNumFrames(), 4 );
+  EXPECT_EQ( buffer.getNumChannels(), 3 );
+  EXPECT_EQ( buffer.getNumValuesInBuffer(), 0 );
+
+  //The buffer should be filled with the default value
+  for(UINT i=0; i<4; i++){
+    for(UINT j=0; j<3; j++){
+      EXPECT_EQ( buffer(i,j), 5 );
+    }
+  }
+
+  //The size of a pushed vector must match the number of channels
+  EXPECT_FALSE( buffer.push_back( VectorFloat(2,0) ) );
+}
+
+// Tests that the frames are always ordered from the oldest to the most recent, as the buffer wraps around
+TEST(MultichannelCircularBuffer, PushBack) {
+
+  const UINT numFrames = 5;
+  const UINT numChannels = 3;
+  MultichannelCircularBuffer< Float > buffer( numFrames, numChannels, 0 );
+
+  for(UINT n=0; n<23; n++){
+    VectorFloat frame( numChannels );
+    for(UINT j=0; j<numChannels; j++) frame[j] = n*10.0 + j;
+    EXPECT_TRUE( buffer.push_back( frame ) );
+    EXPECT_EQ( buffer.getNumValuesInBuffer(), grt_min( n+1, numFrames ) );
+    EXPECT_EQ( buffer.getBufferFilled(), n+1 >= numFrames );
+
+    //Frames that have not been pushed yet should still have the default value
+    for(UINT i=0; i<numFrames; i++){
+      const int value = int(n) - int(numFrames-1) + int(i);
+      for(UINT j=0; j<numChannels; j++){
+        EXPECT_EQ( buffer(i,j), value < 0 ? 0 : value*10.0 + j );
+        EXPECT_EQ( buffer.getFrame(i)[j], buffer(i,j) );
+      }
+    }
+    EXPECT_EQ( buffer.getBack()[0], n*10.0 );
+
+    //Any window should be contiguous
+    for(UINT windowSize=1; windowSize<=numFrames; windowSize++){
+      const Float *window = buffer.getWindow( windowSize );
+      for(UINT i=0; i<windowSize; i++){
+        for(UINT j=0; j<numChannels; j++){
+          EXPECT_EQ( window[i*numChannels+j], buffer(numFrames-windowSize+i,j) );
+        }
+      }
+    }
+  }
+}
+
+// Tests the channel views and getData
+TEST(MultichannelCircularBuffer, Views) {
+
+  MultichannelCircularBuffer< Float > buffer( 4, 2, 0 );
+  for(UINT n=1; n<=6; n++){
+    VectorFloat frame(2);
+    frame[0] = n;
+    frame[1] = -Float(n);
+    buffer.push_back( frame );
+  }
+
+  MultichannelCircularBuffer< Float >::ChannelView channel = buffer.getChannel( 1 );
+  EXPECT_EQ( channel.getSize(), 4 );
+  EXPECT_EQ( channel.getStride(), 2 );
+  for(UINT i=0; i<4; i++){
+    EXPECT_EQ( channel[i], -Float(i+3) );
+  }
+
+  VectorFloat values;
+  EXPECT_TRUE( buffer.getChannel( 0, 2 ).copyTo( values ) );
+  EXPECT_EQ( values.getSize(), 2 );
+  EXPECT_EQ( values[0], 5 );
+  EXPECT_EQ( values[1], 6 );
+
+  Vector< Vector< Float > > data = buffer.getData();
+  EXPECT_EQ( data.getSize(), 4 );
+  EXPECT_EQ( data[0][0], 3 );
+  EXPECT_EQ( data[3][1], -6 );
+
+  //The frames can also be copied into VectorFloats
+  Vector< VectorFloat > frames = buffer.getData< VectorFloat >();
+  EXPECT_EQ( frames.getSize(), 4 );
+  EXPECT_EQ( frames[0][0], 3 );
+  EXPECT_EQ( frames[3][1], -6 );
+
+  //Copies should be independent
+  MultichannelCircularBuffer< Float > copy( buffer );
+  VectorFloat frame(2,100);
+  copy.push_back( frame );
+  EXPECT_EQ( buffer.getBack()[0], 6 );
+  EXPECT_EQ( copy.getBack()[0], 100 );
+
+  //Reset should restore the default values, fill should set all the values and flag the buffer as filled
+  EXPECT_TRUE( buffer.reset() );
+  EXPECT_EQ( buffer.getNumValuesInBuffer(), 0 );
+  EXPECT_EQ( buffer.getData().getSize(), 0 );
+  EXPECT_EQ( buffer(3,1), 0 );
+  EXPECT_TRUE( buffer.fill( 7 ) );
+  EXPECT_TRUE( buffer.getBufferFilled() );
+  EXPECT_EQ( buffer(0,0), 7 );
+  EXPECT_EQ( buffer.getData().getSize(), 4 );
+}
+
+// Tests a single channel buffer of integer observations, as used by the discrete HMM
+TEST(MultichannelCircularBuffer, SingleChannel) {
+
+  MultichannelCircularBuffer< UINT > buffer( 3, 1 );
+  for(UINT n=0; n<2; n++){
+    buffer.push_back( &n );
+  }
+  EXPECT_EQ( buffer.getNumValuesInBuffer(), 2 );
+  const UINT *window = buffer.getWindow( buffer.getNumValuesInBuffer() );
+  EXPECT_EQ( window[0], 0 );
+  EXPECT_EQ( window[1], 1 );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
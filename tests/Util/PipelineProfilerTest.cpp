@@ -0,0 +1,146 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT PipelineProfiler and LatencyHistogram classes
+
+// Tests that the histogram buckets cover the value range with a small relative error
+TEST(PipelineProfiler, LatencyHistogramBuckets) {
+
+  for(unsigned long long value=0; value<100000; value+=7){
+    const UINT index = LatencyHistogram::getBucketIndex( value );
+    ASSERT_LT( index, (UINT)LatencyHistogram::NUM_BUCKETS );
+    const unsigned long long lowerBound = LatencyHistogram::getBucketLowerBound( index );
+    const unsigned long long width = LatencyHistogram::getBucketWidth( index );
+    EXPECT_LE( lowerBound, value );
+    EXPECT_LT( value, lowerBound + width );
+    EXPECT_LE( Float(width), value / 32.0 + 1 );
+  }
+
+  //Values outside of the histogram range should be clamped to the last bucket
+  EXPECT_EQ( LatencyHistogram::getBucketIndex( 1ULL << 50 ), (UINT)LatencyHistogram::NUM_BUCKETS-1 );
+}
+
+// Tests the histogram statistics and percentiles
+TEST(PipelineProfiler, LatencyHistogramPercentiles) {
+
+  LatencyHistogram histogram;
+  EXPECT_EQ( histogram.getCount(), 0 );
+  EXPECT_EQ( histogram.getPercentile( 50 ), 0 );
+
+  for(unsigned long long value=1; value<=1000; value++){
+    histogram.record( value * 1000 );
+  }
+
+  EXPECT_EQ( histogram.getCount(), 1000 );
+  EXPECT_EQ( histogram.getMin(), 1000 );
+  EXPECT_EQ( histogram.getMax(), 1000000 );
+  EXPECT_NEAR( histogram.getMean(), 500500, 1.0e-6 );
+  EXPECT_NEAR( Float(histogram.getPercentile( 50 )), 500000, 500000 * 0.04 );
+  EXPECT_NEAR( Float(histogram.getPercentile( 99 )), 990000, 990000 * 0.04 );
+  EXPECT_EQ( histogram.getPercentile( 100 ), 1000000 );
+
+  //Merging a histogram should add its values
+  LatencyHistogram other;
+  other.record( 5 );
+  EXPECT_TRUE( histogram.merge( other ) );
+  EXPECT_EQ( histogram.getCount(), 1001 );
+  EXPECT_EQ( histogram.getMin(), 5 );
+
+  EXPECT_TRUE( histogram.reset() );
+  EXPECT_EQ( histogram.getCount(), 0 );
+}
+
+// Tests the profiler counters and module latencies
+TEST(PipelineProfiler, RecordLatencies) {
+
+  PipelineProfiler profiler;
+  EXPECT_TRUE( profiler.recordModuleLatency( PipelineProfiler::PREPROCESSING_STAGE, 1, 100 ) );
+  EXPECT_TRUE( profiler.recordModuleLatency( PipelineProfiler::PREPROCESSING_STAGE, 0, 200 ) );
+  EXPECT_FALSE( profiler.recordModuleLatency( PipelineProfiler::NUM_PROFILER_STAGES, 0, 200 ) );
+
+  EXPECT_EQ( profiler.getNumModules( PipelineProfiler::PREPROCESSING_STAGE ), 2 );
+  EXPECT_EQ( profiler.getNumModules( PipelineProfiler::CLASSIFIER_STAGE ), 0 );
+  EXPECT_EQ( profiler.getModuleLatency( PipelineProfiler::PREPROCESSING_STAGE, 1 ).getMax(), 100 );
+  EXPECT_EQ( profiler.getStageLatency( PipelineProfiler::PREPROCESSING_STAGE ).getCount(), 2 );
+
+  profiler.startPrediction();
+  profiler.stopPrediction( true, true );
+  profiler.startPrediction();
+  profiler.stopPrediction( false, false );
+  EXPECT_EQ( profiler.getNumPredictions(), 2 );
+  EXPECT_EQ( profiler.getNumFailedPredictions(), 1 );
+  EXPECT_EQ( profiler.getNumRejections(), 1 );
+  EXPECT_EQ( profiler.getPipelineLatency().getCount(), 2 );
+
+  EXPECT_TRUE( profiler.reset() );
+  EXPECT_EQ( profiler.getNumPredictions(), 0 );
+  EXPECT_EQ( profiler.getNumModules( PipelineProfiler::PREPROCESSING_STAGE ), 0 );
+}
+
+// Tests profiling the predictions of a pipeline
+TEST(PipelineProfiler, PipelineProfiling) {
+
+  ClassificationData::generateGaussDataset( "profiler_test_data.csv", 200, 3, 2, 10, 1 );
+  ClassificationData data;
+  ASSERT_TRUE( data.load( "profiler_test_data.csv" ) );
+
+  GestureRecognitionPipeline pipeline;
+  pipeline << MovingAverageFilter( 3, data.getNumDimensions() );
+  pipeline << MovingAverageFilter( 2, data.getNumDimensions() );
+  pipeline << KNN( 3 );
+  pipeline << ClassLabelFilter( 1, 1 );
+  ASSERT_TRUE( pipeline.train( data ) );
+
+  //Profiling is disabled by default, so nothing should be recorded
+  EXPECT_FALSE( pipeline.getProfilingEnabled() );
+  EXPECT_TRUE( pipeline.predict( data[0].getSample() ) );
+  EXPECT_EQ( pipeline.getProfiler().getNumPredictions(), 0 );
+
+  EXPECT_TRUE( pipeline.setProfilingEnabled( true ) );
+  const UINT numPredictions = 50;
+  for(UINT i=0; i<numPredictions; i++){
+    EXPECT_TRUE( pipeline.predict( data[i].getSample() ) );
+  }
+
+  const PipelineProfiler &profiler = pipeline.getProfiler();
+  EXPECT_EQ( profiler.getNumPredictions(), numPredictions );
+  EXPECT_EQ( profiler.getNumFailedPredictions(), 0 );
+  EXPECT_EQ( profiler.getPipelineLatency().getCount(), numPredictions );
+  EXPECT_EQ( profiler.getNumModules( PipelineProfiler::PREPROCESSING_STAGE ), 2 );
+  EXPECT_EQ( profiler.getModuleLatency( PipelineProfiler::PREPROCESSING_STAGE, 0 ).getCount(), numPredictions );
+  EXPECT_EQ( profiler.getModuleLatency( PipelineProfiler::PREPROCESSING_STAGE, 1 ).getCount(), numPredictions );
+  EXPECT_EQ( profiler.getModuleLatency( PipelineProfiler::CLASSIFIER_STAGE, 0 ).getCount(), numPredictions );
+  EXPECT_EQ( profiler.getModuleLatency( PipelineProfiler::POST_PROCESSING_STAGE, 0 ).getCount(), numPredictions );
+  EXPECT_EQ( profiler.getNumModules( PipelineProfiler::FEATURE_EXTRACTION_STAGE ), 0 );
+
+  //The classifier can not take longer than the complete pipeline
+  EXPECT_LE( profiler.getModuleLatency( PipelineProfiler::CLASSIFIER_STAGE, 0 ).getSum(), profiler.getPipelineLatency().getSum() );
+
+  if( !PipelineProfiler::getAllocationCountingEnabled() ){
+    EXPECT_EQ( profiler.getNumAllocations(), 0 );
+  }
+
+  //The stats should contain each module
+  const std::string text = profiler.getStatsAsString();
+  EXPECT_NE( text.find( "preProcessing[1]" ), std::string::npos );
+  EXPECT_NE( text.find( "classifier[0]" ), std::string::npos );
+  const std::string json = profiler.getStatsAsJSON();
+  EXPECT_EQ( json[0], '{' );
+  EXPECT_EQ( json[ json.size()-1 ], '}' );
+  EXPECT_NE( json.find( "\"predictions\":50" ), std::string::npos );
+  EXPECT_NE( json.find( "\"postProcessing\":[{\"count\":50" ), std::string::npos );
+
+  //Copies of the pipeline should keep the profiler
+  GestureRecognitionPipeline copy( pipeline );
+  EXPECT_TRUE( copy.getProfilingEnabled() );
+  EXPECT_EQ( copy.getProfiler().getNumPredictions(), numPredictions );
+
+  EXPECT_TRUE( pipeline.resetProfiler() );
+  EXPECT_EQ( pipeline.getProfiler().getNumPredictions(), 0 );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,87 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#ifdef GRT_CXX11_ENABLED
+#include <thread>
+#endif
+using namespace GRT;
+
+//Unit tests for the GRT SPSCQueue class, which requires C++11 support
+
+#ifdef GRT_CXX11_ENABLED
+
+// Tests the capacity, push and pop from a single thread
+TEST(SPSCQueue, SingleThread) {
+
+  SPSCQueue< int > queue( 5 );
+  EXPECT_EQ( queue.getCapacity(), 8 );
+  EXPECT_TRUE( queue.getIsEmpty() );
+
+  int value = 0;
+  EXPECT_FALSE( queue.pop( value ) );
+
+  for(int i=0; i<8; i++){
+    EXPECT_TRUE( queue.push( i ) );
+  }
+  EXPECT_EQ( queue.getSize(), 8 );
+  EXPECT_FALSE( queue.push( 8 ) );
+
+  for(int i=0; i<8; i++){
+    EXPECT_TRUE( queue.pop( value ) );
+    EXPECT_EQ( value, i );
+  }
+  EXPECT_FALSE( queue.pop( value ) );
+  EXPECT_TRUE( queue.getIsEmpty() );
+
+  //Fill and empty the queue in place, so the indices wrap around the ring
+  for(int i=0; i<20; i++){
+    int *slot = queue.getPushSlot();
+    ASSERT_TRUE( slot != NULL );
+    *slot = i * 2;
+    queue.commitPush();
+    slot = queue.getPopSlot();
+    ASSERT_TRUE( slot != NULL );
+    EXPECT_EQ( *slot, i * 2 );
+    queue.commitPop();
+  }
+  EXPECT_TRUE( queue.getIsEmpty() );
+}
+
+// Tests that all the values pushed by a producer thread reach a consumer thread in order
+TEST(SPSCQueue, ProducerConsumer) {
+
+  const unsigned int numValues = 200000;
+  SPSCQueue< VectorFloat > queue( 64 );
+
+  std::thread producer( [&]{
+    VectorFloat sample( 3 );
+    for(unsigned int i=0; i<numValues; i++){
+      sample[0] = i;
+      sample[1] = i + 1;
+      sample[2] = i + 2;
+      while( !queue.push( sample ) ) std::this_thread::yield();
+    }
+  } );
+
+  unsigned int numReceived = 0;
+  bool inOrder = true;
+  VectorFloat sample;
+  while( numReceived < numValues ){
+    if( !queue.pop( sample ) ){
+      std::this_thread::yield();
+      continue;
+    }
+    if( sample.getSize() != 3 || sample[0] != numReceived || sample[2] != numReceived + 2 ) inOrder = false;
+    numReceived++;
+  }
+  producer.join();
+
+  EXPECT_TRUE( inOrder );
+  EXPECT_EQ( numReceived, numValues );
+  EXPECT_TRUE( queue.getIsEmpty() );
+}
+#endif //GRT_CXX11_ENABLED
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
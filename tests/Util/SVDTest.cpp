@@ -0,0 +1,76 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+#include "../GRTTestUtil.h"
+using namespace GRT;
+
+//Unit tests for the GRT SVD class
+
+// Tests the singular values of a small matrix against known results
+TEST(SVD, KnownValues) {
+  MatrixFloat a(4,2);
+  a[0][0] = 1; a[0][1] = 2;
+  a[1][0] = 3; a[1][1] = 4;
+  a[2][0] = 5; a[2][1] = 6;
+  a[3][0] = 7; a[3][1] = 8;
+
+  SVD svd;
+  EXPECT_TRUE( svd.solve( a ) );
+
+  VectorFloat w = svd.getW();
+  EXPECT_EQ( w.getSize(), 2 );
+  EXPECT_NEAR( w[0], 14.2690954992615, tolerance( 1.0e-9 ) );
+  EXPECT_NEAR( w[1], 0.626828232417543, tolerance( 1.0e-9 ) );
+}
+
+// Tests that U diag(W) V' reconstructs a larger random matrix, with orthonormal U and V and sorted singular values
+TEST(SVD, Reconstruction) {
+  const UINT M = 80;
+  const UINT N = 48;
+  Random random;
+  MatrixFloat a(M,N);
+  for(UINT i=0; i<M; i++)
+    for(UINT j=0; j<N; j++)
+      a[i][j] = random.getRandomNumberUniform(-1.0,1.0);
+
+  SVD svd;
+  EXPECT_TRUE( svd.solve( a ) );
+
+  MatrixFloat u = svd.getU();
+  MatrixFloat v = svd.getV();
+  VectorFloat w = svd.getW();
+  EXPECT_EQ( u.getNumRows(), M );
+  EXPECT_EQ( u.getNumCols(), N );
+  EXPECT_EQ( v.getNumRows(), N );
+  EXPECT_EQ( v.getNumCols(), N );
+  EXPECT_EQ( w.getSize(), N );
+
+  for(UINT k=1; k<N; k++) EXPECT_GE( w[k-1], w[k] );
+
+  Float maxError = 0;
+  for(UINT i=0; i<M; i++){
+    for(UINT j=0; j<N; j++){
+      Float x = 0;
+      for(UINT k=0; k<N; k++) x += u[i][k] * w[k] * v[j][k];
+      maxError = grt_max( maxError, fabs( x - a[i][j] ) );
+    }
+  }
+  EXPECT_LT( maxError, tolerance( 1.0e-10 ) );
+
+  Float maxOrthError = 0;
+  for(UINT i=0; i<N; i++){
+    for(UINT k=0; k<N; k++){
+      Float uu = 0;
+      Float vv = 0;
+      for(UINT j=0; j<M; j++) uu += u[j][i] * u[j][k];
+      for(UINT j=0; j<N; j++) vv += v[j][i] * v[j][k];
+      maxOrthError = grt_max( maxOrthError, fabs( uu - (i==k ? 1.0 : 0.0) ) );
+      maxOrthError = grt_max( maxOrthError, fabs( vv - (i==k ? 1.0 : 0.0) ) );
+    }
+  }
+  EXPECT_LT( maxOrthError, tolerance( 1.0e-10 ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
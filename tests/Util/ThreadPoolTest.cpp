@@ -0,0 +1,101 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT ThreadPool class
+
+// Tests parallelFor runs every index in the range exactly once, in contiguous blocks
+TEST(ThreadPool, ParallelForCoversRange) {
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  const unsigned int begin = 5;
+  const unsigned int end = 1005;
+  Vector< unsigned int > counts( end, 0 );
+#ifdef GRT_CXX11_ENABLED
+  EXPECT_EQ( ThreadPool::getNumParallelBlocks( end-begin, 10 ), 4 );
+  EXPECT_EQ( ThreadPool::getNumParallelBlocks( end-begin, 400 ), 2 );
+  EXPECT_EQ( ThreadPool::getNumParallelBlocks( end-begin, 10, 3 ), 3 );
+#endif
+  EXPECT_EQ( ThreadPool::getNumParallelBlocks( 0, 10 ), 1 );
+
+  EXPECT_TRUE( ThreadPool::parallelFor( begin, end, 10, [&counts](const unsigned int blockBegin,const unsigned int blockEnd){
+    for(unsigned int i=blockBegin; i<blockEnd; i++) counts[i]++;
+    return true;
+  } ) );
+
+  //The pool should be reused by the next call
+  EXPECT_TRUE( ThreadPool::parallelFor( begin, end, 10, [&counts](const unsigned int blockBegin,const unsigned int blockEnd){
+    for(unsigned int i=blockBegin; i<blockEnd; i++) counts[i]++;
+    return true;
+  } ) );
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  for(unsigned int i=0; i<end; i++){
+    EXPECT_EQ( counts[i], i < begin ? 0 : 2 );
+  }
+
+  //An empty range should not call the function
+  EXPECT_TRUE( ThreadPool::parallelFor( 3, 3, 1, [](const unsigned int,const unsigned int){ return false; } ) );
+}
+
+// Tests parallelFor returns false if any block fails, and rethrows exceptions from the blocks
+TEST(ThreadPool, ParallelForErrors) {
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  EXPECT_FALSE( ThreadPool::parallelFor( 0, 100, 1, [](const unsigned int blockBegin,const unsigned int blockEnd){
+    return !( 50 >= blockBegin && 50 < blockEnd );
+  } ) );
+
+  bool threw = false;
+  try{
+    ThreadPool::parallelFor( 0, 100, 1, [](const unsigned int blockBegin,const unsigned int blockEnd){
+      if( 99 >= blockBegin && 99 < blockEnd ) throw std::runtime_error( "block failed" );
+      return true;
+    } );
+  }catch( const std::runtime_error & ){
+    threw = true;
+  }
+  EXPECT_TRUE( threw );
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+}
+
+// Tests a parallelFor called from inside a block is run serially on the calling thread
+TEST(ThreadPool, NestedParallelForRunsSerially) {
+
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  ThreadPool::setThreadPoolSize( 4 );
+
+  const unsigned int numOuter = 8;
+  const unsigned int numInner = 1000;
+  Vector< unsigned int > innerBlocks( numOuter, 0 );
+  Vector< unsigned int > innerSum( numOuter, 0 );
+  EXPECT_TRUE( ThreadPool::parallelFor( 0, numOuter, 1, [&](const unsigned int outerBegin,const unsigned int outerEnd){
+    for(unsigned int o=outerBegin; o<outerEnd; o++){
+      EXPECT_EQ( ThreadPool::getNumParallelBlocks( numInner, 1 ), 1 );
+      ThreadPool::parallelFor( 0, numInner, 1, [&,o](const unsigned int innerBegin,const unsigned int innerEnd){
+        innerBlocks[o]++;
+        for(unsigned int i=innerBegin; i<innerEnd; i++) innerSum[o] += i;
+        return true;
+      } );
+    }
+    return true;
+  } ) );
+
+  ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  for(unsigned int o=0; o<numOuter; o++){
+    EXPECT_EQ( innerBlocks[o], 1 );
+    EXPECT_EQ( innerSum[o], numInner*(numInner-1)/2 );
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,107 @@
+/**
+ @author Nicholas Gillian <nick@nickgillian.com>
+ @brief This file implements a basic tool for converting GRT model files between the text and binary model file formats.
+ If the input file is a binary model file it will be saved as a text file, otherwise it will be saved as a binary file.
+*/
+
+//You might need to set the specific path of the GRT header relative to your project
+#include <GRT/GRT.h>
+using namespace GRT;
+using namespace std;
+
+InfoLog infoLog("[grt-convert-tool]");
+WarningLog warningLog("[WARNING grt-convert-tool]");
+ErrorLog errorLog("[ERROR grt-convert-tool]");
+
+bool printUsage(){
+    infoLog << "grt-convert-tool pipeline INPUT_FILENAME OUTPUT_FILENAME" << endl;
+    infoLog << "grt-convert-tool classifier|regressifier|clusterer MODEL_TYPE INPUT_FILENAME OUTPUT_FILENAME" << endl;
+    infoLog << "For example: grt-convert-tool classifier RandomForests model.grt model.grtb" << endl;
+    return true;
+}
+
+bool convertModel( MLBase *model, const string &inputFilename, const string &outputFilename, const bool toBinary ){
+
+    if( model == NULL ){
+        errorLog << "Unknown model type!" << endl;
+        return false;
+    }
+
+    infoLog << "- Loading model from file: " << inputFilename << endl;
+    if( !model->load( inputFilename ) ){
+        errorLog << "Failed to load model from file: " << inputFilename << endl;
+        return false;
+    }
+
+    infoLog << "- Saving " << (toBinary ? "binary" : "text") << " model to file: " << outputFilename << endl;
+    if( !(toBinary ? model->saveBinary( outputFilename ) : model->save( outputFilename )) ){
+        errorLog << "Failed to save model to file: " << outputFilename << endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char * argv[])
+{
+
+    if( argc < 4 ){
+        errorLog << "Not enough input arguments!" << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const string moduleType = argv[1];
+
+    if( moduleType == "pipeline" ){
+        const string inputFilename = argv[2];
+        const string outputFilename = argv[3];
+        const bool toBinary = !BinaryModelReader::isBinaryModelFile( inputFilename );
+
+        GestureRecognitionPipeline pipeline;
+
+        infoLog << "- Loading pipeline from file: " << inputFilename << endl;
+        if( !pipeline.load( inputFilename ) ){
+            errorLog << "Failed to load pipeline from file: " << inputFilename << endl;
+            return EXIT_FAILURE;
+        }
+
+        infoLog << "- Saving " << (toBinary ? "binary" : "text") << " pipeline to file: " << outputFilename << endl;
+        if( !(toBinary ? pipeline.saveBinary( outputFilename ) : pipeline.save( outputFilename )) ){
+            errorLog << "Failed to save pipeline to file: " << outputFilename << endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    if( argc < 5 ){
+        errorLog << "Not enough input arguments!" << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const string modelType = argv[2];
+    const string inputFilename = argv[3];
+    const string outputFilename = argv[4];
+    const bool toBinary = !BinaryModelReader::isBinaryModelFile( inputFilename );
+
+    MLBase *model = NULL;
+    if( moduleType == "classifier" ) model = Classifier::createInstanceFromString( modelType );
+    else if( moduleType == "regressifier" ) model = Regressifier::createInstanceFromString( modelType );
+    else if( moduleType == "clusterer" ) model = Clusterer::createInstanceFromString( modelType );
+    else{
+        errorLog << "Unknown module type: " << moduleType << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const bool result = convertModel( model, inputFilename, outputFilename, toBinary );
+
+    if( model != NULL ){
+        delete model;
+        model = NULL;
+    }
+
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,587 @@
+/**
+ @author Nicholas Gillian <nick@nickgillian.com>
+ @brief This file implements a headless, low-latency inference server. It loads a saved pipeline, receives samples as OSC messages
+ over UDP (or a Unix datagram socket) and sends the prediction for each sample back to the address it came from.
+
+ Each sample goes through three threads: the receiver thread parses the OSC message into a preallocated queue slot, the inference
+ thread (which can be pinned to a CPU) runs the const pipeline predict function, and the main thread publishes the results and
+ records the latency. The threads are connected by lock-free single-producer single-consumer queues, so no locks are taken per sample.
+
+ Input messages use the same format as the GRT GUI: an OSC message with the data address (default /Data) and one float, double or int
+ argument per input dimension. Classification results are sent as /Prediction (int class label, float likelihood), regression results
+ are sent as /RegressionData (int number of dimensions, followed by one float per dimension).
+
+ Use --loopback N to start a local sender that sends N random samples to the server and counts the replies, which can be used to test
+ the server and measure the latency without any other software.
+*/
+
+//You might need to set the specific path of the GRT header relative to your project
+#include <GRT/GRT.h>
+using namespace GRT;
+using namespace std;
+
+InfoLog infoLog("[grt-serve-tool]");
+WarningLog warningLog("[WARNING grt-serve-tool]");
+ErrorLog errorLog("[ERROR grt-serve-tool]");
+
+bool printUsage(){
+    infoLog << "grt-serve-tool [options]\n";
+    infoLog << "\t-f: sets the name of the file the pipeline should be loaded from\n";
+    infoLog << "\t--port: sets the UDP port the server listens on (default 5000)\n";
+    infoLog << "\t--socket: listen on a Unix datagram socket with this path instead of a UDP port\n";
+    infoLog << "\t--address: sets the OSC address of the input data messages (default /Data)\n";
+    infoLog << "\t--cpu: pins the inference thread to this CPU (default -1, not pinned)\n";
+    infoLog << "\t--queue-size: sets the size of the sample and result queues (default 1024)\n";
+    infoLog << "\t--stats-interval: prints the latency percentiles every N seconds (default 0, only print them when the server stops)\n";
+    infoLog << "\t--duration: stops the server after N seconds (default 0, run until ctrl-c)\n";
+    infoLog << "\t--loopback: sends N random samples to the server from a local sender and counts the replies (default 0, disabled)\n";
+    infoLog << "\t--rate: sets the number of samples per second sent by the loopback sender, 0 sends them as fast as possible (default 1000)\n";
+    infoLog << endl;
+    return true;
+}
+
+#if defined(GRT_CXX11_ENABLED) && ( defined(__linux__) || defined(__APPLE__) || defined(__unix__) )
+
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+typedef std::chrono::steady_clock Clock;
+
+const size_t MAX_PACKET_SIZE = 65536;
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+void signalHandler( int ){
+    stopRequested = 1;
+}
+
+//A sample received by the server, along with where the result should be sent
+struct Sample{
+    VectorFloat data;
+    sockaddr_storage replyAddress;
+    socklen_t replyAddressLength;
+    Clock::time_point receivedTime;
+};
+
+//The result for a sample, along with where it should be sent
+struct Result{
+    bool valid;
+    UINT predictedClassLabel;
+    Float maxLikelihood;
+    VectorFloat regressionData;
+    sockaddr_storage replyAddress;
+    socklen_t replyAddressLength;
+    Clock::time_point receivedTime;
+};
+
+//Counters shared by the server threads, each counter is only written by one thread
+struct ServerStats{
+    ServerStats(){
+        numReceived.store( 0 );
+        numDropped.store( 0 );
+        numInvalid.store( 0 );
+        numPredictionErrors.store( 0 );
+    }
+    std::atomic< unsigned long long > numReceived;
+    std::atomic< unsigned long long > numDropped;
+    std::atomic< unsigned long long > numInvalid;
+    std::atomic< unsigned long long > numPredictionErrors;
+};
+
+/*
+ The OSC functions below implement the small subset of OSC 1.0 the server needs: a single message (no bundles) with int32, float32 or
+ float64 arguments. Numbers are big endian and strings are null terminated and padded to a multiple of 4 bytes.
+*/
+size_t getOSCStringSize( const char *data, const size_t size ){
+    const size_t length = strnlen( data, size );
+    if( length == size ) return 0;
+    return ((length / 4) + 1) * 4;
+}
+
+bool parseOSCMessage( const char *data, const size_t size, const string &address, VectorFloat &values ){
+
+    const size_t addressSize = getOSCStringSize( data, size );
+    if( addressSize == 0 || addressSize > size || address != data ) return false;
+
+    size_t pos = addressSize;
+    const char *typeTags = data + pos;
+    const size_t typeTagSize = getOSCStringSize( typeTags, size - pos );
+    if( typeTagSize == 0 || typeTags[0] != ',' ) return false;
+    pos += typeTagSize;
+
+    const size_t numArgs = strlen( typeTags ) - 1;
+    values.resize( numArgs );
+    for(size_t i=0; i<numArgs; i++){
+        switch( typeTags[i+1] ){
+            case 'i':
+            case 'f':{
+                if( pos + 4 > size ) return false;
+                uint32_t bits = 0;
+                memcpy( &bits, data + pos, 4 );
+                bits = ntohl( bits );
+                if( typeTags[i+1] == 'i' ){
+                    int32_t value = 0;
+                    memcpy( &value, &bits, 4 );
+                    values[i] = value;
+                }else{
+                    float value = 0;
+                    memcpy( &value, &bits, 4 );
+                    values[i] = value;
+                }
+                pos += 4;
+            }
+            break;
+            case 'd':{
+                if( pos + 8 > size ) return false;
+                uint32_t words[2];
+                memcpy( words, data + pos, 8 );
+                const uint64_t bits = ((uint64_t)ntohl( words[0] ) << 32) | ntohl( words[1] );
+                double value = 0;
+                memcpy( &value, &bits, 8 );
+                values[i] = value;
+                pos += 8;
+            }
+            break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+size_t writeOSCString( char *data, const string &value ){
+    const size_t size = ((value.size() / 4) + 1) * 4;
+    memset( data, 0, size );
+    memcpy( data, value.c_str(), value.size() );
+    return size;
+}
+
+size_t writeOSCInt( char *data, const int32_t value ){
+    uint32_t bits = 0;
+    memcpy( &bits, &value, 4 );
+    bits = htonl( bits );
+    memcpy( data, &bits, 4 );
+    return 4;
+}
+
+size_t writeOSCFloat( char *data, const float value ){
+    uint32_t bits = 0;
+    memcpy( &bits, &value, 4 );
+    bits = htonl( bits );
+    memcpy( data, &bits, 4 );
+    return 4;
+}
+
+size_t writeOSCMessage( char *data, const string &address, const VectorFloat &values ){
+    size_t pos = writeOSCString( data, address );
+    pos += writeOSCString( data + pos, "," + string( values.getSize(), 'f' ) );
+    for(UINT i=0; i<values.getSize(); i++){
+        pos += writeOSCFloat( data + pos, (float)values[i] );
+    }
+    return pos;
+}
+
+size_t writeResultMessage( char *data, const Result &result, const bool classificationMode ){
+    size_t pos = 0;
+    if( classificationMode ){
+        pos += writeOSCString( data + pos, "/Prediction" );
+        pos += writeOSCString( data + pos, ",if" );
+        pos += writeOSCInt( data + pos, (int32_t)result.predictedClassLabel );
+        pos += writeOSCFloat( data + pos, (float)result.maxLikelihood );
+        return pos;
+    }
+    const UINT N = result.regressionData.getSize();
+    pos += writeOSCString( data + pos, "/RegressionData" );
+    pos += writeOSCString( data + pos, ",i" + string( N, 'f' ) );
+    pos += writeOSCInt( data + pos, (int32_t)N );
+    for(UINT i=0; i<N; i++){
+        pos += writeOSCFloat( data + pos, (float)result.regressionData[i] );
+    }
+    return pos;
+}
+
+//Creates a datagram socket bound to the UDP port (if socketPath is empty) or to the Unix socket path
+int createSocket( const string &socketPath, const int port, sockaddr_storage &address, socklen_t &addressLength ){
+
+    memset( &address, 0, sizeof(address) );
+    int fd = -1;
+
+    if( socketPath.empty() ){
+        fd = socket( AF_INET, SOCK_DGRAM, 0 );
+        sockaddr_in *inetAddress = (sockaddr_in*)&address;
+        inetAddress->sin_family = AF_INET;
+        inetAddress->sin_addr.s_addr = htonl( INADDR_ANY );
+        inetAddress->sin_port = htons( (uint16_t)port );
+        addressLength = sizeof(sockaddr_in);
+    }else{
+        if( socketPath.size() >= sizeof(sockaddr_un::sun_path) ){
+            errorLog << "createSocket(...) - The socket path is too long: " << socketPath << endl;
+            return -1;
+        }
+        fd = socket( AF_UNIX, SOCK_DGRAM, 0 );
+        sockaddr_un *unixAddress = (sockaddr_un*)&address;
+        unixAddress->sun_family = AF_UNIX;
+        strncpy( unixAddress->sun_path, socketPath.c_str(), sizeof(unixAddress->sun_path)-1 );
+        addressLength = sizeof(sockaddr_un);
+        unlink( socketPath.c_str() );
+    }
+
+    if( fd < 0 ){
+        errorLog << "createSocket(...) - Failed to create socket: " << strerror( errno ) << endl;
+        return -1;
+    }
+
+    if( ::bind( fd, (const sockaddr*)&address, addressLength ) != 0 ){
+        errorLog << "createSocket(...) - Failed to bind socket: " << strerror( errno ) << endl;
+        close( fd );
+        return -1;
+    }
+
+    //Use a receive timeout, so the threads can check if they should stop
+    timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout) );
+
+    return fd;
+}
+
+bool pinThreadToCPU( const int cpu ){
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO( &cpuSet );
+    CPU_SET( cpu, &cpuSet );
+    return pthread_setaffinity_np( pthread_self(), sizeof(cpuSet), &cpuSet ) == 0;
+#else
+    return false;
+#endif
+}
+
+void printLatencyStats( LatencyHistogram &latencies, const ServerStats &stats, const unsigned long long numPublished ){
+
+    infoLog << "received: " << stats.numReceived.load() << " published: " << numPublished << " dropped: " << stats.numDropped.load();
+    infoLog << " invalid: " << stats.numInvalid.load() << " prediction errors: " << stats.numPredictionErrors.load() << endl;
+
+    if( latencies.getCount() == 0 ) return;
+
+    //The histogram records nanoseconds, the stats are printed in microseconds
+    const Float percentiles[] = {50.0,90.0,99.0,99.9};
+    infoLog << "latency (us) over " << latencies.getCount() << " samples -";
+    for(UINT i=0; i<4; i++){
+        infoLog << " p" << percentiles[i] << ": " << latencies.getPercentile( percentiles[i] ) / 1000.0;
+    }
+    infoLog << " max: " << latencies.getMax() / 1000.0 << endl;
+    latencies.reset();
+}
+
+void receiverThread( const int fd, const string address, SPSCQueue< Sample > &samples, ServerStats &stats, std::atomic< bool > &running ){
+
+    Vector< char > packet( MAX_PACKET_SIZE );
+    Sample dropped;
+
+    while( running.load( std::memory_order_relaxed ) ){
+        //Parse the message straight into the next free queue slot, so the sample data is not reallocated for each message
+        Sample *sample = samples.getPushSlot();
+        const bool queueFull = sample == NULL;
+        if( queueFull ) sample = &dropped;
+
+        sample->replyAddressLength = sizeof(sample->replyAddress);
+        const ssize_t size = recvfrom( fd, &packet[0], packet.getSize(), 0, (sockaddr*)&sample->replyAddress, &sample->replyAddressLength );
+        if( size <= 0 ) continue;
+        sample->receivedTime = Clock::now();
+
+        if( !parseOSCMessage( &packet[0], (size_t)size, address, sample->data ) ){
+            stats.numInvalid.fetch_add( 1, std::memory_order_relaxed );
+            continue;
+        }
+
+        stats.numReceived.fetch_add( 1, std::memory_order_relaxed );
+        if( queueFull ){
+            stats.numDropped.fetch_add( 1, std::memory_order_relaxed );
+            continue;
+        }
+        samples.commitPush();
+    }
+}
+
+void inferenceThread( const GestureRecognitionPipeline &pipeline, const int cpu, SPSCQueue< Sample > &samples, SPSCQueue< Result > &results, ServerStats &stats, std::atomic< bool > &running ){
+
+    if( cpu >= 0 && !pinThreadToCPU( cpu ) ){
+        warningLog << "Failed to pin the inference thread to CPU " << cpu << endl;
+    }
+
+    const bool classificationMode = pipeline.getIsPipelineInClassificationMode();
+    const UINT numInputDimensions = pipeline.getInputVectorDimensionsSize();
+    PredictionContext context;
+    unsigned int numIdleLoops = 0;
+
+    while( running.load( std::memory_order_relaxed ) ){
+        Sample *sample = samples.getPopSlot();
+        Result *result = sample != NULL ? results.getPushSlot() : NULL;
+        if( result == NULL ){
+            //Spin for a while before backing off, so a new sample is picked up quickly without keeping the CPU busy when the server is idle
+            if( ++numIdleLoops < 10000 ) std::this_thread::yield();
+            else std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+            continue;
+        }
+        numIdleLoops = 0;
+
+        result->valid = sample->data.getSize() == numInputDimensions && pipeline.predict( sample->data, context );
+        if( result->valid ){
+            if( classificationMode ){
+                result->predictedClassLabel = context.predictedClassLabel;
+                result->maxLikelihood = context.maxLikelihood;
+            }else result->regressionData = context.regressionData;
+        }else stats.numPredictionErrors.fetch_add( 1, std::memory_order_relaxed );
+        result->replyAddress = sample->replyAddress;
+        result->replyAddressLength = sample->replyAddressLength;
+        result->receivedTime = sample->receivedTime;
+
+        samples.commitPop();
+        results.commitPush();
+    }
+}
+
+void loopbackSenderThread( const string socketPath, const int port, const string address, const UINT numDimensions, const UINT numSamples, const UINT rate, std::atomic< unsigned long long > &numReplies ){
+
+    //Bind the sender to its own address, so the server can send the replies back to it
+    sockaddr_storage localAddress;
+    socklen_t localAddressLength = 0;
+    const string localSocketPath = socketPath.empty() ? "" : socketPath + ".loopback";
+    const int fd = createSocket( localSocketPath, 0, localAddress, localAddressLength );
+    if( fd < 0 ){
+        errorLog << "Failed to create the loopback socket!" << endl;
+        return;
+    }
+
+    sockaddr_storage serverAddress;
+    socklen_t serverAddressLength = 0;
+    memset( &serverAddress, 0, sizeof(serverAddress) );
+    if( socketPath.empty() ){
+        sockaddr_in *inetAddress = (sockaddr_in*)&serverAddress;
+        inetAddress->sin_family = AF_INET;
+        inetAddress->sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        inetAddress->sin_port = htons( (uint16_t)port );
+        serverAddressLength = sizeof(sockaddr_in);
+    }else{
+        sockaddr_un *unixAddress = (sockaddr_un*)&serverAddress;
+        unixAddress->sun_family = AF_UNIX;
+        strncpy( unixAddress->sun_path, socketPath.c_str(), sizeof(unixAddress->sun_path)-1 );
+        serverAddressLength = sizeof(sockaddr_un);
+    }
+
+    //Count the replies on a separate thread, so the send rate does not depend on the server
+    std::atomic< bool > receiving( true );
+    std::thread replyThread( [&]{
+        Vector< char > packet( MAX_PACKET_SIZE );
+        while( receiving.load() ){
+            if( recv( fd, &packet[0], packet.getSize(), 0 ) > 0 ) numReplies.fetch_add( 1 );
+        }
+    } );
+
+    Random random;
+    VectorFloat sample( numDimensions );
+    Vector< char > packet( MAX_PACKET_SIZE );
+    const Clock::duration interval = rate > 0 ? std::chrono::duration_cast< Clock::duration >( std::chrono::duration< double >( 1.0 / rate ) ) : Clock::duration::zero();
+    Clock::time_point nextSendTime = Clock::now();
+
+    for(UINT i=0; i<numSamples && !stopRequested; i++){
+        for(UINT j=0; j<numDimensions; j++){
+            sample[j] = random.getRandomNumberUniform( 0, 1 );
+        }
+        const size_t size = writeOSCMessage( &packet[0], address, sample );
+        if( sendto( fd, &packet[0], size, 0, (const sockaddr*)&serverAddress, serverAddressLength ) < 0 ){
+            warningLog << "Failed to send loopback sample: " << strerror( errno ) << endl;
+        }
+        nextSendTime += interval;
+        std::this_thread::sleep_until( nextSendTime );
+    }
+
+    //Give the server some time to send the last replies
+    const Clock::time_point timeout = Clock::now() + std::chrono::seconds( 2 );
+    while( numReplies.load() < numSamples && Clock::now() < timeout && !stopRequested ){
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+
+    receiving.store( false );
+    replyThread.join();
+    close( fd );
+    if( !localSocketPath.empty() ) unlink( localSocketPath.c_str() );
+}
+
+int main(int argc, char * argv[])
+{
+    //Create an instance of the parser
+    CommandLineParser parser;
+
+    //Disable warning messages
+    parser.setWarningLoggingEnabled( false );
+
+    //Add some options and identifiers that can be used to get the results
+    parser.addOption( "-f", "pipeline-filename" ); //This should be supplied by the user as an input argument
+    parser.addOption( "--port", "port", 5000 );
+    parser.addOption( "--socket", "socket-path", "" );
+    parser.addOption( "--address", "address", "/Data" );
+    parser.addOption( "--cpu", "cpu", -1 );
+    parser.addOption( "--queue-size", "queue-size", 1024 );
+    parser.addOption( "--stats-interval", "stats-interval", 0 );
+    parser.addOption( "--duration", "duration", 0 );
+    parser.addOption( "--loopback", "loopback", 0 );
+    parser.addOption( "--rate", "rate", 1000 );
+
+    //Parse the command line
+    parser.parse( argc, argv );
+
+    string pipelineFilename = "";
+    string socketPath = "";
+    string address = "";
+    int port = 0;
+    int cpu = -1;
+    int queueSize = 0;
+    int statsInterval = 0;
+    int duration = 0;
+    int numLoopbackSamples = 0;
+    int loopbackRate = 0;
+
+    //Get the pipeline filename
+    if( !parser.get("pipeline-filename",pipelineFilename) ){
+        errorLog << "Failed to parse pipeline filename from command line! You can set the pipeline filename using the -f." << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    parser.get("port",port);
+    parser.get("socket-path",socketPath);
+    parser.get("address",address);
+    parser.get("cpu",cpu);
+    parser.get("queue-size",queueSize);
+    parser.get("stats-interval",statsInterval);
+    parser.get("duration",duration);
+    parser.get("loopback",numLoopbackSamples);
+    parser.get("rate",loopbackRate);
+
+    //Load the pipeline from a file
+    GestureRecognitionPipeline pipeline;
+
+    infoLog << "- Loading pipeline from file: " << pipelineFilename << endl;
+    if( !pipeline.load( pipelineFilename ) ){
+        errorLog << "Failed to load pipeline from file: " << pipelineFilename << endl;
+        return EXIT_FAILURE;
+    }
+
+    if( !pipeline.getTrained() ){
+        errorLog << "The pipeline has not been trained!" << endl;
+        return EXIT_FAILURE;
+    }
+
+    const bool classificationMode = pipeline.getIsPipelineInClassificationMode();
+
+    sockaddr_storage serverAddress;
+    socklen_t serverAddressLength = 0;
+    const int fd = createSocket( socketPath, port, serverAddress, serverAddressLength );
+    if( fd < 0 ){
+        errorLog << "Failed to start the server!" << endl;
+        return EXIT_FAILURE;
+    }
+
+    if( socketPath.empty() ) infoLog << "- Listening for " << address << " messages on UDP port: " << port << endl;
+    else infoLog << "- Listening for " << address << " messages on Unix socket: " << socketPath << endl;
+
+    signal( SIGINT, signalHandler );
+    signal( SIGTERM, signalHandler );
+
+    //Preallocate the queues, so the threads do not allocate memory per sample once the slots have been used
+    const UINT numInputDimensions = pipeline.getInputVectorDimensionsSize();
+    SPSCQueue< Sample > samples( (size_t)std::max( queueSize, 2 ) );
+    SPSCQueue< Result > results( (size_t)std::max( queueSize, 2 ) );
+    ServerStats stats;
+    std::atomic< bool > running( true );
+
+    std::thread receiver( receiverThread, fd, address, std::ref( samples ), std::ref( stats ), std::ref( running ) );
+    std::thread inference( inferenceThread, std::cref( pipeline ), cpu, std::ref( samples ), std::ref( results ), std::ref( stats ), std::ref( running ) );
+
+    std::atomic< bool > loopbackFinished( numLoopbackSamples <= 0 );
+    std::atomic< unsigned long long > numLoopbackReplies( 0 );
+    std::thread loopback;
+    if( numLoopbackSamples > 0 ){
+        if( loopbackRate > 0 ) infoLog << "- Sending " << numLoopbackSamples << " loopback samples at " << loopbackRate << " samples per second" << endl;
+        else infoLog << "- Sending " << numLoopbackSamples << " loopback samples as fast as possible" << endl;
+        loopback = std::thread( [&]{
+            loopbackSenderThread( socketPath, port, address, numInputDimensions, (UINT)numLoopbackSamples, (UINT)std::max( loopbackRate, 0 ), numLoopbackReplies );
+            loopbackFinished.store( true );
+        } );
+    }
+
+    //Publish the results from the main thread, the latencies are recorded in a fixed size histogram so nothing is allocated per sample
+    LatencyHistogram latencies;
+    Vector< char > packet( MAX_PACKET_SIZE );
+    unsigned long long numPublished = 0;
+    unsigned int numIdleLoops = 0;
+    const Clock::time_point startTime = Clock::now();
+    Clock::time_point lastStatsTime = startTime;
+
+    while( !stopRequested ){
+        Result *result = results.getPopSlot();
+        if( result != NULL ){
+            numIdleLoops = 0;
+            if( result->valid ){
+                const size_t size = writeResultMessage( &packet[0], *result, classificationMode );
+                sendto( fd, &packet[0], size, 0, (const sockaddr*)&result->replyAddress, result->replyAddressLength );
+                latencies.record( (unsigned long long)std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - result->receivedTime ).count() );
+                numPublished++;
+            }
+            results.commitPop();
+            continue;
+        }
+
+        const Clock::time_point now = Clock::now();
+        if( statsInterval > 0 && now - lastStatsTime >= std::chrono::seconds( statsInterval ) ){
+            printLatencyStats( latencies, stats, numPublished );
+            lastStatsTime = now;
+        }
+        if( duration > 0 && now - startTime >= std::chrono::seconds( duration ) ) break;
+        if( loopbackFinished.load() && numLoopbackSamples > 0 ) break;
+
+        if( ++numIdleLoops < 10000 ) std::this_thread::yield();
+        else std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+    }
+
+    stopRequested = 1;
+    running.store( false );
+    if( loopback.joinable() ) loopback.join();
+    receiver.join();
+    inference.join();
+    close( fd );
+    if( !socketPath.empty() ) unlink( socketPath.c_str() );
+
+    printLatencyStats( latencies, stats, numPublished );
+
+    if( numLoopbackSamples > 0 ){
+        infoLog << "- Loopback replies received: " << numLoopbackReplies.load() << " / " << numLoopbackSamples << endl;
+        if( numLoopbackReplies.load() != (unsigned long long)numLoopbackSamples ) return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int main(int argc, char * argv[])
+{
+    errorLog << "grt-serve-tool requires C++11 support and POSIX sockets, which are not available on this platform!" << endl;
+    printUsage();
+    return EXIT_FAILURE;
+}
+
+#endif